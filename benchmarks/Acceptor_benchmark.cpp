@@ -0,0 +1,143 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file Acceptor_benchmark.cpp
+ *
+ * @brief Connections per second accepted by an Acceptor for growing per iteration budgets
+ *
+ * Usage: Acceptor_benchmark [connections] [clients]
+ *
+ * Client threads open and reset connections as fast as they can while the main thread drains the listener from an
+ * event loop. A budget of 1 is the classic one accept per readiness event, larger budgets drain the backlog in
+ * batches and spend fewer epoll_wait calls per connection.
+ */
+
+
+#include <Acceptor.h>
+#include <BenchmarkUtils.h>
+#include <EventLoop.h>
+
+#include <sys/socket.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+
+namespace ncs { // Network Communications System
+namespace bench { // Network Communications System Benchmarks
+
+
+/**
+ * @brief Measured results of one budget
+ */
+struct result_t {
+  double connectionsPerSecond = 0;
+  double acceptsPerBatch = 0;
+  std::uint64_t exhausted = 0;
+  std::uint64_t queuePeak = 0;
+  std::uint64_t p50 = 0;
+  std::uint64_t p99 = 0;
+};
+
+
+/**
+ * @brief Opens connections to iAddr until iStop is set, resetting each one right away to keep no TIME_WAIT around
+ *
+ * @param iAddr
+ * @param iStop
+ */
+void connect_storm(const addr::InternetAddress& iAddr, const std::atomic<bool>& iStop) {
+  const linger reset = {1, 0};
+  while (!iStop.load(std::memory_order_relaxed)) {
+    sock::InternetSocket client;
+    if (client.connect(iAddr)) {
+      setsockopt(client.get_sd(), SOL_SOCKET, SO_LINGER, &reset, sizeof(reset));
+    }
+    client.close();
+  }
+}
+
+/**
+ * @brief Accepts iConnections connections with the given budget
+ *
+ * @param iBudget
+ * @param iConnections
+ * @param iClients
+ *
+ * @return
+ */
+result_t run(const std::size_t& iBudget, const std::size_t& iConnections, const std::size_t& iClients) {
+  result_t result;
+  sock::EventLoop loop;
+  metrics::AcceptMetrics metrics;
+  sock::acceptor_config_t config;
+  config.budget = iBudget;
+  sock::Acceptor acceptor(loop, config);
+  acceptor.set_metrics(&metrics);
+  std::size_t accepted = 0;
+  if (!acceptor.listen({"127.0.0.1", addr::RANDOM_PORT}, [&accepted](sock::InternetSocket&&) { ++accepted; })) {
+    std::perror("listen");
+    return result;
+  }
+
+  std::atomic<bool> stop(false);
+  std::vector<std::thread> clients;
+  for (std::size_t i = 0; i < iClients; ++i) {
+    clients.emplace_back(connect_storm, acceptor.get_listener().get_addr(), std::cref(stop));
+  }
+  const std::uint64_t start = now_ns();
+  while (accepted < iConnections) {
+    loop.run_once(100);
+  }
+  const double seconds = static_cast<double>(now_ns() - start) / 1e9;
+  stop = true;
+  for (std::thread& client : clients) {
+    client.join();
+  }
+
+  const metrics::accept_snapshot_t snapshot = metrics.snapshot();
+  result.connectionsPerSecond = static_cast<double>(snapshot.accepted) / seconds;
+  result.acceptsPerBatch = static_cast<double>(snapshot.accepted) / static_cast<double>(snapshot.batches);
+  result.exhausted = snapshot.budget_exhausted;
+  result.queuePeak = snapshot.queue_peak;
+  result.p50 = snapshot.accept_latency.get_percentile(0.50) / 1000;
+  result.p99 = snapshot.accept_latency.get_percentile(0.99) / 1000;
+  return result;
+}
+
+
+} // namespace bench
+} // namespace ncs
+
+
+/**
+ * @brief
+ */
+int main(int argc, char** argv) {
+  using namespace ncs;
+  const std::size_t connections = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 20000;
+  const std::size_t clients = std::max<std::size_t>((argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 4, 1);
+
+  std::printf("%-8s %12s %12s %10s %11s %9s %9s\n", "budget", "conns/s", "per_batch", "exhausted", "queue_peak",
+              "p50_us", "p99_us");
+  for (const std::size_t budget : {1, 4, 16, 64, 256}) {
+    const bench::result_t result = bench::run(budget, connections, clients);
+    std::printf("%-8zu %12.0f %12.2f %10llu %11llu %9llu %9llu\n", budget, result.connectionsPerSecond,
+                result.acceptsPerBatch, static_cast<unsigned long long>(result.exhausted),
+                static_cast<unsigned long long>(result.queuePeak), static_cast<unsigned long long>(result.p50),
+                static_cast<unsigned long long>(result.p99));
+  }
+
+  std::uint64_t overflows = 0;
+  std::uint64_t drops = 0;
+  if (sock::Acceptor::read_listen_overflows(overflows, drops)) {
+    std::printf("listen overflows %llu, drops %llu\n", static_cast<unsigned long long>(overflows),
+                static_cast<unsigned long long>(drops));
+  }
+  return 0;
+}
@@ -0,0 +1,185 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file AddressCodec_benchmark.cpp
+ *
+ * @brief Round trip of a gossiped peer list as to_string() lines and in the binary format of AddressCodec.h
+ *
+ * Usage: AddressCodec_benchmark [addresses] [rounds]
+ *
+ * Every fourth peer is IPv6. The text rows join the to_string() of every peer with newlines and parse them back into
+ * InternetAddress, the way peer lists are gossiped today. The binary rows encode and decode the same list, once from
+ * and to InternetAddress, which costs a text conversion of the ip each way, and once from and to inet_address_t,
+ * which is plain copies. Each row reports the best of the rounds.
+ */
+
+
+#include <AddressCodec.h>
+#include <BenchmarkUtils.h>
+#include <FixedAddress.h>
+#include <InternetAddress.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <vector>
+
+
+namespace ncs { // Network Communications System
+namespace bench { // Network Communications System Benchmarks
+
+
+/**
+ * @brief Ip of the i-th peer
+ *
+ * @param iPeer
+ *
+ * @return
+ */
+addr::ip_t peer_ip(const std::size_t& iPeer) {
+  if (iPeer % 4 == 3) {
+    char text[INET6_ADDRSTRLEN];
+    std::snprintf(text, sizeof(text), "2001:db8:%zx::%zx", (iPeer >> 16) & 0xffff, iPeer & 0xffff);
+    return text;
+  }
+  return "10." + std::to_string((iPeer >> 16) & 0xff) + "." + std::to_string((iPeer >> 8) & 0xff) + "." +
+         std::to_string(iPeer & 0xff);
+}
+
+/**
+ * @brief Parses the lines written by to_string(), "ip:port" or "[ip]:port"
+ *
+ * @param iText
+ * @param oAddrs
+ */
+void parse_lines(const std::string& iText, std::vector<addr::InternetAddress>& oAddrs) {
+  oAddrs.clear();
+  std::size_t start = 0;
+  while (start < iText.size()) {
+    std::size_t end = iText.find('\n', start);
+    end = (end == std::string::npos) ? iText.size() : end;
+    const std::size_t colon = iText.rfind(':', end);
+    const bool bracketed = iText[start] == '[';
+    const std::size_t ipStart = start + (bracketed ? 1 : 0);
+    const std::size_t ipEnd = colon - (bracketed ? 1 : 0);
+    oAddrs.emplace_back(iText.substr(ipStart, ipEnd - ipStart), std::stoi(iText.substr(colon + 1, end - colon - 1)));
+    start = end + 1;
+  }
+}
+
+/**
+ * @brief Best time of iRounds runs of iOperation, in nanoseconds
+ *
+ * @param iRounds
+ * @param iOperation
+ *
+ * @return
+ */
+template <typename Operation>
+std::uint64_t best_ns(const std::size_t& iRounds, Operation&& iOperation) {
+  std::uint64_t best = std::numeric_limits<std::uint64_t>::max();
+  for (std::size_t round = 0; round < iRounds; ++round) {
+    const std::uint64_t start = now_ns();
+    iOperation();
+    best = std::min(best, now_ns() - start);
+  }
+  return best;
+}
+
+/**
+ * @brief Prints one row
+ *
+ * @param iName
+ * @param iBytes Encoded size
+ * @param iCount Addresses
+ * @param iEncodeNs
+ * @param iDecodeNs
+ */
+void report(const char* iName, const std::size_t& iBytes, const std::size_t& iCount, const std::uint64_t& iEncodeNs,
+            const std::uint64_t& iDecodeNs) {
+  const double count = static_cast<double>(iCount);
+  std::printf("%-22s %10.1f %12.1f %12.1f %12.0f %12.0f\n", iName, static_cast<double>(iBytes) / count,
+              static_cast<double>(iEncodeNs) / count, static_cast<double>(iDecodeNs) / count,
+              static_cast<double>(iBytes) * 1e3 / static_cast<double>(iEncodeNs),
+              static_cast<double>(iBytes) * 1e3 / static_cast<double>(iDecodeNs));
+}
+
+
+} // namespace bench
+} // namespace ncs
+
+
+/**
+ * @brief
+ */
+int main(int argc, char** argv) {
+  using namespace ncs;
+  const std::size_t count = std::max<std::size_t>((argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 10000, 1);
+  const std::size_t rounds = std::max<std::size_t>((argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 3, 1);
+
+  std::vector<addr::InternetAddress> peers;
+  std::vector<addr::inet_address_t> binaries(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    peers.emplace_back(bench::peer_ip(i), 1024 + static_cast<int>(i % 60000));
+    if (!addr::to_inet_address(peers.back(), binaries[i])) {
+      std::fprintf(stderr, "bad address %s\n", peers.back().to_string().c_str());
+      return 1;
+    }
+  }
+
+  std::printf("%-22s %10s %12s %12s %12s %12s\n", "format", "bytes/addr", "encode_ns", "decode_ns", "encode_MB/s",
+              "decode_MB/s");
+  std::string text;
+  std::vector<addr::InternetAddress> parsed;
+  const std::uint64_t textEncode = bench::best_ns(rounds, [&]() {
+    text.clear();
+    for (const addr::InternetAddress& peer : peers) {
+      text += peer.to_string();
+      text += '\n';
+    }
+  });
+  const std::uint64_t textDecode = bench::best_ns(rounds, [&]() {
+    bench::parse_lines(text, parsed);
+  });
+  bench::report("text to_string()", text.size(), count, textEncode, textDecode);
+
+  std::vector<std::uint8_t> wire;
+  std::vector<addr::InternetAddress> decoded;
+  bool ok = true;
+  const std::uint64_t addressEncode = bench::best_ns(rounds, [&]() {
+    wire.clear();
+    ok = addr::encode_addresses(peers, wire) && ok;
+  });
+  const std::uint64_t addressDecode = bench::best_ns(rounds, [&]() {
+    ok = (addr::decode_addresses(wire.data(), wire.size(), decoded) == wire.size()) && ok;
+  });
+  bench::report("binary InternetAddress", wire.size(), count, addressEncode, addressDecode);
+
+  std::vector<addr::inet_address_t> decodedBinaries;
+  const std::uint64_t binaryEncode = bench::best_ns(rounds, [&]() {
+    wire.clear();
+    addr::encode_addresses(binaries, wire);
+  });
+  const std::uint64_t binaryDecode = bench::best_ns(rounds, [&]() {
+    ok = (addr::decode_addresses(wire.data(), wire.size(), decodedBinaries) == wire.size()) && ok;
+  });
+  bench::report("binary inet_address_t", wire.size(), count, binaryEncode, binaryDecode);
+
+  // inet_ntop(3) spells some IPv6 addresses differently, compare them by value
+  const auto same = [&peers](const std::vector<addr::InternetAddress>& iAddrs) {
+    return std::equal(iAddrs.begin(), iAddrs.end(), peers.begin(), peers.end(),
+                      [](const addr::InternetAddress& iLeft, const addr::InternetAddress& iRight) {
+                        return iLeft.compare(iRight) == 0;
+                      });
+  };
+  if (!ok || !same(parsed) || !same(decoded) || (decodedBinaries.size() != count)) {
+    std::fprintf(stderr, "round trip mismatch\n");
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,221 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file AddressNormalization_benchmark.cpp
+ *
+ * @brief Cost of normalizing addresses into their canonical key, and what comparing and hashing the key saves
+ *
+ * Usage: AddressNormalization_benchmark [peers] [rounds]
+ *
+ * Every peer is written four ways, the way peer lists from different sources spell them: IPv4 peers dotted and IPv4
+ * mapped, IPv6 peers compressed and fully expanded in upper case, each spelling twice. The first table normalizes
+ * them from text and from sockaddr, and shows the checks InternetAddress used to redo on every call, the family
+ * through std::regex and the sockaddr through inet_pton(3). The second one compares and hashes them, by text as
+ * before and by key. The last line counts the distinct peers a cache keyed by each of them would hold, and by the key
+ * with IPv4 mapped addresses folded.
+ */
+
+
+#include <BenchmarkUtils.h>
+#include <InternetAddress.h>
+
+#include <arpa/inet.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <regex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+
+namespace ncs { // Network Communications System
+namespace bench { // Network Communications System Benchmarks
+
+
+/**
+ * @brief Spellings of the i-th peer
+ *
+ * @param iPeer
+ *
+ * @return
+ */
+std::vector<addr::ip_t> spellings(const std::size_t& iPeer) {
+  char text[64];
+  if (iPeer % 4 == 3) {
+    const unsigned high = static_cast<unsigned>((iPeer >> 16) & 0xffff);
+    const unsigned low = static_cast<unsigned>(iPeer & 0xffff);
+    std::snprintf(text, sizeof(text), "2001:db8:%x::%x", high, low);
+    const addr::ip_t compressed = text;
+    std::snprintf(text, sizeof(text), "2001:0DB8:%04X:0000:0000:0000:0000:%04X", high, low);
+    return {compressed, text};
+  }
+  std::snprintf(text, sizeof(text), "10.%zu.%zu.%zu", (iPeer >> 16) & 0xff, (iPeer >> 8) & 0xff, iPeer & 0xff);
+  const addr::ip_t dotted = text;
+  return {dotted, "::ffff:" + dotted};
+}
+
+/**
+ * @brief Family check InternetAddress ran on every call before the canonical key
+ *
+ * @param iIp
+ *
+ * @return
+ */
+addr::addr_family_e regex_family(const addr::ip_t& iIp) {
+  const std::regex IPV4_PATTERN("^(25[0-5]|2[0-4][0-9]|1[0-9]{2}|[1-9]?[0-9])(\\.(25[0-5]|2[0-4][0-9]|1[0-9]{2}|"
+                                "[1-9]?[0-9])){3}$");
+  if (std::regex_match(iIp, IPV4_PATTERN)) {
+    return addr::NET_ADDR_FAM_INET;
+  }
+  const std::regex IPV6_PATTERN("^(([0-9A-Fa-f]{1,4}:){7}([0-9A-Fa-f]{1,4})|(([0-9A-Fa-f]{1,4}:){1,7}:)|"
+                                "(([0-9A-Fa-f]{1,4}:){1,6}:([0-9A-Fa-f]{1,4}))|(::([0-9A-Fa-f]{1,4}:){1,5})|::)$");
+  return std::regex_match(iIp, IPV6_PATTERN) ? addr::NET_ADDR_FAM_INET6 : addr::NET_ADDR_FAM_UNKNOWN;
+}
+
+/**
+ * @brief Sockaddr conversion InternetAddress ran on every call before the canonical key
+ *
+ * @param iIp
+ * @param oAddr
+ *
+ * @return
+ */
+bool pton_sockaddr(const addr::ip_t& iIp, sockaddr_storage& oAddr) {
+  return (inet_pton(AF_INET, iIp.c_str(), &reinterpret_cast<sockaddr_in&>(oAddr).sin_addr) == 1) ||
+         (inet_pton(AF_INET6, iIp.c_str(), &reinterpret_cast<sockaddr_in6&>(oAddr).sin6_addr) == 1);
+}
+
+/**
+ * @brief Text key of an address, what a cache keyed by text stores
+ *
+ * @param iAddr
+ *
+ * @return
+ */
+std::string text_key(const addr::InternetAddress& iAddr) {
+  return iAddr.get_ip() + '#' + std::to_string(iAddr.get_port());
+}
+
+/**
+ * @brief Prints one row
+ *
+ * @param iName
+ * @param iNs
+ */
+void report(const char* iName, const double& iNs) {
+  std::printf("%-30s %12.2f\n", iName, iNs);
+}
+
+
+} // namespace bench
+} // namespace ncs
+
+
+/**
+ * @brief
+ */
+int main(int argc, char** argv) {
+  using namespace ncs;
+  const std::size_t peers = std::max<std::size_t>((argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 10000, 1);
+  const std::size_t rounds = std::max<std::size_t>((argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 20, 1);
+
+  std::vector<addr::ip_t> ips;
+  for (std::size_t i = 0; i < peers; ++i) {
+    for (const addr::ip_t& ip : bench::spellings(i)) {
+      ips.push_back(ip);
+      ips.push_back(ip);
+    }
+  }
+  std::vector<addr::InternetAddress> addrs;
+  std::vector<sockaddr_storage> storages(ips.size());
+  std::vector<socklen_t> sizes(ips.size());
+  for (std::size_t i = 0; i < ips.size(); ++i) {
+    addrs.emplace_back(ips[i], 1024 + static_cast<int>(i / 4 % 60000));
+    if (!addrs.back().to_sockaddr(storages[i], sizes[i])) {
+      std::fprintf(stderr, "bad address %s\n", ips[i].c_str());
+      return 1;
+    }
+  }
+  const double count = static_cast<double>(ips.size());
+
+  std::printf("%-30s %12s\n", "normalize", "ns/address");
+  addr::InternetAddress target;
+  bench::report("from text", bench::ns_per_op(rounds, [&](const std::size_t&) {
+    for (const addr::ip_t& ip : ips) {
+      target.set_ip(ip);
+      bench::do_not_optimize(target);
+    }
+  }) / count);
+  bench::report("from sockaddr", bench::ns_per_op(rounds, [&](const std::size_t&) {
+    for (std::size_t i = 0; i < storages.size(); ++i) {
+      const bool set = target.set_sockaddr(reinterpret_cast<const sockaddr*>(&storages[i]), sizes[i]);
+      bench::do_not_optimize(set);
+    }
+  }) / count);
+  // A single round, the regexes are built on every call like they were
+  bench::report("former family check (regex)", bench::ns_per_op(1, [&](const std::size_t&) {
+    for (const addr::ip_t& ip : ips) {
+      const addr::addr_family_e family = bench::regex_family(ip);
+      bench::do_not_optimize(family);
+    }
+  }) / count);
+  sockaddr_storage storage;
+  bench::report("former to_sockaddr (pton)", bench::ns_per_op(rounds, [&](const std::size_t&) {
+    for (const addr::ip_t& ip : ips) {
+      const bool parsed = bench::pton_sockaddr(ip, storage);
+      bench::do_not_optimize(parsed);
+    }
+  }) / count);
+  socklen_t size = 0;
+  bench::report("to_sockaddr (key)", bench::ns_per_op(rounds, [&](const std::size_t&) {
+    for (const addr::InternetAddress& addr : addrs) {
+      const bool built = addr.to_sockaddr(storage, size);
+      bench::do_not_optimize(built);
+    }
+  }) / count);
+
+  std::printf("\n%-30s %12s\n", "compare and hash", "ns/address");
+  std::size_t equal = 0;
+  bench::report("== by text", bench::ns_per_op(rounds, [&](const std::size_t&) {
+    for (std::size_t i = 1; i < addrs.size(); ++i) {
+      equal += ((addrs[i].get_ip() == addrs[i - 1].get_ip()) && (addrs[i].get_port() == addrs[i - 1].get_port()));
+    }
+  }) / count);
+  bench::report("== by key", bench::ns_per_op(rounds, [&](const std::size_t&) {
+    for (std::size_t i = 1; i < addrs.size(); ++i) {
+      equal += (addrs[i] == addrs[i - 1]);
+    }
+  }) / count);
+  std::size_t hashes = 0;
+  bench::report("hash of the text", bench::ns_per_op(rounds, [&](const std::size_t&) {
+    for (const addr::InternetAddress& addr : addrs) {
+      hashes += std::hash<std::string>()(bench::text_key(addr));
+    }
+  }) / count);
+  const addr::internet_address_hash_t hash;
+  bench::report("hash of the key", bench::ns_per_op(rounds, [&](const std::size_t&) {
+    for (const addr::InternetAddress& addr : addrs) {
+      hashes += hash(addr);
+    }
+  }) / count);
+  bench::do_not_optimize(equal);
+  bench::do_not_optimize(hashes);
+
+  std::unordered_set<std::string> byText;
+  std::unordered_set<addr::InternetAddress, addr::internet_address_hash_t> byKey;
+  std::unordered_set<addr::InternetAddress, addr::folded_address_hash_t, addr::folded_address_equal_t> byFolded;
+  for (const addr::InternetAddress& addr : addrs) {
+    byText.insert(bench::text_key(addr));
+    byKey.insert(addr);
+    byFolded.insert(addr);
+  }
+  std::printf("\n%zu peers, %zu addresses: %zu distinct by text, %zu by key, %zu folded\n", peers, addrs.size(),
+              byText.size(), byKey.size(), byFolded.size());
+  return (byFolded.size() == peers) ? 0 : 1;
+}
@@ -0,0 +1,134 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file AddressPool_benchmark.cpp
+ *
+ * @brief Memory and compare cost of a million connection endpoints, owned strings against an AddressPool
+ *
+ * Usage: AddressPool_benchmark [connections] [clients]
+ *
+ * The connections come from a few thousand distinct client ips, every fourth one IPv6, as behind carrier grade NATs.
+ * Heap usage is read from mallinfo2() before and after building each table.
+ */
+
+
+#include <AddressPool.h>
+#include <BenchmarkUtils.h>
+#include <FixedAddress.h>
+#include <InternetAddress.h>
+
+#include <malloc.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+
+namespace ncs { // Network Communications System
+namespace bench { // Network Communications System Benchmarks
+
+
+/**
+ * @brief Bytes allocated right now, large blocks are mapped apart from the heap
+ *
+ * @return
+ */
+std::size_t heap_in_use(void) {
+  const struct mallinfo2 info = mallinfo2();
+  return info.uordblks + info.hblkhd;
+}
+
+/**
+ * @brief Ip of the i-th client
+ *
+ * @param iClient
+ *
+ * @return
+ */
+addr::ip_t client_ip(const std::size_t& iClient) {
+  if (iClient % 4 == 3) {
+    return "2001:db8:" + std::to_string(iClient % 0xffff) + "::" + std::to_string(iClient + 1);
+  }
+  return "100.64." + std::to_string((iClient / 256) % 256) + "." + std::to_string(iClient % 256);
+}
+
+/**
+ * @brief Prints one row
+ *
+ * @param iName
+ * @param iBytes
+ * @param iConnections
+ * @param iCompareNs
+ */
+void report(const char* iName, const std::size_t& iBytes, const std::size_t& iConnections, const double& iCompareNs) {
+  std::printf("%-16s %12.1f %14.1f %12.2f\n", iName, static_cast<double>(iBytes) / (1024.0 * 1024.0),
+              static_cast<double>(iBytes) / static_cast<double>(iConnections), iCompareNs);
+}
+
+
+} // namespace bench
+} // namespace ncs
+
+
+/**
+ * @brief
+ */
+int main(int argc, char** argv) {
+  using namespace ncs;
+  const std::size_t connections = std::max<std::size_t>((argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 1000000, 1);
+  const std::size_t clients = std::max<std::size_t>((argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 4096, 1);
+
+  // Encoded once up front, the tables below are built from what accept(2) would return
+  std::vector<addr::inet_address_t> peers;
+  for (std::size_t i = 0; i < clients; ++i) {
+    addr::inet_address_t peer;
+    if (!addr::to_inet_address({bench::client_ip(i), 1024 + static_cast<int>(i % 60000)}, peer)) {
+      std::fprintf(stderr, "bad address %s\n", bench::client_ip(i).c_str());
+      return 1;
+    }
+    peers.push_back(peer);
+  }
+
+  std::printf("%-16s %12s %14s %12s\n", "storage", "heap_MiB", "bytes/conn", "compare_ns");
+  std::size_t matches = 0;
+  {
+    const std::size_t before = bench::heap_in_use();
+    std::vector<addr::InternetAddress> owned;
+    owned.reserve(connections);
+    for (std::size_t i = 0; i < connections; ++i) {
+      owned.emplace_back();
+      socklen_t size = 0;
+      (void)owned.back().set_sockaddr(addr::get_sockaddr(peers[i % clients], size), size);
+    }
+    const std::size_t bytes = bench::heap_in_use() - before;
+    const double compareNs = bench::ns_per_op(connections, [&](const std::size_t& iIndex) {
+      matches += (owned[iIndex].get_ip() == owned[0].get_ip()) ? 1 : 0;
+    });
+    bench::report("owned strings", bytes, connections, compareNs);
+  }
+  {
+    const std::size_t before = bench::heap_in_use();
+    addr::AddressPool pool;
+    std::vector<addr::pooled_address_t> pooled;
+    pooled.reserve(connections);
+    const std::uint64_t start = bench::now_ns();
+    for (std::size_t i = 0; i < connections; ++i) {
+      socklen_t size = 0;
+      const sockaddr* peer = addr::get_sockaddr(peers[i % clients], size);
+      pooled.push_back({pool.intern(peer, size), static_cast<std::uint16_t>(1024 + i % 60000)});
+    }
+    const double internNs = static_cast<double>(bench::now_ns() - start) / static_cast<double>(connections);
+    const std::size_t bytes = bench::heap_in_use() - before;
+    const double compareNs = bench::ns_per_op(connections, [&](const std::size_t& iIndex) {
+      matches += (pooled[iIndex].ip == pooled[0].ip) ? 1 : 0;
+    });
+    bench::report("address pool", bytes, connections, compareNs);
+    std::printf("pool entries %zu, intern %.1f ns\n", pool.get_size(), internNs);
+  }
+  bench::do_not_optimize(matches);
+  return 0;
+}
@@ -0,0 +1,132 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file AddressSort_benchmark.cpp
+ *
+ * @brief Time to sort and dedupe a peer list with std::sort and with the radix sort of AddressSort.h
+ *
+ * Usage: AddressSort_benchmark [addresses] [clients]
+ *
+ * The list holds repeated peers from a pool of clients, every fourth one IPv6. The string rows sort on the text of
+ * the ip then the port, which is neither numeric order nor spelling independent but the cheapest order at hand before
+ * InternetAddress::compare() existed. The compare rows use operator<, which parses both sides on every comparison.
+ */
+
+
+#include <AddressSort.h>
+#include <BenchmarkUtils.h>
+#include <InternetAddress.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+
+namespace ncs { // Network Communications System
+namespace bench { // Network Communications System Benchmarks
+
+
+/**
+ * @brief Ip of the i-th client
+ *
+ * @param iClient
+ *
+ * @return
+ */
+addr::ip_t client_ip(const std::size_t& iClient) {
+  if (iClient % 4 == 3) {
+    char text[INET6_ADDRSTRLEN];
+    std::snprintf(text, sizeof(text), "2001:db8:%zx::%zx", (iClient >> 16) & 0xffff, iClient & 0xffff);
+    return text;
+  }
+  return "100.64." + std::to_string((iClient / 256) % 256) + "." + std::to_string(iClient % 256);
+}
+
+/**
+ * @brief Text order of the ip, then the port
+ *
+ * @param iLeft
+ * @param iRight
+ *
+ * @return
+ */
+bool string_less(const addr::InternetAddress& iLeft, const addr::InternetAddress& iRight) {
+  const int byIp = iLeft.get_ip().compare(iRight.get_ip());
+  return (byIp != 0) ? (byIp < 0) : (iLeft.get_port() < iRight.get_port());
+}
+
+/**
+ * @brief Milliseconds taken by iOperation on a fresh copy of iAddresses
+ *
+ * @param iAddresses
+ * @param iOperation
+ *
+ * @return
+ */
+template <typename Operation>
+double time_ms(const std::vector<addr::InternetAddress>& iAddresses, Operation&& iOperation) {
+  std::vector<addr::InternetAddress> addresses = iAddresses;
+  const std::uint64_t start = now_ns();
+  iOperation(addresses);
+  const double ms = static_cast<double>(now_ns() - start) / 1e6;
+  do_not_optimize(addresses.size());
+  return ms;
+}
+
+/**
+ * @brief Prints one row
+ *
+ * @param iName
+ * @param iMs
+ * @param iAddresses
+ */
+void report(const char* iName, const double& iMs, const std::size_t& iAddresses) {
+  std::printf("%-22s %12.1f %12.1f\n", iName, iMs, iMs * 1e6 / static_cast<double>(iAddresses));
+}
+
+
+} // namespace bench
+} // namespace ncs
+
+
+/**
+ * @brief
+ */
+int main(int argc, char** argv) {
+  using namespace ncs;
+  const std::size_t count = std::max<std::size_t>((argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 2000000, 1);
+  const std::size_t clients = std::max<std::size_t>((argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 500000, 1);
+
+  std::mt19937_64 random(7);
+  std::vector<addr::InternetAddress> addresses;
+  addresses.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    const std::size_t client = random() % clients;
+    addresses.emplace_back(bench::client_ip(client), 1024 + static_cast<int>(client % 16));
+  }
+
+  std::printf("%-22s %12s %12s\n", "operation", "ms", "ns/address");
+  bench::report("std::sort strings", bench::time_ms(addresses, [](std::vector<addr::InternetAddress>& ioAddresses) {
+    std::sort(ioAddresses.begin(), ioAddresses.end(), bench::string_less);
+  }), count);
+  bench::report("std::sort compare", bench::time_ms(addresses, [](std::vector<addr::InternetAddress>& ioAddresses) {
+    std::sort(ioAddresses.begin(), ioAddresses.end());
+  }), count);
+  bench::report("radix sort", bench::time_ms(addresses, [](std::vector<addr::InternetAddress>& ioAddresses) {
+    addr::sort_addresses(ioAddresses);
+  }), count);
+  bench::report("dedupe strings", bench::time_ms(addresses, [](std::vector<addr::InternetAddress>& ioAddresses) {
+    std::sort(ioAddresses.begin(), ioAddresses.end(), bench::string_less);
+    ioAddresses.erase(std::unique(ioAddresses.begin(), ioAddresses.end()), ioAddresses.end());
+  }), count);
+  bench::report("dedupe radix", bench::time_ms(addresses, [](std::vector<addr::InternetAddress>& ioAddresses) {
+    (void)addr::unique_addresses(ioAddresses);
+  }), count);
+  return 0;
+}
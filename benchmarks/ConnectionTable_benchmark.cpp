@@ -0,0 +1,145 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file ConnectionTable_benchmark.cpp
+ *
+ * @brief Housekeeping scan rates over a million connections, one object per connection against a ConnectionTable
+ *
+ * Usage: ConnectionTable_benchmark [connections] [rounds]
+ *
+ * The object rows keep every connection as a heap allocated InternetSocket next to its state, timestamp and counters,
+ * the way a server holding a map of sockets does. The table rows keep the same fields column by column. Each round
+ * runs an idle sweep, which only reads the timestamps, and an aggregation over states and counters.
+ */
+
+
+#include <BenchmarkUtils.h>
+#include <ConnectionTable.h>
+#include <FixedAddress.h>
+#include <InternetSocket.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace ncs { // Network Communications System
+namespace bench { // Network Communications System Benchmarks
+
+
+/**
+ * @brief One connection as an object, for comparison
+ */
+struct connection_object_t {
+  sock::InternetSocket socket;
+  sock::connection_state_e state = sock::CONNECTION_OPEN;
+  std::uint64_t last_active = 0;
+  std::uint64_t bytes_in = 0;
+  std::uint64_t bytes_out = 0;
+};
+
+
+/**
+ * @brief Activity timestamp of the i-th connection, one in sixteen has been idle for long
+ *
+ * @param iIndex
+ *
+ * @return
+ */
+std::uint64_t last_active(const std::size_t& iIndex) {
+  return (iIndex % 16 == 0) ? 1000 : 2000000 - iIndex % 1000;
+}
+
+/**
+ * @brief Prints one row
+ *
+ * @param iName
+ * @param iNs Per connection cost
+ */
+void report(const char* iName, const double& iNs) {
+  std::printf("%-22s %10.2f %14.1f\n", iName, iNs, 1000.0 / iNs);
+}
+
+
+} // namespace bench
+} // namespace ncs
+
+
+/**
+ * @brief
+ */
+int main(int argc, char** argv) {
+  using namespace ncs;
+  const std::size_t connections = std::max<std::size_t>((argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 1000000, 1);
+  const std::size_t rounds = std::max<std::size_t>((argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 20, 1);
+  const std::uint64_t now = 2000000;
+  const std::uint64_t idleNs = 500000;
+
+  std::vector<std::unique_ptr<bench::connection_object_t>> objects;
+  sock::ConnectionTable table;
+  table.reserve(connections);
+  for (std::size_t i = 0; i < connections; ++i) {
+    const addr::InternetAddress peer("100.64." + std::to_string((i / 256) % 256) + "." + std::to_string(i % 256),
+                                     1024 + static_cast<int>(i % 60000));
+    objects.push_back(std::make_unique<bench::connection_object_t>());
+    objects.back()->socket.set_addr(peer);
+    objects.back()->last_active = bench::last_active(i);
+    objects.back()->bytes_in = i;
+
+    addr::inet_address_t binary;
+    socklen_t size = 0;
+    if (!addr::to_inet_address(peer, binary)) {
+      std::fprintf(stderr, "bad address %s\n", peer.to_string().c_str());
+      return 1;
+    }
+    const sock::sd_t sd = static_cast<sock::sd_t>(i);
+    const sock::connection_handle_t handle = table.insert(sd, addr::get_sockaddr(binary, size), size, 0);
+    (void)table.touch(handle, bench::last_active(i), i, 0);
+  }
+
+  std::printf("%-22s %10s %14s\n", "scan", "ns/conn", "M conn/s");
+  std::vector<sock::connection_handle_t> idle;
+  const double objectSweepNs = bench::ns_per_op(rounds, [&](const std::size_t&) {
+    idle.clear();
+    for (std::size_t i = 0; i < objects.size(); ++i) {
+      if (now - objects[i]->last_active > idleNs) {
+        idle.push_back(i);
+      }
+    }
+    bench::do_not_optimize(idle.size());
+  }) / static_cast<double>(connections);
+  bench::report("objects idle sweep", objectSweepNs);
+
+  const double tableSweepNs = bench::ns_per_op(rounds, [&](const std::size_t&) {
+    bench::do_not_optimize(table.sweep_idle(now, idleNs, idle));
+  }) / static_cast<double>(connections);
+  bench::report("table idle sweep", tableSweepNs);
+
+  const double objectAggregateNs = bench::ns_per_op(rounds, [&](const std::size_t&) {
+    sock::connection_totals_t totals;
+    for (const std::unique_ptr<bench::connection_object_t>& object : objects) {
+      ++totals.connections;
+      ++totals.states[object->state];
+      totals.bytes_in += object->bytes_in;
+      totals.bytes_out += object->bytes_out;
+    }
+    bench::do_not_optimize(totals);
+  }) / static_cast<double>(connections);
+  bench::report("objects aggregate", objectAggregateNs);
+
+  const double tableAggregateNs = bench::ns_per_op(rounds, [&](const std::size_t&) {
+    bench::do_not_optimize(table.aggregate());
+  }) / static_cast<double>(connections);
+  bench::report("table aggregate", tableAggregateNs);
+
+  const std::size_t rowBytes = sizeof(sock::sd_t) + sizeof(addr::pooled_address_t) + sizeof(std::uint8_t) +
+                               3 * sizeof(std::uint64_t) + sizeof(std::uint32_t);
+  std::printf("idle %zu of %zu, object %zu B + heap, row %zu B\n", idle.size(), connections,
+              sizeof(bench::connection_object_t), rowBytes);
+  return 0;
+}
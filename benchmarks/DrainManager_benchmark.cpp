@@ -0,0 +1,285 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file DrainManager_benchmark.cpp
+ *
+ * @brief Shutting down loops full of connections with queued replies, closing them at once or draining them
+ *
+ * Usage: DrainManager_benchmark [connections] [loops] [payload]
+ *
+ * Every connection accepted by a server loop is sent payload bytes, far more than the socket buffers take, so most
+ * of each reply is still queued in its WriteBatcher when the shutdown starts. The clients run on their own loop, read
+ * until the end of the stream and then close. The close row closes every server socket and listener at once, the
+ * drain rows hand the connections to a DrainManager over one loop and over all of them. Each row reports the time
+ * until the servers closed everything, how much of the replies reached the clients, how many clients saw a reset
+ * instead of the end of the stream, and the descriptors still open once the clients are done.
+ */
+
+
+#include <Acceptor.h>
+#include <BenchmarkUtils.h>
+#include <DrainManager.h>
+#include <EventLoop.h>
+#include <WriteBatcher.h>
+
+#include <dirent.h>
+#include <sys/epoll.h>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+namespace ncs { // Network Communications System
+namespace bench { // Network Communications System Benchmarks
+
+
+/**
+ * DrainManager benchmark constants
+ */
+constexpr std::chrono::milliseconds DRAIN_DEADLINE{10000};
+constexpr std::size_t CLIENT_READ_SIZE = 65536;
+
+/**
+ * @brief Server side of one accepted connection
+ */
+struct session_t {
+  sock::InternetSocket socket;
+  std::unique_ptr<sock::WriteBatcher> writes;
+};
+
+/**
+ * @brief Server loop running on its own thread
+ */
+struct server_t {
+  server_t() : acceptor(loop) {
+    thread = std::thread([this]() {
+      loop.run();
+    });
+  }
+
+  ~server_t() {
+    loop.stop();
+    thread.join();
+  }
+
+  sock::EventLoop loop;
+  sock::Acceptor acceptor;
+  std::vector<std::unique_ptr<session_t>> sessions;
+  std::atomic<std::size_t> accepted{0};
+  std::thread thread;
+};
+
+/**
+ * @brief Client side of every connection, all of them on one loop
+ */
+struct clients_t {
+  std::vector<sock::InternetSocket> sockets;
+  std::uint64_t received = 0;
+  std::atomic<std::size_t> ended{0};
+  std::atomic<std::size_t> reset{0};
+};
+
+/**
+ * @brief Measured results of one shutdown
+ */
+struct result_t {
+  std::uint64_t shutdown_ns = 0;
+  std::uint64_t received = 0;
+  std::size_t reset = 0;
+  long open_fds = 0;
+};
+
+
+/**
+ * @brief Descriptors this process has open
+ *
+ * @return
+ */
+long count_fds(void) {
+  long count = 0;
+  DIR* dir = opendir("/proc/self/fd");
+  if (dir == nullptr) {
+    return -1;
+  }
+  while (readdir(dir) != nullptr) {
+    ++count;
+  }
+  closedir(dir);
+  return count;
+}
+
+/**
+ * @brief Waits until iCounter reaches iCount
+ *
+ * @param iCounter
+ * @param iCount
+ */
+void wait_for(const std::atomic<std::size_t>& iCounter, const std::size_t& iCount) {
+  while (iCounter.load() < iCount) {
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+}
+
+/**
+ * @brief Opens iConnections across iLoops server loops, then shuts them down
+ *
+ * @param iConnections
+ * @param iLoops
+ * @param iPayload
+ * @param iDrain False closes everything at once
+ *
+ * @return
+ */
+result_t run(const std::size_t& iConnections, const std::size_t& iLoops, const std::size_t& iPayload,
+             const bool& iDrain) {
+  result_t result;
+  sock::drain_config_t config;
+  config.deadline = DRAIN_DEADLINE;
+  sock::DrainManager manager(config);
+  std::vector<std::unique_ptr<server_t>> servers;
+  std::vector<std::size_t> indexes;
+  for (std::size_t i = 0; i < iLoops; ++i) {
+    servers.push_back(std::make_unique<server_t>());
+    indexes.push_back(manager.add_loop(servers.back()->loop));
+    manager.add_acceptor(indexes.back(), servers.back()->acceptor);
+  }
+  sock::EventLoop clientLoop;
+  clients_t clients;
+  clients.sockets.resize(iConnections);
+  const long baseline = count_fds();
+
+  const std::vector<std::uint8_t> reply(iPayload, 'x');
+  for (std::size_t i = 0; i < iLoops; ++i) {
+    server_t& server = *servers[i];
+    const std::size_t index = indexes[i];
+    const sock::accept_handler_t onAccept = [&, index](sock::InternetSocket&& ioClient) {
+      server.sessions.push_back(std::make_unique<session_t>());
+      session_t& session = *server.sessions.back();
+      session.socket = std::move(ioClient);
+      session.writes = std::make_unique<sock::WriteBatcher>(session.socket);
+      (void)session.writes->write(reply.data(), reply.size());
+      (void)session.writes->flush();
+      (void)server.loop.add(session.socket.get_sd(), EPOLLIN, [](const std::uint32_t&) {});
+      manager.track(index, session.socket, session.writes.get());
+      ++server.accepted;
+    };
+    if (!server.acceptor.listen({"127.0.0.1", addr::RANDOM_PORT}, onAccept)) {
+      std::perror("listen");
+      return result;
+    }
+  }
+  for (std::size_t i = 0; i < iConnections; ++i) {
+    if (!clients.sockets[i].connect(servers[i % iLoops]->acceptor.get_listener().get_addr())) {
+      std::perror("connect");
+      return result;
+    }
+  }
+  for (std::size_t i = 0; i < iLoops; ++i) {
+    wait_for(servers[i]->accepted, (iConnections - i + iLoops - 1) / iLoops);
+  }
+
+  // The clients read until the end of the stream, then close their side
+  for (sock::InternetSocket& client : clients.sockets) {
+    const sock::sd_t sd = client.get_sd();
+    (void)client.set_non_blocking(true);
+    (void)clientLoop.add(sd, EPOLLIN, [&clients, &clientLoop, &client, sd](const std::uint32_t&) {
+      static char buffer[CLIENT_READ_SIZE];
+      const ssize_t got = client.recv(buffer, sizeof(buffer));
+      if (got > 0) {
+        clients.received += static_cast<std::uint64_t>(got);
+        return;
+      }
+      if ((got < 0) && ((errno == EAGAIN) || (errno == EINTR))) {
+        return;
+      }
+      ++((got == 0) ? clients.ended : clients.reset);
+      (void)clientLoop.remove(sd);
+      client.close();
+    });
+  }
+  std::atomic<bool> stop(false);
+  std::thread clientThread([&]() {
+    while (!stop.load()) {
+      (void)clientLoop.run_once(10);
+    }
+  });
+
+  const std::uint64_t start = now_ns();
+  if (iDrain) {
+    (void)manager.drain();
+    (void)manager.wait(DRAIN_DEADLINE * 2);
+  } else {
+    std::atomic<std::size_t> closed(0);
+    for (std::unique_ptr<server_t>& server : servers) {
+      server_t* target = server.get();
+      target->loop.post([target, &closed]() {
+        target->acceptor.close();
+        for (std::unique_ptr<session_t>& session : target->sessions) {
+          (void)target->loop.remove(session->socket.get_sd());
+          session->writes->clear();
+          session->socket.close();
+        }
+        ++closed;
+      });
+    }
+    wait_for(closed, iLoops);
+  }
+  result.shutdown_ns = now_ns() - start;
+
+  while (clients.ended.load() + clients.reset.load() < iConnections) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  stop = true;
+  clientThread.join();
+  result.received = clients.received;
+  result.reset = clients.reset.load();
+  result.open_fds = count_fds() - baseline;
+  return result;
+}
+
+/**
+ * @brief Prints one row
+ *
+ * @param iName
+ * @param iResult
+ * @param iConnections
+ * @param iPayload
+ */
+void report(const char* iName, const result_t& iResult, const std::size_t& iConnections,
+            const std::size_t& iPayload) {
+  std::printf("%-18s %12.1f %11.1f%% %10zu %10ld\n", iName, static_cast<double>(iResult.shutdown_ns) / 1e6,
+              100.0 * static_cast<double>(iResult.received) / static_cast<double>(iConnections * iPayload),
+              iResult.reset, iResult.open_fds);
+}
+
+
+} // namespace bench
+} // namespace ncs
+
+
+/**
+ * @brief
+ */
+int main(int argc, char** argv) {
+  using namespace ncs;
+  const std::size_t connections = std::max<std::size_t>((argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 1000, 1);
+  const std::size_t loops = std::max<std::size_t>((argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 4, 1);
+  const std::size_t payload = std::max<std::size_t>((argc > 3) ? std::strtoul(argv[3], nullptr, 10) : 1 << 20, 1);
+
+  std::printf("%-18s %12s %12s %10s %10s\n", "shutdown", "shutdown_ms", "delivered", "resets", "open_fds");
+  bench::report("close at once", bench::run(connections, loops, payload, false), connections, payload);
+  bench::report("drain, 1 loop", bench::run(connections, 1, payload, true), connections, payload);
+  char name[48];
+  std::snprintf(name, sizeof(name), "drain, %zu loops", loops);
+  bench::report(name, bench::run(connections, loops, payload, true), connections, payload);
+  return 0;
+}
@@ -0,0 +1,345 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file HotRestart_benchmark.cpp
+ *
+ * @brief Requests a client loses while an echo server restarts, cold and with a HotRestart handoff
+ *
+ * Usage: HotRestart_benchmark [seconds] [restarts]
+ *
+ * A client process sends an 8 bytes request on a long lived connection, then another on a fresh connection, and
+ * waits for each echo, over and over. Meanwhile the server restarts the given number of times, each generation a new
+ * process. A cold restart stops the running generation and starts one that binds the port again. A hot one starts
+ * the new generation first, it takes the listener and the open connections over from the running one, which then
+ * stops accepting, closes its copies and exits. A request fails when its connect, send or echo fails, the long lived
+ * connection is opened again after a failure.
+ */
+
+
+#include <Acceptor.h>
+#include <BenchmarkUtils.h>
+#include <EventLoop.h>
+#include <HotRestart.h>
+
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+namespace ncs { // Network Communications System
+namespace bench { // Network Communications System Benchmarks
+
+
+/**
+ * HotRestart benchmark constants
+ */
+constexpr std::size_t REQUEST_BYTES = 8;
+
+/**
+ * @brief What the client process reports back
+ */
+struct client_result_t {
+  std::uint64_t requests = 0;
+  std::uint64_t failures = 0;
+  std::uint64_t p50_ns = 0;
+  std::uint64_t p99_ns = 0;
+  std::uint64_t max_ns = 0;
+};
+
+/**
+ * @brief Generation of the server running in the current process
+ */
+struct generation_t {
+  sock::EventLoop loop;
+  std::vector<sock::InternetSocket> listeners;
+  std::unordered_map<sock::sd_t, sock::InternetSocket> sessions;
+  bool stopping = false;                        // Handed over to a successor
+};
+
+
+/**
+ * @brief Echoes the requests of iSocket from the loop of ioGeneration
+ *
+ * @param ioGeneration
+ * @param iSocket
+ */
+void serve(generation_t& ioGeneration, sock::InternetSocket&& iSocket) {
+  const sock::sd_t sd = iSocket.get_sd();
+  (void)iSocket.set_non_blocking(true);
+  ioGeneration.sessions[sd] = std::move(iSocket);
+  (void)ioGeneration.loop.add(sd, EPOLLIN, [&ioGeneration, sd](const std::uint32_t&) {
+    char buffer[REQUEST_BYTES * 16];
+    sock::InternetSocket& session = ioGeneration.sessions[sd];
+    const ssize_t got = session.recv(buffer, sizeof(buffer));
+    if ((got < 0) && (errno == EAGAIN)) {
+      return;
+    }
+    if ((got <= 0) || !send_all(session, buffer, static_cast<std::size_t>(got))) {
+      (void)ioGeneration.loop.remove(sd);
+      session.close();
+      ioGeneration.sessions.erase(sd);
+    }
+  });
+}
+
+/**
+ * @brief Runs a server generation until it hands over to its successor, or forever if iPath is empty
+ *
+ * @param ioListener Listener of a first or cold generation, nullptr to take over from the one at iPath
+ * @param iPath
+ * @param iReadyFd Written once the generation serves
+ *
+ * @return Exit status
+ */
+int run_generation(sock::InternetSocket* ioListener, const std::string& iPath, const int& iReadyFd) {
+  generation_t generation;
+  std::vector<sock::InternetSocket> connections;
+  if (ioListener != nullptr) {
+    generation.listeners.push_back(std::move(*ioListener));
+  } else if (!sock::HotRestart::take_over(iPath, generation.listeners, connections)) {
+    std::perror("take_over");
+    return 1;
+  }
+  sock::Acceptor acceptor(generation.loop);
+  const sock::accept_handler_t onAccept = [&generation](sock::InternetSocket&& ioClient) {
+    serve(generation, std::move(ioClient));
+  };
+  sock::HotRestart restart;
+  if (!acceptor.attach(generation.listeners[0], onAccept) || (!iPath.empty() && !restart.listen(iPath))) {
+    std::perror("serve");
+    return 1;
+  }
+  for (sock::InternetSocket& connection : connections) {
+    serve(generation, std::move(connection));
+  }
+  (void)generation.loop.add(restart.get_sd(), EPOLLIN, [&](const std::uint32_t&) {
+    std::vector<const sock::InternetSocket*> open;
+    for (const auto& session : generation.sessions) {
+      open.push_back(&session.second);
+    }
+    generation.stopping = restart.hand_over({&generation.listeners[0]}, open);
+    // Unwatched right away, events of the same iteration must not accept or read anything the successor owns
+    if (generation.stopping) {
+      acceptor.close();
+      for (const auto& session : generation.sessions) {
+        (void)generation.loop.remove(session.first);
+      }
+    }
+  });
+  const char ready = 'r';
+  (void)!write(iReadyFd, &ready, 1);
+  while (!generation.stopping) {
+    (void)generation.loop.run_once(-1);
+  }
+  // Drains: nothing is in flight between two echoes, the successor answers everything from now on
+  generation.listeners[0].close();
+  for (auto& session : generation.sessions) {
+    session.second.close();
+  }
+  return 0;
+}
+
+/**
+ * @brief Starts a generation in a new process and waits until it serves
+ *
+ * @param ioListener
+ * @param iPath
+ *
+ * @return
+ */
+pid_t start_generation(sock::InternetSocket* ioListener, const std::string& iPath) {
+  int ready[2];
+  if (pipe(ready) != 0) {
+    return -1;
+  }
+  const pid_t pid = fork();
+  if (pid == 0) {
+    ::close(ready[0]);
+    _exit(run_generation(ioListener, iPath, ready[1]));
+  }
+  ::close(ready[1]);
+  char byte = 0;
+  const bool started = (pid > 0) && (read(ready[0], &byte, 1) == 1);
+  ::close(ready[0]);
+  return started ? pid : -1;
+}
+
+/**
+ * @brief Sends one request on iSocket and waits for its echo
+ *
+ * @param iSocket
+ *
+ * @return
+ */
+bool request(sock::InternetSocket& iSocket) {
+  static const char payload[REQUEST_BYTES] = {'h', 'o', 't', '-', 'e', 'c', 'h', 'o'};
+  char echo[REQUEST_BYTES];
+  return send_all(iSocket, payload, sizeof(payload)) && receive_all(iSocket, echo, sizeof(echo));
+}
+
+/**
+ * @brief Connects to iAddr with a receive timeout
+ *
+ * @param iAddr
+ * @param oSocket
+ *
+ * @return
+ */
+bool connect(const addr::InternetAddress& iAddr, sock::InternetSocket& oSocket) {
+  const timeval timeout = {1, 0};
+  oSocket.close();
+  return oSocket.open(addr::NET_ADDR_FAM_INET) &&
+         (setsockopt(oSocket.get_sd(), SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) == 0) &&
+         oSocket.connect(iAddr);
+}
+
+/**
+ * @brief Sends requests to iAddr for iSeconds, each one on the long lived connection then on a fresh one
+ *
+ * @param iAddr
+ * @param iSeconds
+ *
+ * @return
+ */
+client_result_t run_client(const addr::InternetAddress& iAddr, const double& iSeconds) {
+  client_result_t result;
+  std::vector<std::uint64_t> latencies;
+  sock::InternetSocket kept;
+  bool connected = connect(iAddr, kept);
+  const std::uint64_t end = now_ns() + static_cast<std::uint64_t>(iSeconds * 1e9);
+  while (now_ns() < end) {
+    std::uint64_t start = now_ns();
+    if (connected && request(kept)) {
+      latencies.push_back(now_ns() - start);
+    } else {
+      ++result.failures;
+      connected = connect(iAddr, kept);
+    }
+    start = now_ns();
+    sock::InternetSocket fresh;
+    if (connect(iAddr, fresh) && request(fresh)) {
+      latencies.push_back(now_ns() - start);
+    } else {
+      ++result.failures;
+    }
+    fresh.close();
+    result.requests += 2;
+  }
+  kept.close();
+  result.p50_ns = percentile(latencies, 0.50);
+  result.p99_ns = percentile(latencies, 0.99);
+  result.max_ns = percentile(latencies, 1.0);
+  return result;
+}
+
+/**
+ * @brief Listener on iAddr, RANDOM_PORT for a new one
+ *
+ * @param iAddr
+ * @param oListener
+ *
+ * @return
+ */
+bool open_listener(const addr::InternetAddress& iAddr, sock::InternetSocket& oListener) {
+  return oListener.open(addr::NET_ADDR_FAM_INET) && oListener.set_option(SOL_SOCKET, SO_REUSEADDR, 1) &&
+         oListener.bind(iAddr) && oListener.listen();
+}
+
+/**
+ * @brief Runs the client against a server restarted iRestarts times, hot or cold
+ *
+ * @param iHot
+ * @param iSeconds
+ * @param iRestarts
+ * @param oResult
+ *
+ * @return
+ */
+bool run(const bool& iHot, const double& iSeconds, const std::size_t& iRestarts, client_result_t& oResult) {
+  const std::string path = "/tmp/ncs_hot_restart_benchmark_" + std::to_string(getpid());
+  sock::InternetSocket listener;
+  if (!open_listener({"127.0.0.1", addr::RANDOM_PORT}, listener)) {
+    std::perror("listen");
+    return false;
+  }
+  const addr::InternetAddress server = listener.get_addr();
+  pid_t current = start_generation(&listener, iHot ? path : "");
+  listener.close();
+  int results[2];
+  if ((current < 0) || (pipe(results) != 0)) {
+    return false;
+  }
+  const pid_t client = fork();
+  if (client == 0) {
+    ::close(results[0]);
+    const client_result_t result = run_client(server, iSeconds);
+    (void)!write(results[1], &result, sizeof(result));
+    _exit(0);
+  }
+  ::close(results[1]);
+
+  const useconds_t period = static_cast<useconds_t>(iSeconds * 1e6 / static_cast<double>(iRestarts + 1));
+  for (std::size_t restart = 0; restart < iRestarts; ++restart) {
+    usleep(period);
+    const pid_t previous = current;
+    if (iHot) {
+      current = start_generation(nullptr, path);
+    } else {
+      kill(previous, SIGKILL);
+      (void)waitpid(previous, nullptr, 0);
+      current = open_listener(server, listener) ? start_generation(&listener, "") : -1;
+      listener.close();
+    }
+    if (current < 0) {
+      std::fprintf(stderr, "restart %zu failed\n", restart);
+      return false;
+    }
+    (void)waitpid(previous, nullptr, 0);
+  }
+  const bool received = read(results[0], &oResult, sizeof(oResult)) == static_cast<ssize_t>(sizeof(oResult));
+  ::close(results[0]);
+  (void)waitpid(client, nullptr, 0);
+  kill(current, SIGKILL);
+  (void)waitpid(current, nullptr, 0);
+  unlink(path.c_str());
+  return received;
+}
+
+
+} // namespace bench
+} // namespace ncs
+
+
+/**
+ * @brief
+ */
+int main(int argc, char** argv) {
+  using namespace ncs;
+  const double seconds = (argc > 1) ? std::atof(argv[1]) : 3.0;
+  const std::size_t restarts = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 10;
+
+  std::printf("%-8s %9s %10s %10s %10s %10s %10s\n", "restart", "restarts", "requests", "failed", "p50_us", "p99_us",
+              "max_us");
+  for (const bool hot : {false, true}) {
+    bench::client_result_t result;
+    if (!bench::run(hot, seconds, restarts, result)) {
+      return 1;
+    }
+    std::printf("%-8s %9zu %10lu %10lu %10.1f %10.1f %10.1f\n", hot ? "hot" : "cold", restarts, result.requests,
+                result.failures, static_cast<double>(result.p50_ns) / 1e3, static_cast<double>(result.p99_ns) / 1e3,
+                static_cast<double>(result.max_ns) / 1e3);
+  }
+  return 0;
+}
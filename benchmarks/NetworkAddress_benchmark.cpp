@@ -0,0 +1,178 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file NetworkAddress_benchmark.cpp
+ *
+ * @brief Cost of resolving the family and sockaddr of an address through virtual calls and at compile time
+ *
+ * Usage: NetworkAddress_benchmark [addresses] [rounds]
+ *
+ * Every round walks a table of mixed IPv4 and IPv6 addresses and copies out the sockaddr of each one, the work a
+ * socket does before every bind(2), connect(2) or sendto(2). The virtual rows reproduce the former NetworkAddress
+ * design: one heap object per address behind a vtable. The variant rows hold the closed set of kinds inline and
+ * dispatch with std::visit, the fixed rows know the family at compile time. InternetAddress, which keeps its text
+ * form next to the canonical key it builds the sockaddr from, is shown for scale.
+ */
+
+
+#include <BenchmarkUtils.h>
+#include <FixedAddress.h>
+#include <InternetAddress.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace ncs { // Network Communications System
+namespace bench { // Network Communications System Benchmarks
+
+
+/**
+ * @brief Former design, the family and the sockaddr behind virtual calls
+ */
+class VirtualAddress {
+public:
+  virtual ~VirtualAddress() = default;
+  [[nodiscard]] virtual addr::addr_family_e get_address_family(void) const = 0;
+  [[nodiscard]] virtual socklen_t to_sockaddr(sockaddr_storage& oAddr) const = 0;
+};
+
+/**
+ * @brief
+ */
+template <addr::addr_family_e Family>
+class VirtualInetAddress : public VirtualAddress {
+public:
+  explicit VirtualInetAddress(const addr::FixedAddress<Family>& iAddr) : addr_(iAddr) {}
+
+  [[nodiscard]] addr::addr_family_e get_address_family(void) const override {
+    return Family;
+  }
+
+  [[nodiscard]] socklen_t to_sockaddr(sockaddr_storage& oAddr) const override {
+    std::memcpy(&oAddr, this->addr_.get_sockaddr(), this->addr_.get_sockaddr_size());
+    return this->addr_.get_sockaddr_size();
+  }
+
+private:
+  addr::FixedAddress<Family> addr_;
+};
+
+
+/**
+ * @brief Text form of the i-th address of the table, every fourth one is IPv6
+ *
+ * @param iIndex
+ *
+ * @return
+ */
+addr::InternetAddress make_address(const std::size_t& iIndex) {
+  const int port = 1024 + static_cast<int>(iIndex % 60000);
+  if (iIndex % 4 == 3) {
+    return {"2001:db8::" + std::to_string(iIndex % 0xffff + 1), port};
+  }
+  return {"10.0." + std::to_string((iIndex / 256) % 256) + "." + std::to_string(iIndex % 256), port};
+}
+
+/**
+ * @brief Prints one row
+ *
+ * @param iName
+ * @param iBytes Per address footprint
+ * @param iNs
+ */
+void report(const char* iName, const std::size_t& iBytes, const double& iNs) {
+  std::printf("%-24s %10zu %12.2f\n", iName, iBytes, iNs);
+}
+
+
+} // namespace bench
+} // namespace ncs
+
+
+/**
+ * @brief
+ */
+int main(int argc, char** argv) {
+  using namespace ncs;
+  const std::size_t count = std::max<std::size_t>((argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 4096, 1);
+  const std::size_t rounds = std::max<std::size_t>((argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 2000, 1);
+
+  std::vector<addr::InternetAddress> text;
+  std::vector<std::unique_ptr<bench::VirtualAddress>> virtuals;
+  std::vector<addr::inet_address_t> variants;
+  std::vector<addr::Inet4Address> fixed;
+  for (std::size_t i = 0; i < count; ++i) {
+    text.push_back(bench::make_address(i));
+    addr::inet_address_t kind;
+    if (!addr::to_inet_address(text.back(), kind)) {
+      std::fprintf(stderr, "bad address %s\n", text.back().to_string().c_str());
+      return 1;
+    }
+    variants.push_back(kind);
+    if (kind.index() == 0) {
+      virtuals.push_back(std::make_unique<bench::VirtualInetAddress<addr::NET_ADDR_FAM_INET>>(
+          std::get<addr::Inet4Address>(kind)));
+      fixed.push_back(std::get<addr::Inet4Address>(kind));
+    }
+    else {
+      virtuals.push_back(std::make_unique<bench::VirtualInetAddress<addr::NET_ADDR_FAM_INET6>>(
+          std::get<addr::Inet6Address>(kind)));
+    }
+  }
+
+  sockaddr_storage storage;
+  std::printf("%-24s %10s %12s\n", "design", "bytes", "ns/address");
+
+  const double virtualNs = bench::ns_per_op(rounds, [&](const std::size_t&) {
+    for (const std::unique_ptr<bench::VirtualAddress>& addr : virtuals) {
+      const addr::addr_family_e family = addr->get_address_family();
+      const socklen_t size = addr->to_sockaddr(storage);
+      bench::do_not_optimize(family);
+      bench::do_not_optimize(size);
+      bench::do_not_optimize(storage);
+    }
+  }) / static_cast<double>(count);
+  // The object with its vtable pointer, plus the owning pointer in the table
+  bench::report("virtual", sizeof(bench::VirtualInetAddress<addr::NET_ADDR_FAM_INET6>) + sizeof(void*), virtualNs);
+
+  const double variantNs = bench::ns_per_op(rounds, [&](const std::size_t&) {
+    for (const addr::inet_address_t& addr : variants) {
+      socklen_t size = 0;
+      const addr::addr_family_e family = addr::get_address_family(addr);
+      std::memcpy(&storage, addr::get_sockaddr(addr, size), size);
+      bench::do_not_optimize(family);
+      bench::do_not_optimize(size);
+      bench::do_not_optimize(storage);
+    }
+  }) / static_cast<double>(count);
+  bench::report("variant", sizeof(addr::inet_address_t), variantNs);
+
+  const double fixedNs = bench::ns_per_op(rounds, [&](const std::size_t&) {
+    for (const addr::Inet4Address& addr : fixed) {
+      const addr::addr_family_e family = addr.get_address_family();
+      std::memcpy(&storage, addr.get_sockaddr(), addr.get_sockaddr_size());
+      bench::do_not_optimize(family);
+      bench::do_not_optimize(storage);
+    }
+  }) / static_cast<double>(std::max<std::size_t>(fixed.size(), 1));
+  bench::report("fixed (ipv4 only)", sizeof(addr::Inet4Address), fixedNs);
+
+  const double textNs = bench::ns_per_op(rounds, [&](const std::size_t&) {
+    for (const addr::InternetAddress& addr : text) {
+      socklen_t size = 0;
+      const bool valid = addr.to_sockaddr(storage, size);
+      bench::do_not_optimize(valid);
+      bench::do_not_optimize(storage);
+    }
+  }) / static_cast<double>(count);
+  bench::report("InternetAddress", sizeof(addr::InternetAddress), textNs);
+  return 0;
+}
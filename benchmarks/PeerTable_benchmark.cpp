@@ -0,0 +1,172 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file PeerTable_benchmark.cpp
+ *
+ * @brief Warm start of a process from a PeerTable against reloading a text snapshot of the same peers
+ *
+ * Usage: PeerTable_benchmark [peers]
+ *
+ * For tables of 1000 peers up to the given count, ten times more each row, the table is filled with put(), closed,
+ * and opened again, which is what a restarting process pays before it can look its peers up. The text column reads
+ * the same peers back from "ip port rtt last_seen failures" lines into InternetAddress and their metadata, without
+ * even validating them. Lookups are find() of random peers right after open, paging the table in, and compaction
+ * rewrites the table after every peer was updated once.
+ */
+
+
+#include <BenchmarkUtils.h>
+#include <FixedAddress.h>
+#include <InternetAddress.h>
+#include <PeerTable.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+
+namespace ncs { // Network Communications System
+namespace bench { // Network Communications System Benchmarks
+
+
+/**
+ * PeerTable benchmark constants
+ */
+constexpr std::size_t OPEN_ROUNDS = 5;
+constexpr std::size_t LOOKUPS = 1000000;
+
+/**
+ * @brief Peer as a text snapshot holds it
+ */
+struct text_peer_t {
+  addr::InternetAddress addr;
+  addr::peer_info_t info;
+};
+
+
+/**
+ * @brief Ip of the i-th peer, every fourth one IPv6
+ *
+ * @param iPeer
+ *
+ * @return
+ */
+addr::ip_t peer_ip(const std::size_t& iPeer) {
+  if (iPeer % 4 == 3) {
+    char text[INET6_ADDRSTRLEN];
+    std::snprintf(text, sizeof(text), "2001:db8:%zx::%zx", (iPeer >> 16) & 0xffff, iPeer & 0xffff);
+    return text;
+  }
+  return "10." + std::to_string((iPeer >> 16) & 0xff) + "." + std::to_string((iPeer >> 8) & 0xff) + "." +
+         std::to_string(iPeer & 0xff);
+}
+
+/**
+ * @brief Reads the text snapshot at iPath
+ *
+ * @param iPath
+ * @param oPeers
+ */
+void load_text(const std::string& iPath, std::vector<text_peer_t>& oPeers) {
+  oPeers.clear();
+  std::ifstream file(iPath);
+  std::string ip;
+  int port = 0;
+  addr::peer_info_t info;
+  while (file >> ip >> port >> info.rtt_us >> info.last_seen >> info.failures) {
+    oPeers.push_back({addr::InternetAddress(ip, port), info});
+  }
+}
+
+
+} // namespace bench
+} // namespace ncs
+
+
+/**
+ * @brief
+ */
+int main(int argc, char** argv) {
+  using namespace ncs;
+  const std::size_t maxPeers = std::max<std::size_t>((argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 1000000, 1000);
+  const std::string path = "/tmp/ncs_peer_table_benchmark_" + std::to_string(getpid());
+  const std::string textPath = path + ".txt";
+
+  std::printf("%10s %10s %12s %12s %12s %12s %12s\n", "peers", "file_MB", "put_ns", "open_us", "text_load_us",
+              "find_ns", "compact_ms");
+  for (std::size_t peers = 1000; peers <= maxPeers; peers *= 10) {
+    std::vector<addr::inet_address_t> addrs(peers);
+    std::ofstream text(textPath, std::ios::trunc);
+    for (std::size_t i = 0; i < peers; ++i) {
+      const addr::InternetAddress addr(bench::peer_ip(i), 1024 + static_cast<int>(i % 60000));
+      if (!addr::to_inet_address(addr, addrs[i])) {
+        std::fprintf(stderr, "bad address %s\n", bench::peer_ip(i).c_str());
+        return 1;
+      }
+      text << addr.get_ip() << ' ' << addr.get_port() << ' ' << i % 1000 << ' ' << 1700000000 + i << " 0\n";
+    }
+    text.close();
+
+    std::remove(path.c_str());
+    addr::PeerTable table;
+    if (!table.open(path, peers)) {
+      std::perror("open");
+      return 1;
+    }
+    bool ok = true;
+    const double putNs = bench::ns_per_op(peers, [&](const std::size_t& iIndex) {
+      ok = table.put(addrs[iIndex], {static_cast<std::uint32_t>(iIndex % 1000), 1700000000 + iIndex, 0}) && ok;
+    });
+    const double fileMb = static_cast<double>(table.get_capacity() * (sizeof(addr::peer_record_t) + 8)) / 1e6;
+    table.close();
+
+    std::uint64_t openNs = std::numeric_limits<std::uint64_t>::max();
+    for (std::size_t round = 0; round < bench::OPEN_ROUNDS; ++round) {
+      const std::uint64_t start = bench::now_ns();
+      ok = table.open(path) && ok;
+      openNs = std::min(openNs, bench::now_ns() - start);
+      if (round + 1 < bench::OPEN_ROUNDS) {
+        table.close();
+      }
+    }
+    std::size_t found = 0;
+    const double findNs = bench::ns_per_op(bench::LOOKUPS, [&](const std::size_t& iIndex) {
+      found += (table.find(addrs[(iIndex * 7919) % peers]) != nullptr) ? 1 : 0;
+    });
+    bench::do_not_optimize(found);
+
+    std::vector<bench::text_peer_t> loaded;
+    const std::uint64_t textStart = bench::now_ns();
+    bench::load_text(textPath, loaded);
+    const std::uint64_t textNs = bench::now_ns() - textStart;
+
+    for (std::size_t i = 0; i < peers; ++i) {
+      ok = table.put(addrs[i], {0, 1800000000 + i, 0}) && ok;
+    }
+    const std::uint64_t compactStart = bench::now_ns();
+    ok = table.compact() && ok;
+    const std::uint64_t compactNs = bench::now_ns() - compactStart;
+
+    if (!ok || (found != bench::LOOKUPS) || (loaded.size() != peers) || (table.get_size() != peers)) {
+      std::fprintf(stderr, "peer table mismatch\n");
+      return 1;
+    }
+    table.close();
+    std::printf("%10zu %10.2f %12.1f %12.1f %12.1f %12.1f %12.2f\n", peers, fileMb, putNs,
+                static_cast<double>(openNs) / 1e3, static_cast<double>(textNs) / 1e3, findNs,
+                static_cast<double>(compactNs) / 1e6);
+  }
+  std::remove(path.c_str());
+  std::remove(textPath.c_str());
+  return 0;
+}
@@ -0,0 +1,254 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file RateLimiter_benchmark.cpp
+ *
+ * @brief Cost of a RateLimiter decision, and an Acceptor serving one client under a loopback connection flood
+ *
+ * Usage: RateLimiter_benchmark [seconds] [flooders]
+ *
+ * The first table times admit() on a source within its rate, on one over it, and on a million distinct sources
+ * churning through the table. In the second one flooder threads open and reset connections from 127.0.0.2 as fast as
+ * they can while a well behaved client on 127.0.0.3 sends a byte every LEGIT_PERIOD_MS and waits for its echo. Each
+ * accepted connection gets a session buffer and an echo handler on the loop, so every flooding connection the
+ * acceptor lets through costs the server an allocation and a few system calls the client then waits behind.
+ */
+
+
+#include <Acceptor.h>
+#include <BenchmarkUtils.h>
+#include <EventLoop.h>
+#include <RateLimiter.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+
+namespace ncs { // Network Communications System
+namespace bench { // Network Communications System Benchmarks
+
+
+/**
+ * RateLimiter benchmark constants
+ */
+constexpr std::size_t DECISIONS = 10000000;
+constexpr std::size_t CHURN_SOURCES = 1000000;
+constexpr std::size_t SESSION_BYTES = 16384;     // Per connection state a server allocates on accept
+constexpr int LEGIT_PERIOD_MS = 20;
+
+/**
+ * @brief Server side of one accepted connection
+ */
+struct session_t {
+  sock::InternetSocket socket;
+  std::vector<char> buffer;
+};
+
+/**
+ * @brief Measured results of one flood
+ */
+struct result_t {
+  std::uint64_t accepted = 0;
+  std::uint64_t refused = 0;
+  std::size_t requests = 0;
+  std::vector<std::uint64_t> latencies;     // Connect to echo of the well behaved client, answered requests only
+};
+
+
+/**
+ * @brief Opens connections to iAddr from iSource until iStop is set, resetting each one right away
+ *
+ * @param iSource
+ * @param iAddr
+ * @param iStop
+ */
+void flood(const addr::ip_t& iSource, const addr::InternetAddress& iAddr, const std::atomic<bool>& iStop) {
+  const linger reset = {1, 0};
+  while (!iStop.load(std::memory_order_relaxed)) {
+    sock::InternetSocket client;
+    if (client.bind({iSource, addr::RANDOM_PORT})) {
+      (void)setsockopt(client.get_sd(), SOL_SOCKET, SO_LINGER, &reset, sizeof(reset));
+      (void)client.connect(iAddr);
+    }
+    client.close();
+  }
+}
+
+/**
+ * @brief Connects from iSource every LEGIT_PERIOD_MS and times the echo of one byte until iStop is set
+ *
+ * @param iSource
+ * @param iAddr
+ * @param iStop
+ * @param oResult
+ */
+void request(const addr::ip_t& iSource, const addr::InternetAddress& iAddr, const std::atomic<bool>& iStop,
+             result_t& oResult) {
+  const timeval timeout = {1, 0};
+  while (!iStop.load(std::memory_order_relaxed)) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(LEGIT_PERIOD_MS));
+    ++oResult.requests;
+    sock::InternetSocket client;
+    const std::uint64_t start = now_ns();
+    char byte = 'x';
+    if (client.bind({iSource, addr::RANDOM_PORT}) &&
+        (setsockopt(client.get_sd(), SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) == 0) &&
+        client.connect(iAddr) && (client.send(&byte, 1) == 1) && (client.recv(&byte, 1) == 1)) {
+      oResult.latencies.push_back(now_ns() - start);
+    }
+    client.close();
+  }
+}
+
+/**
+ * @brief Serves echo sessions for iSeconds under a flood of iFlooders threads
+ *
+ * @param iLimiter nullptr to accept everything
+ * @param iSeconds
+ * @param iFlooders
+ *
+ * @return
+ */
+result_t run(sock::RateLimiter* iLimiter, const double& iSeconds, const std::size_t& iFlooders) {
+  result_t result;
+  sock::EventLoop loop;
+  metrics::AcceptMetrics metrics;
+  sock::acceptor_config_t config;
+  config.limiter = iLimiter;
+  sock::Acceptor acceptor(loop, config);
+  acceptor.set_metrics(&metrics);
+  std::unordered_map<sock::sd_t, session_t> sessions;
+  const sock::accept_handler_t onAccept = [&](sock::InternetSocket&& ioClient) {
+    const sock::sd_t sd = ioClient.get_sd();
+    session_t& session = sessions[sd];
+    session.socket = std::move(ioClient);
+    session.buffer.assign(SESSION_BYTES, 0);
+    (void)loop.add(sd, EPOLLIN, [&sessions, &loop, sd](const std::uint32_t&) {
+      session_t& readable = sessions[sd];
+      const ssize_t got = readable.socket.recv(readable.buffer.data(), readable.buffer.size());
+      if ((got < 0) && (errno == EAGAIN)) {
+        return;
+      }
+      if (got > 0) {
+        (void)readable.socket.send(readable.buffer.data(), static_cast<std::size_t>(got));
+      }
+      (void)loop.remove(sd);
+      readable.socket.close();
+      sessions.erase(sd);
+    });
+  };
+  if (!acceptor.listen({"127.0.0.1", addr::RANDOM_PORT}, onAccept)) {
+    std::perror("listen");
+    return result;
+  }
+
+  std::atomic<bool> stop(false);
+  const addr::InternetAddress server = acceptor.get_listener().get_addr();
+  std::vector<std::thread> flooders;
+  for (std::size_t i = 0; i < iFlooders; ++i) {
+    flooders.emplace_back(flood, "127.0.0.2", server, std::cref(stop));
+  }
+  std::thread client(request, "127.0.0.3", server, std::cref(stop), std::ref(result));
+  const std::uint64_t end = now_ns() + static_cast<std::uint64_t>(iSeconds * 1e9);
+  while (now_ns() < end) {
+    (void)loop.run_once(10);
+  }
+  stop = true;
+  // Keeps serving until the threads are done, a request still waiting for its echo would stall otherwise
+  std::atomic<bool> joined(false);
+  std::thread joiner([&]() {
+    client.join();
+    for (std::thread& flooder : flooders) {
+      flooder.join();
+    }
+    joined = true;
+  });
+  while (!joined.load()) {
+    (void)loop.run_once(10);
+  }
+  joiner.join();
+
+  const metrics::accept_snapshot_t snapshot = metrics.snapshot();
+  result.accepted = snapshot.accepted;
+  result.refused = snapshot.rate_limited;
+  for (auto& session : sessions) {
+    session.second.socket.close();
+  }
+  return result;
+}
+
+/**
+ * @brief Prints one row
+ *
+ * @param iName
+ * @param ioResult
+ * @param iSeconds
+ */
+void report(const char* iName, result_t& ioResult, const double& iSeconds) {
+  const std::size_t answered = ioResult.latencies.size();
+  std::printf("%-12s %12.0f %12.0f %9zu/%-6zu %9.1f %9.1f\n", iName, static_cast<double>(ioResult.accepted) / iSeconds,
+              static_cast<double>(ioResult.refused) / iSeconds, answered, ioResult.requests,
+              static_cast<double>(percentile(ioResult.latencies, 0.50)) / 1000.0,
+              static_cast<double>(percentile(ioResult.latencies, 0.99)) / 1000.0);
+}
+
+
+} // namespace bench
+} // namespace ncs
+
+
+/**
+ * @brief
+ */
+int main(int argc, char** argv) {
+  using namespace ncs;
+  const double seconds = (argc > 1) ? std::atof(argv[1]) : 3.0;
+  const std::size_t flooders = std::max<std::size_t>((argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 2, 1);
+
+  std::vector<sockaddr_in> sources(bench::CHURN_SOURCES);
+  for (std::size_t i = 0; i < sources.size(); ++i) {
+    sources[i] = {};
+    sources[i].sin_family = AF_INET;
+    sources[i].sin_addr.s_addr = htonl(static_cast<std::uint32_t>(0x0a000000 + i));
+  }
+  const sockaddr* hot = reinterpret_cast<const sockaddr*>(&sources[0]);
+  std::size_t admitted = 0;
+
+  std::printf("%-24s %10s\n", "decision", "ns/op");
+  sock::RateLimiter generous(sock::rate_limit_config_t{1000000000, 1000, 32, 64, sock::DEFAULT_RATE_LIMIT_SLOTS});
+  std::printf("%-24s %10.2f\n", "within rate", bench::ns_per_op(bench::DECISIONS, [&](const std::size_t& iIndex) {
+    admitted += generous.admit(hot, sizeof(sockaddr_in), iIndex * 1000) ? 1 : 0;
+  }));
+  sock::RateLimiter strict(sock::rate_limit_config_t{1, 1, 32, 64, sock::DEFAULT_RATE_LIMIT_SLOTS});
+  std::printf("%-24s %10.2f\n", "over rate", bench::ns_per_op(bench::DECISIONS, [&](const std::size_t& iIndex) {
+    admitted += strict.admit(hot, sizeof(sockaddr_in), iIndex) ? 1 : 0;
+  }));
+  std::printf("%-24s %10.2f\n", "1M sources, 64K slots", bench::ns_per_op(bench::DECISIONS, [&](const std::size_t& i) {
+    admitted += strict.admit(reinterpret_cast<const sockaddr*>(&sources[(i * 7919) % sources.size()]),
+                             sizeof(sockaddr_in), i) ? 1 : 0;
+  }));
+  bench::do_not_optimize(admitted);
+
+  std::printf("\n%-12s %12s %12s %16s %9s %9s\n", "acceptor", "accepted/s", "refused/s", "answered", "p50_us",
+              "p99_us");
+  bench::result_t open = bench::run(nullptr, seconds, flooders);
+  bench::report("no limiter", open, seconds);
+  sock::RateLimiter limiter;
+  bench::result_t limited = bench::run(&limiter, seconds, flooders);
+  bench::report("limiter", limited, seconds);
+  return 0;
+}
@@ -0,0 +1,216 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file SourcePortManager_benchmark.cpp
+ *
+ * @brief Loopback stress test opening hundreds of thousands of outbound connections at a high rate
+ *
+ * Usage: SourcePortManager_benchmark [connections] [sources] [destinations] [ports] [window]
+ *
+ * Connections go round robin to a few loopback listeners, the last window of them stays open and the older ones are
+ * closed by the client, which leaves them in TIME_WAIT holding their port for a minute. Every socket is narrowed to
+ * the last ports of the ephemeral range so exhaustion comes early. The bind rows bind to port 0 of a source before
+ * connecting: the kernel reserves the port for the source whatever the destination and TIME_WAIT keeps it, so the
+ * run stalls once every source went through its range. The manager rows leave the port to connect(2), which shares it
+ * between destinations and may take over a TIME_WAIT four-tuple. connect(2) never picks a port left bound by bind(2),
+ * so the two runs get ranges of the same size that do not overlap. A run stops after MAX_FAILURES failed connects.
+ */
+
+
+#include <BenchmarkUtils.h>
+#include <ConnectMetrics.h>
+#include <InternetSocket.h>
+#include <SocketOptions.h>
+#include <SourcePortManager.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <string>
+#include <vector>
+
+
+namespace ncs { // Network Communications System
+namespace bench { // Network Communications System Benchmarks
+
+
+/**
+ * SourcePortManager benchmark constants
+ */
+constexpr std::size_t MAX_FAILURES = 1000;
+constexpr std::size_t DRAIN_EVERY = 64;     // Connects between two drains of the listeners
+
+/**
+ * @brief Measured results of one run
+ */
+struct result_t {
+  std::size_t established = 0;
+  std::size_t failures = 0;
+  int error = 0;                            // errno of the first failure
+  double seconds = 0;
+};
+
+
+/**
+ * @brief Accepts every queued connection of iListeners
+ *
+ * @param iListeners
+ * @param ioAccepted
+ */
+void drain(const std::vector<sock::InternetSocket>& iListeners, std::deque<sock::InternetSocket>& ioAccepted) {
+  for (const sock::InternetSocket& listener : iListeners) {
+    sock::InternetSocket client;
+    while (listener.accept(client)) {
+      ioAccepted.push_back(std::move(client));
+    }
+  }
+}
+
+/**
+ * @brief Closes the oldest sockets of ioSockets until iKeep are left
+ *
+ * @param ioSockets
+ * @param iKeep
+ * @param iOnClose Called with every socket before it closes
+ */
+template <typename OnClose>
+void close_oldest(std::deque<sock::InternetSocket>& ioSockets, const std::size_t& iKeep, OnClose&& iOnClose) {
+  while (ioSockets.size() > iKeep) {
+    iOnClose(ioSockets.front());
+    ioSockets.front().close();
+    ioSockets.pop_front();
+  }
+}
+
+/**
+ * @brief Opens iConnections connections with iConnect, keeping the last iWindow of them open
+ *
+ * @param iListeners
+ * @param iConnections
+ * @param iWindow
+ * @param iConnect Called with the connection index, the destination and the socket to connect
+ * @param iRelease Called with every client before it closes
+ *
+ * @return
+ */
+template <typename Connect, typename Release>
+result_t run(const std::vector<sock::InternetSocket>& iListeners, const std::size_t& iConnections,
+             const std::size_t& iWindow, Connect&& iConnect, Release&& iRelease) {
+  const auto nothing = [](const sock::InternetSocket&) {};
+  result_t result;
+  std::deque<sock::InternetSocket> clients;
+  std::deque<sock::InternetSocket> accepted;
+  const std::uint64_t start = now_ns();
+  for (std::size_t i = 0; (i < iConnections) && (result.failures < MAX_FAILURES); ++i) {
+    sock::InternetSocket client;
+    if (iConnect(i, iListeners[i % iListeners.size()].get_addr(), client)) {
+      clients.push_back(std::move(client));
+      ++result.established;
+    }
+    else {
+      result.error = (result.failures == 0) ? errno : result.error;
+      ++result.failures;
+      client.close();
+    }
+    if (i % DRAIN_EVERY == 0) {
+      drain(iListeners, accepted);
+      // Clients close first so the TIME_WAIT lands on their side
+      close_oldest(clients, iWindow, iRelease);
+      close_oldest(accepted, 2 * iWindow, nothing);
+    }
+  }
+  result.seconds = static_cast<double>(now_ns() - start) / 1e9;
+  drain(iListeners, accepted);
+  close_oldest(clients, 0, iRelease);
+  close_oldest(accepted, 0, nothing);
+  return result;
+}
+
+/**
+ * @brief Prints one row
+ *
+ * @param iName
+ * @param iResult
+ */
+void report(const char* iName, const result_t& iResult) {
+  std::printf("%-10s %12zu %9zu %-24s %9.2f %12.0f\n", iName, iResult.established, iResult.failures,
+              (iResult.failures > 0) ? std::strerror(iResult.error) : "-", iResult.seconds,
+              static_cast<double>(iResult.established) / iResult.seconds);
+}
+
+
+} // namespace bench
+} // namespace ncs
+
+
+/**
+ * @brief
+ */
+int main(int argc, char** argv) {
+  using namespace ncs;
+  const std::size_t connections = std::max<std::size_t>((argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 300000, 1);
+  const std::size_t sources = std::max<std::size_t>((argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 2, 1);
+  const std::size_t destinations = std::max<std::size_t>((argc > 3) ? std::strtoul(argv[3], nullptr, 10) : 4, 1);
+  const addr::port_t ports = std::max<addr::port_t>((argc > 4) ? std::atoi(argv[4]) : 4096, 1);
+  const std::size_t window = (argc > 5) ? std::strtoul(argv[5], nullptr, 10) : 1024;
+
+  std::vector<sock::InternetSocket> listeners(destinations);
+  for (sock::InternetSocket& listener : listeners) {
+    if (!listener.bind({"127.0.0.1", addr::RANDOM_PORT}) || !listener.listen() || !listener.set_non_blocking(true)) {
+      std::perror("listen");
+      return 1;
+    }
+  }
+  addr::port_t first = sock::DEFAULT_FIRST_LOCAL_PORT;
+  addr::port_t last = sock::DEFAULT_LAST_LOCAL_PORT;
+  std::ifstream range(sock::LOCAL_PORT_RANGE_PATH);
+  range >> first >> last;
+  sock::source_ports_config_t config;
+  config.first_port = std::max(first, last - 2 * ports + 1);
+  config.last_port = std::max(first, last - ports);
+  for (std::size_t i = 0; i < sources; ++i) {
+    config.sources.emplace_back("127.0.0." + std::to_string(2 + i), addr::RANDOM_PORT);
+  }
+  const std::uint32_t narrowed = (static_cast<std::uint32_t>(last) << 16) |
+                                 static_cast<std::uint32_t>(std::max(first, last - ports + 1));
+
+  std::printf("%-10s %12s %9s %-24s %9s %12s\n", "mode", "established", "failures", "first_error", "seconds",
+              "conns/s");
+  const bench::result_t bound = bench::run(listeners, connections, window,
+      [&](const std::size_t& iIndex, const addr::InternetAddress& iDestination, sock::InternetSocket& oSocket) {
+        const addr::InternetAddress& source = config.sources[iIndex % config.sources.size()];
+        return oSocket.open(addr::NET_ADDR_FAM_INET) && oSocket.set_option<sock::local_port_range_t>(narrowed) &&
+               oSocket.bind({source.get_ip(), addr::RANDOM_PORT}) && oSocket.connect(iDestination);
+      }, [](const sock::InternetSocket&) {});
+  bench::report("bind", bound);
+
+  sock::SourcePortManager manager(config);
+  metrics::ConnectMetrics metrics;
+  manager.set_metrics(&metrics);
+  const bench::result_t managed = bench::run(listeners, connections, window,
+      [&manager](const std::size_t&, const addr::InternetAddress& iDestination, sock::InternetSocket& oSocket) {
+        return manager.connect(iDestination, oSocket);
+      }, [&manager](const sock::InternetSocket& iSocket) {
+        (void)manager.release(iSocket);
+      });
+  bench::report("manager", managed);
+
+  const metrics::connect_snapshot_t snapshot = metrics.snapshot();
+  std::printf("ports %d-%d, capacity %zu per source and destination, exhausted %llu, port unavailable %llu, "
+              "connect p50 %llu us p99 %llu us\n", config.first_port, config.last_port, manager.get_capacity(),
+              static_cast<unsigned long long>(snapshot.exhausted),
+              static_cast<unsigned long long>(snapshot.port_unavailable),
+              static_cast<unsigned long long>(snapshot.connect_latency.get_percentile(0.50) / 1000),
+              static_cast<unsigned long long>(snapshot.connect_latency.get_percentile(0.99) / 1000));
+  for (sock::InternetSocket& listener : listeners) {
+    listener.close();
+  }
+  return 0;
+}
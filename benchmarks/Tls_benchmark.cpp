@@ -0,0 +1,206 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file Tls_benchmark.cpp
+ *
+ * @brief CPU spent per gigabyte streamed over the loopback in plaintext, userspace TLS and kernel TLS
+ *
+ * Usage: Tls_benchmark [megabytes]
+ *
+ * Each row streams the same amount of data from a writer to a reader thread, either copying from a buffer or with
+ * sendfile from a temporary file. The CPU time covers both threads, user and system. Kernel TLS rows are reported as
+ * unavailable when the tls module can not be loaded, userspace sendfile reads the file and encrypts it in OpenSSL.
+ */
+
+
+#include <BenchmarkUtils.h>
+#include <TlsContext.h>
+#include <TlsSession.h>
+
+#include <sys/resource.h>
+#include <sys/sendfile.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+namespace ncs { // Network Communications System
+namespace bench { // Network Communications System Benchmarks
+
+
+/**
+ * Tls benchmark constants
+ */
+constexpr std::size_t STREAM_CHUNK = 64 * 1024;               // Bytes per send() or sendfile() call
+constexpr std::size_t SOURCE_FILE_SIZE = 16 * 1024 * 1024;    // Sendfile rows wrap around this file
+
+/**
+ * @brief Record layer measured by one row
+ */
+enum transport_e {
+  TRANSPORT_PLAINTEXT,
+  TRANSPORT_USERSPACE_TLS,
+  TRANSPORT_KERNEL_TLS
+};
+
+/**
+ * @brief
+ */
+struct row_result_t {
+  bool ran = false;
+  double seconds = 0;
+  double cpu_seconds = 0;
+};
+
+/**
+ * @brief User plus system time of the whole process
+ *
+ * @return
+ */
+double process_cpu_seconds(void) {
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+  return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+         static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+/**
+ * @brief Streams iBytes from a client to a server over a fresh loopback connection
+ *
+ * @param iTransport
+ * @param iSendfile
+ * @param iBytes
+ * @param iFileFd Source of the sendfile rows
+ *
+ * @return ran is false when the transport is not available
+ */
+row_result_t stream(const transport_e& iTransport, const bool& iSendfile, const std::size_t& iBytes,
+                    const int& iFileFd) {
+  row_result_t result;
+  sock::InternetSocket client, server;
+  if (!loopback_pair(client, server)) {
+    return result;
+  }
+  tls::TlsContext clientContext(tls::TLS_CLIENT), serverContext(tls::TLS_SERVER);
+  clientContext.set_verify_peer(false);
+  if (!serverContext.use_self_signed("localhost")) {
+    return result;
+  }
+  clientContext.set_ktls(iTransport == TRANSPORT_KERNEL_TLS);
+  serverContext.set_ktls(iTransport == TRANSPORT_KERNEL_TLS);
+  std::unique_ptr<tls::TlsSession> writer, reader;
+  if (iTransport != TRANSPORT_PLAINTEXT) {
+    writer = std::make_unique<tls::TlsSession>(clientContext, client);
+    reader = std::make_unique<tls::TlsSession>(serverContext, server);
+    bool accepted = false;
+    std::thread handshake([&]() { accepted = reader->handshake(); });
+    const bool connected = writer->handshake();
+    handshake.join();
+    if (!connected || !accepted ||
+        (iTransport == TRANSPORT_KERNEL_TLS && writer->get_offload() == tls::TLS_OFFLOAD_NONE)) {
+      client.close();
+      server.close();
+      return result;
+    }
+  }
+
+  const double cpuStart = process_cpu_seconds();
+  const std::uint64_t start = now_ns();
+  std::thread receiving([&]() {
+    std::vector<char> buffer(STREAM_CHUNK);
+    for (std::size_t received = 0; received < iBytes;) {
+      const ssize_t count = reader ? reader->recv(buffer.data(), buffer.size())
+                                   : server.recv(buffer.data(), buffer.size());
+      if (count <= 0) {
+        break;
+      }
+      received += static_cast<std::size_t>(count);
+    }
+  });
+  std::vector<char> buffer(STREAM_CHUNK, 'n');
+  off_t offset = 0;
+  for (std::size_t sent = 0; sent < iBytes;) {
+    const std::size_t chunk = std::min(STREAM_CHUNK, iBytes - sent);
+    if (iSendfile && offset >= static_cast<off_t>(SOURCE_FILE_SIZE)) {
+      offset = 0;
+    }
+    ssize_t count = 0;
+    if (iSendfile) {
+      count = writer ? writer->sendfile(iFileFd, offset, chunk) : ::sendfile(client.get_sd(), iFileFd, &offset, chunk);
+    } else {
+      count = writer ? writer->send(buffer.data(), chunk) : client.send(buffer.data(), chunk);
+    }
+    if (count <= 0) {
+      break;
+    }
+    sent += static_cast<std::size_t>(count);
+  }
+  receiving.join();
+  result.seconds = static_cast<double>(now_ns() - start) / 1e9;
+  result.cpu_seconds = process_cpu_seconds() - cpuStart;
+  result.ran = true;
+  writer.reset();
+  reader.reset();
+  client.close();
+  server.close();
+  return result;
+}
+
+
+} // namespace bench
+} // namespace ncs
+
+
+/**
+ * @brief
+ */
+int main(int argc, char** argv) {
+  using namespace ncs;
+  const std::size_t megabytes = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 1024;
+  const std::size_t bytes = megabytes * 1024 * 1024;
+  const double gigabytes = static_cast<double>(bytes) / (1024.0 * 1024.0 * 1024.0);
+
+  std::FILE* file = std::tmpfile();
+  std::vector<char> block(bench::STREAM_CHUNK, 'f');
+  for (std::size_t written = 0; file != nullptr && written < bench::SOURCE_FILE_SIZE; written += block.size()) {
+    if (std::fwrite(block.data(), 1, block.size(), file) != block.size()) {
+      std::perror("fwrite");
+      return 1;
+    }
+  }
+  if (file == nullptr || std::fflush(file) != 0) {
+    std::perror("tmpfile");
+    return 1;
+  }
+
+  struct {
+    const char* name;
+    bench::transport_e transport;
+    bool sendfile;
+  } rows[] = {
+    {"plaintext send", bench::TRANSPORT_PLAINTEXT, false},
+    {"plaintext sendfile", bench::TRANSPORT_PLAINTEXT, true},
+    {"userspace tls send", bench::TRANSPORT_USERSPACE_TLS, false},
+    {"userspace tls sendfile", bench::TRANSPORT_USERSPACE_TLS, true},
+    {"ktls send", bench::TRANSPORT_KERNEL_TLS, false},
+    {"ktls sendfile", bench::TRANSPORT_KERNEL_TLS, true},
+  };
+  std::printf("%-24s %10s %14s\n", "transport", "GB/s", "cpu s / GB");
+  for (const auto& row : rows) {
+    const bench::row_result_t result = bench::stream(row.transport, row.sendfile, bytes, ::fileno(file));
+    if (!result.ran) {
+      std::printf("%-24s %10s %14s\n", row.name, "-", "unavailable");
+      continue;
+    }
+    std::printf("%-24s %10.2f %14.3f\n", row.name, gigabytes / result.seconds, result.cpu_seconds / gigabytes);
+  }
+  std::fclose(file);
+  return 0;
+}
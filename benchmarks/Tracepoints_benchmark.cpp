@@ -0,0 +1,108 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file Tracepoints_benchmark.cpp
+ *
+ * @brief Cost of the tracepoints while nothing is attached to them
+ *
+ * Usage: Tracepoints_benchmark [iterations]
+ *
+ * Times a bare tracepoint against an empty loop, then a send/recv round over a socketpair through raw syscalls and
+ * through InternetSocket with tracing detached and attached. Configure with -DNCS_ENABLE_TRACEPOINTS=OFF to compare
+ * against a build without them.
+ */
+
+
+#include <BenchmarkUtils.h>
+#include <Tracer.h>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+
+
+namespace ncs { // Network Communications System
+namespace bench { // Network Communications System Benchmarks
+
+
+/**
+ * @brief Attached handler doing no work
+ *
+ * @param iEvent
+ */
+void ignore(const trace::trace_event_t& iEvent) {
+  do_not_optimize(iEvent.size);
+}
+
+/**
+ * @brief Sends and receives one datagram per iteration through InternetSocket
+ *
+ * @param iIterations
+ * @param iWriter
+ * @param iReader
+ *
+ * @return
+ */
+double socket_round(const std::size_t& iIterations, const sock::InternetSocket& iWriter,
+                    const sock::InternetSocket& iReader) {
+  char buffer[64] = {};
+  return ns_per_op(iIterations, [&](const std::size_t&) {
+    (void)iWriter.send(buffer, sizeof(buffer));
+    do_not_optimize(iReader.recv(buffer, sizeof(buffer)));
+  });
+}
+
+
+} // namespace bench
+} // namespace ncs
+
+
+/**
+ * @brief
+ */
+int main(int argc, char** argv) {
+  using namespace ncs;
+  const std::size_t iterations = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+#if defined(NCS_ENABLE_TRACEPOINTS)
+  std::printf("tracepoints: compiled in, usdt %s\n", NCS_HAVE_USDT ? "available" : "unavailable");
+#else
+  std::printf("tracepoints: compiled out\n");
+#endif
+
+  const double empty = bench::ns_per_op(iterations * 100, [](const std::size_t& i) { bench::do_not_optimize(i); });
+  const double detached = bench::ns_per_op(iterations * 100, [](const std::size_t& i) {
+    bench::do_not_optimize(i);
+    NCS_TRACE(SOCKET_SEND, nullptr, -1, static_cast<std::int64_t>(i), 0);
+  });
+  std::printf("%-22s %10.3f ns/op\n", "empty loop", empty);
+  std::printf("%-22s %10.3f ns/op (+%.3f)\n", "detached tracepoint", detached, detached - empty);
+
+  int pair[2];
+  if (socketpair(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0, pair) != 0) {
+    std::perror("socketpair");
+    return 1;
+  }
+  char buffer[64] = {};
+  const double raw = bench::ns_per_op(iterations, [&](const std::size_t&) {
+    (void)!::send(pair[0], buffer, sizeof(buffer), MSG_NOSIGNAL);
+    bench::do_not_optimize(::recv(pair[1], buffer, sizeof(buffer), 0));
+  });
+  sock::InternetSocket writer, reader;
+  writer.set_sd(pair[0]);
+  reader.set_sd(pair[1]);
+  const double unattached = bench::socket_round(iterations, writer, reader);
+  trace::Tracer::attach(&bench::ignore);
+  const double attached = bench::socket_round(iterations, writer, reader);
+  trace::Tracer::detach();
+  std::printf("%-22s %10.1f ns/op\n", "raw send+recv", raw);
+  std::printf("%-22s %10.1f ns/op (%+.2f%%)\n", "socket, detached", unattached, 100.0 * (unattached - raw) / raw);
+  std::printf("%-22s %10.1f ns/op (%+.2f%%)\n", "socket, attached", attached, 100.0 * (attached - raw) / raw);
+  writer.close();
+  reader.close();
+  return 0;
+}
@@ -0,0 +1,176 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file WriteBatcher_benchmark.cpp
+ *
+ * @brief Throughput against latency of WriteBatcher policies over the loopback
+ *
+ * Usage: WriteBatcher_benchmark [messages] [message_size] [burst]
+ *
+ * Every loop iteration the writer produces a burst of timestamped messages, the receiver thread records how long
+ * each one took to arrive. Growing latency budgets trade latency for fewer syscalls and higher throughput.
+ */
+
+
+#include <BenchmarkUtils.h>
+#include <EventLoop.h>
+#include <WriteBatcher.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+
+namespace ncs { // Network Communications System
+namespace bench { // Network Communications System Benchmarks
+
+
+/**
+ * @brief Writer configuration measured by one row of the report
+ */
+struct scenario_t {
+  const char* name;
+  sock::coalesce_policy_t policy;
+  bool noDelay;
+};
+
+/**
+ * @brief Measured results of one scenario
+ */
+struct result_t {
+  double messagesPerSecond = 0;
+  double megabytesPerSecond = 0;
+  double syscallsPerMessage = 0;
+  std::uint64_t p50 = 0;
+  std::uint64_t p99 = 0;
+  std::uint64_t max = 0;
+};
+
+
+/**
+ * @brief Receives iMessages records of iMessageSize bytes and stores their one way latency
+ *
+ * @param iSocket
+ * @param iMessages
+ * @param iMessageSize
+ * @param oLatencies
+ */
+void receive(const sock::InternetSocket& iSocket, const std::size_t& iMessages, const std::size_t& iMessageSize,
+             std::vector<std::uint64_t>& oLatencies) {
+  std::vector<std::uint8_t> buffer(256 * 1024);
+  std::size_t buffered = 0;
+  oLatencies.reserve(iMessages);
+  while (oLatencies.size() < iMessages) {
+    const ssize_t received = iSocket.recv(buffer.data() + buffered, buffer.size() - buffered);
+    if (received <= 0) {
+      return;
+    }
+    buffered += static_cast<std::size_t>(received);
+    const std::uint64_t now = now_ns();
+    std::size_t offset = 0;
+    for (; offset + iMessageSize <= buffered; offset += iMessageSize) {
+      std::uint64_t sentAt;
+      std::memcpy(&sentAt, buffer.data() + offset, sizeof(sentAt));
+      oLatencies.push_back(now - sentAt);
+    }
+    std::memmove(buffer.data(), buffer.data() + offset, buffered - offset);
+    buffered -= offset;
+  }
+}
+
+/**
+ * @brief Runs one scenario on a fresh loopback connection
+ *
+ * @param iScenario
+ * @param iMessages
+ * @param iMessageSize
+ * @param iBurst
+ *
+ * @return
+ */
+result_t run(const scenario_t& iScenario, const std::size_t& iMessages, const std::size_t& iMessageSize,
+             const std::size_t& iBurst) {
+  result_t result;
+  sock::InternetSocket client, server;
+  if (!loopback_pair(client, server)) {
+    std::perror("loopback_pair");
+    return result;
+  }
+  set_no_delay(client, iScenario.noDelay);
+
+  std::vector<std::uint64_t> latencies;
+  std::thread receiver(receive, std::cref(server), iMessages, iMessageSize, std::ref(latencies));
+
+  sock::EventLoop loop;
+  sock::WriteBatcher batcher(client, iScenario.policy, &loop);
+  std::vector<std::uint8_t> message(iMessageSize, 'm');
+  const std::uint64_t start = now_ns();
+  for (std::size_t sent = 0; sent < iMessages;) {
+    for (std::size_t i = 0; (i < iBurst) && (sent < iMessages); ++i, ++sent) {
+      const std::uint64_t now = now_ns();
+      std::memcpy(message.data(), &now, sizeof(now));
+      (void)batcher.write(message.data(), message.size());
+    }
+    loop.run_once(0);
+  }
+  while (batcher.has_pending()) {
+    loop.run_once();
+  }
+  receiver.join();
+  const double seconds = static_cast<double>(now_ns() - start) / 1e9;
+
+  result.messagesPerSecond = static_cast<double>(iMessages) / seconds;
+  result.megabytesPerSecond = static_cast<double>(iMessages * iMessageSize) / seconds / 1e6;
+  result.syscallsPerMessage = static_cast<double>(batcher.get_stats().syscalls) / static_cast<double>(iMessages);
+  result.p50 = percentile(latencies, 0.50) / 1000;
+  result.p99 = percentile(latencies, 0.99) / 1000;
+  result.max = percentile(latencies, 1.00) / 1000;
+  client.close();
+  server.close();
+  return result;
+}
+
+
+} // namespace bench
+} // namespace ncs
+
+
+/**
+ * @brief
+ */
+int main(int argc, char** argv) {
+  using namespace ncs;
+  const std::size_t messages = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 200000;
+  const std::size_t messageSize = std::max<std::size_t>((argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 64, 8);
+  const std::size_t burst = (argc > 3) ? std::strtoul(argv[3], nullptr, 10) : 16;
+
+  sock::coalesce_policy_t unbatched;
+  unbatched.max_batch_bytes = 1;  // Every write is flushed on its own
+  std::vector<bench::scenario_t> scenarios = {
+    {"unbatched-nagle", unbatched, false},
+    {"unbatched-nodelay", unbatched, true},
+  };
+  for (const int budgetUs : {0, 50, 200, 1000}) {
+    sock::coalesce_policy_t policy;
+    policy.latency_budget = std::chrono::microseconds(budgetUs);
+    scenarios.push_back({"batched", policy, true});
+  }
+  sock::coalesce_policy_t corked;
+  corked.use_cork = true;
+  scenarios.push_back({"batched-cork", corked, true});
+
+  std::printf("%-18s %10s %12s %10s %13s %9s %9s %9s\n", "scenario", "budget_us", "msgs/s", "MB/s",
+              "syscalls/msg", "p50_us", "p99_us", "max_us");
+  for (const bench::scenario_t& scenario : scenarios) {
+    const bench::result_t result = bench::run(scenario, messages, messageSize, burst);
+    std::printf("%-18s %10lld %12.0f %10.1f %13.3f %9llu %9llu %9llu\n", scenario.name,
+                static_cast<long long>(scenario.policy.latency_budget.count()), result.messagesPerSecond,
+                result.megabytesPerSecond, result.syscallsPerMessage, static_cast<unsigned long long>(result.p50),
+                static_cast<unsigned long long>(result.p99), static_cast<unsigned long long>(result.max));
+  }
+  return 0;
+}
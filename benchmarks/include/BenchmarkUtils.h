@@ -0,0 +1,173 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file BenchmarkUtils.h
+ *
+ * @brief Helpers shared by the benchmark executables
+ */
+
+
+#ifndef NCS_BENCHMARK_UTILS_H
+#define NCS_BENCHMARK_UTILS_H
+
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include <InternetSocket.h>
+
+
+namespace ncs { // Network Communications System
+namespace bench { // Network Communications System Benchmarks
+
+
+/**
+ * @brief Monotonic timestamp in nanoseconds
+ *
+ * @return
+ */
+inline std::uint64_t now_ns(void) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Keeps the compiler from optimizing away the computation of iValue
+ *
+ * @param iValue
+ */
+template <typename T>
+inline void do_not_optimize(const T& iValue) {
+  asm volatile("" : : "r,m"(iValue) : "memory");
+}
+
+/**
+ * @brief Value below which iRatio of the samples fall, reorders the samples
+ *
+ * @param ioSamples
+ * @param iRatio In [0, 1]
+ *
+ * @return
+ */
+inline std::uint64_t percentile(std::vector<std::uint64_t>& ioSamples, const double& iRatio) {
+  if (ioSamples.empty()) {
+    return 0;
+  }
+  const std::size_t rank = std::min(ioSamples.size() - 1, static_cast<std::size_t>(iRatio * ioSamples.size()));
+  std::nth_element(ioSamples.begin(), ioSamples.begin() + rank, ioSamples.end());
+  return ioSamples[rank];
+}
+
+/**
+ * @brief Average nanoseconds taken by one call of iOperation
+ *
+ * @param iIterations
+ * @param iOperation Called with the iteration index
+ *
+ * @return
+ */
+template <typename Operation>
+inline double ns_per_op(const std::size_t& iIterations, Operation&& iOperation) {
+  const std::uint64_t start = now_ns();
+  for (std::size_t i = 0; i < iIterations; ++i) {
+    iOperation(i);
+  }
+  return static_cast<double>(now_ns() - start) / static_cast<double>(iIterations);
+}
+
+/**
+ * @brief Connects oClient to oServer through a fresh listener on the IPv4 loopback
+ *
+ * @param oClient
+ * @param oServer
+ *
+ * @return
+ */
+inline bool loopback_pair(sock::InternetSocket& oClient, sock::InternetSocket& oServer) {
+  sock::InternetSocket listener;
+  const bool connected = listener.bind({"127.0.0.1", addr::RANDOM_PORT}) && listener.listen() &&
+                         oClient.connect(listener.get_addr()) && listener.accept(oServer);
+  listener.close();
+  return connected;
+}
+
+/**
+ * @brief Toggles Nagle's algorithm
+ *
+ * @param iSocket
+ * @param iNoDelay
+ */
+inline void set_no_delay(const sock::InternetSocket& iSocket, const bool& iNoDelay) {
+  const int value = iNoDelay ? 1 : 0;
+  setsockopt(iSocket.get_sd(), IPPROTO_TCP, TCP_NODELAY, &value, sizeof(value));
+}
+
+
+/**
+ * @brief Sends the whole buffer, spinning while a non blocking socket is full
+ *
+ * @param iSocket
+ * @param iData
+ * @param iSize
+ *
+ * @return False on a socket error
+ */
+inline bool send_all(const sock::InternetSocket& iSocket, const void* iData, const std::size_t& iSize) {
+  const std::uint8_t* bytes = static_cast<const std::uint8_t*>(iData);
+  for (std::size_t sent = 0; sent < iSize;) {
+    const ssize_t result = iSocket.send(bytes + sent, iSize - sent);
+    if (result > 0) {
+      sent += static_cast<std::size_t>(result);
+    }
+    else if ((result < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR))) {
+      sched_yield();
+    }
+    else {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Receives exactly iSize bytes, spinning while a non blocking socket is empty
+ *
+ * @param iSocket
+ * @param oData
+ * @param iSize
+ *
+ * @return False on a socket error or end of stream
+ */
+inline bool receive_all(const sock::InternetSocket& iSocket, void* oData, const std::size_t& iSize) {
+  std::uint8_t* bytes = static_cast<std::uint8_t*>(oData);
+  for (std::size_t received = 0; received < iSize;) {
+    const ssize_t result = iSocket.recv(bytes + received, iSize - received);
+    if (result > 0) {
+      received += static_cast<std::size_t>(result);
+    }
+    else if ((result < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR))) {
+      sched_yield();
+    }
+    else {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+} // namespace bench
+} // namespace ncs
+
+
+#endif // NCS_BENCHMARK_UTILS_H
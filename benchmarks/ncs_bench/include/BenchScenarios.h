@@ -0,0 +1,104 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file BenchScenarios.h
+ *
+ * @brief Scenarios measured by ncs_bench
+ */
+
+
+#ifndef NCS_BENCH_SCENARIOS_H
+#define NCS_BENCH_SCENARIOS_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <InternetAddress.h>
+
+
+namespace ncs { // Network Communications System
+namespace bench { // Network Communications System Benchmarks
+
+
+/**
+ * BenchScenarios types
+ */
+enum backend_e {
+  BACKEND_BLOCKING,     // One blocking call at a time per client thread
+  BACKEND_EPOLL,        // Non blocking sockets driven by an EventLoop per client thread
+  BACKEND_BUSY_POLL     // Like BACKEND_EPOLL with every client and server loop busy polling
+};
+
+/**
+ * @brief Command line configuration of a run
+ */
+struct bench_options_t {
+  std::string scenario = "pingpong";      // pingpong, stream, reqresp or connrate
+  backend_e backend = BACKEND_EPOLL;
+  std::size_t size = 64;                  // Bytes per message, at least a timestamp
+  std::size_t threads = 1;                // Client threads, the server runs as many
+  std::size_t connections = 1;            // Connections spread over the client threads
+  std::size_t count = 10000;              // Messages per connection, or connections per thread for connrate
+  addr::ip_t ip = "127.0.0.1";            // Loopback address of the family to use
+};
+
+/**
+ * @brief Measured results of a run
+ */
+struct bench_report_t {
+  double seconds = 0;
+  std::uint64_t operations = 0;           // Round trips, messages or connections completed
+  std::uint64_t bytes = 0;                // Payload bytes moved in the measured direction(s)
+  std::uint64_t errors = 0;
+  std::vector<std::uint64_t> latencies;   // Nanoseconds per operation
+};
+
+
+/**
+ * @brief Round trips of one message over a single connection
+ *
+ * @param iOptions
+ *
+ * @return
+ */
+bench_report_t run_pingpong(const bench_options_t& iOptions);
+
+/**
+ * @brief One way stream of timestamped messages, latency measured at the receiver
+ *
+ * @param iOptions
+ *
+ * @return
+ */
+bench_report_t run_stream(const bench_options_t& iOptions);
+
+/**
+ * @brief Round trips over many concurrent connections, one request outstanding on each
+ *
+ * @param iOptions
+ *
+ * @return
+ */
+bench_report_t run_reqresp(const bench_options_t& iOptions);
+
+/**
+ * @brief Connections established and torn down per second
+ *
+ * @param iOptions
+ *
+ * @return
+ */
+bench_report_t run_connrate(const bench_options_t& iOptions);
+
+
+} // namespace bench
+} // namespace ncs
+
+
+#endif // NCS_BENCH_SCENARIOS_H
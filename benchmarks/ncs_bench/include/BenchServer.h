@@ -0,0 +1,199 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file BenchServer.h
+ *
+ * @brief Loopback server the ncs_bench clients run against
+ */
+
+
+#ifndef NCS_BENCH_SERVER_H
+#define NCS_BENCH_SERVER_H
+
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <EventLoop.h>
+#include <InternetSocket.h>
+
+
+namespace ncs { // Network Communications System
+namespace bench { // Network Communications System Benchmarks
+
+
+/**
+ * BenchServer types
+ */
+enum server_mode_e {
+  SERVER_ECHO,      // Sends every received byte back
+  SERVER_SINK,      // Reads timestamped messages and records their one way latency
+  SERVER_ACCEPT     // Accepts and closes connections right away
+};
+
+/**
+ * BenchServer constants
+ */
+constexpr std::size_t SERVER_READ_SIZE = 64 * 1024;   // Bytes read per call
+constexpr int SERVER_POLL_TIMEOUT_MS = 20;            // Longest wait before noticing stop()
+
+
+/**
+ * @brief Runs one EventLoop per thread, each with its own SO_REUSEPORT listener so the kernel spreads the connections
+ */
+class BenchServer {
+public:
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+  /**
+   * @brief Mode constructor
+   * 
+   * @param iMode
+   * @param iMessageSize Bytes of every message, at least a timestamp
+   */
+  BenchServer(const server_mode_e& iMode, const std::size_t& iMessageSize);
+
+  /**
+   * @brief Copy constructor
+   */
+  BenchServer(const BenchServer& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Listens on a random port of iIp and starts the server threads
+   * 
+   * @param iIp
+   * @param iThreads
+   * 
+   * @return
+   */
+  [[nodiscard]] bool start(const addr::ip_t& iIp, const std::size_t& iThreads);
+
+  /**
+   * @brief Stops and joins the server threads
+   */
+  void stop(void);
+
+  /**
+   * @brief Latencies recorded by SERVER_SINK, call once stopped
+   * 
+   * @return
+   */
+  [[nodiscard]] std::vector<std::uint64_t> take_latencies(void);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+  /**
+   * @brief
+   * 
+   * @return Address the clients must connect to
+   */
+  [[nodiscard]] const addr::InternetAddress& get_addr(void) const;
+
+  /**
+   * @brief
+   * 
+   * @return Messages completely received by SERVER_SINK
+   */
+  [[nodiscard]] std::uint64_t get_received(void) const;
+
+  /**
+   * @brief Busy poll mode of the server loops, call before start()
+   * 
+   * @param iConfig
+   */
+  void set_busy_poll(const sock::busy_poll_config_t& iConfig);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+  /**
+   * @brief Copy assignment operator
+   */
+  BenchServer& operator=(const BenchServer& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+  /**
+   * @brief Destructor
+   */
+  ~BenchServer();
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+protected:
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Body of a server thread
+   * 
+   * @param ioListener
+   * @param oLatencies
+   */
+  void serve(sock::InternetSocket& ioListener, std::vector<std::uint64_t>& oLatencies);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+  server_mode_e mode_;
+  std::size_t messageSize_;
+  addr::InternetAddress addr_;
+  std::atomic<bool> stopped_;
+  std::atomic<std::uint64_t> received_;
+  std::vector<sock::InternetSocket> listeners_;
+  std::vector<std::vector<std::uint64_t>> latencies_;
+  std::vector<std::thread> threads_;
+  sock::busy_poll_config_t busyPoll_;
+};
+
+
+} // namespace bench
+} // namespace ncs
+
+
+#endif // NCS_BENCH_SERVER_H
@@ -0,0 +1,369 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file BenchScenarios.cpp
+ *
+ * @brief
+ */
+
+
+#include <BenchScenarios.h>
+
+#include <sys/socket.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <thread>
+
+#include <BenchServer.h>
+#include <BenchmarkUtils.h>
+#include <EventLoop.h>
+
+
+namespace ncs { // Network Communications System
+namespace bench { // Network Communications System Benchmarks
+
+
+/**
+ * BenchScenarios constants
+ */
+constexpr std::size_t STREAM_BATCH_BYTES = 64 * 1024;   // Bytes handed to the kernel per stream send
+constexpr std::uint64_t STALL_TIMEOUT_NS = 5000000000;  // Give up on a run that makes no progress for this long
+
+
+/**
+ * @brief Busy poll mode of the loops of a run, disabled unless the backend asks for it
+ *
+ * @param iOptions
+ *
+ * @return
+ */
+static sock::busy_poll_config_t busy_poll_config(const bench_options_t& iOptions) {
+  sock::busy_poll_config_t config;
+  config.enabled = (iOptions.backend == BACKEND_BUSY_POLL);
+  return config;
+}
+
+
+/**
+ * @brief Share of iTotal handled by client thread iThread
+ *
+ * @param iTotal
+ * @param iThreads
+ * @param iThread
+ *
+ * @return
+ */
+static std::size_t thread_share(const std::size_t& iTotal, const std::size_t& iThreads, const std::size_t& iThread) {
+  return iTotal / iThreads + ((iThread < iTotal % iThreads) ? 1 : 0);
+}
+
+/**
+ * @brief Runs iBody on iThreads client threads, each filling its own report, and merges the reports
+ *
+ * @param iThreads
+ * @param iBody Called with the thread index and its report, sets the seconds it measured
+ *
+ * @return
+ */
+template <typename Body>
+static bench_report_t run_clients(const std::size_t& iThreads, Body&& iBody) {
+  std::vector<bench_report_t> reports(iThreads);
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < iThreads; ++i) {
+    threads.emplace_back([&iBody, &reports, i]() { iBody(i, reports[i]); });
+  }
+  bench_report_t total;
+  for (std::size_t i = 0; i < iThreads; ++i) {
+    threads[i].join();
+    total.seconds = std::max(total.seconds, reports[i].seconds);
+    total.operations += reports[i].operations;
+    total.bytes += reports[i].bytes;
+    total.errors += reports[i].errors;
+    total.latencies.insert(total.latencies.end(), reports[i].latencies.begin(), reports[i].latencies.end());
+  }
+  return total;
+}
+
+/**
+ * @brief Opens iCount blocking connections to iAddr with Nagle's algorithm disabled
+ *
+ * @param iAddr
+ * @param iCount
+ * @param oSockets
+ *
+ * @return
+ */
+static bool connect_clients(const addr::InternetAddress& iAddr, const std::size_t& iCount,
+                            std::vector<sock::InternetSocket>& oSockets) {
+  oSockets.resize(iCount);
+  for (sock::InternetSocket& socket : oSockets) {
+    if (!socket.connect(iAddr)) {
+      return false;
+    }
+    set_no_delay(socket, true);
+  }
+  return true;
+}
+
+/**
+ * @brief Sends one request on every connection, then collects every response
+ *
+ * @param iOptions
+ * @param iSockets
+ * @param ioReport
+ */
+static void request_blocking(const bench_options_t& iOptions, const std::vector<sock::InternetSocket>& iSockets,
+                             bench_report_t& ioReport) {
+  std::vector<std::uint8_t> request(iOptions.size, 'q');
+  std::vector<std::uint8_t> response(iOptions.size);
+  std::vector<std::uint64_t> sentAt(iSockets.size());
+  for (std::size_t round = 0; round < iOptions.count; ++round) {
+    for (std::size_t i = 0; i < iSockets.size(); ++i) {
+      sentAt[i] = now_ns();
+      if (!send_all(iSockets[i], request.data(), request.size())) {
+        ++ioReport.errors;
+        return;
+      }
+    }
+    for (std::size_t i = 0; i < iSockets.size(); ++i) {
+      if (!receive_all(iSockets[i], response.data(), response.size())) {
+        ++ioReport.errors;
+        return;
+      }
+      ioReport.latencies.push_back(now_ns() - sentAt[i]);
+      ++ioReport.operations;
+      ioReport.bytes += 2 * iOptions.size;
+    }
+  }
+}
+
+/**
+ * @brief Sends the next request of a connection as soon as its previous response is complete
+ *
+ * @param iOptions
+ * @param ioSockets
+ * @param ioReport
+ */
+static void request_epoll(const bench_options_t& iOptions, std::vector<sock::InternetSocket>& ioSockets,
+                          bench_report_t& ioReport) {
+  struct peer_t {
+    std::size_t received = 0;       // Bytes of the current response
+    std::size_t remaining = 0;      // Requests still to send
+    std::uint64_t sentAt = 0;
+  };
+  sock::EventLoop loop;
+  (void)loop.set_busy_poll(busy_poll_config(iOptions));
+  std::vector<peer_t> peers(ioSockets.size());
+  std::vector<std::uint8_t> request(iOptions.size, 'q');
+  std::vector<std::uint8_t> buffer(SERVER_READ_SIZE);
+  std::size_t active = ioSockets.size();
+  std::uint64_t progress = now_ns();
+
+  auto finish = [&](const std::size_t& iPeer, const bool& iFailed) {
+    (void)loop.remove(ioSockets[iPeer].get_sd());
+    ioReport.errors += iFailed ? 1 : 0;
+    --active;
+  };
+  auto send_request = [&](const std::size_t& iPeer) {
+    peers[iPeer].sentAt = now_ns();
+    if (!send_all(ioSockets[iPeer], request.data(), request.size())) {
+      finish(iPeer, true);
+    }
+  };
+  for (std::size_t i = 0; i < ioSockets.size(); ++i) {
+    peers[i].remaining = iOptions.count;
+    if (!ioSockets[i].set_non_blocking(true)) {
+      ++ioReport.errors;
+      return;
+    }
+    (void)loop.add(ioSockets[i].get_sd(), EPOLLIN, [&, i](const std::uint32_t&) {
+      peer_t& peer = peers[i];
+      while (true) {
+        const ssize_t received = ioSockets[i].recv(buffer.data(), buffer.size());
+        if (received <= 0) {
+          if ((received < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK))) {
+            return;
+          }
+          finish(i, true);
+          return;
+        }
+        // A single request is outstanding, so the response ends exactly at its size
+        peer.received += static_cast<std::size_t>(received);
+        if (peer.received >= request.size()) {
+          progress = now_ns();
+          ioReport.latencies.push_back(progress - peer.sentAt);
+          ++ioReport.operations;
+          ioReport.bytes += 2 * iOptions.size;
+          peer.received = 0;
+          if (--peer.remaining == 0) {
+            finish(i, false);
+            return;
+          }
+          send_request(i);
+        }
+      }
+    });
+  }
+  for (std::size_t i = 0; i < ioSockets.size(); ++i) {
+    send_request(i);
+  }
+  while ((active > 0) && (now_ns() - progress < STALL_TIMEOUT_NS)) {
+    loop.run_once(100);
+  }
+  ioReport.errors += active;
+}
+
+/**
+ * @brief Round trips of one message over a single connection
+ *
+ * @param iOptions
+ *
+ * @return
+ */
+bench_report_t run_pingpong(const bench_options_t& iOptions) {
+  bench_options_t options = iOptions;
+  options.threads = 1;
+  options.connections = 1;
+  return run_reqresp(options);
+}
+
+/**
+ * @brief One way stream of timestamped messages
+ *
+ * @param iOptions
+ *
+ * @return
+ */
+bench_report_t run_stream(const bench_options_t& iOptions) {
+  BenchServer server(SERVER_SINK, iOptions.size);
+  if (!server.start(iOptions.ip, iOptions.threads)) {
+    bench_report_t report;
+    report.errors = 1;
+    return report;
+  }
+  const std::size_t connections = std::max(iOptions.connections, iOptions.threads);
+  const std::uint64_t start = now_ns();
+  bench_report_t report = run_clients(iOptions.threads, [&](const std::size_t& iThread, bench_report_t& oReport) {
+    std::vector<sock::InternetSocket> sockets;
+    if (!connect_clients(server.get_addr(), thread_share(connections, iOptions.threads, iThread), sockets)) {
+      ++oReport.errors;
+      return;
+    }
+    const std::size_t perBatch = std::max<std::size_t>(1, STREAM_BATCH_BYTES / iOptions.size);
+    std::vector<std::uint8_t> batch(perBatch * iOptions.size, 's');
+    for (std::size_t sent = 0; sent < iOptions.count;) {
+      const std::size_t messages = std::min(perBatch, iOptions.count - sent);
+      for (const sock::InternetSocket& socket : sockets) {
+        for (std::size_t i = 0; i < messages; ++i) {
+          const std::uint64_t stamp = now_ns();
+          std::memcpy(batch.data() + i * iOptions.size, &stamp, sizeof(stamp));
+        }
+        if (!send_all(socket, batch.data(), messages * iOptions.size)) {
+          ++oReport.errors;
+          return;
+        }
+        oReport.operations += messages;
+        oReport.bytes += messages * iOptions.size;
+      }
+      sent += messages;
+    }
+    for (sock::InternetSocket& socket : sockets) {
+      socket.close();
+    }
+  });
+  // The stream is over once the receivers have read every message
+  std::uint64_t received = 0;
+  std::uint64_t progress = now_ns();
+  while ((server.get_received() < report.operations) && (now_ns() - progress < STALL_TIMEOUT_NS)) {
+    if (server.get_received() != received) {
+      received = server.get_received();
+      progress = now_ns();
+    }
+    std::this_thread::yield();
+  }
+  report.seconds = static_cast<double>(now_ns() - start) / 1e9;
+  report.errors += report.operations - std::min(report.operations, server.get_received());
+  server.stop();
+  report.latencies = server.take_latencies();
+  return report;
+}
+
+/**
+ * @brief Round trips over many concurrent connections
+ *
+ * @param iOptions
+ *
+ * @return
+ */
+bench_report_t run_reqresp(const bench_options_t& iOptions) {
+  BenchServer server(SERVER_ECHO, iOptions.size);
+  server.set_busy_poll(busy_poll_config(iOptions));
+  if (!server.start(iOptions.ip, iOptions.threads)) {
+    bench_report_t report;
+    report.errors = 1;
+    return report;
+  }
+  const std::size_t threads = std::max<std::size_t>(1, std::min(iOptions.threads, iOptions.connections));
+  return run_clients(threads, [&](const std::size_t& iThread, bench_report_t& oReport) {
+    std::vector<sock::InternetSocket> sockets;
+    if (!connect_clients(server.get_addr(), thread_share(iOptions.connections, threads, iThread), sockets)) {
+      ++oReport.errors;
+      return;
+    }
+    const std::uint64_t start = now_ns();
+    if (iOptions.backend == BACKEND_BLOCKING) {
+      request_blocking(iOptions, sockets, oReport);
+    }
+    else {
+      request_epoll(iOptions, sockets, oReport);
+    }
+    oReport.seconds = static_cast<double>(now_ns() - start) / 1e9;
+    for (sock::InternetSocket& socket : sockets) {
+      socket.close();
+    }
+  });
+}
+
+/**
+ * @brief Connections established and torn down per second
+ *
+ * @param iOptions
+ *
+ * @return
+ */
+bench_report_t run_connrate(const bench_options_t& iOptions) {
+  BenchServer server(SERVER_ACCEPT, iOptions.size);
+  if (!server.start(iOptions.ip, iOptions.threads)) {
+    bench_report_t report;
+    report.errors = 1;
+    return report;
+  }
+  return run_clients(iOptions.threads, [&](const std::size_t&, bench_report_t& oReport) {
+    // Resetting instead of closing keeps the client ports out of TIME_WAIT
+    const linger reset = {1, 0};
+    const std::uint64_t start = now_ns();
+    for (std::size_t i = 0; i < iOptions.count; ++i) {
+      sock::InternetSocket socket;
+      const std::uint64_t connectStart = now_ns();
+      if (!socket.connect(server.get_addr())) {
+        ++oReport.errors;
+        socket.close();
+        continue;
+      }
+      oReport.latencies.push_back(now_ns() - connectStart);
+      ++oReport.operations;
+      setsockopt(socket.get_sd(), SOL_SOCKET, SO_LINGER, &reset, sizeof(reset));
+      socket.close();
+    }
+    oReport.seconds = static_cast<double>(now_ns() - start) / 1e9;
+  });
+}
+
+
+} // namespace bench
+} // namespace ncs
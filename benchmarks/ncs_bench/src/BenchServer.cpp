@@ -0,0 +1,277 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file BenchServer.cpp
+ *
+ * @brief
+ */
+
+
+#include <BenchServer.h>
+
+#include <sys/socket.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <unordered_map>
+
+#include <BenchmarkUtils.h>
+#include <EventLoop.h>
+
+
+namespace ncs { // Network Communications System
+namespace bench { // Network Communications System Benchmarks
+
+
+/** PUBLIC METHODS **/
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+/**
+ * @brief Mode constructor
+ * 
+ * @param iMode
+ * @param iMessageSize
+ */
+BenchServer::BenchServer(const server_mode_e& iMode, const std::size_t& iMessageSize)
+    : mode_(iMode), messageSize_(iMessageSize), addr_(), stopped_(false), received_(0), listeners_(), latencies_(),
+      threads_(), busyPoll_() {
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Listens on a random port of iIp and starts the server threads
+ * 
+ * @param iIp
+ * @param iThreads
+ * 
+ * @return
+ */
+[[nodiscard]] bool BenchServer::start(const addr::ip_t& iIp, const std::size_t& iThreads) {
+  this->stop();
+  this->stopped_.store(false);
+  this->received_.store(0);
+  this->listeners_.resize(std::max<std::size_t>(iThreads, 1));
+  this->latencies_.assign(this->listeners_.size(), {});
+  addr::InternetAddress bindAddr(iIp, addr::RANDOM_PORT);
+  for (sock::InternetSocket& listener : this->listeners_) {
+    const int one = 1;
+    if (!listener.open(bindAddr.get_address_family()) ||
+        (setsockopt(listener.get_sd(), SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one)) != 0) ||
+        !listener.bind(bindAddr) || !listener.listen() || !listener.set_non_blocking(true)) {
+      return false;
+    }
+    bindAddr = listener.get_addr();
+  }
+  this->addr_ = bindAddr;
+  for (std::size_t i = 0; i < this->listeners_.size(); ++i) {
+    this->threads_.emplace_back(&BenchServer::serve, this, std::ref(this->listeners_[i]), std::ref(this->latencies_[i]));
+  }
+  return true;
+}
+
+/**
+ * @brief Stops and joins the server threads
+ */
+void BenchServer::stop(void) {
+  this->stopped_.store(true);
+  for (std::thread& thread : this->threads_) {
+    thread.join();
+  }
+  this->threads_.clear();
+  for (sock::InternetSocket& listener : this->listeners_) {
+    listener.close();
+  }
+  this->listeners_.clear();
+}
+
+/**
+ * @brief Latencies recorded by SERVER_SINK
+ * 
+ * @return
+ */
+[[nodiscard]] std::vector<std::uint64_t> BenchServer::take_latencies(void) {
+  std::vector<std::uint64_t> latencies;
+  for (std::vector<std::uint64_t>& thread : this->latencies_) {
+    latencies.insert(latencies.end(), thread.begin(), thread.end());
+  }
+  this->latencies_.clear();
+  return latencies;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] const addr::InternetAddress& BenchServer::get_addr(void) const {
+  return this->addr_;
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] std::uint64_t BenchServer::get_received(void) const {
+  return this->received_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Busy poll mode of the server loops
+ * 
+ * @param iConfig
+ */
+void BenchServer::set_busy_poll(const sock::busy_poll_config_t& iConfig) {
+  this->busyPoll_ = iConfig;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+/**
+ * @brief Destructor
+ */
+BenchServer::~BenchServer() {
+  this->stop();
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PROTECTED METHODS **/
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PRIVATE METHODS **/
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Body of a server thread
+ * 
+ * @param ioListener
+ * @param oLatencies
+ */
+void BenchServer::serve(sock::InternetSocket& ioListener, std::vector<std::uint64_t>& oLatencies) {
+  struct connection_t {
+    sock::InternetSocket socket;
+    std::size_t position = 0;     // Bytes of the current message already read
+    std::uint64_t stamp = 0;      // Send time carried by the current message
+  };
+  sock::EventLoop loop;
+  (void)loop.set_busy_poll(this->busyPoll_);
+  std::unordered_map<sock::sd_t, std::unique_ptr<connection_t>> connections;
+  std::vector<std::uint8_t> buffer(SERVER_READ_SIZE);
+
+  // Splits the byte stream in messages and records the latency of each complete one
+  auto consume = [&](connection_t& ioConnection, const std::uint8_t* iData, const std::size_t& iSize) {
+    for (std::size_t i = 0; i < iSize;) {
+      std::size_t take;
+      if (ioConnection.position < sizeof(ioConnection.stamp)) {
+        take = std::min(sizeof(ioConnection.stamp) - ioConnection.position, iSize - i);
+        std::memcpy(reinterpret_cast<std::uint8_t*>(&ioConnection.stamp) + ioConnection.position, iData + i, take);
+      }
+      else {
+        take = std::min(this->messageSize_ - ioConnection.position, iSize - i);
+      }
+      ioConnection.position += take;
+      i += take;
+      if (ioConnection.position == this->messageSize_) {
+        oLatencies.push_back(now_ns() - ioConnection.stamp);
+        this->received_.fetch_add(1, std::memory_order_relaxed);
+        ioConnection.position = 0;
+      }
+    }
+  };
+  auto readable = [&](connection_t* ioConnection) {
+    while (true) {
+      const ssize_t received = ioConnection->socket.recv(buffer.data(), buffer.size());
+      if (received > 0) {
+        if (this->mode_ == SERVER_ECHO) {
+          send_all(ioConnection->socket, buffer.data(), static_cast<std::size_t>(received));
+        }
+        else {
+          consume(*ioConnection, buffer.data(), static_cast<std::size_t>(received));
+        }
+        continue;
+      }
+      if ((received < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK))) {
+        return;
+      }
+      const sock::sd_t sd = ioConnection->socket.get_sd();
+      loop.remove(sd);
+      ioConnection->socket.close();
+      connections.erase(sd);
+      return;
+    }
+  };
+  (void)loop.add(ioListener.get_sd(), EPOLLIN, [&](const std::uint32_t&) {
+    sock::InternetSocket client;
+    while (ioListener.accept(client, SOCK_NONBLOCK)) {
+      if (this->mode_ == SERVER_ACCEPT) {
+        client.close();
+        continue;
+      }
+      set_no_delay(client, true);
+      auto connection = std::make_unique<connection_t>();
+      connection->socket = std::move(client);
+      connection_t* raw = connection.get();
+      (void)loop.add(raw->socket.get_sd(), EPOLLIN, [&readable, raw](const std::uint32_t&) { readable(raw); });
+      connections.emplace(raw->socket.get_sd(), std::move(connection));
+    }
+  });
+  while (!this->stopped_.load(std::memory_order_relaxed)) {
+    loop.run_once(SERVER_POLL_TIMEOUT_MS);
+  }
+  for (auto& connection : connections) {
+    connection.second->socket.close();
+  }
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+} // namespace bench
+} // namespace ncs
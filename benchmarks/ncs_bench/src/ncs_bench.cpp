@@ -0,0 +1,188 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file ncs_bench.cpp
+ *
+ * @brief Loopback throughput and tail latency benchmark of the NCS sockets
+ *
+ * Usage: ncs_bench [--scenario pingpong|stream|reqresp|connrate] [--backend blocking|epoll|busypoll]
+ *                  [--size bytes] [--threads n] [--connections n] [--count n] [--ip address]
+ *
+ * Prints a single JSON object and exits with a non zero status if any operation failed, so releases can be gated on
+ * it. The backend only applies to the round trip scenarios. The busypoll backend spins every loop, so run it with
+ * client and server on isolated cores and compare its pingpong latencies against the epoll backend.
+ */
+
+
+#include <BenchScenarios.h>
+#include <BenchmarkUtils.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+
+namespace ncs { // Network Communications System
+namespace bench { // Network Communications System Benchmarks
+
+
+/**
+ * @brief Prints the command line help
+ *
+ * @param iProgram
+ */
+static void usage(const char* iProgram) {
+  std::fprintf(stderr,
+               "Usage: %s [--scenario pingpong|stream|reqresp|connrate] [--backend blocking|epoll|busypoll]\n"
+               "       [--size bytes] [--threads n] [--connections n] [--count n] [--ip address]\n",
+               iProgram);
+}
+
+/**
+ * @brief Reads the command line, accepting both '--key value' and '--key=value'
+ *
+ * @param iArgc
+ * @param iArgv
+ * @param oOptions
+ *
+ * @return False on an unknown or malformed option
+ */
+static bool parse_options(const int& iArgc, char** iArgv, bench_options_t& oOptions) {
+  for (int i = 1; i < iArgc; ++i) {
+    std::string key = iArgv[i];
+    std::string value;
+    const std::size_t equals = key.find('=');
+    if (equals != std::string::npos) {
+      value = key.substr(equals + 1);
+      key.resize(equals);
+    }
+    else if (i + 1 < iArgc) {
+      value = iArgv[++i];
+    }
+    else {
+      return false;
+    }
+    if (key == "--scenario") {
+      oOptions.scenario = value;
+    }
+    else if (key == "--backend") {
+      if (value == "blocking") {
+        oOptions.backend = BACKEND_BLOCKING;
+      }
+      else if (value == "epoll") {
+        oOptions.backend = BACKEND_EPOLL;
+      }
+      else if (value == "busypoll") {
+        oOptions.backend = BACKEND_BUSY_POLL;
+      }
+      else {
+        return false;
+      }
+    }
+    else if (key == "--size") {
+      oOptions.size = std::strtoul(value.c_str(), nullptr, 10);
+    }
+    else if (key == "--threads") {
+      oOptions.threads = std::strtoul(value.c_str(), nullptr, 10);
+    }
+    else if (key == "--connections") {
+      oOptions.connections = std::strtoul(value.c_str(), nullptr, 10);
+    }
+    else if (key == "--count") {
+      oOptions.count = std::strtoul(value.c_str(), nullptr, 10);
+    }
+    else if (key == "--ip") {
+      oOptions.ip = value;
+    }
+    else {
+      return false;
+    }
+  }
+  return (oOptions.size >= sizeof(std::uint64_t)) && (oOptions.threads > 0) && (oOptions.connections > 0) &&
+         (oOptions.count > 0);
+}
+
+/**
+ * @brief
+ *
+ * @param iBackend
+ *
+ * @return
+ */
+static const char* to_string(const backend_e& iBackend) {
+  switch (iBackend) {
+    case BACKEND_BLOCKING:
+      return "blocking";
+    case BACKEND_BUSY_POLL:
+      return "busypoll";
+    default:
+      return "epoll";
+  }
+}
+
+/**
+ * @brief Prints the report as a JSON object
+ *
+ * @param iOptions
+ * @param ioReport Its latencies get reordered
+ */
+static void print_json(const bench_options_t& iOptions, bench_report_t& ioReport) {
+  const double seconds = (ioReport.seconds > 0) ? ioReport.seconds : 1e-9;
+  auto us = [&ioReport](const double& iRatio) { return static_cast<double>(percentile(ioReport.latencies, iRatio)) / 1e3; };
+  std::printf("{\n");
+  std::printf("  \"scenario\": \"%s\",\n", iOptions.scenario.c_str());
+  std::printf("  \"backend\": \"%s\",\n", to_string(iOptions.backend));
+  std::printf("  \"ip\": \"%s\",\n", iOptions.ip.c_str());
+  std::printf("  \"size\": %zu,\n", iOptions.size);
+  std::printf("  \"threads\": %zu,\n", iOptions.threads);
+  std::printf("  \"connections\": %zu,\n", iOptions.connections);
+  std::printf("  \"count\": %zu,\n", iOptions.count);
+  std::printf("  \"seconds\": %.6f,\n", ioReport.seconds);
+  std::printf("  \"operations\": %llu,\n", static_cast<unsigned long long>(ioReport.operations));
+  std::printf("  \"errors\": %llu,\n", static_cast<unsigned long long>(ioReport.errors));
+  std::printf("  \"ops_per_sec\": %.1f,\n", static_cast<double>(ioReport.operations) / seconds);
+  std::printf("  \"mb_per_sec\": %.3f,\n", static_cast<double>(ioReport.bytes) / seconds / 1e6);
+  std::printf("  \"latency_us\": {\"p50\": %.3f, \"p99\": %.3f, \"p99_9\": %.3f, \"max\": %.3f}\n", us(0.50),
+              us(0.99), us(0.999), us(1.0));
+  std::printf("}\n");
+}
+
+
+} // namespace bench
+} // namespace ncs
+
+
+/**
+ * @brief
+ */
+int main(int argc, char** argv) {
+  using namespace ncs::bench;
+  bench_options_t options;
+  if (!parse_options(argc, argv, options)) {
+    usage(argv[0]);
+    return 2;
+  }
+  bench_report_t report;
+  if (options.scenario == "pingpong") {
+    report = run_pingpong(options);
+  }
+  else if (options.scenario == "stream") {
+    report = run_stream(options);
+  }
+  else if (options.scenario == "reqresp") {
+    report = run_reqresp(options);
+  }
+  else if (options.scenario == "connrate") {
+    report = run_connrate(options);
+  }
+  else {
+    usage(argv[0]);
+    return 2;
+  }
+  print_json(options, report);
+  return (report.errors == 0) ? 0 : 1;
+}
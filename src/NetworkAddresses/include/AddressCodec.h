@@ -0,0 +1,137 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file AddressCodec.h
+ *
+ * @brief Fixed size binary wire format of addresses and address lists
+ */
+
+
+#ifndef NCS_ADDRESS_CODEC_H
+#define NCS_ADDRESS_CODEC_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <FixedAddress.h>
+#include <InternetAddress.h>
+
+
+namespace ncs { // Network Communications System
+namespace addr { // Network Communications System Addresses
+
+
+/**
+ * AddressCodec constants
+ *
+ * An address takes WIRE_ADDRESS_SIZE bytes: its wire_family_e, 16 address bytes in network order, IPv4 ones in the
+ * first 4 and the rest zeroed, then the port, big endian. A list is a WIRE_HEADER_SIZE bytes header, WIRE_MAGIC, the
+ * version, the size of each record and the record count as a big endian 32 bits integer, followed by the records.
+ * Records larger than WIRE_ADDRESS_SIZE leave room for fields a later revision of the same version appends, readers
+ * skip them. Both byte orders are the sockaddr ones, so binary addresses are encoded and decoded by plain copies.
+ */
+constexpr std::size_t WIRE_ADDRESS_SIZE = 19;
+constexpr std::size_t WIRE_HEADER_SIZE = 8;
+constexpr std::uint8_t WIRE_MAGIC[2] = {'N', 'A'};
+constexpr std::uint8_t WIRE_VERSION = 1;      // Bumped on changes older readers must not decode
+
+/**
+ * @brief
+ */
+enum wire_family_e : std::uint8_t {
+  WIRE_FAMILY_INET  = 4,
+  WIRE_FAMILY_INET6 = 6,
+};
+
+
+/**
+ * @brief Writes the WIRE_ADDRESS_SIZE bytes of iAddr to oWire
+ *
+ * @param iAddr
+ * @param oWire
+ */
+void encode_address(const inet_address_t& iAddr, std::uint8_t* oWire);
+
+/**
+ * @brief Writes the WIRE_ADDRESS_SIZE bytes of iAddr to oWire
+ *
+ * @param iAddr
+ * @param oWire
+ *
+ * @return False, leaving oWire untouched, if iAddr does not fit a sockaddr
+ */
+[[nodiscard]] bool encode_address(const InternetAddress& iAddr, std::uint8_t* oWire);
+
+/**
+ * @brief Reads WIRE_ADDRESS_SIZE bytes from iWire
+ *
+ * @param iWire
+ * @param oAddr
+ *
+ * @return False on an unknown family
+ */
+[[nodiscard]] bool decode_address(const std::uint8_t* iWire, inet_address_t& oAddr);
+
+/**
+ * @brief Reads WIRE_ADDRESS_SIZE bytes from iWire
+ *
+ * @param iWire
+ * @param oAddr
+ *
+ * @return False on an unknown family
+ */
+[[nodiscard]] bool decode_address(const std::uint8_t* iWire, InternetAddress& oAddr);
+
+/**
+ * @brief Appends iAddrs to oWire as a list, header included
+ *
+ * @param iAddrs
+ * @param oWire
+ */
+void encode_addresses(const std::vector<inet_address_t>& iAddrs, std::vector<std::uint8_t>& oWire);
+
+/**
+ * @brief Appends iAddrs to oWire as a list, header included
+ *
+ * @param iAddrs
+ * @param oWire
+ *
+ * @return False, leaving oWire untouched, if some address does not fit a sockaddr
+ */
+[[nodiscard]] bool encode_addresses(const std::vector<InternetAddress>& iAddrs, std::vector<std::uint8_t>& oWire);
+
+/**
+ * @brief Reads a list from the iSize bytes at iWire, replacing the content of oAddrs
+ *
+ * @param iWire
+ * @param iSize
+ * @param oAddrs
+ *
+ * @return Bytes the list took, 0 if it is truncated, of another version or holds an unknown family
+ */
+[[nodiscard]] std::size_t decode_addresses(const std::uint8_t* iWire, const std::size_t& iSize,
+                                           std::vector<inet_address_t>& oAddrs);
+
+/**
+ * @brief Reads a list from the iSize bytes at iWire, replacing the content of oAddrs
+ *
+ * @param iWire
+ * @param iSize
+ * @param oAddrs
+ *
+ * @return Bytes the list took, 0 if it is truncated, of another version or holds an unknown family
+ */
+[[nodiscard]] std::size_t decode_addresses(const std::uint8_t* iWire, const std::size_t& iSize,
+                                           std::vector<InternetAddress>& oAddrs);
+
+
+} // namespace addr
+} // namespace ncs
+
+
+#endif // NCS_ADDRESS_CODEC_H
@@ -0,0 +1,288 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file AddressPool.h
+ *
+ * @brief Interning pool storing every distinct ip once behind a compact handle
+ */
+
+
+#ifndef NCS_ADDRESS_POOL_H
+#define NCS_ADDRESS_POOL_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include <InternetAddress.h>
+
+
+namespace ncs { // Network Communications System
+namespace addr { // Network Communications System Addresses
+
+
+/**
+ * AddressPool types
+ */
+using address_handle_t = std::uint64_t;   // Generation in the high half, slot in the low half
+
+/**
+ * AddressPool constants
+ */
+constexpr address_handle_t INVALID_ADDRESS_HANDLE = std::numeric_limits<address_handle_t>::max();
+
+/**
+ * @brief Endpoint of a connection with its ip held by an AddressPool
+ */
+struct pooled_address_t {
+  address_handle_t ip = INVALID_ADDRESS_HANDLE;
+  std::uint16_t port = 0;
+
+  [[nodiscard]] bool operator==(const pooled_address_t& iOther) const {
+    return (this->ip == iOther.ip) && (this->port == iOther.port);
+  }
+
+  [[nodiscard]] bool operator!=(const pooled_address_t& iOther) const {
+    return !(*this == iOther);
+  }
+};
+
+/**
+ * @brief Binary ip, IPv4 addresses use the first 4 bytes
+ */
+struct pool_key_t {
+  std::uint8_t bytes[sizeof(in6_addr)] = {};
+  std::uint8_t family = AF_UNSPEC;
+
+  [[nodiscard]] bool operator==(const pool_key_t& iOther) const;
+};
+
+/**
+ * @brief FNV-1a over the key bytes
+ */
+struct pool_key_hash_t {
+  [[nodiscard]] std::size_t operator()(const pool_key_t& iKey) const;
+};
+
+/**
+ * @brief
+ */
+struct pool_entry_t {
+  pool_key_t key;
+  std::uint32_t refs = 0;                 // 0 for a reclaimed slot
+  std::uint32_t generation = 0;           // Bumped on reclaim, stale handles no longer match
+};
+
+
+/**
+ * @brief Stores each distinct ip once, equal ips get equal handles and unreferenced entries are reclaimed
+ */
+class AddressPool {
+public:
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+  /**
+   * @brief Default constructor
+   */
+  AddressPool(void);
+
+  /**
+   * @brief Copy constructor
+   */
+  AddressPool(const AddressPool& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Takes a reference to the entry of iIp, adding it if missing
+   * 
+   * @param iIp IPv4 or IPv6 address, textual variants of the same address share the entry
+   * 
+   * @return INVALID_ADDRESS_HANDLE if iIp is not a valid address
+   */
+  [[nodiscard]] address_handle_t intern(const ip_t& iIp);
+
+  /**
+   * @brief Takes a reference to the entry of the ip of a sockaddr_in or sockaddr_in6, the port is ignored
+   * 
+   * @param iAddr
+   * @param iSize
+   * 
+   * @return INVALID_ADDRESS_HANDLE if iAddr is neither
+   */
+  [[nodiscard]] address_handle_t intern(const sockaddr* iAddr, const socklen_t& iSize);
+
+  /**
+   * @brief Takes one more reference to a held entry
+   * 
+   * @param iHandle
+   * 
+   * @return False if iHandle is not live
+   */
+  [[nodiscard]] bool retain(const address_handle_t& iHandle);
+
+  /**
+   * @brief Drops one reference, the entry is reclaimed with the last one and its handle stops being live
+   * 
+   * @param iHandle
+   * 
+   * @return False if iHandle is not live
+   */
+  bool release(const address_handle_t& iHandle);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+  /**
+   * @brief Text form of the ip of a live handle
+   * 
+   * @param iHandle
+   * @param oIp
+   * 
+   * @return
+   */
+  [[nodiscard]] bool get_ip(const address_handle_t& iHandle, ip_t& oIp) const;
+
+  /**
+   * @brief
+   * 
+   * @param iHandle
+   * 
+   * @return NET_ADDR_FAM_UNKNOWN if iHandle is not live
+   */
+  [[nodiscard]] addr_family_e get_address_family(const address_handle_t& iHandle) const;
+
+  /**
+   * @brief
+   * 
+   * @param iHandle
+   * 
+   * @return 0 if iHandle is not live
+   */
+  [[nodiscard]] std::uint32_t get_refs(const address_handle_t& iHandle) const;
+
+  /**
+   * @brief Live entries
+   * 
+   * @return
+   */
+  [[nodiscard]] std::size_t get_size(void) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+  /**
+   * @brief Full address of a pooled connection endpoint
+   * 
+   * @param iAddr
+   * @param oAddr
+   * 
+   * @return False if the ip handle is not live
+   */
+  [[nodiscard]] bool to_address(const pooled_address_t& iAddr, InternetAddress& oAddr) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+  /**
+   * @brief Copy assignment operator
+   */
+  AddressPool& operator=(const AddressPool& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+  /**
+   * @brief Destructor
+   */
+  ~AddressPool();
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+protected:
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Takes a reference to the entry of iKey, adding it if missing
+   * 
+   * @param iKey
+   * 
+   * @return
+   */
+  [[nodiscard]] address_handle_t intern(const pool_key_t& iKey);
+
+  /**
+   * @brief Whether iHandle names a live entry, the caller holds the lock
+   * 
+   * @param iHandle
+   * 
+   * @return
+   */
+  [[nodiscard]] bool is_live(const address_handle_t& iHandle) const;
+
+  /**
+   * @brief Handle of a slot at its current generation
+   * 
+   * @param iSlot
+   * 
+   * @return
+   */
+  [[nodiscard]] address_handle_t make_handle(const std::uint32_t& iSlot) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+  mutable std::shared_mutex mutex_;                                          // Shared by readers
+  std::vector<pool_entry_t> entries_;
+  std::vector<std::uint32_t> free_;                                          // Reclaimed slots
+  std::unordered_map<pool_key_t, address_handle_t, pool_key_hash_t> index_;
+};
+
+
+} // namespace addr
+} // namespace ncs
+
+
+#endif // NCS_ADDRESS_POOL_H
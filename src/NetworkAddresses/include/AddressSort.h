@@ -0,0 +1,52 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file AddressSort.h
+ *
+ * @brief Radix sort of address lists on their binary sort keys
+ */
+
+
+#ifndef NCS_ADDRESS_SORT_H
+#define NCS_ADDRESS_SORT_H
+
+
+#include <cstddef>
+#include <vector>
+
+#include <InternetAddress.h>
+
+
+namespace ncs { // Network Communications System
+namespace addr { // Network Communications System Addresses
+
+
+/**
+ * @brief Sorts iAddresses in the order of InternetAddress::compare(), stable
+ *
+ * Every address is parsed once into its sort key, then the keys are sorted with a byte wise LSD radix sort that skips
+ * the bytes shared by all of them, so a list of IPv4 peers takes six passes. Ips that are neither IPv4 nor IPv6 go
+ * last and are sorted by comparison, like the rare ports that do not fit in 16 bits among the ones of their address.
+ *
+ * @param ioAddresses
+ */
+void sort_addresses(std::vector<InternetAddress>& ioAddresses);
+
+/**
+ * @brief Sorts iAddresses and removes the repeated ones, keeping the first spelling of each address
+ *
+ * @param ioAddresses
+ *
+ * @return Number of addresses removed
+ */
+std::size_t unique_addresses(std::vector<InternetAddress>& ioAddresses);
+
+
+} // namespace addr
+} // namespace ncs
+
+
+#endif // NCS_ADDRESS_SORT_H
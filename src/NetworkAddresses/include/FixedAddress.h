@@ -0,0 +1,459 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file FixedAddress.h
+ *
+ * @brief Addresses whose family and sockaddr layout are fixed at compile time
+ */
+
+
+#ifndef NCS_FIXED_ADDRESS_H
+#define NCS_FIXED_ADDRESS_H
+
+
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <variant>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include <InternetAddress.h>
+#include <NetworkAddress.h>
+
+
+namespace ncs { // Network Communications System
+namespace addr { // Network Communications System Addresses
+
+
+/**
+ * @brief Binary IPv4 or IPv6 address and port, stored as the sockaddr handed to the kernel
+ */
+template <addr_family_e Family>
+class FixedAddress : public NetworkAddress<FixedAddress<Family>> {
+  static_assert((Family == NET_ADDR_FAM_INET) || (Family == NET_ADDR_FAM_INET6), "only IPv4 and IPv6 are supported");
+
+public:
+  using sockaddr_t = std::conditional_t<Family == NET_ADDR_FAM_INET, sockaddr_in, sockaddr_in6>;
+
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+  /**
+   * @brief Default constructor, wildcard address and port 0
+   */
+  FixedAddress(void);
+
+  /**
+   * @brief Sockaddr constructor
+   * 
+   * @param iAddr
+   */
+  explicit FixedAddress(const sockaddr_t& iAddr);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Sets the address from its text form
+   * 
+   * @param iIp
+   * @param iPort
+   * 
+   * @return False, leaving the address untouched, if iIp is not of the family or iPort does not fit in 16 bits
+   */
+  [[nodiscard]] bool parse(const ip_t& iIp, const port_t& iPort);
+
+  /**
+   * @brief Sets the address from an InternetAddress of the same family
+   * 
+   * @param iAddr
+   * 
+   * @return
+   */
+  [[nodiscard]] bool assign(const InternetAddress& iAddr);
+
+  /**
+   * @brief Whether the address is an IPv4 (224.0.0.0/4) or IPv6 (ff00::/8) multicast group
+   * 
+   * @return
+   */
+  [[nodiscard]] bool is_multicast(void) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+  /**
+   * @brief
+   * 
+   * @param iPort Truncated to 16 bits
+   */
+  void set_port(const port_t& iPort);
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] port_t get_port(void) const;
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] static constexpr addr_family_e get_address_family(void) {
+    return Family;
+  }
+
+  /**
+   * @brief Address ready for bind(2), connect(2) or sendto(2)
+   * 
+   * @return
+   */
+  [[nodiscard]] const sockaddr* get_sockaddr(void) const;
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] static constexpr socklen_t get_sockaddr_size(void) {
+    return sizeof(sockaddr_t);
+  }
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+  /**
+   * @brief Same format as InternetAddress::to_string()
+   * 
+   * @return
+   */
+  [[nodiscard]] std::string to_string(void) const;
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] InternetAddress to_internet_address(void) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+  /**
+   * @brief Compares address and port
+   * 
+   * @param iOther
+   * 
+   * @return
+   */
+  [[nodiscard]] bool operator==(const FixedAddress& iOther) const;
+
+  /**
+   * @brief
+   * 
+   * @param iOther
+   * 
+   * @return
+   */
+  [[nodiscard]] bool operator!=(const FixedAddress& iOther) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+  /**
+   * @brief Destructor
+   */
+  ~FixedAddress() = default;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+protected:
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+  /**
+   * @brief Address bytes in network byte order
+   * 
+   * @return
+   */
+  [[nodiscard]] const void* get_ip_bytes(void) const;
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] static constexpr std::size_t get_ip_size(void) {
+    return (Family == NET_ADDR_FAM_INET) ? sizeof(in_addr) : sizeof(in6_addr);
+  }
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+  sockaddr_t addr_;
+};
+
+/**
+ * FixedAddress types
+ */
+using Inet4Address = FixedAddress<NET_ADDR_FAM_INET>;
+using Inet6Address = FixedAddress<NET_ADDR_FAM_INET6>;
+using inet_address_t = std::variant<Inet4Address, Inet6Address>;   // Closed set of the internet address kinds
+
+/**
+ * @brief Binary form of iAddr, of the kind matching its family
+ * 
+ * @param iAddr
+ * @param oAddr
+ * 
+ * @return False if iAddr is not a valid IPv4/IPv6 address or its port does not fit in 16 bits
+ */
+[[nodiscard]] bool to_inet_address(const InternetAddress& iAddr, inet_address_t& oAddr);
+
+/**
+ * @brief Sockaddr of whichever kind iAddr holds
+ * 
+ * @param iAddr
+ * @param oSize
+ * 
+ * @return
+ */
+[[nodiscard]] inline const sockaddr* get_sockaddr(const inet_address_t& iAddr, socklen_t& oSize) {
+  // A branch on the index, cheaper than the jump table of std::visit for two kinds
+  if (const Inet4Address* addr4 = std::get_if<Inet4Address>(&iAddr)) {
+    oSize = Inet4Address::get_sockaddr_size();
+    return addr4->get_sockaddr();
+  }
+  oSize = Inet6Address::get_sockaddr_size();
+  return std::get_if<Inet6Address>(&iAddr)->get_sockaddr();
+}
+
+/**
+ * @brief Family of whichever kind iAddr holds
+ * 
+ * @param iAddr
+ * 
+ * @return
+ */
+[[nodiscard]] inline addr_family_e get_address_family(const inet_address_t& iAddr) {
+  return std::holds_alternative<Inet4Address>(iAddr) ? Inet4Address::get_address_family() :
+                                                       Inet6Address::get_address_family();
+}
+
+
+/**
+ * @brief Default constructor
+ */
+template <addr_family_e Family>
+FixedAddress<Family>::FixedAddress(void) : addr_() {
+  if constexpr (Family == NET_ADDR_FAM_INET) {
+    this->addr_.sin_family = AF_INET;
+  } else {
+    this->addr_.sin6_family = AF_INET6;
+  }
+}
+
+/**
+ * @brief Sockaddr constructor
+ * 
+ * @param iAddr
+ */
+template <addr_family_e Family>
+FixedAddress<Family>::FixedAddress(const sockaddr_t& iAddr) : addr_(iAddr) {}
+
+/**
+ * @brief Sets the address from its text form
+ * 
+ * @param iIp
+ * @param iPort
+ * 
+ * @return
+ */
+template <addr_family_e Family>
+[[nodiscard]] bool FixedAddress<Family>::parse(const ip_t& iIp, const port_t& iPort) {
+  if ((iPort < 0) || (iPort > MAX_VALID_PORT)) {
+    return false;
+  }
+  sockaddr_t addr = FixedAddress().addr_;
+  void* bytes = nullptr;
+  if constexpr (Family == NET_ADDR_FAM_INET) {
+    bytes = &addr.sin_addr;
+  } else {
+    bytes = &addr.sin6_addr;
+  }
+  if (inet_pton(Family, iIp.c_str(), bytes) != 1) {
+    return false;
+  }
+  this->addr_ = addr;
+  this->set_port(iPort);
+  return true;
+}
+
+/**
+ * @brief Sets the address from an InternetAddress of the same family
+ * 
+ * @param iAddr
+ * 
+ * @return
+ */
+template <addr_family_e Family>
+[[nodiscard]] bool FixedAddress<Family>::assign(const InternetAddress& iAddr) {
+  return this->parse(iAddr.get_ip(), iAddr.get_port());
+}
+
+/**
+ * @brief Whether the address is a multicast group
+ * 
+ * @return
+ */
+template <addr_family_e Family>
+[[nodiscard]] bool FixedAddress<Family>::is_multicast(void) const {
+  if constexpr (Family == NET_ADDR_FAM_INET) {
+    return IN_MULTICAST(ntohl(this->addr_.sin_addr.s_addr));
+  } else {
+    return IN6_IS_ADDR_MULTICAST(&this->addr_.sin6_addr);
+  }
+}
+
+/**
+ * @brief
+ * 
+ * @param iPort
+ */
+template <addr_family_e Family>
+void FixedAddress<Family>::set_port(const port_t& iPort) {
+  if constexpr (Family == NET_ADDR_FAM_INET) {
+    this->addr_.sin_port = htons(static_cast<in_port_t>(iPort));
+  } else {
+    this->addr_.sin6_port = htons(static_cast<in_port_t>(iPort));
+  }
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+template <addr_family_e Family>
+[[nodiscard]] port_t FixedAddress<Family>::get_port(void) const {
+  if constexpr (Family == NET_ADDR_FAM_INET) {
+    return ntohs(this->addr_.sin_port);
+  } else {
+    return ntohs(this->addr_.sin6_port);
+  }
+}
+
+/**
+ * @brief Address ready for bind(2), connect(2) or sendto(2)
+ * 
+ * @return
+ */
+template <addr_family_e Family>
+[[nodiscard]] const sockaddr* FixedAddress<Family>::get_sockaddr(void) const {
+  return reinterpret_cast<const sockaddr*>(&this->addr_);
+}
+
+/**
+ * @brief Same format as InternetAddress::to_string()
+ * 
+ * @return
+ */
+template <addr_family_e Family>
+[[nodiscard]] std::string FixedAddress<Family>::to_string(void) const {
+  return this->to_internet_address().to_string();
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+template <addr_family_e Family>
+[[nodiscard]] InternetAddress FixedAddress<Family>::to_internet_address(void) const {
+  InternetAddress addr;
+  (void)addr.set_sockaddr(this->get_sockaddr(), get_sockaddr_size());
+  return addr;
+}
+
+/**
+ * @brief Compares address and port
+ * 
+ * @param iOther
+ * 
+ * @return
+ */
+template <addr_family_e Family>
+[[nodiscard]] bool FixedAddress<Family>::operator==(const FixedAddress& iOther) const {
+  return (this->get_port() == iOther.get_port()) &&
+         (std::memcmp(this->get_ip_bytes(), iOther.get_ip_bytes(), get_ip_size()) == 0);
+}
+
+/**
+ * @brief
+ * 
+ * @param iOther
+ * 
+ * @return
+ */
+template <addr_family_e Family>
+[[nodiscard]] bool FixedAddress<Family>::operator!=(const FixedAddress& iOther) const {
+  return !(*this == iOther);
+}
+
+/**
+ * @brief Address bytes in network byte order
+ * 
+ * @return
+ */
+template <addr_family_e Family>
+[[nodiscard]] const void* FixedAddress<Family>::get_ip_bytes(void) const {
+  if constexpr (Family == NET_ADDR_FAM_INET) {
+    return &this->addr_.sin_addr;
+  } else {
+    return &this->addr_.sin6_addr;
+  }
+}
+
+
+} // namespace addr
+} // namespace ncs
+
+
+#endif // NCS_FIXED_ADDRESS_H
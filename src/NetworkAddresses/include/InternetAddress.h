@@ -14,8 +14,12 @@
 #define NC_INTERNET_ADDRESS_H
 
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
+#include <netinet/in.h>
+
 #include <NetworkAddress.h>
 
 
@@ -38,11 +42,39 @@ constexpr port_t RANDOM_PORT =  0;     // Use to allow the machine to select the
 constexpr port_t MIN_VALID_PORT =  1023;     // Use to set the minimum valid port value
 constexpr port_t MAX_VALID_PORT = 65535;     // Use to set the maximum valid port value
 
+constexpr std::size_t ADDRESS_KEY_SIZE = 19;    // Kind, 16 address bytes and the port, big endian
+
+/**
+ * @brief Kind of address held by the first byte of a sort key, in sort order
+ */
+enum address_key_kind_e : std::uint8_t {
+  ADDRESS_KEY_INET  = 0,      // IPv4, address in bytes 1 to 4, bytes 5 to 16 zeroed
+  ADDRESS_KEY_INET6 = 1,      // IPv6, address in bytes 1 to 16
+  ADDRESS_KEY_OTHER = 2,      // Ip that is neither, or port that does not fit in 16 bits, the rest zeroed
+};
+
+/**
+ * @brief Fixed width binary form of an address, compared with memcmp it follows numeric address order
+ */
+struct address_key_t {
+  std::uint8_t bytes[ADDRESS_KEY_SIZE] = {};
+};
+
+
+/**
+ * @brief Key of an IPv4 mapped IPv6 address, ::ffff:0:0/96, rewritten as the key of the IPv4 address it maps
+ * 
+ * @param iKey
+ * 
+ * @return iKey itself for any other address
+ */
+[[nodiscard]] address_key_t fold_v4_mapped(const address_key_t& iKey);
+
 
 /**
  * @brief
  */
-class InternetAddress : NetworkAddress {
+class InternetAddress : public NetworkAddress<InternetAddress> {
 public:
 /// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
   /**
@@ -95,6 +127,25 @@ public:
    */
   [[nodiscard]] bool has_valid_port(void) const;
 
+  /**
+   * @brief Whether the ip is an IPv4 (224.0.0.0/4) or IPv6 (ff00::/8) multicast group
+   * 
+   * @return
+   */
+  [[nodiscard]] bool is_multicast(void) const;
+
+  /**
+   * @brief Three way comparison in numeric order: IPv4 before IPv6, each by address then port
+   * 
+   * Different spellings of an address compare equal, as they do with operator==. Ips that are neither IPv4 nor IPv6 go
+   * last, ordered by their text and port. Ports that do not fit in 16 bits keep their numeric order.
+   * 
+   * @param iOther
+   * 
+   * @return Negative, zero or positive as the address goes before, with or after iOther
+   */
+  [[nodiscard]] int compare(const InternetAddress& iOther) const;
+
   /**
    * @brief
    */
@@ -115,6 +166,16 @@ public:
    * @param iPort 
    */
   void set_port(const port_t& iPort);
+
+  /**
+   * @brief Sets the ip and port from a sockaddr_in or sockaddr_in6
+   * 
+   * @param iAddr
+   * @param iSize
+   * 
+   * @return False if the family is neither AF_INET nor AF_INET6
+   */
+  [[nodiscard]] bool set_sockaddr(const sockaddr* iAddr, const socklen_t& iSize);
   
   /**
    * @brief
@@ -131,11 +192,21 @@ public:
   [[nodiscard]] const port_t& get_port(void) const;
 
   /**
-   * @brief
+   * @brief Family of the ip as written, IPv4 mapped IPv6 addresses are AF_INET6
    * 
    * @return
    */
   [[nodiscard]] addr_family_e get_address_family(void) const;
+
+  /**
+   * @brief Canonical binary form of the address, computed when the ip or the port is set
+   * 
+   * Laid out like the sort key, with ADDRESS_KEY_OTHER and zeroed address bytes when the ip is neither IPv4 nor IPv6,
+   * and the port bytes zeroed when the port does not fit in 16 bits.
+   * 
+   * @return
+   */
+  [[nodiscard]] const address_key_t& get_key(void) const;
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
@@ -145,6 +216,25 @@ public:
    * @return
    */
   [[nodiscard]] std::string to_string(void) const;
+
+  /**
+   * @brief Fills a sockaddr_in or sockaddr_in6 with the address
+   * 
+   * @param oAddr
+   * @param oSize
+   * 
+   * @return False if the ip is not a valid IPv4/IPv6 address or the port does not fit in 16 bits
+   */
+  [[nodiscard]] bool to_sockaddr(sockaddr_storage& oAddr, socklen_t& oSize) const;
+
+  /**
+   * @brief Fills the sort key of the address
+   * 
+   * @param oKey
+   * 
+   * @return False, with an ADDRESS_KEY_OTHER key, if the address does not fit a sockaddr
+   */
+  bool to_key(address_key_t& oKey) const;
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
@@ -167,7 +257,10 @@ public:
   InternetAddress& operator=(InternetAddress&& iOther) noexcept;
 
   /**
-   * @brief
+   * @brief Compares the canonical keys and the ports, so different spellings of an address are equal
+   * 
+   * Ips that are neither IPv4 nor IPv6 are compared as text. An IPv4 mapped address and the IPv4 address it maps
+   * differ, folded_address_equal_t treats them as one.
    * 
    * @param iOther
    * 
@@ -183,6 +276,42 @@ public:
    * @return
    */
   [[nodiscard]] bool operator!=(const InternetAddress& iOther) const;
+
+  /**
+   * @brief Numeric order, see compare()
+   * 
+   * @param iOther
+   * 
+   * @return
+   */
+  [[nodiscard]] bool operator<(const InternetAddress& iOther) const;
+
+  /**
+   * @brief
+   * 
+   * @param iOther
+   * 
+   * @return
+   */
+  [[nodiscard]] bool operator<=(const InternetAddress& iOther) const;
+
+  /**
+   * @brief
+   * 
+   * @param iOther
+   * 
+   * @return
+   */
+  [[nodiscard]] bool operator>(const InternetAddress& iOther) const;
+
+  /**
+   * @brief
+   * 
+   * @param iOther
+   * 
+   * @return
+   */
+  [[nodiscard]] bool operator>=(const InternetAddress& iOther) const;
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
@@ -244,6 +373,14 @@ private:
    * @return
    */
   [[nodiscard]] bool has_valid_v6_ip(void) const;
+
+  /**
+   * @brief Sets the family and the address bytes of the key from the binary ip iBytes
+   * 
+   * @param iFamily AF_INET, AF_INET6, or NET_ADDR_FAM_UNKNOWN for an ip that is neither
+   * @param iBytes in_addr or in6_addr, unused for NET_ADDR_FAM_UNKNOWN
+   */
+  void set_binary(const addr_family_e& iFamily, const void* iBytes);
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
@@ -262,6 +399,30 @@ private:
 private:
   ip_t ip_;
   port_t port_;
+  addr_family_e family_;
+  address_key_t key_;
+};
+
+
+/**
+ * @brief FNV-1a over the canonical key and the port, consistent with operator==
+ */
+struct internet_address_hash_t {
+  [[nodiscard]] std::size_t operator()(const InternetAddress& iAddr) const;
+};
+
+/**
+ * @brief Hash of the key folded by fold_v4_mapped() and the port, consistent with folded_address_equal_t
+ */
+struct folded_address_hash_t {
+  [[nodiscard]] std::size_t operator()(const InternetAddress& iAddr) const;
+};
+
+/**
+ * @brief Equality for containers that hold an IPv4 peer once, however it is written, with folded_address_hash_t
+ */
+struct folded_address_equal_t {
+  [[nodiscard]] bool operator()(const InternetAddress& iLeft, const InternetAddress& iRight) const;
 };
 
 
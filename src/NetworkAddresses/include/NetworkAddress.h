@@ -80,8 +80,12 @@ enum addr_family_e {
 
 
 /**
- * @brief 
+ * @brief Static base of the address types, Address provides get_address_family()
+ * 
+ * The family is resolved without virtual calls, addresses carry no vtable pointer and are never deleted through the
+ * base
  */
+template <typename Address>
 class NetworkAddress {
 public:
 /// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
@@ -92,11 +96,13 @@ public:
 
 /// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
   /**
-   * @brief
+   * @brief Whether the address belongs to iFamily
+   * 
+   * @param iFamily
    * 
    * @return
    */
-  [[nodiscard]] virtual addr_family_e get_address_family(void) const = 0;
+  [[nodiscard]] bool has_family(const addr_family_e& iFamily) const;
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
@@ -109,10 +115,6 @@ public:
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
-  /**
-   * @brief
-   */
-  virtual ~NetworkAddress();
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
   
 
@@ -121,7 +123,7 @@ protected:
   /**
    * @brief
    */
-  NetworkAddress(void);
+  NetworkAddress(void) = default;
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
@@ -137,6 +139,10 @@ protected:
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+  /**
+   * @brief Destructor
+   */
+  ~NetworkAddress() = default;
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
   
 
@@ -160,6 +166,18 @@ private:
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 };
 
+/**
+ * @brief Whether the address belongs to iFamily
+ * 
+ * @param iFamily
+ * 
+ * @return
+ */
+template <typename Address>
+[[nodiscard]] bool NetworkAddress<Address>::has_family(const addr_family_e& iFamily) const {
+  return static_cast<const Address&>(*this).get_address_family() == iFamily;
+}
+
 
 } // namespace addr
 } // namespace ncs
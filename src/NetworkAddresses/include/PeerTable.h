@@ -0,0 +1,405 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file PeerTable.h
+ *
+ * @brief Persistent table of known peers, memory mapped and used in place
+ */
+
+
+#ifndef NCS_PEER_TABLE_H
+#define NCS_PEER_TABLE_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include <AddressCodec.h>
+#include <FixedAddress.h>
+#include <InternetAddress.h>
+
+
+namespace ncs { // Network Communications System
+namespace addr { // Network Communications System Addresses
+
+
+/**
+ * PeerTable constants
+ *
+ * A table file is a peer_table_header_t, an open addressing index of 32 bits entries, a power of two at least twice
+ * the capacity, then the records. Records are only appended: a put or a remove writes the new record of the address
+ * past the last one, counts it in committed, then points the index entry of the address at it and counts it in
+ * indexed. Integers are in host byte order, tables are not meant to move between machines.
+ */
+constexpr std::size_t DEFAULT_PEER_TABLE_CAPACITY = 4096;
+constexpr std::size_t MAX_PEER_TABLE_CAPACITY = std::size_t(1) << 30;   // Index entries are 32 bits
+constexpr char PEER_TABLE_MAGIC[8] = {'N', 'C', 'S', 'P', 'E', 'E', 'R', 'S'};
+constexpr std::uint32_t PEER_TABLE_VERSION = 1;                         // Bumped on any change of the layout
+
+/**
+ * @brief
+ */
+enum peer_state_e : std::uint8_t {
+  PEER_LIVE    = 1,
+  PEER_REMOVED = 2,
+};
+
+/**
+ * @brief Metadata kept with each peer
+ */
+struct peer_info_t {
+  std::uint32_t rtt_us = 0;
+  std::uint64_t last_seen = 0;                  // Wall clock seconds, monotonic clocks do not survive a reboot
+  std::uint32_t failures = 0;                   // Consecutive failed connects
+};
+
+/**
+ * @brief One record of the table, 40 bytes without padding
+ */
+struct peer_record_t {
+  std::uint8_t address[WIRE_ADDRESS_SIZE];      // AddressCodec layout
+  std::uint8_t state;                           // peer_state_e
+  std::uint32_t rtt_us;
+  std::uint64_t last_seen;
+  std::uint32_t failures;
+  std::uint32_t checksum;                       // FNV-1a of the bytes before it
+};
+
+/**
+ * @brief First 64 bytes of a table file
+ */
+struct peer_table_header_t {
+  char magic[sizeof(PEER_TABLE_MAGIC)];
+  std::uint32_t version;
+  std::uint32_t record_size;
+  std::uint64_t capacity;                       // Records
+  std::uint64_t index_slots;
+  std::uint64_t committed;                      // Records that are part of the table
+  std::uint64_t indexed;                        // Records the index points to, committed unless a put was cut short
+  std::uint64_t live;                           // Peers in the table
+  std::uint64_t reserved;
+};
+
+
+/**
+ * @brief Peers and their metadata kept in a file that is mapped, never parsed, on open
+ */
+class PeerTable {
+public:
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+  /**
+   * @brief Default constructor, the table is closed
+   */
+  PeerTable();
+
+  /**
+   * @brief Copy constructor
+   */
+  PeerTable(const PeerTable& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Maps the table at iPath, creating an empty one with room for iCapacity records if there is none
+   * 
+   * Opening only checks the header, whatever the size of the table. Records a crash left counted but not indexed are
+   * indexed again, the first torn one and the ones after it are dropped.
+   * 
+   * @param iPath
+   * @param iCapacity Records a new table makes room for, compaction never shrinks a table below it
+   * 
+   * @return False, with errno set, if the file cannot be mapped, EINVAL if it is not a table of this version
+   */
+  [[nodiscard]] bool open(const std::string& iPath, const std::size_t& iCapacity = DEFAULT_PEER_TABLE_CAPACITY);
+
+  /**
+   * @brief Unmaps the table, what was put stays in the page cache and reaches the disk on its own or on sync()
+   */
+  void close(void);
+
+  /**
+   * @brief Records iInfo as the metadata of iAddr, adding it if it is not in the table
+   * 
+   * Records are appended, the table is compacted when it runs out of room for them. A put survives a crash of the
+   * process as soon as it returns, and a power loss once sync() returned.
+   * 
+   * @param iAddr
+   * @param iInfo
+   * 
+   * @return False, with errno set, if the table is closed, iAddr does not fit a sockaddr or compaction failed
+   */
+  [[nodiscard]] bool put(const InternetAddress& iAddr, const peer_info_t& iInfo);
+
+  /**
+   * @brief Records iInfo as the metadata of iAddr, adding it if it is not in the table
+   * 
+   * @param iAddr
+   * @param iInfo
+   * 
+   * @return False, with errno set, if the table is closed or compaction failed
+   */
+  [[nodiscard]] bool put(const inet_address_t& iAddr, const peer_info_t& iInfo);
+
+  /**
+   * @brief Removes iAddr from the table, appending a record that says so
+   * 
+   * @param iAddr
+   * 
+   * @return False, with errno set, ENOENT if iAddr is not in the table
+   */
+  [[nodiscard]] bool remove(const InternetAddress& iAddr);
+
+  /**
+   * @brief Removes iAddr from the table, appending a record that says so
+   * 
+   * @param iAddr
+   * 
+   * @return False, with errno set, ENOENT if iAddr is not in the table
+   */
+  [[nodiscard]] bool remove(const inet_address_t& iAddr);
+
+  /**
+   * @brief Current record of iAddr, decode_address() turns its address back into an address
+   * 
+   * @param iAddr
+   * 
+   * @return Pointer into the mapping, valid until the next put, remove or compaction, nullptr if iAddr is not in it
+   */
+  [[nodiscard]] const peer_record_t* find(const InternetAddress& iAddr) const;
+
+  /**
+   * @brief Current record of iAddr
+   * 
+   * @param iAddr
+   * 
+   * @return Pointer into the mapping, valid until the next put, remove or compaction, nullptr if iAddr is not in it
+   */
+  [[nodiscard]] const peer_record_t* find(const inet_address_t& iAddr) const;
+
+  /**
+   * @brief Calls iVisit with the current record of every peer, in no particular order
+   * 
+   * @param iVisit
+   */
+  void for_each(const std::function<void(const peer_record_t&)>& iVisit) const;
+
+  /**
+   * @brief Rewrites the table with the current record of each peer only
+   * 
+   * The new table is written next to the old one, synced and renamed over it, a crash leaves one or the other. Its
+   * capacity is twice the peers in the table, iCapacity of open() at least.
+   * 
+   * @return False, with errno set, leaving the table as it was
+   */
+  [[nodiscard]] bool compact(void);
+
+  /**
+   * @brief Writes the mapping back to the disk and waits for it
+   * 
+   * @return False, with errno set
+   */
+  [[nodiscard]] bool sync(void) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] bool is_open(void) const;
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] const std::string& get_path(void) const;
+
+  /**
+   * @brief Peers in the table
+   * 
+   * @return
+   */
+  [[nodiscard]] std::size_t get_size(void) const;
+
+  /**
+   * @brief Records the table has room for before it needs compaction
+   * 
+   * @return
+   */
+  [[nodiscard]] std::size_t get_capacity(void) const;
+
+  /**
+   * @brief Records appended since the last compaction, superseded ones included
+   * 
+   * @return
+   */
+  [[nodiscard]] std::size_t get_committed(void) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+  /**
+   * @brief Copy assignment operator
+   */
+  PeerTable& operator=(const PeerTable& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+  /**
+   * @brief Destructor
+   */
+  ~PeerTable();
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+protected:
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Creates and maps an empty table at iPath, truncating any file there
+   * 
+   * @param iPath
+   * @param iCapacity
+   * 
+   * @return False, with errno set
+   */
+  [[nodiscard]] bool create(const std::string& iPath, const std::size_t& iCapacity);
+
+  /**
+   * @brief Syncs the table and renames it to iPath
+   * 
+   * @param iPath
+   * 
+   * @return False, with errno set
+   */
+  [[nodiscard]] bool publish(const std::string& iPath);
+
+  /**
+   * @brief Takes over the mapping of ioOther, closing this one
+   * 
+   * @param ioOther
+   */
+  void take(PeerTable& ioOther);
+
+  /**
+   * @brief Indexes the records counted but not indexed when the table was last written, dropping stale entries
+   */
+  void recover(void);
+
+  /**
+   * @brief Appends iRecord, counts it, then points the index at it
+   * 
+   * @param iRecord
+   * 
+   * @return False, with errno set
+   */
+  [[nodiscard]] bool append(peer_record_t& iRecord);
+
+  /**
+   * @brief Points the index entry of the address of the iNumber-th record at it
+   * 
+   * @param iNumber
+   */
+  void index(const std::size_t& iNumber);
+
+  /**
+   * @brief Index entry of iWire, the one holding it or the empty one where it would go
+   * 
+   * @param iWire
+   * 
+   * @return
+   */
+  [[nodiscard]] std::uint32_t* slot_of(const std::uint8_t* iWire) const;
+
+  /**
+   * @brief Record iEntry points at, null if the entry is empty or past the committed records
+   * 
+   * @param iEntry
+   * 
+   * @return
+   */
+  [[nodiscard]] const peer_record_t* record_of(const std::uint32_t& iEntry) const;
+
+  /**
+   * @brief Current record of the address at iWire
+   * 
+   * @param iWire
+   * 
+   * @return
+   */
+  [[nodiscard]] const peer_record_t* find(const std::uint8_t* iWire) const;
+
+  /**
+   * @brief Appends a record removing the address at iWire
+   * 
+   * @param iWire
+   * 
+   * @return
+   */
+  [[nodiscard]] bool remove(const std::uint8_t* iWire);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+  std::string path_;
+  int fd_;
+  std::uint8_t* map_;
+  std::size_t mapSize_;
+  std::size_t minCapacity_;
+  peer_table_header_t* header_;                 // Start of the mapping
+  std::uint32_t* index_;                        // Record number + 1 of each address, 0 for an empty entry
+  peer_record_t* records_;
+};
+
+
+} // namespace addr
+} // namespace ncs
+
+
+#endif // NCS_PEER_TABLE_H
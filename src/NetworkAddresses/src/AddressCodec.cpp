@@ -0,0 +1,266 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file AddressCodec.cpp
+ *
+ * @brief
+ */
+
+
+#include <AddressCodec.h>
+
+#include <cstring>
+
+
+namespace ncs { // Network Communications System
+namespace addr { // Network Communications System Addresses
+
+
+/**
+ * AddressCodec offsets
+ */
+constexpr std::size_t WIRE_IP_OFFSET = 1;
+constexpr std::size_t WIRE_PORT_OFFSET = 17;
+
+
+/**
+ * @brief Fills oAddr from the record at iWire, sin_port and sin6_port are big endian like the record
+ *
+ * @param iWire
+ * @param oAddr
+ * @param oSize
+ *
+ * @return
+ */
+static bool to_sockaddr(const std::uint8_t* iWire, sockaddr_storage& oAddr, socklen_t& oSize) {
+  if (iWire[0] == WIRE_FAMILY_INET) {
+    sockaddr_in& addr4 = reinterpret_cast<sockaddr_in&>(oAddr);
+    addr4 = {};
+    addr4.sin_family = AF_INET;
+    std::memcpy(&addr4.sin_addr, iWire + WIRE_IP_OFFSET, sizeof(addr4.sin_addr));
+    std::memcpy(&addr4.sin_port, iWire + WIRE_PORT_OFFSET, sizeof(addr4.sin_port));
+    oSize = sizeof(addr4);
+    return true;
+  }
+  if (iWire[0] == WIRE_FAMILY_INET6) {
+    sockaddr_in6& addr6 = reinterpret_cast<sockaddr_in6&>(oAddr);
+    addr6 = {};
+    addr6.sin6_family = AF_INET6;
+    std::memcpy(&addr6.sin6_addr, iWire + WIRE_IP_OFFSET, sizeof(addr6.sin6_addr));
+    std::memcpy(&addr6.sin6_port, iWire + WIRE_PORT_OFFSET, sizeof(addr6.sin6_port));
+    oSize = sizeof(addr6);
+    return true;
+  }
+  return false;
+}
+
+/**
+ * @brief Appends the header of a list of iCount records to ioWire and makes room for the records
+ *
+ * @param iCount
+ * @param ioWire
+ *
+ * @return First byte of the records
+ */
+static std::uint8_t* append_header(const std::size_t& iCount, std::vector<std::uint8_t>& ioWire) {
+  const std::size_t start = ioWire.size();
+  ioWire.resize(start + WIRE_HEADER_SIZE + iCount * WIRE_ADDRESS_SIZE);
+  std::uint8_t* header = ioWire.data() + start;
+  header[0] = WIRE_MAGIC[0];
+  header[1] = WIRE_MAGIC[1];
+  header[2] = WIRE_VERSION;
+  header[3] = static_cast<std::uint8_t>(WIRE_ADDRESS_SIZE);
+  const std::uint32_t count = htonl(static_cast<std::uint32_t>(iCount));
+  std::memcpy(header + 4, &count, sizeof(count));
+  return header + WIRE_HEADER_SIZE;
+}
+
+/**
+ * @brief Decodes every record of the list at iWire with iDecode
+ *
+ * @param iWire
+ * @param iSize
+ * @param oAddrs
+ * @param iDecode
+ *
+ * @return
+ */
+template <typename Address, typename Decode>
+static std::size_t decode_list(const std::uint8_t* iWire, const std::size_t& iSize, std::vector<Address>& oAddrs,
+                               Decode&& iDecode) {
+  oAddrs.clear();
+  if ((iSize < WIRE_HEADER_SIZE) || (iWire[0] != WIRE_MAGIC[0]) || (iWire[1] != WIRE_MAGIC[1]) ||
+      (iWire[2] != WIRE_VERSION) || (iWire[3] < WIRE_ADDRESS_SIZE)) {
+    return 0;
+  }
+  std::uint32_t count = 0;
+  std::memcpy(&count, iWire + 4, sizeof(count));
+  count = ntohl(count);
+  const std::size_t recordSize = iWire[3];
+  if ((iSize - WIRE_HEADER_SIZE) / recordSize < count) {
+    return 0;
+  }
+  oAddrs.resize(count);
+  const std::uint8_t* record = iWire + WIRE_HEADER_SIZE;
+  for (Address& addr : oAddrs) {
+    if (!iDecode(record, addr)) {
+      oAddrs.clear();
+      return 0;
+    }
+    record += recordSize;
+  }
+  return WIRE_HEADER_SIZE + count * recordSize;
+}
+
+
+/**
+ * @brief Writes the WIRE_ADDRESS_SIZE bytes of iAddr to oWire
+ *
+ * @param iAddr
+ * @param oWire
+ */
+void encode_address(const inet_address_t& iAddr, std::uint8_t* oWire) {
+  std::memset(oWire, 0, WIRE_ADDRESS_SIZE);
+  if (const Inet4Address* addr4 = std::get_if<Inet4Address>(&iAddr)) {
+    const sockaddr_in* addr = reinterpret_cast<const sockaddr_in*>(addr4->get_sockaddr());
+    oWire[0] = WIRE_FAMILY_INET;
+    std::memcpy(oWire + WIRE_IP_OFFSET, &addr->sin_addr, sizeof(addr->sin_addr));
+    std::memcpy(oWire + WIRE_PORT_OFFSET, &addr->sin_port, sizeof(addr->sin_port));
+  } else {
+    const sockaddr_in6* addr = reinterpret_cast<const sockaddr_in6*>(std::get<Inet6Address>(iAddr).get_sockaddr());
+    oWire[0] = WIRE_FAMILY_INET6;
+    std::memcpy(oWire + WIRE_IP_OFFSET, &addr->sin6_addr, sizeof(addr->sin6_addr));
+    std::memcpy(oWire + WIRE_PORT_OFFSET, &addr->sin6_port, sizeof(addr->sin6_port));
+  }
+}
+
+/**
+ * @brief Writes the WIRE_ADDRESS_SIZE bytes of iAddr to oWire
+ *
+ * @param iAddr
+ * @param oWire
+ *
+ * @return
+ */
+[[nodiscard]] bool encode_address(const InternetAddress& iAddr, std::uint8_t* oWire) {
+  // The sort key shares the layout, only the family byte differs. It is the family the address was written in, an
+  // IPv4 mapped address goes out as the IPv6 address it is and comes back as one
+  static_assert(ADDRESS_KEY_SIZE == WIRE_ADDRESS_SIZE, "the sort key and the wire format must share their layout");
+  address_key_t key;
+  if (!iAddr.to_key(key)) {
+    return false;
+  }
+  key.bytes[0] = (iAddr.get_address_family() == NET_ADDR_FAM_INET) ? WIRE_FAMILY_INET : WIRE_FAMILY_INET6;
+  std::memcpy(oWire, key.bytes, WIRE_ADDRESS_SIZE);
+  return true;
+}
+
+/**
+ * @brief Reads WIRE_ADDRESS_SIZE bytes from iWire
+ *
+ * @param iWire
+ * @param oAddr
+ *
+ * @return
+ */
+[[nodiscard]] bool decode_address(const std::uint8_t* iWire, inet_address_t& oAddr) {
+  sockaddr_storage storage;
+  socklen_t size = 0;
+  if (!to_sockaddr(iWire, storage, size)) {
+    return false;
+  }
+  if (storage.ss_family == AF_INET) {
+    oAddr.emplace<Inet4Address>(reinterpret_cast<const sockaddr_in&>(storage));
+  } else {
+    oAddr.emplace<Inet6Address>(reinterpret_cast<const sockaddr_in6&>(storage));
+  }
+  return true;
+}
+
+/**
+ * @brief Reads WIRE_ADDRESS_SIZE bytes from iWire
+ *
+ * @param iWire
+ * @param oAddr
+ *
+ * @return
+ */
+[[nodiscard]] bool decode_address(const std::uint8_t* iWire, InternetAddress& oAddr) {
+  sockaddr_storage storage;
+  socklen_t size = 0;
+  return to_sockaddr(iWire, storage, size) && oAddr.set_sockaddr(reinterpret_cast<const sockaddr*>(&storage), size);
+}
+
+/**
+ * @brief Appends iAddrs to oWire as a list
+ *
+ * @param iAddrs
+ * @param oWire
+ */
+void encode_addresses(const std::vector<inet_address_t>& iAddrs, std::vector<std::uint8_t>& oWire) {
+  std::uint8_t* record = append_header(iAddrs.size(), oWire);
+  for (const inet_address_t& addr : iAddrs) {
+    encode_address(addr, record);
+    record += WIRE_ADDRESS_SIZE;
+  }
+}
+
+/**
+ * @brief Appends iAddrs to oWire as a list
+ *
+ * @param iAddrs
+ * @param oWire
+ *
+ * @return
+ */
+[[nodiscard]] bool encode_addresses(const std::vector<InternetAddress>& iAddrs, std::vector<std::uint8_t>& oWire) {
+  const std::size_t start = oWire.size();
+  std::uint8_t* record = append_header(iAddrs.size(), oWire);
+  for (const InternetAddress& addr : iAddrs) {
+    if (!encode_address(addr, record)) {
+      oWire.resize(start);
+      return false;
+    }
+    record += WIRE_ADDRESS_SIZE;
+  }
+  return true;
+}
+
+/**
+ * @brief Reads a list from the iSize bytes at iWire
+ *
+ * @param iWire
+ * @param iSize
+ * @param oAddrs
+ *
+ * @return
+ */
+[[nodiscard]] std::size_t decode_addresses(const std::uint8_t* iWire, const std::size_t& iSize,
+                                           std::vector<inet_address_t>& oAddrs) {
+  return decode_list(iWire, iSize, oAddrs, [](const std::uint8_t* iRecord, inet_address_t& oAddr) {
+    return decode_address(iRecord, oAddr);
+  });
+}
+
+/**
+ * @brief Reads a list from the iSize bytes at iWire
+ *
+ * @param iWire
+ * @param iSize
+ * @param oAddrs
+ *
+ * @return
+ */
+[[nodiscard]] std::size_t decode_addresses(const std::uint8_t* iWire, const std::size_t& iSize,
+                                           std::vector<InternetAddress>& oAddrs) {
+  return decode_list(iWire, iSize, oAddrs, [](const std::uint8_t* iRecord, InternetAddress& oAddr) {
+    return decode_address(iRecord, oAddr);
+  });
+}
+
+
+} // namespace addr
+} // namespace ncs
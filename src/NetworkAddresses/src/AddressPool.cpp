@@ -0,0 +1,345 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file AddressPool.cpp
+ *
+ * @brief
+ */
+
+
+#include <AddressPool.h>
+
+#include <cstring>
+#include <mutex>
+
+#include <arpa/inet.h>
+
+
+namespace ncs { // Network Communications System
+namespace addr { // Network Communications System Addresses
+
+
+/**
+ * @brief
+ * 
+ * @param iOther
+ * 
+ * @return
+ */
+[[nodiscard]] bool pool_key_t::operator==(const pool_key_t& iOther) const {
+  return (this->family == iOther.family) && (std::memcmp(this->bytes, iOther.bytes, sizeof(this->bytes)) == 0);
+}
+
+/**
+ * @brief FNV-1a over the key bytes
+ * 
+ * @param iKey
+ * 
+ * @return
+ */
+[[nodiscard]] std::size_t pool_key_hash_t::operator()(const pool_key_t& iKey) const {
+  std::uint64_t hash = 14695981039346656037ull;
+  for (const std::uint8_t byte : iKey.bytes) {
+    hash = (hash ^ byte) * 1099511628211ull;
+  }
+  return static_cast<std::size_t>(hash ^ iKey.family);
+}
+
+
+/**
+ * @brief Slot a handle points to, whatever its generation
+ * 
+ * @param iHandle
+ * 
+ * @return
+ */
+static std::size_t slot_of(const address_handle_t& iHandle) {
+  return static_cast<std::size_t>(iHandle & 0xffffffffu);
+}
+
+
+/** PUBLIC METHODS **/
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+/**
+ * @brief Default constructor
+ */
+AddressPool::AddressPool(void) {}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Takes a reference to the entry of iIp, adding it if missing
+ * 
+ * @param iIp
+ * 
+ * @return
+ */
+[[nodiscard]] address_handle_t AddressPool::intern(const ip_t& iIp) {
+  pool_key_t key;
+  if (inet_pton(AF_INET, iIp.c_str(), key.bytes) == 1) {
+    key.family = AF_INET;
+  }
+  else if (inet_pton(AF_INET6, iIp.c_str(), key.bytes) == 1) {
+    key.family = AF_INET6;
+  }
+  else {
+    return INVALID_ADDRESS_HANDLE;
+  }
+  return this->intern(key);
+}
+
+/**
+ * @brief Takes a reference to the entry of the ip of a sockaddr_in or sockaddr_in6
+ * 
+ * @param iAddr
+ * @param iSize
+ * 
+ * @return
+ */
+[[nodiscard]] address_handle_t AddressPool::intern(const sockaddr* iAddr, const socklen_t& iSize) {
+  pool_key_t key;
+  if ((iAddr->sa_family == AF_INET) && (iSize >= sizeof(sockaddr_in))) {
+    std::memcpy(key.bytes, &reinterpret_cast<const sockaddr_in*>(iAddr)->sin_addr, sizeof(in_addr));
+  }
+  else if ((iAddr->sa_family == AF_INET6) && (iSize >= sizeof(sockaddr_in6))) {
+    std::memcpy(key.bytes, &reinterpret_cast<const sockaddr_in6*>(iAddr)->sin6_addr, sizeof(in6_addr));
+  }
+  else {
+    return INVALID_ADDRESS_HANDLE;
+  }
+  key.family = static_cast<std::uint8_t>(iAddr->sa_family);
+  return this->intern(key);
+}
+
+/**
+ * @brief Takes one more reference to a held entry
+ * 
+ * @param iHandle
+ * 
+ * @return
+ */
+[[nodiscard]] bool AddressPool::retain(const address_handle_t& iHandle) {
+  std::unique_lock<std::shared_mutex> lock(this->mutex_);
+  if (!this->is_live(iHandle)) {
+    return false;
+  }
+  ++this->entries_[slot_of(iHandle)].refs;
+  return true;
+}
+
+/**
+ * @brief Drops one reference, the entry is reclaimed with the last one
+ * 
+ * @param iHandle
+ * 
+ * @return
+ */
+bool AddressPool::release(const address_handle_t& iHandle) {
+  std::unique_lock<std::shared_mutex> lock(this->mutex_);
+  if (!this->is_live(iHandle)) {
+    return false;
+  }
+  pool_entry_t& entry = this->entries_[slot_of(iHandle)];
+  if (--entry.refs == 0) {
+    this->index_.erase(entry.key);
+    ++entry.generation;
+    this->free_.push_back(static_cast<std::uint32_t>(slot_of(iHandle)));
+  }
+  return true;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+/**
+ * @brief Text form of the ip of a live handle
+ * 
+ * @param iHandle
+ * @param oIp
+ * 
+ * @return
+ */
+[[nodiscard]] bool AddressPool::get_ip(const address_handle_t& iHandle, ip_t& oIp) const {
+  char text[INET6_ADDRSTRLEN];
+  std::shared_lock<std::shared_mutex> lock(this->mutex_);
+  if (!this->is_live(iHandle)) {
+    return false;
+  }
+  const pool_key_t& key = this->entries_[slot_of(iHandle)].key;
+  if (inet_ntop(key.family, key.bytes, text, sizeof(text)) == nullptr) {
+    return false;
+  }
+  oIp = text;
+  return true;
+}
+
+/**
+ * @brief
+ * 
+ * @param iHandle
+ * 
+ * @return
+ */
+[[nodiscard]] addr_family_e AddressPool::get_address_family(const address_handle_t& iHandle) const {
+  std::shared_lock<std::shared_mutex> lock(this->mutex_);
+  return this->is_live(iHandle) ? static_cast<addr_family_e>(this->entries_[slot_of(iHandle)].key.family) :
+                                  NET_ADDR_FAM_UNKNOWN;
+}
+
+/**
+ * @brief
+ * 
+ * @param iHandle
+ * 
+ * @return
+ */
+[[nodiscard]] std::uint32_t AddressPool::get_refs(const address_handle_t& iHandle) const {
+  std::shared_lock<std::shared_mutex> lock(this->mutex_);
+  return this->is_live(iHandle) ? this->entries_[slot_of(iHandle)].refs : 0;
+}
+
+/**
+ * @brief Live entries
+ * 
+ * @return
+ */
+[[nodiscard]] std::size_t AddressPool::get_size(void) const {
+  std::shared_lock<std::shared_mutex> lock(this->mutex_);
+  return this->index_.size();
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+/**
+ * @brief Full address of a pooled connection endpoint
+ * 
+ * @param iAddr
+ * @param oAddr
+ * 
+ * @return
+ */
+[[nodiscard]] bool AddressPool::to_address(const pooled_address_t& iAddr, InternetAddress& oAddr) const {
+  ip_t ip;
+  if (!this->get_ip(iAddr.ip, ip)) {
+    return false;
+  }
+  oAddr.set_ip(ip);
+  oAddr.set_port(iAddr.port);
+  return true;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+/**
+ * @brief Destructor
+ */
+AddressPool::~AddressPool() {}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PROTECTED METHODS **/
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PRIVATE METHODS **/
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Takes a reference to the entry of iKey, adding it if missing
+ * 
+ * @param iKey
+ * 
+ * @return
+ */
+[[nodiscard]] address_handle_t AddressPool::intern(const pool_key_t& iKey) {
+  std::unique_lock<std::shared_mutex> lock(this->mutex_);
+  const auto found = this->index_.find(iKey);
+  if (found != this->index_.end()) {
+    ++this->entries_[slot_of(found->second)].refs;
+    return found->second;
+  }
+  std::uint32_t slot = 0;
+  if (!this->free_.empty()) {
+    slot = this->free_.back();
+    this->free_.pop_back();
+  }
+  else if (this->entries_.size() < std::numeric_limits<std::uint32_t>::max()) {
+    slot = static_cast<std::uint32_t>(this->entries_.size());
+    this->entries_.emplace_back();
+  }
+  else {
+    return INVALID_ADDRESS_HANDLE;
+  }
+  this->entries_[slot].key = iKey;
+  this->entries_[slot].refs = 1;
+  const address_handle_t handle = this->make_handle(slot);
+  this->index_.emplace(iKey, handle);
+  return handle;
+}
+
+/**
+ * @brief Whether iHandle names a live entry, the caller holds the lock
+ * 
+ * @param iHandle
+ * 
+ * @return
+ */
+[[nodiscard]] bool AddressPool::is_live(const address_handle_t& iHandle) const {
+  const std::size_t slot = slot_of(iHandle);
+  return (slot < this->entries_.size()) && (this->entries_[slot].refs > 0) &&
+         (this->entries_[slot].generation == static_cast<std::uint32_t>(iHandle >> 32));
+}
+
+/**
+ * @brief Handle of a slot at its current generation
+ * 
+ * @param iSlot
+ * 
+ * @return
+ */
+[[nodiscard]] address_handle_t AddressPool::make_handle(const std::uint32_t& iSlot) const {
+  return (static_cast<address_handle_t>(this->entries_[iSlot].generation) << 32) | iSlot;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+} // namespace addr
+} // namespace ncs
@@ -0,0 +1,149 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file AddressSort.cpp
+ *
+ * @brief
+ */
+
+
+#include <AddressSort.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+
+namespace ncs { // Network Communications System
+namespace addr { // Network Communications System Addresses
+
+
+/**
+ * AddressSort constants
+ */
+constexpr std::size_t KEY_PORT_OFFSET = ADDRESS_KEY_SIZE - 2;
+
+/**
+ * @brief Sort key of an address and its position in the input
+ */
+struct keyed_address_t {
+  address_key_t key;
+  std::uint32_t index = 0;
+};
+
+
+/**
+ * @brief Keys of iAddresses in sort order, the ones of kind ADDRESS_KEY_OTHER last in input order
+ *
+ * @param iAddresses
+ *
+ * @return
+ */
+static std::vector<keyed_address_t> radix_sort(const std::vector<InternetAddress>& iAddresses) {
+  const std::size_t size = iAddresses.size();
+  std::vector<keyed_address_t> keyed(size);
+  // One histogram per key byte, all filled in a single pass over the keys
+  std::vector<std::size_t> counts(ADDRESS_KEY_SIZE * 256, 0);
+  for (std::size_t i = 0; i < size; ++i) {
+    keyed[i].key = iAddresses[i].get_key();
+    keyed[i].index = static_cast<std::uint32_t>(i);
+    for (std::size_t byte = 0; byte < ADDRESS_KEY_SIZE; ++byte) {
+      ++counts[byte * 256 + keyed[i].key.bytes[byte]];
+    }
+  }
+
+  std::vector<keyed_address_t> scratch(size);
+  for (std::size_t byte = ADDRESS_KEY_SIZE; byte-- > 0;) {
+    std::size_t* count = &counts[byte * 256];
+    // A byte shared by every key does not reorder anything
+    if (std::any_of(count, count + 256, [size](const std::size_t& iCount) { return iCount == size; })) {
+      continue;
+    }
+    std::size_t offset = 0;
+    for (std::size_t digit = 0; digit < 256; ++digit) {
+      const std::size_t next = offset + count[digit];
+      count[digit] = offset;
+      offset = next;
+    }
+    for (const keyed_address_t& entry : keyed) {
+      scratch[count[entry.key.bytes[byte]]++] = entry;
+    }
+    keyed.swap(scratch);
+  }
+  return keyed;
+}
+
+/**
+ * @brief Moves the addresses of ioAddresses into the order of iKeyed, sorting what the keys can not order
+ *
+ * The key zeroes the ports that do not fit in 16 bits. When some port does not, the addresses sharing their address
+ * bytes are sorted again by comparison, like the trailing unparsable ones
+ *
+ * @param iKeyed
+ * @param ioAddresses
+ *
+ * @return Position of the first unparsable address
+ */
+static std::size_t reorder(const std::vector<keyed_address_t>& iKeyed, std::vector<InternetAddress>& ioAddresses) {
+  std::vector<InternetAddress> sorted;
+  sorted.reserve(ioAddresses.size());
+  std::size_t others = iKeyed.size();
+  for (std::size_t i = 0; i < iKeyed.size(); ++i) {
+    if ((others == iKeyed.size()) && (iKeyed[i].key.bytes[0] == ADDRESS_KEY_OTHER)) {
+      others = i;
+    }
+    sorted.push_back(std::move(ioAddresses[iKeyed[i].index]));
+  }
+  const bool unfit = std::any_of(sorted.begin(), sorted.begin() + others, [](const InternetAddress& iAddr) {
+    return (iAddr.get_port() < 0) || (iAddr.get_port() > MAX_VALID_PORT);
+  });
+  for (std::size_t first = 0; unfit && (first < others);) {
+    std::size_t last = first + 1;
+    while ((last < others) && (std::memcmp(iKeyed[last].key.bytes, iKeyed[first].key.bytes, KEY_PORT_OFFSET) == 0)) {
+      ++last;
+    }
+    std::stable_sort(sorted.begin() + first, sorted.begin() + last);
+    first = last;
+  }
+  std::stable_sort(sorted.begin() + others, sorted.end());
+  ioAddresses.swap(sorted);
+  return others;
+}
+
+
+/**
+ * @brief Sorts iAddresses in the order of InternetAddress::compare(), stable
+ *
+ * @param ioAddresses
+ */
+void sort_addresses(std::vector<InternetAddress>& ioAddresses) {
+  (void)reorder(radix_sort(ioAddresses), ioAddresses);
+}
+
+/**
+ * @brief Sorts iAddresses and removes the repeated ones, keeping the first spelling of each address
+ *
+ * @param ioAddresses
+ *
+ * @return
+ */
+std::size_t unique_addresses(std::vector<InternetAddress>& ioAddresses) {
+  (void)reorder(radix_sort(ioAddresses), ioAddresses);
+  // Sorted like compare() orders them, equal addresses are next to each other whatever their kind
+  std::size_t kept = 0;
+  for (std::size_t i = 0; i < ioAddresses.size(); ++i) {
+    if ((kept == 0) || (ioAddresses[i] != ioAddresses[kept - 1])) {
+      ioAddresses[kept++] = std::move(ioAddresses[i]);
+    }
+  }
+  const std::size_t removed = ioAddresses.size() - kept;
+  ioAddresses.erase(ioAddresses.begin() + kept, ioAddresses.end());
+  return removed;
+}
+
+
+} // namespace addr
+} // namespace ncs
@@ -0,0 +1,44 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file FixedAddress.cpp
+ *
+ * @brief
+ */
+
+
+#include <FixedAddress.h>
+
+
+namespace ncs { // Network Communications System
+namespace addr { // Network Communications System Addresses
+
+
+/**
+ * @brief Binary form of iAddr, of the kind matching its family
+ *
+ * @param iAddr
+ * @param oAddr
+ *
+ * @return
+ */
+[[nodiscard]] bool to_inet_address(const InternetAddress& iAddr, inet_address_t& oAddr) {
+  Inet4Address addr4;
+  if (addr4.assign(iAddr)) {
+    oAddr = addr4;
+    return true;
+  }
+  Inet6Address addr6;
+  if (addr6.assign(iAddr)) {
+    oAddr = addr6;
+    return true;
+  }
+  return false;
+}
+
+
+} // namespace addr
+} // namespace ncs
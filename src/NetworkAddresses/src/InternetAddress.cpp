@@ -11,23 +11,120 @@
 
 
 #include <InternetAddress.h>
+#include <Tracer.h>
 
 #include <arpa/inet.h>
 
 #include <algorithm> 
-#include <regex>
+#include <cstring>
 
 
 namespace ncs { // Network Communications System
 namespace addr { // Network Communications System Addresses
 
 
+/**
+ * InternetAddress key offsets
+ */
+constexpr std::size_t KEY_IP_OFFSET = 1;
+constexpr std::size_t KEY_PORT_OFFSET = ADDRESS_KEY_SIZE - 2;
+constexpr std::uint8_t V4_MAPPED_PREFIX[12] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff};
+
+
+
+/**
+ * @brief FNV-1a over iKey, or over the ip text when it is neither IPv4 nor IPv6, and the port
+ * 
+ * @param iKey
+ * @param iAddr
+ * 
+ * @return
+ */
+static std::size_t hash_key(const address_key_t& iKey, const InternetAddress& iAddr) {
+  std::uint64_t hash = 14695981039346656037ull;
+  if (iKey.bytes[0] != ADDRESS_KEY_OTHER) {
+    for (const std::uint8_t byte : iKey.bytes) {
+      hash = (hash ^ byte) * 1099511628211ull;
+    }
+  }
+  else {
+    for (const char character : iAddr.get_ip()) {
+      hash = (hash ^ static_cast<std::uint8_t>(character)) * 1099511628211ull;
+    }
+  }
+  return static_cast<std::size_t>((hash ^ static_cast<std::uint32_t>(iAddr.get_port())) * 1099511628211ull);
+}
+
+/**
+ * @brief Key of an IPv4 mapped IPv6 address rewritten as the key of the IPv4 address it maps
+ * 
+ * @param iKey
+ * 
+ * @return
+ */
+[[nodiscard]] address_key_t fold_v4_mapped(const address_key_t& iKey) {
+  if ((iKey.bytes[0] != ADDRESS_KEY_INET6) ||
+      (std::memcmp(iKey.bytes + KEY_IP_OFFSET, V4_MAPPED_PREFIX, sizeof(V4_MAPPED_PREFIX)) != 0)) {
+    return iKey;
+  }
+  address_key_t folded = iKey;
+  folded.bytes[0] = ADDRESS_KEY_INET;
+  std::memcpy(folded.bytes + KEY_IP_OFFSET, iKey.bytes + KEY_IP_OFFSET + sizeof(V4_MAPPED_PREFIX), sizeof(in_addr));
+  std::memset(folded.bytes + KEY_IP_OFFSET + sizeof(in_addr), 0, sizeof(in6_addr) - sizeof(in_addr));
+  return folded;
+}
+
+/**
+ * @brief FNV-1a over the canonical key and the port
+ * 
+ * @param iAddr
+ * 
+ * @return
+ */
+[[nodiscard]] std::size_t internet_address_hash_t::operator()(const InternetAddress& iAddr) const {
+  return hash_key(iAddr.get_key(), iAddr);
+}
+
+/**
+ * @brief Hash of the folded key and the port
+ * 
+ * @param iAddr
+ * 
+ * @return
+ */
+[[nodiscard]] std::size_t folded_address_hash_t::operator()(const InternetAddress& iAddr) const {
+  return hash_key(fold_v4_mapped(iAddr.get_key()), iAddr);
+}
+
+/**
+ * @brief Equality of the folded keys, ips that are neither IPv4 nor IPv6 compare as text
+ * 
+ * @param iLeft
+ * @param iRight
+ * 
+ * @return
+ */
+[[nodiscard]] bool folded_address_equal_t::operator()(const InternetAddress& iLeft,
+                                                      const InternetAddress& iRight) const {
+  // The key zeroes ports that do not fit in 16 bits, the raw port is what the hash mixes in
+  if (iLeft.get_port() != iRight.get_port()) {
+    return false;
+  }
+  if (iLeft.get_key().bytes[0] == ADDRESS_KEY_OTHER) {
+    return iLeft == iRight;
+  }
+  const address_key_t left = fold_v4_mapped(iLeft.get_key());
+  const address_key_t right = fold_v4_mapped(iRight.get_key());
+  return std::memcmp(left.bytes, right.bytes, ADDRESS_KEY_SIZE) == 0;
+}
+
+
 /** PUBLIC METHODS */
 /// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
 /**
  * @brief Default constructor
  */
-InternetAddress::InternetAddress(void) {
+InternetAddress::InternetAddress(void) : port_(-1), family_(NET_ADDR_FAM_UNKNOWN) {
   this->set_ip(LOCAL_HOST);
   this->set_port(-1);
 }
@@ -38,7 +135,7 @@ InternetAddress::InternetAddress(void) {
  * @param iPort 
  * @param iIp_
  */
-InternetAddress::InternetAddress(const ip_t& iIp, const port_t& iPort) {
+InternetAddress::InternetAddress(const ip_t& iIp, const port_t& iPort) : port_(-1), family_(NET_ADDR_FAM_UNKNOWN) {
   this->set_ip(iIp);
   this->set_port(iPort);
 }
@@ -48,19 +145,16 @@ InternetAddress::InternetAddress(const ip_t& iIp, const port_t& iPort) {
  * 
  * @param iOther 
  */
-InternetAddress::InternetAddress(const InternetAddress& iOther) {
-  this->set_ip(iOther.get_ip());
-  this->set_port(iOther.get_port());
-}
+InternetAddress::InternetAddress(const InternetAddress& iOther)
+    : ip_(iOther.ip_), port_(iOther.port_), family_(iOther.family_), key_(iOther.key_) {}
 
 /**
  * @brief Move constructor
  * 
  * @param iOther 
  */
-InternetAddress::InternetAddress(InternetAddress&& iOther) noexcept {
-  this->set_ip(std::move(iOther.get_ip()));
-  this->set_port(iOther.get_port());
+InternetAddress::InternetAddress(InternetAddress&& iOther) noexcept
+    : ip_(std::move(iOther.ip_)), port_(iOther.port_), family_(iOther.family_), key_(iOther.key_) {
   iOther.clear();
 }
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -103,6 +197,44 @@ InternetAddress::InternetAddress(InternetAddress&& iOther) noexcept {
   return (this->get_port() >= MIN_VALID_PORT) && (this->get_port() <= MAX_VALID_PORT);
 }
 
+/**
+ * @brief Whether the ip is an IPv4 or IPv6 multicast group
+ * 
+ * @return
+ */
+[[nodiscard]] bool InternetAddress::is_multicast(void) const {
+  if (this->family_ == NET_ADDR_FAM_INET) {
+    std::uint32_t addr4 = 0;
+    std::memcpy(&addr4, this->key_.bytes + KEY_IP_OFFSET, sizeof(addr4));
+    return IN_MULTICAST(ntohl(addr4));
+  }
+  return (this->key_.bytes[0] == ADDRESS_KEY_INET6) && (this->key_.bytes[KEY_IP_OFFSET] == 0xff);
+}
+
+/**
+ * @brief Three way comparison in numeric order
+ * 
+ * @param iOther
+ * 
+ * @return
+ */
+[[nodiscard]] int InternetAddress::compare(const InternetAddress& iOther) const {
+  // Kind and address bytes of the key, then the raw port, the key zeroes the ports that do not fit in 16 bits
+  if ((this->key_.bytes[0] != ADDRESS_KEY_OTHER) || (iOther.key_.bytes[0] != ADDRESS_KEY_OTHER)) {
+    const int byAddress = std::memcmp(this->key_.bytes, iOther.key_.bytes, KEY_PORT_OFFSET);
+    if (byAddress != 0) {
+      return byAddress;
+    }
+  }
+  else {
+    const int byIp = this->get_ip().compare(iOther.get_ip());
+    if (byIp != 0) {
+      return byIp;
+    }
+  }
+  return (this->get_port() < iOther.get_port()) ? -1 : (this->get_port() > iOther.get_port()) ? 1 : 0;
+}
+
 /**
  * @brief
  */
@@ -120,6 +252,16 @@ void InternetAddress::clear(void) {
  */
 void InternetAddress::set_ip(const ip_t& iIp) {
   this->ip_ = iIp;
+  std::uint8_t binary[sizeof(in6_addr)];
+  if (inet_pton(AF_INET, iIp.c_str(), binary) == 1) {
+    this->set_binary(NET_ADDR_FAM_INET, binary);
+  }
+  else if (inet_pton(AF_INET6, iIp.c_str(), binary) == 1) {
+    this->set_binary(NET_ADDR_FAM_INET6, binary);
+  }
+  else {
+    this->set_binary(NET_ADDR_FAM_UNKNOWN, nullptr);
+  }
 }
 
 /**
@@ -129,6 +271,41 @@ void InternetAddress::set_ip(const ip_t& iIp) {
  */
 void InternetAddress::set_port(const port_t& iPort) {
   this->port_ = iPort;
+  const bool fits = (iPort >= 0) && (iPort <= MAX_VALID_PORT);
+  this->key_.bytes[KEY_PORT_OFFSET] = fits ? static_cast<std::uint8_t>(iPort >> 8) : 0;
+  this->key_.bytes[KEY_PORT_OFFSET + 1] = fits ? static_cast<std::uint8_t>(iPort & 0xff) : 0;
+}
+
+/**
+ * @brief Sets the ip and port from a sockaddr_in or sockaddr_in6
+ * 
+ * @param iAddr
+ * @param iSize
+ * 
+ * @return
+ */
+[[nodiscard]] bool InternetAddress::set_sockaddr(const sockaddr* iAddr, const socklen_t& iSize) {
+  char text[INET6_ADDRSTRLEN];
+  if ((iAddr->sa_family == AF_INET) && (iSize >= sizeof(sockaddr_in))) {
+    const sockaddr_in* addr4 = reinterpret_cast<const sockaddr_in*>(iAddr);
+    inet_ntop(AF_INET, &addr4->sin_addr, text, sizeof(text));
+    this->ip_ = text;
+    this->set_binary(NET_ADDR_FAM_INET, &addr4->sin_addr);
+    this->set_port(ntohs(addr4->sin_port));
+    NCS_TRACE(ADDRESS_PARSE, this, -1, iSize, 1);
+    return true;
+  }
+  if ((iAddr->sa_family == AF_INET6) && (iSize >= sizeof(sockaddr_in6))) {
+    const sockaddr_in6* addr6 = reinterpret_cast<const sockaddr_in6*>(iAddr);
+    inet_ntop(AF_INET6, &addr6->sin6_addr, text, sizeof(text));
+    this->ip_ = text;
+    this->set_binary(NET_ADDR_FAM_INET6, &addr6->sin6_addr);
+    this->set_port(ntohs(addr6->sin6_port));
+    NCS_TRACE(ADDRESS_PARSE, this, -1, iSize, 1);
+    return true;
+  }
+  NCS_TRACE(ADDRESS_PARSE, this, -1, iSize, 0);
+  return false;
 }
 
 
@@ -156,13 +333,16 @@ void InternetAddress::set_port(const port_t& iPort) {
  * @return
  */
 [[nodiscard]] addr_family_e InternetAddress::get_address_family(void) const {
-  if (this->has_valid_v4_ip()) {
-    return NET_ADDR_FAM_INET;
-  }
-  if (this->has_valid_v6_ip()) {
-    return NET_ADDR_FAM_INET6;
-  }
-  return NET_ADDR_FAM_UNKNOWN;
+  return this->family_;
+}
+
+/**
+ * @brief Canonical binary form of the address
+ * 
+ * @return
+ */
+[[nodiscard]] const address_key_t& InternetAddress::get_key(void) const {
+  return this->key_;
 }
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -189,6 +369,55 @@ void InternetAddress::set_port(const port_t& iPort) {
                                    : "Invalid_Port(" + std::to_string(this->get_port()) + ")";
   return result;
 }
+
+/**
+ * @brief Fills a sockaddr_in or sockaddr_in6 with the address
+ * 
+ * @param oAddr
+ * @param oSize
+ * 
+ * @return
+ */
+[[nodiscard]] bool InternetAddress::to_sockaddr(sockaddr_storage& oAddr, socklen_t& oSize) const {
+  if ((this->get_port() < 0) || (this->get_port() > MAX_VALID_PORT) || (this->family_ == NET_ADDR_FAM_UNKNOWN)) {
+    NCS_TRACE(ADDRESS_PARSE, this, -1, this->get_ip().size(), 0);
+    return false;
+  }
+  std::memset(&oAddr, 0, sizeof(oAddr));
+  if (this->family_ == NET_ADDR_FAM_INET) {
+    sockaddr_in* addr4 = reinterpret_cast<sockaddr_in*>(&oAddr);
+    addr4->sin_family = AF_INET;
+    std::memcpy(&addr4->sin_addr, this->key_.bytes + KEY_IP_OFFSET, sizeof(addr4->sin_addr));
+    addr4->sin_port = htons(static_cast<std::uint16_t>(this->get_port()));
+    oSize = sizeof(sockaddr_in);
+  }
+  else {
+    sockaddr_in6* addr6 = reinterpret_cast<sockaddr_in6*>(&oAddr);
+    addr6->sin6_family = AF_INET6;
+    std::memcpy(&addr6->sin6_addr, this->key_.bytes + KEY_IP_OFFSET, sizeof(addr6->sin6_addr));
+    addr6->sin6_port = htons(static_cast<std::uint16_t>(this->get_port()));
+    oSize = sizeof(sockaddr_in6);
+  }
+  NCS_TRACE(ADDRESS_PARSE, this, -1, this->get_ip().size(), 1);
+  return true;
+}
+
+/**
+ * @brief Fills the sort key of the address
+ * 
+ * @param oKey
+ * 
+ * @return
+ */
+bool InternetAddress::to_key(address_key_t& oKey) const {
+  if ((this->key_.bytes[0] != ADDRESS_KEY_OTHER) && (this->get_port() >= 0) && (this->get_port() <= MAX_VALID_PORT)) {
+    oKey = this->key_;
+    return true;
+  }
+  std::memset(oKey.bytes, 0, ADDRESS_KEY_SIZE);
+  oKey.bytes[0] = ADDRESS_KEY_OTHER;
+  return false;
+}
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
@@ -201,8 +430,10 @@ void InternetAddress::set_port(const port_t& iPort) {
  */
 InternetAddress& InternetAddress::operator=(const InternetAddress& iOther) {
   if (this != &iOther) {
-    this->set_ip(iOther.get_ip());
-    this->set_port(iOther.get_port());
+    this->ip_ = iOther.ip_;
+    this->port_ = iOther.port_;
+    this->family_ = iOther.family_;
+    this->key_ = iOther.key_;
   }
   return *this;
 }
@@ -216,8 +447,10 @@ InternetAddress& InternetAddress::operator=(const InternetAddress& iOther) {
  */
 InternetAddress& InternetAddress::operator=(InternetAddress&& iOther) noexcept {
   if (this != &iOther) {
-    this->set_ip(std::move(iOther.get_ip()));
-    this->set_port(iOther.get_port());
+    this->ip_ = std::move(iOther.ip_);
+    this->port_ = iOther.port_;
+    this->family_ = iOther.family_;
+    this->key_ = iOther.key_;
     iOther.clear();
   }
   return *this;
@@ -232,7 +465,13 @@ InternetAddress& InternetAddress::operator=(InternetAddress&& iOther) noexcept {
  */
 [[nodiscard]] bool InternetAddress::operator==(const InternetAddress& iOther) const {
   if (this == &iOther) {return true;}
-  return (this->get_ip() == iOther.get_ip()) && (this->get_port() == iOther.get_port());
+  if (this->get_port() != iOther.get_port()) {
+    return false;
+  }
+  if (this->key_.bytes[0] != ADDRESS_KEY_OTHER) {
+    return std::memcmp(this->key_.bytes, iOther.key_.bytes, ADDRESS_KEY_SIZE) == 0;
+  }
+  return (iOther.key_.bytes[0] == ADDRESS_KEY_OTHER) && (this->get_ip() == iOther.get_ip());
 }
 
 /**
@@ -243,8 +482,51 @@ InternetAddress& InternetAddress::operator=(InternetAddress&& iOther) noexcept {
  * @return
  */
 [[nodiscard]] bool InternetAddress::operator!=(const InternetAddress& iOther) const {
-  if (this == &iOther) {return false;}
-  return (this->get_ip() != iOther.get_ip()) || (this->get_port() != iOther.get_port());
+  return !(*this == iOther);
+}
+
+/**
+ * @brief
+ * 
+ * @param iOther
+ * 
+ * @return
+ */
+[[nodiscard]] bool InternetAddress::operator<(const InternetAddress& iOther) const {
+  return this->compare(iOther) < 0;
+}
+
+/**
+ * @brief
+ * 
+ * @param iOther
+ * 
+ * @return
+ */
+[[nodiscard]] bool InternetAddress::operator<=(const InternetAddress& iOther) const {
+  return this->compare(iOther) <= 0;
+}
+
+/**
+ * @brief
+ * 
+ * @param iOther
+ * 
+ * @return
+ */
+[[nodiscard]] bool InternetAddress::operator>(const InternetAddress& iOther) const {
+  return this->compare(iOther) > 0;
+}
+
+/**
+ * @brief
+ * 
+ * @param iOther
+ * 
+ * @return
+ */
+[[nodiscard]] bool InternetAddress::operator>=(const InternetAddress& iOther) const {
+  return this->compare(iOther) >= 0;
 }
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -302,18 +584,7 @@ InternetAddress::~InternetAddress() {}
  * @return
  */
 [[nodiscard]] bool InternetAddress::has_valid_v4_ip(void) const {
-  const std::regex IPV4_PATTERN(
-      "^"                     // Start of string
-      "(25[0-5]|2[0-4][0-9]|1[0-9]{2}|[1-9]?[0-9])"  // 1st octet
-      "\\."                   // Dot separator
-      "(25[0-5]|2[0-4][0-9]|1[0-9]{2}|[1-9]?[0-9])"  // 2nd octet
-      "\\."                   // Dot separator
-      "(25[0-5]|2[0-4][0-9]|1[0-9]{2}|[1-9]?[0-9])"  // 3rd octet
-      "\\."                   // Dot separator
-      "(25[0-5]|2[0-4][0-9]|1[0-9]{2}|[1-9]?[0-9])"  // 4th octet
-      "$"                     // End of string
-  );
-  return std::regex_match(this->get_ip(), IPV4_PATTERN);
+  return this->family_ == NET_ADDR_FAM_INET;
 }
 
 
@@ -323,30 +594,30 @@ InternetAddress::~InternetAddress() {}
  * @return
  */
 [[nodiscard]] bool InternetAddress::has_valid_v6_ip(void) const {
-  const std::regex IPV6_PATTERN(
-      "^((" // Start of pattern
-      "([0-9A-Fa-f]{1,4}:){7}([0-9A-Fa-f]{1,4})" // Uncompressed
-
-      // Compressed with various positions for ::
-      "|(([0-9A-Fa-f]{1,4}:){1,7}:)"                    
-      "|(:([0-9A-Fa-f]{1,4}:){1,7})"
-      "|(([0-9A-Fa-f]{1,4}:){1,6}:([0-9A-Fa-f]{1,4}))" // Improved pattern for middle compression
-      "|(::([0-9A-Fa-f]{1,4}:){1,5})"
-      "|(:{2}([0-9A-Fa-f]{1,4}:){1,4})"
-      "|(:{2}([0-9A-Fa-f]{1,4}:){1,3})"
-      "|(:{2}([0-9A-Fa-f]{1,4}:){1,2})"
-      "|(:{2}([0-9A-Fa-f]{1,4}:){1})"
-      "|(:{2}([0-9A-Fa-f]{1,4}){1})"
-      "|(:{2})"
-
-      // Loopback, unspecified addresses
-      "|(::1)"
-      "|(::)"
-      "|([0:0:0:0:0:0:0:1])" // Full loopback address
-
-      ")$)"
-  );
-  return std::regex_match(this->get_ip(), IPV6_PATTERN);
+  return this->family_ == NET_ADDR_FAM_INET6;
+}
+
+/**
+ * @brief Sets the family and the address bytes of the key from the binary ip iBytes
+ * 
+ * @param iFamily
+ * @param iBytes
+ */
+void InternetAddress::set_binary(const addr_family_e& iFamily, const void* iBytes) {
+  this->family_ = iFamily;
+  std::memset(this->key_.bytes, 0, KEY_PORT_OFFSET);
+  const std::uint8_t* bytes = static_cast<const std::uint8_t*>(iBytes);
+  if (iFamily == NET_ADDR_FAM_INET) {
+    this->key_.bytes[0] = ADDRESS_KEY_INET;
+    std::memcpy(this->key_.bytes + KEY_IP_OFFSET, bytes, sizeof(in_addr));
+  }
+  else if (iFamily == NET_ADDR_FAM_INET6) {
+    this->key_.bytes[0] = ADDRESS_KEY_INET6;
+    std::memcpy(this->key_.bytes + KEY_IP_OFFSET, bytes, sizeof(in6_addr));
+  }
+  else {
+    this->key_.bytes[0] = ADDRESS_KEY_OTHER;
+  }
 }
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -0,0 +1,686 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file PeerTable.cpp
+ *
+ * @brief
+ */
+
+
+#include <PeerTable.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace ncs { // Network Communications System
+namespace addr { // Network Communications System Addresses
+
+
+/**
+ * PeerTable constants
+ */
+constexpr const char* PEER_TABLE_TEMPORARY_SUFFIX = ".tmp";   // New tables are written here, then renamed
+
+static_assert(sizeof(peer_record_t) == 40, "peer records are part of the file format and must not have padding");
+static_assert(sizeof(peer_table_header_t) == 64, "the table header is part of the file format");
+
+
+/**
+ * @brief Index entries a table of iCapacity records needs, a power of two at least twice iCapacity
+ * 
+ * @param iCapacity
+ * 
+ * @return
+ */
+static std::size_t index_slots_for(const std::size_t& iCapacity) {
+  std::size_t slots = 16;
+  while (slots < 2 * iCapacity) {
+    slots <<= 1;
+  }
+  return slots;
+}
+
+/**
+ * @brief Bytes of the file of a table
+ * 
+ * @param iCapacity
+ * @param iSlots
+ * 
+ * @return
+ */
+static std::size_t table_size(const std::size_t& iCapacity, const std::size_t& iSlots) {
+  return sizeof(peer_table_header_t) + iSlots * sizeof(std::uint32_t) + iCapacity * sizeof(peer_record_t);
+}
+
+/**
+ * @brief FNV-1a over the record bytes before the checksum
+ * 
+ * @param iRecord
+ * 
+ * @return
+ */
+static std::uint32_t checksum_of(const peer_record_t& iRecord) {
+  const std::uint8_t* bytes = reinterpret_cast<const std::uint8_t*>(&iRecord);
+  std::uint32_t hash = 2166136261u;
+  for (std::size_t i = 0; i < offsetof(peer_record_t, checksum); ++i) {
+    hash = (hash ^ bytes[i]) * 16777619u;
+  }
+  return hash;
+}
+
+/**
+ * @brief FNV-1a over the WIRE_ADDRESS_SIZE bytes at iWire
+ * 
+ * @param iWire
+ * 
+ * @return
+ */
+static std::uint64_t hash_of(const std::uint8_t* iWire) {
+  std::uint64_t hash = 14695981039346656037ull;
+  for (std::size_t i = 0; i < WIRE_ADDRESS_SIZE; ++i) {
+    hash = (hash ^ iWire[i]) * 1099511628211ull;
+  }
+  return hash;
+}
+
+
+/** PUBLIC METHODS **/
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+/**
+ * @brief Default constructor
+ */
+PeerTable::PeerTable()
+    : fd_(-1), map_(nullptr), mapSize_(0), minCapacity_(0), header_(nullptr), index_(nullptr), records_(nullptr) {}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Maps the table at iPath, creating an empty one if there is none
+ * 
+ * @param iPath
+ * @param iCapacity
+ * 
+ * @return
+ */
+[[nodiscard]] bool PeerTable::open(const std::string& iPath, const std::size_t& iCapacity) {
+  this->close();
+  const std::size_t capacity = std::min(std::max<std::size_t>(iCapacity, 1), MAX_PEER_TABLE_CAPACITY);
+  const int fd = ::open(iPath.c_str(), O_RDWR | O_CLOEXEC);
+  if (fd < 0) {
+    if ((errno != ENOENT) || !this->create(iPath + PEER_TABLE_TEMPORARY_SUFFIX, capacity)) {
+      return false;
+    }
+    if (!this->publish(iPath)) {
+      const int error = errno;
+      unlink(this->path_.c_str());
+      this->close();
+      errno = error;
+      return false;
+    }
+    return true;
+  }
+  struct stat status;
+  if (fstat(fd, &status) != 0) {
+    const int error = errno;
+    ::close(fd);
+    errno = error;
+    return false;
+  }
+  if (static_cast<std::size_t>(status.st_size) < sizeof(peer_table_header_t)) {
+    ::close(fd);
+    errno = EINVAL;
+    return false;
+  }
+  const std::size_t size = static_cast<std::size_t>(status.st_size);
+  void* map = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (map == MAP_FAILED) {
+    const int error = errno;
+    ::close(fd);
+    errno = error;
+    return false;
+  }
+  this->path_ = iPath;
+  this->fd_ = fd;
+  this->map_ = static_cast<std::uint8_t*>(map);
+  this->mapSize_ = size;
+  this->header_ = reinterpret_cast<peer_table_header_t*>(this->map_);
+  const peer_table_header_t& header = *this->header_;
+  if ((std::memcmp(header.magic, PEER_TABLE_MAGIC, sizeof(PEER_TABLE_MAGIC)) != 0) ||
+      (header.version != PEER_TABLE_VERSION) || (header.record_size != sizeof(peer_record_t)) ||
+      (header.capacity == 0) || (header.capacity > MAX_PEER_TABLE_CAPACITY) ||
+      (header.index_slots != index_slots_for(header.capacity)) ||
+      (size != table_size(header.capacity, header.index_slots)) || (header.committed > header.capacity) ||
+      (header.indexed > header.committed)) {
+    this->close();
+    errno = EINVAL;
+    return false;
+  }
+  this->index_ = reinterpret_cast<std::uint32_t*>(this->map_ + sizeof(peer_table_header_t));
+  this->records_ = reinterpret_cast<peer_record_t*>(this->index_ + header.index_slots);
+  this->minCapacity_ = capacity;
+  this->recover();
+  return true;
+}
+
+/**
+ * @brief Unmaps the table
+ */
+void PeerTable::close(void) {
+  if (this->map_ != nullptr) {
+    munmap(this->map_, this->mapSize_);
+  }
+  if (this->fd_ >= 0) {
+    ::close(this->fd_);
+  }
+  this->path_.clear();
+  this->fd_ = -1;
+  this->map_ = nullptr;
+  this->mapSize_ = 0;
+  this->minCapacity_ = 0;
+  this->header_ = nullptr;
+  this->index_ = nullptr;
+  this->records_ = nullptr;
+}
+
+/**
+ * @brief Records iInfo as the metadata of iAddr
+ * 
+ * @param iAddr
+ * @param iInfo
+ * 
+ * @return
+ */
+[[nodiscard]] bool PeerTable::put(const InternetAddress& iAddr, const peer_info_t& iInfo) {
+  peer_record_t record;
+  if (!encode_address(iAddr, record.address)) {
+    errno = EINVAL;
+    return false;
+  }
+  record.state = PEER_LIVE;
+  record.rtt_us = iInfo.rtt_us;
+  record.last_seen = iInfo.last_seen;
+  record.failures = iInfo.failures;
+  return this->append(record);
+}
+
+/**
+ * @brief Records iInfo as the metadata of iAddr
+ * 
+ * @param iAddr
+ * @param iInfo
+ * 
+ * @return
+ */
+[[nodiscard]] bool PeerTable::put(const inet_address_t& iAddr, const peer_info_t& iInfo) {
+  peer_record_t record;
+  encode_address(iAddr, record.address);
+  record.state = PEER_LIVE;
+  record.rtt_us = iInfo.rtt_us;
+  record.last_seen = iInfo.last_seen;
+  record.failures = iInfo.failures;
+  return this->append(record);
+}
+
+/**
+ * @brief Removes iAddr from the table
+ * 
+ * @param iAddr
+ * 
+ * @return
+ */
+[[nodiscard]] bool PeerTable::remove(const InternetAddress& iAddr) {
+  std::uint8_t wire[WIRE_ADDRESS_SIZE];
+  if (!encode_address(iAddr, wire)) {
+    errno = ENOENT;
+    return false;
+  }
+  return this->remove(wire);
+}
+
+/**
+ * @brief Removes iAddr from the table
+ * 
+ * @param iAddr
+ * 
+ * @return
+ */
+[[nodiscard]] bool PeerTable::remove(const inet_address_t& iAddr) {
+  std::uint8_t wire[WIRE_ADDRESS_SIZE];
+  encode_address(iAddr, wire);
+  return this->remove(wire);
+}
+
+/**
+ * @brief Current record of iAddr
+ * 
+ * @param iAddr
+ * 
+ * @return
+ */
+[[nodiscard]] const peer_record_t* PeerTable::find(const InternetAddress& iAddr) const {
+  std::uint8_t wire[WIRE_ADDRESS_SIZE];
+  return encode_address(iAddr, wire) ? this->find(wire) : nullptr;
+}
+
+/**
+ * @brief Current record of iAddr
+ * 
+ * @param iAddr
+ * 
+ * @return
+ */
+[[nodiscard]] const peer_record_t* PeerTable::find(const inet_address_t& iAddr) const {
+  std::uint8_t wire[WIRE_ADDRESS_SIZE];
+  encode_address(iAddr, wire);
+  return this->find(wire);
+}
+
+/**
+ * @brief Calls iVisit with the current record of every peer
+ * 
+ * @param iVisit
+ */
+void PeerTable::for_each(const std::function<void(const peer_record_t&)>& iVisit) const {
+  if (this->map_ == nullptr) {
+    return;
+  }
+  for (std::size_t slot = 0; slot < this->header_->index_slots; ++slot) {
+    const peer_record_t* record = this->record_of(this->index_[slot]);
+    if ((record != nullptr) && (record->state == PEER_LIVE)) {
+      iVisit(*record);
+    }
+  }
+}
+
+/**
+ * @brief Rewrites the table with the current record of each peer only
+ * 
+ * @return
+ */
+[[nodiscard]] bool PeerTable::compact(void) {
+  if (this->map_ == nullptr) {
+    errno = EBADF;
+    return false;
+  }
+  const std::size_t capacity = std::min(std::max<std::size_t>(this->minCapacity_, 2 * this->header_->live),
+                                        MAX_PEER_TABLE_CAPACITY);
+  const std::string temporary = this->path_ + PEER_TABLE_TEMPORARY_SUFFIX;
+  PeerTable compacted;
+  bool done = compacted.create(temporary, capacity);
+  for (std::size_t slot = 0; done && (slot < this->header_->index_slots); ++slot) {
+    const peer_record_t* current = this->record_of(this->index_[slot]);
+    if ((current != nullptr) && (current->state == PEER_LIVE)) {
+      peer_record_t record = *current;
+      done = compacted.append(record);
+    }
+  }
+  if (!done || !compacted.publish(this->path_)) {
+    const int error = errno;
+    compacted.close();
+    unlink(temporary.c_str());
+    errno = error;
+    return false;
+  }
+  compacted.minCapacity_ = this->minCapacity_;
+  this->take(compacted);
+  return true;
+}
+
+/**
+ * @brief Writes the mapping back to the disk and waits for it
+ * 
+ * @return
+ */
+[[nodiscard]] bool PeerTable::sync(void) const {
+  if (this->map_ == nullptr) {
+    errno = EBADF;
+    return false;
+  }
+  return msync(this->map_, this->mapSize_, MS_SYNC) == 0;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] bool PeerTable::is_open(void) const {
+  return this->map_ != nullptr;
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] const std::string& PeerTable::get_path(void) const {
+  return this->path_;
+}
+
+/**
+ * @brief Peers in the table
+ * 
+ * @return
+ */
+[[nodiscard]] std::size_t PeerTable::get_size(void) const {
+  return (this->map_ != nullptr) ? this->header_->live : 0;
+}
+
+/**
+ * @brief Records the table has room for
+ * 
+ * @return
+ */
+[[nodiscard]] std::size_t PeerTable::get_capacity(void) const {
+  return (this->map_ != nullptr) ? this->header_->capacity : 0;
+}
+
+/**
+ * @brief Records appended since the last compaction
+ * 
+ * @return
+ */
+[[nodiscard]] std::size_t PeerTable::get_committed(void) const {
+  return (this->map_ != nullptr) ? this->header_->committed : 0;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+/**
+ * @brief Destructor
+ */
+PeerTable::~PeerTable() {
+  this->close();
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PROTECTED METHODS **/
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PRIVATE METHODS **/
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Creates and maps an empty table at iPath
+ * 
+ * @param iPath
+ * @param iCapacity
+ * 
+ * @return
+ */
+[[nodiscard]] bool PeerTable::create(const std::string& iPath, const std::size_t& iCapacity) {
+  this->close();
+  const std::size_t slots = index_slots_for(iCapacity);
+  const std::size_t size = table_size(iCapacity, slots);
+  const int fd = ::open(iPath.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd < 0) {
+    return false;
+  }
+  // The file starts sparse and zeroed, an empty index and no records
+  void* map = (ftruncate(fd, static_cast<off_t>(size)) == 0)
+                  ? mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+  if (map == MAP_FAILED) {
+    const int error = errno;
+    ::close(fd);
+    unlink(iPath.c_str());
+    errno = error;
+    return false;
+  }
+  this->path_ = iPath;
+  this->fd_ = fd;
+  this->map_ = static_cast<std::uint8_t*>(map);
+  this->mapSize_ = size;
+  this->minCapacity_ = iCapacity;
+  this->header_ = reinterpret_cast<peer_table_header_t*>(this->map_);
+  this->index_ = reinterpret_cast<std::uint32_t*>(this->map_ + sizeof(peer_table_header_t));
+  this->records_ = reinterpret_cast<peer_record_t*>(this->index_ + slots);
+  std::memcpy(this->header_->magic, PEER_TABLE_MAGIC, sizeof(PEER_TABLE_MAGIC));
+  this->header_->version = PEER_TABLE_VERSION;
+  this->header_->record_size = sizeof(peer_record_t);
+  this->header_->capacity = iCapacity;
+  this->header_->index_slots = slots;
+  return true;
+}
+
+/**
+ * @brief Syncs the table and renames it to iPath
+ * 
+ * @param iPath
+ * 
+ * @return
+ */
+[[nodiscard]] bool PeerTable::publish(const std::string& iPath) {
+  if ((msync(this->map_, this->mapSize_, MS_SYNC) != 0) || (fsync(this->fd_) != 0) ||
+      (rename(this->path_.c_str(), iPath.c_str()) != 0)) {
+    return false;
+  }
+  this->path_ = iPath;
+  // The rename is durable once the directory holding both names is
+  const std::size_t slash = iPath.find_last_of('/');
+  const std::string directory = (slash == std::string::npos) ? "." : iPath.substr(0, std::max<std::size_t>(slash, 1));
+  const int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (fd >= 0) {
+    (void)fsync(fd);
+    ::close(fd);
+  }
+  return true;
+}
+
+/**
+ * @brief Takes over the mapping of ioOther
+ * 
+ * @param ioOther
+ */
+void PeerTable::take(PeerTable& ioOther) {
+  this->close();
+  this->path_ = std::move(ioOther.path_);
+  this->fd_ = ioOther.fd_;
+  this->map_ = ioOther.map_;
+  this->mapSize_ = ioOther.mapSize_;
+  this->minCapacity_ = ioOther.minCapacity_;
+  this->header_ = ioOther.header_;
+  this->index_ = ioOther.index_;
+  this->records_ = ioOther.records_;
+  ioOther.fd_ = -1;
+  ioOther.map_ = nullptr;
+  ioOther.close();
+}
+
+/**
+ * @brief Indexes the records counted but not indexed when the table was last written, dropping stale entries
+ */
+void PeerTable::recover(void) {
+  peer_table_header_t& header = *this->header_;
+  // Index pages may reach the disk without the header, entries past committed point at puts that never happened
+  std::uint32_t* end = this->index_ + header.index_slots;
+  if (std::any_of(this->index_, end, [&header](const std::uint32_t& iEntry) { return iEntry > header.committed; })) {
+    std::fill(this->index_, end, 0u);
+    header.indexed = 0;
+  }
+  if (header.indexed == header.committed) {
+    return;
+  }
+  for (; header.indexed < header.committed; ++header.indexed) {
+    const peer_record_t& record = this->records_[header.indexed];
+    if ((record.checksum != checksum_of(record)) ||
+        ((record.state != PEER_LIVE) && (record.state != PEER_REMOVED))) {
+      header.committed = header.indexed;
+      break;
+    }
+    this->index(header.indexed);
+  }
+  // The put cut short may or may not have counted its peer, the index tells
+  header.live = 0;
+  for (std::size_t slot = 0; slot < header.index_slots; ++slot) {
+    const peer_record_t* record = this->record_of(this->index_[slot]);
+    header.live += ((record != nullptr) && (record->state == PEER_LIVE)) ? 1 : 0;
+  }
+}
+
+/**
+ * @brief Appends iRecord, counts it, then points the index at it
+ * 
+ * @param iRecord
+ * 
+ * @return
+ */
+[[nodiscard]] bool PeerTable::append(peer_record_t& iRecord) {
+  if (this->map_ == nullptr) {
+    errno = EBADF;
+    return false;
+  }
+  if ((this->header_->committed == this->header_->capacity) && !this->compact()) {
+    return false;
+  }
+  iRecord.checksum = checksum_of(iRecord);
+  const std::uint64_t number = this->header_->committed;
+  this->records_[number] = iRecord;
+  // Stores to the mapping must reach it in this order for a crash at any point to leave a table open() can recover
+  std::atomic_thread_fence(std::memory_order_release);
+  this->header_->committed = number + 1;
+  std::atomic_thread_fence(std::memory_order_release);
+  this->index(number);
+  std::atomic_thread_fence(std::memory_order_release);
+  this->header_->indexed = number + 1;
+  return true;
+}
+
+/**
+ * @brief Points the index entry of the address of the iNumber-th record at it
+ * 
+ * @param iNumber
+ */
+void PeerTable::index(const std::size_t& iNumber) {
+  const peer_record_t& record = this->records_[iNumber];
+  std::uint32_t* slot = this->slot_of(record.address);
+  const peer_record_t* previous = this->record_of(*slot);
+  const bool wasLive = (previous != nullptr) && (previous->state == PEER_LIVE);
+  *slot = static_cast<std::uint32_t>(iNumber + 1);
+  if (wasLive && (record.state != PEER_LIVE)) {
+    --this->header_->live;
+  } else if (!wasLive && (record.state == PEER_LIVE)) {
+    ++this->header_->live;
+  }
+}
+
+/**
+ * @brief Index entry of iWire
+ * 
+ * @param iWire
+ * 
+ * @return
+ */
+[[nodiscard]] std::uint32_t* PeerTable::slot_of(const std::uint8_t* iWire) const {
+  // At most half the entries are used, the probe always ends on an empty one
+  const std::size_t mask = this->header_->index_slots - 1;
+  for (std::size_t slot = hash_of(iWire) & mask;; slot = (slot + 1) & mask) {
+    const peer_record_t* record = this->record_of(this->index_[slot]);
+    if ((record == nullptr) || (std::memcmp(record->address, iWire, WIRE_ADDRESS_SIZE) == 0)) {
+      return &this->index_[slot];
+    }
+  }
+}
+
+/**
+ * @brief Record iEntry points at, null if the entry is empty or past the committed records
+ * 
+ * @param iEntry
+ * 
+ * @return
+ */
+[[nodiscard]] const peer_record_t* PeerTable::record_of(const std::uint32_t& iEntry) const {
+  return ((iEntry != 0) && (iEntry <= this->header_->committed)) ? &this->records_[iEntry - 1] : nullptr;
+}
+
+/**
+ * @brief Current record of the address at iWire
+ * 
+ * @param iWire
+ * 
+ * @return
+ */
+[[nodiscard]] const peer_record_t* PeerTable::find(const std::uint8_t* iWire) const {
+  if (this->map_ == nullptr) {
+    return nullptr;
+  }
+  const peer_record_t* record = this->record_of(*this->slot_of(iWire));
+  return ((record != nullptr) && (record->state == PEER_LIVE)) ? record : nullptr;
+}
+
+/**
+ * @brief Appends a record removing the address at iWire
+ * 
+ * @param iWire
+ * 
+ * @return
+ */
+[[nodiscard]] bool PeerTable::remove(const std::uint8_t* iWire) {
+  const peer_record_t* current = this->find(iWire);
+  if (current == nullptr) {
+    errno = (this->map_ == nullptr) ? EBADF : ENOENT;
+    return false;
+  }
+  peer_record_t record = *current;
+  record.state = PEER_REMOVED;
+  return this->append(record);
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+} // namespace addr
+} // namespace ncs
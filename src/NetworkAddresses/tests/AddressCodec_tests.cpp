@@ -0,0 +1,161 @@
+/**
+ * @copyright Copyright (c) 2023
+ * 
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ * 
+ * @file AddressCodec_tests.cpp
+ * 
+ * @brief
+ */
+
+
+#include <AddressCodec.h>
+#include <InternetAddressTest.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+
+namespace ncs::addr {
+namespace tests {
+
+
+/**
+ * @brief
+ */
+TEST_F(InternetAddressTest, Codec_Golden_Bytes) {
+  // The layout is part of the format, these bytes must never change within WIRE_VERSION 1
+  const std::vector<std::uint8_t> golden4 = {4, 192, 0, 2, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x1f, 0x90};
+  const std::vector<std::uint8_t> golden6 = {6, 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 0xbb};
+  std::uint8_t wire[WIRE_ADDRESS_SIZE];
+  ASSERT_TRUE(encode_address(InternetAddress("192.0.2.1", 8080), wire));
+  EXPECT_EQ(std::vector<std::uint8_t>(wire, wire + WIRE_ADDRESS_SIZE), golden4);
+  ASSERT_TRUE(encode_address(InternetAddress("2001:DB8::1", 443), wire));
+  EXPECT_EQ(std::vector<std::uint8_t>(wire, wire + WIRE_ADDRESS_SIZE), golden6);
+
+  inet_address_t binary;
+  ASSERT_TRUE(to_inet_address({"192.0.2.1", 8080}, binary));
+  encode_address(binary, wire);
+  EXPECT_EQ(std::vector<std::uint8_t>(wire, wire + WIRE_ADDRESS_SIZE), golden4);
+
+  InternetAddress addr;
+  ASSERT_TRUE(decode_address(golden6.data(), addr));
+  EXPECT_EQ(addr, InternetAddress("2001:db8::1", 443));
+  ASSERT_TRUE(decode_address(golden4.data(), binary));
+  ASSERT_TRUE(std::holds_alternative<Inet4Address>(binary));
+  EXPECT_EQ(std::get<Inet4Address>(binary).to_internet_address(), InternetAddress("192.0.2.1", 8080));
+
+  std::vector<std::uint8_t> unknown = golden4;
+  unknown[0] = 5;
+  EXPECT_FALSE(decode_address(unknown.data(), addr));
+  EXPECT_FALSE(decode_address(unknown.data(), binary));
+  EXPECT_FALSE(encode_address(InternetAddress("localhost", 80), wire));
+  EXPECT_FALSE(encode_address(InternetAddress("192.0.2.1", 70000), wire));
+}
+
+/**
+ * @brief
+ */
+TEST_F(InternetAddressTest, Codec_Keeps_Mapped_Addresses_Ipv6) {
+  const std::vector<std::uint8_t> golden = {6, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff, 192, 0, 2, 1, 0x1f, 0x90};
+  const InternetAddress mapped("::ffff:192.0.2.1", 8080);
+  std::uint8_t wire[WIRE_ADDRESS_SIZE];
+  ASSERT_TRUE(encode_address(mapped, wire));
+  EXPECT_EQ(std::vector<std::uint8_t>(wire, wire + WIRE_ADDRESS_SIZE), golden);
+
+  InternetAddress addr;
+  ASSERT_TRUE(decode_address(wire, addr));
+  EXPECT_EQ(addr.get_address_family(), NET_ADDR_FAM_INET6);
+  EXPECT_EQ(addr, mapped);
+  inet_address_t binary;
+  ASSERT_TRUE(decode_address(wire, binary));
+  EXPECT_TRUE(std::holds_alternative<Inet6Address>(binary));
+}
+
+/**
+ * @brief
+ */
+TEST_F(InternetAddressTest, Codec_Round_Trips_Lists) {
+  const std::vector<InternetAddress> addrs = {{"10.0.0.1", 1}, {"::1", 65535}, {"255.255.255.255", 0},
+                                              {"fe80::1:2:3:4", 8080}, {"192.0.2.7", 443}};
+  std::vector<std::uint8_t> wire = {0xee};
+  ASSERT_TRUE(encode_addresses(addrs, wire));
+  ASSERT_EQ(wire.size(), 1 + WIRE_HEADER_SIZE + addrs.size() * WIRE_ADDRESS_SIZE);
+  EXPECT_EQ(std::vector<std::uint8_t>(wire.begin() + 1, wire.begin() + 1 + WIRE_HEADER_SIZE),
+            std::vector<std::uint8_t>({'N', 'A', 1, 19, 0, 0, 0, 5}));
+
+  // Lists follow each other, the decoded size tells where the next one starts
+  std::vector<inet_address_t> binaries;
+  for (const InternetAddress& addr : addrs) {
+    binaries.emplace_back();
+    ASSERT_TRUE(to_inet_address(addr, binaries.back()));
+  }
+  encode_addresses(binaries, wire);
+  const std::size_t first = decode_addresses(wire.data() + 1, wire.size() - 1, binaries);
+  ASSERT_EQ(first, WIRE_HEADER_SIZE + addrs.size() * WIRE_ADDRESS_SIZE);
+  std::vector<InternetAddress> decoded;
+  ASSERT_EQ(decode_addresses(wire.data() + 1 + first, wire.size() - 1 - first, decoded), first);
+  EXPECT_EQ(decoded, addrs);
+  ASSERT_EQ(binaries.size(), addrs.size());
+  for (std::size_t i = 0; i < addrs.size(); ++i) {
+    socklen_t size = 0;
+    InternetAddress addr;
+    ASSERT_TRUE(addr.set_sockaddr(get_sockaddr(binaries[i], size), size));
+    EXPECT_EQ(addr, addrs[i]) << i;
+  }
+
+  // Nothing is written when one address does not fit
+  const std::size_t size = wire.size();
+  EXPECT_FALSE(encode_addresses({{"10.0.0.1", 1}, {"localhost", 80}}, wire));
+  EXPECT_EQ(wire.size(), size);
+  std::vector<std::uint8_t> empty;
+  ASSERT_TRUE(encode_addresses(std::vector<InternetAddress>(), empty));
+  EXPECT_EQ(decode_addresses(empty.data(), empty.size(), decoded), WIRE_HEADER_SIZE);
+  EXPECT_TRUE(decoded.empty());
+}
+
+/**
+ * @brief
+ */
+TEST_F(InternetAddressTest, Codec_Checks_Lists) {
+  std::vector<std::uint8_t> wire;
+  ASSERT_TRUE(encode_addresses({{"10.0.0.1", 1}, {"10.0.0.2", 2}}, wire));
+  std::vector<InternetAddress> decoded;
+  EXPECT_EQ(decode_addresses(wire.data(), wire.size() - 1, decoded), 0u);
+  EXPECT_EQ(decode_addresses(wire.data(), WIRE_HEADER_SIZE - 1, decoded), 0u);
+
+  std::vector<std::uint8_t> bad = wire;
+  bad[0] = 'X';
+  EXPECT_EQ(decode_addresses(bad.data(), bad.size(), decoded), 0u);
+  bad = wire;
+  bad[2] = WIRE_VERSION + 1;
+  EXPECT_EQ(decode_addresses(bad.data(), bad.size(), decoded), 0u);
+  bad = wire;
+  bad[3] = WIRE_ADDRESS_SIZE - 1;
+  EXPECT_EQ(decode_addresses(bad.data(), bad.size(), decoded), 0u);
+  bad = wire;
+  bad[4] = 0xff;
+  EXPECT_EQ(decode_addresses(bad.data(), bad.size(), decoded), 0u);
+  bad = wire;
+  bad[WIRE_HEADER_SIZE + WIRE_ADDRESS_SIZE] = 0;
+  EXPECT_EQ(decode_addresses(bad.data(), bad.size(), decoded), 0u);
+  EXPECT_TRUE(decoded.empty());
+
+  // Records grown by a later revision are read up to the fields known here
+  std::vector<std::uint8_t> grown(wire.begin(), wire.begin() + WIRE_HEADER_SIZE);
+  grown[3] = WIRE_ADDRESS_SIZE + 2;
+  for (std::size_t i = 0; i < 2; ++i) {
+    const auto record = wire.begin() + WIRE_HEADER_SIZE + i * WIRE_ADDRESS_SIZE;
+    grown.insert(grown.end(), record, record + WIRE_ADDRESS_SIZE);
+    grown.insert(grown.end(), {0xab, 0xcd});
+  }
+  ASSERT_EQ(decode_addresses(grown.data(), grown.size(), decoded), grown.size());
+  EXPECT_EQ(decoded, std::vector<InternetAddress>({{"10.0.0.1", 1}, {"10.0.0.2", 2}}));
+}
+
+
+} // namespace tests
+} // namespace ncs::addr
@@ -0,0 +1,134 @@
+/**
+ * @copyright Copyright (c) 2023
+ * 
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ * 
+ * @file AddressPool_tests.cpp
+ * 
+ * @brief
+ */
+
+
+#include <AddressPool.h>
+#include <FixedAddress.h>
+#include <InternetAddressTest.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace ncs::addr {
+namespace tests {
+
+
+/**
+ * @brief
+ */
+TEST_F(InternetAddressTest, Pool_Deduplicates_Addresses) {
+  AddressPool pool;
+  const address_handle_t a = pool.intern("192.0.2.1");
+  const address_handle_t b = pool.intern("192.0.2.1");
+  const address_handle_t c = pool.intern("2001:db8::1");
+  ASSERT_NE(a, INVALID_ADDRESS_HANDLE);
+  EXPECT_EQ(a, b);
+  EXPECT_NE(a, c);
+  EXPECT_EQ(pool.get_size(), 2u);
+  EXPECT_EQ(pool.get_refs(a), 2u);
+
+  // Every spelling of an address, and its sockaddr, lands on the same entry
+  EXPECT_EQ(pool.intern("2001:DB8:0::1"), c);
+  Inet6Address addr6;
+  ASSERT_TRUE(addr6.parse("2001:db8::1", 8080));
+  EXPECT_EQ(pool.intern(addr6.get_sockaddr(), addr6.get_sockaddr_size()), c);
+  EXPECT_EQ(pool.get_refs(c), 3u);
+
+  ip_t ip;
+  EXPECT_TRUE(pool.get_ip(c, ip));
+  EXPECT_EQ(ip, "2001:db8::1");
+  EXPECT_EQ(pool.get_address_family(a), NET_ADDR_FAM_INET);
+  EXPECT_EQ(pool.get_address_family(c), NET_ADDR_FAM_INET6);
+
+  InternetAddress addr;
+  EXPECT_TRUE(pool.to_address({a, 8080}, addr));
+  EXPECT_EQ(addr, InternetAddress("192.0.2.1", 8080));
+  EXPECT_EQ(pooled_address_t({a, 8080}), pooled_address_t({b, 8080}));
+  EXPECT_NE(pooled_address_t({a, 8080}), pooled_address_t({c, 8080}));
+
+  EXPECT_EQ(pool.intern("localhost"), INVALID_ADDRESS_HANDLE);
+  EXPECT_EQ(pool.intern("192.0.2.256"), INVALID_ADDRESS_HANDLE);
+}
+
+/**
+ * @brief
+ */
+TEST_F(InternetAddressTest, Pool_Reclaims_Unreferenced_Entries) {
+  AddressPool pool;
+  const address_handle_t a = pool.intern("10.0.0.1");
+  ASSERT_TRUE(pool.retain(a));
+  EXPECT_TRUE(pool.release(a));
+  EXPECT_EQ(pool.get_size(), 1u);
+  EXPECT_TRUE(pool.release(a));
+  EXPECT_EQ(pool.get_size(), 0u);
+  EXPECT_EQ(pool.get_refs(a), 0u);
+  EXPECT_FALSE(pool.release(a));
+  EXPECT_FALSE(pool.retain(a));
+  ip_t ip;
+  EXPECT_FALSE(pool.get_ip(a, ip));
+
+  // The slot is reused by the next address under a new handle, the stale one stays dead
+  const address_handle_t b = pool.intern("10.0.0.2");
+  EXPECT_NE(b, a);
+  EXPECT_TRUE(pool.get_ip(b, ip));
+  EXPECT_EQ(ip, "10.0.0.2");
+  EXPECT_FALSE(pool.get_ip(a, ip));
+  EXPECT_EQ(pool.get_refs(a), 0u);
+  EXPECT_FALSE(pool.release(a));
+  EXPECT_EQ(pool.get_refs(b), 1u);
+}
+
+/**
+ * @brief
+ */
+TEST_F(InternetAddressTest, Pool_Concurrent_Readers) {
+  AddressPool pool;
+  std::vector<address_handle_t> handles;
+  for (int i = 0; i < 64; ++i) {
+    handles.push_back(pool.intern("10.1.0." + std::to_string(i)));
+  }
+
+  std::atomic<bool> stop(false);
+  std::atomic<std::size_t> mismatches(0);
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; ++t) {
+    readers.emplace_back([&]() {
+      while (!stop.load()) {
+        for (std::size_t i = 0; i < handles.size(); ++i) {
+          ip_t ip;
+          if (!pool.get_ip(handles[i], ip) || (ip != "10.1.0." + std::to_string(i))) {
+            ++mismatches;
+          }
+        }
+      }
+    });
+  }
+  // A writer keeps adding and reclaiming other entries meanwhile
+  for (int i = 0; i < 500; ++i) {
+    const address_handle_t other = pool.intern("10.2." + std::to_string(i / 256) + "." + std::to_string(i % 256));
+    EXPECT_TRUE(pool.release(other));
+  }
+  stop = true;
+  for (std::thread& reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(mismatches.load(), 0u);
+  EXPECT_EQ(pool.get_size(), handles.size());
+}
+
+
+} // namespace tests
+} // namespace ncs::addr
@@ -0,0 +1,137 @@
+/**
+ * @copyright Copyright (c) 2023
+ * 
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ * 
+ * @file AddressSort_tests.cpp
+ * 
+ * @brief
+ */
+
+
+#include <AddressSort.h>
+#include <InternetAddressTest.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+
+namespace ncs::addr {
+namespace tests {
+
+
+/**
+ * @brief
+ */
+TEST_F(InternetAddressTest, Address_Numeric_Order) {
+  // Textual order would put 10.0.0.10 before 10.0.0.9
+  EXPECT_LT(InternetAddress("10.0.0.9", 8080), InternetAddress("10.0.0.10", 8080));
+  EXPECT_LT(InternetAddress("10.0.0.9", 8080), InternetAddress("10.0.0.9", 8443));
+  EXPECT_LT(InternetAddress("255.255.255.255", 65535), InternetAddress("::", 0));
+  EXPECT_LT(InternetAddress("2001:db8::2", 8080), InternetAddress("2001:db8::10", 8080));
+  EXPECT_GT(InternetAddress("2001:db8::1", 8080), InternetAddress("192.0.2.1", 8080));
+  EXPECT_LE(InternetAddress("192.0.2.1", 8080), InternetAddress("192.0.2.1", 8080));
+  EXPECT_GE(InternetAddress("192.0.2.1", 8080), InternetAddress("192.0.2.1", 8080));
+
+  // Spellings of the same address are equivalent, ips that are neither IPv4 nor IPv6 go last
+  EXPECT_EQ(InternetAddress("2001:DB8:0::1", 8080).compare(InternetAddress("2001:db8::1", 8080)), 0);
+  EXPECT_LT(InternetAddress("ffff::1", 8080), InternetAddress("localhost", 8080));
+  EXPECT_LT(InternetAddress("10.0.0.1", 65535), InternetAddress("10.0.0.1", 70000));
+  EXPECT_LT(InternetAddress("10.0.0.1", 70000), InternetAddress("10.0.0.2", 0));
+  EXPECT_LT(InternetAddress("10.0.0.1", -1), InternetAddress("10.0.0.1", 0));
+
+  // Ports out of range compare like operator== tells them apart
+  EXPECT_EQ(InternetAddress("::1", -1), InternetAddress("0:0::1", -1));
+  EXPECT_EQ(InternetAddress("::1", -1).compare(InternetAddress("0:0::1", -1)), 0);
+  EXPECT_LT(InternetAddress("localhost", 8080), InternetAddress("localhost", 8443));
+  EXPECT_LT(InternetAddress("a.example", 8080), InternetAddress("b.example", 8080));
+
+  std::set<InternetAddress> peers{{"10.0.0.2", 8080}, {"10.0.0.1", 8080}, {"2001:db8::1", 8080},
+                                  {"2001:DB8::1", 8080}, {"10.0.0.1", 8080}};
+  ASSERT_EQ(peers.size(), 3u);
+  EXPECT_EQ(*peers.begin(), InternetAddress("10.0.0.1", 8080));
+  EXPECT_EQ(*peers.rbegin(), InternetAddress("2001:db8::1", 8080));
+}
+
+/**
+ * @brief
+ */
+TEST_F(InternetAddressTest, Address_Sort_Key) {
+  address_key_t key;
+  ASSERT_TRUE(InternetAddress("192.0.2.1", 0x1f90).to_key(key));
+  const std::uint8_t expected4[ADDRESS_KEY_SIZE] = {ADDRESS_KEY_INET, 192, 0, 2, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                                                    0x1f, 0x90};
+  EXPECT_EQ(std::memcmp(key.bytes, expected4, ADDRESS_KEY_SIZE), 0);
+
+  ASSERT_TRUE(InternetAddress("2001:db8::1", 443).to_key(key));
+  EXPECT_EQ(key.bytes[0], ADDRESS_KEY_INET6);
+  EXPECT_EQ(key.bytes[1], 0x20);
+  EXPECT_EQ(key.bytes[16], 0x01);
+  EXPECT_EQ(key.bytes[18], 443 & 0xff);
+
+  EXPECT_FALSE(InternetAddress("localhost", 8080).to_key(key));
+  EXPECT_EQ(key.bytes[0], ADDRESS_KEY_OTHER);
+  EXPECT_FALSE(InternetAddress("192.0.2.1", -1).to_key(key));
+  EXPECT_EQ(key.bytes[0], ADDRESS_KEY_OTHER);
+}
+
+/**
+ * @brief
+ */
+TEST_F(InternetAddressTest, Address_Radix_Sort) {
+  std::vector<InternetAddress> addresses;
+  for (int i = 0; i < 2000; ++i) {
+    const std::string host = std::to_string(i % 300);
+    if (i % 5 == 0) {
+      addresses.emplace_back("2001:db8::" + host, 1024 + i % 7);
+    }
+    else if (i % 97 == 0) {
+      addresses.emplace_back("host" + host, 1024 + i % 7);
+    }
+    else {
+      addresses.emplace_back("10." + std::to_string(i % 3) + ".0." + std::to_string(i % 256), 1024 + i % 7);
+    }
+  }
+  std::shuffle(addresses.begin(), addresses.end(), std::mt19937(42));
+
+  std::vector<InternetAddress> expected = addresses;
+  std::stable_sort(expected.begin(), expected.end());
+  std::vector<InternetAddress> sorted = addresses;
+  sort_addresses(sorted);
+  EXPECT_EQ(sorted, expected);
+
+  expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
+  const std::size_t removed = unique_addresses(addresses);
+  EXPECT_EQ(removed, 2000u - expected.size());
+  EXPECT_EQ(addresses, expected);
+
+  // Equivalent spellings collapse into the first one met
+  std::vector<InternetAddress> spellings{{"2001:DB8::1", 8080}, {"10.0.0.1", 8080}, {"2001:db8::1", 8080}};
+  EXPECT_EQ(unique_addresses(spellings), 1u);
+  ASSERT_EQ(spellings.size(), 2u);
+  EXPECT_EQ(spellings[1].get_ip(), "2001:DB8::1");
+
+  // Out of range ports share a key with port 0 and must still be told apart and collapsed like operator== does
+  std::vector<InternetAddress> unset{{"::1", -1}, {"1.1.1.1", -1}, {"0:0::1", -1}, {"::1", 0}, {"1.1.1.1", 70000}};
+  EXPECT_EQ(unique_addresses(unset), 1u);
+  EXPECT_EQ(unset, std::vector<InternetAddress>({{"1.1.1.1", -1}, {"1.1.1.1", 70000}, {"::1", -1}, {"::1", 0}}));
+  std::vector<InternetAddress> shuffled{{"10.0.0.1", 0}, {"10.0.0.1", 70000}, {"10.0.0.1", -1}, {"10.0.0.1", 1}};
+  sort_addresses(shuffled);
+  EXPECT_EQ(shuffled, std::vector<InternetAddress>({{"10.0.0.1", -1}, {"10.0.0.1", 0}, {"10.0.0.1", 1},
+                                                    {"10.0.0.1", 70000}}));
+
+  std::vector<InternetAddress> empty;
+  sort_addresses(empty);
+  EXPECT_EQ(unique_addresses(empty), 0u);
+}
+
+
+} // namespace tests
+} // namespace ncs::addr
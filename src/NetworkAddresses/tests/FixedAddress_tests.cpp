@@ -0,0 +1,98 @@
+/**
+ * @copyright Copyright (c) 2023
+ * 
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ * 
+ * @file FixedAddress_tests.cpp
+ * 
+ * @brief
+ */
+
+
+#include <FixedAddress.h>
+#include <InternetAddressTest.h>
+
+#include <gtest/gtest.h>
+
+#include <type_traits>
+
+
+namespace ncs::addr {
+namespace tests {
+
+
+static_assert(!std::is_polymorphic<InternetAddress>::value, "addresses must not carry a vtable pointer");
+static_assert(sizeof(Inet4Address) == sizeof(sockaddr_in), "IPv4 addresses are stored as their sockaddr");
+static_assert(sizeof(Inet6Address) == sizeof(sockaddr_in6), "IPv6 addresses are stored as their sockaddr");
+static_assert(Inet6Address::get_address_family() == NET_ADDR_FAM_INET6, "the family is a constant expression");
+
+
+/**
+ * @brief
+ */
+TEST_F(InternetAddressTest, Fixed_Parse_And_Format) {
+  Inet4Address addr4;
+  EXPECT_EQ(addr4.get_port(), 0);
+  EXPECT_EQ(addr4.get_sockaddr()->sa_family, AF_INET);
+  ASSERT_TRUE(addr4.parse("192.0.2.10", 8080));
+  EXPECT_EQ(addr4.get_port(), 8080);
+  EXPECT_EQ(addr4.to_string(), "192.0.2.10:8080");
+  EXPECT_EQ(addr4.to_internet_address(), InternetAddress("192.0.2.10", 8080));
+  EXPECT_TRUE(addr4.has_family(NET_ADDR_FAM_INET));
+
+  // A failed parse leaves the address untouched
+  EXPECT_FALSE(addr4.parse("2001:db8::1", 8080));
+  EXPECT_FALSE(addr4.parse("192.0.2.11", 70000));
+  EXPECT_EQ(addr4.to_string(), "192.0.2.10:8080");
+
+  Inet6Address addr6;
+  ASSERT_TRUE(addr6.assign({"2001:db8::1", 8443}));
+  EXPECT_EQ(addr6.get_sockaddr()->sa_family, AF_INET6);
+  EXPECT_EQ(addr6.to_string(), "[2001:db8::1]:8443");
+  EXPECT_FALSE(addr6.is_multicast());
+  ASSERT_TRUE(addr6.parse("ff02::1", 0));
+  EXPECT_TRUE(addr6.is_multicast());
+  EXPECT_FALSE(addr6.assign({"192.0.2.10", 8443}));
+}
+
+/**
+ * @brief
+ */
+TEST_F(InternetAddressTest, Fixed_Comparison) {
+  Inet4Address a;
+  Inet4Address b;
+  ASSERT_TRUE(a.parse("10.0.0.1", 5000));
+  ASSERT_TRUE(b.parse("10.0.0.1", 5000));
+  EXPECT_EQ(a, b);
+  b.set_port(5001);
+  EXPECT_NE(a, b);
+  ASSERT_TRUE(b.parse("10.0.0.2", 5000));
+  EXPECT_NE(a, b);
+  EXPECT_EQ(Inet4Address(*reinterpret_cast<const sockaddr_in*>(a.get_sockaddr())), a);
+}
+
+/**
+ * @brief
+ */
+TEST_F(InternetAddressTest, Fixed_Variant_Of_Kinds) {
+  inet_address_t addr;
+  socklen_t size = 0;
+  ASSERT_TRUE(to_inet_address({"127.0.0.1", 80}, addr));
+  EXPECT_EQ(get_address_family(addr), NET_ADDR_FAM_INET);
+  EXPECT_EQ(get_sockaddr(addr, size)->sa_family, AF_INET);
+  EXPECT_EQ(size, sizeof(sockaddr_in));
+
+  ASSERT_TRUE(to_inet_address({"::1", 8080}, addr));
+  EXPECT_EQ(get_address_family(addr), NET_ADDR_FAM_INET6);
+  EXPECT_EQ(get_sockaddr(addr, size)->sa_family, AF_INET6);
+  EXPECT_EQ(size, sizeof(sockaddr_in6));
+  EXPECT_EQ(std::get<Inet6Address>(addr).to_string(), "[::1]:8080");
+
+  EXPECT_FALSE(to_inet_address({"localhost", 80}, addr));
+  EXPECT_FALSE(to_inet_address({"::1", -1}, addr));
+}
+
+
+} // namespace tests
+} // namespace ncs::addr
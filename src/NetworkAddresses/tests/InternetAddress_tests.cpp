@@ -14,9 +14,12 @@
 
 #include <gtest/gtest.h>
 
+#include <arpa/inet.h>
+
 #include <map>
 #include <random>
 #include <array>
+#include <unordered_set>
 
 
 namespace ncs::addr {
@@ -135,6 +138,20 @@ TEST_F(InternetAddressTest, Address_Family) {
   EXPECT_EQ(defaultAddr_.get_address_family(), defaultFamily_);
 }
 
+/**
+ * @brief
+ */
+TEST_F(InternetAddressTest, Multicast_Groups) {
+  EXPECT_TRUE (InternetAddress("224.0.0.1", 0).is_multicast());
+  EXPECT_TRUE (InternetAddress("239.255.255.255", 0).is_multicast());
+  EXPECT_FALSE(InternetAddress("223.255.255.255", 0).is_multicast());
+  EXPECT_FALSE(InternetAddress("240.0.0.1", 0).is_multicast());
+  EXPECT_TRUE (InternetAddress("ff02::1", 0).is_multicast());
+  EXPECT_TRUE (InternetAddress("FF3E::8000:1", 0).is_multicast());
+  EXPECT_FALSE(InternetAddress("fe80::1", 0).is_multicast());
+  EXPECT_FALSE(InternetAddress("not-an-ip", 0).is_multicast());
+}
+
 /**
  * @brief
  */
@@ -190,6 +207,64 @@ TEST_F(InternetAddressTest, Comparison_Operators) {
   EXPECT_NE(auxiliaryIpAddr1, defaultAddr_);
 }
 
+/**
+ * @brief
+ */
+TEST_F(InternetAddressTest, Canonical_Equality) {
+  const internet_address_hash_t hash;
+  const auto same = [&hash](const InternetAddress& iLeft, const InternetAddress& iRight) {
+    return (iLeft == iRight) && (hash(iLeft) == hash(iRight));
+  };
+  EXPECT_TRUE (same({"::1", 80}, {"0:0:0:0:0:0:0:1", 80}));
+  EXPECT_TRUE (same({"2001:DB8::1", 80}, {"2001:0db8:0:0::1", 80}));
+  EXPECT_TRUE (same({"::ffff:127.0.0.1", 80}, {"::FFFF:7f00:1", 80}));
+  EXPECT_TRUE (same({"localhost", 80}, {"localhost", 80}));
+  EXPECT_FALSE(InternetAddress("::1", 80) == InternetAddress("::1", 81));
+  EXPECT_FALSE(InternetAddress("localhost", 80) == InternetAddress("127.0.0.1", 80));
+  EXPECT_FALSE(InternetAddress("::", 70000) == InternetAddress("::", 4464));
+  EXPECT_FALSE(InternetAddress("::ffff:127.0.0.1", 80) == InternetAddress("127.0.0.1", 80));
+
+  // A mapped address keeps the family and the bytes it was written in
+  const InternetAddress mapped("::ffff:10.0.0.1", 443);
+  EXPECT_EQ(mapped.get_address_family(), NET_ADDR_FAM_INET6);
+  EXPECT_EQ(mapped.get_key().bytes[0], ADDRESS_KEY_INET6);
+  sockaddr_storage storage;
+  socklen_t size = 0;
+  ASSERT_TRUE(mapped.to_sockaddr(storage, size));
+  ASSERT_EQ(size, sizeof(sockaddr_in6));
+  InternetAddress fromSockaddr;
+  ASSERT_TRUE(fromSockaddr.set_sockaddr(reinterpret_cast<const sockaddr*>(&storage), size));
+  EXPECT_EQ(fromSockaddr.get_ip(), "::ffff:10.0.0.1");
+  EXPECT_TRUE(same(fromSockaddr, mapped));
+}
+
+/**
+ * @brief
+ */
+TEST_F(InternetAddressTest, Folded_Equality) {
+  const folded_address_hash_t hash;
+  const folded_address_equal_t equal;
+  const auto same = [&hash, &equal](const InternetAddress& iLeft, const InternetAddress& iRight) {
+    return equal(iLeft, iRight) && (hash(iLeft) == hash(iRight));
+  };
+  EXPECT_TRUE (same({"::ffff:127.0.0.1", 80}, {"127.0.0.1", 80}));
+  EXPECT_TRUE (same({"::1", 80}, {"0:0:0:0:0:0:0:1", 80}));
+  EXPECT_TRUE (same({"localhost", 80}, {"localhost", 80}));
+  EXPECT_FALSE(equal({"::ffff:127.0.0.1", 80}, {"127.0.0.1", 81}));
+  EXPECT_FALSE(equal({"::ffff:127.0.0.1", 80}, {"::127.0.0.1", 80}));
+  EXPECT_FALSE(equal({"localhost", 80}, {"127.0.0.1", 80}));
+  EXPECT_FALSE(equal({"1.2.3.4", -1}, {"1.2.3.4", 0}));
+  EXPECT_FALSE(equal({"::ffff:1.2.3.4", 70000}, {"1.2.3.4", 0}));
+  EXPECT_TRUE (same({"::ffff:1.2.3.4", -1}, {"1.2.3.4", -1}));
+  EXPECT_EQ(fold_v4_mapped(InternetAddress("::ffff:10.0.0.1", 443).get_key()).bytes[0], ADDRESS_KEY_INET);
+
+  // Folding is a property of the container, the addresses keep their own key
+  std::unordered_set<InternetAddress, folded_address_hash_t, folded_address_equal_t> peers;
+  peers.insert({"10.0.0.1", 443});
+  EXPECT_FALSE(peers.insert({"::ffff:10.0.0.1", 443}).second);
+  EXPECT_EQ(peers.begin()->get_address_family(), NET_ADDR_FAM_INET);
+}
+
 
 } // namespace tests
 } // namespace ncs::addr
\ No newline at end of file
@@ -0,0 +1,274 @@
+/**
+ * @copyright Copyright (c) 2023
+ * 
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ * 
+ * @file PeerTable_tests.cpp
+ * 
+ * @brief
+ */
+
+
+#include <InternetAddressTest.h>
+#include <PeerTable.h>
+
+#include <gtest/gtest.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+
+namespace ncs::addr {
+namespace tests {
+
+
+/**
+ * @brief Path of a table no other test uses, removed if a previous run left it
+ * 
+ * @param iName
+ * 
+ * @return
+ */
+static std::string table_path(const std::string& iName) {
+  const std::string path = ::testing::TempDir() + "ncs_peer_table_" + iName + "_" + std::to_string(getpid());
+  std::remove(path.c_str());
+  return path;
+}
+
+/**
+ * @brief Overwrites iSize bytes of the file at iPath, the way a crash leaves it
+ * 
+ * @param iPath
+ * @param iOffset
+ * @param iBytes
+ * @param iSize
+ * 
+ * @return
+ */
+static bool patch(const std::string& iPath, const std::size_t& iOffset, const void* iBytes, const std::size_t& iSize) {
+  const int fd = ::open(iPath.c_str(), O_WRONLY);
+  const bool written = (fd >= 0) && (pwrite(fd, iBytes, iSize, static_cast<off_t>(iOffset)) == ssize_t(iSize));
+  ::close(fd);
+  return written;
+}
+
+
+/**
+ * @brief
+ */
+TEST_F(InternetAddressTest, Peer_Table_Persists) {
+  const std::string path = table_path("persists");
+  {
+    PeerTable table;
+    EXPECT_FALSE(table.put(InternetAddress("10.0.0.1", 80), {}));
+    EXPECT_EQ(errno, EBADF);
+    ASSERT_TRUE(table.open(path, 16));
+    EXPECT_EQ(table.get_size(), 0u);
+    EXPECT_EQ(table.get_capacity(), 16u);
+    ASSERT_TRUE(table.put(InternetAddress("10.0.0.1", 80), {100, 1000, 0}));
+    ASSERT_TRUE(table.put(InternetAddress("2001:db8::1", 443), {200, 1001, 0}));
+    ASSERT_TRUE(table.put(InternetAddress("10.0.0.2", 80), {300, 1002, 0}));
+    ASSERT_TRUE(table.put(InternetAddress("10.0.0.1", 80), {150, 2000, 1}));
+    ASSERT_TRUE(table.remove(InternetAddress("10.0.0.2", 80)));
+    EXPECT_FALSE(table.remove(InternetAddress("10.0.0.2", 80)));
+    EXPECT_EQ(errno, ENOENT);
+    EXPECT_FALSE(table.put(InternetAddress("localhost", 80), {}));
+    EXPECT_EQ(table.get_size(), 2u);
+    EXPECT_EQ(table.get_committed(), 5u);
+    ASSERT_TRUE(table.sync());
+  }
+
+  // Another process opening the table finds it as it was left
+  PeerTable table;
+  ASSERT_TRUE(table.open(path));
+  EXPECT_EQ(table.get_size(), 2u);
+  EXPECT_EQ(table.get_capacity(), 16u);
+  const peer_record_t* record = table.find(InternetAddress("10.0.0.1", 80));
+  ASSERT_NE(record, nullptr);
+  EXPECT_EQ(record->rtt_us, 150u);
+  EXPECT_EQ(record->last_seen, 2000u);
+  EXPECT_EQ(record->failures, 1u);
+  InternetAddress addr;
+  ASSERT_TRUE(decode_address(record->address, addr));
+  EXPECT_EQ(addr, InternetAddress("10.0.0.1", 80));
+  EXPECT_EQ(table.find(InternetAddress("10.0.0.2", 80)), nullptr);
+  EXPECT_EQ(table.find(InternetAddress("10.0.0.1", 81)), nullptr);
+  inet_address_t binary;
+  ASSERT_TRUE(to_inet_address({"2001:db8::1", 443}, binary));
+  record = table.find(binary);
+  ASSERT_NE(record, nullptr);
+  EXPECT_EQ(record->rtt_us, 200u);
+
+  std::vector<InternetAddress> peers;
+  table.for_each([&peers](const peer_record_t& iRecord) {
+    peers.emplace_back();
+    EXPECT_TRUE(decode_address(iRecord.address, peers.back()));
+  });
+  EXPECT_EQ(peers.size(), 2u);
+  ASSERT_TRUE(table.put(InternetAddress("10.0.0.2", 80), {}));
+  EXPECT_EQ(table.get_size(), 3u);
+  table.close();
+
+  const char garbage[] = "not a peer table, not even close to one of them, or to anything really";
+  ASSERT_TRUE(patch(path, 0, garbage, sizeof(garbage)));
+  EXPECT_FALSE(table.open(path));
+  EXPECT_EQ(errno, EINVAL);
+  EXPECT_FALSE(table.is_open());
+  std::remove(path.c_str());
+}
+
+/**
+ * @brief
+ */
+TEST_F(InternetAddressTest, Peer_Table_Compacts) {
+  const std::string path = table_path("compacts");
+  PeerTable table;
+  ASSERT_TRUE(table.open(path, 8));
+  // Updates of a few peers only take the room of their last records
+  for (std::uint32_t i = 0; i < 100; ++i) {
+    ASSERT_TRUE(table.put(InternetAddress("10.0.0." + std::to_string(i % 3), 80), {i, i, 0}));
+  }
+  EXPECT_EQ(table.get_size(), 3u);
+  EXPECT_EQ(table.get_capacity(), 8u);
+  EXPECT_LE(table.get_committed(), 8u);
+  ASSERT_TRUE(table.compact());
+  EXPECT_EQ(table.get_committed(), 3u);
+  EXPECT_EQ(table.get_path(), path);
+  EXPECT_NE(access((path + ".tmp").c_str(), F_OK), 0);
+
+  // Then the table grows to twice its peers
+  for (std::uint32_t i = 0; i < 40; ++i) {
+    ASSERT_TRUE(table.put(InternetAddress("2001:db8::" + std::to_string(i + 1), 443), {i, i, 0}));
+  }
+  EXPECT_EQ(table.get_size(), 43u);
+  EXPECT_GE(table.get_capacity(), 43u);
+  table.close();
+
+  ASSERT_TRUE(table.open(path, 8));
+  EXPECT_EQ(table.get_size(), 43u);
+  for (std::uint32_t i = 0; i < 3; ++i) {
+    const peer_record_t* record = table.find(InternetAddress("10.0.0." + std::to_string(i), 80));
+    ASSERT_NE(record, nullptr);
+    EXPECT_EQ(record->rtt_us, 99 - (99 - i) % 3);
+  }
+  ASSERT_NE(table.find(InternetAddress("2001:db8::28", 443)), nullptr);
+  std::remove(path.c_str());
+}
+
+/**
+ * @brief
+ */
+TEST_F(InternetAddressTest, Peer_Table_Recovers) {
+  const std::string path = table_path("recovers");
+  PeerTable table;
+  ASSERT_TRUE(table.open(path, 16));
+  ASSERT_TRUE(table.put(InternetAddress("10.0.0.1", 80), {1, 1, 0}));
+  ASSERT_TRUE(table.put(InternetAddress("10.0.0.2", 80), {2, 2, 0}));
+  ASSERT_TRUE(table.remove(InternetAddress("10.0.0.1", 80)));
+  ASSERT_TRUE(table.put(InternetAddress("10.0.0.3", 80), {3, 3, 0}));
+  const std::size_t slots = 32;
+  table.close();
+
+  // A crash after the records were counted and before any of them was indexed
+  const std::vector<std::uint32_t> empty(slots, 0);
+  const std::uint64_t indexed = 0;
+  const std::uint64_t live = 0;
+  ASSERT_TRUE(patch(path, sizeof(peer_table_header_t), empty.data(), empty.size() * sizeof(std::uint32_t)));
+  ASSERT_TRUE(patch(path, offsetof(peer_table_header_t, indexed), &indexed, sizeof(indexed)));
+  ASSERT_TRUE(patch(path, offsetof(peer_table_header_t, live), &live, sizeof(live)));
+  ASSERT_TRUE(table.open(path));
+  EXPECT_EQ(table.get_size(), 2u);
+  EXPECT_EQ(table.get_committed(), 4u);
+  EXPECT_EQ(table.find(InternetAddress("10.0.0.1", 80)), nullptr);
+  ASSERT_NE(table.find(InternetAddress("10.0.0.3", 80)), nullptr);
+  table.close();
+
+  // The last record was torn, it and the ones after it never happened
+  const std::size_t last = sizeof(peer_table_header_t) + slots * sizeof(std::uint32_t) + 3 * sizeof(peer_record_t);
+  const std::uint8_t torn = 0xff;
+  ASSERT_TRUE(patch(path, sizeof(peer_table_header_t), empty.data(), empty.size() * sizeof(std::uint32_t)));
+  ASSERT_TRUE(patch(path, offsetof(peer_table_header_t, indexed), &indexed, sizeof(indexed)));
+  ASSERT_TRUE(patch(path, last + offsetof(peer_record_t, rtt_us), &torn, sizeof(torn)));
+  ASSERT_TRUE(table.open(path));
+  EXPECT_EQ(table.get_committed(), 3u);
+  EXPECT_EQ(table.get_size(), 1u);
+  EXPECT_EQ(table.find(InternetAddress("10.0.0.3", 80)), nullptr);
+  ASSERT_NE(table.find(InternetAddress("10.0.0.2", 80)), nullptr);
+  ASSERT_TRUE(table.put(InternetAddress("10.0.0.4", 80), {4, 4, 0}));
+  EXPECT_EQ(table.get_committed(), 4u);
+  std::remove(path.c_str());
+}
+
+/**
+ * @brief
+ */
+TEST_F(InternetAddressTest, Peer_Table_Drops_Stale_Index) {
+  const std::string path = table_path("stale_index");
+  PeerTable table;
+  ASSERT_TRUE(table.open(path, 16));
+  ASSERT_TRUE(table.put(InternetAddress("10.0.0.1", 80), {1, 1, 0}));
+  ASSERT_TRUE(table.put(InternetAddress("10.0.0.2", 80), {2, 2, 0}));
+  ASSERT_TRUE(table.sync());
+  ASSERT_TRUE(table.put(InternetAddress("10.0.0.1", 80), {3, 3, 0}));
+  ASSERT_TRUE(table.put(InternetAddress("10.0.0.3", 80), {4, 4, 0}));
+  const std::size_t slots = 32;
+  table.close();
+
+  // Power lost after the index page of the last two puts reached the disk and before the header did
+  const std::uint64_t committed = 2;
+  const std::uint64_t live = 2;
+  ASSERT_TRUE(patch(path, offsetof(peer_table_header_t, committed), &committed, sizeof(committed)));
+  ASSERT_TRUE(patch(path, offsetof(peer_table_header_t, indexed), &committed, sizeof(committed)));
+  ASSERT_TRUE(patch(path, offsetof(peer_table_header_t, live), &live, sizeof(live)));
+
+  // An empty entry corrupted past the end of the records as well
+  std::vector<std::uint32_t> index(slots, 0);
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  const std::size_t bytes = index.size() * sizeof(std::uint32_t);
+  ASSERT_EQ(pread(fd, index.data(), bytes, sizeof(peer_table_header_t)), ssize_t(bytes));
+  ::close(fd);
+  std::size_t empty = 0;
+  while ((empty < slots) && (index[empty] != 0)) {
+    ++empty;
+  }
+  ASSERT_LT(empty, slots);
+  const std::uint32_t corrupt = 0xffffffff;
+  ASSERT_TRUE(patch(path, sizeof(peer_table_header_t) + empty * sizeof(std::uint32_t), &corrupt, sizeof(corrupt)));
+
+  ASSERT_TRUE(table.open(path));
+  EXPECT_EQ(table.get_committed(), 2u);
+  EXPECT_EQ(table.get_size(), 2u);
+  const peer_record_t* record = table.find(InternetAddress("10.0.0.1", 80));
+  ASSERT_NE(record, nullptr);
+  EXPECT_EQ(record->rtt_us, 1u);
+  EXPECT_EQ(table.find(InternetAddress("10.0.0.3", 80)), nullptr);
+  std::size_t visited = 0;
+  table.for_each([&visited](const peer_record_t& iRecord) { visited += (iRecord.rtt_us <= 2) ? 1 : 0; });
+  EXPECT_EQ(visited, 2u);
+
+  // Later puts reuse the record numbers the stale entries pointed at without aliasing them
+  ASSERT_TRUE(table.put(InternetAddress("10.0.0.4", 80), {5, 5, 0}));
+  ASSERT_TRUE(table.put(InternetAddress("10.0.0.5", 80), {6, 6, 0}));
+  EXPECT_EQ(table.get_size(), 4u);
+  EXPECT_EQ(table.find(InternetAddress("10.0.0.3", 80)), nullptr);
+  record = table.find(InternetAddress("10.0.0.1", 80));
+  ASSERT_NE(record, nullptr);
+  EXPECT_EQ(record->rtt_us, 1u);
+  record = table.find(InternetAddress("10.0.0.5", 80));
+  ASSERT_NE(record, nullptr);
+  EXPECT_EQ(record->rtt_us, 6u);
+  ASSERT_TRUE(table.compact());
+  EXPECT_EQ(table.get_committed(), 4u);
+  std::remove(path.c_str());
+}
+
+
+} // namespace tests
+} // namespace ncs::addr
@@ -0,0 +1,155 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file DelimiterFrameFormat.h
+ *
+ * @brief Frames terminated by a fixed byte sequence
+ */
+
+
+#ifndef NCS_DELIMITER_FRAME_FORMAT_H
+#define NCS_DELIMITER_FRAME_FORMAT_H
+
+
+#include <string>
+
+#include <FrameFormat.h>
+
+
+namespace ncs { // Network Communications System
+namespace frame { // Network Communications System Framing
+
+
+/**
+ * DelimiterFrameFormat constants
+ */
+constexpr char DEFAULT_FRAME_DELIMITER[] = "\r\n";     // Line based protocols
+
+
+/**
+ * @brief Payloads must not contain the delimiter, no escaping is performed
+ */
+class DelimiterFrameFormat : public FrameFormat {
+public:
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+  /**
+   * @brief Delimiter constructor
+   * 
+   * @param iDelimiter Non empty sequence terminating every frame
+   */
+  explicit DelimiterFrameFormat(const std::string& iDelimiter = DEFAULT_FRAME_DELIMITER);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Locates the frame placed at the beginning of iData
+   * 
+   * @param iData
+   * @param iSize
+   * @param iMaxPayload
+   * @param ioLayout Its scanned field lets a split frame resume the search where it stopped
+   * 
+   * @return
+   */
+  [[nodiscard]] frame_status_e parse(const std::uint8_t* iData, const std::size_t& iSize,
+                                     const std::size_t& iMaxPayload, frame_layout_t& ioLayout) const override;
+
+  /**
+   * @brief Delimited frames carry no header
+   * 
+   * @param iPayloadSize
+   * @param oHeader
+   * @param oHeaderSize
+   * 
+   * @return
+   */
+  [[nodiscard]] bool encode_header(const std::size_t& iPayloadSize, std::uint8_t* oHeader,
+                                   std::size_t& oHeaderSize) const override;
+
+  /**
+   * @brief The delimiter itself
+   * 
+   * @return
+   */
+  [[nodiscard]] frame_view_t trailer(void) const override;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] const std::string& get_delimiter(void) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+  /**
+   * @brief Destructor
+   */
+  ~DelimiterFrameFormat();
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+protected:
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+  std::string delimiter_;
+};
+
+
+} // namespace frame
+} // namespace ncs
+
+
+#endif // NCS_DELIMITER_FRAME_FORMAT_H
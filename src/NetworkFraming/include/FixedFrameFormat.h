@@ -0,0 +1,134 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file FixedFrameFormat.h
+ *
+ * @brief Frames prefixed with their payload length as a 4-byte big endian integer
+ */
+
+
+#ifndef NCS_FIXED_FRAME_FORMAT_H
+#define NCS_FIXED_FRAME_FORMAT_H
+
+
+#include <FrameFormat.h>
+
+
+namespace ncs { // Network Communications System
+namespace frame { // Network Communications System Framing
+
+
+/**
+ * FixedFrameFormat constants
+ */
+constexpr std::size_t FIXED_FRAME_HEADER_SIZE = 4;    // Bytes of the length prefix
+
+
+/**
+ * @brief
+ */
+class FixedFrameFormat : public FrameFormat {
+public:
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+  /**
+   * @brief Default constructor
+   */
+  FixedFrameFormat(void);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Locates the frame placed at the beginning of iData
+   * 
+   * @param iData
+   * @param iSize
+   * @param iMaxPayload
+   * @param ioLayout
+   * 
+   * @return
+   */
+  [[nodiscard]] frame_status_e parse(const std::uint8_t* iData, const std::size_t& iSize,
+                                     const std::size_t& iMaxPayload, frame_layout_t& ioLayout) const override;
+
+  /**
+   * @brief Writes the 4-byte length announcing a payload of iPayloadSize bytes
+   * 
+   * @param iPayloadSize
+   * @param oHeader
+   * @param oHeaderSize
+   * 
+   * @return False if iPayloadSize does not fit in 32 bits
+   */
+  [[nodiscard]] bool encode_header(const std::size_t& iPayloadSize, std::uint8_t* oHeader,
+                                   std::size_t& oHeaderSize) const override;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+  /**
+   * @brief Destructor
+   */
+  ~FixedFrameFormat();
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+protected:
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+};
+
+
+} // namespace frame
+} // namespace ncs
+
+
+#endif // NCS_FIXED_FRAME_FORMAT_H
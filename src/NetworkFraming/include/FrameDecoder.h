@@ -0,0 +1,205 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file FrameDecoder.h
+ *
+ * @brief Incremental decoder yielding frames that point into its receive buffer
+ */
+
+
+#ifndef NCS_FRAME_DECODER_H
+#define NCS_FRAME_DECODER_H
+
+
+#include <memory>
+
+#include <FrameFormat.h>
+#include <InternetSocket.h>
+
+
+namespace ncs { // Network Communications System
+namespace frame { // Network Communications System Framing
+
+
+/**
+ * FrameDecoder constants
+ */
+constexpr std::size_t DEFAULT_READ_SIZE = 64 * 1024;    // Room offered to every recv(2) by read_from()
+
+
+/**
+ * @brief Frames returned by next() stay valid until the following call to prepare() or read_from()
+ */
+class FrameDecoder {
+public:
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+  /**
+   * @brief Format constructor
+   * 
+   * @param iFormat Must outlive the decoder
+   * @param iMaxFrameSize Largest payload accepted before reporting FRAME_TOO_LARGE
+   */
+  explicit FrameDecoder(const FrameFormat& iFormat, const std::size_t& iMaxFrameSize = DEFAULT_MAX_FRAME_SIZE);
+
+  /**
+   * @brief Copy constructor
+   */
+  FrameDecoder(const FrameDecoder& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Reserves at least iMinSize writable bytes at the end of the buffered data
+   * 
+   * Pending bytes are moved to the front of the buffer only when the free tail is too short, which
+   * invalidates the frames previously returned by next().
+   * 
+   * @param iMinSize
+   * 
+   * @return Pointer to the first writable byte, writable_size() bytes are available
+   */
+  [[nodiscard]] std::uint8_t* prepare(const std::size_t& iMinSize);
+
+  /**
+   * @brief Marks iSize bytes written after prepare() as received
+   * 
+   * @param iSize
+   */
+  void commit(const std::size_t& iSize);
+
+  /**
+   * @brief Receives directly into the buffer, sized so a partially received frame completes in one read
+   * 
+   * @param iSocket
+   * @param iReadSize Minimum room offered to recv(2)
+   * 
+   * @return Result of InternetSocket::recv()
+   */
+  [[nodiscard]] ssize_t read_from(const sock::InternetSocket& iSocket, const std::size_t& iReadSize = DEFAULT_READ_SIZE);
+
+  /**
+   * @brief Extracts the next complete frame from the buffered data
+   * 
+   * @param oFrame Payload view into the receive buffer, only written on FRAME_READY
+   * 
+   * @return
+   */
+  [[nodiscard]] frame_status_e next(frame_view_t& oFrame);
+
+  /**
+   * @brief Drops every buffered byte
+   */
+  void clear(void);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+  /**
+   * @brief
+   * 
+   * @return Bytes received but not yet returned as frames
+   */
+  [[nodiscard]] std::size_t get_buffered_size(void) const;
+
+  /**
+   * @brief
+   * 
+   * @return Bytes available after the buffered data without compacting or growing
+   */
+  [[nodiscard]] std::size_t get_writable_size(void) const;
+
+  /**
+   * @brief
+   * 
+   * @return Bytes still missing to complete the current frame, 0 while its size is unknown
+   */
+  [[nodiscard]] std::size_t get_missing_size(void) const;
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] const std::size_t& get_max_frame_size(void) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+  /**
+   * @brief Copy assignment operator
+   */
+  FrameDecoder& operator=(const FrameDecoder& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+  /**
+   * @brief Destructor
+   */
+  ~FrameDecoder();
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+protected:
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+  const FrameFormat& format_;
+  std::size_t maxFrameSize_;
+  std::unique_ptr<std::uint8_t[]> buffer_;
+  std::size_t capacity_;
+  std::size_t head_;
+  std::size_t tail_;
+  frame_layout_t layout_;
+  std::size_t missing_;
+};
+
+
+} // namespace frame
+} // namespace ncs
+
+
+#endif // NCS_FRAME_DECODER_H
@@ -0,0 +1,170 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file FrameEncoder.h
+ *
+ * @brief Prepends frame headers through scatter/gather I/O without copying payloads
+ */
+
+
+#ifndef NCS_FRAME_ENCODER_H
+#define NCS_FRAME_ENCODER_H
+
+
+#include <FrameFormat.h>
+#include <InternetSocket.h>
+
+
+namespace ncs { // Network Communications System
+namespace frame { // Network Communications System Framing
+
+
+/**
+ * @brief Scatter/gather description of a single frame, the header bytes live inside the struct
+ */
+struct encoded_frame_t {
+  std::uint8_t header[MAX_FRAME_HEADER_SIZE];
+  iovec iov[3];
+  std::size_t iov_count = 0;
+  std::size_t size = 0;
+};
+
+/**
+ * FrameEncoder constants
+ */
+constexpr std::size_t MAX_FRAMES_PER_WRITE = 64;    // Frames gathered by a single sendmsg(2), 3 iovecs each
+
+
+/**
+ * @brief
+ */
+class FrameEncoder {
+public:
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+  /**
+   * @brief Format constructor
+   * 
+   * @param iFormat Must outlive the encoder
+   */
+  explicit FrameEncoder(const FrameFormat& iFormat);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Builds the scatter/gather vector of a frame, the payload is referenced and not copied
+   * 
+   * @param iPayload Must stay alive while oFrame is in use
+   * @param oFrame
+   * 
+   * @return False if the format can not represent the payload
+   */
+  [[nodiscard]] bool encode(const frame_view_t& iPayload, encoded_frame_t& oFrame) const;
+
+  /**
+   * @brief Sends one frame with a single sendmsg(2), retrying on short writes
+   * 
+   * @param iSocket
+   * @param iPayload
+   * 
+   * @return Bytes sent, or -1 if nothing could be sent. A short count means the socket stopped accepting data.
+   */
+  [[nodiscard]] ssize_t write_to(const sock::InternetSocket& iSocket, const frame_view_t& iPayload) const;
+
+  /**
+   * @brief Sends several frames, gathering up to MAX_FRAMES_PER_WRITE of them per sendmsg(2)
+   * 
+   * @param iSocket
+   * @param iPayloads
+   * @param iCount
+   * 
+   * @return Same as the single frame version
+   */
+  [[nodiscard]] ssize_t write_to(const sock::InternetSocket& iSocket, const frame_view_t* iPayloads,
+                                 const std::size_t& iCount) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+  /**
+   * @brief Destructor
+   */
+  ~FrameEncoder();
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+protected:
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Sends the whole iovec array, advancing it over short writes
+   * 
+   * @param iSocket
+   * @param ioIov
+   * @param iCount
+   * @param ioSent Bytes sent so far, accumulated across calls
+   * 
+   * @return False if the socket failed before every byte was sent
+   */
+  [[nodiscard]] static bool send_all(const sock::InternetSocket& iSocket, iovec* ioIov, std::size_t iCount,
+                                     ssize_t& ioSent);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+  const FrameFormat& format_;
+};
+
+
+} // namespace frame
+} // namespace ncs
+
+
+#endif // NCS_FRAME_ENCODER_H
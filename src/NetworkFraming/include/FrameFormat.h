@@ -0,0 +1,171 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file FrameFormat.h
+ *
+ * @brief Base class for the header formats that delimit messages on a byte stream
+ */
+
+
+#ifndef NCS_FRAME_FORMAT_H
+#define NCS_FRAME_FORMAT_H
+
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace ncs { // Network Communications System
+namespace frame { // Network Communications System Framing
+
+
+/**
+ * FrameFormat types
+ */
+enum frame_status_e {
+  FRAME_READY,          // A complete frame is available
+  FRAME_INCOMPLETE,     // More bytes are needed to complete the frame
+  FRAME_TOO_LARGE,      // The frame exceeds the maximum payload size
+  FRAME_MALFORMED       // The header can not be parsed
+};
+
+/**
+ * @brief Non owning view over a run of bytes
+ */
+struct frame_view_t {
+  const std::uint8_t* data = nullptr;
+  std::size_t size = 0;
+};
+
+/**
+ * @brief Position of a frame inside a buffer, filled by FrameFormat::parse()
+ */
+struct frame_layout_t {
+  std::size_t header_size = 0;      // Bytes preceding the payload
+  std::size_t payload_size = 0;     // Bytes of the payload itself
+  std::size_t trailer_size = 0;     // Bytes following the payload
+  std::size_t scanned = 0;          // Bytes already inspected by formats that search for a delimiter
+};
+
+/**
+ * FrameFormat constants
+ */
+constexpr std::size_t MAX_FRAME_HEADER_SIZE = 10;                   // Largest header any format emits (64-bit varint)
+constexpr std::size_t DEFAULT_MAX_FRAME_SIZE = 16 * 1024 * 1024;    // Default limit for a single payload
+
+
+/**
+ * @brief
+ */
+class FrameFormat {
+public:
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Locates the frame placed at the beginning of iData
+   * 
+   * @param iData
+   * @param iSize
+   * @param iMaxPayload
+   * @param ioLayout
+   * 
+   * @return FRAME_READY once ioLayout describes a complete frame
+   */
+  [[nodiscard]] virtual frame_status_e parse(const std::uint8_t* iData, const std::size_t& iSize,
+                                             const std::size_t& iMaxPayload, frame_layout_t& ioLayout) const = 0;
+
+  /**
+   * @brief Writes the header announcing a payload of iPayloadSize bytes
+   * 
+   * @param iPayloadSize
+   * @param oHeader Buffer of at least MAX_FRAME_HEADER_SIZE bytes
+   * @param oHeaderSize
+   * 
+   * @return False if the payload size can not be represented by the format
+   */
+  [[nodiscard]] virtual bool encode_header(const std::size_t& iPayloadSize, std::uint8_t* oHeader,
+                                           std::size_t& oHeaderSize) const = 0;
+
+  /**
+   * @brief Bytes appended after every payload, empty for length prefixed formats
+   * 
+   * @return
+   */
+  [[nodiscard]] virtual frame_view_t trailer(void) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+  /**
+   * @brief Destructor
+   */
+  virtual ~FrameFormat();
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+protected:
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+  /**
+   * @brief Default constructor
+   */
+  FrameFormat(void);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+};
+
+
+} // namespace frame
+} // namespace ncs
+
+
+#endif // NCS_FRAME_FORMAT_H
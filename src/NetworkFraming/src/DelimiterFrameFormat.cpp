@@ -0,0 +1,172 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file DelimiterFrameFormat.cpp
+ *
+ * @brief
+ */
+
+
+#include <DelimiterFrameFormat.h>
+
+#include <cstring>
+
+
+namespace ncs { // Network Communications System
+namespace frame { // Network Communications System Framing
+
+
+/** PUBLIC METHODS **/
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+/**
+ * @brief Delimiter constructor
+ * 
+ * @param iDelimiter
+ */
+DelimiterFrameFormat::DelimiterFrameFormat(const std::string& iDelimiter) : delimiter_(iDelimiter) {}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Locates the frame placed at the beginning of iData
+ * 
+ * @param iData
+ * @param iSize
+ * @param iMaxPayload
+ * @param ioLayout
+ * 
+ * @return
+ */
+[[nodiscard]] frame_status_e DelimiterFrameFormat::parse(const std::uint8_t* iData, const std::size_t& iSize,
+                                                         const std::size_t& iMaxPayload, frame_layout_t& ioLayout) const {
+  const std::size_t delimiterSize = this->get_delimiter().size();
+  if (delimiterSize == 0) {
+    return FRAME_MALFORMED;
+  }
+  const std::uint8_t first = static_cast<std::uint8_t>(this->get_delimiter().front());
+  std::size_t position = ioLayout.scanned;
+  while (position + delimiterSize <= iSize) {
+    const void* match = std::memchr(iData + position, first, iSize - position - delimiterSize + 1);
+    if (match == nullptr) {
+      break;
+    }
+    position = static_cast<const std::uint8_t*>(match) - iData;
+    if (std::memcmp(iData + position, this->get_delimiter().data(), delimiterSize) == 0) {
+      if (position > iMaxPayload) {
+        return FRAME_TOO_LARGE;
+      }
+      ioLayout.header_size = 0;
+      ioLayout.payload_size = position;
+      ioLayout.trailer_size = delimiterSize;
+      return FRAME_READY;
+    }
+    ++position;
+  }
+  // Keep the last bytes unscanned, they may be the start of a split delimiter
+  ioLayout.scanned = (iSize >= delimiterSize) ? iSize - delimiterSize + 1 : 0;
+  if (ioLayout.scanned > iMaxPayload) {
+    return FRAME_TOO_LARGE;
+  }
+  return FRAME_INCOMPLETE;
+}
+
+/**
+ * @brief Delimited frames carry no header
+ * 
+ * @param iPayloadSize
+ * @param oHeader
+ * @param oHeaderSize
+ * 
+ * @return
+ */
+[[nodiscard]] bool DelimiterFrameFormat::encode_header(const std::size_t& iPayloadSize, std::uint8_t* oHeader,
+                                                       std::size_t& oHeaderSize) const {
+  (void)iPayloadSize;
+  (void)oHeader;
+  oHeaderSize = 0;
+  return !this->get_delimiter().empty();
+}
+
+/**
+ * @brief The delimiter itself
+ * 
+ * @return
+ */
+[[nodiscard]] frame_view_t DelimiterFrameFormat::trailer(void) const {
+  return {reinterpret_cast<const std::uint8_t*>(this->get_delimiter().data()), this->get_delimiter().size()};
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] const std::string& DelimiterFrameFormat::get_delimiter(void) const {
+  return this->delimiter_;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+/**
+ * @brief Destructor
+ */
+DelimiterFrameFormat::~DelimiterFrameFormat() {}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PROTECTED METHODS **/
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PRIVATE METHODS **/
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+} // namespace frame
+} // namespace ncs
@@ -0,0 +1,141 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file FixedFrameFormat.cpp
+ *
+ * @brief
+ */
+
+
+#include <FixedFrameFormat.h>
+
+#include <limits>
+
+
+namespace ncs { // Network Communications System
+namespace frame { // Network Communications System Framing
+
+
+/** PUBLIC METHODS **/
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+/**
+ * @brief Default constructor
+ */
+FixedFrameFormat::FixedFrameFormat(void) {}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Locates the frame placed at the beginning of iData
+ * 
+ * @param iData
+ * @param iSize
+ * @param iMaxPayload
+ * @param ioLayout
+ * 
+ * @return
+ */
+[[nodiscard]] frame_status_e FixedFrameFormat::parse(const std::uint8_t* iData, const std::size_t& iSize,
+                                                     const std::size_t& iMaxPayload, frame_layout_t& ioLayout) const {
+  if (iSize < FIXED_FRAME_HEADER_SIZE) {
+    return FRAME_INCOMPLETE;
+  }
+  const std::size_t length = (static_cast<std::size_t>(iData[0]) << 24) | (static_cast<std::size_t>(iData[1]) << 16) |
+                             (static_cast<std::size_t>(iData[2]) <<  8) |  static_cast<std::size_t>(iData[3]);
+  if (length > iMaxPayload) {
+    return FRAME_TOO_LARGE;
+  }
+  ioLayout.header_size = FIXED_FRAME_HEADER_SIZE;
+  ioLayout.payload_size = length;
+  ioLayout.trailer_size = 0;
+  return (iSize - FIXED_FRAME_HEADER_SIZE >= length) ? FRAME_READY : FRAME_INCOMPLETE;
+}
+
+/**
+ * @brief Writes the 4-byte length announcing a payload of iPayloadSize bytes
+ * 
+ * @param iPayloadSize
+ * @param oHeader
+ * @param oHeaderSize
+ * 
+ * @return
+ */
+[[nodiscard]] bool FixedFrameFormat::encode_header(const std::size_t& iPayloadSize, std::uint8_t* oHeader,
+                                                   std::size_t& oHeaderSize) const {
+  if (iPayloadSize > std::numeric_limits<std::uint32_t>::max()) {
+    return false;
+  }
+  oHeader[0] = static_cast<std::uint8_t>(iPayloadSize >> 24);
+  oHeader[1] = static_cast<std::uint8_t>(iPayloadSize >> 16);
+  oHeader[2] = static_cast<std::uint8_t>(iPayloadSize >>  8);
+  oHeader[3] = static_cast<std::uint8_t>(iPayloadSize);
+  oHeaderSize = FIXED_FRAME_HEADER_SIZE;
+  return true;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+/**
+ * @brief Destructor
+ */
+FixedFrameFormat::~FixedFrameFormat() {}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PROTECTED METHODS **/
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PRIVATE METHODS **/
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+} // namespace frame
+} // namespace ncs
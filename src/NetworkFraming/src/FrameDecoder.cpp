@@ -0,0 +1,227 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file FrameDecoder.cpp
+ *
+ * @brief
+ */
+
+
+#include <FrameDecoder.h>
+
+#include <algorithm>
+#include <cstring>
+
+
+namespace ncs { // Network Communications System
+namespace frame { // Network Communications System Framing
+
+
+/** PUBLIC METHODS **/
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+/**
+ * @brief Format constructor
+ * 
+ * @param iFormat
+ * @param iMaxFrameSize
+ */
+FrameDecoder::FrameDecoder(const FrameFormat& iFormat, const std::size_t& iMaxFrameSize)
+    : format_(iFormat), maxFrameSize_(iMaxFrameSize), buffer_(), capacity_(0), head_(0), tail_(0), layout_(), missing_(0) {
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Reserves at least iMinSize writable bytes at the end of the buffered data
+ * 
+ * @param iMinSize
+ * 
+ * @return
+ */
+[[nodiscard]] std::uint8_t* FrameDecoder::prepare(const std::size_t& iMinSize) {
+  if (this->get_writable_size() >= iMinSize) {
+    return this->buffer_.get() + this->tail_;
+  }
+  const std::size_t buffered = this->get_buffered_size();
+  if (this->capacity_ - buffered >= iMinSize) {
+    std::memmove(this->buffer_.get(), this->buffer_.get() + this->head_, buffered);
+  }
+  else {
+    const std::size_t capacity = std::max(this->capacity_ * 2, buffered + iMinSize);
+    std::unique_ptr<std::uint8_t[]> buffer(new std::uint8_t[capacity]);
+    if (buffered > 0) {
+      std::memcpy(buffer.get(), this->buffer_.get() + this->head_, buffered);
+    }
+    this->buffer_ = std::move(buffer);
+    this->capacity_ = capacity;
+  }
+  this->head_ = 0;
+  this->tail_ = buffered;
+  return this->buffer_.get() + this->tail_;
+}
+
+/**
+ * @brief Marks iSize bytes written after prepare() as received
+ * 
+ * @param iSize
+ */
+void FrameDecoder::commit(const std::size_t& iSize) {
+  this->tail_ += std::min(iSize, this->get_writable_size());
+}
+
+/**
+ * @brief Receives directly into the buffer
+ * 
+ * @param iSocket
+ * @param iReadSize
+ * 
+ * @return
+ */
+[[nodiscard]] ssize_t FrameDecoder::read_from(const sock::InternetSocket& iSocket, const std::size_t& iReadSize) {
+  std::uint8_t* destination = this->prepare(std::max(iReadSize, this->get_missing_size()));
+  const ssize_t received = iSocket.recv(destination, this->get_writable_size());
+  if (received > 0) {
+    this->commit(static_cast<std::size_t>(received));
+  }
+  return received;
+}
+
+/**
+ * @brief Extracts the next complete frame from the buffered data
+ * 
+ * @param oFrame
+ * 
+ * @return
+ */
+[[nodiscard]] frame_status_e FrameDecoder::next(frame_view_t& oFrame) {
+  const std::size_t buffered = this->get_buffered_size();
+  const std::uint8_t* begin = this->buffer_.get() + this->head_;
+  const frame_status_e status = this->format_.parse(begin, buffered, this->maxFrameSize_, this->layout_);
+  const std::size_t frameSize = this->layout_.header_size + this->layout_.payload_size + this->layout_.trailer_size;
+  if (status != FRAME_READY) {
+    this->missing_ = (status == FRAME_INCOMPLETE) && (frameSize > buffered) ? frameSize - buffered : 0;
+    return status;
+  }
+  oFrame.data = begin + this->layout_.header_size;
+  oFrame.size = this->layout_.payload_size;
+  this->head_ += frameSize;
+  if (this->head_ == this->tail_) {  // Rewind for free, the bytes are left untouched
+    this->head_ = 0;
+    this->tail_ = 0;
+  }
+  this->layout_ = {};
+  this->missing_ = 0;
+  return FRAME_READY;
+}
+
+/**
+ * @brief Drops every buffered byte
+ */
+void FrameDecoder::clear(void) {
+  this->head_ = 0;
+  this->tail_ = 0;
+  this->layout_ = {};
+  this->missing_ = 0;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] std::size_t FrameDecoder::get_buffered_size(void) const {
+  return this->tail_ - this->head_;
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] std::size_t FrameDecoder::get_writable_size(void) const {
+  return this->capacity_ - this->tail_;
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] std::size_t FrameDecoder::get_missing_size(void) const {
+  return this->missing_;
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] const std::size_t& FrameDecoder::get_max_frame_size(void) const {
+  return this->maxFrameSize_;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+/**
+ * @brief Destructor
+ */
+FrameDecoder::~FrameDecoder() {}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PROTECTED METHODS **/
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PRIVATE METHODS **/
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+} // namespace frame
+} // namespace ncs
@@ -0,0 +1,202 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file FrameEncoder.cpp
+ *
+ * @brief
+ */
+
+
+#include <FrameEncoder.h>
+
+#include <algorithm>
+#include <cerrno>
+
+
+namespace ncs { // Network Communications System
+namespace frame { // Network Communications System Framing
+
+
+/** PUBLIC METHODS **/
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+/**
+ * @brief Format constructor
+ * 
+ * @param iFormat
+ */
+FrameEncoder::FrameEncoder(const FrameFormat& iFormat) : format_(iFormat) {}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Builds the scatter/gather vector of a frame
+ * 
+ * @param iPayload
+ * @param oFrame
+ * 
+ * @return
+ */
+[[nodiscard]] bool FrameEncoder::encode(const frame_view_t& iPayload, encoded_frame_t& oFrame) const {
+  std::size_t headerSize = 0;
+  if (!this->format_.encode_header(iPayload.size, oFrame.header, headerSize)) {
+    return false;
+  }
+  oFrame.iov_count = 0;
+  if (headerSize > 0) {
+    oFrame.iov[oFrame.iov_count++] = {oFrame.header, headerSize};
+  }
+  if (iPayload.size > 0) {
+    oFrame.iov[oFrame.iov_count++] = {const_cast<std::uint8_t*>(iPayload.data), iPayload.size};
+  }
+  const frame_view_t trailer = this->format_.trailer();
+  if (trailer.size > 0) {
+    oFrame.iov[oFrame.iov_count++] = {const_cast<std::uint8_t*>(trailer.data), trailer.size};
+  }
+  oFrame.size = headerSize + iPayload.size + trailer.size;
+  return true;
+}
+
+/**
+ * @brief Sends one frame with a single sendmsg(2)
+ * 
+ * @param iSocket
+ * @param iPayload
+ * 
+ * @return
+ */
+[[nodiscard]] ssize_t FrameEncoder::write_to(const sock::InternetSocket& iSocket, const frame_view_t& iPayload) const {
+  return this->write_to(iSocket, &iPayload, 1);
+}
+
+/**
+ * @brief Sends several frames, gathering up to MAX_FRAMES_PER_WRITE of them per sendmsg(2)
+ * 
+ * @param iSocket
+ * @param iPayloads
+ * @param iCount
+ * 
+ * @return
+ */
+[[nodiscard]] ssize_t FrameEncoder::write_to(const sock::InternetSocket& iSocket, const frame_view_t* iPayloads,
+                                             const std::size_t& iCount) const {
+  encoded_frame_t frames[MAX_FRAMES_PER_WRITE];
+  iovec iov[MAX_FRAMES_PER_WRITE * 3];
+  ssize_t sent = 0;
+  for (std::size_t first = 0; first < iCount; first += MAX_FRAMES_PER_WRITE) {
+    const std::size_t batch = std::min(iCount - first, MAX_FRAMES_PER_WRITE);
+    std::size_t iovCount = 0;
+    for (std::size_t i = 0; i < batch; ++i) {
+      if (!this->encode(iPayloads[first + i], frames[i])) {
+        errno = EMSGSIZE;
+        return (sent > 0) ? sent : -1;
+      }
+      for (std::size_t j = 0; j < frames[i].iov_count; ++j) {
+        iov[iovCount++] = frames[i].iov[j];
+      }
+    }
+    if (!FrameEncoder::send_all(iSocket, iov, iovCount, sent)) {
+      return (sent > 0) ? sent : -1;
+    }
+  }
+  return sent;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+/**
+ * @brief Destructor
+ */
+FrameEncoder::~FrameEncoder() {}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PROTECTED METHODS **/
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PRIVATE METHODS **/
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Sends the whole iovec array, advancing it over short writes
+ * 
+ * @param iSocket
+ * @param ioIov
+ * @param iCount
+ * @param ioSent
+ * 
+ * @return
+ */
+[[nodiscard]] bool FrameEncoder::send_all(const sock::InternetSocket& iSocket, iovec* ioIov, std::size_t iCount,
+                                          ssize_t& ioSent) {
+  while (iCount > 0) {
+    ssize_t written = iSocket.send_v(ioIov, iCount);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    ioSent += written;
+    while ((iCount > 0) && (static_cast<std::size_t>(written) >= ioIov->iov_len)) {
+      written -= ioIov->iov_len;
+      ++ioIov;
+      --iCount;
+    }
+    if (iCount > 0) {
+      ioIov->iov_base = static_cast<std::uint8_t*>(ioIov->iov_base) + written;
+      ioIov->iov_len -= written;
+    }
+  }
+  return true;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+} // namespace frame
+} // namespace ncs
@@ -1,20 +1,20 @@
 /**
  * @copyright Copyright (c) 2023
- * 
+ *
  * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
- * @date 08-08-2024
- * 
- * @file NetworkAddress.cpp
- * 
- * @brief 
+ * @date 19-10-2026
+ *
+ * @file FrameFormat.cpp
+ *
+ * @brief
  */
 
 
-#include <NetworkAddress.h>
+#include <FrameFormat.h>
 
 
 namespace ncs { // Network Communications System
-namespace addr { // Network Communications System Addresses
+namespace frame { // Network Communications System Framing
 
 
 /** PUBLIC METHODS **/
@@ -22,6 +22,14 @@ namespace addr { // Network Communications System Addresses
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Bytes appended after every payload, empty for length prefixed formats
+ * 
+ * @return
+ */
+[[nodiscard]] frame_view_t FrameFormat::trailer(void) const {
+  return {};
+}
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
@@ -38,18 +46,18 @@ namespace addr { // Network Communications System Addresses
 
 /// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
 /**
- * @brief
+ * @brief Destructor
  */
-NetworkAddress::~NetworkAddress() {}
+FrameFormat::~FrameFormat() {}
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-  
+
 
 /** PROTECTED METHODS **/
 /// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
 /**
- * @brief
+ * @brief Default constructor
  */
-NetworkAddress::NetworkAddress(void) {}
+FrameFormat::FrameFormat(void) {}
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
@@ -66,7 +74,7 @@ NetworkAddress::NetworkAddress(void) {}
 
 /// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-  
+
 
 /** PRIVATE METHODS **/
 /// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
@@ -88,5 +96,5 @@ NetworkAddress::NetworkAddress(void) {}
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
-} // namespace addr
-} // namespace ncs
\ No newline at end of file
+} // namespace frame
+} // namespace ncs
@@ -0,0 +1,147 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file VarintFrameFormat.cpp
+ *
+ * @brief
+ */
+
+
+#include <VarintFrameFormat.h>
+
+
+namespace ncs { // Network Communications System
+namespace frame { // Network Communications System Framing
+
+
+/** PUBLIC METHODS **/
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+/**
+ * @brief Default constructor
+ */
+VarintFrameFormat::VarintFrameFormat(void) {}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Locates the frame placed at the beginning of iData
+ * 
+ * @param iData
+ * @param iSize
+ * @param iMaxPayload
+ * @param ioLayout
+ * 
+ * @return
+ */
+[[nodiscard]] frame_status_e VarintFrameFormat::parse(const std::uint8_t* iData, const std::size_t& iSize,
+                                                      const std::size_t& iMaxPayload, frame_layout_t& ioLayout) const {
+  std::uint64_t length = 0;
+  for (std::size_t i = 0; i < MAX_FRAME_HEADER_SIZE; ++i) {
+    if (i == iSize) {
+      return FRAME_INCOMPLETE;
+    }
+    const std::uint8_t byte = iData[i];
+    if ((i == MAX_FRAME_HEADER_SIZE - 1) && (byte > 1)) {  // Would overflow 64 bits
+      return FRAME_MALFORMED;
+    }
+    length |= static_cast<std::uint64_t>(byte & 0x7F) << (7 * i);
+    if (length > iMaxPayload) {  // Later bytes can only make it bigger
+      return FRAME_TOO_LARGE;
+    }
+    if ((byte & 0x80) == 0) {
+      ioLayout.header_size = i + 1;
+      ioLayout.payload_size = length;
+      ioLayout.trailer_size = 0;
+      return (iSize - ioLayout.header_size >= length) ? FRAME_READY : FRAME_INCOMPLETE;
+    }
+  }
+  return FRAME_MALFORMED;
+}
+
+/**
+ * @brief Writes the varint announcing a payload of iPayloadSize bytes
+ * 
+ * @param iPayloadSize
+ * @param oHeader
+ * @param oHeaderSize
+ * 
+ * @return
+ */
+[[nodiscard]] bool VarintFrameFormat::encode_header(const std::size_t& iPayloadSize, std::uint8_t* oHeader,
+                                                    std::size_t& oHeaderSize) const {
+  std::uint64_t length = iPayloadSize;
+  oHeaderSize = 0;
+  while (length >= 0x80) {
+    oHeader[oHeaderSize++] = static_cast<std::uint8_t>(length | 0x80);
+    length >>= 7;
+  }
+  oHeader[oHeaderSize++] = static_cast<std::uint8_t>(length);
+  return true;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+/**
+ * @brief Destructor
+ */
+VarintFrameFormat::~VarintFrameFormat() {}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PROTECTED METHODS **/
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PRIVATE METHODS **/
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+} // namespace frame
+} // namespace ncs
@@ -0,0 +1,184 @@
+/**
+ * @copyright Copyright (c) 2023
+ * 
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ * 
+ * @file FrameDecoder_tests.cpp
+ * 
+ * @brief
+ */
+
+
+#include <FrameCodecTest.h>
+
+#include <gtest/gtest.h>
+
+
+namespace ncs::frame {
+namespace tests {
+
+
+/**
+ * @brief
+ */
+TEST_F(FrameCodecTest, Decode_Single_Frame) {
+  FrameDecoder decoder(varint_);
+  frame_view_t frame;
+  EXPECT_EQ(decoder.next(frame), FRAME_INCOMPLETE);
+
+  feed(decoder, encode_bytes(varint_, "hello"));
+  ASSERT_EQ(decoder.next(frame), FRAME_READY);
+  EXPECT_EQ(to_string(frame), "hello");
+  EXPECT_EQ(decoder.next(frame), FRAME_INCOMPLETE);
+  EXPECT_EQ(decoder.get_buffered_size(), 0u);
+}
+
+/**
+ * @brief
+ */
+TEST_F(FrameCodecTest, Decode_Is_Zero_Copy) {
+  FrameDecoder decoder(fixed_);
+  const std::vector<std::uint8_t> bytes = encode_bytes(fixed_, "payload");
+  std::uint8_t* destination = decoder.prepare(bytes.size());
+  std::copy(bytes.begin(), bytes.end(), destination);
+  decoder.commit(bytes.size());
+
+  frame_view_t frame;
+  ASSERT_EQ(decoder.next(frame), FRAME_READY);
+  EXPECT_EQ(frame.data, destination + FIXED_FRAME_HEADER_SIZE);
+  EXPECT_EQ(to_string(frame), "payload");
+}
+
+/**
+ * @brief
+ */
+TEST_F(FrameCodecTest, Decode_Several_Frames_In_One_Read) {
+  for (const FrameFormat* format : {static_cast<const FrameFormat*>(&varint_), static_cast<const FrameFormat*>(&fixed_),
+                                    static_cast<const FrameFormat*>(&delimiter_)}) {
+    FrameDecoder decoder(*format);
+    std::vector<std::uint8_t> bytes;
+    for (const std::string payload : {"first", "", "third"}) {
+      const std::vector<std::uint8_t> encoded = encode_bytes(*format, payload);
+      bytes.insert(bytes.end(), encoded.begin(), encoded.end());
+    }
+    feed(decoder, bytes);
+
+    frame_view_t first, second, third, fourth;
+    ASSERT_EQ(decoder.next(first), FRAME_READY);
+    ASSERT_EQ(decoder.next(second), FRAME_READY);
+    ASSERT_EQ(decoder.next(third), FRAME_READY);
+    EXPECT_EQ(decoder.next(fourth), FRAME_INCOMPLETE);
+    EXPECT_EQ(to_string(first), "first");
+    EXPECT_EQ(to_string(second), "");
+    EXPECT_EQ(to_string(third), "third");
+  }
+}
+
+/**
+ * @brief
+ */
+TEST_F(FrameCodecTest, Decode_Frames_Split_Across_Reads) {
+  for (const FrameFormat* format : {static_cast<const FrameFormat*>(&varint_), static_cast<const FrameFormat*>(&fixed_),
+                                    static_cast<const FrameFormat*>(&delimiter_)}) {
+    FrameDecoder decoder(*format);
+    const std::string payload(300, 'x');
+    std::vector<std::uint8_t> bytes = encode_bytes(*format, payload);
+    const std::vector<std::uint8_t> next = encode_bytes(*format, "tail");
+    bytes.insert(bytes.end(), next.begin(), next.end());
+
+    std::vector<std::string> decoded;
+    for (const std::uint8_t& byte : bytes) {  // One byte per read
+      feed(decoder, {byte});
+      frame_view_t frame;
+      while (decoder.next(frame) == FRAME_READY) {
+        decoded.push_back(to_string(frame));
+      }
+    }
+    ASSERT_EQ(decoded.size(), 2u);
+    EXPECT_EQ(decoded[0], payload);
+    EXPECT_EQ(decoded[1], "tail");
+  }
+}
+
+/**
+ * @brief
+ */
+TEST_F(FrameCodecTest, Missing_Size_Of_Partial_Frame) {
+  FrameDecoder decoder(fixed_);
+  std::vector<std::uint8_t> bytes = encode_bytes(fixed_, std::string(1000, 'y'));
+  bytes.resize(100);
+  feed(decoder, bytes);
+
+  frame_view_t frame;
+  EXPECT_EQ(decoder.next(frame), FRAME_INCOMPLETE);
+  EXPECT_EQ(decoder.get_missing_size(), FIXED_FRAME_HEADER_SIZE + 1000 - 100);
+}
+
+/**
+ * @brief
+ */
+TEST_F(FrameCodecTest, Enforce_Max_Frame_Size) {
+  frame_view_t frame;
+
+  FrameDecoder varintDecoder(varint_, 16);
+  feed(varintDecoder, encode_bytes(varint_, std::string(17, 'a')));
+  EXPECT_EQ(varintDecoder.next(frame), FRAME_TOO_LARGE);
+
+  FrameDecoder fixedDecoder(fixed_, 16);
+  std::vector<std::uint8_t> header = encode_bytes(fixed_, std::string(17, 'a'));
+  header.resize(FIXED_FRAME_HEADER_SIZE);  // Rejected before the payload arrives
+  feed(fixedDecoder, header);
+  EXPECT_EQ(fixedDecoder.next(frame), FRAME_TOO_LARGE);
+
+  FrameDecoder delimiterDecoder(delimiter_, 16);
+  feed(delimiterDecoder, std::vector<std::uint8_t>(32, 'a'));
+  EXPECT_EQ(delimiterDecoder.next(frame), FRAME_TOO_LARGE);
+
+  FrameDecoder exactDecoder(varint_, 16);
+  feed(exactDecoder, encode_bytes(varint_, std::string(16, 'a')));
+  EXPECT_EQ(exactDecoder.next(frame), FRAME_READY);
+}
+
+/**
+ * @brief
+ */
+TEST_F(FrameCodecTest, Reject_Malformed_Varint) {
+  FrameDecoder decoder(varint_, SIZE_MAX);
+  feed(decoder, std::vector<std::uint8_t>(MAX_FRAME_HEADER_SIZE + 1, 0xFF));
+  frame_view_t frame;
+  EXPECT_EQ(decoder.next(frame), FRAME_MALFORMED);
+}
+
+/**
+ * @brief
+ */
+TEST_F(FrameCodecTest, Delimiter_Split_Across_Reads) {
+  FrameDecoder decoder(delimiter_);
+  frame_view_t frame;
+  feed(decoder, {'a', 'b', '\r'});
+  EXPECT_EQ(decoder.next(frame), FRAME_INCOMPLETE);
+  feed(decoder, {'\n', 'c'});
+  ASSERT_EQ(decoder.next(frame), FRAME_READY);
+  EXPECT_EQ(to_string(frame), "ab");
+  EXPECT_EQ(decoder.next(frame), FRAME_INCOMPLETE);
+  EXPECT_EQ(decoder.get_buffered_size(), 1u);
+}
+
+/**
+ * @brief
+ */
+TEST_F(FrameCodecTest, Read_From_Socket) {
+  FrameDecoder decoder(varint_);
+  const std::vector<std::uint8_t> bytes = encode_bytes(varint_, "over the wire");
+  ASSERT_EQ(writer_.send(bytes.data(), bytes.size()), static_cast<ssize_t>(bytes.size()));
+
+  ASSERT_EQ(decoder.read_from(reader_), static_cast<ssize_t>(bytes.size()));
+  frame_view_t frame;
+  ASSERT_EQ(decoder.next(frame), FRAME_READY);
+  EXPECT_EQ(to_string(frame), "over the wire");
+}
+
+
+} // namespace tests
+} // namespace ncs::frame
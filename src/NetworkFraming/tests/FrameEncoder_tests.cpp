@@ -0,0 +1,94 @@
+/**
+ * @copyright Copyright (c) 2023
+ * 
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ * 
+ * @file FrameEncoder_tests.cpp
+ * 
+ * @brief
+ */
+
+
+#include <FrameCodecTest.h>
+
+#include <gtest/gtest.h>
+
+
+namespace ncs::frame {
+namespace tests {
+
+
+/**
+ * @brief
+ */
+TEST_F(FrameCodecTest, Encode_Does_Not_Copy_Payload) {
+  const std::string payload = "payload";
+  encoded_frame_t frame;
+  ASSERT_TRUE(FrameEncoder(fixed_).encode(to_view(payload), frame));
+  ASSERT_EQ(frame.iov_count, 2u);
+  EXPECT_EQ(frame.iov[0].iov_base, frame.header);
+  EXPECT_EQ(frame.iov[0].iov_len, FIXED_FRAME_HEADER_SIZE);
+  EXPECT_EQ(frame.iov[1].iov_base, payload.data());
+  EXPECT_EQ(frame.size, FIXED_FRAME_HEADER_SIZE + payload.size());
+}
+
+/**
+ * @brief
+ */
+TEST_F(FrameCodecTest, Encode_Headers) {
+  EXPECT_EQ(encode_bytes(varint_, std::string(300, 'a')).size(), 302u);
+  EXPECT_EQ(encode_bytes(varint_, std::string(300, 'a'))[0], 0xAC);
+  EXPECT_EQ(encode_bytes(varint_, std::string(300, 'a'))[1], 0x02);
+  EXPECT_EQ(encode_bytes(varint_, std::string(127, 'a'))[0], 0x7F);
+
+  const std::vector<std::uint8_t> fixed = encode_bytes(fixed_, std::string(258, 'a'));
+  EXPECT_EQ(std::vector<std::uint8_t>(fixed.begin(), fixed.begin() + 4), (std::vector<std::uint8_t>{0, 0, 1, 2}));
+
+  const std::vector<std::uint8_t> delimited = encode_bytes(delimiter_, "line");
+  EXPECT_EQ(std::string(delimited.begin(), delimited.end()), "line\r\n");
+}
+
+/**
+ * @brief
+ */
+TEST_F(FrameCodecTest, Delimiter_Trailer_Is_Not_Copied) {
+  encoded_frame_t frame;
+  ASSERT_TRUE(FrameEncoder(delimiter_).encode(to_view("x"), frame));
+  ASSERT_EQ(frame.iov_count, 2u);
+  EXPECT_EQ(frame.iov[1].iov_base, delimiter_.get_delimiter().data());
+}
+
+/**
+ * @brief
+ */
+TEST_F(FrameCodecTest, Write_Batch_Round_Trip) {
+  for (const FrameFormat* format : {static_cast<const FrameFormat*>(&varint_), static_cast<const FrameFormat*>(&fixed_),
+                                    static_cast<const FrameFormat*>(&delimiter_)}) {
+    std::vector<std::string> payloads;
+    for (std::size_t i = 0; i < MAX_FRAMES_PER_WRITE + 10; ++i) {
+      payloads.push_back("message-" + std::to_string(i));
+    }
+    std::vector<frame_view_t> views;
+    std::size_t expected = 0;
+    for (const std::string& payload : payloads) {
+      views.push_back(to_view(payload));
+      expected += encode_bytes(*format, payload).size();
+    }
+    ASSERT_EQ(FrameEncoder(*format).write_to(writer_, views.data(), views.size()), static_cast<ssize_t>(expected));
+
+    FrameDecoder decoder(*format);
+    std::size_t decoded = 0;
+    while (decoded < payloads.size()) {
+      ASSERT_GT(decoder.read_from(reader_), 0);
+      frame_view_t frame;
+      while (decoder.next(frame) == FRAME_READY) {
+        EXPECT_EQ(to_string(frame), payloads[decoded++]);
+      }
+    }
+  }
+}
+
+
+} // namespace tests
+} // namespace ncs::frame
@@ -0,0 +1,159 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file FrameCodecTest.h
+ *
+ * @brief
+ */
+
+
+#ifndef NCS_FRAME_CODEC_TEST_H
+#define NCS_FRAME_CODEC_TEST_H
+
+
+#include <DelimiterFrameFormat.h>
+#include <FixedFrameFormat.h>
+#include <FrameDecoder.h>
+#include <FrameEncoder.h>
+#include <VarintFrameFormat.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+
+namespace ncs { // Network Communications System
+namespace frame { // Network Communications System Framing
+namespace tests { // Tests
+
+
+/**
+ * @brief
+ */
+class FrameCodecTest : public ::testing::Test {
+public:
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+protected:
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+  /**
+   * @brief Set the Up object
+   */
+  void SetUp() override;
+
+  /**
+   * @brief Tear the Down object
+   */
+  void TearDown() override;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Flattens the scatter/gather vector of an encoded frame
+   * 
+   * @param iFormat
+   * @param iPayload
+   * 
+   * @return
+   */
+  std::vector<std::uint8_t> encode_bytes(const FrameFormat& iFormat, const std::string& iPayload);
+
+  /**
+   * @brief Copies iBytes into the receive buffer of the decoder
+   * 
+   * @param ioDecoder
+   * @param iBytes
+   */
+  void feed(FrameDecoder& ioDecoder, const std::vector<std::uint8_t>& iBytes);
+
+  /**
+   * @brief
+   * 
+   * @param iFrame
+   * 
+   * @return
+   */
+  std::string to_string(const frame_view_t& iFrame);
+
+  /**
+   * @brief
+   * 
+   * @param iText
+   * 
+   * @return
+   */
+  frame_view_t to_view(const std::string& iText);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+protected:
+  VarintFrameFormat varint_;
+  FixedFrameFormat fixed_;
+  DelimiterFrameFormat delimiter_;
+  sock::InternetSocket writer_;
+  sock::InternetSocket reader_;
+};
+
+
+} // namespace tests
+} // namespace frame
+} // namespace ncs
+
+
+#endif // NCS_FRAME_CODEC_TEST_H
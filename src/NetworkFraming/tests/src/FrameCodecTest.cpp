@@ -0,0 +1,162 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file FrameCodecTest.cpp
+ *
+ * @brief
+ */
+
+
+#include <FrameCodecTest.h>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstring>
+
+
+namespace ncs { // Network Communications System
+namespace frame { // Network Communications System Framing
+namespace tests { // Tests
+
+
+/** PUBLIC METHODS **/
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PROTECTED METHODS **/
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+/**
+ * @brief 
+ */
+void FrameCodecTest::SetUp() {
+  int pair[2];
+  ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, pair), 0);
+  writer_.set_sd(pair[0]);
+  reader_.set_sd(pair[1]);
+}
+
+/**
+ * @brief 
+ */
+void FrameCodecTest::TearDown() {
+  writer_.close();
+  reader_.close();
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief 
+ * 
+ * @param iFormat
+ * @param iPayload
+ * 
+ * @return
+ */
+std::vector<std::uint8_t> FrameCodecTest::encode_bytes(const FrameFormat& iFormat, const std::string& iPayload) {
+  std::vector<std::uint8_t> bytes;
+  encoded_frame_t frame;
+  EXPECT_TRUE(FrameEncoder(iFormat).encode(to_view(iPayload), frame));
+  for (std::size_t i = 0; i < frame.iov_count; ++i) {
+    const std::uint8_t* base = static_cast<const std::uint8_t*>(frame.iov[i].iov_base);
+    bytes.insert(bytes.end(), base, base + frame.iov[i].iov_len);
+  }
+  return bytes;
+}
+
+/**
+ * @brief 
+ * 
+ * @param ioDecoder
+ * @param iBytes
+ */
+void FrameCodecTest::feed(FrameDecoder& ioDecoder, const std::vector<std::uint8_t>& iBytes) {
+  std::uint8_t* destination = ioDecoder.prepare(iBytes.size());
+  if (!iBytes.empty()) {
+    std::memcpy(destination, iBytes.data(), iBytes.size());
+  }
+  ioDecoder.commit(iBytes.size());
+}
+
+/**
+ * @brief 
+ * 
+ * @param iFrame
+ * 
+ * @return
+ */
+std::string FrameCodecTest::to_string(const frame_view_t& iFrame) {
+  return std::string(reinterpret_cast<const char*>(iFrame.data), iFrame.size);
+}
+
+/**
+ * @brief 
+ * 
+ * @param iText
+ * 
+ * @return
+ */
+frame_view_t FrameCodecTest::to_view(const std::string& iText) {
+  return {reinterpret_cast<const std::uint8_t*>(iText.data()), iText.size()};
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PRIVATE METHODS **/
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+} // namespace tests
+} // namespace frame
+} // namespace ncs
@@ -0,0 +1,198 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file AcceptMetrics.h
+ *
+ * @brief Activity counters of a single accepting listener
+ */
+
+
+#ifndef NCS_ACCEPT_METRICS_H
+#define NCS_ACCEPT_METRICS_H
+
+
+#include <cstdint>
+
+#include <LatencyHistogram.h>
+#include <MetricCounter.h>
+
+
+namespace ncs { // Network Communications System
+namespace metrics { // Network Communications System Metrics
+
+
+/**
+ * @brief Plain copy of AcceptMetrics, or the sum of several of them
+ */
+struct accept_snapshot_t {
+  std::uint64_t accepted = 0;
+  std::uint64_t batches = 0;
+  std::uint64_t budget_exhausted = 0;     // Batches cut short by the per iteration budget
+  std::uint64_t shed = 0;                 // Connections refused because the process ran out of descriptors
+  std::uint64_t rate_limited = 0;         // Connections refused because their source went over its rate
+  std::uint64_t descriptor_errors = 0;    // EMFILE and ENFILE failures
+  std::uint64_t errors = 0;               // Every other failure
+  std::uint64_t queue_peak = 0;           // Longest accept queue observed
+  std::uint64_t backlog_full = 0;         // Samples that found the accept queue full, the kernel drops SYNs then
+  LatencyHistogram accept_latency;        // Time from readiness to each accept
+};
+
+
+/**
+ * @brief Written only by the thread draining the listener, read by anyone through snapshot()
+ */
+class AcceptMetrics {
+public:
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+  /**
+   * @brief Default constructor
+   */
+  AcceptMetrics(void);
+
+  /**
+   * @brief Copy constructor
+   */
+  AcceptMetrics(const AcceptMetrics& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Accounts for one accepted connection
+   * 
+   * @param iLatencyNs Time since the listener was reported readable
+   */
+  void on_accept(const std::uint64_t& iLatencyNs);
+
+  /**
+   * @brief Accounts for one connection closed right after accepting it because no descriptor was left
+   */
+  void on_shed(void);
+
+  /**
+   * @brief Accounts for one connection closed right after accepting it because its source went over its rate
+   */
+  void on_rate_limited(void);
+
+  /**
+   * @brief Accounts for a failed accept
+   * 
+   * @param iError errno left by the call
+   */
+  void on_error(const int& iError);
+
+  /**
+   * @brief Accounts for one drain of the listener
+   * 
+   * @param iExhausted True if it stopped because the budget ran out while connections were still queued
+   */
+  void on_batch(const bool& iExhausted);
+
+  /**
+   * @brief Accounts for a sample of the accept queue
+   * 
+   * @param iQueued Connections waiting to be accepted
+   * @param iBacklog Queue limit, the kernel drops connections beyond it
+   */
+  void on_backlog(const std::uint64_t& iQueued, const std::uint64_t& iBacklog);
+
+  /**
+   * @brief Adds this listener to an aggregate
+   * 
+   * @param ioTotal
+   */
+  void add_to(accept_snapshot_t& ioTotal) const;
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] accept_snapshot_t snapshot(void) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+  /**
+   * @brief Copy assignment operator
+   */
+  AcceptMetrics& operator=(const AcceptMetrics& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+  /**
+   * @brief Destructor
+   */
+  ~AcceptMetrics();
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+protected:
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+  MetricCounter accepted_;
+  MetricCounter batches_;
+  MetricCounter exhausted_;
+  MetricCounter shed_;
+  MetricCounter rateLimited_;
+  MetricCounter descriptorErrors_;
+  MetricCounter errors_;
+  MetricCounter queuePeak_;
+  MetricCounter backlogFull_;
+  LatencyHistogram acceptLatency_;
+};
+
+
+} // namespace metrics
+} // namespace ncs
+
+
+#endif // NCS_ACCEPT_METRICS_H
@@ -0,0 +1,171 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file ConnectMetrics.h
+ *
+ * @brief Counters of the outbound connections opened through a SourcePortManager
+ */
+
+
+#ifndef NCS_CONNECT_METRICS_H
+#define NCS_CONNECT_METRICS_H
+
+
+#include <cstdint>
+
+#include <LatencyHistogram.h>
+#include <MetricCounter.h>
+
+
+namespace ncs { // Network Communications System
+namespace metrics { // Network Communications System Metrics
+
+
+/**
+ * @brief Plain copy of ConnectMetrics, or the sum of several of them
+ */
+struct connect_snapshot_t {
+  std::uint64_t connected = 0;
+  std::uint64_t exhausted = 0;            // Connects refused with every source out of ports
+  std::uint64_t port_unavailable = 0;     // EADDRNOTAVAIL from the kernel, retried on another source
+  std::uint64_t errors = 0;               // Every other failure
+  LatencyHistogram connect_latency;       // Time taken by each successful bind and connect
+};
+
+
+/**
+ * @brief Written only by the thread opening the connections, read by anyone through snapshot()
+ */
+class ConnectMetrics {
+public:
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+  /**
+   * @brief Default constructor
+   */
+  ConnectMetrics(void);
+
+  /**
+   * @brief Copy constructor
+   */
+  ConnectMetrics(const ConnectMetrics& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Accounts for one established connection
+   * 
+   * @param iLatencyNs Time taken by bind(2) and connect(2)
+   */
+  void on_connect(const std::uint64_t& iLatencyNs);
+
+  /**
+   * @brief Accounts for a connect refused because every source had used up its ports toward the destination
+   */
+  void on_exhausted(void);
+
+  /**
+   * @brief Accounts for a source the kernel found no free port on, the connect moved on to the next source
+   */
+  void on_port_unavailable(void);
+
+  /**
+   * @brief Accounts for any other failure
+   */
+  void on_error(void);
+
+  /**
+   * @brief Adds these connects to an aggregate
+   * 
+   * @param ioTotal
+   */
+  void add_to(connect_snapshot_t& ioTotal) const;
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] connect_snapshot_t snapshot(void) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+  /**
+   * @brief Copy assignment operator
+   */
+  ConnectMetrics& operator=(const ConnectMetrics& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+  /**
+   * @brief Destructor
+   */
+  ~ConnectMetrics();
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+protected:
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+  MetricCounter connected_;
+  MetricCounter exhausted_;
+  MetricCounter portUnavailable_;
+  MetricCounter errors_;
+  LatencyHistogram connectLatency_;
+};
+
+
+} // namespace metrics
+} // namespace ncs
+
+
+#endif // NCS_CONNECT_METRICS_H
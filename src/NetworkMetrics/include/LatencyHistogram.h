@@ -0,0 +1,201 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file LatencyHistogram.h
+ *
+ * @brief Log-linear histogram of latencies in nanoseconds
+ */
+
+
+#ifndef NCS_LATENCY_HISTOGRAM_H
+#define NCS_LATENCY_HISTOGRAM_H
+
+
+#include <cstddef>
+#include <cstdint>
+
+#include <MetricCounter.h>
+
+
+namespace ncs { // Network Communications System
+namespace metrics { // Network Communications System Metrics
+
+
+/**
+ * LatencyHistogram constants
+ */
+constexpr std::size_t HISTOGRAM_SUB_BUCKET_BITS = 3;                                // Linear buckets per power of two (log2)
+constexpr std::size_t HISTOGRAM_SUB_BUCKETS = 1 << HISTOGRAM_SUB_BUCKET_BITS;      // Linear buckets per power of two
+constexpr std::size_t HISTOGRAM_MAX_EXPONENT = 36;                                  // Values from 2^36 ns (~68 s) share the last bucket
+constexpr std::size_t HISTOGRAM_BUCKETS =
+    (HISTOGRAM_MAX_EXPONENT - HISTOGRAM_SUB_BUCKET_BITS + 1) * HISTOGRAM_SUB_BUCKETS;
+
+
+/**
+ * @brief Every power of two is split in HISTOGRAM_SUB_BUCKETS linear buckets, so any recorded value is reported within 12.5%
+ */
+class LatencyHistogram {
+public:
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+  /**
+   * @brief Default constructor
+   */
+  LatencyHistogram(void);
+
+  /**
+   * @brief Copy constructor
+   */
+  LatencyHistogram(const LatencyHistogram& iOther) = default;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Counts one occurrence of iValue
+   * 
+   * @param iValue
+   */
+  void record(const std::uint64_t& iValue);
+
+  /**
+   * @brief Adds every occurrence counted by iOther
+   * 
+   * @param iOther
+   */
+  void merge(const LatencyHistogram& iOther);
+
+  /**
+   * @brief Bucket holding iValue
+   * 
+   * @param iValue
+   * 
+   * @return
+   */
+  [[nodiscard]] static std::size_t bucket_index(const std::uint64_t& iValue);
+
+  /**
+   * @brief Largest value held by a bucket
+   * 
+   * @param iIndex
+   * 
+   * @return
+   */
+  [[nodiscard]] static std::uint64_t bucket_upper(const std::size_t& iIndex);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] std::uint64_t get_count(void) const;
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] std::uint64_t get_sum(void) const;
+
+  /**
+   * @brief
+   * 
+   * @return 0 when empty
+   */
+  [[nodiscard]] std::uint64_t get_min(void) const;
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] std::uint64_t get_max(void) const;
+
+  /**
+   * @brief Value below which iRatio of the occurrences fall
+   * 
+   * @param iRatio Between 0 and 1, 0.99 for the 99th percentile
+   * 
+   * @return 0 when empty
+   */
+  [[nodiscard]] std::uint64_t get_percentile(const double& iRatio) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+  /**
+   * @brief Copy assignment operator
+   */
+  LatencyHistogram& operator=(const LatencyHistogram& iOther) = default;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+  /**
+   * @brief Destructor
+   */
+  ~LatencyHistogram();
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+protected:
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+  MetricCounter buckets_[HISTOGRAM_BUCKETS];
+  MetricCounter count_;
+  MetricCounter sum_;
+  MetricCounter min_;
+  MetricCounter max_;
+};
+
+
+} // namespace metrics
+} // namespace ncs
+
+
+#endif // NCS_LATENCY_HISTOGRAM_H
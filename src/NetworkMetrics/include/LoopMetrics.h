@@ -0,0 +1,162 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file LoopMetrics.h
+ *
+ * @brief Activity counters of a single event loop
+ */
+
+
+#ifndef NCS_LOOP_METRICS_H
+#define NCS_LOOP_METRICS_H
+
+
+#include <cstdint>
+
+#include <LatencyHistogram.h>
+#include <MetricCounter.h>
+
+
+namespace ncs { // Network Communications System
+namespace metrics { // Network Communications System Metrics
+
+
+/**
+ * @brief Plain copy of LoopMetrics, or the sum of several of them
+ */
+struct loop_snapshot_t {
+  std::uint64_t iterations = 0;
+  std::uint64_t idle = 0;             // Iterations that had nothing to do
+  std::uint64_t events = 0;
+  std::uint64_t tasks = 0;
+  std::uint64_t wait_ns = 0;          // Total time blocked waiting for events
+  LatencyHistogram busy_latency;      // Time each iteration spent working
+};
+
+
+/**
+ * @brief Written only by the thread running the loop, read by anyone through snapshot()
+ */
+class LoopMetrics {
+public:
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+  /**
+   * @brief Default constructor
+   */
+  LoopMetrics(void);
+
+  /**
+   * @brief Copy constructor
+   */
+  LoopMetrics(const LoopMetrics& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Accounts for one iteration of the loop
+   * 
+   * @param iEvents Descriptors dispatched
+   * @param iTasks Timers and deferred tasks run
+   * @param iWaitNs Time blocked waiting for events
+   * @param iBusyNs Time spent dispatching and running tasks
+   */
+  void on_iteration(const std::uint64_t& iEvents, const std::uint64_t& iTasks, const std::uint64_t& iWaitNs,
+                    const std::uint64_t& iBusyNs);
+
+  /**
+   * @brief Adds this loop to an aggregate
+   * 
+   * @param ioTotal
+   */
+  void add_to(loop_snapshot_t& ioTotal) const;
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] loop_snapshot_t snapshot(void) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+  /**
+   * @brief Copy assignment operator
+   */
+  LoopMetrics& operator=(const LoopMetrics& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+  /**
+   * @brief Destructor
+   */
+  ~LoopMetrics();
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+protected:
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+  MetricCounter iterations_;
+  MetricCounter idle_;
+  MetricCounter events_;
+  MetricCounter tasks_;
+  MetricCounter waitNs_;
+  LatencyHistogram busyLatency_;
+};
+
+
+} // namespace metrics
+} // namespace ncs
+
+
+#endif // NCS_LOOP_METRICS_H
@@ -0,0 +1,217 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file MetricsRegistry.h
+ *
+ * @brief Aggregates the metrics of every socket and loop for export
+ */
+
+
+#ifndef NCS_METRICS_REGISTRY_H
+#define NCS_METRICS_REGISTRY_H
+
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include <AcceptMetrics.h>
+#include <ConnectMetrics.h>
+#include <LoopMetrics.h>
+#include <SocketMetrics.h>
+
+
+namespace ncs { // Network Communications System
+namespace metrics { // Network Communications System Metrics
+
+
+/**
+ * @brief Aggregate exported by MetricsRegistry
+ */
+struct metrics_snapshot_t {
+  socket_snapshot_t sockets;          // Sum over every socket, including the removed ones
+  loop_snapshot_t loops;              // Sum over every loop, including the removed ones
+  accept_snapshot_t acceptors;        // Sum over every listener, including the removed ones
+  connect_snapshot_t connectors;      // Sum over every source port manager, including the removed ones
+  std::size_t live_sockets = 0;
+  std::size_t live_loops = 0;
+  std::size_t live_acceptors = 0;
+  std::size_t live_connectors = 0;
+};
+
+
+/**
+ * @brief Only registration and snapshots take the lock, the registered metrics are updated without it
+ */
+class MetricsRegistry {
+public:
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+  /**
+   * @brief Default constructor
+   */
+  MetricsRegistry(void);
+
+  /**
+   * @brief Copy constructor
+   */
+  MetricsRegistry(const MetricsRegistry& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Includes iMetrics in the snapshots
+   * 
+   * @param iMetrics Must stay alive until removed
+   */
+  void add(const SocketMetrics& iMetrics);
+
+  /**
+   * @brief Stops tracking iMetrics, its counters stay in the totals
+   * 
+   * @param iMetrics
+   * 
+   * @return False if it was not registered
+   */
+  bool remove(const SocketMetrics& iMetrics);
+
+  /**
+   * @brief Includes iMetrics in the snapshots
+   * 
+   * @param iMetrics Must stay alive until removed
+   */
+  void add(const LoopMetrics& iMetrics);
+
+  /**
+   * @brief Stops tracking iMetrics, its counters stay in the totals
+   * 
+   * @param iMetrics
+   * 
+   * @return False if it was not registered
+   */
+  bool remove(const LoopMetrics& iMetrics);
+
+  /**
+   * @brief Includes iMetrics in the snapshots
+   * 
+   * @param iMetrics Must stay alive until removed
+   */
+  void add(const AcceptMetrics& iMetrics);
+
+  /**
+   * @brief Stops tracking iMetrics, its counters stay in the totals
+   * 
+   * @param iMetrics
+   * 
+   * @return False if it was not registered
+   */
+  bool remove(const AcceptMetrics& iMetrics);
+
+  /**
+   * @brief Includes iMetrics in the snapshots
+   * 
+   * @param iMetrics Must stay alive until removed
+   */
+  void add(const ConnectMetrics& iMetrics);
+
+  /**
+   * @brief Stops tracking iMetrics, its counters stay in the totals
+   * 
+   * @param iMetrics
+   * 
+   * @return False if it was not registered
+   */
+  bool remove(const ConnectMetrics& iMetrics);
+
+  /**
+   * @brief
+   * 
+   * @return Totals of everything ever registered
+   */
+  [[nodiscard]] metrics_snapshot_t snapshot(void) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+  /**
+   * @brief Copy assignment operator
+   */
+  MetricsRegistry& operator=(const MetricsRegistry& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+  /**
+   * @brief Destructor
+   */
+  ~MetricsRegistry();
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+protected:
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+  mutable std::mutex mutex_;
+  std::vector<const SocketMetrics*> sockets_;
+  std::vector<const LoopMetrics*> loops_;
+  std::vector<const AcceptMetrics*> acceptors_;
+  std::vector<const ConnectMetrics*> connectors_;
+  socket_snapshot_t retiredSockets_;
+  loop_snapshot_t retiredLoops_;
+  accept_snapshot_t retiredAcceptors_;
+  connect_snapshot_t retiredConnectors_;
+};
+
+
+} // namespace metrics
+} // namespace ncs
+
+
+#endif // NCS_METRICS_REGISTRY_H
@@ -0,0 +1,208 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file SocketMetrics.h
+ *
+ * @brief Traffic counters and latencies of a single socket
+ */
+
+
+#ifndef NCS_SOCKET_METRICS_H
+#define NCS_SOCKET_METRICS_H
+
+
+#include <sys/types.h>
+
+#include <cstdint>
+
+#include <LatencyHistogram.h>
+#include <MetricCounter.h>
+
+
+namespace ncs { // Network Communications System
+namespace metrics { // Network Communications System Metrics
+
+
+/**
+ * @brief Fields of TCP_INFO worth exporting
+ */
+struct tcp_info_sample_t {
+  std::uint64_t rtt_us = 0;           // Smoothed round trip time
+  std::uint64_t rtt_var_us = 0;       // Round trip time variance
+  std::uint64_t snd_cwnd = 0;         // Congestion window in segments
+  std::uint64_t retransmits = 0;      // Segments currently being retransmitted
+  std::uint64_t total_retrans = 0;    // Retransmissions over the life of the connection
+  std::uint64_t samples = 0;          // Times TCP_INFO has been read
+};
+
+/**
+ * @brief Plain copy of SocketMetrics, or the sum of several of them
+ */
+struct socket_snapshot_t {
+  std::uint64_t bytes_in = 0;
+  std::uint64_t bytes_out = 0;
+  std::uint64_t messages_in = 0;      // Successful receive calls returning data
+  std::uint64_t messages_out = 0;     // Successful send calls
+  std::uint64_t syscalls = 0;
+  std::uint64_t eagain = 0;           // Calls that would have blocked
+  std::uint64_t errors = 0;           // Calls failing for any other reason
+  LatencyHistogram send_latency;
+  LatencyHistogram recv_latency;
+  tcp_info_sample_t tcp;
+};
+
+/**
+ * @brief Monotonic clock used to time the calls
+ * 
+ * @return Nanoseconds
+ */
+[[nodiscard]] std::uint64_t clock_ns(void);
+
+
+/**
+ * @brief Written only by the thread driving the socket, read by anyone through snapshot()
+ */
+class SocketMetrics {
+public:
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+  /**
+   * @brief Default constructor
+   */
+  SocketMetrics(void);
+
+  /**
+   * @brief Copy constructor
+   */
+  SocketMetrics(const SocketMetrics& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Accounts for a send call, errno must still hold its error
+   * 
+   * @param iResult Value returned by the call
+   * @param iLatencyNs Time spent inside the call
+   */
+  void on_send(const ssize_t& iResult, const std::uint64_t& iLatencyNs);
+
+  /**
+   * @brief Accounts for a receive call, errno must still hold its error
+   * 
+   * @param iResult Value returned by the call
+   * @param iLatencyNs Time spent inside the call
+   */
+  void on_recv(const ssize_t& iResult, const std::uint64_t& iLatencyNs);
+
+  /**
+   * @brief Stores the latest kernel view of the connection
+   * 
+   * @param iSample
+   */
+  void on_tcp_info(const tcp_info_sample_t& iSample);
+
+  /**
+   * @brief Adds this socket to an aggregate, gauges keep the largest value
+   * 
+   * @param ioTotal
+   */
+  void add_to(socket_snapshot_t& ioTotal) const;
+
+  /**
+   * @brief
+   * 
+   * @return A consistent enough copy of every counter
+   */
+  [[nodiscard]] socket_snapshot_t snapshot(void) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+  /**
+   * @brief Copy assignment operator
+   */
+  SocketMetrics& operator=(const SocketMetrics& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+  /**
+   * @brief Destructor
+   */
+  ~SocketMetrics();
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+protected:
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+  MetricCounter bytesIn_;
+  MetricCounter bytesOut_;
+  MetricCounter messagesIn_;
+  MetricCounter messagesOut_;
+  MetricCounter syscalls_;
+  MetricCounter eagain_;
+  MetricCounter errors_;
+  LatencyHistogram sendLatency_;
+  LatencyHistogram recvLatency_;
+  MetricCounter rtt_;
+  MetricCounter rttVar_;
+  MetricCounter cwnd_;
+  MetricCounter retransmits_;
+  MetricCounter totalRetrans_;
+  MetricCounter tcpSamples_;
+};
+
+
+} // namespace metrics
+} // namespace ncs
+
+
+#endif // NCS_SOCKET_METRICS_H
@@ -0,0 +1,187 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file AcceptMetrics.cpp
+ *
+ * @brief
+ */
+
+
+#include <AcceptMetrics.h>
+
+#include <algorithm>
+#include <cerrno>
+
+
+namespace ncs { // Network Communications System
+namespace metrics { // Network Communications System Metrics
+
+
+/** PUBLIC METHODS **/
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+/**
+ * @brief Default constructor
+ */
+AcceptMetrics::AcceptMetrics(void) {}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Accounts for one accepted connection
+ * 
+ * @param iLatencyNs
+ */
+void AcceptMetrics::on_accept(const std::uint64_t& iLatencyNs) {
+  this->accepted_.add();
+  this->acceptLatency_.record(iLatencyNs);
+}
+
+/**
+ * @brief Accounts for one shed connection
+ */
+void AcceptMetrics::on_shed(void) {
+  this->shed_.add();
+}
+
+/**
+ * @brief Accounts for one rate limited connection
+ */
+void AcceptMetrics::on_rate_limited(void) {
+  this->rateLimited_.add();
+}
+
+/**
+ * @brief Accounts for a failed accept
+ * 
+ * @param iError
+ */
+void AcceptMetrics::on_error(const int& iError) {
+  if ((iError == EMFILE) || (iError == ENFILE)) {
+    this->descriptorErrors_.add();
+  } else {
+    this->errors_.add();
+  }
+}
+
+/**
+ * @brief Accounts for one drain of the listener
+ * 
+ * @param iExhausted
+ */
+void AcceptMetrics::on_batch(const bool& iExhausted) {
+  this->batches_.add();
+  if (iExhausted) {
+    this->exhausted_.add();
+  }
+}
+
+/**
+ * @brief Accounts for a sample of the accept queue
+ * 
+ * @param iQueued
+ * @param iBacklog
+ */
+void AcceptMetrics::on_backlog(const std::uint64_t& iQueued, const std::uint64_t& iBacklog) {
+  if (iQueued > this->queuePeak_.get()) {
+    this->queuePeak_.set(iQueued);
+  }
+  if ((iBacklog > 0) && (iQueued >= iBacklog)) {
+    this->backlogFull_.add();
+  }
+}
+
+/**
+ * @brief Adds this listener to an aggregate
+ * 
+ * @param ioTotal
+ */
+void AcceptMetrics::add_to(accept_snapshot_t& ioTotal) const {
+  ioTotal.accepted += this->accepted_.get();
+  ioTotal.batches += this->batches_.get();
+  ioTotal.budget_exhausted += this->exhausted_.get();
+  ioTotal.shed += this->shed_.get();
+  ioTotal.rate_limited += this->rateLimited_.get();
+  ioTotal.descriptor_errors += this->descriptorErrors_.get();
+  ioTotal.errors += this->errors_.get();
+  ioTotal.queue_peak = std::max(ioTotal.queue_peak, this->queuePeak_.get());
+  ioTotal.backlog_full += this->backlogFull_.get();
+  ioTotal.accept_latency.merge(this->acceptLatency_);
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] accept_snapshot_t AcceptMetrics::snapshot(void) const {
+  accept_snapshot_t snapshot;
+  this->add_to(snapshot);
+  return snapshot;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+/**
+ * @brief Destructor
+ */
+AcceptMetrics::~AcceptMetrics() {}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PROTECTED METHODS **/
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PRIVATE METHODS **/
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+} // namespace metrics
+} // namespace ncs
@@ -0,0 +1,226 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file LatencyHistogram.cpp
+ *
+ * @brief
+ */
+
+
+#include <LatencyHistogram.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+namespace ncs { // Network Communications System
+namespace metrics { // Network Communications System Metrics
+
+
+/** PUBLIC METHODS **/
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+/**
+ * @brief Default constructor
+ */
+LatencyHistogram::LatencyHistogram(void) : buckets_(), count_(), sum_(), min_(), max_() {
+  this->min_.set(std::numeric_limits<std::uint64_t>::max());
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Counts one occurrence of iValue
+ * 
+ * @param iValue
+ */
+void LatencyHistogram::record(const std::uint64_t& iValue) {
+  this->buckets_[bucket_index(iValue)].add();
+  this->count_.add();
+  this->sum_.add(iValue);
+  if (iValue < this->min_.get()) {
+    this->min_.set(iValue);
+  }
+  if (iValue > this->max_.get()) {
+    this->max_.set(iValue);
+  }
+}
+
+/**
+ * @brief Adds every occurrence counted by iOther
+ * 
+ * @param iOther
+ */
+void LatencyHistogram::merge(const LatencyHistogram& iOther) {
+  if (iOther.count_.get() == 0) {
+    return;
+  }
+  for (std::size_t i = 0; i < HISTOGRAM_BUCKETS; ++i) {
+    this->buckets_[i].add(iOther.buckets_[i].get());
+  }
+  this->count_.add(iOther.count_.get());
+  this->sum_.add(iOther.sum_.get());
+  this->min_.set(std::min(this->min_.get(), iOther.min_.get()));
+  this->max_.set(std::max(this->max_.get(), iOther.max_.get()));
+}
+
+/**
+ * @brief Bucket holding iValue
+ * 
+ * @param iValue
+ * 
+ * @return
+ */
+[[nodiscard]] std::size_t LatencyHistogram::bucket_index(const std::uint64_t& iValue) {
+  if (iValue < HISTOGRAM_SUB_BUCKETS) {
+    return static_cast<std::size_t>(iValue);
+  }
+  const std::size_t exponent = 63 - static_cast<std::size_t>(__builtin_clzll(iValue));
+  if (exponent >= HISTOGRAM_MAX_EXPONENT) {
+    return HISTOGRAM_BUCKETS - 1;
+  }
+  const std::size_t shift = exponent - HISTOGRAM_SUB_BUCKET_BITS;
+  return (shift + 1) * HISTOGRAM_SUB_BUCKETS + static_cast<std::size_t>((iValue >> shift) & (HISTOGRAM_SUB_BUCKETS - 1));
+}
+
+/**
+ * @brief Largest value held by a bucket
+ * 
+ * @param iIndex
+ * 
+ * @return
+ */
+[[nodiscard]] std::uint64_t LatencyHistogram::bucket_upper(const std::size_t& iIndex) {
+  if (iIndex < HISTOGRAM_SUB_BUCKETS) {
+    return iIndex;
+  }
+  const std::size_t shift = iIndex / HISTOGRAM_SUB_BUCKETS - 1;
+  const std::uint64_t sub = HISTOGRAM_SUB_BUCKETS + iIndex % HISTOGRAM_SUB_BUCKETS;
+  return ((sub + 1) << shift) - 1;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] std::uint64_t LatencyHistogram::get_count(void) const {
+  return this->count_.get();
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] std::uint64_t LatencyHistogram::get_sum(void) const {
+  return this->sum_.get();
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] std::uint64_t LatencyHistogram::get_min(void) const {
+  return (this->count_.get() == 0) ? 0 : this->min_.get();
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] std::uint64_t LatencyHistogram::get_max(void) const {
+  return this->max_.get();
+}
+
+/**
+ * @brief Value below which iRatio of the occurrences fall
+ * 
+ * @param iRatio
+ * 
+ * @return
+ */
+[[nodiscard]] std::uint64_t LatencyHistogram::get_percentile(const double& iRatio) const {
+  const std::uint64_t count = this->count_.get();
+  if (count == 0) {
+    return 0;
+  }
+  const double ratio = std::clamp(iRatio, 0.0, 1.0);
+  const std::uint64_t rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(ratio * count)));
+  std::uint64_t seen = 0;
+  for (std::size_t i = 0; i < HISTOGRAM_BUCKETS; ++i) {
+    seen += this->buckets_[i].get();
+    if (seen >= rank) {
+      return std::clamp(bucket_upper(i), this->get_min(), this->get_max());
+    }
+  }
+  return this->get_max();
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+/**
+ * @brief Destructor
+ */
+LatencyHistogram::~LatencyHistogram() {}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PROTECTED METHODS **/
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PRIVATE METHODS **/
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+} // namespace metrics
+} // namespace ncs
@@ -0,0 +1,240 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file MetricsRegistry.cpp
+ *
+ * @brief
+ */
+
+
+#include <MetricsRegistry.h>
+
+#include <algorithm>
+
+
+namespace ncs { // Network Communications System
+namespace metrics { // Network Communications System Metrics
+
+
+/** PUBLIC METHODS **/
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+/**
+ * @brief Default constructor
+ */
+MetricsRegistry::MetricsRegistry(void) {}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Includes iMetrics in the snapshots
+ * 
+ * @param iMetrics
+ */
+void MetricsRegistry::add(const SocketMetrics& iMetrics) {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  this->sockets_.push_back(&iMetrics);
+}
+
+/**
+ * @brief Stops tracking iMetrics
+ * 
+ * @param iMetrics
+ * 
+ * @return
+ */
+bool MetricsRegistry::remove(const SocketMetrics& iMetrics) {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  auto metrics = std::find(this->sockets_.begin(), this->sockets_.end(), &iMetrics);
+  if (metrics == this->sockets_.end()) {
+    return false;
+  }
+  iMetrics.add_to(this->retiredSockets_);
+  *metrics = this->sockets_.back();
+  this->sockets_.pop_back();
+  return true;
+}
+
+/**
+ * @brief Includes iMetrics in the snapshots
+ * 
+ * @param iMetrics
+ */
+void MetricsRegistry::add(const LoopMetrics& iMetrics) {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  this->loops_.push_back(&iMetrics);
+}
+
+/**
+ * @brief Stops tracking iMetrics
+ * 
+ * @param iMetrics
+ * 
+ * @return
+ */
+bool MetricsRegistry::remove(const LoopMetrics& iMetrics) {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  auto metrics = std::find(this->loops_.begin(), this->loops_.end(), &iMetrics);
+  if (metrics == this->loops_.end()) {
+    return false;
+  }
+  iMetrics.add_to(this->retiredLoops_);
+  *metrics = this->loops_.back();
+  this->loops_.pop_back();
+  return true;
+}
+
+/**
+ * @brief Includes iMetrics in the snapshots
+ * 
+ * @param iMetrics
+ */
+void MetricsRegistry::add(const AcceptMetrics& iMetrics) {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  this->acceptors_.push_back(&iMetrics);
+}
+
+/**
+ * @brief Stops tracking iMetrics
+ * 
+ * @param iMetrics
+ * 
+ * @return
+ */
+bool MetricsRegistry::remove(const AcceptMetrics& iMetrics) {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  auto metrics = std::find(this->acceptors_.begin(), this->acceptors_.end(), &iMetrics);
+  if (metrics == this->acceptors_.end()) {
+    return false;
+  }
+  iMetrics.add_to(this->retiredAcceptors_);
+  *metrics = this->acceptors_.back();
+  this->acceptors_.pop_back();
+  return true;
+}
+
+/**
+ * @brief Includes iMetrics in the snapshots
+ * 
+ * @param iMetrics
+ */
+void MetricsRegistry::add(const ConnectMetrics& iMetrics) {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  this->connectors_.push_back(&iMetrics);
+}
+
+/**
+ * @brief Stops tracking iMetrics
+ * 
+ * @param iMetrics
+ * 
+ * @return
+ */
+bool MetricsRegistry::remove(const ConnectMetrics& iMetrics) {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  auto metrics = std::find(this->connectors_.begin(), this->connectors_.end(), &iMetrics);
+  if (metrics == this->connectors_.end()) {
+    return false;
+  }
+  iMetrics.add_to(this->retiredConnectors_);
+  *metrics = this->connectors_.back();
+  this->connectors_.pop_back();
+  return true;
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] metrics_snapshot_t MetricsRegistry::snapshot(void) const {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  metrics_snapshot_t snapshot;
+  snapshot.sockets = this->retiredSockets_;
+  snapshot.loops = this->retiredLoops_;
+  snapshot.acceptors = this->retiredAcceptors_;
+  snapshot.connectors = this->retiredConnectors_;
+  for (const SocketMetrics* metrics : this->sockets_) {
+    metrics->add_to(snapshot.sockets);
+  }
+  for (const LoopMetrics* metrics : this->loops_) {
+    metrics->add_to(snapshot.loops);
+  }
+  for (const AcceptMetrics* metrics : this->acceptors_) {
+    metrics->add_to(snapshot.acceptors);
+  }
+  for (const ConnectMetrics* metrics : this->connectors_) {
+    metrics->add_to(snapshot.connectors);
+  }
+  snapshot.live_sockets = this->sockets_.size();
+  snapshot.live_loops = this->loops_.size();
+  snapshot.live_acceptors = this->acceptors_.size();
+  snapshot.live_connectors = this->connectors_.size();
+  return snapshot;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+/**
+ * @brief Destructor
+ */
+MetricsRegistry::~MetricsRegistry() {}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PROTECTED METHODS **/
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PRIVATE METHODS **/
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+} // namespace metrics
+} // namespace ncs
@@ -0,0 +1,196 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file SocketMetrics.cpp
+ *
+ * @brief
+ */
+
+
+#include <SocketMetrics.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+
+
+namespace ncs { // Network Communications System
+namespace metrics { // Network Communications System Metrics
+
+
+/**
+ * @brief Monotonic clock used to time the calls
+ * 
+ * @return
+ */
+[[nodiscard]] std::uint64_t clock_ns(void) {
+  return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+
+/** PUBLIC METHODS **/
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+/**
+ * @brief Default constructor
+ */
+SocketMetrics::SocketMetrics(void) {}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Accounts for a send call
+ * 
+ * @param iResult
+ * @param iLatencyNs
+ */
+void SocketMetrics::on_send(const ssize_t& iResult, const std::uint64_t& iLatencyNs) {
+  this->syscalls_.add();
+  if (iResult >= 0) {
+    this->messagesOut_.add();
+    this->bytesOut_.add(static_cast<std::uint64_t>(iResult));
+    this->sendLatency_.record(iLatencyNs);
+  }
+  else if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
+    this->eagain_.add();
+  }
+  else {
+    this->errors_.add();
+  }
+}
+
+/**
+ * @brief Accounts for a receive call
+ * 
+ * @param iResult
+ * @param iLatencyNs
+ */
+void SocketMetrics::on_recv(const ssize_t& iResult, const std::uint64_t& iLatencyNs) {
+  this->syscalls_.add();
+  if (iResult > 0) {
+    this->messagesIn_.add();
+    this->bytesIn_.add(static_cast<std::uint64_t>(iResult));
+    this->recvLatency_.record(iLatencyNs);
+  }
+  else if ((iResult < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK))) {
+    this->eagain_.add();
+  }
+  else if (iResult < 0) {
+    this->errors_.add();
+  }
+}
+
+/**
+ * @brief Stores the latest kernel view of the connection
+ * 
+ * @param iSample
+ */
+void SocketMetrics::on_tcp_info(const tcp_info_sample_t& iSample) {
+  this->rtt_.set(iSample.rtt_us);
+  this->rttVar_.set(iSample.rtt_var_us);
+  this->cwnd_.set(iSample.snd_cwnd);
+  this->retransmits_.set(iSample.retransmits);
+  this->totalRetrans_.set(iSample.total_retrans);
+  this->tcpSamples_.add();
+}
+
+/**
+ * @brief Adds this socket to an aggregate
+ * 
+ * @param ioTotal
+ */
+void SocketMetrics::add_to(socket_snapshot_t& ioTotal) const {
+  ioTotal.bytes_in += this->bytesIn_.get();
+  ioTotal.bytes_out += this->bytesOut_.get();
+  ioTotal.messages_in += this->messagesIn_.get();
+  ioTotal.messages_out += this->messagesOut_.get();
+  ioTotal.syscalls += this->syscalls_.get();
+  ioTotal.eagain += this->eagain_.get();
+  ioTotal.errors += this->errors_.get();
+  ioTotal.send_latency.merge(this->sendLatency_);
+  ioTotal.recv_latency.merge(this->recvLatency_);
+  ioTotal.tcp.rtt_us = std::max(ioTotal.tcp.rtt_us, this->rtt_.get());
+  ioTotal.tcp.rtt_var_us = std::max(ioTotal.tcp.rtt_var_us, this->rttVar_.get());
+  ioTotal.tcp.snd_cwnd = std::max(ioTotal.tcp.snd_cwnd, this->cwnd_.get());
+  ioTotal.tcp.retransmits += this->retransmits_.get();
+  ioTotal.tcp.total_retrans += this->totalRetrans_.get();
+  ioTotal.tcp.samples += this->tcpSamples_.get();
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] socket_snapshot_t SocketMetrics::snapshot(void) const {
+  socket_snapshot_t snapshot;
+  this->add_to(snapshot);
+  return snapshot;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+/**
+ * @brief Destructor
+ */
+SocketMetrics::~SocketMetrics() {}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PROTECTED METHODS **/
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PRIVATE METHODS **/
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+} // namespace metrics
+} // namespace ncs
@@ -0,0 +1,74 @@
+/**
+ * @copyright Copyright (c) 2023
+ * 
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ * 
+ * @file LatencyHistogram_tests.cpp
+ * 
+ * @brief
+ */
+
+
+#include <LatencyHistogram.h>
+
+#include <gtest/gtest.h>
+
+
+namespace ncs::metrics {
+namespace tests {
+
+
+/**
+ * @brief
+ */
+TEST(LatencyHistogramTest, Buckets_Bound_The_Relative_Error) {
+  for (std::uint64_t value = 0; value < (1u << 20); value = value * 5 / 4 + 1) {
+    const std::size_t index = LatencyHistogram::bucket_index(value);
+    ASSERT_LT(index, HISTOGRAM_BUCKETS);
+    EXPECT_GE(LatencyHistogram::bucket_upper(index), value);
+    EXPECT_LE(LatencyHistogram::bucket_upper(index) - value, value / HISTOGRAM_SUB_BUCKETS);
+    if (index > 0) {
+      EXPECT_LT(LatencyHistogram::bucket_upper(index - 1), value);
+    }
+  }
+  EXPECT_EQ(LatencyHistogram::bucket_index(~0ull), HISTOGRAM_BUCKETS - 1);
+}
+
+/**
+ * @brief
+ */
+TEST(LatencyHistogramTest, Percentiles) {
+  LatencyHistogram histogram;
+  EXPECT_EQ(histogram.get_percentile(0.5), 0u);
+  for (std::uint64_t value = 1; value <= 1000; ++value) {
+    histogram.record(value * 1000);
+  }
+  EXPECT_EQ(histogram.get_count(), 1000u);
+  EXPECT_EQ(histogram.get_min(), 1000u);
+  EXPECT_EQ(histogram.get_max(), 1000000u);
+  EXPECT_NEAR(static_cast<double>(histogram.get_percentile(0.5)), 500000.0, 500000.0 / HISTOGRAM_SUB_BUCKETS);
+  EXPECT_NEAR(static_cast<double>(histogram.get_percentile(0.99)), 990000.0, 990000.0 / HISTOGRAM_SUB_BUCKETS);
+  EXPECT_EQ(histogram.get_percentile(1.0), 1000000u);
+}
+
+/**
+ * @brief
+ */
+TEST(LatencyHistogramTest, Merge) {
+  LatencyHistogram low;
+  LatencyHistogram high;
+  low.record(10);
+  high.record(100000);
+  high.record(200000);
+  low.merge(high);
+  EXPECT_EQ(low.get_count(), 3u);
+  EXPECT_EQ(low.get_sum(), 300010u);
+  EXPECT_EQ(low.get_min(), 10u);
+  EXPECT_EQ(low.get_max(), 200000u);
+  EXPECT_EQ(low.get_percentile(0.3), 10u);
+}
+
+
+} // namespace tests
+} // namespace ncs::metrics
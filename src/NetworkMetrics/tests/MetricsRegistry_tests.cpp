@@ -0,0 +1,158 @@
+/**
+ * @copyright Copyright (c) 2023
+ * 
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ * 
+ * @file MetricsRegistry_tests.cpp
+ * 
+ * @brief
+ */
+
+
+#include <MetricsTest.h>
+
+#include <gtest/gtest.h>
+
+#include <cerrno>
+#include <thread>
+
+
+namespace ncs::metrics {
+namespace tests {
+
+
+/**
+ * @brief
+ */
+TEST_F(MetricsTest, Socket_Counters) {
+  simulate_traffic(socket_, 10, 100);
+  errno = EAGAIN;
+  socket_.on_send(-1, 0);
+  errno = ECONNRESET;
+  socket_.on_recv(-1, 0);
+  socket_.on_recv(0, 0);
+
+  const socket_snapshot_t snapshot = socket_.snapshot();
+  EXPECT_EQ(snapshot.bytes_out, 1000u);
+  EXPECT_EQ(snapshot.bytes_in, 1000u);
+  EXPECT_EQ(snapshot.messages_out, 10u);
+  EXPECT_EQ(snapshot.messages_in, 10u);
+  EXPECT_EQ(snapshot.syscalls, 23u);
+  EXPECT_EQ(snapshot.eagain, 1u);
+  EXPECT_EQ(snapshot.errors, 1u);
+  EXPECT_EQ(snapshot.send_latency.get_count(), 10u);
+  EXPECT_EQ(snapshot.recv_latency.get_max(), 10u);
+}
+
+/**
+ * @brief
+ */
+TEST_F(MetricsTest, Snapshot_Keeps_Removed_Sockets) {
+  SocketMetrics other;
+  registry_.add(other);
+  simulate_traffic(socket_, 5, 10);
+  simulate_traffic(other, 3, 10);
+  other.on_tcp_info({200, 50, 10, 0, 2, 0});
+  loop_.on_iteration(2, 1, 1000, 500);
+
+  metrics_snapshot_t snapshot = registry_.snapshot();
+  EXPECT_EQ(snapshot.live_sockets, 2u);
+  EXPECT_EQ(snapshot.sockets.bytes_out, 80u);
+  EXPECT_EQ(snapshot.sockets.tcp.rtt_us, 200u);
+  EXPECT_EQ(snapshot.sockets.tcp.total_retrans, 2u);
+  EXPECT_EQ(snapshot.loops.events, 2u);
+
+  EXPECT_TRUE(registry_.remove(other));
+  EXPECT_FALSE(registry_.remove(other));
+  snapshot = registry_.snapshot();
+  EXPECT_EQ(snapshot.live_sockets, 1u);
+  EXPECT_EQ(snapshot.sockets.bytes_out, 80u);
+  EXPECT_EQ(snapshot.sockets.send_latency.get_count(), 8u);
+}
+
+/**
+ * @brief
+ */
+TEST_F(MetricsTest, Accept_Counters) {
+  AcceptMetrics acceptor;
+  registry_.add(acceptor);
+  acceptor.on_backlog(12, 16);
+  acceptor.on_backlog(16, 16);
+  acceptor.on_backlog(3, 16);
+  for (std::uint64_t latency = 1; latency <= 4; ++latency) {
+    acceptor.on_accept(latency);
+  }
+  acceptor.on_error(EMFILE);
+  acceptor.on_shed();
+  acceptor.on_rate_limited();
+  acceptor.on_error(ECONNABORTED);
+  acceptor.on_batch(true);
+  acceptor.on_batch(false);
+
+  metrics_snapshot_t snapshot = registry_.snapshot();
+  EXPECT_EQ(snapshot.live_acceptors, 1u);
+  EXPECT_EQ(snapshot.acceptors.accepted, 4u);
+  EXPECT_EQ(snapshot.acceptors.batches, 2u);
+  EXPECT_EQ(snapshot.acceptors.budget_exhausted, 1u);
+  EXPECT_EQ(snapshot.acceptors.shed, 1u);
+  EXPECT_EQ(snapshot.acceptors.rate_limited, 1u);
+  EXPECT_EQ(snapshot.acceptors.descriptor_errors, 1u);
+  EXPECT_EQ(snapshot.acceptors.errors, 1u);
+  EXPECT_EQ(snapshot.acceptors.queue_peak, 16u);
+  EXPECT_EQ(snapshot.acceptors.backlog_full, 1u);
+  EXPECT_EQ(snapshot.acceptors.accept_latency.get_max(), 4u);
+
+  EXPECT_TRUE(registry_.remove(acceptor));
+  snapshot = registry_.snapshot();
+  EXPECT_EQ(snapshot.live_acceptors, 0u);
+  EXPECT_EQ(snapshot.acceptors.accepted, 4u);
+}
+
+/**
+ * @brief
+ */
+TEST_F(MetricsTest, Connect_Counters) {
+  ConnectMetrics connector;
+  registry_.add(connector);
+  connector.on_connect(10);
+  connector.on_connect(30);
+  connector.on_port_unavailable();
+  connector.on_exhausted();
+  connector.on_error();
+
+  metrics_snapshot_t snapshot = registry_.snapshot();
+  EXPECT_EQ(snapshot.live_connectors, 1u);
+  EXPECT_EQ(snapshot.connectors.connected, 2u);
+  EXPECT_EQ(snapshot.connectors.port_unavailable, 1u);
+  EXPECT_EQ(snapshot.connectors.exhausted, 1u);
+  EXPECT_EQ(snapshot.connectors.errors, 1u);
+  EXPECT_EQ(snapshot.connectors.connect_latency.get_max(), 30u);
+
+  EXPECT_TRUE(registry_.remove(connector));
+  EXPECT_FALSE(registry_.remove(connector));
+  snapshot = registry_.snapshot();
+  EXPECT_EQ(snapshot.live_connectors, 0u);
+  EXPECT_EQ(snapshot.connectors.connected, 2u);
+}
+
+/**
+ * @brief
+ */
+TEST_F(MetricsTest, Snapshot_While_Recording) {
+  std::thread writer([this]() {
+    simulate_traffic(socket_, 100000, 1);
+  });
+  std::uint64_t last = 0;
+  for (int i = 0; i < 100; ++i) {
+    const std::uint64_t current = registry_.snapshot().sockets.bytes_out;
+    EXPECT_GE(current, last);
+    last = current;
+  }
+  writer.join();
+  EXPECT_EQ(registry_.snapshot().sockets.bytes_out, 100000u);
+}
+
+
+} // namespace tests
+} // namespace ncs::metrics
@@ -0,0 +1,198 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file TlsContext.h
+ *
+ * @brief Shared TLS configuration, one per role and certificate
+ */
+
+
+#ifndef NCS_TLS_CONTEXT_H
+#define NCS_TLS_CONTEXT_H
+
+
+#include <string>
+
+#include <openssl/ssl.h>
+
+
+namespace ncs { // Network Communications System
+namespace tls { // Network Communications System Transport Layer Security
+
+
+/**
+ * TlsContext types
+ */
+enum tls_role_e {
+  TLS_CLIENT,     // Connects and verifies the server
+  TLS_SERVER      // Accepts and presents a certificate
+};
+
+
+/**
+ * @brief Owns the OpenSSL context every TlsSession of a listener or client is created from
+ */
+class TlsContext {
+public:
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+  /**
+   * @brief Role constructor, TLS 1.2 is the lowest version negotiated
+   * 
+   * @param iRole
+   */
+  explicit TlsContext(const tls_role_e& iRole);
+
+  /**
+   * @brief Copy constructor
+   */
+  TlsContext(const TlsContext& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Loads a PEM certificate chain and its private key
+   * 
+   * @param iCertificateFile
+   * @param iKeyFile
+   * 
+   * @return False if either can not be loaded or they do not match
+   */
+  [[nodiscard]] bool use_certificate(const std::string& iCertificateFile, const std::string& iKeyFile);
+
+  /**
+   * @brief Generates a throwaway P-256 key and a self signed certificate, meant for tests and benchmarks
+   * 
+   * @param iCommonName
+   * 
+   * @return
+   */
+  [[nodiscard]] bool use_self_signed(const std::string& iCommonName);
+
+  /**
+   * @brief Trusts the PEM certificates in iCaFile and starts verifying the peer
+   * 
+   * @param iCaFile
+   * 
+   * @return
+   */
+  [[nodiscard]] bool trust(const std::string& iCaFile);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+  /**
+   * @brief Enables or disables peer certificate verification, enabled by default for clients
+   * 
+   * Client sessions verifying the peer must be given the host the certificate is checked against
+   * 
+   * @param iVerify
+   */
+  void set_verify_peer(const bool& iVerify);
+
+  /**
+   * @brief Hands the record layer to the kernel after every handshake, enabled by default
+   * 
+   * Enabling it also stops the server from sending session tickets, which would advance the record sequence
+   * before the keys are installed
+   * 
+   * @param iEnabled
+   */
+  void set_ktls(const bool& iEnabled);
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] const bool& get_ktls(void) const;
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] const tls_role_e& get_role(void) const;
+
+  /**
+   * @brief Underlying context, for settings not covered here
+   * 
+   * @return Null if OpenSSL could not create it
+   */
+  [[nodiscard]] SSL_CTX* get_native(void) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+  /**
+   * @brief Copy assignment operator
+   */
+  TlsContext& operator=(const TlsContext& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+  /**
+   * @brief Destructor
+   */
+  ~TlsContext();
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+protected:
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+  tls_role_e role_;
+  bool ktls_;
+  SSL_CTX* context_;
+};
+
+
+} // namespace tls
+} // namespace ncs
+
+
+#endif // NCS_TLS_CONTEXT_H
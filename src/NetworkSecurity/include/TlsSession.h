@@ -0,0 +1,259 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file TlsSession.h
+ *
+ * @brief TLS connection over an InternetSocket, offloading the record layer to the kernel when possible
+ */
+
+
+#ifndef NCS_TLS_SESSION_H
+#define NCS_TLS_SESSION_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <openssl/ssl.h>
+#include <sys/types.h>
+
+#include <InternetSocket.h>
+#include <TlsContext.h>
+
+
+namespace ncs { // Network Communications System
+namespace tls { // Network Communications System Transport Layer Security
+
+
+/**
+ * TlsSession types
+ */
+enum tls_offload_e {
+  TLS_OFFLOAD_NONE,     // OpenSSL builds every record
+  TLS_OFFLOAD_TX,       // The kernel encrypts, OpenSSL still decrypts
+  TLS_OFFLOAD_FULL      // The kernel handles both directions
+};
+
+
+/**
+ * @brief Runs the handshake in OpenSSL, then installs the TLS 1.3 traffic keys with setsockopt(SOL_TLS) and falls back to OpenSSL records when the kernel can not take them
+ */
+class TlsSession {
+public:
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+  /**
+   * @brief Context constructor
+   * 
+   * @param iContext Must outlive the session
+   * @param iSocket Connected TCP socket, the session does not own it
+   * @param iHost Name or address the server certificate must be issued for, sent as SNI when it is a name.
+   *              Required by clients verifying the peer, ignored by servers
+   */
+  TlsSession(const TlsContext& iContext, const sock::InternetSocket& iSocket, const std::string& iHost = "");
+
+  /**
+   * @brief Copy constructor
+   */
+  TlsSession(const TlsSession& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Runs the handshake for the context role and then tries to offload the record layer
+   * 
+   * @return False with errno set to EAGAIN on a non blocking socket that needs to be retried once ready,
+   *         EINVAL for a client verifying the peer without a host, any other errno means the handshake failed,
+   *         see get_error()
+   */
+  [[nodiscard]] bool handshake(void);
+
+  /**
+   * @brief Encrypts and sends up to iSize bytes
+   * 
+   * @param iData
+   * @param iSize
+   * 
+   * @return Bytes sent, -1 with errno set on failure
+   */
+  ssize_t send(const void* iData, const std::size_t& iSize);
+
+  /**
+   * @brief Receives and decrypts up to iSize bytes
+   * 
+   * @param oData
+   * @param iSize
+   * 
+   * @return Bytes received, 0 once the peer closed, -1 with errno set on failure
+   */
+  ssize_t recv(void* oData, const std::size_t& iSize);
+
+  /**
+   * @brief Sends part of a file, zero copy when the kernel owns the transmit keys
+   * 
+   * @param iFd
+   * @param ioOffset Advanced by the bytes sent
+   * @param iCount
+   * 
+   * @return Bytes sent, -1 with errno set if nothing could be sent
+   */
+  ssize_t sendfile(const int& iFd, off_t& ioOffset, const std::size_t& iCount);
+
+  /**
+   * @brief Sends close_notify, the socket itself stays open
+   * 
+   * @return
+   */
+  bool shutdown(void);
+
+  /**
+   * @brief OpenSSL key log hook collecting the traffic secrets of the session owning iSsl
+   * 
+   * @param iSsl
+   * @param iLine NSS key log line
+   */
+  static void on_key_log(const SSL* iSsl, const char* iLine);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] const bool& is_established(void) const;
+
+  /**
+   * @brief Directions whose records are handled by the kernel
+   * 
+   * @return
+   */
+  [[nodiscard]] const tls_offload_e& get_offload(void) const;
+
+  /**
+   * @brief Negotiated protocol version, such as "TLSv1.3"
+   * 
+   * @return
+   */
+  [[nodiscard]] std::string get_version(void) const;
+
+  /**
+   * @brief Negotiated cipher suite
+   * 
+   * @return
+   */
+  [[nodiscard]] std::string get_cipher(void) const;
+
+  /**
+   * @brief Last OpenSSL error message
+   * 
+   * @return
+   */
+  [[nodiscard]] const std::string& get_error(void) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+  /**
+   * @brief Copy assignment operator
+   */
+  TlsSession& operator=(const TlsSession& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+  /**
+   * @brief Destructor
+   */
+  ~TlsSession();
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+protected:
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Installs the traffic keys in the kernel
+   * 
+   * @return False when the version, the cipher or the kernel do not allow it
+   */
+  bool install_ktls(void);
+
+  /**
+   * @brief Translates an OpenSSL failure into errno and the error message
+   * 
+   * @param iResult Value returned by the failed call
+   */
+  void fail(const int& iResult);
+
+  /**
+   * @brief Binds the certificate check to iHost and sends it as SNI when it is not an address
+   * 
+   * @param iHost
+   * 
+   * @return
+   */
+  bool bind_host(const std::string& iHost);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+  const TlsContext& context_;
+  sock::sd_t sd_;
+  SSL* ssl_;
+  bool established_;
+  bool hostBound_;
+  tls_offload_e offload_;
+  std::vector<std::uint8_t> clientSecret_;
+  std::vector<std::uint8_t> serverSecret_;
+  std::string error_;
+};
+
+
+} // namespace tls
+} // namespace ncs
+
+
+#endif // NCS_TLS_SESSION_H
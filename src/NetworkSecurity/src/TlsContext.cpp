@@ -0,0 +1,233 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file TlsContext.cpp
+ *
+ * @brief
+ */
+
+
+#include <TlsContext.h>
+#include <TlsSession.h>
+
+#include <cstddef>
+
+#include <openssl/evp.h>
+#include <openssl/x509.h>
+
+
+namespace ncs { // Network Communications System
+namespace tls { // Network Communications System Transport Layer Security
+
+
+/**
+ * TlsContext constants
+ */
+constexpr long SELF_SIGNED_LIFETIME_S = 24 * 60 * 60;     // Validity of use_self_signed() certificates
+constexpr std::size_t DEFAULT_SESSION_TICKETS = 2;        // OpenSSL default for TLS 1.3 servers
+
+
+/** PUBLIC METHODS **/
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+/**
+ * @brief Role constructor, TLS 1.2 is the lowest version negotiated
+ * 
+ * @param iRole
+ */
+TlsContext::TlsContext(const tls_role_e& iRole)
+    : role_(iRole), ktls_(false), context_(SSL_CTX_new(iRole == TLS_SERVER ? TLS_server_method() : TLS_client_method())) {
+  if (this->context_ == nullptr) {
+    return;
+  }
+  SSL_CTX_set_min_proto_version(this->context_, TLS1_2_VERSION);
+  SSL_CTX_set_mode(this->context_, SSL_MODE_ENABLE_PARTIAL_WRITE | SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
+  this->set_verify_peer(iRole == TLS_CLIENT);
+  this->set_ktls(true);
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Loads a PEM certificate chain and its private key
+ * 
+ * @param iCertificateFile
+ * @param iKeyFile
+ * 
+ * @return
+ */
+bool TlsContext::use_certificate(const std::string& iCertificateFile, const std::string& iKeyFile) {
+  return this->context_ != nullptr &&
+         SSL_CTX_use_certificate_chain_file(this->context_, iCertificateFile.c_str()) == 1 &&
+         SSL_CTX_use_PrivateKey_file(this->context_, iKeyFile.c_str(), SSL_FILETYPE_PEM) == 1 &&
+         SSL_CTX_check_private_key(this->context_) == 1;
+}
+
+/**
+ * @brief Generates a throwaway P-256 key and a self signed certificate
+ * 
+ * @param iCommonName
+ * 
+ * @return
+ */
+bool TlsContext::use_self_signed(const std::string& iCommonName) {
+  if (this->context_ == nullptr) {
+    return false;
+  }
+  EVP_PKEY* key = EVP_EC_gen("P-256");
+  X509* certificate = X509_new();
+  bool ready = key != nullptr && certificate != nullptr;
+  if (ready) {
+    X509_set_version(certificate, 2);
+    ASN1_INTEGER_set(X509_get_serialNumber(certificate), 1);
+    X509_gmtime_adj(X509_getm_notBefore(certificate), 0);
+    X509_gmtime_adj(X509_getm_notAfter(certificate), SELF_SIGNED_LIFETIME_S);
+    X509_NAME* name = X509_get_subject_name(certificate);
+    X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC,
+                               reinterpret_cast<const unsigned char*>(iCommonName.c_str()), -1, -1, 0);
+    X509_set_issuer_name(certificate, name);
+    ready = X509_set_pubkey(certificate, key) == 1 && X509_sign(certificate, key, EVP_sha256()) > 0 &&
+            SSL_CTX_use_certificate(this->context_, certificate) == 1 &&
+            SSL_CTX_use_PrivateKey(this->context_, key) == 1;
+  }
+  X509_free(certificate);
+  EVP_PKEY_free(key);
+  return ready;
+}
+
+/**
+ * @brief Trusts the PEM certificates in iCaFile and starts verifying the peer
+ * 
+ * @param iCaFile
+ * 
+ * @return
+ */
+bool TlsContext::trust(const std::string& iCaFile) {
+  if (this->context_ == nullptr || SSL_CTX_load_verify_locations(this->context_, iCaFile.c_str(), nullptr) != 1) {
+    return false;
+  }
+  this->set_verify_peer(true);
+  return true;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+/**
+ * @brief Enables or disables peer certificate verification
+ * 
+ * @param iVerify
+ */
+void TlsContext::set_verify_peer(const bool& iVerify) {
+  if (this->context_ != nullptr) {
+    SSL_CTX_set_verify(this->context_, iVerify ? SSL_VERIFY_PEER : SSL_VERIFY_NONE, nullptr);
+  }
+}
+
+/**
+ * @brief Hands the record layer to the kernel after every handshake
+ * 
+ * @param iEnabled
+ */
+void TlsContext::set_ktls(const bool& iEnabled) {
+  this->ktls_ = iEnabled;
+  if (this->context_ == nullptr) {
+    return;
+  }
+  // The traffic secrets only reach us through the key log callback
+  SSL_CTX_set_keylog_callback(this->context_, iEnabled ? &TlsSession::on_key_log : nullptr);
+  if (this->role_ == TLS_SERVER) {
+    SSL_CTX_set_num_tickets(this->context_, iEnabled ? 0 : DEFAULT_SESSION_TICKETS);
+  }
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+const bool& TlsContext::get_ktls(void) const {
+  return this->ktls_;
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+const tls_role_e& TlsContext::get_role(void) const {
+  return this->role_;
+}
+
+/**
+ * @brief Underlying context, for settings not covered here
+ * 
+ * @return
+ */
+SSL_CTX* TlsContext::get_native(void) const {
+  return this->context_;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+/**
+ * @brief Destructor
+ */
+TlsContext::~TlsContext() {
+  SSL_CTX_free(this->context_);
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PROTECTED METHODS **/
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PRIVATE METHODS **/
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+} // namespace tls
+} // namespace ncs
@@ -0,0 +1,562 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file TlsSession.cpp
+ *
+ * @brief
+ */
+
+
+#include <TlsSession.h>
+
+#include <arpa/inet.h>
+#include <linux/tls.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/kdf.h>
+#include <openssl/x509v3.h>
+#include <sys/sendfile.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+
+
+namespace ncs { // Network Communications System
+namespace tls { // Network Communications System Transport Layer Security
+
+
+/**
+ * TlsSession constants
+ */
+constexpr std::size_t TLS_MAX_RECORD_SIZE = 16 * 1024;            // Largest plaintext a record carries
+constexpr unsigned char TLS_RECORD_ALERT = 21;
+constexpr unsigned char TLS_RECORD_HANDSHAKE = 22;
+constexpr unsigned char TLS_RECORD_APPLICATION_DATA = 23;
+constexpr unsigned char TLS_HANDSHAKE_NEW_SESSION_TICKET = 4;
+constexpr unsigned char TLS_ALERT_LEVEL_WARNING = 1;
+constexpr unsigned char TLS_ALERT_CLOSE_NOTIFY = 0;
+constexpr std::uint16_t TLS_AES_128_GCM_SHA256 = 0x1301;
+constexpr std::uint16_t TLS_AES_256_GCM_SHA384 = 0x1302;
+constexpr std::uint16_t TLS_CHACHA20_POLY1305_SHA256 = 0x1303;
+constexpr std::size_t TLS13_IV_SIZE = 12;
+
+/**
+ * @brief Any of the kernel key layouts
+ */
+union crypto_info_t {
+  tls12_crypto_info_aes_gcm_128 aes_128;
+  tls12_crypto_info_aes_gcm_256 aes_256;
+  tls12_crypto_info_chacha20_poly1305 chacha;
+};
+
+/**
+ * @brief Decodes hexadecimal digits up to the end of the string
+ * 
+ * @param iHex
+ * @param oBytes
+ */
+static void hex_decode(const char* iHex, std::vector<std::uint8_t>& oBytes) {
+  const auto nibble = [](const char& iDigit) -> std::uint8_t {
+    return static_cast<std::uint8_t>((iDigit <= '9') ? iDigit - '0' : (iDigit | 0x20) - 'a' + 10);
+  };
+  oBytes.clear();
+  for (; iHex[0] != '\0' && iHex[1] != '\0'; iHex += 2) {
+    oBytes.push_back(static_cast<std::uint8_t>((nibble(iHex[0]) << 4) | nibble(iHex[1])));
+  }
+}
+
+/**
+ * @brief HKDF-Expand-Label from RFC 8446 with an empty context
+ * 
+ * @param iDigest
+ * @param iSecret
+ * @param iLabel
+ * @param oOutput
+ * @param iSize
+ * 
+ * @return
+ */
+static bool expand_label(const EVP_MD* iDigest, const std::vector<std::uint8_t>& iSecret, const std::string& iLabel,
+                         unsigned char* oOutput, std::size_t iSize) {
+  const std::string label = "tls13 " + iLabel;
+  std::vector<unsigned char> info = {static_cast<unsigned char>(iSize >> 8), static_cast<unsigned char>(iSize),
+                                     static_cast<unsigned char>(label.size())};
+  info.insert(info.end(), label.begin(), label.end());
+  info.push_back(0);
+  EVP_PKEY_CTX* context = EVP_PKEY_CTX_new_id(EVP_PKEY_HKDF, nullptr);
+  const bool expanded = context != nullptr && EVP_PKEY_derive_init(context) > 0 &&
+                        EVP_PKEY_CTX_hkdf_mode(context, EVP_PKEY_HKDEF_MODE_EXPAND_ONLY) > 0 &&
+                        EVP_PKEY_CTX_set_hkdf_md(context, iDigest) > 0 &&
+                        EVP_PKEY_CTX_set1_hkdf_key(context, iSecret.data(), static_cast<int>(iSecret.size())) > 0 &&
+                        EVP_PKEY_CTX_add1_hkdf_info(context, info.data(), static_cast<int>(info.size())) > 0 &&
+                        EVP_PKEY_derive(context, oOutput, &iSize) > 0;
+  EVP_PKEY_CTX_free(context);
+  return expanded;
+}
+
+/**
+ * @brief Derives the record key and nonce from a traffic secret in the kernel layout of the cipher
+ * 
+ * The sequence starts at zero, nothing has been sent with the application keys yet
+ * 
+ * @param iSuite
+ * @param iDigest
+ * @param iSecret
+ * @param oInfo
+ * @param oSize
+ * 
+ * @return False for ciphers the kernel does not take
+ */
+static bool build_crypto_info(const std::uint16_t& iSuite, const EVP_MD* iDigest,
+                              const std::vector<std::uint8_t>& iSecret, crypto_info_t& oInfo, socklen_t& oSize) {
+  std::memset(&oInfo, 0, sizeof(oInfo));
+  unsigned char iv[TLS13_IV_SIZE];
+  if (!expand_label(iDigest, iSecret, "iv", iv, sizeof(iv))) {
+    return false;
+  }
+  bool built = false;
+  switch (iSuite) {
+    case TLS_AES_128_GCM_SHA256:
+      oInfo.aes_128.info = {TLS_1_3_VERSION, TLS_CIPHER_AES_GCM_128};
+      std::memcpy(oInfo.aes_128.salt, iv, sizeof(oInfo.aes_128.salt));
+      std::memcpy(oInfo.aes_128.iv, iv + sizeof(oInfo.aes_128.salt), sizeof(oInfo.aes_128.iv));
+      built = expand_label(iDigest, iSecret, "key", oInfo.aes_128.key, sizeof(oInfo.aes_128.key));
+      oSize = sizeof(oInfo.aes_128);
+      break;
+    case TLS_AES_256_GCM_SHA384:
+      oInfo.aes_256.info = {TLS_1_3_VERSION, TLS_CIPHER_AES_GCM_256};
+      std::memcpy(oInfo.aes_256.salt, iv, sizeof(oInfo.aes_256.salt));
+      std::memcpy(oInfo.aes_256.iv, iv + sizeof(oInfo.aes_256.salt), sizeof(oInfo.aes_256.iv));
+      built = expand_label(iDigest, iSecret, "key", oInfo.aes_256.key, sizeof(oInfo.aes_256.key));
+      oSize = sizeof(oInfo.aes_256);
+      break;
+    case TLS_CHACHA20_POLY1305_SHA256:
+      oInfo.chacha.info = {TLS_1_3_VERSION, TLS_CIPHER_CHACHA20_POLY1305};
+      std::memcpy(oInfo.chacha.iv, iv, sizeof(oInfo.chacha.iv));
+      built = expand_label(iDigest, iSecret, "key", oInfo.chacha.key, sizeof(oInfo.chacha.key));
+      oSize = sizeof(oInfo.chacha);
+      break;
+    default:
+      break;
+  }
+  OPENSSL_cleanse(iv, sizeof(iv));
+  return built;
+}
+
+
+/** PUBLIC METHODS **/
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+/**
+ * @brief Context constructor
+ * 
+ * @param iContext
+ * @param iSocket
+ * @param iHost
+ */
+TlsSession::TlsSession(const TlsContext& iContext, const sock::InternetSocket& iSocket, const std::string& iHost)
+    : context_(iContext), sd_(iSocket.get_sd()),
+      ssl_(iContext.get_native() != nullptr ? SSL_new(iContext.get_native()) : nullptr), established_(false),
+      hostBound_(false), offload_(TLS_OFFLOAD_NONE), clientSecret_(), serverSecret_(), error_() {
+  if (this->ssl_ != nullptr) {
+    SSL_set_app_data(this->ssl_, this);
+    SSL_set_fd(this->ssl_, this->sd_);
+    if ((iContext.get_role() == TLS_CLIENT) && !iHost.empty()) {
+      this->hostBound_ = this->bind_host(iHost);
+    }
+  }
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Runs the handshake for the context role and then tries to offload the record layer
+ * 
+ * @return
+ */
+bool TlsSession::handshake(void) {
+  if (this->ssl_ == nullptr) {
+    errno = ENOMEM;
+    return false;
+  }
+  // A trusted certificate proves nothing unless it was issued for the host we meant to reach
+  if ((this->context_.get_role() == TLS_CLIENT) && ((SSL_get_verify_mode(this->ssl_) & SSL_VERIFY_PEER) != 0) &&
+      !this->hostBound_) {
+    this->error_ = "no host to verify the server certificate against";
+    errno = EINVAL;
+    return false;
+  }
+  const int result = (this->context_.get_role() == TLS_SERVER) ? SSL_accept(this->ssl_) : SSL_connect(this->ssl_);
+  if (result != 1) {
+    this->fail(result);
+    return false;
+  }
+  this->established_ = true;
+  this->install_ktls();
+  OPENSSL_cleanse(this->clientSecret_.data(), this->clientSecret_.size());
+  OPENSSL_cleanse(this->serverSecret_.data(), this->serverSecret_.size());
+  this->clientSecret_.clear();
+  this->serverSecret_.clear();
+  return true;
+}
+
+/**
+ * @brief Encrypts and sends up to iSize bytes
+ * 
+ * @param iData
+ * @param iSize
+ * 
+ * @return
+ */
+ssize_t TlsSession::send(const void* iData, const std::size_t& iSize) {
+  if (this->offload_ != TLS_OFFLOAD_NONE) {
+    return ::send(this->sd_, iData, iSize, MSG_NOSIGNAL);
+  }
+  if (iSize == 0) {
+    return 0;
+  }
+  const int result = SSL_write(this->ssl_, iData, static_cast<int>(std::min<std::size_t>(iSize, INT_MAX)));
+  if (result > 0) {
+    return result;
+  }
+  this->fail(result);
+  return -1;
+}
+
+/**
+ * @brief Receives and decrypts up to iSize bytes
+ * 
+ * @param oData
+ * @param iSize
+ * 
+ * @return
+ */
+ssize_t TlsSession::recv(void* oData, const std::size_t& iSize) {
+  if (this->offload_ == TLS_OFFLOAD_FULL) {
+    // Non application records are delivered one at a time, tagged with their type
+    while (true) {
+      char control[CMSG_SPACE(sizeof(unsigned char))];
+      iovec buffer{oData, iSize};
+      msghdr message{};
+      message.msg_iov = &buffer;
+      message.msg_iovlen = 1;
+      message.msg_control = control;
+      message.msg_controllen = sizeof(control);
+      const ssize_t result = ::recvmsg(this->sd_, &message, 0);
+      const cmsghdr* header = (result < 0) ? nullptr : CMSG_FIRSTHDR(&message);
+      if (header == nullptr || header->cmsg_level != SOL_TLS || header->cmsg_type != TLS_GET_RECORD_TYPE) {
+        return result;
+      }
+      const unsigned char type = *CMSG_DATA(header);
+      if (type == TLS_RECORD_APPLICATION_DATA) {
+        return result;
+      }
+      if (type == TLS_RECORD_ALERT) {
+        return 0;
+      }
+      if (type == TLS_RECORD_HANDSHAKE && result > 0 &&
+          static_cast<const std::uint8_t*>(oData)[0] == TLS_HANDSHAKE_NEW_SESSION_TICKET) {
+        continue;
+      }
+      // A key update would need the new secrets, which only OpenSSL could derive
+      errno = EPROTO;
+      return -1;
+    }
+  }
+  if (iSize == 0) {
+    return 0;
+  }
+  const int result = SSL_read(this->ssl_, oData, static_cast<int>(std::min<std::size_t>(iSize, INT_MAX)));
+  if (result > 0) {
+    return result;
+  }
+  if (SSL_get_error(this->ssl_, result) == SSL_ERROR_ZERO_RETURN) {
+    return 0;
+  }
+  this->fail(result);
+  return -1;
+}
+
+/**
+ * @brief Sends part of a file, zero copy when the kernel owns the transmit keys
+ * 
+ * @param iFd
+ * @param ioOffset
+ * @param iCount
+ * 
+ * @return
+ */
+ssize_t TlsSession::sendfile(const int& iFd, off_t& ioOffset, const std::size_t& iCount) {
+  if (this->offload_ != TLS_OFFLOAD_NONE) {
+    return ::sendfile(this->sd_, iFd, &ioOffset, iCount);
+  }
+  std::vector<char> buffer(TLS_MAX_RECORD_SIZE);
+  std::size_t total = 0;
+  while (total < iCount) {
+    const ssize_t read = ::pread(iFd, buffer.data(), std::min(buffer.size(), iCount - total), ioOffset);
+    if (read <= 0) {
+      if (read < 0 && total == 0) {
+        return -1;
+      }
+      break;
+    }
+    for (ssize_t written = 0; written < read;) {
+      const ssize_t result = this->send(buffer.data() + written, static_cast<std::size_t>(read - written));
+      if (result < 0) {
+        return (total > 0) ? static_cast<ssize_t>(total) : -1;
+      }
+      written += result;
+      ioOffset += result;
+      total += static_cast<std::size_t>(result);
+    }
+  }
+  return static_cast<ssize_t>(total);
+}
+
+/**
+ * @brief Sends close_notify, the socket itself stays open
+ * 
+ * @return
+ */
+bool TlsSession::shutdown(void) {
+  if (!this->established_) {
+    return false;
+  }
+  if (this->offload_ == TLS_OFFLOAD_NONE) {
+    return SSL_shutdown(this->ssl_) >= 0;
+  }
+  // OpenSSL no longer tracks the write sequence, the alert has to go through the kernel as well
+  unsigned char alert[] = {TLS_ALERT_LEVEL_WARNING, TLS_ALERT_CLOSE_NOTIFY};
+  char control[CMSG_SPACE(sizeof(unsigned char))] = {};
+  iovec buffer{alert, sizeof(alert)};
+  msghdr message{};
+  message.msg_iov = &buffer;
+  message.msg_iovlen = 1;
+  message.msg_control = control;
+  message.msg_controllen = sizeof(control);
+  cmsghdr* header = CMSG_FIRSTHDR(&message);
+  header->cmsg_level = SOL_TLS;
+  header->cmsg_type = TLS_SET_RECORD_TYPE;
+  header->cmsg_len = CMSG_LEN(sizeof(unsigned char));
+  *CMSG_DATA(header) = TLS_RECORD_ALERT;
+  return ::sendmsg(this->sd_, &message, MSG_NOSIGNAL) == static_cast<ssize_t>(sizeof(alert));
+}
+
+/**
+ * @brief OpenSSL key log hook collecting the traffic secrets of the session owning iSsl
+ * 
+ * @param iSsl
+ * @param iLine "<label> <client random> <secret>" in hexadecimal
+ */
+void TlsSession::on_key_log(const SSL* iSsl, const char* iLine) {
+  TlsSession* session = static_cast<TlsSession*>(SSL_get_app_data(iSsl));
+  const char* secret = std::strrchr(iLine, ' ');
+  if (session == nullptr || secret == nullptr) {
+    return;
+  }
+  std::vector<std::uint8_t>* target = nullptr;
+  if (std::strncmp(iLine, "CLIENT_TRAFFIC_SECRET_0 ", 24) == 0) {
+    target = &session->clientSecret_;
+  } else if (std::strncmp(iLine, "SERVER_TRAFFIC_SECRET_0 ", 24) == 0) {
+    target = &session->serverSecret_;
+  } else {
+    return;
+  }
+  hex_decode(secret + 1, *target);
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+/**
+ * @brief
+ * 
+ * @return
+ */
+const bool& TlsSession::is_established(void) const {
+  return this->established_;
+}
+
+/**
+ * @brief Directions whose records are handled by the kernel
+ * 
+ * @return
+ */
+const tls_offload_e& TlsSession::get_offload(void) const {
+  return this->offload_;
+}
+
+/**
+ * @brief Negotiated protocol version
+ * 
+ * @return
+ */
+std::string TlsSession::get_version(void) const {
+  return (this->ssl_ != nullptr) ? SSL_get_version(this->ssl_) : "";
+}
+
+/**
+ * @brief Negotiated cipher suite
+ * 
+ * @return
+ */
+std::string TlsSession::get_cipher(void) const {
+  return this->established_ ? SSL_get_cipher_name(this->ssl_) : "";
+}
+
+/**
+ * @brief Last OpenSSL error message
+ * 
+ * @return
+ */
+const std::string& TlsSession::get_error(void) const {
+  return this->error_;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+/**
+ * @brief Destructor
+ */
+TlsSession::~TlsSession() {
+  OPENSSL_cleanse(this->clientSecret_.data(), this->clientSecret_.size());
+  OPENSSL_cleanse(this->serverSecret_.data(), this->serverSecret_.size());
+  SSL_free(this->ssl_);
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PROTECTED METHODS **/
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PRIVATE METHODS **/
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Installs the traffic keys in the kernel
+ * 
+ * Only TLS 1.3 is offloaded, its secrets are the only ones the key log exposes
+ * 
+ * @return
+ */
+bool TlsSession::install_ktls(void) {
+  if (!this->context_.get_ktls() || SSL_version(this->ssl_) != TLS1_3_VERSION || SSL_has_pending(this->ssl_) ||
+      this->clientSecret_.empty() || this->serverSecret_.empty()) {
+    return false;
+  }
+  const SSL_CIPHER* cipher = SSL_get_current_cipher(this->ssl_);
+  const std::uint16_t suite = SSL_CIPHER_get_protocol_id(cipher);
+  const EVP_MD* digest = SSL_CIPHER_get_handshake_digest(cipher);
+  const bool server = this->context_.get_role() == TLS_SERVER;
+  crypto_info_t transmit;
+  crypto_info_t receive;
+  socklen_t transmitSize = 0;
+  socklen_t receiveSize = 0;
+  bool installed = false;
+  if (build_crypto_info(suite, digest, server ? this->serverSecret_ : this->clientSecret_, transmit, transmitSize) &&
+      build_crypto_info(suite, digest, server ? this->clientSecret_ : this->serverSecret_, receive, receiveSize) &&
+      ::setsockopt(this->sd_, SOL_TCP, TCP_ULP, "tls", sizeof("tls")) == 0 &&
+      ::setsockopt(this->sd_, SOL_TLS, TLS_TX, &transmit, transmitSize) == 0) {
+    this->offload_ = TLS_OFFLOAD_TX;
+    if (::setsockopt(this->sd_, SOL_TLS, TLS_RX, &receive, receiveSize) == 0) {
+      this->offload_ = TLS_OFFLOAD_FULL;
+    }
+    installed = true;
+  }
+  OPENSSL_cleanse(&transmit, sizeof(transmit));
+  OPENSSL_cleanse(&receive, sizeof(receive));
+  return installed;
+}
+
+/**
+ * @brief Translates an OpenSSL failure into errno and the error message
+ * 
+ * @param iResult
+ */
+void TlsSession::fail(const int& iResult) {
+  const int error = errno;
+  switch (SSL_get_error(this->ssl_, iResult)) {
+    case SSL_ERROR_WANT_READ:
+    case SSL_ERROR_WANT_WRITE:
+      errno = EAGAIN;
+      break;
+    case SSL_ERROR_SYSCALL:
+      errno = (error != 0) ? error : ECONNRESET;
+      break;
+    default:
+      errno = EPROTO;
+      break;
+  }
+  char message[256] = {};
+  ERR_error_string_n(ERR_peek_last_error(), message, sizeof(message));
+  this->error_ = message;
+  ERR_clear_error();
+}
+
+/**
+ * @brief Binds the certificate check to iHost and sends it as SNI when it is not an address
+ * 
+ * @param iHost
+ * 
+ * @return
+ */
+bool TlsSession::bind_host(const std::string& iHost) {
+  unsigned char address[sizeof(in6_addr)];
+  if ((inet_pton(AF_INET, iHost.c_str(), address) == 1) || (inet_pton(AF_INET6, iHost.c_str(), address) == 1)) {
+    // RFC 6066 forbids addresses in SNI, they are matched against the IP entries of the certificate instead
+    return X509_VERIFY_PARAM_set1_ip_asc(SSL_get0_param(this->ssl_), iHost.c_str()) == 1;
+  }
+  return (SSL_set_tlsext_host_name(this->ssl_, iHost.c_str()) == 1) && (SSL_set1_host(this->ssl_, iHost.c_str()) == 1);
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+} // namespace tls
+} // namespace ncs
@@ -0,0 +1,157 @@
+/**
+ * @copyright Copyright (c) 2023
+ * 
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ * 
+ * @file TlsSession_tests.cpp
+ * 
+ * @brief
+ */
+
+
+#include <TlsTest.h>
+
+#include <gtest/gtest.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+
+namespace ncs::tls {
+namespace tests {
+
+
+/**
+ * @brief
+ */
+TEST_F(TlsTest, Handshake_Negotiates_Tls13) {
+  TlsSession client(clientContext_, client_);
+  TlsSession server(serverContext_, server_);
+  ASSERT_TRUE(establish(client, server)) << client.get_error() << server.get_error();
+  EXPECT_TRUE(client.is_established());
+  EXPECT_EQ(client.get_version(), "TLSv1.3");
+  EXPECT_EQ(client.get_cipher(), server.get_cipher());
+
+  // Whatever the kernel took, both sides must still understand each other
+  ASSERT_EQ(client.send("ping", 4), 4);
+  EXPECT_EQ(receive_exactly(server, 4), "ping");
+  ASSERT_EQ(server.send("pong", 4), 4);
+  EXPECT_EQ(receive_exactly(client, 4), "pong");
+
+  EXPECT_TRUE(server.shutdown());
+  char byte;
+  EXPECT_EQ(client.recv(&byte, 1), 0);
+}
+
+/**
+ * @brief
+ */
+TEST_F(TlsTest, Userspace_Records_When_Ktls_Is_Disabled) {
+  clientContext_.set_ktls(false);
+  serverContext_.set_ktls(false);
+  TlsSession client(clientContext_, client_);
+  TlsSession server(serverContext_, server_);
+  ASSERT_TRUE(establish(client, server));
+  EXPECT_EQ(client.get_offload(), TLS_OFFLOAD_NONE);
+  EXPECT_EQ(server.get_offload(), TLS_OFFLOAD_NONE);
+
+  const std::string payload(100000, 'n');
+  std::thread writer([&]() {
+    for (std::size_t sent = 0; sent < payload.size();) {
+      const ssize_t result = client.send(payload.data() + sent, payload.size() - sent);
+      ASSERT_GT(result, 0);
+      sent += static_cast<std::size_t>(result);
+    }
+  });
+  EXPECT_EQ(receive_exactly(server, payload.size()), payload);
+  writer.join();
+}
+
+/**
+ * @brief
+ */
+TEST_F(TlsTest, Sendfile_Streams_An_Encrypted_File) {
+  TlsSession client(clientContext_, client_);
+  TlsSession server(serverContext_, server_);
+  ASSERT_TRUE(establish(client, server));
+
+  std::string contents;
+  for (int i = 0; contents.size() < 200000; ++i) {
+    contents += std::to_string(i) + ',';
+  }
+  std::FILE* file = std::tmpfile();
+  ASSERT_NE(file, nullptr);
+  ASSERT_EQ(std::fwrite(contents.data(), 1, contents.size(), file), contents.size());
+  ASSERT_EQ(std::fflush(file), 0);
+
+  std::thread reader([&]() { EXPECT_EQ(receive_exactly(client, contents.size() - 100), contents.substr(100)); });
+  off_t offset = 100;
+  std::size_t sent = 0;
+  while (sent < contents.size() - 100) {
+    const ssize_t result = server.sendfile(::fileno(file), offset, contents.size() - 100 - sent);
+    ASSERT_GT(result, 0);
+    sent += static_cast<std::size_t>(result);
+  }
+  reader.join();
+  EXPECT_EQ(offset, static_cast<off_t>(contents.size()));
+  std::fclose(file);
+}
+
+/**
+ * @brief
+ */
+TEST_F(TlsTest, Untrusted_Certificate_Fails_The_Handshake) {
+  clientContext_.set_verify_peer(true);
+  TlsSession client(clientContext_, client_, "localhost");
+  TlsSession server(serverContext_, server_);
+  EXPECT_FALSE(establish(client, server));
+  EXPECT_EQ(errno, EPROTO);
+  EXPECT_FALSE(client.is_established());
+  EXPECT_NE(client.get_error(), "");
+}
+
+/**
+ * @brief
+ */
+TEST_F(TlsTest, Certificate_For_Another_Host_Fails_The_Handshake) {
+  // The server certificate is trusted, it is only issued for the wrong name
+  X509* certificate = SSL_CTX_get0_certificate(serverContext_.get_native());
+  ASSERT_EQ(X509_STORE_add_cert(SSL_CTX_get_cert_store(clientContext_.get_native()), certificate), 1);
+  clientContext_.set_verify_peer(true);
+  TlsSession client(clientContext_, client_, "example.com");
+  TlsSession server(serverContext_, server_);
+  EXPECT_FALSE(establish(client, server));
+  EXPECT_EQ(errno, EPROTO);
+  EXPECT_FALSE(client.is_established());
+  EXPECT_NE(client.get_error(), "");
+}
+
+/**
+ * @brief
+ */
+TEST_F(TlsTest, Certificate_For_The_Host_Completes_The_Handshake) {
+  X509* certificate = SSL_CTX_get0_certificate(serverContext_.get_native());
+  ASSERT_EQ(X509_STORE_add_cert(SSL_CTX_get_cert_store(clientContext_.get_native()), certificate), 1);
+  clientContext_.set_verify_peer(true);
+  TlsSession client(clientContext_, client_, "localhost");
+  TlsSession server(serverContext_, server_);
+  EXPECT_TRUE(establish(client, server)) << client.get_error() << server.get_error();
+}
+
+/**
+ * @brief
+ */
+TEST_F(TlsTest, Verifying_Client_Requires_A_Host) {
+  clientContext_.set_verify_peer(true);
+  TlsSession client(clientContext_, client_);
+  EXPECT_FALSE(client.handshake());
+  EXPECT_EQ(errno, EINVAL);
+  EXPECT_FALSE(client.is_established());
+}
+
+
+} // namespace tests
+} // namespace ncs::tls
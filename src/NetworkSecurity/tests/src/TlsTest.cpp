@@ -0,0 +1,146 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file TlsTest.cpp
+ *
+ * @brief
+ */
+
+
+#include <TlsTest.h>
+
+#include <thread>
+
+
+namespace ncs { // Network Communications System
+namespace tls { // Network Communications System Transport Layer Security
+namespace tests { // Tests
+
+
+/** PUBLIC METHODS **/
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PROTECTED METHODS **/
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+/**
+ * @brief Self signed server on a loopback pair, the client trusts anything
+ */
+void TlsTest::SetUp() {
+  ASSERT_TRUE(serverContext_.use_self_signed("localhost"));
+  clientContext_.set_verify_peer(false);
+  ASSERT_TRUE(listener_.bind({"127.0.0.1", addr::RANDOM_PORT}));
+  ASSERT_TRUE(listener_.listen());
+  ASSERT_TRUE(client_.connect(listener_.get_addr()));
+  ASSERT_TRUE(listener_.accept(server_));
+}
+
+/**
+ * @brief 
+ */
+void TlsTest::TearDown() {
+  server_.close();
+  client_.close();
+  listener_.close();
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief 
+ * 
+ * @param ioClient
+ * @param ioServer
+ * 
+ * @return
+ */
+bool TlsTest::establish(TlsSession& ioClient, TlsSession& ioServer) {
+  bool server = false;
+  std::thread accepting([&]() { server = ioServer.handshake(); });
+  // A client refusing the certificate sends an alert, which also fails the server side
+  const bool client = ioClient.handshake();
+  accepting.join();
+  return client && server;
+}
+
+/**
+ * @brief 
+ * 
+ * @param ioSession
+ * @param iSize
+ * 
+ * @return
+ */
+std::string TlsTest::receive_exactly(TlsSession& ioSession, const std::size_t& iSize) {
+  std::string data(iSize, '\0');
+  std::size_t received = 0;
+  while (received < iSize) {
+    const ssize_t result = ioSession.recv(&data[received], iSize - received);
+    if (result <= 0) {
+      break;
+    }
+    received += static_cast<std::size_t>(result);
+  }
+  data.resize(received);
+  return data;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PRIVATE METHODS **/
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+} // namespace tests
+} // namespace tls
+} // namespace ncs
@@ -0,0 +1,273 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file Acceptor.h
+ *
+ * @brief Drains a listening socket in batches from an event loop
+ */
+
+
+#ifndef NCS_ACCEPTOR_H
+#define NCS_ACCEPTOR_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include <sys/socket.h>
+
+#include <AcceptMetrics.h>
+#include <EventLoop.h>
+#include <InternetAddress.h>
+#include <InternetSocket.h>
+#include <RateLimiter.h>
+#include <SocketProfile.h>
+
+
+namespace ncs { // Network Communications System
+namespace sock { // Network Communications System Sockets
+
+
+/**
+ * Acceptor constants
+ */
+constexpr std::size_t DEFAULT_ACCEPT_BUDGET = 64;   // Connections accepted per readiness event before yielding
+
+/**
+ * @brief
+ */
+struct acceptor_config_t {
+  std::size_t budget = DEFAULT_ACCEPT_BUDGET;   // Bounds the time one busy listener keeps the loop
+  int backlog = SOMAXCONN;
+  int defer_accept_s = 0;                       // TCP_DEFER_ACCEPT, wakes up only once the client sent data
+  bool exclusive = true;                        // EPOLLEXCLUSIVE, wakes a single loop when several share a listener
+  bool reuse_port = false;                      // SO_REUSEPORT, lets each loop own a listener on the same address
+  const SocketProfile* profile = nullptr;       // Applied to every accepted connection, must outlive the acceptor
+  RateLimiter* limiter = nullptr;               // Refuses sources over their rate, must outlive the acceptor
+};
+
+/**
+ * @brief Takes ownership of an accepted connection by moving from it
+ */
+using accept_handler_t = std::function<void(InternetSocket&& ioClient)>;
+
+
+/**
+ * @brief Accepts up to a budget of connections per readiness event and keeps a spare descriptor to shed load on EMFILE
+ */
+class Acceptor {
+public:
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+  /**
+   * @brief Loop constructor
+   * 
+   * @param ioLoop Must outlive the acceptor
+   * @param iConfig
+   */
+  explicit Acceptor(EventLoop& ioLoop, const acceptor_config_t& iConfig = acceptor_config_t());
+
+  /**
+   * @brief Copy constructor
+   */
+  Acceptor(const Acceptor& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Opens a listener on iAddr and starts accepting from the loop
+   * 
+   * @param iAddr
+   * @param iHandler Receives every accepted connection, non blocking
+   * 
+   * @return
+   */
+  [[nodiscard]] bool listen(const addr::InternetAddress& iAddr, accept_handler_t iHandler);
+
+  /**
+   * @brief Starts accepting from a listener owned by someone else, typically shared by one acceptor per loop
+   * 
+   * The listener is switched to non blocking mode and is not closed by close()
+   * 
+   * @param iListener
+   * @param iHandler Receives every accepted connection, non blocking
+   * 
+   * @return
+   */
+  [[nodiscard]] bool attach(const InternetSocket& iListener, accept_handler_t iHandler);
+
+  /**
+   * @brief Accepts the pending connections, at most the budget of the config
+   * 
+   * Called by the loop whenever the listener is readable. Connections the handler does not take are closed
+   * 
+   * @return Connections handed to the handler
+   */
+  std::size_t drain(void);
+
+  /**
+   * @brief Stops accepting, closing the listener if it was opened by listen()
+   */
+  void close(void);
+
+  /**
+   * @brief Reads the accept queue overflow counters of the network namespace from /proc/net/netstat
+   * 
+   * @param oOverflows Connections dropped because an accept queue was full
+   * @param oDrops Connections dropped for any reason before reaching an accept queue, overflows included
+   * 
+   * @return
+   */
+  [[nodiscard]] static bool read_listen_overflows(std::uint64_t& oOverflows, std::uint64_t& oDrops);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+  /**
+   * @brief Attaches the counters updated by drain(), nullptr to disable them
+   * 
+   * @param iMetrics Must outlive the acceptor
+   */
+  void set_metrics(metrics::AcceptMetrics* iMetrics);
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] const InternetSocket& get_listener(void) const;
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] const acceptor_config_t& get_config(void) const;
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] bool is_listening(void) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+  /**
+   * @brief Copy assignment operator
+   */
+  Acceptor& operator=(const Acceptor& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+  /**
+   * @brief Destructor
+   */
+  ~Acceptor();
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+protected:
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Registers the listener with the loop
+   * 
+   * @param iHandler
+   * 
+   * @return
+   */
+  [[nodiscard]] bool watch(accept_handler_t iHandler);
+
+  /**
+   * @brief Accepts the next connection, unless the rate limiter of the config refuses its source
+   * 
+   * A refused connection is reset and closed straight from the descriptor and the peer address accept(2) returned
+   * 
+   * @param oClient
+   * @param oRefused Set when a connection was accepted and refused
+   * 
+   * @return
+   */
+  [[nodiscard]] bool accept(InternetSocket& oClient, bool& oRefused);
+
+  /**
+   * @brief Gives up the spare descriptor to accept one connection and close it right away
+   * 
+   * @return False if there was no spare descriptor or nothing to accept
+   */
+  [[nodiscard]] bool shed(void);
+
+  /**
+   * @brief Feeds the accept queue length to the metrics
+   */
+  void sample_backlog(void) const;
+
+  /**
+   * @brief Closes everything, keeping errno
+   * 
+   * @return Always false
+   */
+  bool fail(void);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+  EventLoop& loop_;
+  acceptor_config_t config_;
+  InternetSocket listener_;
+  bool owned_;
+  bool listening_;
+  accept_handler_t handler_;
+  sd_t spareSd_;
+  metrics::AcceptMetrics* metrics_;
+};
+
+
+} // namespace sock
+} // namespace ncs
+
+
+#endif // NCS_ACCEPTOR_H
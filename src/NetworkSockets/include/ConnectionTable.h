@@ -0,0 +1,325 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file ConnectionTable.h
+ *
+ * @brief Registry of connections stored column by column for fast housekeeping scans
+ */
+
+
+#ifndef NCS_CONNECTION_TABLE_H
+#define NCS_CONNECTION_TABLE_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <sys/socket.h>
+
+#include <AddressPool.h>
+#include <InternetAddress.h>
+#include <InternetSocket.h>
+
+
+namespace ncs { // Network Communications System
+namespace sock { // Network Communications System Sockets
+
+
+/**
+ * ConnectionTable types
+ */
+using connection_handle_t = std::uint64_t;   // Generation in the high half, slot in the low half
+
+/**
+ * ConnectionTable constants
+ */
+constexpr connection_handle_t INVALID_CONNECTION_HANDLE = std::numeric_limits<connection_handle_t>::max();
+constexpr std::size_t NO_ROW = std::numeric_limits<std::size_t>::max();
+
+/**
+ * @brief Lifecycle of a registered connection
+ */
+enum connection_state_e : std::uint8_t {
+  CONNECTION_OPEN,        // Serving traffic
+  CONNECTION_DRAINING,    // Finishing in flight work, takes no new requests
+  CONNECTION_CLOSING,     // Waiting to be closed and erased
+  CONNECTION_STATES       // Number of states
+};
+
+/**
+ * @brief Result of ConnectionTable::aggregate()
+ */
+struct connection_totals_t {
+  std::size_t connections = 0;
+  std::size_t states[CONNECTION_STATES] = {};
+  std::uint64_t bytes_in = 0;
+  std::uint64_t bytes_out = 0;
+};
+
+/**
+ * @brief Indirection from a handle to the dense row of its connection
+ */
+struct connection_slot_t {
+  std::uint32_t row = 0;
+  std::uint32_t generation = 0;           // Bumped on erase, stale handles no longer match
+  bool live = false;
+};
+
+
+/**
+ * @brief Keeps each connection field in its own dense column, addressed through generational handles
+ */
+class ConnectionTable {
+public:
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+  /**
+   * @brief Default constructor
+   */
+  ConnectionTable(void);
+
+  /**
+   * @brief Copy constructor
+   */
+  ConnectionTable(const ConnectionTable& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Reserves room for iConnections connections in every column
+   * 
+   * @param iConnections
+   */
+  void reserve(const std::size_t& iConnections);
+
+  /**
+   * @brief Registers an open connection, the table does not own the descriptor
+   * 
+   * @param iSd
+   * @param iPeer sockaddr_in or sockaddr_in6 of the peer, its ip is interned
+   * @param iSize
+   * @param iNowNs Initial activity timestamp
+   * 
+   * @return INVALID_CONNECTION_HANDLE if iPeer is not an internet address
+   */
+  [[nodiscard]] connection_handle_t insert(const sd_t& iSd, const sockaddr* iPeer, const socklen_t& iSize,
+                                           const std::uint64_t& iNowNs);
+
+  /**
+   * @brief Unregisters a connection, its handle and every copy of it become stale
+   * 
+   * The last row is moved into the hole, rows stay dense
+   * 
+   * @param iHandle
+   * 
+   * @return False if iHandle is stale
+   */
+  bool erase(const connection_handle_t& iHandle);
+
+  /**
+   * @brief Records activity on a connection
+   * 
+   * @param iHandle
+   * @param iNowNs
+   * @param iBytesIn
+   * @param iBytesOut
+   * 
+   * @return False if iHandle is stale
+   */
+  bool touch(const connection_handle_t& iHandle, const std::uint64_t& iNowNs, const std::uint64_t& iBytesIn = 0,
+             const std::uint64_t& iBytesOut = 0);
+
+  /**
+   * @brief Collects the handles of the connections idle for longer than iIdleNs
+   * 
+   * @param iNowNs
+   * @param iIdleNs
+   * @param oIdle Cleared first
+   * 
+   * @return Number of idle connections
+   */
+  std::size_t sweep_idle(const std::uint64_t& iNowNs, const std::uint64_t& iIdleNs,
+                         std::vector<connection_handle_t>& oIdle) const;
+
+  /**
+   * @brief Counts connections per state and sums their traffic
+   * 
+   * @return
+   */
+  [[nodiscard]] connection_totals_t aggregate(void) const;
+
+  /**
+   * @brief Moves every open connection to iState
+   * 
+   * @param iState
+   * 
+   * @return Connections changed
+   */
+  std::size_t mark_all(const connection_state_e& iState);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+  /**
+   * @brief
+   * 
+   * @param iHandle
+   * @param iState
+   * 
+   * @return False if iHandle is stale
+   */
+  bool set_state(const connection_handle_t& iHandle, const connection_state_e& iState);
+
+  /**
+   * @brief Row of a connection in the columns, valid until the next erase()
+   * 
+   * @param iHandle
+   * 
+   * @return NO_ROW if iHandle is stale
+   */
+  [[nodiscard]] std::size_t get_row(const connection_handle_t& iHandle) const;
+
+  /**
+   * @brief
+   * 
+   * @param iHandle
+   * @param oPeer
+   * 
+   * @return False if iHandle is stale
+   */
+  [[nodiscard]] bool get_peer(const connection_handle_t& iHandle, addr::InternetAddress& oPeer) const;
+
+  /**
+   * @brief Live connections, also the length of every column
+   * 
+   * @return
+   */
+  [[nodiscard]] std::size_t get_size(void) const;
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] const std::vector<sd_t>& get_sds(void) const;
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] const std::vector<addr::pooled_address_t>& get_peers(void) const;
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] const std::vector<std::uint8_t>& get_states(void) const;
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] const std::vector<std::uint64_t>& get_last_active(void) const;
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] const addr::AddressPool& get_pool(void) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+  /**
+   * @brief Copy assignment operator
+   */
+  ConnectionTable& operator=(const ConnectionTable& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+  /**
+   * @brief Destructor
+   */
+  ~ConnectionTable();
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+protected:
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Handle of a slot at its current generation
+   * 
+   * @param iSlot
+   * 
+   * @return
+   */
+  [[nodiscard]] connection_handle_t make_handle(const std::uint32_t& iSlot) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+  std::vector<connection_slot_t> slots_;   // Indexed by the handle, never shrinks
+  std::vector<std::uint32_t> freeSlots_;
+  std::vector<std::uint32_t> owners_;      // Slot of every row
+  std::vector<sd_t> sds_;
+  std::vector<addr::pooled_address_t> peers_;
+  std::vector<std::uint8_t> states_;
+  std::vector<std::uint64_t> lastActive_;
+  std::vector<std::uint64_t> bytesIn_;
+  std::vector<std::uint64_t> bytesOut_;
+  addr::AddressPool pool_;
+};
+
+
+} // namespace sock
+} // namespace ncs
+
+
+#endif // NCS_CONNECTION_TABLE_H
@@ -0,0 +1,325 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file DrainManager.h
+ *
+ * @brief Graceful shutdown of the connections of every loop of a server
+ */
+
+
+#ifndef NCS_DRAIN_MANAGER_H
+#define NCS_DRAIN_MANAGER_H
+
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <Acceptor.h>
+#include <EventLoop.h>
+#include <InternetSocket.h>
+#include <WriteBatcher.h>
+
+
+namespace ncs { // Network Communications System
+namespace sock { // Network Communications System Sockets
+
+
+/**
+ * DrainManager constants
+ */
+constexpr std::chrono::milliseconds DEFAULT_DRAIN_DEADLINE{5000};
+constexpr std::size_t DRAIN_READ_SIZE = 4096;              // Bytes read at once from peers that keep sending
+constexpr std::size_t DRAIN_READ_BATCH = 16;               // Reads per wake up, so a chatty peer can't stall the loop
+
+/**
+ * @brief How connections still open at the deadline are closed
+ */
+enum linger_policy_e : std::uint8_t {
+  LINGER_KERNEL = 0,      // close(2) returns at once, the kernel keeps sending what is queued in the background
+  LINGER_RESET  = 1,      // SO_LINGER {1, 0}, what is queued is dropped, the peer gets a RST and no TIME_WAIT is left
+};
+
+/**
+ * @brief
+ */
+struct drain_config_t {
+  std::chrono::milliseconds deadline = DEFAULT_DRAIN_DEADLINE;    // From drain() to the last connection closed
+  linger_policy_e on_deadline = LINGER_RESET;
+};
+
+/**
+ * @brief Connections of all loops that reached each stage of the drain
+ */
+struct drain_progress_t {
+  std::uint64_t loops = 0;
+  std::uint64_t loops_done = 0;
+  std::uint64_t connections = 0;                // Drained so far, tracked ones as the loops start
+  std::uint64_t flushed = 0;                    // Had queued writes and sent them all
+  std::uint64_t half_closed = 0;                // Sent their FIN
+  std::uint64_t closed = 0;                     // Closed once the peer closed too, or on an error
+  std::uint64_t expired = 0;                    // Closed at the deadline
+  bool done = false;                            // Every loop closed its last connection
+};
+
+/**
+ * @brief Tracked connection
+ */
+struct drain_connection_t {
+  InternetSocket* socket = nullptr;
+  WriteBatcher* writes = nullptr;
+  bool half_closed = false;
+  bool peer_closed = false;                     // Read the end of the stream, nothing left to wait for
+};
+
+/**
+ * @brief State of one loop, only touched from its thread once it runs
+ */
+struct drain_loop_t {
+  EventLoop* loop = nullptr;
+  std::vector<Acceptor*> acceptors;
+  std::unordered_map<sd_t, drain_connection_t> connections;
+  task_id_t deadline = 0;
+  bool started = false;
+  bool done = false;
+};
+
+
+/**
+ * @brief Stops accepting, then flushes, half closes and closes every tracked connection, each loop on its own thread
+ */
+class DrainManager {
+public:
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+  /**
+   * @brief Config constructor
+   * 
+   * @param iConfig
+   */
+  explicit DrainManager(const drain_config_t& iConfig = drain_config_t());
+
+  /**
+   * @brief Copy constructor
+   */
+  DrainManager(const DrainManager& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Takes part iLoop in the drain, before drain() is called
+   * 
+   * @param ioLoop Must outlive the manager and be running when the drain starts
+   * 
+   * @return Index of the loop for the other calls
+   */
+  [[nodiscard]] std::size_t add_loop(EventLoop& ioLoop);
+
+  /**
+   * @brief Closes ioAcceptor when the drain starts, before drain() is called
+   * 
+   * @param iLoop Index of the loop ioAcceptor runs on
+   * @param ioAcceptor Must outlive the manager
+   */
+  void add_acceptor(const std::size_t& iLoop, Acceptor& ioAcceptor);
+
+  /**
+   * @brief Drains ioSocket with the rest of its loop, called from the thread of the loop
+   * 
+   * Tracked after the drain started the connection is drained right away, or closed if its loop is already done.
+   * 
+   * @param iLoop
+   * @param ioSocket Connection watched by the loop, must stay alive until untracked or the drain is done
+   * @param ioWrites Writes queued for ioSocket that must be sent before it is half closed, nullptr if none
+   */
+  void track(const std::size_t& iLoop, InternetSocket& ioSocket, WriteBatcher* ioWrites = nullptr);
+
+  /**
+   * @brief Forgets ioSocket, called from the thread of the loop before the application closes it
+   * 
+   * Untracked while it is being drained the connection counts as closed and the drain stops watching it.
+   * 
+   * @param iLoop
+   * @param iSocket
+   */
+  void untrack(const std::size_t& iLoop, const InternetSocket& iSocket);
+
+  /**
+   * @brief Starts draining every loop, callable from any thread, returns at once
+   * 
+   * Each loop closes its acceptors, takes every tracked connection away from its handlers and drains them in
+   * parallel: queued writes are flushed, the connection is half closed with shutdown(SHUT_WR), and whatever the peer
+   * still sends is read and dropped until it closes its side, closing with unread data would reset the connection
+   * and lose the last replies. Connections still open at the deadline are closed with the on_deadline policy.
+   * 
+   * @return False if the drain had already started
+   */
+  [[nodiscard]] bool drain(void);
+
+  /**
+   * @brief Waits until every loop closed its last connection
+   * 
+   * @param iTimeout
+   * 
+   * @return False if some loop was still draining after iTimeout
+   */
+  [[nodiscard]] bool wait(const std::chrono::milliseconds& iTimeout) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] const drain_config_t& get_config(void) const;
+
+  /**
+   * @brief Where the drain is, readable from any thread
+   * 
+   * @return
+   */
+  [[nodiscard]] drain_progress_t get_progress(void) const;
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] bool is_draining(void) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+  /**
+   * @brief Copy assignment operator
+   */
+  DrainManager& operator=(const DrainManager& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+  /**
+   * @brief Destructor
+   */
+  ~DrainManager();
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+protected:
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Closes the acceptors of ioLoop and starts draining its connections, on the thread of the loop
+   * 
+   * @param ioLoop
+   */
+  void start(drain_loop_t& ioLoop);
+
+  /**
+   * @brief Takes iSd away from the handlers of the application and starts draining it
+   * 
+   * @param ioLoop
+   * @param iSd
+   */
+  void begin(drain_loop_t& ioLoop, const sd_t& iSd);
+
+  /**
+   * @brief Moves the drain of iSd forward
+   * 
+   * @param ioLoop
+   * @param iSd
+   */
+  void step(drain_loop_t& ioLoop, const sd_t& iSd);
+
+  /**
+   * @brief Closes iSd and forgets it
+   * 
+   * @param ioLoop
+   * @param iSd
+   * @param iExpired Reached the deadline, closed with the on_deadline policy
+   */
+  void finish(drain_loop_t& ioLoop, const sd_t& iSd, const bool& iExpired);
+
+  /**
+   * @brief Closes every connection of ioLoop still open at the deadline
+   * 
+   * @param ioLoop
+   */
+  void expire(drain_loop_t& ioLoop);
+
+  /**
+   * @brief Counts ioLoop as done once it has no connection left
+   * 
+   * @param ioLoop
+   */
+  void complete(drain_loop_t& ioLoop);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+  drain_config_t config_;
+  std::vector<std::unique_ptr<drain_loop_t>> loops_;
+  std::atomic<bool> draining_;
+  std::atomic<std::uint64_t> loopsDone_;
+  std::atomic<std::uint64_t> connections_;
+  std::atomic<std::uint64_t> flushed_;
+  std::atomic<std::uint64_t> halfClosed_;
+  std::atomic<std::uint64_t> closed_;
+  std::atomic<std::uint64_t> expired_;
+  mutable std::mutex doneMutex_;
+  mutable std::condition_variable doneCondition_;
+};
+
+
+} // namespace sock
+} // namespace ncs
+
+
+#endif // NCS_DRAIN_MANAGER_H
@@ -0,0 +1,339 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file EventLoop.h
+ *
+ * @brief Single threaded epoll event loop with end of iteration tasks and timers
+ */
+
+
+#ifndef NCS_EVENT_LOOP_H
+#define NCS_EVENT_LOOP_H
+
+
+#include <sys/epoll.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <InternetSocket.h>
+#include <LoopMetrics.h>
+
+
+namespace ncs { // Network Communications System
+namespace sock { // Network Communications System Sockets
+
+
+/**
+ * EventLoop types
+ */
+using event_handler_t = std::function<void(const std::uint32_t& iEvents)>;   // Called with the ready epoll events
+using loop_task_t     = std::function<void(void)>;                           // Deferred or scheduled work
+using loop_clock_t    = std::chrono::steady_clock;                           // Clock used for timers
+using task_id_t       = std::uint64_t;                                       // Handle of a deferred or scheduled task
+
+/**
+ * EventLoop constants
+ */
+constexpr int MAX_LOOP_EVENTS = 256;     // Events collected by a single epoll_wait(2)
+constexpr std::chrono::microseconds DEFAULT_BUSY_POLL_IDLE{1000};   // Spinning without events before blocking again
+constexpr int DEFAULT_SOCKET_BUSY_POLL_US = 50;                     // SO_BUSY_POLL of the sockets of a spinning loop
+
+/**
+ * @brief Busy polling mode of an EventLoop, trading a whole core for the wake up latency of a blocking wait
+ */
+struct busy_poll_config_t {
+  bool enabled = false;
+  std::chrono::microseconds idle_fallback = DEFAULT_BUSY_POLL_IDLE;   // Idle spinning before blocking, 0 never blocks
+  int cpu = -1;                                                       // Core the loop thread is pinned to, -1 keeps it
+  int socket_busy_poll_us = DEFAULT_SOCKET_BUSY_POLL_US;              // SO_BUSY_POLL of every watched socket, 0 skips
+  bool prefer_busy_poll = true;                                       // SO_PREFER_BUSY_POLL, defers device interrupts
+};
+
+
+/**
+ * @brief Every method but stop() and post() must be called from the thread running the loop
+ */
+class EventLoop {
+public:
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+  /**
+   * @brief Default constructor
+   */
+  EventLoop(void);
+
+  /**
+   * @brief Copy constructor
+   */
+  EventLoop(const EventLoop& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Starts watching a descriptor
+   * 
+   * @param iSd
+   * @param iEvents epoll(7) event mask
+   * @param iHandler Called with the ready events, it may add or remove descriptors, itself included
+   * 
+   * @return
+   */
+  [[nodiscard]] bool add(const sd_t& iSd, const std::uint32_t& iEvents, event_handler_t iHandler);
+
+  /**
+   * @brief Changes the events watched for a descriptor
+   * 
+   * @param iSd
+   * @param iEvents
+   * 
+   * @return
+   */
+  [[nodiscard]] bool modify(const sd_t& iSd, const std::uint32_t& iEvents);
+
+  /**
+   * @brief Stops watching a descriptor
+   * 
+   * @param iSd
+   * 
+   * @return
+   */
+  bool remove(const sd_t& iSd);
+
+  /**
+   * @brief Runs iTask once, at the end of the current iteration or of the next one if none is running
+   * 
+   * @param iTask
+   * 
+   * @return Identifier usable with cancel()
+   */
+  task_id_t defer(loop_task_t iTask);
+
+  /**
+   * @brief Runs iTask once, at the end of the first iteration reaching iDeadline
+   * 
+   * @param iDeadline
+   * @param iTask
+   * 
+   * @return Identifier usable with cancel()
+   */
+  task_id_t schedule(const loop_clock_t::time_point& iDeadline, loop_task_t iTask);
+
+  /**
+   * @brief Drops a deferred or scheduled task that has not run yet
+   * 
+   * @param iTask
+   */
+  void cancel(const task_id_t& iTask);
+
+  /**
+   * @brief Runs iTask once on the thread running the loop, at the end of its current or next iteration
+   * 
+   * Callable from any thread, like stop(), it wakes the loop up if it is waiting
+   * 
+   * @param iTask
+   */
+  void post(loop_task_t iTask);
+
+  /**
+   * @brief Waits for events, dispatches them, then runs the expired timers and the deferred tasks
+   * 
+   * @param iTimeoutMs Upper bound for the wait, -1 to wait until something happens
+   * 
+   * @return Number of descriptor events dispatched
+   */
+  std::size_t run_once(const int& iTimeoutMs = -1);
+
+  /**
+   * @brief Iterates until stop() is called
+   */
+  void run(void);
+
+  /**
+   * @brief Makes run() return after the current iteration, safe to call from any thread
+   * 
+   * Called before run() starts, the next run() returns right away.
+   */
+  void stop(void);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+  /**
+   * @brief
+   * 
+   * @return Number of completed iterations
+   */
+  [[nodiscard]] const std::uint64_t& get_iteration(void) const;
+
+  /**
+   * @brief
+   * 
+   * @return Number of watched descriptors
+   */
+  [[nodiscard]] std::size_t get_watched_count(void) const;
+
+  /**
+   * @brief Accounts every iteration in iMetrics, nullptr to stop
+   * 
+   * @param iMetrics Must outlive its use by the loop
+   */
+  void set_metrics(metrics::LoopMetrics* iMetrics);
+
+  /**
+   * @brief Switches the loop between blocking waits and busy polling
+   * 
+   * Pins the calling thread, which must be the one running the loop, and sets the busy poll options of the epoll
+   * instance where the kernel supports them and of every watched socket, now and when added. Options needing
+   * privileges that are missing are skipped
+   * 
+   * @param iConfig
+   * 
+   * @return False with errno set if the thread could not be pinned
+   */
+  [[nodiscard]] bool set_busy_poll(const busy_poll_config_t& iConfig);
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] const busy_poll_config_t& get_busy_poll(void) const;
+
+  /**
+   * @brief
+   * 
+   * @return True while busy polling, false once it fell back to blocking waits after the idle period
+   */
+  [[nodiscard]] bool is_spinning(void) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+  /**
+   * @brief Copy assignment operator
+   */
+  EventLoop& operator=(const EventLoop& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+  /**
+   * @brief Destructor
+   */
+  ~EventLoop();
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+protected:
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Timeout for epoll_wait(2) honouring pending tasks and timers
+   * 
+   * @param iTimeoutMs
+   * 
+   * @return
+   */
+  [[nodiscard]] int next_timeout(const int& iTimeoutMs) const;
+
+  /**
+   * @brief Runs the expired timers and the deferred tasks
+   * 
+   * @return Tasks run
+   */
+  [[nodiscard]] std::size_t run_tasks(void);
+
+  /**
+   * @brief epoll_wait(2), spinning with a zero timeout first when busy polling
+   * 
+   * @param iTimeoutMs
+   * 
+   * @return
+   */
+  [[nodiscard]] int wait(const int& iTimeoutMs);
+
+  /**
+   * @brief Sets the busy poll socket options on iSd, ignored for descriptors that are not sockets
+   * 
+   * @param iSd
+   */
+  void prepare_busy_poll(const sd_t& iSd) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+  sd_t epollSd_;
+  sd_t wakeSd_;
+  std::atomic<bool> stopped_;
+  std::uint64_t iteration_;
+  task_id_t lastTask_;
+  metrics::LoopMetrics* metrics_;
+  busy_poll_config_t busyPoll_;
+  bool parked_;
+  std::uint64_t lastActiveNs_;
+  std::unordered_map<sd_t, std::unique_ptr<event_handler_t>> handlers_;
+  std::vector<std::unique_ptr<event_handler_t>> removed_;
+  std::vector<std::pair<task_id_t, loop_task_t>> deferred_;
+  std::vector<std::pair<task_id_t, loop_task_t>> running_;
+  std::map<std::pair<loop_clock_t::time_point, task_id_t>, loop_task_t> timers_;
+  std::unordered_map<task_id_t, loop_clock_t::time_point> timerDeadlines_;
+  std::mutex postedMutex_;
+  std::vector<loop_task_t> posted_;                   // Tasks posted by other threads
+  std::atomic<bool> hasPosted_;                       // Spares the lock to iterations with nothing posted
+  epoll_event events_[MAX_LOOP_EVENTS];
+};
+
+
+} // namespace sock
+} // namespace ncs
+
+
+#endif // NCS_EVENT_LOOP_H
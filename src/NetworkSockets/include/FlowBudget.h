@@ -0,0 +1,170 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file FlowBudget.h
+ *
+ * @brief Memory cap on the outbound bytes queued across every connection
+ */
+
+
+#ifndef NCS_FLOW_BUDGET_H
+#define NCS_FLOW_BUDGET_H
+
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace ncs { // Network Communications System
+namespace sock { // Network Communications System Sockets
+
+
+/**
+ * @brief Monitoring view of a FlowBudget
+ */
+struct flow_budget_counters_t {
+  std::size_t capacity = 0;     // Configured cap
+  std::size_t used = 0;         // Bytes currently reserved
+  std::size_t peak = 0;         // Highest reservation seen
+  std::uint64_t rejected = 0;   // Reservations refused because of the cap
+};
+
+
+/**
+ * @brief Shared by every FlowController of the process, safe to use from any thread
+ */
+class FlowBudget {
+public:
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+  /**
+   * @brief Capacity constructor
+   * 
+   * @param iCapacity Bytes that may be queued at once across all connections
+   */
+  explicit FlowBudget(const std::size_t& iCapacity);
+
+  /**
+   * @brief Copy constructor
+   */
+  FlowBudget(const FlowBudget& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Takes iSize bytes from the budget
+   * 
+   * @param iSize
+   * 
+   * @return False, without taking anything, if the cap would be exceeded
+   */
+  [[nodiscard]] bool reserve(const std::size_t& iSize);
+
+  /**
+   * @brief Gives back iSize previously reserved bytes
+   * 
+   * @param iSize
+   */
+  void release(const std::size_t& iSize);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] std::size_t get_capacity(void) const;
+
+  /**
+   * @brief
+   * 
+   * @return Bytes currently reserved
+   */
+  [[nodiscard]] std::size_t get_used(void) const;
+
+  /**
+   * @brief
+   * 
+   * @return Snapshot of the monitoring counters
+   */
+  [[nodiscard]] flow_budget_counters_t get_counters(void) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+  /**
+   * @brief Copy assignment operator
+   */
+  FlowBudget& operator=(const FlowBudget& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+  /**
+   * @brief Destructor
+   */
+  ~FlowBudget();
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+protected:
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+  const std::size_t capacity_;
+  std::atomic<std::size_t> used_;
+  std::atomic<std::size_t> peak_;
+  std::atomic<std::uint64_t> rejected_;
+};
+
+
+} // namespace sock
+} // namespace ncs
+
+
+#endif // NCS_FLOW_BUDGET_H
@@ -0,0 +1,227 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file FlowController.h
+ *
+ * @brief Tracks the outbound bytes queued on one connection and applies backpressure
+ */
+
+
+#ifndef NCS_FLOW_CONTROLLER_H
+#define NCS_FLOW_CONTROLLER_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <FlowBudget.h>
+#include <ReadGate.h>
+
+
+namespace ncs { // Network Communications System
+namespace sock { // Network Communications System Sockets
+
+
+/**
+ * FlowController types
+ */
+using watermark_handler_t = std::function<void(const std::size_t& iQueued)>;   // Called with the queued bytes
+
+/**
+ * @brief Watermarks of a single connection, low must not exceed high
+ */
+struct flow_limits_t {
+  std::size_t high_watermark = 1024 * 1024;    // Queued bytes at which the connection is saturated
+  std::size_t low_watermark = 256 * 1024;      // Queued bytes at which a saturated connection recovers
+};
+
+/**
+ * @brief Monitoring view of a FlowController
+ */
+struct flow_counters_t {
+  std::size_t peak = 0;                  // Highest amount of queued bytes seen
+  std::uint64_t high_crossings = 0;      // Times the high watermark was reached
+  std::uint64_t low_crossings = 0;       // Times the low watermark was reached while saturated
+  std::uint64_t rejected = 0;            // Reservations refused by the shared budget
+};
+
+
+/**
+ * @brief Crossing the high watermark pauses the attached upstream reads, they resume once the queue drains below the low watermark
+ */
+class FlowController {
+public:
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+  /**
+   * @brief Limits constructor
+   * 
+   * @param iLimits
+   * @param iBudget Process wide cap shared with other connections, nullptr for none
+   */
+  explicit FlowController(const flow_limits_t& iLimits = {}, FlowBudget* iBudget = nullptr);
+
+  /**
+   * @brief Copy constructor
+   */
+  FlowController(const FlowController& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Accounts for iSize newly queued bytes
+   * 
+   * @param iSize
+   * 
+   * @return False, accounting nothing, if the shared budget is exhausted
+   */
+  [[nodiscard]] bool reserve(const std::size_t& iSize);
+
+  /**
+   * @brief Accounts for iSize bytes leaving the queue
+   * 
+   * @param iSize
+   */
+  void release(const std::size_t& iSize);
+
+  /**
+   * @brief Pauses iGate while this connection is saturated
+   * 
+   * @param iGate Must outlive the controller
+   */
+  void attach_upstream(ReadGate& iGate);
+
+  /**
+   * @brief
+   * 
+   * @param iGate
+   */
+  void detach_upstream(ReadGate& iGate);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+  /**
+   * @brief
+   * 
+   * @param iHandler Called when the queue grows to the high watermark
+   */
+  void set_high_watermark_handler(watermark_handler_t iHandler);
+
+  /**
+   * @brief
+   * 
+   * @param iHandler Called when a saturated queue drains to the low watermark
+   */
+  void set_low_watermark_handler(watermark_handler_t iHandler);
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] const flow_limits_t& get_limits(void) const;
+
+  /**
+   * @brief
+   * 
+   * @return True between a high watermark crossing and the following low watermark crossing
+   */
+  [[nodiscard]] bool is_saturated(void) const;
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] const std::size_t& get_queued_size(void) const;
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] const flow_counters_t& get_counters(void) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+  /**
+   * @brief Copy assignment operator
+   */
+  FlowController& operator=(const FlowController& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+  /**
+   * @brief Destructor, gives the queued bytes back to the budget and resumes the upstreams
+   */
+  ~FlowController();
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+protected:
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+  flow_limits_t limits_;
+  FlowBudget* budget_;
+  std::size_t queued_;
+  bool saturated_;
+  flow_counters_t counters_;
+  std::vector<ReadGate*> upstreams_;
+  watermark_handler_t onHigh_;
+  watermark_handler_t onLow_;
+};
+
+
+} // namespace sock
+} // namespace ncs
+
+
+#endif // NCS_FLOW_CONTROLLER_H
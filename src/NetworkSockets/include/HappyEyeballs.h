@@ -0,0 +1,172 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file HappyEyeballs.h
+ *
+ * @brief Staggered parallel connects over several candidate addresses as described by RFC 8305
+ */
+
+
+#ifndef NCS_HAPPY_EYEBALLS_H
+#define NCS_HAPPY_EYEBALLS_H
+
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+#include <InternetAddress.h>
+#include <InternetSocket.h>
+#include <SocketProfile.h>
+
+
+namespace ncs { // Network Communications System
+namespace sock { // Network Communications System Sockets
+
+
+/**
+ * HappyEyeballs constants
+ */
+constexpr std::chrono::milliseconds DEFAULT_ATTEMPT_DELAY{250};     // Recommended Connection Attempt Delay
+constexpr std::chrono::milliseconds MIN_ATTEMPT_DELAY{10};          // Lower bound set by RFC 8305
+constexpr std::chrono::milliseconds DEFAULT_CONNECT_TIMEOUT{10000};
+
+/**
+ * @brief
+ */
+struct eyeballs_config_t {
+  std::chrono::milliseconds attempt_delay = DEFAULT_ATTEMPT_DELAY;    // Head start given to each attempt
+  std::chrono::milliseconds timeout = DEFAULT_CONNECT_TIMEOUT;        // Deadline for the whole race
+  addr::addr_family_e preferred = addr::NET_ADDR_FAM_INET6;           // Family tried first
+  std::size_t first_family_count = 1;                                 // Preferred addresses before interleaving
+  const SocketProfile* profile = nullptr;                             // Applied to every attempt before connecting
+};
+
+
+/**
+ * @brief Races non blocking connects started one attempt delay apart, keeping the first that completes
+ */
+class HappyEyeballs {
+public:
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+  /**
+   * @brief Config constructor
+   * 
+   * @param iConfig
+   */
+  explicit HappyEyeballs(const eyeballs_config_t& iConfig = eyeballs_config_t());
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Connects oSocket to the first candidate that answers
+   * 
+   * A new attempt starts every attempt delay, or right away when the previous one fails. The winner is returned in
+   * blocking mode like InternetSocket::connect() leaves it, every other attempt is closed
+   * 
+   * @param iCandidates Addresses of a single host, in resolver order
+   * @param oSocket
+   * 
+   * @return False with errno set to the last failure, ETIMEDOUT if the deadline expired first
+   */
+  [[nodiscard]] bool connect(const std::vector<addr::InternetAddress>& iCandidates, InternetSocket& oSocket);
+
+  /**
+   * @brief Interleaves the families, starting with iFirstFamilyCount addresses of iPreferred
+   * 
+   * The relative order of each family is kept
+   * 
+   * @param iCandidates
+   * @param iPreferred
+   * @param iFirstFamilyCount
+   * 
+   * @return
+   */
+  [[nodiscard]] static std::vector<addr::InternetAddress> sort(const std::vector<addr::InternetAddress>& iCandidates,
+                                                               const addr::addr_family_e& iPreferred,
+                                                               const std::size_t& iFirstFamilyCount = 1);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] const eyeballs_config_t& get_config(void) const;
+
+  /**
+   * @brief Connects started by the last connect()
+   * 
+   * @return
+   */
+  [[nodiscard]] const std::size_t& get_attempts(void) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+protected:
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+  eyeballs_config_t config_;
+  std::size_t attempts_;
+};
+
+
+} // namespace sock
+} // namespace ncs
+
+
+#endif // NCS_HAPPY_EYEBALLS_H
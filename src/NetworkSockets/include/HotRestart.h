@@ -0,0 +1,221 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file HotRestart.h
+ *
+ * @brief Hand over of listening sockets and live connections to the next process on restart
+ */
+
+
+#ifndef NCS_HOT_RESTART_H
+#define NCS_HOT_RESTART_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+
+#include <InternetSocket.h>
+
+
+namespace ncs { // Network Communications System
+namespace sock { // Network Communications System Sockets
+
+
+/**
+ * HotRestart constants
+ *
+ * Every message is a header, HANDOFF_MAGIC, the version and a record count, followed by the records, one per
+ * descriptor of its SCM_RIGHTS control message: the handoff_kind_e of the socket and its address in the layout of
+ * AddressCodec.h. The previous process sends as many messages as it needs and an empty one, the successor answers
+ * with an empty one once it holds every descriptor.
+ */
+constexpr int DEFAULT_HANDOFF_TIMEOUT_MS = 5000;
+constexpr std::size_t HANDOFF_BATCH = 64;                  // Descriptors per message, SCM_MAX_FD is 253
+constexpr std::size_t HANDOFF_HEADER_SIZE = 4;
+constexpr std::uint8_t HANDOFF_MAGIC[2] = {'N', 'H'};
+constexpr std::uint8_t HANDOFF_VERSION = 1;
+
+/**
+ * @brief
+ */
+enum handoff_kind_e : std::uint8_t {
+  HANDOFF_LISTENER   = 1,
+  HANDOFF_CONNECTION = 2,
+};
+
+
+/**
+ * @brief Passes socket descriptors and their addresses to a successor process over a Unix socket with SCM_RIGHTS
+ */
+class HotRestart {
+public:
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+  /**
+   * @brief Default constructor
+   */
+  HotRestart();
+
+  /**
+   * @brief Copy constructor
+   */
+  HotRestart(const HotRestart& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Waits for a successor on the Unix socket at iPath, replacing a file left there by a previous process
+   * 
+   * The descriptor of get_sd() turns readable when a successor connects, callers add it to their loop and call
+   * hand_over() then.
+   * 
+   * @param iPath
+   * 
+   * @return False, with errno set
+   */
+  [[nodiscard]] bool listen(const std::string& iPath);
+
+  /**
+   * @brief Passes iListeners and iConnections to the next successor that connects within iTimeoutMs
+   * 
+   * The sockets stay open here: both processes share them until this one closes its descriptors. Once this returns
+   * true this process must stop watching them before its loop dispatches anything else, then close them and finish
+   * whatever it has in flight. On failure nothing changed and it can keep serving. Connections must be handed over
+   * between requests, data already read from them stays here.
+   * 
+   * @param iListeners
+   * @param iConnections
+   * @param iTimeoutMs For the successor to connect, then for each message and its acknowledgement
+   * 
+   * @return False, with errno set, ETIMEDOUT if no successor connected or acknowledged
+   */
+  [[nodiscard]] bool hand_over(const std::vector<const InternetSocket*>& iListeners,
+                               const std::vector<const InternetSocket*>& iConnections,
+                               const int& iTimeoutMs = DEFAULT_HANDOFF_TIMEOUT_MS);
+
+  /**
+   * @brief Takes over the sockets of the process listening at iPath
+   * 
+   * Each socket comes with the address it had in the previous process, the bound one of a listener and the peer one
+   * of a connection. Received descriptors are close on exec and in the blocking mode they had there.
+   * 
+   * @param iPath
+   * @param oListeners
+   * @param oConnections
+   * @param iTimeoutMs For each message
+   * 
+   * @return False, with errno set and nothing taken, EPROTO if the previous process spoke another version
+   */
+  [[nodiscard]] static bool take_over(const std::string& iPath, std::vector<InternetSocket>& oListeners,
+                                      std::vector<InternetSocket>& oConnections,
+                                      const int& iTimeoutMs = DEFAULT_HANDOFF_TIMEOUT_MS);
+
+  /**
+   * @brief Stops waiting for successors, removing the socket file unless a successor bound its own there
+   */
+  void close(void);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] const sd_t& get_sd(void) const;
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] const std::string& get_path(void) const;
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] bool is_listening(void) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+  /**
+   * @brief Copy assignment operator
+   */
+  HotRestart& operator=(const HotRestart& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+  /**
+   * @brief Destructor
+   */
+  ~HotRestart();
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+protected:
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+  std::string path_;
+  sd_t sd_;
+  dev_t device_;                                // Identify the socket file this process created at path_
+  ino_t inode_;
+};
+
+
+} // namespace sock
+} // namespace ncs
+
+
+#endif // NCS_HOT_RESTART_H
@@ -13,7 +13,12 @@
 #define NCS_INTERNET_SOCKET_H
 
 #include <InternetAddress.h>
+#include <SocketMetrics.h>
 #include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include <type_traits>
 
 namespace ncs {   // Network Communications System
 namespace sock {  // Network Communications System Sockets
@@ -35,9 +40,9 @@ public:
   InternetSocket(void);
 
   /**
-   * @brief Copy constructor
+   * @brief Copy constructor, a descriptor has a single owner
    */
-  InternetSocket(const InternetSocket& other);
+  InternetSocket(const InternetSocket& other) = delete;
 
   /**
    * @brief Move constructor
@@ -46,6 +51,154 @@ public:
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Creates the underlying socket descriptor, closing any previous one
+   * 
+   * @param iFamily NET_ADDR_FAM_INET or NET_ADDR_FAM_INET6
+   * @param iType
+   * 
+   * @return
+   */
+  [[nodiscard]] bool open(const addr::addr_family_e& iFamily, const int& iType = SOCK_STREAM);
+
+  /**
+   * @brief Binds the socket, opening it first if needed. The bound address, with the port picked by
+   *        the kernel when RANDOM_PORT is requested, is stored as the socket address.
+   * 
+   * @param iAddr
+   * 
+   * @return
+   */
+  [[nodiscard]] bool bind(const addr::InternetAddress& iAddr);
+
+  /**
+   * @brief
+   * 
+   * @param iBacklog
+   * 
+   * @return
+   */
+  [[nodiscard]] bool listen(const int& iBacklog = SOMAXCONN);
+
+  /**
+   * @brief Connects the socket, opening it first if needed. The peer becomes the socket address.
+   * 
+   * @param iAddr
+   * 
+   * @return True once connected, or while in progress (errno EINPROGRESS) on a non blocking socket, also when a
+   *         signal interrupted it. A blocking socket interrupted by a signal waits for the connection to complete
+   */
+  [[nodiscard]] bool connect(const addr::InternetAddress& iAddr);
+
+  /**
+   * @brief Accepts a pending connection, the new socket is stored in oClient with the peer address
+   * 
+   * @param oClient
+   * @param iFlags accept4(2) flags, SOCK_CLOEXEC is always added
+   * 
+   * @return
+   */
+  [[nodiscard]] bool accept(InternetSocket& oClient, const int& iFlags = 0) const;
+
+  /**
+   * @brief
+   * 
+   * @param iEnabled
+   * 
+   * @return
+   */
+  [[nodiscard]] bool set_non_blocking(const bool& iEnabled);
+
+  /**
+   * @brief Closes the descriptor if open
+   * 
+   * @return False if close(2) reported an error
+   */
+  bool close(void);
+
+  /**
+   * @brief Shuts down one or both directions of the connection, keeping the descriptor open
+   * 
+   * @param iHow SHUT_RD, SHUT_WR or SHUT_RDWR
+   * 
+   * @return
+   */
+  [[nodiscard]] bool shutdown(const int& iHow = SHUT_WR) const;
+
+  /**
+   * @brief Sends a contiguous buffer through the socket
+   * 
+   * @param iData
+   * @param iSize
+   * @param iFlags Additional send(2) flags, MSG_NOSIGNAL is always added
+   * 
+   * @return Number of bytes sent, or -1 with errno set
+   */
+  [[nodiscard]] ssize_t send(const void* iData, const size_t& iSize, const int& iFlags = 0) const;
+
+  /**
+   * @brief Sends several buffers with a single scatter/gather call
+   * 
+   * @param iIov
+   * @param iCount
+   * @param iFlags Additional sendmsg(2) flags, MSG_NOSIGNAL is always added
+   * 
+   * @return Number of bytes sent, or -1 with errno set
+   */
+  [[nodiscard]] ssize_t send_v(const iovec* iIov, const size_t& iCount, const int& iFlags = 0) const;
+
+  /**
+   * @brief Receives up to iSize bytes from the socket
+   * 
+   * @param oData
+   * @param iSize
+   * @param iFlags
+   * 
+   * @return Number of bytes received, 0 on orderly shutdown, or -1 with errno set
+   */
+  [[nodiscard]] ssize_t recv(void* oData, const size_t& iSize, const int& iFlags = 0) const;
+
+  /**
+   * @brief Sets an integer socket option
+   * 
+   * @param iLevel
+   * @param iName
+   * @param iValue
+   * 
+   * @return False with errno set by setsockopt(2)
+   */
+  [[nodiscard]] bool set_option(const int& iLevel, const int& iName, const int& iValue) const;
+
+  /**
+   * @brief Reads an integer socket option back from the kernel
+   * 
+   * @param iLevel
+   * @param iName
+   * @param oValue
+   * 
+   * @return False with errno set by getsockopt(2)
+   */
+  [[nodiscard]] bool get_option(const int& iLevel, const int& iName, int& oValue) const;
+
+  /**
+   * @brief Sets the option named by a SocketOptions.h tag, the value type is checked at compile time
+   * 
+   * @param iValue
+   * 
+   * @return False with errno set by setsockopt(2)
+   */
+  template <typename Option>
+  [[nodiscard]] bool set_option(const typename Option::value_t& iValue) const;
+
+  /**
+   * @brief Reads back the option named by a SocketOptions.h tag
+   * 
+   * @param oValue Effective value, which the kernel may have adjusted
+   * 
+   * @return False with errno set by getsockopt(2)
+   */
+  template <typename Option>
+  [[nodiscard]] bool get_option(typename Option::value_t& oValue) const;
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
@@ -62,6 +215,13 @@ public:
    * @param iAddr 
    */
   void set_addr(const addr::InternetAddress& iAddr);
+
+  /**
+   * @brief Accounts every send and receive in iMetrics, nullptr to stop
+   * 
+   * @param iMetrics Must outlive its use by the socket
+   */
+  void set_metrics(metrics::SocketMetrics* iMetrics);
   
   /**
    * @brief
@@ -76,6 +236,27 @@ public:
    * @return
    */
   [[nodiscard]] const addr::InternetAddress& get_addr(void) const;
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] bool is_open(void) const;
+
+  /**
+   * @brief Family the descriptor was opened with, which the address may not tell before connecting
+   * 
+   * @return NET_ADDR_FAM_UNSPEC if the socket is not open
+   */
+  [[nodiscard]] addr::addr_family_e get_address_family(void) const;
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] metrics::SocketMetrics* get_metrics(void) const;
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
@@ -84,16 +265,12 @@ public:
 /// PUBLIC //////////////////////////////////////      OPERATORS      //////////////////////////////////////////////////
 
   /**
-   * @brief Copy assignment operator
-   * 
-   * @param iOther
-   * 
-   * @return
+   * @brief Copy assignment operator, a descriptor has a single owner
    */
-  InternetSocket& operator=(const InternetSocket& iOther);
+  InternetSocket& operator=(const InternetSocket& iOther) = delete;
 
   /**
-   * @brief Move assignment operator
+   * @brief Move assignment operator, closes the descriptor held until then
    * 
    * @param iOther
    * 
@@ -116,7 +293,7 @@ public:
 
 /// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
   /**
-   * @brief Destructor
+   * @brief Destructor, closes the descriptor if open
    */
   ~InternetSocket();
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -162,8 +339,46 @@ private:
 private:
   sd_t sd_;
   addr::InternetAddress addr_;
+  metrics::SocketMetrics* metrics_;
 };
 
+/**
+ * @brief Sets the option named by a SocketOptions.h tag
+ * 
+ * @param iValue
+ * 
+ * @return
+ */
+template <typename Option>
+[[nodiscard]] bool InternetSocket::set_option(const typename Option::value_t& iValue) const {
+  static_assert(std::is_integral<typename Option::value_t>::value, "socket options carry integral values");
+  if (((Option::LEVEL_V6 != Option::LEVEL) || (Option::NAME_V6 != Option::NAME)) &&
+      (this->get_address_family() == addr::NET_ADDR_FAM_INET6)) {
+    return this->set_option(Option::LEVEL_V6, Option::NAME_V6, static_cast<int>(iValue));
+  }
+  return this->set_option(Option::LEVEL, Option::NAME, static_cast<int>(iValue));
+}
+
+/**
+ * @brief Reads back the option named by a SocketOptions.h tag
+ * 
+ * @param oValue
+ * 
+ * @return
+ */
+template <typename Option>
+[[nodiscard]] bool InternetSocket::get_option(typename Option::value_t& oValue) const {
+  static_assert(std::is_integral<typename Option::value_t>::value, "socket options carry integral values");
+  int value = 0;
+  const bool v6 = ((Option::LEVEL_V6 != Option::LEVEL) || (Option::NAME_V6 != Option::NAME)) &&
+                  (this->get_address_family() == addr::NET_ADDR_FAM_INET6);
+  if (!this->get_option(v6 ? Option::LEVEL_V6 : Option::LEVEL, v6 ? Option::NAME_V6 : Option::NAME, value)) {
+    return false;
+  }
+  oValue = static_cast<typename Option::value_t>(value);
+  return true;
+}
+
 }  // namespace sock
 }  // namespace ncs
 
@@ -0,0 +1,325 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file MulticastFanout.h
+ *
+ * @brief Hands every received multicast datagram to the in process subscribers of its group
+ */
+
+
+#ifndef NCS_MULTICAST_FANOUT_H
+#define NCS_MULTICAST_FANOUT_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include <InternetAddress.h>
+#include <MulticastSocket.h>
+
+
+namespace ncs { // Network Communications System
+namespace sock { // Network Communications System Sockets
+
+
+/**
+ * MulticastFanout constants
+ */
+constexpr std::size_t DEFAULT_FANOUT_BATCH = 32;      // Datagrams received per recvmmsg(2) call
+constexpr std::size_t DEFAULT_DATAGRAM_SIZE = 2048;   // Larger datagrams are truncated
+
+/**
+ * @brief
+ */
+struct fanout_config_t {
+  std::size_t batch = DEFAULT_FANOUT_BATCH;
+  std::size_t datagram_size = DEFAULT_DATAGRAM_SIZE;
+  unsigned int ifindex = 0;                           // Interface the groups are joined on, 0 for the routing table
+};
+
+/**
+ * @brief Received datagram lent to the subscribers, the data is only valid during the handler call
+ */
+struct datagram_t {
+  const std::uint8_t* data = nullptr;
+  std::size_t size = 0;
+  const sockaddr* source = nullptr;
+  socklen_t source_size = 0;
+  bool truncated = false;                             // Larger than datagram_size, the tail was dropped
+};
+
+/**
+ * @brief
+ */
+struct fanout_stats_t {
+  std::uint64_t datagrams = 0;
+  std::uint64_t deliveries = 0;                       // Handler calls, a datagram counts once per subscriber
+  std::uint64_t unmatched = 0;                        // Datagrams no subscriber wanted
+  std::uint64_t truncated = 0;
+};
+
+/**
+ * @brief Group or source address in network byte order, IPv4 addresses use the first 4 bytes
+ */
+struct group_key_t {
+  int family = AF_UNSPEC;
+  std::uint8_t bytes[sizeof(in6_addr)] = {};
+};
+
+using subscription_id_t = std::uint64_t;
+using datagram_handler_t = std::function<void(const datagram_t& iDatagram)>;
+
+/**
+ * @brief
+ */
+struct fanout_subscription_t {
+  subscription_id_t id = 0;
+  group_key_t key;
+  addr::InternetAddress group;
+  addr::InternetAddress source;
+  group_key_t sourceKey;                              // Set when specific
+  bool specific = false;                              // Joined for source only
+  bool active = true;                                 // Cleared by unsubscribe(), erased once no batch is dispatching
+  datagram_handler_t handler;
+};
+
+
+/**
+ * @brief Receives batches of datagrams into preallocated buffers and lends each one to every subscriber of its group
+ */
+class MulticastFanout {
+public:
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+  /**
+   * @brief Socket constructor
+   * 
+   * @param ioSocket Opened and bound on the group port, must outlive the fanout
+   * @param iConfig
+   */
+  explicit MulticastFanout(MulticastSocket& ioSocket, const fanout_config_t& iConfig = fanout_config_t());
+
+  /**
+   * @brief Copy constructor
+   */
+  MulticastFanout(const MulticastFanout& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Delivers the datagrams sent to iGroup to iHandler, joining the group for the first subscriber
+   * 
+   * @param iGroup
+   * @param iHandler
+   * 
+   * @return Subscription id, 0 with errno set if the group could not be joined
+   */
+  [[nodiscard]] subscription_id_t subscribe(const addr::InternetAddress& iGroup, datagram_handler_t iHandler);
+
+  /**
+   * @brief Delivers the datagrams sent to iGroup to iHandler, joining the group for iSource only
+   * 
+   * Datagrams of the group sent by other sources, joined by another subscription, are not delivered to it
+   * 
+   * @param iGroup
+   * @param iSource
+   * @param iHandler
+   * 
+   * @return Subscription id, 0 with errno set if the group could not be joined
+   */
+  [[nodiscard]] subscription_id_t subscribe(const addr::InternetAddress& iGroup, const addr::InternetAddress& iSource,
+                                            datagram_handler_t iHandler);
+
+  /**
+   * @brief Drops a subscription, leaving its group after the last subscriber. Safe to call from a handler
+   * 
+   * @param iId
+   * 
+   * @return False if iId is unknown or the group could not be left
+   */
+  bool unsubscribe(const subscription_id_t& iId);
+
+  /**
+   * @brief Drops every subscription and leaves their groups
+   */
+  void clear(void);
+
+  /**
+   * @brief Receives one batch of datagrams without blocking and hands them to the subscribers
+   * 
+   * @return Datagrams received, 0 if there were none
+   */
+  std::size_t poll(void);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] const fanout_stats_t& get_stats(void) const;
+
+  /**
+   * @brief Active subscriptions
+   * 
+   * @return
+   */
+  [[nodiscard]] std::size_t get_subscribers(void) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+  /**
+   * @brief Copy assignment operator
+   */
+  MulticastFanout& operator=(const MulticastFanout& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+  /**
+   * @brief Destructor, leaves the joined groups
+   */
+  ~MulticastFanout();
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+protected:
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Joins the membership of a new subscription unless another one already holds it
+   * 
+   * @param iGroup
+   * @param iSource nullptr for any source
+   * @param iHandler
+   * 
+   * @return
+   */
+  [[nodiscard]] subscription_id_t add(const addr::InternetAddress& iGroup, const addr::InternetAddress* iSource,
+                                      datagram_handler_t iHandler);
+
+  /**
+   * @brief Whether an active subscription other than iSubscription holds its membership
+   * 
+   * @param iSubscription
+   * 
+   * @return
+   */
+  [[nodiscard]] bool is_shared(const fanout_subscription_t& iSubscription) const;
+
+  /**
+   * @brief Hands one received datagram to the subscribers of its destination group
+   * 
+   * @param iMessage
+   * @param iData
+   * @param iSize
+   * @param iSubscribers Subscriptions present when the batch started
+   */
+  void dispatch(const msghdr& iMessage, const std::uint8_t* iData, const std::size_t& iSize,
+                const std::size_t& iSubscribers);
+
+  /**
+   * @brief Erases the subscriptions dropped while dispatching
+   */
+  void compact(void);
+
+  /**
+   * @brief Binary form of a group address
+   * 
+   * @param iGroup
+   * @param oKey
+   * 
+   * @return
+   */
+  [[nodiscard]] static bool make_key(const addr::InternetAddress& iGroup, group_key_t& oKey);
+
+  /**
+   * @brief Destination group of a datagram, read from its IP_PKTINFO or IPV6_PKTINFO control message
+   * 
+   * @param iMessage
+   * @param oKey
+   * 
+   * @return
+   */
+  [[nodiscard]] static bool destination(const msghdr& iMessage, group_key_t& oKey);
+
+  /**
+   * @brief Source of a datagram, read from its name, IPv4 mapped sources get the IPv4 key
+   * 
+   * @param iMessage
+   * @param oKey
+   * 
+   * @return
+   */
+  [[nodiscard]] static bool origin(const msghdr& iMessage, group_key_t& oKey);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+  MulticastSocket& socket_;
+  fanout_config_t config_;
+  std::vector<std::unique_ptr<fanout_subscription_t>> subscriptions_;   // Stable while handlers add more
+  subscription_id_t nextId_;
+  bool dispatching_;
+  std::vector<std::uint8_t> buffers_;                                    // One datagram_size slot per message
+  std::vector<std::uint8_t> controls_;
+  std::vector<sockaddr_storage> sources_;
+  std::vector<iovec> iovs_;
+  std::vector<mmsghdr> messages_;
+  fanout_stats_t stats_;
+};
+
+
+} // namespace sock
+} // namespace ncs
+
+
+#endif // NCS_MULTICAST_FANOUT_H
@@ -0,0 +1,317 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file MulticastSocket.h
+ *
+ * @brief UDP socket joining IPv4 and IPv6 multicast groups
+ */
+
+
+#ifndef NCS_MULTICAST_SOCKET_H
+#define NCS_MULTICAST_SOCKET_H
+
+
+#include <cstddef>
+
+#include <sys/socket.h>
+#include <sys/types.h>
+
+#include <FixedAddress.h>
+#include <InternetAddress.h>
+#include <InternetSocket.h>
+#include <SocketOptions.h>
+
+
+namespace ncs { // Network Communications System
+namespace sock { // Network Communications System Sockets
+
+
+/**
+ * @brief Datagram socket managing group memberships, any source and source specific, and the multicast send options
+ */
+class MulticastSocket {
+public:
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+  /**
+   * @brief Default constructor
+   */
+  MulticastSocket(void);
+
+  /**
+   * @brief Copy constructor
+   */
+  MulticastSocket(const MulticastSocket& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Opens a datagram socket that reports the destination group of every received datagram
+   * 
+   * @param iFamily
+   * @param iType Socket type flags added to SOCK_DGRAM, e.g. SOCK_NONBLOCK
+   * 
+   * @return
+   */
+  [[nodiscard]] bool open(const addr::addr_family_e& iFamily, const int& iType = 0);
+
+  /**
+   * @brief Binds the socket, opening it first if needed
+   * 
+   * Receivers bind the wildcard address on the group port, SO_REUSEADDR lets several of them share it
+   * 
+   * @param iAddr
+   * 
+   * @return
+   */
+  [[nodiscard]] bool bind(const addr::InternetAddress& iAddr);
+
+  /**
+   * @brief Joins iGroup, receiving from any source
+   * 
+   * @param iGroup Port ignored, any valid one will do
+   * @param iIfindex Interface to join on, 0 lets the routing table pick it
+   * 
+   * @return False with errno EINVAL if iGroup is not a multicast address
+   */
+  [[nodiscard]] bool join(const addr::InternetAddress& iGroup, const unsigned int& iIfindex = 0);
+
+  /**
+   * @brief Joins iGroup, receiving only from iSource
+   * 
+   * @param iGroup Port ignored, any valid one will do
+   * @param iSource Port ignored, any valid one will do
+   * @param iIfindex Interface to join on, 0 lets the routing table pick it
+   * 
+   * @return False with errno EINVAL if iGroup is not a multicast address
+   */
+  [[nodiscard]] bool join(const addr::InternetAddress& iGroup, const addr::InternetAddress& iSource,
+                          const unsigned int& iIfindex = 0);
+
+  /**
+   * @brief Leaves a group joined from any source
+   * 
+   * @param iGroup
+   * @param iIfindex Same interface given to join()
+   * 
+   * @return
+   */
+  [[nodiscard]] bool leave(const addr::InternetAddress& iGroup, const unsigned int& iIfindex = 0);
+
+  /**
+   * @brief Leaves a group joined for iSource only
+   * 
+   * @param iGroup
+   * @param iSource
+   * @param iIfindex Same interface given to join()
+   * 
+   * @return
+   */
+  [[nodiscard]] bool leave(const addr::InternetAddress& iGroup, const addr::InternetAddress& iSource,
+                           const unsigned int& iIfindex = 0);
+
+  /**
+   * @brief Sends one datagram to iGroup
+   * 
+   * @param iData
+   * @param iSize
+   * @param iGroup
+   * 
+   * @return Bytes sent or -1 with errno set
+   */
+  [[nodiscard]] ssize_t send_to(const void* iData, const std::size_t& iSize,
+                                const addr::InternetAddress& iGroup) const;
+
+  /**
+   * @brief Sends one datagram to an already encoded group, skipping the text parsing of the other overload
+   * 
+   * @param iData
+   * @param iSize
+   * @param iGroup
+   * 
+   * @return Bytes sent or -1 with errno set
+   */
+  template <addr::addr_family_e Family>
+  [[nodiscard]] ssize_t send_to(const void* iData, const std::size_t& iSize,
+                                const addr::FixedAddress<Family>& iGroup) const;
+
+  /**
+   * @brief Receives one datagram
+   * 
+   * @param oData
+   * @param iSize
+   * @param oSource Sender of the datagram
+   * @param iFlags Additional recvfrom(2) flags
+   * 
+   * @return Bytes received or -1 with errno set
+   */
+  [[nodiscard]] ssize_t recv_from(void* oData, const std::size_t& iSize, addr::InternetAddress& oSource,
+                                  const int& iFlags = 0) const;
+
+  /**
+   * @brief Closes the socket, the kernel drops its memberships
+   * 
+   * @return
+   */
+  bool close(void);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+  /**
+   * @brief Hops the sent datagrams may travel, 1 by default keeps them on the local network
+   * 
+   * @param iTtl
+   * 
+   * @return
+   */
+  [[nodiscard]] bool set_ttl(const int& iTtl);
+
+  /**
+   * @brief Whether the sent datagrams are also delivered to the members on this host, on by default
+   * 
+   * @param iEnabled
+   * 
+   * @return
+   */
+  [[nodiscard]] bool set_loopback(const bool& iEnabled);
+
+  /**
+   * @brief Interface the datagrams are sent from
+   * 
+   * @param iIfindex 0 lets the routing table pick it
+   * 
+   * @return
+   */
+  [[nodiscard]] bool set_interface(const unsigned int& iIfindex);
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] const InternetSocket& get_socket(void) const;
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] addr::addr_family_e get_address_family(void) const;
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] bool is_open(void) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+  /**
+   * @brief Copy assignment operator
+   */
+  MulticastSocket& operator=(const MulticastSocket& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+  /**
+   * @brief Destructor, closes the socket
+   */
+  ~MulticastSocket();
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+protected:
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Adds or drops a membership with the protocol independent MCAST_* options
+   * 
+   * @param iOption MCAST_JOIN_GROUP, MCAST_LEAVE_GROUP, MCAST_JOIN_SOURCE_GROUP or MCAST_LEAVE_SOURCE_GROUP
+   * @param iGroup
+   * @param iSource nullptr for any source
+   * @param iIfindex
+   * 
+   * @return
+   */
+  [[nodiscard]] bool membership(const int& iOption, const addr::InternetAddress& iGroup,
+                                const addr::InternetAddress* iSource, const unsigned int& iIfindex);
+
+  /**
+   * @brief Level of the multicast options for the family of the socket
+   * 
+   * @return
+   */
+  [[nodiscard]] int level(void) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+  InternetSocket socket_;
+  addr::addr_family_e family_;
+};
+
+/**
+ * @brief Sends one datagram to an already encoded group
+ * 
+ * @param iData
+ * @param iSize
+ * @param iGroup
+ * 
+ * @return
+ */
+template <addr::addr_family_e Family>
+[[nodiscard]] ssize_t MulticastSocket::send_to(const void* iData, const std::size_t& iSize,
+                                               const addr::FixedAddress<Family>& iGroup) const {
+  return ::sendto(this->socket_.get_sd(), iData, iSize, MSG_NOSIGNAL, iGroup.get_sockaddr(),
+                  iGroup.get_sockaddr_size());
+}
+
+
+} // namespace sock
+} // namespace ncs
+
+
+#endif // NCS_MULTICAST_SOCKET_H
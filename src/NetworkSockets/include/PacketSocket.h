@@ -0,0 +1,325 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file PacketSocket.h
+ *
+ * @brief AF_PACKET socket with TPACKET_V3 memory mapped receive and transmit rings
+ */
+
+
+#ifndef NCS_PACKET_SOCKET_H
+#define NCS_PACKET_SOCKET_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <linux/filter.h>
+#include <linux/if_ether.h>
+#include <linux/if_packet.h>
+#include <sys/uio.h>
+
+#include <InternetSocket.h>
+
+
+namespace ncs { // Network Communications System
+namespace sock { // Network Communications System Sockets
+
+
+/**
+ * PacketSocket types
+ */
+enum fanout_mode_e {
+  FANOUT_HASH       = PACKET_FANOUT_HASH,       // Keeps every flow on the same member
+  FANOUT_LB         = PACKET_FANOUT_LB,         // Round robin
+  FANOUT_CPU        = PACKET_FANOUT_CPU,        // Member chosen by the receiving CPU
+  FANOUT_ROLLOVER   = PACKET_FANOUT_ROLLOVER,   // Fill one member before moving to the next
+  FANOUT_QM         = PACKET_FANOUT_QM          // Member chosen by the receive queue
+};
+
+/**
+ * @brief Classic BPF program, see ethertype_filter()
+ */
+typedef std::vector<sock_filter> packet_filter_t;
+
+/**
+ * @brief Ring geometry and binding of a PacketSocket
+ */
+struct packet_config_t {
+  int ifindex = 0;                                      // 0 captures on every interface, TX requires one
+  std::uint16_t protocol = ETH_P_ALL;                   // Host order ethertype to capture
+  std::uint32_t block_size = 1 << 20;                   // RX block, multiple of the page size
+  std::uint32_t block_count = 64;
+  std::uint32_t frame_size = 2048;                      // Only used by the kernel to size the ring
+  std::uint32_t block_timeout_ms = 10;                  // Retire a partially filled block after this time
+  std::uint32_t tx_frame_size = 2048;                   // TX slot, holds the header and one frame
+  std::uint32_t tx_frame_count = 1024;                  // 0 disables the TX ring
+  packet_filter_t filter;                               // Attached before binding so nothing slips through
+};
+
+/**
+ * @brief View of a frame inside a retired block
+ */
+struct packet_frame_t {
+  const std::uint8_t* data = nullptr;                   // Link layer header onwards
+  std::uint32_t size = 0;                               // Captured bytes
+  std::uint32_t length = 0;                             // Bytes on the wire
+  std::uint64_t timestamp_ns = 0;
+  std::uint32_t rxhash = 0;
+  int ifindex = 0;
+  std::uint8_t type = 0;                                // PACKET_HOST, PACKET_OUTGOING, ...
+};
+
+/**
+ * @brief
+ */
+struct packet_stats_t {
+  std::uint64_t blocks = 0;                             // Blocks consumed
+  std::uint64_t rx_packets = 0;
+  std::uint64_t tx_packets = 0;                         // Frames queued on the TX ring
+  std::uint64_t kernel_packets = 0;                     // Frames that reached the socket
+  std::uint64_t kernel_drops = 0;                       // Frames lost because every block was busy
+  std::uint64_t kernel_freezes = 0;                     // Times the ring ran out of free blocks
+};
+
+
+/**
+ * @brief Every method must be called from the same thread, use one socket per thread joined to a fanout group
+ */
+class PacketSocket {
+public:
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+  /**
+   * @brief Default constructor
+   */
+  PacketSocket(void);
+
+  /**
+   * @brief Copy constructor
+   */
+  PacketSocket(const PacketSocket& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Creates the socket, attaches the filter, maps the rings and binds to the interface
+   * 
+   * @param iConfig
+   * 
+   * @return False with errno set if any step fails, the socket is left closed
+   */
+  [[nodiscard]] bool open(const packet_config_t& iConfig);
+
+  /**
+   * @brief Unmaps the rings and closes the descriptor
+   */
+  void close(void);
+
+  /**
+   * @brief Joins a fanout group, the kernel then spreads packets across its members
+   * 
+   * @param iGroup Identifier shared by every member of the group
+   * @param iMode
+   * @param iFlags PACKET_FANOUT_FLAG_* bits
+   * 
+   * @return
+   */
+  [[nodiscard]] bool join_fanout(const std::uint16_t& iGroup, const fanout_mode_e& iMode,
+                                 const std::uint16_t& iFlags = PACKET_FANOUT_FLAG_DEFRAG);
+
+  /**
+   * @brief Replaces the classic BPF filter, an empty program removes it
+   * 
+   * @param iFilter
+   * 
+   * @return
+   */
+  [[nodiscard]] bool set_filter(const packet_filter_t& iFilter);
+
+  /**
+   * @brief Hands back the block taken by the previous call and takes the next retired one
+   * 
+   * One call consumes a whole block, the frame views stay valid until the next receive() or release()
+   * 
+   * @param oFrames Cleared and filled with every frame of the block
+   * 
+   * @return Frames in the block, 0 if none is ready
+   */
+  std::size_t receive(std::vector<packet_frame_t>& oFrames);
+
+  /**
+   * @brief Hands the block taken by receive() back to the kernel
+   */
+  void release(void);
+
+  /**
+   * @brief Waits until a block is retired
+   * 
+   * @param iTimeoutMs -1 waits forever
+   * 
+   * @return False on timeout or error
+   */
+  [[nodiscard]] bool wait(const int& iTimeoutMs) const;
+
+  /**
+   * @brief Copies the frames into free TX slots and flushes them with a single syscall
+   * 
+   * @param iFrames Complete link layer frames
+   * @param iCount
+   * 
+   * @return Frames queued, stops at the first one that does not fit or when the ring is full
+   */
+  std::size_t send(const iovec* iFrames, const std::size_t& iCount);
+
+  /**
+   * @brief Asks the kernel to transmit every queued slot
+   * 
+   * @return False on a fatal error, a busy ring is not an error
+   */
+  bool flush(void);
+
+  /**
+   * @brief Accepts only frames of the given ethertype
+   * 
+   * @param iEthertype Host order
+   * 
+   * @return
+   */
+  [[nodiscard]] static packet_filter_t ethertype_filter(const std::uint16_t& iEthertype);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] bool is_open(void) const;
+
+  /**
+   * @brief Descriptor to poll for readability
+   * 
+   * @return
+   */
+  [[nodiscard]] const sd_t& get_sd(void) const;
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] const packet_config_t& get_config(void) const;
+
+  /**
+   * @brief Local counters merged with PACKET_STATISTICS
+   * 
+   * @return
+   */
+  [[nodiscard]] packet_stats_t get_stats(void) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+  /**
+   * @brief Copy assignment operator
+   */
+  PacketSocket& operator=(const PacketSocket& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+  /**
+   * @brief Destructor
+   */
+  ~PacketSocket();
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+protected:
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Closes everything opened so far keeping the errno of the failed step
+   * 
+   * @return Always false
+   */
+  bool fail(void);
+
+  /**
+   * @brief Address of a TX slot
+   * 
+   * @param iSlot
+   * 
+   * @return
+   */
+  [[nodiscard]] std::uint8_t* tx_slot(const std::uint32_t& iSlot) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+  packet_config_t config_;
+  sd_t sd_;
+  std::uint8_t* map_;
+  std::size_t mapSize_;
+  std::uint8_t* txRing_;
+  std::uint32_t txSlots_;
+  std::uint32_t txPerBlock_;
+  std::uint32_t txNext_;
+  std::uint32_t rxNext_;
+  bool holding_;
+  std::uint64_t blocks_;
+  std::uint64_t rxPackets_;
+  std::uint64_t txPackets_;
+  mutable std::uint64_t kernelPackets_;     // PACKET_STATISTICS resets on every read
+  mutable std::uint64_t kernelDrops_;
+  mutable std::uint64_t kernelFreezes_;
+};
+
+
+} // namespace sock
+} // namespace ncs
+
+
+#endif // NCS_PACKET_SOCKET_H
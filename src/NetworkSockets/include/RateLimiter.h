@@ -0,0 +1,225 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file RateLimiter.h
+ *
+ * @brief Per source connection rate limiting for the accept path
+ */
+
+
+#ifndef NCS_RATE_LIMITER_H
+#define NCS_RATE_LIMITER_H
+
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <sys/socket.h>
+
+#include <InternetAddress.h>
+
+
+namespace ncs { // Network Communications System
+namespace sock { // Network Communications System Sockets
+
+
+/**
+ * RateLimiter constants
+ */
+constexpr std::size_t DEFAULT_RATE_LIMIT_SLOTS = 65536;     // Sources tracked at once
+constexpr std::size_t RATE_LIMIT_BUCKET_SLOTS = 4;          // Sources sharing one cache line
+
+/**
+ * @brief
+ */
+struct rate_limit_config_t {
+  std::uint64_t rate = 100;                         // Connections per second each source is entitled to, 0 for no limit
+  std::uint64_t burst = 20;                         // Connections a quiet source may open back to back
+  std::uint8_t prefix_v4 = 32;                      // Leading bits of a source address that identify it
+  std::uint8_t prefix_v6 = 64;                      // A /64 usually belongs to a single host
+  std::size_t slots = DEFAULT_RATE_LIMIT_SLOTS;
+};
+
+/**
+ * @brief Sources whose keys hash to the same bucket, the theoretical arrival time of each one next to its key
+ */
+struct alignas(64) rate_limit_bucket_t {
+  std::atomic<std::uint64_t> keys[RATE_LIMIT_BUCKET_SLOTS];   // 0 for a free slot
+  std::atomic<std::uint64_t> tats[RATE_LIMIT_BUCKET_SLOTS];
+};
+
+
+/**
+ * @brief GCRA over a fixed table of source prefixes, shared by any number of threads without locking
+ */
+class RateLimiter {
+public:
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+  /**
+   * @brief Config constructor
+   * 
+   * @param iConfig
+   */
+  explicit RateLimiter(const rate_limit_config_t& iConfig = rate_limit_config_t());
+
+  /**
+   * @brief Copy constructor
+   */
+  RateLimiter(const RateLimiter& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Accounts for one connection from iAddr and tells whether its source is still within its rate
+   * 
+   * Sources other than IPv4 and IPv6 are always admitted, IPv4 mapped IPv6 sources count as IPv4 ones. A source
+   * missing from the table takes the free slot of its bucket, or the one of the source closest to a full burst.
+   * 
+   * @param iAddr Peer address as returned by accept(2)
+   * @param iSize
+   * @param iNowNs Monotonic time
+   * 
+   * @return
+   */
+  [[nodiscard]] bool admit(const sockaddr* iAddr, const socklen_t& iSize, const std::uint64_t& iNowNs);
+
+  /**
+   * @brief Accounts for one connection from iAddr and tells whether its source is still within its rate
+   * 
+   * @param iAddr
+   * @param iNowNs Monotonic time
+   * 
+   * @return
+   */
+  [[nodiscard]] bool admit(const addr::InternetAddress& iAddr, const std::uint64_t& iNowNs);
+
+  /**
+   * @brief Forgets every source, not safe while other threads call admit()
+   */
+  void clear(void);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] const rate_limit_config_t& get_config(void) const;
+
+  /**
+   * @brief Sources the table holds at most, the configured slots rounded up to whole buckets
+   * 
+   * @return
+   */
+  [[nodiscard]] std::size_t get_slots(void) const;
+
+  /**
+   * @brief Sources in the table right now, walks the whole table
+   * 
+   * @return
+   */
+  [[nodiscard]] std::size_t get_tracked(void) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+  /**
+   * @brief Copy assignment operator
+   */
+  RateLimiter& operator=(const RateLimiter& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+  /**
+   * @brief Destructor
+   */
+  ~RateLimiter();
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+protected:
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Hash of the source prefix of iAddr
+   * 
+   * @param iAddr
+   * @param iSize
+   * 
+   * @return 0 for addresses that are not rate limited
+   */
+  [[nodiscard]] std::uint64_t key_of(const sockaddr* iAddr, const socklen_t& iSize) const;
+
+  /**
+   * @brief Pushes the theoretical arrival time of a source one interval further if it stays within the burst
+   * 
+   * @param ioTat
+   * @param iNowNs
+   * 
+   * @return
+   */
+  [[nodiscard]] bool conform(std::atomic<std::uint64_t>& ioTat, const std::uint64_t& iNowNs) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+  rate_limit_config_t config_;
+  std::uint64_t intervalNs_;                          // Time each connection costs, 1 s / rate
+  std::uint64_t toleranceNs_;                         // How far ahead of now a source may run, burst intervals
+  std::uint64_t maskV4_;                              // Prefix of an IPv4 address in the upper half
+  std::uint64_t maskV6_[2];
+  std::size_t mask_;                                  // Buckets - 1
+  std::unique_ptr<rate_limit_bucket_t[]> buckets_;
+};
+
+
+} // namespace sock
+} // namespace ncs
+
+
+#endif // NCS_RATE_LIMITER_H
@@ -0,0 +1,158 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file SocketOptions.h
+ *
+ * @brief Compile time tags naming the socket options InternetSocket can set and read back
+ */
+
+
+#ifndef NCS_SOCKET_OPTIONS_H
+#define NCS_SOCKET_OPTIONS_H
+
+
+#include <cstdint>
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+
+#ifndef IP_LOCAL_PORT_RANGE
+#define IP_LOCAL_PORT_RANGE 51    // Linux 6.3, not exported by every libc yet
+#endif
+
+
+namespace ncs { // Network Communications System
+namespace sock { // Network Communications System Sockets
+
+
+/**
+ * @brief Level, name and value type of an integer socket option
+ * 
+ * Options whose level and name depend on the address family override the _V6 pair
+ */
+template <int Level, int Name, typename Value>
+struct socket_option_t {
+  using value_t = Value;
+  static constexpr int LEVEL = Level;
+  static constexpr int NAME = Name;
+  static constexpr int LEVEL_V6 = Level;
+  static constexpr int NAME_V6 = Name;
+};
+
+/**
+ * @brief Sends segments as soon as possible instead of coalescing them with Nagle's algorithm
+ */
+struct tcp_no_delay_t : socket_option_t<IPPROTO_TCP, TCP_NODELAY, bool> {
+  static constexpr const char* LABEL = "TCP_NODELAY";
+};
+
+/**
+ * @brief Acknowledges every segment right away, the kernel may fall back to delayed acks later
+ */
+struct tcp_quick_ack_t : socket_option_t<IPPROTO_TCP, TCP_QUICKACK, bool> {
+  static constexpr const char* LABEL = "TCP_QUICKACK";
+};
+
+/**
+ * @brief Bytes left unsent in the send buffer before the socket stops reporting writable
+ */
+struct tcp_not_sent_low_at_t : socket_option_t<IPPROTO_TCP, TCP_NOTSENT_LOWAT, int> {
+  static constexpr const char* LABEL = "TCP_NOTSENT_LOWAT";
+};
+
+/**
+ * @brief Receive buffer size, the kernel doubles it and turns off autotuning
+ */
+struct recv_buffer_t : socket_option_t<SOL_SOCKET, SO_RCVBUF, int> {
+  static constexpr const char* LABEL = "SO_RCVBUF";
+};
+
+/**
+ * @brief Send buffer size, the kernel doubles it and turns off autotuning
+ */
+struct send_buffer_t : socket_option_t<SOL_SOCKET, SO_SNDBUF, int> {
+  static constexpr const char* LABEL = "SO_SNDBUF";
+};
+
+/**
+ * @brief Microseconds a blocking receive busy polls the device queue, raising it needs CAP_NET_ADMIN
+ */
+struct busy_poll_t : socket_option_t<SOL_SOCKET, SO_BUSY_POLL, int> {
+  static constexpr const char* LABEL = "SO_BUSY_POLL";
+};
+
+/**
+ * @brief Keeps device interrupts off while the application busy polls, needs CAP_NET_ADMIN
+ */
+struct prefer_busy_poll_t : socket_option_t<SOL_SOCKET, SO_PREFER_BUSY_POLL, bool> {
+  static constexpr const char* LABEL = "SO_PREFER_BUSY_POLL";
+};
+
+/**
+ * @brief Sends keepalive probes on idle connections
+ */
+struct keep_alive_t : socket_option_t<SOL_SOCKET, SO_KEEPALIVE, bool> {
+  static constexpr const char* LABEL = "SO_KEEPALIVE";
+};
+
+/**
+ * @brief Firewall mark of the outgoing packets, needs CAP_NET_ADMIN
+ */
+struct mark_t : socket_option_t<SOL_SOCKET, SO_MARK, std::uint32_t> {
+  static constexpr const char* LABEL = "SO_MARK";
+};
+
+/**
+ * @brief Hops the multicast datagrams sent by the socket may travel, 1 keeps them on the local network
+ */
+struct multicast_ttl_t : socket_option_t<IPPROTO_IP, IP_MULTICAST_TTL, int> {
+  static constexpr const char* LABEL = "IP_MULTICAST_TTL";
+  static constexpr int LEVEL_V6 = IPPROTO_IPV6;
+  static constexpr int NAME_V6 = IPV6_MULTICAST_HOPS;
+};
+
+/**
+ * @brief Delivers the multicast datagrams sent by the socket to the members on the same host
+ */
+struct multicast_loop_t : socket_option_t<IPPROTO_IP, IP_MULTICAST_LOOP, bool> {
+  static constexpr const char* LABEL = "IP_MULTICAST_LOOP";
+  static constexpr int LEVEL_V6 = IPPROTO_IPV6;
+  static constexpr int NAME_V6 = IPV6_MULTICAST_LOOP;
+};
+
+/**
+ * @brief Binding to port 0 leaves the port to connect(2), which can share it with other connections to other peers
+ */
+struct bind_address_no_port_t : socket_option_t<IPPROTO_IP, IP_BIND_ADDRESS_NO_PORT, bool> {
+  static constexpr const char* LABEL = "IP_BIND_ADDRESS_NO_PORT";
+};
+
+/**
+ * @brief Ephemeral ports the socket may pick from, the last port in the high half and the first in the low half
+ * 
+ * Zero in either half falls back to the system wide net.ipv4.ip_local_port_range
+ */
+struct local_port_range_t : socket_option_t<IPPROTO_IP, IP_LOCAL_PORT_RANGE, std::uint32_t> {
+  static constexpr const char* LABEL = "IP_LOCAL_PORT_RANGE";
+};
+
+/**
+ * @brief IP_TOS byte, set through IPV6_TCLASS on IPv6 sockets
+ */
+struct traffic_class_t : socket_option_t<IPPROTO_IP, IP_TOS, int> {
+  static constexpr const char* LABEL = "IP_TOS";
+  static constexpr int LEVEL_V6 = IPPROTO_IPV6;
+  static constexpr int NAME_V6 = IPV6_TCLASS;
+};
+
+
+} // namespace sock
+} // namespace ncs
+
+
+#endif // NCS_SOCKET_OPTIONS_H
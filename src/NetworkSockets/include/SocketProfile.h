@@ -0,0 +1,254 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file SocketProfile.h
+ *
+ * @brief Named sets of socket options applied to a socket in one pass
+ */
+
+
+#ifndef NCS_SOCKET_PROFILE_H
+#define NCS_SOCKET_PROFILE_H
+
+
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <InternetSocket.h>
+#include <SocketOptions.h>
+
+
+namespace ncs { // Network Communications System
+namespace sock { // Network Communications System Sockets
+
+
+/**
+ * SocketProfile constants
+ */
+constexpr int LOW_LATENCY_NOT_SENT_LOW_AT = 16 * 1024;   // Keeps queued but unsent data, and its latency, small
+constexpr int LOW_LATENCY_BUSY_POLL_US = 50;
+constexpr int BULK_BUFFER_SIZE = 4 * 1024 * 1024;         // Capped by net.core.rmem_max and wmem_max
+constexpr int IDLE_BUFFER_SIZE = 16 * 1024;
+
+/**
+ * @brief Type erased option recorded by SocketProfile
+ */
+struct profile_entry_t {
+  const char* label = "";
+  int level = 0;
+  int name = 0;
+  int level_v6 = 0;               // Level used on IPv6 sockets
+  int name_v6 = 0;                // Name used on IPv6 sockets
+  int value = 0;
+  bool optional = false;
+};
+
+/**
+ * @brief Requested against effective value of one option, filled by SocketProfile::read_back()
+ */
+struct option_reading_t {
+  const char* label = "";
+  int requested = 0;
+  int effective = 0;
+  bool read = false;              // False if getsockopt(2) failed, effective is meaningless then
+};
+
+
+/**
+ * @brief Records typed options once and applies them to every accepted or connected socket
+ */
+class SocketProfile {
+public:
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+  /**
+   * @brief Name constructor
+   * 
+   * @param iName
+   */
+  explicit SocketProfile(const std::string& iName = "");
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Adds an option to the profile, replacing an earlier value of the same option
+   * 
+   * @param iValue
+   * @param iOptional Failures to set it, e.g. for lack of privileges, do not fail apply()
+   * 
+   * @return The profile, to chain calls
+   */
+  template <typename Option>
+  SocketProfile& set(const typename Option::value_t& iValue, const bool& iOptional = false);
+
+  /**
+   * @brief Sets every option of the profile on iSocket
+   * 
+   * Every option is attempted even after a failure
+   * 
+   * @param iSocket
+   * 
+   * @return False with errno set by the first required option that failed
+   */
+  [[nodiscard]] bool apply(const InternetSocket& iSocket) const;
+
+  /**
+   * @brief Reads the effective value of every option of the profile from iSocket
+   * 
+   * @param iSocket
+   * 
+   * @return One reading per option, in the order they were set
+   */
+  [[nodiscard]] std::vector<option_reading_t> read_back(const InternetSocket& iSocket) const;
+
+  /**
+   * @brief Interactive traffic: no coalescing, immediate acks, shallow send buffer, busy polling if permitted
+   * 
+   * @return
+   */
+  [[nodiscard]] static SocketProfile low_latency(void);
+
+  /**
+   * @brief Transfers of large volumes: coalesced segments and deep fixed buffers
+   * 
+   * @return
+   */
+  [[nodiscard]] static SocketProfile bulk_throughput(void);
+
+  /**
+   * @brief Large numbers of mostly idle connections: small buffers and keepalives to reap dead peers
+   * 
+   * @return
+   */
+  [[nodiscard]] static SocketProfile many_idle_connections(void);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] const std::string& get_name(void) const;
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] const std::vector<profile_entry_t>& get_entries(void) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+  /**
+   * @brief Destructor
+   */
+  ~SocketProfile();
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+protected:
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Stores iEntry, replacing an entry for the same option
+   * 
+   * @param iEntry
+   */
+  void add(const profile_entry_t& iEntry);
+
+  /**
+   * @brief Level and name of iEntry on iSocket
+   * 
+   * @param iEntry
+   * @param iFamily
+   * @param oLevel
+   * @param oName
+   */
+  static void resolve(const profile_entry_t& iEntry, const addr::addr_family_e& iFamily, int& oLevel, int& oName);
+
+  /**
+   * @brief Family of iSocket, looked up only if some option depends on it
+   * 
+   * @param iSocket
+   * 
+   * @return
+   */
+  [[nodiscard]] addr::addr_family_e family_of(const InternetSocket& iSocket) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+  std::string name_;
+  std::vector<profile_entry_t> entries_;
+};
+
+
+/**
+ * @brief Adds an option to the profile
+ * 
+ * @param iValue
+ * @param iOptional
+ * 
+ * @return
+ */
+template <typename Option>
+SocketProfile& SocketProfile::set(const typename Option::value_t& iValue, const bool& iOptional) {
+  static_assert(std::is_integral<typename Option::value_t>::value, "socket options carry integral values");
+  this->add({Option::LABEL, Option::LEVEL, Option::NAME, Option::LEVEL_V6, Option::NAME_V6, static_cast<int>(iValue),
+             iOptional});
+  return *this;
+}
+
+
+} // namespace sock
+} // namespace ncs
+
+
+#endif // NCS_SOCKET_PROFILE_H
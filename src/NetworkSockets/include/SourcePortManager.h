@@ -0,0 +1,256 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file SourcePortManager.h
+ *
+ * @brief Outbound connects spread over several local addresses, with the ephemeral ports accounted per destination
+ */
+
+
+#ifndef NCS_SOURCE_PORT_MANAGER_H
+#define NCS_SOURCE_PORT_MANAGER_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <ConnectMetrics.h>
+#include <InternetAddress.h>
+#include <InternetSocket.h>
+#include <SocketProfile.h>
+
+
+namespace ncs { // Network Communications System
+namespace sock { // Network Communications System Sockets
+
+
+/**
+ * SourcePortManager constants
+ */
+constexpr char LOCAL_PORT_RANGE_PATH[] = "/proc/sys/net/ipv4/ip_local_port_range";
+constexpr addr::port_t DEFAULT_FIRST_LOCAL_PORT = 32768;     // System wide range when it cannot be read
+constexpr addr::port_t DEFAULT_LAST_LOCAL_PORT = 60999;
+
+/**
+ * @brief
+ */
+struct source_ports_config_t {
+  std::vector<addr::InternetAddress> sources;     // Local addresses the connections leave from, ports are ignored
+  addr::port_t first_port = 0;                    // Ephemeral ports of every socket, 0 for the system wide range
+  addr::port_t last_port = 0;                     // The kernel clips the range to the system wide one
+  const SocketProfile* profile = nullptr;         // Applied to every socket before binding
+};
+
+/**
+ * @brief Source and destination of a group of connections, the source port tells them apart
+ */
+struct flow_key_t {
+  std::uint32_t source = 0;                       // Index in the configured sources
+  addr::address_key_t destination;
+
+  /**
+   * @brief
+   * 
+   * @param iOther
+   * 
+   * @return
+   */
+  [[nodiscard]] bool operator==(const flow_key_t& iOther) const;
+};
+
+/**
+ * @brief FNV-1a over the key
+ */
+struct flow_key_hash_t {
+  /**
+   * @brief
+   * 
+   * @param iKey
+   * 
+   * @return
+   */
+  [[nodiscard]] std::size_t operator()(const flow_key_t& iKey) const;
+};
+
+
+/**
+ * @brief Binds outbound sockets to the local address with the most ports left toward their destination
+ */
+class SourcePortManager {
+public:
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+  /**
+   * @brief Config constructor
+   * 
+   * @param iConfig
+   */
+  explicit SourcePortManager(const source_ports_config_t& iConfig);
+
+  /**
+   * @brief Copy constructor
+   */
+  SourcePortManager(const SourcePortManager& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Connects oSocket to iDestination from one of the sources of its family
+   * 
+   * The source with the fewest connections to iDestination goes first, ties are broken round robin. Since the port
+   * is only picked by connect(2), the kernel can hand out the same port toward different destinations. A source the
+   * kernel finds no free port on is skipped for the next one.
+   * 
+   * @param iDestination
+   * @param oSocket Blocking once connected, like InternetSocket::connect() leaves it
+   * 
+   * @return False with errno set, EADDRNOTAVAIL once every source has used up its ports toward iDestination
+   */
+  [[nodiscard]] bool connect(const addr::InternetAddress& iDestination, InternetSocket& oSocket);
+
+  /**
+   * @brief Gives back the port held by a connection opened by connect(), to be called before closing it
+   * 
+   * @param iSocket
+   * 
+   * @return False if no connection from its source to its destination is accounted
+   */
+  bool release(const InternetSocket& iSocket);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+  /**
+   * @brief Accounts every connect in iMetrics, nullptr to stop
+   * 
+   * @param iMetrics Must outlive the manager
+   */
+  void set_metrics(metrics::ConnectMetrics* iMetrics);
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] const source_ports_config_t& get_config(void) const;
+
+  /**
+   * @brief Ports each source has toward a destination, the configured range clipped to the system wide one
+   * 
+   * @return
+   */
+  [[nodiscard]] const std::size_t& get_capacity(void) const;
+
+  /**
+   * @brief Connections opened and not yet released
+   * 
+   * @return
+   */
+  [[nodiscard]] const std::size_t& get_connections(void) const;
+
+  /**
+   * @brief Connections opened and not yet released from iSource to iDestination
+   * 
+   * @param iSource Index in the configured sources
+   * @param iDestination
+   * 
+   * @return
+   */
+  [[nodiscard]] std::size_t get_connections(const std::size_t& iSource,
+                                            const addr::InternetAddress& iDestination) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+  /**
+   * @brief Copy assignment operator
+   */
+  SourcePortManager& operator=(const SourcePortManager& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+protected:
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Opens oSocket and binds it to the address of iSource, leaving the port to connect(2)
+   * 
+   * @param iSource
+   * @param oSocket
+   * 
+   * @return
+   */
+  [[nodiscard]] bool open_from(const std::size_t& iSource, InternetSocket& oSocket) const;
+
+  /**
+   * @brief Connections from iSource to the destination of iKey
+   * 
+   * @param iKey
+   * 
+   * @return
+   */
+  [[nodiscard]] std::size_t count(const flow_key_t& iKey) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+  source_ports_config_t config_;
+  std::vector<addr::address_key_t> sourceKeys_;    // Sort key of every source, port zeroed
+  std::unordered_map<flow_key_t, std::size_t, flow_key_hash_t> flows_;
+  std::size_t capacity_;
+  std::size_t connections_;
+  std::size_t cursor_;                             // Source that wins the next tie
+  metrics::ConnectMetrics* metrics_;
+};
+
+
+} // namespace sock
+} // namespace ncs
+
+
+#endif // NCS_SOURCE_PORT_MANAGER_H
@@ -0,0 +1,185 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file TcpInfoSampler.h
+ *
+ * @brief Periodic TCP_INFO sampling of the sockets driven by an event loop
+ */
+
+
+#ifndef NCS_TCP_INFO_SAMPLER_H
+#define NCS_TCP_INFO_SAMPLER_H
+
+
+#include <chrono>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <EventLoop.h>
+#include <InternetSocket.h>
+#include <SocketMetrics.h>
+
+
+namespace ncs { // Network Communications System
+namespace sock { // Network Communications System Sockets
+
+
+/**
+ * TcpInfoSampler constants
+ */
+constexpr std::chrono::milliseconds DEFAULT_TCP_INFO_INTERVAL{1000};   // Default sampling period
+
+
+/**
+ * @brief Samples from the loop thread, which keeps that thread the only writer of the metrics
+ */
+class TcpInfoSampler {
+public:
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+  /**
+   * @brief Loop constructor
+   * 
+   * @param iLoop Loop driving the sampled sockets
+   * @param iInterval
+   */
+  explicit TcpInfoSampler(EventLoop& iLoop, const std::chrono::milliseconds& iInterval = DEFAULT_TCP_INFO_INTERVAL);
+
+  /**
+   * @brief Copy constructor
+   */
+  TcpInfoSampler(const TcpInfoSampler& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Samples iSocket into ioMetrics on every period
+   * 
+   * @param iSocket
+   * @param ioMetrics Must stay alive until removed
+   */
+  void add(const InternetSocket& iSocket, metrics::SocketMetrics& ioMetrics);
+
+  /**
+   * @brief
+   * 
+   * @param iSocket
+   * 
+   * @return False if it was not sampled
+   */
+  bool remove(const InternetSocket& iSocket);
+
+  /**
+   * @brief Samples every socket once per interval until stop()
+   */
+  void start(void);
+
+  /**
+   * @brief
+   */
+  void stop(void);
+
+  /**
+   * @brief Samples every socket right away
+   * 
+   * @return Sockets successfully sampled
+   */
+  std::size_t sample_all(void);
+
+  /**
+   * @brief Reads TCP_INFO from a descriptor
+   * 
+   * @param iSd
+   * @param oSample
+   * 
+   * @return False if the descriptor is not a TCP socket
+   */
+  [[nodiscard]] static bool sample(const sd_t& iSd, metrics::tcp_info_sample_t& oSample);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] std::size_t get_sampled_count(void) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+  /**
+   * @brief Copy assignment operator
+   */
+  TcpInfoSampler& operator=(const TcpInfoSampler& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+  /**
+   * @brief Destructor
+   */
+  ~TcpInfoSampler();
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+protected:
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+  EventLoop& loop_;
+  std::chrono::milliseconds interval_;
+  std::vector<std::pair<sd_t, metrics::SocketMetrics*>> targets_;
+  task_id_t task_;
+};
+
+
+} // namespace sock
+} // namespace ncs
+
+
+#endif // NCS_TCP_INFO_SAMPLER_H
@@ -0,0 +1,291 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file WriteBatcher.h
+ *
+ * @brief Per connection stage coalescing small writes into few sendmsg(2) calls
+ */
+
+
+#ifndef NCS_WRITE_BATCHER_H
+#define NCS_WRITE_BATCHER_H
+
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include <EventLoop.h>
+#include <FlowController.h>
+#include <InternetSocket.h>
+
+
+namespace ncs { // Network Communications System
+namespace sock { // Network Communications System Sockets
+
+
+/**
+ * WriteBatcher types
+ */
+enum flush_status_e {
+  FLUSH_DONE,       // Every queued byte has been sent
+  FLUSH_PENDING,    // The socket would block, some bytes are still queued
+  FLUSH_ERROR       // The socket failed, errno tells why
+};
+
+/**
+ * @brief Coalescing knobs of a single connection
+ */
+struct coalesce_policy_t {
+  std::size_t max_batch_bytes = 64 * 1024;             // Flush as soon as this many bytes are queued
+  std::chrono::microseconds latency_budget{0};         // Extra time a byte may wait past its loop iteration
+  std::size_t copy_threshold = 1024;                   // Writes below this size are copied into a shared buffer
+  bool use_cork = false;                               // Hold partial segments with TCP_CORK while flushing
+  bool use_msg_more = true;                            // Flag every sendmsg(2) but the last one with MSG_MORE
+};
+
+/**
+ * @brief Counters describing how well writes are being coalesced
+ */
+struct coalesce_stats_t {
+  std::uint64_t writes = 0;      // Calls to write()
+  std::uint64_t flushes = 0;     // Flushes that sent something
+  std::uint64_t syscalls = 0;    // sendmsg(2) calls
+  std::uint64_t bytes = 0;       // Bytes sent
+};
+
+/**
+ * @brief Queued buffer and how much of it has already been sent
+ */
+struct write_buffer_t {
+  std::vector<std::uint8_t> data;
+  std::size_t offset = 0;
+};
+
+/**
+ * WriteBatcher constants
+ */
+constexpr std::size_t WRITE_CHUNK_SIZE = 16 * 1024;     // Capacity of the buffers that collect small writes
+constexpr std::size_t MAX_WRITE_IOV = 64;               // Buffers gathered by a single sendmsg(2)
+constexpr std::chrono::microseconds MIN_WRITE_RETRY{500};     // First retry of an automatic flush that would block
+constexpr std::chrono::microseconds MAX_WRITE_RETRY{64000};   // Retries back off up to this or the latency budget
+
+
+/**
+ * @brief Queued bytes are flushed at the end of the loop iteration, once the latency budget expires or as soon as max_batch_bytes are queued, whichever comes first
+ */
+class WriteBatcher {
+public:
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+  /**
+   * @brief Socket constructor
+   * 
+   * @param iSocket Must outlive the batcher
+   * @param iPolicy
+   * @param iLoop Loop flushing the queue automatically, nullptr to only flush on demand
+   */
+  explicit WriteBatcher(const InternetSocket& iSocket, const coalesce_policy_t& iPolicy = {}, EventLoop* iLoop = nullptr);
+
+  /**
+   * @brief Copy constructor
+   */
+  WriteBatcher(const WriteBatcher& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Queues a copy of iData, appended to the last queued buffer when it has room
+   * 
+   * @param iData
+   * @param iSize
+   * 
+   * @return False if a flush triggered by the byte threshold failed
+   */
+  [[nodiscard]] bool write(const void* iData, const std::size_t& iSize);
+
+  /**
+   * @brief Queues iBuffer without copying it
+   * 
+   * @param iBuffer
+   * 
+   * @return False if a flush triggered by the byte threshold failed
+   */
+  [[nodiscard]] bool write(std::vector<std::uint8_t>&& iBuffer);
+
+  /**
+   * @brief Sends as much of the queue as the socket accepts
+   * 
+   * Automatic flushes that would block are retried by the loop until the queue is empty, explicit ones are not.
+   * 
+   * @return FLUSH_PENDING when the socket stopped accepting data, flush again once it is writable
+   */
+  flush_status_e flush(void);
+
+  /**
+   * @brief Drops every queued byte
+   */
+  void clear(void);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+  /**
+   * @brief
+   * 
+   * @param iPolicy
+   */
+  void set_policy(const coalesce_policy_t& iPolicy);
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] const coalesce_policy_t& get_policy(void) const;
+
+  /**
+   * @brief Reports queued and sent bytes to iFlow, writes fail with ENOBUFS when its budget is exhausted
+   * 
+   * @param iFlow Must outlive the batcher, nullptr to stop reporting
+   */
+  void set_flow_controller(FlowController* iFlow);
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] const coalesce_stats_t& get_stats(void) const;
+
+  /**
+   * @brief
+   * 
+   * @return Bytes queued and not yet sent
+   */
+  [[nodiscard]] const std::size_t& get_queued_size(void) const;
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] bool has_pending(void) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+  /**
+   * @brief Copy assignment operator
+   */
+  WriteBatcher& operator=(const WriteBatcher& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+  /**
+   * @brief Destructor, queued bytes are dropped
+   */
+  ~WriteBatcher();
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+protected:
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Accounts for newly queued bytes, flushing or arming the automatic flush
+   * 
+   * @param iSize
+   * 
+   * @return
+   */
+  [[nodiscard]] bool queued(const std::size_t& iSize);
+
+  /**
+   * @brief Registers the automatic flush in the loop if not done yet
+   */
+  void arm(void);
+
+  /**
+   * @brief Cancels the automatic flush
+   */
+  void disarm(void);
+
+  /**
+   * @brief Flushes from the loop, retrying while the socket would block
+   */
+  void auto_flush(void);
+
+  /**
+   * @brief Schedules the next try of an automatic flush that would block, backing off up to the latency budget
+   */
+  void retry(void);
+
+  /**
+   * @brief Toggles TCP_CORK when the policy asks for it
+   * 
+   * @param iEnabled
+   */
+  void cork(const bool& iEnabled) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+  const InternetSocket& socket_;
+  coalesce_policy_t policy_;
+  EventLoop* loop_;
+  std::deque<write_buffer_t> queue_;
+  std::size_t queuedSize_;
+  task_id_t flushTask_;
+  std::chrono::microseconds retryDelay_;
+  coalesce_stats_t stats_;
+  FlowController* flow_;
+};
+
+
+} // namespace sock
+} // namespace ncs
+
+
+#endif // NCS_WRITE_BATCHER_H
@@ -0,0 +1,210 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file XdpProgram.h
+ *
+ * @brief Minimal XDP program redirecting every queue to the AF_XDP socket registered for it
+ */
+
+
+#ifndef NCS_XDP_PROGRAM_H
+#define NCS_XDP_PROGRAM_H
+
+
+#include <cstdint>
+
+#include <InternetSocket.h>
+#include <XdpSocket.h>
+
+
+namespace ncs { // Network Communications System
+namespace sock { // Network Communications System Sockets
+
+
+/**
+ * XdpProgram types
+ */
+enum xdp_attach_e {
+  XDP_ATTACH_AUTO,      // Try the driver hook first and fall back to the generic one
+  XDP_ATTACH_NATIVE,    // Runs in the driver before any skb is built
+  XDP_ATTACH_GENERIC    // Runs on the skb path, works on any device
+};
+
+/**
+ * XdpProgram constants
+ */
+constexpr std::uint32_t XDP_PROGRAM_MAX_QUEUES = 64;     // Default size of the socket map
+
+
+/**
+ * @brief Loads and links the program through the bpf syscall, so no libbpf is required
+ */
+class XdpProgram {
+public:
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+  /**
+   * @brief Default constructor
+   */
+  XdpProgram(void);
+
+  /**
+   * @brief Copy constructor
+   */
+  XdpProgram(const XdpProgram& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Creates the socket map, loads the program and links it to the interface
+   * 
+   * Packets arriving on a queue without a registered socket continue up the stack
+   * 
+   * @param iIfIndex
+   * @param iMode
+   * @param iQueues Size of the socket map, highest queue index plus one
+   * 
+   * @return False with errno set if the kernel refuses any step
+   */
+  [[nodiscard]] bool attach(const int& iIfIndex, const xdp_attach_e& iMode = XDP_ATTACH_AUTO,
+                            const std::uint32_t& iQueues = XDP_PROGRAM_MAX_QUEUES);
+
+  /**
+   * @brief Redirects the queue iSocket is bound to into it
+   * 
+   * @param iSocket
+   * 
+   * @return
+   */
+  [[nodiscard]] bool add(const XdpSocket& iSocket);
+
+  /**
+   * @brief Stops redirecting iQueue
+   * 
+   * @param iQueue
+   * 
+   * @return False if no socket was registered for it
+   */
+  bool remove(const std::uint32_t& iQueue);
+
+  /**
+   * @brief Unlinks the program and releases the map
+   */
+  void detach(void);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] bool is_attached(void) const;
+
+  /**
+   * @brief Mode the program ended up linked with
+   * 
+   * @return XDP_ATTACH_NATIVE or XDP_ATTACH_GENERIC once attached
+   */
+  [[nodiscard]] const xdp_attach_e& get_mode(void) const;
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] const int& get_ifindex(void) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+  /**
+   * @brief Copy assignment operator
+   */
+  XdpProgram& operator=(const XdpProgram& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+  /**
+   * @brief Destructor
+   */
+  ~XdpProgram();
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+protected:
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Loads the redirect program against mapSd_
+   * 
+   * @return
+   */
+  [[nodiscard]] bool load(void);
+
+  /**
+   * @brief Links the loaded program with a single mode
+   * 
+   * @param iMode XDP_ATTACH_NATIVE or XDP_ATTACH_GENERIC
+   * 
+   * @return
+   */
+  [[nodiscard]] bool link(const xdp_attach_e& iMode);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+  int ifindex_;
+  xdp_attach_e mode_;
+  sd_t mapSd_;
+  sd_t programSd_;
+  sd_t linkSd_;
+};
+
+
+} // namespace sock
+} // namespace ncs
+
+
+#endif // NCS_XDP_PROGRAM_H
@@ -0,0 +1,365 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file XdpSocket.h
+ *
+ * @brief AF_XDP socket owning its UMEM and the four rings shared with the kernel
+ */
+
+
+#ifndef NCS_XDP_SOCKET_H
+#define NCS_XDP_SOCKET_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <linux/if_xdp.h>
+#include <sys/uio.h>
+
+#include <InternetSocket.h>
+
+
+namespace ncs { // Network Communications System
+namespace sock { // Network Communications System Sockets
+
+
+/**
+ * XdpSocket constants
+ */
+constexpr std::uint32_t XDP_MIN_FRAME_SIZE = 2048;      // Smallest chunk the kernel accepts
+constexpr std::size_t XDP_DEFAULT_BATCH = 64;           // Packets moved per receive() / submit() round
+
+/**
+ * XdpSocket types
+ */
+enum xdp_mode_e {
+  XDP_MODE_AUTO,        // Try zero copy first and fall back to copy mode
+  XDP_MODE_COPY,        // Frames are copied between the driver and the UMEM, works on any device
+  XDP_MODE_ZEROCOPY     // The driver DMAs straight into the UMEM
+};
+
+/**
+ * @brief Setup of an XdpSocket, sizes must be powers of two
+ */
+struct xdp_config_t {
+  int ifindex = 0;                                      // Interface to bind to
+  std::uint32_t queue = 0;                              // Receive queue of the interface
+  std::uint32_t frame_count = 4096;                     // Frames in the UMEM, half of them feed the fill ring
+  std::uint32_t frame_size = 4096;                      // Bytes per frame, 2048 or 4096
+  std::uint32_t ring_size = 2048;                       // Entries of each of the four rings
+  xdp_mode_e mode = XDP_MODE_AUTO;
+  bool need_wakeup = true;                              // Only enter the kernel when it flags a ring
+  int busy_poll_us = 0;                                 // SO_BUSY_POLL timeout, 0 disables busy polling
+  int busy_poll_budget = 64;                            // Packets processed per busy poll round
+};
+
+/**
+ * @brief Frame inside the UMEM
+ */
+struct xdp_packet_t {
+  std::uint8_t* data = nullptr;
+  std::uint32_t size = 0;
+  std::uint64_t addr = 0;                               // Offset of the frame in the UMEM
+};
+
+/**
+ * @brief Single producer single consumer ring shared with the kernel
+ */
+struct xdp_ring_t {
+  std::uint32_t* producer = nullptr;
+  std::uint32_t* consumer = nullptr;
+  std::uint32_t* flags = nullptr;
+  void* entries = nullptr;
+  void* map = nullptr;
+  std::size_t map_size = 0;
+  std::uint32_t mask = 0;
+  std::uint32_t size = 0;
+  std::uint32_t cached = 0;                             // Local copy of the index this side owns
+};
+
+/**
+ * @brief
+ */
+struct xdp_stats_t {
+  std::uint64_t rx_packets = 0;
+  std::uint64_t tx_packets = 0;                         // Frames completed by the kernel
+  std::uint64_t wakeups = 0;                            // Syscalls issued to kick the kernel
+  std::uint64_t rx_dropped = 0;
+  std::uint64_t rx_ring_full = 0;
+  std::uint64_t fill_ring_empty = 0;
+  std::uint64_t rx_invalid = 0;
+  std::uint64_t tx_invalid = 0;
+  std::uint64_t tx_ring_empty = 0;
+};
+
+
+/**
+ * @brief Single queue AF_XDP socket, every method must be called from the same thread
+ */
+class XdpSocket {
+public:
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+  /**
+   * @brief Default constructor
+   */
+  XdpSocket(void);
+
+  /**
+   * @brief Copy constructor
+   */
+  XdpSocket(const XdpSocket& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Creates the socket, registers the UMEM, maps the rings and binds to the configured queue
+   * 
+   * @param iConfig
+   * 
+   * @return False with errno set if any step fails, the socket is left closed
+   */
+  [[nodiscard]] bool open(const xdp_config_t& iConfig);
+
+  /**
+   * @brief Unmaps the rings and the UMEM and closes the descriptor
+   */
+  void close(void);
+
+  /**
+   * @brief Takes up to iMax received packets from the RX ring
+   * 
+   * The frames stay owned by the caller until they are handed back with release()
+   * 
+   * @param oPackets
+   * @param iMax
+   * 
+   * @return Packets written to oPackets
+   */
+  [[nodiscard]] std::size_t receive(xdp_packet_t* oPackets, const std::size_t& iMax);
+
+  /**
+   * @brief Hands received frames back to the kernel through the fill ring
+   * 
+   * @param iPackets
+   * @param iCount
+   */
+  void release(const xdp_packet_t* iPackets, const std::size_t& iCount);
+
+  /**
+   * @brief Takes up to iMax free frames to be filled in place and passed to submit()
+   * 
+   * Each packet size is set to the frame capacity
+   * 
+   * @param oPackets
+   * @param iMax
+   * 
+   * @return Frames written to oPackets
+   */
+  [[nodiscard]] std::size_t acquire(xdp_packet_t* oPackets, const std::size_t& iMax);
+
+  /**
+   * @brief Posts acquired frames on the TX ring and kicks the kernel when it asks for it
+   * 
+   * Frames that do not fit in the ring go back to the free list unsent
+   * 
+   * @param iPackets
+   * @param iCount
+   * 
+   * @return Packets posted
+   */
+  std::size_t submit(const xdp_packet_t* iPackets, const std::size_t& iCount);
+
+  /**
+   * @brief Copies every buffer into its own frame and submits them
+   * 
+   * @param iPackets
+   * @param iCount
+   * 
+   * @return Packets posted, stops at the first one larger than a frame
+   */
+  std::size_t send(const iovec* iPackets, const std::size_t& iCount);
+
+  /**
+   * @brief Reaps the completion ring, returning sent frames to the free list
+   * 
+   * @return Frames completed
+   */
+  std::size_t complete(void);
+
+  /**
+   * @brief Asks the kernel to process the TX ring and refill RX
+   * 
+   * @return False on a fatal error, a busy ring is not an error
+   */
+  bool wakeup(void);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] bool is_open(void) const;
+
+  /**
+   * @brief Descriptor to poll for readability
+   * 
+   * @return
+   */
+  [[nodiscard]] const sd_t& get_sd(void) const;
+
+  /**
+   * @brief
+   * 
+   * @return
+   */
+  [[nodiscard]] const xdp_config_t& get_config(void) const;
+
+  /**
+   * @brief Mode the kernel actually granted
+   * 
+   * @return XDP_MODE_COPY or XDP_MODE_ZEROCOPY once open
+   */
+  [[nodiscard]] const xdp_mode_e& get_mode(void) const;
+
+  /**
+   * @brief Frames neither in a ring nor handed to the caller
+   * 
+   * @return
+   */
+  [[nodiscard]] std::size_t get_free_frames(void) const;
+
+  /**
+   * @brief Local counters merged with XDP_STATISTICS
+   * 
+   * @return
+   */
+  [[nodiscard]] xdp_stats_t get_stats(void) const;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+  /**
+   * @brief Copy assignment operator
+   */
+  XdpSocket& operator=(const XdpSocket& iOther) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+  /**
+   * @brief Destructor
+   */
+  ~XdpSocket();
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+protected:
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Binds with a single mode
+   * 
+   * @param iMode XDP_MODE_COPY or XDP_MODE_ZEROCOPY
+   * 
+   * @return
+   */
+  [[nodiscard]] bool bind(const xdp_mode_e& iMode);
+
+  /**
+   * @brief Closes everything opened so far keeping the errno of the failed step
+   * 
+   * @return Always false
+   */
+  bool fail(void);
+
+  /**
+   * @brief Maps one ring
+   * 
+   * @param oRing
+   * @param iOffsets
+   * @param iEntrySize
+   * @param iPageOffset
+   * 
+   * @return
+   */
+  [[nodiscard]] bool map_ring(xdp_ring_t& oRing, const xdp_ring_offset& iOffsets, const std::size_t& iEntrySize,
+                              const std::uint64_t& iPageOffset);
+
+  /**
+   * @brief Pushes frames from the free list to the fill ring
+   * 
+   * @param iCount
+   * 
+   * @return Frames pushed
+   */
+  std::size_t refill(const std::size_t& iCount);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+  xdp_config_t config_;
+  xdp_mode_e mode_;
+  sd_t sd_;
+  std::uint8_t* umem_;
+  std::size_t umemSize_;
+  xdp_ring_t fill_;
+  xdp_ring_t completion_;
+  xdp_ring_t rx_;
+  xdp_ring_t tx_;
+  std::vector<std::uint64_t> freeFrames_;
+  std::uint64_t rxPackets_;
+  std::uint64_t txPackets_;
+  std::uint64_t wakeups_;
+};
+
+
+} // namespace sock
+} // namespace ncs
+
+
+#endif // NCS_XDP_SOCKET_H
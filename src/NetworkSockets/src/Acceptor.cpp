@@ -0,0 +1,437 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file Acceptor.cpp
+ *
+ * @brief
+ */
+
+
+#include <Acceptor.h>
+#include <Tracer.h>
+
+#include <cerrno>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+
+namespace ncs { // Network Communications System
+namespace sock { // Network Communications System Sockets
+
+
+/** PUBLIC METHODS **/
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+/**
+ * @brief Loop constructor
+ * 
+ * @param ioLoop
+ * @param iConfig
+ */
+Acceptor::Acceptor(EventLoop& ioLoop, const acceptor_config_t& iConfig)
+    : loop_(ioLoop), config_(iConfig), owned_(false), listening_(false), spareSd_(-1), metrics_(nullptr) {
+  if (this->config_.budget == 0) {
+    this->config_.budget = 1;
+  }
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Opens a listener on iAddr and starts accepting from the loop
+ * 
+ * @param iAddr
+ * @param iHandler
+ * 
+ * @return
+ */
+[[nodiscard]] bool Acceptor::listen(const addr::InternetAddress& iAddr, accept_handler_t iHandler) {
+  this->close();
+  this->owned_ = true;
+  const int one = 1;
+  if (!this->listener_.open(iAddr.get_address_family(), SOCK_STREAM | SOCK_NONBLOCK) ||
+      (setsockopt(this->listener_.get_sd(), SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one)) != 0)) {
+    return this->fail();
+  }
+  if (this->config_.reuse_port &&
+      (setsockopt(this->listener_.get_sd(), SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one)) != 0)) {
+    return this->fail();
+  }
+  if (!this->listener_.bind(iAddr) || !this->listener_.listen(this->config_.backlog)) {
+    return this->fail();
+  }
+#ifdef TCP_DEFER_ACCEPT
+  if ((this->config_.defer_accept_s > 0) &&
+      (setsockopt(this->listener_.get_sd(), IPPROTO_TCP, TCP_DEFER_ACCEPT, &this->config_.defer_accept_s,
+                  sizeof(this->config_.defer_accept_s)) != 0)) {
+    return this->fail();
+  }
+#endif
+  return this->watch(std::move(iHandler));
+}
+
+/**
+ * @brief Starts accepting from a listener owned by someone else
+ * 
+ * @param iListener
+ * @param iHandler
+ * 
+ * @return
+ */
+[[nodiscard]] bool Acceptor::attach(const InternetSocket& iListener, accept_handler_t iHandler) {
+  this->close();
+  this->owned_ = false;
+  // Borrows the descriptor, close() gives it back before the socket could close it
+  this->listener_.set_sd(iListener.get_sd());
+  this->listener_.set_addr(iListener.get_addr());
+  if (!this->listener_.set_non_blocking(true)) {
+    return this->fail();
+  }
+  return this->watch(std::move(iHandler));
+}
+
+/**
+ * @brief Accepts the pending connections, at most the budget of the config
+ * 
+ * @return
+ */
+std::size_t Acceptor::drain(void) {
+  const std::uint64_t ready = (this->metrics_ != nullptr) ? metrics::clock_ns() : 0;
+  if (this->metrics_ != nullptr) {
+    this->sample_backlog();
+  }
+  std::size_t accepted = 0;
+  std::size_t handled = 0;
+  InternetSocket client;
+  while (handled < this->config_.budget) {
+    bool refused = false;
+    if (this->accept(client, refused)) {
+      ++handled;
+      ++accepted;
+      if (this->metrics_ != nullptr) {
+        this->metrics_->on_accept(metrics::clock_ns() - ready);
+      }
+      // A connection missing some option still works, it is handed over and the failure counted
+      if ((this->config_.profile != nullptr) && !this->config_.profile->apply(client) && (this->metrics_ != nullptr)) {
+        this->metrics_->on_error(errno);
+      }
+      this->handler_(std::move(client));
+      client.close();
+      continue;
+    }
+    if (refused) {
+      ++handled;
+      continue;
+    }
+    const int error = errno;
+    if ((error == EAGAIN) || (error == EWOULDBLOCK)) {
+      break;
+    }
+    if (this->metrics_ != nullptr) {
+      this->metrics_->on_error(error);
+    }
+    if ((error == EINTR) || (error == ECONNABORTED)) {
+      continue;
+    }
+    // Out of descriptors the connection stays queued and the listener readable, refuse it instead of spinning
+    if (((error == EMFILE) || (error == ENFILE)) && this->shed()) {
+      ++handled;
+      continue;
+    }
+    break;
+  }
+  if (this->spareSd_ < 0) {
+    this->spareSd_ = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+  }
+  if (this->metrics_ != nullptr) {
+    this->metrics_->on_batch(handled == this->config_.budget);
+  }
+  return accepted;
+}
+
+/**
+ * @brief Stops accepting
+ */
+void Acceptor::close(void) {
+  if (this->listening_) {
+    (void)this->loop_.remove(this->listener_.get_sd());
+    this->listening_ = false;
+  }
+  if (this->owned_) {
+    this->listener_.close();
+  } else {
+    this->listener_.set_sd(-1);
+  }
+  this->owned_ = false;
+  if (this->spareSd_ >= 0) {
+    ::close(this->spareSd_);
+    this->spareSd_ = -1;
+  }
+}
+
+/**
+ * @brief Reads the accept queue overflow counters of the network namespace
+ * 
+ * @param oOverflows
+ * @param oDrops
+ * 
+ * @return
+ */
+[[nodiscard]] bool Acceptor::read_listen_overflows(std::uint64_t& oOverflows, std::uint64_t& oDrops) {
+  std::ifstream netstat("/proc/net/netstat");
+  std::string names;
+  std::string values;
+  // Each group is a line of names followed by a line of values, both starting with the group tag
+  while (std::getline(netstat, names) && std::getline(netstat, values)) {
+    if (names.rfind("TcpExt:", 0) != 0) {
+      continue;
+    }
+    std::istringstream nameStream(names);
+    std::istringstream valueStream(values);
+    std::string name;
+    std::string value;
+    bool overflows = false;
+    bool drops = false;
+    while ((nameStream >> name) && (valueStream >> value)) {
+      if (name == "ListenOverflows") {
+        oOverflows = std::stoull(value);
+        overflows = true;
+      } else if (name == "ListenDrops") {
+        oDrops = std::stoull(value);
+        drops = true;
+      }
+    }
+    return overflows && drops;
+  }
+  return false;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+/**
+ * @brief Attaches the counters updated by drain()
+ * 
+ * @param iMetrics
+ */
+void Acceptor::set_metrics(metrics::AcceptMetrics* iMetrics) {
+  this->metrics_ = iMetrics;
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] const InternetSocket& Acceptor::get_listener(void) const {
+  return this->listener_;
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] const acceptor_config_t& Acceptor::get_config(void) const {
+  return this->config_;
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] bool Acceptor::is_listening(void) const {
+  return this->listening_;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+/**
+ * @brief Destructor
+ */
+Acceptor::~Acceptor() {
+  this->close();
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PROTECTED METHODS **/
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PRIVATE METHODS **/
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Registers the listener with the loop
+ * 
+ * @param iHandler
+ * 
+ * @return
+ */
+[[nodiscard]] bool Acceptor::watch(accept_handler_t iHandler) {
+  this->handler_ = std::move(iHandler);
+  this->spareSd_ = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+  if (this->spareSd_ < 0) {
+    return this->fail();
+  }
+  const event_handler_t onReadable = [this](const std::uint32_t&) {
+    (void)this->drain();
+  };
+  std::uint32_t events = EPOLLIN;
+#ifdef EPOLLEXCLUSIVE
+  if (this->config_.exclusive) {
+    events |= EPOLLEXCLUSIVE;
+  }
+#endif
+  // Kernels older than 4.5 reject EPOLLEXCLUSIVE, every sharing loop is woken up there
+  if (!this->loop_.add(this->listener_.get_sd(), events, onReadable) &&
+      ((events == EPOLLIN) || (errno != EINVAL) || !this->loop_.add(this->listener_.get_sd(), EPOLLIN, onReadable))) {
+    return this->fail();
+  }
+  this->listening_ = true;
+  return true;
+}
+
+/**
+ * @brief Accepts the next connection, unless the rate limiter of the config refuses its source
+ * 
+ * @param oClient
+ * @param oRefused
+ * 
+ * @return
+ */
+[[nodiscard]] bool Acceptor::accept(InternetSocket& oClient, bool& oRefused) {
+  oRefused = false;
+  if (this->config_.limiter == nullptr) {
+    return this->listener_.accept(oClient, SOCK_NONBLOCK);
+  }
+  sockaddr_storage storage;
+  socklen_t size = sizeof(storage);
+  const sd_t client = ::accept4(this->listener_.get_sd(), reinterpret_cast<sockaddr*>(&storage), &size,
+                                SOCK_NONBLOCK | SOCK_CLOEXEC);
+  if (client < 0) {
+    NCS_TRACE(SOCKET_ACCEPT, nullptr, this->listener_.get_sd(), 0, -errno);
+    return false;
+  }
+  if (!this->config_.limiter->admit(reinterpret_cast<sockaddr*>(&storage), size, metrics::clock_ns())) {
+    // Reset rather than closed gracefully, the refused connection leaves no TIME_WAIT behind
+    const linger reset = {1, 0};
+    (void)setsockopt(client, SOL_SOCKET, SO_LINGER, &reset, sizeof(reset));
+    ::close(client);
+    oRefused = true;
+    if (this->metrics_ != nullptr) {
+      this->metrics_->on_rate_limited();
+    }
+    return false;
+  }
+  addr::InternetAddress peer;
+  (void)peer.set_sockaddr(reinterpret_cast<sockaddr*>(&storage), size);
+  oClient.close();
+  oClient.set_sd(client);
+  oClient.set_addr(peer);
+  NCS_TRACE(SOCKET_ACCEPT, &oClient.get_addr(), this->listener_.get_sd(), 0, client);
+  return true;
+}
+
+/**
+ * @brief Gives up the spare descriptor to accept one connection and close it right away
+ * 
+ * @return
+ */
+[[nodiscard]] bool Acceptor::shed(void) {
+  if (this->spareSd_ < 0) {
+    return false;
+  }
+  ::close(this->spareSd_);
+  const sd_t client = ::accept4(this->listener_.get_sd(), nullptr, nullptr, SOCK_CLOEXEC);
+  if (client >= 0) {
+    ::close(client);
+  }
+  this->spareSd_ = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+  if (client < 0) {
+    return false;
+  }
+  if (this->metrics_ != nullptr) {
+    this->metrics_->on_shed();
+  }
+  return true;
+}
+
+/**
+ * @brief Feeds the accept queue length to the metrics
+ */
+void Acceptor::sample_backlog(void) const {
+  // On a listener TCP_INFO reports the accept queue length as unacked and its limit as sacked
+  tcp_info info{};
+  socklen_t size = sizeof(info);
+  if (getsockopt(this->listener_.get_sd(), IPPROTO_TCP, TCP_INFO, &info, &size) == 0) {
+    this->metrics_->on_backlog(info.tcpi_unacked, info.tcpi_sacked);
+  }
+}
+
+/**
+ * @brief Closes everything, keeping errno
+ * 
+ * @return
+ */
+bool Acceptor::fail(void) {
+  const int error = errno;
+  this->close();
+  errno = error;
+  return false;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+} // namespace sock
+} // namespace ncs
@@ -0,0 +1,400 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file ConnectionTable.cpp
+ *
+ * @brief
+ */
+
+
+#include <ConnectionTable.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+
+namespace ncs { // Network Communications System
+namespace sock { // Network Communications System Sockets
+
+
+/** PUBLIC METHODS **/
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+/**
+ * @brief Default constructor
+ */
+ConnectionTable::ConnectionTable(void) {}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Reserves room for iConnections connections in every column
+ * 
+ * @param iConnections
+ */
+void ConnectionTable::reserve(const std::size_t& iConnections) {
+  this->slots_.reserve(iConnections);
+  this->owners_.reserve(iConnections);
+  this->sds_.reserve(iConnections);
+  this->peers_.reserve(iConnections);
+  this->states_.reserve(iConnections);
+  this->lastActive_.reserve(iConnections);
+  this->bytesIn_.reserve(iConnections);
+  this->bytesOut_.reserve(iConnections);
+}
+
+/**
+ * @brief Registers an open connection
+ * 
+ * @param iSd
+ * @param iPeer
+ * @param iSize
+ * @param iNowNs
+ * 
+ * @return
+ */
+[[nodiscard]] connection_handle_t ConnectionTable::insert(const sd_t& iSd, const sockaddr* iPeer,
+                                                          const socklen_t& iSize, const std::uint64_t& iNowNs) {
+  addr::pooled_address_t peer;
+  peer.ip = this->pool_.intern(iPeer, iSize);
+  if (peer.ip == addr::INVALID_ADDRESS_HANDLE) {
+    return INVALID_CONNECTION_HANDLE;
+  }
+  // Both sockaddr kinds keep the port at the same offset
+  peer.port = ntohs(reinterpret_cast<const sockaddr_in*>(iPeer)->sin_port);
+
+  std::uint32_t slot = 0;
+  if (!this->freeSlots_.empty()) {
+    slot = this->freeSlots_.back();
+    this->freeSlots_.pop_back();
+  }
+  else {
+    slot = static_cast<std::uint32_t>(this->slots_.size());
+    this->slots_.emplace_back();
+  }
+  this->slots_[slot].row = static_cast<std::uint32_t>(this->sds_.size());
+  this->slots_[slot].live = true;
+  this->owners_.push_back(slot);
+  this->sds_.push_back(iSd);
+  this->peers_.push_back(peer);
+  this->states_.push_back(CONNECTION_OPEN);
+  this->lastActive_.push_back(iNowNs);
+  this->bytesIn_.push_back(0);
+  this->bytesOut_.push_back(0);
+  return this->make_handle(slot);
+}
+
+/**
+ * @brief Unregisters a connection
+ * 
+ * @param iHandle
+ * 
+ * @return
+ */
+bool ConnectionTable::erase(const connection_handle_t& iHandle) {
+  const std::size_t row = this->get_row(iHandle);
+  if (row == NO_ROW) {
+    return false;
+  }
+  connection_slot_t& slot = this->slots_[this->owners_[row]];
+  slot.live = false;
+  ++slot.generation;
+  this->freeSlots_.push_back(this->owners_[row]);
+  this->pool_.release(this->peers_[row].ip);
+
+  const std::size_t last = this->sds_.size() - 1;
+  if (row != last) {
+    this->owners_[row] = this->owners_[last];
+    this->sds_[row] = this->sds_[last];
+    this->peers_[row] = this->peers_[last];
+    this->states_[row] = this->states_[last];
+    this->lastActive_[row] = this->lastActive_[last];
+    this->bytesIn_[row] = this->bytesIn_[last];
+    this->bytesOut_[row] = this->bytesOut_[last];
+    this->slots_[this->owners_[row]].row = static_cast<std::uint32_t>(row);
+  }
+  this->owners_.pop_back();
+  this->sds_.pop_back();
+  this->peers_.pop_back();
+  this->states_.pop_back();
+  this->lastActive_.pop_back();
+  this->bytesIn_.pop_back();
+  this->bytesOut_.pop_back();
+  return true;
+}
+
+/**
+ * @brief Records activity on a connection
+ * 
+ * @param iHandle
+ * @param iNowNs
+ * @param iBytesIn
+ * @param iBytesOut
+ * 
+ * @return
+ */
+bool ConnectionTable::touch(const connection_handle_t& iHandle, const std::uint64_t& iNowNs,
+                            const std::uint64_t& iBytesIn, const std::uint64_t& iBytesOut) {
+  const std::size_t row = this->get_row(iHandle);
+  if (row == NO_ROW) {
+    return false;
+  }
+  this->lastActive_[row] = iNowNs;
+  this->bytesIn_[row] += iBytesIn;
+  this->bytesOut_[row] += iBytesOut;
+  return true;
+}
+
+/**
+ * @brief Collects the handles of the connections idle for longer than iIdleNs
+ * 
+ * @param iNowNs
+ * @param iIdleNs
+ * @param oIdle
+ * 
+ * @return
+ */
+std::size_t ConnectionTable::sweep_idle(const std::uint64_t& iNowNs, const std::uint64_t& iIdleNs,
+                                        std::vector<connection_handle_t>& oIdle) const {
+  oIdle.clear();
+  // Idle connections are rare, a first pass over the timestamps alone finds whether any row needs a closer look
+  const std::size_t rows = this->lastActive_.size();
+  const std::uint64_t* lastActive = this->lastActive_.data();
+  const std::uint64_t threshold = (iNowNs > iIdleNs) ? (iNowNs - iIdleNs) : 0;
+  std::size_t count = 0;
+  for (std::size_t row = 0; row < rows; ++row) {
+    count += (lastActive[row] < threshold) ? 1 : 0;
+  }
+  if (count == 0) {
+    return 0;
+  }
+  oIdle.reserve(count);
+  for (std::size_t row = 0; row < rows; ++row) {
+    if (lastActive[row] < threshold) {
+      oIdle.push_back(this->make_handle(this->owners_[row]));
+    }
+  }
+  return count;
+}
+
+/**
+ * @brief Counts connections per state and sums their traffic
+ * 
+ * @return
+ */
+[[nodiscard]] connection_totals_t ConnectionTable::aggregate(void) const {
+  connection_totals_t totals;
+  const std::size_t rows = this->states_.size();
+  totals.connections = rows;
+  const std::uint64_t* bytesIn = this->bytesIn_.data();
+  const std::uint64_t* bytesOut = this->bytesOut_.data();
+  const std::uint8_t* states = this->states_.data();
+  for (std::size_t row = 0; row < rows; ++row) {
+    totals.bytes_in += bytesIn[row];
+    totals.bytes_out += bytesOut[row];
+  }
+  std::size_t draining = 0;
+  std::size_t closing = 0;
+  for (std::size_t row = 0; row < rows; ++row) {
+    draining += (states[row] == CONNECTION_DRAINING) ? 1 : 0;
+    closing += (states[row] == CONNECTION_CLOSING) ? 1 : 0;
+  }
+  totals.states[CONNECTION_DRAINING] = draining;
+  totals.states[CONNECTION_CLOSING] = closing;
+  totals.states[CONNECTION_OPEN] = rows - draining - closing;
+  return totals;
+}
+
+/**
+ * @brief Moves every open connection to iState
+ * 
+ * @param iState
+ * 
+ * @return
+ */
+std::size_t ConnectionTable::mark_all(const connection_state_e& iState) {
+  std::size_t changed = 0;
+  std::uint8_t* states = this->states_.data();
+  const std::size_t rows = this->states_.size();
+  for (std::size_t row = 0; row < rows; ++row) {
+    const bool open = (states[row] == CONNECTION_OPEN);
+    changed += open ? 1 : 0;
+    states[row] = open ? static_cast<std::uint8_t>(iState) : states[row];
+  }
+  return changed;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+/**
+ * @brief
+ * 
+ * @param iHandle
+ * @param iState
+ * 
+ * @return
+ */
+bool ConnectionTable::set_state(const connection_handle_t& iHandle, const connection_state_e& iState) {
+  const std::size_t row = this->get_row(iHandle);
+  if ((row == NO_ROW) || (iState >= CONNECTION_STATES)) {
+    return false;
+  }
+  this->states_[row] = iState;
+  return true;
+}
+
+/**
+ * @brief Row of a connection in the columns
+ * 
+ * @param iHandle
+ * 
+ * @return
+ */
+[[nodiscard]] std::size_t ConnectionTable::get_row(const connection_handle_t& iHandle) const {
+  const std::uint64_t slot = iHandle & 0xffffffffu;
+  if ((slot >= this->slots_.size()) || !this->slots_[slot].live ||
+      (this->slots_[slot].generation != static_cast<std::uint32_t>(iHandle >> 32))) {
+    return NO_ROW;
+  }
+  return this->slots_[slot].row;
+}
+
+/**
+ * @brief
+ * 
+ * @param iHandle
+ * @param oPeer
+ * 
+ * @return
+ */
+[[nodiscard]] bool ConnectionTable::get_peer(const connection_handle_t& iHandle, addr::InternetAddress& oPeer) const {
+  const std::size_t row = this->get_row(iHandle);
+  return (row != NO_ROW) && this->pool_.to_address(this->peers_[row], oPeer);
+}
+
+/**
+ * @brief Live connections
+ * 
+ * @return
+ */
+[[nodiscard]] std::size_t ConnectionTable::get_size(void) const {
+  return this->sds_.size();
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] const std::vector<sd_t>& ConnectionTable::get_sds(void) const {
+  return this->sds_;
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] const std::vector<addr::pooled_address_t>& ConnectionTable::get_peers(void) const {
+  return this->peers_;
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] const std::vector<std::uint8_t>& ConnectionTable::get_states(void) const {
+  return this->states_;
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] const std::vector<std::uint64_t>& ConnectionTable::get_last_active(void) const {
+  return this->lastActive_;
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] const addr::AddressPool& ConnectionTable::get_pool(void) const {
+  return this->pool_;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+/**
+ * @brief Destructor
+ */
+ConnectionTable::~ConnectionTable() {}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PROTECTED METHODS **/
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PRIVATE METHODS **/
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Handle of a slot at its current generation
+ * 
+ * @param iSlot
+ * 
+ * @return
+ */
+[[nodiscard]] connection_handle_t ConnectionTable::make_handle(const std::uint32_t& iSlot) const {
+  return (static_cast<connection_handle_t>(this->slots_[iSlot].generation) << 32) | iSlot;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+} // namespace sock
+} // namespace ncs
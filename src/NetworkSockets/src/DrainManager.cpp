@@ -0,0 +1,410 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file DrainManager.cpp
+ *
+ * @brief
+ */
+
+
+#include <DrainManager.h>
+
+#include <cerrno>
+
+#include <sys/epoll.h>
+#include <sys/socket.h>
+
+
+namespace ncs { // Network Communications System
+namespace sock { // Network Communications System Sockets
+
+
+/** PUBLIC METHODS **/
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+/**
+ * @brief Config constructor
+ * 
+ * @param iConfig
+ */
+DrainManager::DrainManager(const drain_config_t& iConfig)
+    : config_(iConfig), draining_(false), loopsDone_(0), connections_(0), flushed_(0), halfClosed_(0), closed_(0),
+      expired_(0) {}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Takes part iLoop in the drain, before drain() is called
+ * 
+ * @param ioLoop
+ * 
+ * @return
+ */
+std::size_t DrainManager::add_loop(EventLoop& ioLoop) {
+  this->loops_.push_back(std::make_unique<drain_loop_t>());
+  this->loops_.back()->loop = &ioLoop;
+  return this->loops_.size() - 1;
+}
+
+/**
+ * @brief Closes ioAcceptor when the drain starts, before drain() is called
+ * 
+ * @param iLoop
+ * @param ioAcceptor
+ */
+void DrainManager::add_acceptor(const std::size_t& iLoop, Acceptor& ioAcceptor) {
+  this->loops_.at(iLoop)->acceptors.push_back(&ioAcceptor);
+}
+
+/**
+ * @brief Drains ioSocket with the rest of its loop, called from the thread of the loop
+ * 
+ * @param iLoop
+ * @param ioSocket
+ * @param ioWrites
+ */
+void DrainManager::track(const std::size_t& iLoop, InternetSocket& ioSocket, WriteBatcher* ioWrites) {
+  drain_loop_t& loop = *this->loops_.at(iLoop);
+  const sd_t sd = ioSocket.get_sd();
+  if (loop.done) {
+    (void)loop.loop->remove(sd);
+    ioSocket.close();
+    ++this->connections_;
+    ++this->closed_;
+    return;
+  }
+  drain_connection_t& connection = loop.connections[sd];
+  connection.socket = &ioSocket;
+  connection.writes = ioWrites;
+  if (loop.started) {
+    ++this->connections_;
+    this->begin(loop, sd);
+  }
+}
+
+/**
+ * @brief Forgets ioSocket, called from the thread of the loop before the application closes it
+ * 
+ * @param iLoop
+ * @param iSocket
+ */
+void DrainManager::untrack(const std::size_t& iLoop, const InternetSocket& iSocket) {
+  drain_loop_t& loop = *this->loops_.at(iLoop);
+  const auto found = loop.connections.find(iSocket.get_sd());
+  if (found == loop.connections.end()) {
+    return;
+  }
+  loop.connections.erase(found);
+  if (loop.started) {
+    (void)loop.loop->remove(iSocket.get_sd());
+    ++this->closed_;
+    if (loop.connections.empty()) {
+      this->complete(loop);
+    }
+  }
+}
+
+/**
+ * @brief Starts draining every loop, callable from any thread, returns at once
+ * 
+ * @return
+ */
+bool DrainManager::drain(void) {
+  if (this->draining_.exchange(true)) {
+    return false;
+  }
+  for (const std::unique_ptr<drain_loop_t>& loop : this->loops_) {
+    drain_loop_t* target = loop.get();
+    loop->loop->post([this, target]() {
+      this->start(*target);
+    });
+  }
+  return true;
+}
+
+/**
+ * @brief Waits until every loop closed its last connection
+ * 
+ * @param iTimeout
+ * 
+ * @return
+ */
+bool DrainManager::wait(const std::chrono::milliseconds& iTimeout) const {
+  std::unique_lock<std::mutex> lock(this->doneMutex_);
+  return this->doneCondition_.wait_for(lock, iTimeout, [this]() {
+    return this->draining_.load() && (this->loopsDone_.load() == this->loops_.size());
+  });
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+/**
+ * @brief
+ * 
+ * @return
+ */
+const drain_config_t& DrainManager::get_config(void) const {
+  return this->config_;
+}
+
+/**
+ * @brief Where the drain is, readable from any thread
+ * 
+ * @return
+ */
+drain_progress_t DrainManager::get_progress(void) const {
+  drain_progress_t progress;
+  progress.loops = this->loops_.size();
+  progress.loops_done = this->loopsDone_.load();
+  progress.connections = this->connections_.load();
+  progress.flushed = this->flushed_.load();
+  progress.half_closed = this->halfClosed_.load();
+  progress.closed = this->closed_.load();
+  progress.expired = this->expired_.load();
+  progress.done = this->draining_.load() && (progress.loops_done == progress.loops);
+  return progress;
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+bool DrainManager::is_draining(void) const {
+  return this->draining_.load();
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+/**
+ * @brief Destructor
+ */
+DrainManager::~DrainManager() {}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PROTECTED METHODS **/
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PRIVATE METHODS **/
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Closes the acceptors of ioLoop and starts draining its connections, on the thread of the loop
+ * 
+ * @param ioLoop
+ */
+void DrainManager::start(drain_loop_t& ioLoop) {
+  ioLoop.started = true;
+  for (Acceptor* acceptor : ioLoop.acceptors) {
+    acceptor->close();
+  }
+  this->connections_ += ioLoop.connections.size();
+  if (ioLoop.connections.empty()) {
+    this->complete(ioLoop);
+    return;
+  }
+  ioLoop.deadline = ioLoop.loop->schedule(loop_clock_t::now() + this->config_.deadline, [this, &ioLoop]() {
+    this->expire(ioLoop);
+  });
+  // begin() may close a connection right away, walks a copy
+  std::vector<sd_t> sds;
+  sds.reserve(ioLoop.connections.size());
+  for (const auto& connection : ioLoop.connections) {
+    sds.push_back(connection.first);
+  }
+  for (const sd_t& sd : sds) {
+    this->begin(ioLoop, sd);
+  }
+}
+
+/**
+ * @brief Takes iSd away from the handlers of the application and starts draining it
+ * 
+ * @param ioLoop
+ * @param iSd
+ */
+void DrainManager::begin(drain_loop_t& ioLoop, const sd_t& iSd) {
+  drain_connection_t& connection = ioLoop.connections.at(iSd);
+  (void)ioLoop.loop->remove(iSd);
+  const event_handler_t handler = [this, &ioLoop, iSd](const std::uint32_t&) {
+    this->step(ioLoop, iSd);
+  };
+  if (!connection.socket->set_non_blocking(true) || !ioLoop.loop->add(iSd, EPOLLIN | EPOLLRDHUP | EPOLLOUT, handler)) {
+    this->finish(ioLoop, iSd, false);
+    return;
+  }
+  this->step(ioLoop, iSd);
+}
+
+/**
+ * @brief Moves the drain of iSd forward
+ * 
+ * @param ioLoop
+ * @param iSd
+ */
+void DrainManager::step(drain_loop_t& ioLoop, const sd_t& iSd) {
+  const auto found = ioLoop.connections.find(iSd);
+  if (found == ioLoop.connections.end()) {
+    return;
+  }
+  drain_connection_t& connection = found->second;
+  if (!connection.half_closed) {
+    if ((connection.writes != nullptr) && connection.writes->has_pending()) {
+      const flush_status_e status = connection.writes->flush();
+      if (status == FLUSH_ERROR) {
+        this->finish(ioLoop, iSd, false);
+        return;
+      }
+      if (status == FLUSH_DONE) {
+        ++this->flushed_;
+      }
+    }
+    if ((connection.writes == nullptr) || !connection.writes->has_pending()) {
+      if (!connection.socket->shutdown(SHUT_WR)) {
+        this->finish(ioLoop, iSd, false);
+        return;
+      }
+      connection.half_closed = true;
+      ++this->halfClosed_;
+    }
+  }
+  char buffer[DRAIN_READ_SIZE];
+  for (std::size_t reads = 0; !connection.peer_closed && (reads < DRAIN_READ_BATCH); ++reads) {
+    const ssize_t got = connection.socket->recv(buffer, sizeof(buffer));
+    if ((got < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK))) {
+      break;
+    }
+    if ((got < 0) && (errno != EINTR)) {
+      this->finish(ioLoop, iSd, false);
+      return;
+    }
+    connection.peer_closed = (got == 0);
+  }
+  if (connection.half_closed && connection.peer_closed) {
+    this->finish(ioLoop, iSd, false);
+    return;
+  }
+  // Stops waiting for what already happened, level triggered events would fire again and again otherwise
+  std::uint32_t events = connection.peer_closed ? 0 : (EPOLLIN | EPOLLRDHUP);
+  if (!connection.half_closed) {
+    events |= EPOLLOUT;
+  }
+  if (!ioLoop.loop->modify(iSd, events)) {
+    this->finish(ioLoop, iSd, false);
+  }
+}
+
+/**
+ * @brief Closes iSd and forgets it
+ * 
+ * @param ioLoop
+ * @param iSd
+ * @param iExpired
+ */
+void DrainManager::finish(drain_loop_t& ioLoop, const sd_t& iSd, const bool& iExpired) {
+  const auto found = ioLoop.connections.find(iSd);
+  if (found == ioLoop.connections.end()) {
+    return;
+  }
+  const drain_connection_t connection = found->second;
+  ioLoop.connections.erase(found);
+  (void)ioLoop.loop->remove(iSd);
+  if (connection.writes != nullptr) {
+    connection.writes->clear();
+  }
+  if (iExpired && (this->config_.on_deadline == LINGER_RESET)) {
+    const linger reset = {1, 0};
+    (void)setsockopt(iSd, SOL_SOCKET, SO_LINGER, &reset, sizeof(reset));
+  }
+  connection.socket->close();
+  ++(iExpired ? this->expired_ : this->closed_);
+  if (ioLoop.connections.empty()) {
+    this->complete(ioLoop);
+  }
+}
+
+/**
+ * @brief Closes every connection of ioLoop still open at the deadline
+ * 
+ * @param ioLoop
+ */
+void DrainManager::expire(drain_loop_t& ioLoop) {
+  ioLoop.deadline = 0;
+  std::vector<sd_t> sds;
+  sds.reserve(ioLoop.connections.size());
+  for (const auto& connection : ioLoop.connections) {
+    sds.push_back(connection.first);
+  }
+  for (const sd_t& sd : sds) {
+    this->finish(ioLoop, sd, true);
+  }
+}
+
+/**
+ * @brief Counts ioLoop as done once it has no connection left
+ * 
+ * @param ioLoop
+ */
+void DrainManager::complete(drain_loop_t& ioLoop) {
+  if (ioLoop.done) {
+    return;
+  }
+  if (ioLoop.deadline != 0) {
+    ioLoop.loop->cancel(ioLoop.deadline);
+    ioLoop.deadline = 0;
+  }
+  ioLoop.done = true;
+  {
+    std::lock_guard<std::mutex> lock(this->doneMutex_);
+    ++this->loopsDone_;
+  }
+  this->doneCondition_.notify_all();
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+} // namespace sock
+} // namespace ncs
@@ -0,0 +1,501 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file EventLoop.cpp
+ *
+ * @brief
+ */
+
+
+#include <EventLoop.h>
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+
+#include <SocketOptions.h>
+
+
+namespace ncs { // Network Communications System
+namespace sock { // Network Communications System Sockets
+
+
+/**
+ * @brief Layout of struct epoll_params, missing from older kernel headers
+ */
+struct epoll_busy_params_t {
+  std::uint32_t busy_poll_usecs;
+  std::uint16_t busy_poll_budget;
+  std::uint8_t prefer_busy_poll;
+  std::uint8_t pad;
+};
+
+/**
+ * EventLoop constants
+ */
+constexpr unsigned long EPOLL_SET_PARAMS = _IOW(0x8A, 0x01, epoll_busy_params_t);   // EPIOCSPARAMS, Linux 6.9
+
+
+/** PUBLIC METHODS **/
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+/**
+ * @brief Default constructor
+ */
+EventLoop::EventLoop(void)
+    : epollSd_(epoll_create1(EPOLL_CLOEXEC)), wakeSd_(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)), stopped_(false),
+      iteration_(0), lastTask_(0), metrics_(nullptr), parked_(false), lastActiveNs_(0), hasPosted_(false) {
+  epoll_event event{};
+  event.events = EPOLLIN;
+  event.data.fd = this->wakeSd_;
+  epoll_ctl(this->epollSd_, EPOLL_CTL_ADD, this->wakeSd_, &event);
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Starts watching a descriptor
+ * 
+ * @param iSd
+ * @param iEvents
+ * @param iHandler
+ * 
+ * @return
+ */
+[[nodiscard]] bool EventLoop::add(const sd_t& iSd, const std::uint32_t& iEvents, event_handler_t iHandler) {
+  epoll_event event{};
+  event.events = iEvents;
+  event.data.fd = iSd;
+  if (epoll_ctl(this->epollSd_, EPOLL_CTL_ADD, iSd, &event) != 0) {
+    return false;
+  }
+  this->handlers_[iSd] = std::make_unique<event_handler_t>(std::move(iHandler));
+  if (this->busyPoll_.enabled) {
+    this->prepare_busy_poll(iSd);
+  }
+  return true;
+}
+
+/**
+ * @brief Changes the events watched for a descriptor
+ * 
+ * @param iSd
+ * @param iEvents
+ * 
+ * @return
+ */
+[[nodiscard]] bool EventLoop::modify(const sd_t& iSd, const std::uint32_t& iEvents) {
+  epoll_event event{};
+  event.events = iEvents;
+  event.data.fd = iSd;
+  return epoll_ctl(this->epollSd_, EPOLL_CTL_MOD, iSd, &event) == 0;
+}
+
+/**
+ * @brief Stops watching a descriptor
+ * 
+ * @param iSd
+ * 
+ * @return
+ */
+bool EventLoop::remove(const sd_t& iSd) {
+  auto handler = this->handlers_.find(iSd);
+  if (handler == this->handlers_.end()) {
+    return false;
+  }
+  // The handler may be the one running, keep it alive until the iteration ends
+  this->removed_.push_back(std::move(handler->second));
+  this->handlers_.erase(handler);
+  return epoll_ctl(this->epollSd_, EPOLL_CTL_DEL, iSd, nullptr) == 0;
+}
+
+/**
+ * @brief Runs iTask once, at the end of the current iteration
+ * 
+ * @param iTask
+ * 
+ * @return
+ */
+task_id_t EventLoop::defer(loop_task_t iTask) {
+  this->deferred_.emplace_back(++this->lastTask_, std::move(iTask));
+  return this->lastTask_;
+}
+
+/**
+ * @brief Runs iTask once, at the end of the first iteration reaching iDeadline
+ * 
+ * @param iDeadline
+ * @param iTask
+ * 
+ * @return
+ */
+task_id_t EventLoop::schedule(const loop_clock_t::time_point& iDeadline, loop_task_t iTask) {
+  const task_id_t task = ++this->lastTask_;
+  this->timers_.emplace(std::make_pair(iDeadline, task), std::move(iTask));
+  this->timerDeadlines_.emplace(task, iDeadline);
+  return task;
+}
+
+/**
+ * @brief Drops a deferred or scheduled task that has not run yet
+ * 
+ * @param iTask
+ */
+void EventLoop::cancel(const task_id_t& iTask) {
+  auto deadline = this->timerDeadlines_.find(iTask);
+  if (deadline != this->timerDeadlines_.end()) {
+    this->timers_.erase(std::make_pair(deadline->second, iTask));
+    this->timerDeadlines_.erase(deadline);
+    return;
+  }
+  for (auto* tasks : {&this->deferred_, &this->running_}) {
+    for (auto& deferred : *tasks) {
+      if (deferred.first == iTask) {
+        deferred.second = nullptr;
+        return;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Runs iTask once on the thread running the loop
+ * 
+ * @param iTask
+ */
+void EventLoop::post(loop_task_t iTask) {
+  {
+    std::lock_guard<std::mutex> lock(this->postedMutex_);
+    this->posted_.push_back(std::move(iTask));
+  }
+  this->hasPosted_.store(true, std::memory_order_release);
+  const std::uint64_t value = 1;
+  (void)!write(this->wakeSd_, &value, sizeof(value));
+}
+
+/**
+ * @brief Waits for events, dispatches them, then runs the expired timers and the deferred tasks
+ * 
+ * @param iTimeoutMs
+ * 
+ * @return
+ */
+std::size_t EventLoop::run_once(const int& iTimeoutMs) {
+  const std::uint64_t start = (this->metrics_ != nullptr) ? metrics::clock_ns() : 0;
+  const int ready = this->wait(this->next_timeout(iTimeoutMs));
+  const std::uint64_t woken = (this->metrics_ != nullptr) ? metrics::clock_ns() : 0;
+  std::size_t dispatched = 0;
+  for (int i = 0; i < ready; ++i) {
+    const sd_t sd = this->events_[i].data.fd;
+    if (sd == this->wakeSd_) {
+      std::uint64_t value;
+      (void)!read(this->wakeSd_, &value, sizeof(value));
+      continue;
+    }
+    auto handler = this->handlers_.find(sd);
+    if (handler != this->handlers_.end()) {
+      (*handler->second)(this->events_[i].events);
+      ++dispatched;
+    }
+  }
+  const std::size_t tasks = this->run_tasks();
+  this->removed_.clear();
+  ++this->iteration_;
+  if (this->metrics_ != nullptr) {
+    this->metrics_->on_iteration(dispatched, tasks, woken - start, metrics::clock_ns() - woken);
+  }
+  return dispatched;
+}
+
+/**
+ * @brief Iterates until stop() is called
+ */
+void EventLoop::run(void) {
+  while (!this->stopped_.load(std::memory_order_relaxed)) {
+    this->run_once();
+  }
+  // Reset once stopped rather than on entry, a stop() issued before run() must not be lost
+  this->stopped_.store(false, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Makes run() return after the current iteration
+ */
+void EventLoop::stop(void) {
+  this->stopped_.store(true, std::memory_order_relaxed);
+  const std::uint64_t value = 1;
+  (void)!write(this->wakeSd_, &value, sizeof(value));
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] const std::uint64_t& EventLoop::get_iteration(void) const {
+  return this->iteration_;
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] std::size_t EventLoop::get_watched_count(void) const {
+  return this->handlers_.size();
+}
+
+/**
+ * @brief Accounts every iteration in iMetrics
+ * 
+ * @param iMetrics
+ */
+void EventLoop::set_metrics(metrics::LoopMetrics* iMetrics) {
+  this->metrics_ = iMetrics;
+}
+
+/**
+ * @brief Switches the loop between blocking waits and busy polling
+ * 
+ * @param iConfig
+ * 
+ * @return
+ */
+[[nodiscard]] bool EventLoop::set_busy_poll(const busy_poll_config_t& iConfig) {
+  this->busyPoll_ = iConfig;
+  this->parked_ = false;
+  this->lastActiveNs_ = metrics::clock_ns();
+  if (!iConfig.enabled) {
+    return true;
+  }
+  if (iConfig.cpu >= 0) {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(iConfig.cpu, &cpus);
+    const int error = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    if (error != 0) {
+      errno = error;
+      return false;
+    }
+  }
+  // Lets epoll_wait(2) itself poll the device queues, rejected by kernels older than 6.9
+  epoll_busy_params_t params{};
+  params.busy_poll_usecs = static_cast<std::uint32_t>(std::max(iConfig.socket_busy_poll_us, 0));
+  params.prefer_busy_poll = iConfig.prefer_busy_poll ? 1 : 0;
+  (void)ioctl(this->epollSd_, EPOLL_SET_PARAMS, &params);
+  for (const auto& handler : this->handlers_) {
+    this->prepare_busy_poll(handler.first);
+  }
+  return true;
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] const busy_poll_config_t& EventLoop::get_busy_poll(void) const {
+  return this->busyPoll_;
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] bool EventLoop::is_spinning(void) const {
+  return this->busyPoll_.enabled && !this->parked_;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+/**
+ * @brief Destructor
+ */
+EventLoop::~EventLoop() {
+  close(this->wakeSd_);
+  close(this->epollSd_);
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PROTECTED METHODS **/
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PRIVATE METHODS **/
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Timeout for epoll_wait(2) honouring pending tasks and timers
+ * 
+ * @param iTimeoutMs
+ * 
+ * @return
+ */
+[[nodiscard]] int EventLoop::next_timeout(const int& iTimeoutMs) const {
+  if (!this->deferred_.empty()) {
+    return 0;
+  }
+  if (this->timers_.empty()) {
+    return iTimeoutMs;
+  }
+  const auto remaining = this->timers_.begin()->first.first - loop_clock_t::now();
+  // Round up so the loop never wakes before the deadline and spins
+  const auto remainingMs = std::chrono::ceil<std::chrono::milliseconds>(remaining).count();
+  const int timerMs = static_cast<int>(std::max<decltype(remainingMs)>(remainingMs, 0));
+  return (iTimeoutMs < 0) ? timerMs : std::min(timerMs, iTimeoutMs);
+}
+
+/**
+ * @brief Runs the expired timers and the deferred tasks
+ * 
+ * @return
+ */
+[[nodiscard]] std::size_t EventLoop::run_tasks(void) {
+  const loop_clock_t::time_point now = loop_clock_t::now();
+  std::size_t ran = 0;
+  while (!this->timers_.empty() && (this->timers_.begin()->first.first <= now)) {
+    auto timer = this->timers_.begin();
+    loop_task_t task = std::move(timer->second);
+    this->timerDeadlines_.erase(timer->first.second);
+    this->timers_.erase(timer);
+    task();
+    ++ran;
+  }
+  if (this->hasPosted_.exchange(false, std::memory_order_acquire)) {
+    std::vector<loop_task_t> posted;
+    {
+      std::lock_guard<std::mutex> lock(this->postedMutex_);
+      posted.swap(this->posted_);
+    }
+    for (loop_task_t& task : posted) {
+      task();
+      ++ran;
+    }
+  }
+  // Tasks deferred while these run belong to the next iteration
+  this->running_.swap(this->deferred_);
+  for (std::size_t i = 0; i < this->running_.size(); ++i) {
+    loop_task_t task = std::move(this->running_[i].second);
+    this->running_[i].second = nullptr;
+    if (task) {
+      task();
+      ++ran;
+    }
+  }
+  this->running_.clear();
+  return ran;
+}
+
+/**
+ * @brief epoll_wait(2), spinning with a zero timeout first when busy polling
+ * 
+ * @param iTimeoutMs
+ * 
+ * @return
+ */
+[[nodiscard]] int EventLoop::wait(const int& iTimeoutMs) {
+  if (!this->busyPoll_.enabled || (iTimeoutMs == 0)) {
+    return epoll_wait(this->epollSd_, this->events_, MAX_LOOP_EVENTS, iTimeoutMs);
+  }
+  const std::uint64_t start = metrics::clock_ns();
+  const std::uint64_t idleNs = static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(this->busyPoll_.idle_fallback).count());
+  std::uint64_t now = start;
+  if (!this->parked_) {
+    while (true) {
+      const int ready = epoll_wait(this->epollSd_, this->events_, MAX_LOOP_EVENTS, 0);
+      now = metrics::clock_ns();
+      if (ready != 0) {
+        this->lastActiveNs_ = now;
+        return ready;
+      }
+      if ((iTimeoutMs > 0) && (now - start >= static_cast<std::uint64_t>(iTimeoutMs) * 1000000)) {
+        return 0;
+      }
+      if ((idleNs > 0) && (now - this->lastActiveNs_ >= idleNs)) {
+        this->parked_ = true;
+        break;
+      }
+    }
+  }
+  // Nothing came for the whole idle period, block until traffic resumes instead of burning the core
+  int timeout = iTimeoutMs;
+  if (timeout > 0) {
+    timeout -= static_cast<int>(std::min<std::uint64_t>((now - start) / 1000000, static_cast<std::uint64_t>(timeout)));
+  }
+  const int ready = epoll_wait(this->epollSd_, this->events_, MAX_LOOP_EVENTS, timeout);
+  if (ready > 0) {
+    this->parked_ = false;
+    this->lastActiveNs_ = metrics::clock_ns();
+  }
+  return ready;
+}
+
+/**
+ * @brief Sets the busy poll socket options on iSd
+ * 
+ * @param iSd
+ */
+void EventLoop::prepare_busy_poll(const sd_t& iSd) const {
+  const int busyPoll = this->busyPoll_.socket_busy_poll_us;
+  const int prefer = this->busyPoll_.prefer_busy_poll ? 1 : 0;
+  if (busyPoll > 0) {
+    (void)setsockopt(iSd, busy_poll_t::LEVEL, busy_poll_t::NAME, &busyPoll, sizeof(busyPoll));
+  }
+  (void)setsockopt(iSd, prefer_busy_poll_t::LEVEL, prefer_busy_poll_t::NAME, &prefer, sizeof(prefer));
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+} // namespace sock
+} // namespace ncs
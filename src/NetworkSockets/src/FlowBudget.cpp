@@ -0,0 +1,154 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file FlowBudget.cpp
+ *
+ * @brief
+ */
+
+
+#include <FlowBudget.h>
+
+
+namespace ncs { // Network Communications System
+namespace sock { // Network Communications System Sockets
+
+
+/** PUBLIC METHODS **/
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+/**
+ * @brief Capacity constructor
+ * 
+ * @param iCapacity
+ */
+FlowBudget::FlowBudget(const std::size_t& iCapacity) : capacity_(iCapacity), used_(0), peak_(0), rejected_(0) {}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Takes iSize bytes from the budget
+ * 
+ * @param iSize
+ * 
+ * @return
+ */
+[[nodiscard]] bool FlowBudget::reserve(const std::size_t& iSize) {
+  std::size_t used = this->used_.load(std::memory_order_relaxed);
+  do {
+    if (iSize > this->capacity_ - used) {
+      this->rejected_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+  } while (!this->used_.compare_exchange_weak(used, used + iSize, std::memory_order_relaxed));
+  std::size_t peak = this->peak_.load(std::memory_order_relaxed);
+  while ((used + iSize > peak) && !this->peak_.compare_exchange_weak(peak, used + iSize, std::memory_order_relaxed)) {
+  }
+  return true;
+}
+
+/**
+ * @brief Gives back iSize previously reserved bytes
+ * 
+ * @param iSize
+ */
+void FlowBudget::release(const std::size_t& iSize) {
+  this->used_.fetch_sub(iSize, std::memory_order_relaxed);
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] std::size_t FlowBudget::get_capacity(void) const {
+  return this->capacity_;
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] std::size_t FlowBudget::get_used(void) const {
+  return this->used_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] flow_budget_counters_t FlowBudget::get_counters(void) const {
+  flow_budget_counters_t counters;
+  counters.capacity = this->capacity_;
+  counters.used = this->used_.load(std::memory_order_relaxed);
+  counters.peak = this->peak_.load(std::memory_order_relaxed);
+  counters.rejected = this->rejected_.load(std::memory_order_relaxed);
+  return counters;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+/**
+ * @brief Destructor
+ */
+FlowBudget::~FlowBudget() {}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PROTECTED METHODS **/
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PRIVATE METHODS **/
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+} // namespace sock
+} // namespace ncs
@@ -0,0 +1,238 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file FlowController.cpp
+ *
+ * @brief
+ */
+
+
+#include <FlowController.h>
+
+#include <algorithm>
+
+
+namespace ncs { // Network Communications System
+namespace sock { // Network Communications System Sockets
+
+
+/** PUBLIC METHODS **/
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+/**
+ * @brief Limits constructor
+ * 
+ * @param iLimits
+ * @param iBudget
+ */
+FlowController::FlowController(const flow_limits_t& iLimits, FlowBudget* iBudget)
+    : limits_(iLimits), budget_(iBudget), queued_(0), saturated_(false), counters_(), upstreams_(), onHigh_(),
+      onLow_() {
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Accounts for iSize newly queued bytes
+ * 
+ * @param iSize
+ * 
+ * @return
+ */
+[[nodiscard]] bool FlowController::reserve(const std::size_t& iSize) {
+  if ((this->budget_ != nullptr) && !this->budget_->reserve(iSize)) {
+    ++this->counters_.rejected;
+    return false;
+  }
+  this->queued_ += iSize;
+  this->counters_.peak = std::max(this->counters_.peak, this->queued_);
+  if (!this->saturated_ && (this->queued_ >= this->limits_.high_watermark)) {
+    this->saturated_ = true;
+    ++this->counters_.high_crossings;
+    for (ReadGate* upstream : this->upstreams_) {
+      upstream->pause();
+    }
+    if (this->onHigh_) {
+      this->onHigh_(this->queued_);
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Accounts for iSize bytes leaving the queue
+ * 
+ * @param iSize
+ */
+void FlowController::release(const std::size_t& iSize) {
+  const std::size_t released = std::min(iSize, this->queued_);
+  this->queued_ -= released;
+  if (this->budget_ != nullptr) {
+    this->budget_->release(released);
+  }
+  if (this->saturated_ && (this->queued_ <= this->limits_.low_watermark)) {
+    this->saturated_ = false;
+    ++this->counters_.low_crossings;
+    for (ReadGate* upstream : this->upstreams_) {
+      upstream->resume();
+    }
+    if (this->onLow_) {
+      this->onLow_(this->queued_);
+    }
+  }
+}
+
+/**
+ * @brief Pauses iGate while this connection is saturated
+ * 
+ * @param iGate
+ */
+void FlowController::attach_upstream(ReadGate& iGate) {
+  this->upstreams_.push_back(&iGate);
+  if (this->saturated_) {
+    iGate.pause();
+  }
+}
+
+/**
+ * @brief
+ * 
+ * @param iGate
+ */
+void FlowController::detach_upstream(ReadGate& iGate) {
+  auto upstream = std::find(this->upstreams_.begin(), this->upstreams_.end(), &iGate);
+  if (upstream != this->upstreams_.end()) {
+    this->upstreams_.erase(upstream);
+    if (this->saturated_) {
+      iGate.resume();
+    }
+  }
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+/**
+ * @brief
+ * 
+ * @param iHandler
+ */
+void FlowController::set_high_watermark_handler(watermark_handler_t iHandler) {
+  this->onHigh_ = std::move(iHandler);
+}
+
+/**
+ * @brief
+ * 
+ * @param iHandler
+ */
+void FlowController::set_low_watermark_handler(watermark_handler_t iHandler) {
+  this->onLow_ = std::move(iHandler);
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] const flow_limits_t& FlowController::get_limits(void) const {
+  return this->limits_;
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] bool FlowController::is_saturated(void) const {
+  return this->saturated_;
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] const std::size_t& FlowController::get_queued_size(void) const {
+  return this->queued_;
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] const flow_counters_t& FlowController::get_counters(void) const {
+  return this->counters_;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+/**
+ * @brief Destructor
+ */
+FlowController::~FlowController() {
+  if (this->budget_ != nullptr) {
+    this->budget_->release(this->queued_);
+  }
+  if (this->saturated_) {
+    for (ReadGate* upstream : this->upstreams_) {
+      upstream->resume();
+    }
+  }
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PROTECTED METHODS **/
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PRIVATE METHODS **/
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+} // namespace sock
+} // namespace ncs
@@ -0,0 +1,236 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file HappyEyeballs.cpp
+ *
+ * @brief
+ */
+
+
+#include <HappyEyeballs.h>
+
+#include <poll.h>
+#include <sys/socket.h>
+
+#include <algorithm>
+#include <cerrno>
+
+
+namespace ncs { // Network Communications System
+namespace sock { // Network Communications System Sockets
+
+
+/** PUBLIC METHODS **/
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+/**
+ * @brief Config constructor
+ * 
+ * @param iConfig
+ */
+HappyEyeballs::HappyEyeballs(const eyeballs_config_t& iConfig) : config_(iConfig), attempts_(0) {
+  this->config_.attempt_delay = std::max(this->config_.attempt_delay, MIN_ATTEMPT_DELAY);
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Connects oSocket to the first candidate that answers
+ * 
+ * @param iCandidates
+ * @param oSocket
+ * 
+ * @return
+ */
+bool HappyEyeballs::connect(const std::vector<addr::InternetAddress>& iCandidates, InternetSocket& oSocket) {
+  using clock = std::chrono::steady_clock;
+  const std::vector<addr::InternetAddress> candidates =
+      sort(iCandidates, this->config_.preferred, this->config_.first_family_count);
+  const clock::time_point deadline = clock::now() + this->config_.timeout;
+  clock::time_point nextStart = clock::now();
+  std::vector<InternetSocket> pending;
+  std::vector<pollfd> entries;
+  std::size_t next = 0;
+  int error = ETIMEDOUT;
+  this->attempts_ = 0;
+
+  while (true) {
+    const clock::time_point now = clock::now();
+    if (now >= deadline) {
+      error = ETIMEDOUT;
+      break;
+    }
+    if (next < candidates.size() && (now >= nextStart || pending.empty())) {
+      const addr::InternetAddress& candidate = candidates[next++];
+      InternetSocket attempt;
+      ++this->attempts_;
+      if (!attempt.open(candidate.get_address_family()) || !attempt.set_non_blocking(true) ||
+          ((this->config_.profile != nullptr) && !this->config_.profile->apply(attempt)) ||
+          !attempt.connect(candidate)) {
+        // Failing synchronously, e.g. ENETUNREACH, hands the turn to the next candidate at once
+        error = errno;
+        attempt.close();
+        continue;
+      }
+      pending.push_back(std::move(attempt));
+      nextStart = now + this->config_.attempt_delay;
+      continue;
+    }
+    if (pending.empty()) {
+      break;
+    }
+
+    const clock::time_point wake = (next < candidates.size()) ? std::min(nextStart, deadline) : deadline;
+    const auto wait = std::chrono::ceil<std::chrono::milliseconds>(wake - now);
+    entries.clear();
+    for (const InternetSocket& attempt : pending) {
+      entries.push_back({attempt.get_sd(), POLLOUT, 0});
+    }
+    if (::poll(entries.data(), entries.size(), static_cast<int>(wait.count())) < 0 && errno != EINTR) {
+      error = errno;
+      break;
+    }
+    for (std::size_t i = entries.size(); i > 0; --i) {
+      if (entries[i - 1].revents == 0) {
+        continue;
+      }
+      InternetSocket& attempt = pending[i - 1];
+      int result = 0;
+      socklen_t length = sizeof(result);
+      if (::getsockopt(attempt.get_sd(), SOL_SOCKET, SO_ERROR, &result, &length) != 0) {
+        result = errno;
+      }
+      if (result == 0 && attempt.set_non_blocking(false)) {
+        oSocket.close();
+        oSocket = std::move(attempt);
+        for (InternetSocket& loser : pending) {
+          loser.close();
+        }
+        return true;
+      }
+      error = result;
+      attempt.close();
+      pending.erase(pending.begin() + static_cast<std::ptrdiff_t>(i - 1));
+      nextStart = clock::now();
+    }
+  }
+  for (InternetSocket& attempt : pending) {
+    attempt.close();
+  }
+  errno = error;
+  return false;
+}
+
+/**
+ * @brief Interleaves the families, starting with iFirstFamilyCount addresses of iPreferred
+ * 
+ * @param iCandidates
+ * @param iPreferred
+ * @param iFirstFamilyCount
+ * 
+ * @return
+ */
+std::vector<addr::InternetAddress> HappyEyeballs::sort(const std::vector<addr::InternetAddress>& iCandidates,
+                                                       const addr::addr_family_e& iPreferred,
+                                                       const std::size_t& iFirstFamilyCount) {
+  std::vector<addr::InternetAddress> preferred;
+  std::vector<addr::InternetAddress> other;
+  for (const addr::InternetAddress& candidate : iCandidates) {
+    (candidate.get_address_family() == iPreferred ? preferred : other).push_back(candidate);
+  }
+  std::vector<addr::InternetAddress> sorted;
+  sorted.reserve(iCandidates.size());
+  std::size_t first = 0;
+  std::size_t second = 0;
+  for (; first < std::min(iFirstFamilyCount, preferred.size()); ++first) {
+    sorted.push_back(preferred[first]);
+  }
+  while (first < preferred.size() || second < other.size()) {
+    if (second < other.size()) {
+      sorted.push_back(other[second++]);
+    }
+    if (first < preferred.size()) {
+      sorted.push_back(preferred[first++]);
+    }
+  }
+  return sorted;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+/**
+ * @brief
+ * 
+ * @return
+ */
+const eyeballs_config_t& HappyEyeballs::get_config(void) const {
+  return this->config_;
+}
+
+/**
+ * @brief Connects started by the last connect()
+ * 
+ * @return
+ */
+const std::size_t& HappyEyeballs::get_attempts(void) const {
+  return this->attempts_;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PROTECTED METHODS **/
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PRIVATE METHODS **/
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+} // namespace sock
+} // namespace ncs
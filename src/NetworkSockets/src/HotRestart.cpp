@@ -0,0 +1,431 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file HotRestart.cpp
+ *
+ * @brief
+ */
+
+
+#include <HotRestart.h>
+
+#include <AddressCodec.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+
+namespace ncs { // Network Communications System
+namespace sock { // Network Communications System Sockets
+
+
+/**
+ * @brief Fills oAddr with iPath
+ * 
+ * @param iPath
+ * @param oAddr
+ * @param oSize
+ * 
+ * @return False, with errno set to ENAMETOOLONG, if iPath does not fit
+ */
+static bool unix_address(const std::string& iPath, sockaddr_un& oAddr, socklen_t& oSize) {
+  oAddr = {};
+  oAddr.sun_family = AF_UNIX;
+  if (iPath.empty() || (iPath.size() >= sizeof(oAddr.sun_path))) {
+    errno = ENAMETOOLONG;
+    return false;
+  }
+  std::memcpy(oAddr.sun_path, iPath.c_str(), iPath.size() + 1);
+  oSize = static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + iPath.size() + 1);
+  return true;
+}
+
+/**
+ * @brief Bounds every send and receive on iSd to iTimeoutMs
+ * 
+ * @param iSd
+ * @param iTimeoutMs
+ * 
+ * @return
+ */
+static bool set_timeouts(const sd_t& iSd, const int& iTimeoutMs) {
+  const timeval timeout = {iTimeoutMs / 1000, (iTimeoutMs % 1000) * 1000};
+  return (setsockopt(iSd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) == 0) &&
+         (setsockopt(iSd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout)) == 0);
+}
+
+/**
+ * @brief Tells whether iHeader starts a message of this version
+ * 
+ * @param iHeader HANDOFF_HEADER_SIZE bytes
+ * 
+ * @return
+ */
+static bool check_header(const std::uint8_t* iHeader) {
+  return (iHeader[0] == HANDOFF_MAGIC[0]) && (iHeader[1] == HANDOFF_MAGIC[1]) && (iHeader[2] == HANDOFF_VERSION);
+}
+
+/**
+ * @brief Closes every socket of ioSockets and empties it
+ * 
+ * @param ioSockets
+ */
+static void close_all(std::vector<InternetSocket>& ioSockets) {
+  for (InternetSocket& socket : ioSockets) {
+    socket.close();
+  }
+  ioSockets.clear();
+}
+
+/**
+ * @brief Sends one message with the iCount sockets at iSockets
+ * 
+ * @param iSd
+ * @param iSockets
+ * @param iKinds
+ * @param iCount At most HANDOFF_BATCH
+ * 
+ * @return
+ */
+static bool send_batch(const sd_t& iSd, const InternetSocket* const* iSockets, const handoff_kind_e* iKinds,
+                       const std::size_t& iCount) {
+  std::uint8_t data[HANDOFF_HEADER_SIZE + HANDOFF_BATCH * (1 + addr::WIRE_ADDRESS_SIZE)];
+  data[0] = HANDOFF_MAGIC[0];
+  data[1] = HANDOFF_MAGIC[1];
+  data[2] = HANDOFF_VERSION;
+  data[3] = static_cast<std::uint8_t>(iCount);
+  alignas(cmsghdr) char control[CMSG_SPACE(HANDOFF_BATCH * sizeof(int))];
+  std::uint8_t* record = data + HANDOFF_HEADER_SIZE;
+  int sds[HANDOFF_BATCH];
+  for (std::size_t i = 0; i < iCount; ++i) {
+    record[0] = iKinds[i];
+    if (!addr::encode_address(iSockets[i]->get_addr(), record + 1)) {
+      std::memset(record + 1, 0, addr::WIRE_ADDRESS_SIZE);
+    }
+    sds[i] = iSockets[i]->get_sd();
+    record += 1 + addr::WIRE_ADDRESS_SIZE;
+  }
+  iovec iov = {data, static_cast<std::size_t>(record - data)};
+  msghdr message = {};
+  message.msg_iov = &iov;
+  message.msg_iovlen = 1;
+  if (iCount > 0) {
+    message.msg_control = control;
+    message.msg_controllen = CMSG_SPACE(iCount * sizeof(int));
+    cmsghdr* rights = CMSG_FIRSTHDR(&message);
+    rights->cmsg_level = SOL_SOCKET;
+    rights->cmsg_type = SCM_RIGHTS;
+    rights->cmsg_len = CMSG_LEN(iCount * sizeof(int));
+    std::memcpy(CMSG_DATA(rights), sds, iCount * sizeof(int));
+  }
+  return ::sendmsg(iSd, &message, MSG_NOSIGNAL) == static_cast<ssize_t>(iov.iov_len);
+}
+
+/**
+ * @brief Receives one message, appending its sockets to oListeners and oConnections
+ * 
+ * @param iSd
+ * @param oListeners
+ * @param oConnections
+ * @param oCount Sockets the message carried, 0 for the last one
+ * 
+ * @return False, with errno set, closing whatever descriptors the message carried
+ */
+static bool receive_batch(const sd_t& iSd, std::vector<InternetSocket>& oListeners,
+                          std::vector<InternetSocket>& oConnections, std::size_t& oCount) {
+  std::uint8_t data[HANDOFF_HEADER_SIZE + HANDOFF_BATCH * (1 + addr::WIRE_ADDRESS_SIZE)];
+  alignas(cmsghdr) char control[CMSG_SPACE(HANDOFF_BATCH * sizeof(int))];
+  iovec iov = {data, sizeof(data)};
+  msghdr message = {};
+  message.msg_iov = &iov;
+  message.msg_iovlen = 1;
+  message.msg_control = control;
+  message.msg_controllen = sizeof(control);
+  const ssize_t size = ::recvmsg(iSd, &message, MSG_CMSG_CLOEXEC);
+  int sds[HANDOFF_BATCH];
+  std::size_t received = 0;
+  for (cmsghdr* header = CMSG_FIRSTHDR(&message); (size >= 0) && (header != nullptr);
+       header = CMSG_NXTHDR(&message, header)) {
+    if ((header->cmsg_level == SOL_SOCKET) && (header->cmsg_type == SCM_RIGHTS)) {
+      const std::size_t count = (header->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+      std::memcpy(sds + received, CMSG_DATA(header), count * sizeof(int));
+      received += count;
+    }
+  }
+  oCount = (size >= static_cast<ssize_t>(HANDOFF_HEADER_SIZE)) ? data[3] : 0;
+  const bool valid = (size >= 0) && ((message.msg_flags & (MSG_TRUNC | MSG_CTRUNC)) == 0) &&
+                     (size == static_cast<ssize_t>(HANDOFF_HEADER_SIZE + oCount * (1 + addr::WIRE_ADDRESS_SIZE))) &&
+                     check_header(data) && (received == oCount);
+  for (std::size_t i = 0; valid && (i < oCount); ++i) {
+    const std::uint8_t* record = data + HANDOFF_HEADER_SIZE + i * (1 + addr::WIRE_ADDRESS_SIZE);
+    InternetSocket socket;
+    addr::InternetAddress addr;
+    socket.set_sd(sds[i]);
+    if (addr::decode_address(record + 1, addr)) {
+      socket.set_addr(addr);
+    }
+    ((record[0] == HANDOFF_LISTENER) ? oListeners : oConnections).push_back(std::move(socket));
+  }
+  if (!valid) {
+    const int error = (size < 0) ? errno : EPROTO;
+    for (std::size_t i = 0; i < received; ++i) {
+      ::close(sds[i]);
+    }
+    errno = error;
+  }
+  return valid;
+}
+
+
+/** PUBLIC METHODS **/
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+/**
+ * @brief Default constructor
+ */
+HotRestart::HotRestart() : sd_(-1), device_(0), inode_(0) {}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Waits for a successor on the Unix socket at iPath
+ * 
+ * @param iPath
+ * 
+ * @return
+ */
+[[nodiscard]] bool HotRestart::listen(const std::string& iPath) {
+  this->close();
+  sockaddr_un addr;
+  socklen_t size = 0;
+  if (!unix_address(iPath, addr, size)) {
+    return false;
+  }
+  const sd_t sd = ::socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (sd < 0) {
+    return false;
+  }
+  struct stat status;
+  (void)unlink(iPath.c_str());
+  if ((::bind(sd, reinterpret_cast<const sockaddr*>(&addr), size) != 0) || (::listen(sd, 1) != 0) ||
+      (stat(iPath.c_str(), &status) != 0)) {
+    const int error = errno;
+    ::close(sd);
+    errno = error;
+    return false;
+  }
+  this->path_ = iPath;
+  this->sd_ = sd;
+  this->device_ = status.st_dev;
+  this->inode_ = status.st_ino;
+  return true;
+}
+
+/**
+ * @brief Passes iListeners and iConnections to the next successor
+ * 
+ * @param iListeners
+ * @param iConnections
+ * @param iTimeoutMs
+ * 
+ * @return
+ */
+[[nodiscard]] bool HotRestart::hand_over(const std::vector<const InternetSocket*>& iListeners,
+                                         const std::vector<const InternetSocket*>& iConnections,
+                                         const int& iTimeoutMs) {
+  if (this->sd_ < 0) {
+    errno = EBADF;
+    return false;
+  }
+  pollfd ready = {this->sd_, POLLIN, 0};
+  const int polled = poll(&ready, 1, iTimeoutMs);
+  if (polled <= 0) {
+    errno = (polled == 0) ? ETIMEDOUT : errno;
+    return false;
+  }
+  const sd_t successor = ::accept4(this->sd_, nullptr, nullptr, SOCK_CLOEXEC);
+  if (successor < 0) {
+    errno = (errno == EAGAIN) ? ETIMEDOUT : errno;
+    return false;
+  }
+  bool done = set_timeouts(successor, iTimeoutMs);
+  std::vector<const InternetSocket*> sockets(iListeners);
+  sockets.insert(sockets.end(), iConnections.begin(), iConnections.end());
+  std::vector<handoff_kind_e> kinds(iListeners.size(), HANDOFF_LISTENER);
+  kinds.resize(sockets.size(), HANDOFF_CONNECTION);
+  for (std::size_t first = 0; done && (first < sockets.size()); first += HANDOFF_BATCH) {
+    const std::size_t count = std::min(HANDOFF_BATCH, sockets.size() - first);
+    done = send_batch(successor, &sockets[first], &kinds[first], count);
+  }
+  // The empty message closes the list, the empty answer says every descriptor arrived
+  std::uint8_t ack[HANDOFF_HEADER_SIZE];
+  done = done && send_batch(successor, nullptr, nullptr, 0) &&
+         (::recv(successor, ack, sizeof(ack), 0) == static_cast<ssize_t>(sizeof(ack))) && check_header(ack) &&
+         (ack[3] == 0);
+  const int error = ((errno == EAGAIN) || (errno == EWOULDBLOCK)) ? ETIMEDOUT : errno;
+  ::close(successor);
+  errno = error;
+  return done;
+}
+
+/**
+ * @brief Takes over the sockets of the process listening at iPath
+ * 
+ * @param iPath
+ * @param oListeners
+ * @param oConnections
+ * @param iTimeoutMs
+ * 
+ * @return
+ */
+[[nodiscard]] bool HotRestart::take_over(const std::string& iPath, std::vector<InternetSocket>& oListeners,
+                                         std::vector<InternetSocket>& oConnections, const int& iTimeoutMs) {
+  oListeners.clear();
+  oConnections.clear();
+  sockaddr_un addr;
+  socklen_t size = 0;
+  if (!unix_address(iPath, addr, size)) {
+    return false;
+  }
+  const sd_t sd = ::socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+  if (sd < 0) {
+    return false;
+  }
+  bool done = set_timeouts(sd, iTimeoutMs) && (::connect(sd, reinterpret_cast<const sockaddr*>(&addr), size) == 0);
+  std::size_t received = HANDOFF_BATCH;
+  while (done && (received > 0)) {
+    done = receive_batch(sd, oListeners, oConnections, received);
+  }
+  std::uint8_t ack[HANDOFF_HEADER_SIZE] = {HANDOFF_MAGIC[0], HANDOFF_MAGIC[1], HANDOFF_VERSION, 0};
+  done = done && (::send(sd, ack, sizeof(ack), MSG_NOSIGNAL) == static_cast<ssize_t>(sizeof(ack)));
+  const int error = ((errno == EAGAIN) || (errno == EWOULDBLOCK)) ? ETIMEDOUT : errno;
+  ::close(sd);
+  if (!done) {
+    close_all(oListeners);
+    close_all(oConnections);
+  }
+  errno = error;
+  return done;
+}
+
+/**
+ * @brief Stops waiting for successors
+ */
+void HotRestart::close(void) {
+  if (this->sd_ >= 0) {
+    ::close(this->sd_);
+    // A successor that already listens at the same path owns the file there now
+    struct stat status;
+    if ((stat(this->path_.c_str(), &status) == 0) && (status.st_dev == this->device_) &&
+        (status.st_ino == this->inode_)) {
+      (void)unlink(this->path_.c_str());
+    }
+  }
+  this->path_.clear();
+  this->sd_ = -1;
+  this->device_ = 0;
+  this->inode_ = 0;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] const sd_t& HotRestart::get_sd(void) const {
+  return this->sd_;
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] const std::string& HotRestart::get_path(void) const {
+  return this->path_;
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] bool HotRestart::is_listening(void) const {
+  return this->sd_ >= 0;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+/**
+ * @brief Destructor
+ */
+HotRestart::~HotRestart() {
+  this->close();
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PROTECTED METHODS **/
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PRIVATE METHODS **/
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+} // namespace sock
+} // namespace ncs
@@ -11,38 +11,303 @@
 
 
 #include <InternetSocket.h>
+#include <Tracer.h>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <cerrno>
 
 
 namespace ncs { // Network Communications System
 namespace sock { // Network Communications System Sockets
 
 
+/**
+ * @brief Waits for a connect(2) interrupted by a signal, which the kernel carries on with, to complete
+ * 
+ * @param iSd
+ * 
+ * @return Whether it connected, errno set to its error otherwise
+ */
+static bool wait_connected(const sd_t& iSd) {
+	pollfd entry = {iSd, POLLOUT, 0};
+	int ready = 0;
+	do {
+		ready = ::poll(&entry, 1, -1);
+	} while ((ready < 0) && (errno == EINTR));
+	int error = 0;
+	socklen_t size = sizeof(error);
+	if ((ready < 0) || (::getsockopt(iSd, SOL_SOCKET, SO_ERROR, &error, &size) != 0)) {
+		return false;
+	}
+	errno = error;
+	return error == 0;
+}
+
+
 /** PUBLIC METHODS **/
 /// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////    
 /**
  * @brief Default constructor
  */
-InternetSocket::InternetSocket(void) {
+InternetSocket::InternetSocket(void) : metrics_(nullptr) {
 	this->set_sd(-1);
 	this->set_addr({addr::LOCAL_HOST, addr::RANDOM_PORT});
 }
 
 /**
- * @brief Copy constructor
+ * @brief Move constructor
  */
-InternetSocket::InternetSocket(const InternetSocket& other) : sd_(other.sd_), addr_(other.addr_) {
+InternetSocket::InternetSocket(InternetSocket&& other) noexcept : sd_(other.sd_), addr_(std::move(other.addr_)), metrics_(other.metrics_) {
+	other.sd_ = -1;
+	other.metrics_ = nullptr;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Creates the underlying socket descriptor, closing any previous one
+ * 
+ * @param iFamily
+ * @param iType
+ * 
+ * @return
+ */
+[[nodiscard]] bool InternetSocket::open(const addr::addr_family_e& iFamily, const int& iType) {
+	this->close();
+	this->set_sd(::socket(iFamily, iType | SOCK_CLOEXEC, 0));
+	NCS_TRACE(SOCKET_OPEN, nullptr, this->get_sd(), 0, iFamily);
+	return this->is_open();
 }
 
 /**
- * @brief Move constructor
+ * @brief Binds the socket, opening it first if needed
+ * 
+ * @param iAddr
+ * 
+ * @return
  */
-InternetSocket::InternetSocket(InternetSocket&& other) noexcept : sd_(other.sd_), addr_(std::move(other.addr_)) {
-	other.sd_ = -1;
+[[nodiscard]] bool InternetSocket::bind(const addr::InternetAddress& iAddr) {
+	sockaddr_storage storage;
+	socklen_t size = 0;
+	if (!iAddr.to_sockaddr(storage, size)) {
+		errno = EINVAL;
+		return false;
+	}
+	if (!this->is_open() && !this->open(static_cast<addr::addr_family_e>(storage.ss_family))) {
+		return false;
+	}
+	if (::bind(this->get_sd(), reinterpret_cast<sockaddr*>(&storage), size) != 0) {
+		return false;
+	}
+	size = sizeof(storage);
+	if (::getsockname(this->get_sd(), reinterpret_cast<sockaddr*>(&storage), &size) != 0) {
+		return false;
+	}
+	return this->addr_.set_sockaddr(reinterpret_cast<sockaddr*>(&storage), size);
 }
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief
+ * 
+ * @param iBacklog
+ * 
+ * @return
+ */
+[[nodiscard]] bool InternetSocket::listen(const int& iBacklog) {
+	return ::listen(this->get_sd(), iBacklog) == 0;
+}
+
+/**
+ * @brief Connects the socket, opening it first if needed
+ * 
+ * @param iAddr
+ * 
+ * @return
+ */
+[[nodiscard]] bool InternetSocket::connect(const addr::InternetAddress& iAddr) {
+	sockaddr_storage storage;
+	socklen_t size = 0;
+	if (!iAddr.to_sockaddr(storage, size)) {
+		errno = EINVAL;
+		return false;
+	}
+	if (!this->is_open() && !this->open(static_cast<addr::addr_family_e>(storage.ss_family))) {
+		return false;
+	}
+	this->set_addr(iAddr);
+	// Issued once, calling connect(2) again after EINTR would fail with EALREADY or EISCONN
+	const int result = ::connect(this->get_sd(), reinterpret_cast<sockaddr*>(&storage), size);
+	int error = (result == 0) ? 0 : errno;
+	if (error == EINTR) {
+		const int flags = ::fcntl(this->get_sd(), F_GETFL);
+		if ((flags >= 0) && ((flags & O_NONBLOCK) != 0)) {
+			error = EINPROGRESS;
+		}
+		else {
+			error = wait_connected(this->get_sd()) ? 0 : errno;
+		}
+	}
+	NCS_TRACE(SOCKET_CONNECT, &this->addr_, this->get_sd(), 0, -error);
+	if (error != 0) {
+		errno = error;
+	}
+	return (error == 0) || (error == EINPROGRESS);
+}
+
+/**
+ * @brief Accepts a pending connection
+ * 
+ * @param oClient
+ * @param iFlags
+ * 
+ * @return
+ */
+[[nodiscard]] bool InternetSocket::accept(InternetSocket& oClient, const int& iFlags) const {
+	sockaddr_storage storage;
+	socklen_t size = sizeof(storage);
+	const sd_t client = ::accept4(this->get_sd(), reinterpret_cast<sockaddr*>(&storage), &size, iFlags | SOCK_CLOEXEC);
+	if (client < 0) {
+		NCS_TRACE(SOCKET_ACCEPT, nullptr, this->get_sd(), 0, -errno);
+		return false;
+	}
+	oClient.close();
+	oClient.set_sd(client);
+	oClient.addr_.clear();
+	(void)oClient.addr_.set_sockaddr(reinterpret_cast<sockaddr*>(&storage), size);
+	NCS_TRACE(SOCKET_ACCEPT, &oClient.addr_, this->get_sd(), 0, client);
+	return true;
+}
+
+/**
+ * @brief
+ * 
+ * @param iEnabled
+ * 
+ * @return
+ */
+[[nodiscard]] bool InternetSocket::set_non_blocking(const bool& iEnabled) {
+	const int flags = ::fcntl(this->get_sd(), F_GETFL, 0);
+	if (flags < 0) {
+		return false;
+	}
+	return ::fcntl(this->get_sd(), F_SETFL, iEnabled ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK)) == 0;
+}
+
+/**
+ * @brief Closes the descriptor if open
+ * 
+ * @return
+ */
+bool InternetSocket::close(void) {
+	if (!this->is_open()) {
+		return true;
+	}
+	const int result = ::close(this->get_sd());
+	NCS_TRACE(SOCKET_CLOSE, &this->addr_, this->get_sd(), 0, result);
+	this->set_sd(-1);
+	return result == 0;
+}
+
+/**
+ * @brief Shuts down one or both directions of the connection
+ * 
+ * @param iHow
+ * 
+ * @return
+ */
+[[nodiscard]] bool InternetSocket::shutdown(const int& iHow) const {
+	return ::shutdown(this->get_sd(), iHow) == 0;
+}
+
+/**
+ * @brief Sends a contiguous buffer through the socket
+ * 
+ * @param iData
+ * @param iSize
+ * @param iFlags
+ * 
+ * @return
+ */
+[[nodiscard]] ssize_t InternetSocket::send(const void* iData, const size_t& iSize, const int& iFlags) const {
+	const std::uint64_t start = (this->metrics_ != nullptr) ? metrics::clock_ns() : 0;
+	const ssize_t result = ::send(this->get_sd(), iData, iSize, iFlags | MSG_NOSIGNAL);
+	if (this->metrics_ != nullptr) {
+		this->metrics_->on_send(result, metrics::clock_ns() - start);
+	}
+	NCS_TRACE(SOCKET_SEND, &this->addr_, this->get_sd(), iSize, result);
+	return result;
+}
+
+/**
+ * @brief Sends several buffers with a single scatter/gather call
+ * 
+ * @param iIov
+ * @param iCount
+ * @param iFlags
+ * 
+ * @return
+ */
+[[nodiscard]] ssize_t InternetSocket::send_v(const iovec* iIov, const size_t& iCount, const int& iFlags) const {
+	msghdr msg{};
+	msg.msg_iov = const_cast<iovec*>(iIov);
+	msg.msg_iovlen = iCount;
+	const std::uint64_t start = (this->metrics_ != nullptr) ? metrics::clock_ns() : 0;
+	const ssize_t result = ::sendmsg(this->get_sd(), &msg, iFlags | MSG_NOSIGNAL);
+	if (this->metrics_ != nullptr) {
+		this->metrics_->on_send(result, metrics::clock_ns() - start);
+	}
+	NCS_TRACE(SOCKET_SEND, &this->addr_, this->get_sd(), iCount, result);
+	return result;
+}
+
+/**
+ * @brief Receives up to iSize bytes from the socket
+ * 
+ * @param oData
+ * @param iSize
+ * @param iFlags
+ * 
+ * @return
+ */
+[[nodiscard]] ssize_t InternetSocket::recv(void* oData, const size_t& iSize, const int& iFlags) const {
+	const std::uint64_t start = (this->metrics_ != nullptr) ? metrics::clock_ns() : 0;
+	const ssize_t result = ::recv(this->get_sd(), oData, iSize, iFlags);
+	if (this->metrics_ != nullptr) {
+		this->metrics_->on_recv(result, metrics::clock_ns() - start);
+	}
+	NCS_TRACE(SOCKET_RECV, &this->addr_, this->get_sd(), iSize, result);
+	return result;
+}
+
+/**
+ * @brief Sets an integer socket option
+ * 
+ * @param iLevel
+ * @param iName
+ * @param iValue
+ * 
+ * @return
+ */
+[[nodiscard]] bool InternetSocket::set_option(const int& iLevel, const int& iName, const int& iValue) const {
+	return ::setsockopt(this->get_sd(), iLevel, iName, &iValue, sizeof(iValue)) == 0;
+}
+
+/**
+ * @brief Reads an integer socket option back from the kernel
+ * 
+ * @param iLevel
+ * @param iName
+ * @param oValue
+ * 
+ * @return
+ */
+[[nodiscard]] bool InternetSocket::get_option(const int& iLevel, const int& iName, int& oValue) const {
+	socklen_t size = sizeof(oValue);
+	return ::getsockopt(this->get_sd(), iLevel, iName, &oValue, &size) == 0;
+}
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
@@ -64,6 +329,15 @@ void InternetSocket::set_addr(const addr::InternetAddress& iAddr) {
 	this->addr_ = iAddr;
 }
 
+/**
+ * @brief Accounts every send and receive in iMetrics
+ * 
+ * @param iMetrics
+ */
+void InternetSocket::set_metrics(metrics::SocketMetrics* iMetrics) {
+	this->metrics_ = iMetrics;
+}
+
 /**
  * @brief
  * 
@@ -81,31 +355,54 @@ void InternetSocket::set_addr(const addr::InternetAddress& iAddr) {
 [[nodiscard]] const addr::InternetAddress& InternetSocket::get_addr(void) const {
 	return this->addr_;
 }
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] bool InternetSocket::is_open(void) const {
+	return this->get_sd() >= 0;
+}
 
-/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
 /**
- * @brief Copy assignment operator
+ * @brief Family the descriptor was opened with
+ * 
+ * @return
  */
-InternetSocket& InternetSocket::operator=(const InternetSocket& other) {
- if (this != &other) {
-		sd_ = other.sd_;
-		addr_ = other.addr_;
+[[nodiscard]] addr::addr_family_e InternetSocket::get_address_family(void) const {
+	int domain = AF_UNSPEC;
+	if (!this->get_option(SOL_SOCKET, SO_DOMAIN, domain)) {
+		return addr::NET_ADDR_FAM_UNSPEC;
 	}
-	return *this;
+	return static_cast<addr::addr_family_e>(domain);
 }
 
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] metrics::SocketMetrics* InternetSocket::get_metrics(void) const {
+	return this->metrics_;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
 /**
  * @brief Move assignment operator
  */
 InternetSocket& InternetSocket::operator=(InternetSocket&& other) noexcept {
 	if (this != &other) {
+		this->close();
 		sd_ = other.sd_;
 		addr_ = std::move(other.addr_);
+		metrics_ = other.metrics_;
 		other.sd_ = -1;
+		other.metrics_ = nullptr;
 	}
 	return *this;
 }
@@ -116,9 +413,11 @@ InternetSocket& InternetSocket::operator=(InternetSocket&& other) noexcept {
 
 /// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
 /**
- * @brief
+ * @brief Destructor
  */
-InternetSocket::~InternetSocket() {}
+InternetSocket::~InternetSocket() {
+	this->close();
+}
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
   
 
@@ -0,0 +1,447 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file MulticastFanout.cpp
+ *
+ * @brief
+ */
+
+
+#include <MulticastFanout.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <arpa/inet.h>
+#include <sys/uio.h>
+
+
+namespace ncs { // Network Communications System
+namespace sock { // Network Communications System Sockets
+
+
+/**
+ * MulticastFanout constants
+ */
+constexpr std::size_t CONTROL_SIZE = CMSG_SPACE(sizeof(in6_pktinfo));   // Room for either pktinfo message
+
+
+/**
+ * @brief Whether two keys hold the same address
+ * 
+ * @param iLeft
+ * @param iRight
+ * 
+ * @return
+ */
+static bool same_key(const group_key_t& iLeft, const group_key_t& iRight) {
+  return (iLeft.family == iRight.family) && (std::memcmp(iLeft.bytes, iRight.bytes, sizeof(iLeft.bytes)) == 0);
+}
+
+
+/** PUBLIC METHODS **/
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+/**
+ * @brief Socket constructor
+ * 
+ * @param ioSocket
+ * @param iConfig
+ */
+MulticastFanout::MulticastFanout(MulticastSocket& ioSocket, const fanout_config_t& iConfig)
+    : socket_(ioSocket), config_(iConfig), nextId_(1), dispatching_(false) {
+  this->config_.batch = std::max<std::size_t>(this->config_.batch, 1);
+  this->config_.datagram_size = std::max<std::size_t>(this->config_.datagram_size, 1);
+  this->buffers_.resize(this->config_.batch * this->config_.datagram_size);
+  this->controls_.resize(this->config_.batch * CONTROL_SIZE);
+  this->sources_.resize(this->config_.batch);
+  this->iovs_.resize(this->config_.batch);
+  this->messages_.resize(this->config_.batch);
+  for (std::size_t i = 0; i < this->config_.batch; ++i) {
+    this->iovs_[i].iov_base = &this->buffers_[i * this->config_.datagram_size];
+    this->iovs_[i].iov_len = this->config_.datagram_size;
+    std::memset(&this->messages_[i], 0, sizeof(mmsghdr));
+    this->messages_[i].msg_hdr.msg_iov = &this->iovs_[i];
+    this->messages_[i].msg_hdr.msg_iovlen = 1;
+  }
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Delivers the datagrams sent to iGroup to iHandler
+ * 
+ * @param iGroup
+ * @param iHandler
+ * 
+ * @return
+ */
+[[nodiscard]] subscription_id_t MulticastFanout::subscribe(const addr::InternetAddress& iGroup,
+                                                           datagram_handler_t iHandler) {
+  return this->add(iGroup, nullptr, std::move(iHandler));
+}
+
+/**
+ * @brief Delivers the datagrams sent to iGroup by iSource to iHandler
+ * 
+ * @param iGroup
+ * @param iSource
+ * @param iHandler
+ * 
+ * @return
+ */
+[[nodiscard]] subscription_id_t MulticastFanout::subscribe(const addr::InternetAddress& iGroup,
+                                                           const addr::InternetAddress& iSource,
+                                                           datagram_handler_t iHandler) {
+  return this->add(iGroup, &iSource, std::move(iHandler));
+}
+
+/**
+ * @brief Drops a subscription, leaving its group after the last subscriber
+ * 
+ * @param iId
+ * 
+ * @return
+ */
+bool MulticastFanout::unsubscribe(const subscription_id_t& iId) {
+  for (std::unique_ptr<fanout_subscription_t>& subscription : this->subscriptions_) {
+    if (!subscription->active || (subscription->id != iId)) {
+      continue;
+    }
+    subscription->active = false;
+    bool left = true;
+    if (!this->is_shared(*subscription)) {
+      left = subscription->specific ?
+          this->socket_.leave(subscription->group, subscription->source, this->config_.ifindex) :
+          this->socket_.leave(subscription->group, this->config_.ifindex);
+    }
+    // The handler may be the caller, it is destroyed once the batch is over
+    if (!this->dispatching_) {
+      this->compact();
+    }
+    return left;
+  }
+  return false;
+}
+
+/**
+ * @brief Drops every subscription and leaves their groups
+ */
+void MulticastFanout::clear(void) {
+  // unsubscribe() may erase from the vector, walk a copy of the ids
+  std::vector<subscription_id_t> ids;
+  for (const std::unique_ptr<fanout_subscription_t>& subscription : this->subscriptions_) {
+    if (subscription->active) {
+      ids.push_back(subscription->id);
+    }
+  }
+  for (const subscription_id_t& id : ids) {
+    (void)this->unsubscribe(id);
+  }
+}
+
+/**
+ * @brief Receives one batch of datagrams without blocking and hands them to the subscribers
+ * 
+ * @return
+ */
+std::size_t MulticastFanout::poll(void) {
+  for (std::size_t i = 0; i < this->config_.batch; ++i) {
+    msghdr& header = this->messages_[i].msg_hdr;
+    header.msg_name = &this->sources_[i];
+    header.msg_namelen = sizeof(sockaddr_storage);
+    header.msg_control = &this->controls_[i * CONTROL_SIZE];
+    header.msg_controllen = CONTROL_SIZE;
+    header.msg_flags = 0;
+  }
+  const int received = recvmmsg(this->socket_.get_socket().get_sd(), this->messages_.data(),
+                                static_cast<unsigned int>(this->config_.batch), MSG_DONTWAIT, nullptr);
+  if (received <= 0) {
+    return 0;
+  }
+  this->dispatching_ = true;
+  const std::size_t subscribers = this->subscriptions_.size();
+  for (int i = 0; i < received; ++i) {
+    const std::size_t index = static_cast<std::size_t>(i);
+    const std::size_t size = std::min<std::size_t>(this->messages_[index].msg_len, this->config_.datagram_size);
+    this->dispatch(this->messages_[index].msg_hdr, &this->buffers_[index * this->config_.datagram_size], size,
+                   subscribers);
+  }
+  this->dispatching_ = false;
+  this->compact();
+  return static_cast<std::size_t>(received);
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] const fanout_stats_t& MulticastFanout::get_stats(void) const {
+  return this->stats_;
+}
+
+/**
+ * @brief Active subscriptions
+ * 
+ * @return
+ */
+[[nodiscard]] std::size_t MulticastFanout::get_subscribers(void) const {
+  return static_cast<std::size_t>(std::count_if(this->subscriptions_.begin(), this->subscriptions_.end(),
+      [](const std::unique_ptr<fanout_subscription_t>& iSubscription) { return iSubscription->active; }));
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+/**
+ * @brief Destructor
+ */
+MulticastFanout::~MulticastFanout() {
+  if (this->socket_.is_open()) {
+    this->clear();
+  }
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PROTECTED METHODS **/
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PRIVATE METHODS **/
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Joins the membership of a new subscription unless another one already holds it
+ * 
+ * @param iGroup
+ * @param iSource
+ * @param iHandler
+ * 
+ * @return
+ */
+[[nodiscard]] subscription_id_t MulticastFanout::add(const addr::InternetAddress& iGroup,
+                                                     const addr::InternetAddress* iSource,
+                                                     datagram_handler_t iHandler) {
+  std::unique_ptr<fanout_subscription_t> subscription = std::make_unique<fanout_subscription_t>();
+  if (!iHandler || !iGroup.is_multicast() || !make_key(iGroup, subscription->key)) {
+    errno = EINVAL;
+    return 0;
+  }
+  subscription->group = iGroup;
+  subscription->specific = (iSource != nullptr);
+  if (subscription->specific) {
+    subscription->source = *iSource;
+    if (!make_key(*iSource, subscription->sourceKey)) {
+      errno = EINVAL;
+      return 0;
+    }
+  }
+  if (!this->is_shared(*subscription)) {
+    const bool joined = subscription->specific ?
+        this->socket_.join(iGroup, *iSource, this->config_.ifindex) :
+        this->socket_.join(iGroup, this->config_.ifindex);
+    if (!joined) {
+      return 0;
+    }
+  }
+  subscription->id = this->nextId_++;
+  subscription->handler = std::move(iHandler);
+  this->subscriptions_.push_back(std::move(subscription));
+  return this->subscriptions_.back()->id;
+}
+
+/**
+ * @brief Whether an active subscription other than iSubscription holds its membership
+ * 
+ * @param iSubscription
+ * 
+ * @return
+ */
+[[nodiscard]] bool MulticastFanout::is_shared(const fanout_subscription_t& iSubscription) const {
+  for (const std::unique_ptr<fanout_subscription_t>& other : this->subscriptions_) {
+    if ((other.get() != &iSubscription) && other->active && (other->specific == iSubscription.specific) &&
+        (other->group.get_ip() == iSubscription.group.get_ip()) &&
+        (!other->specific || (other->source.get_ip() == iSubscription.source.get_ip()))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Hands one received datagram to the subscribers of its destination group
+ * 
+ * @param iMessage
+ * @param iData
+ * @param iSize
+ * @param iSubscribers
+ */
+void MulticastFanout::dispatch(const msghdr& iMessage, const std::uint8_t* iData, const std::size_t& iSize,
+                               const std::size_t& iSubscribers) {
+  ++this->stats_.datagrams;
+  datagram_t datagram;
+  datagram.data = iData;
+  datagram.size = iSize;
+  datagram.source = static_cast<const sockaddr*>(iMessage.msg_name);
+  datagram.source_size = iMessage.msg_namelen;
+  datagram.truncated = (iMessage.msg_flags & MSG_TRUNC) != 0;
+  if (datagram.truncated) {
+    ++this->stats_.truncated;
+  }
+
+  group_key_t key;
+  group_key_t source;
+  bool delivered = false;
+  if (destination(iMessage, key)) {
+    const bool known = origin(iMessage, source);
+    // Handlers subscribing from here on only see the next batch
+    for (std::size_t i = 0; i < iSubscribers; ++i) {
+      fanout_subscription_t& subscription = *this->subscriptions_[i];
+      if (subscription.active && same_key(subscription.key, key) &&
+          (!subscription.specific || (known && same_key(subscription.sourceKey, source)))) {
+        subscription.handler(datagram);
+        ++this->stats_.deliveries;
+        delivered = true;
+      }
+    }
+  }
+  if (!delivered) {
+    ++this->stats_.unmatched;
+  }
+}
+
+/**
+ * @brief Erases the subscriptions dropped while dispatching
+ */
+void MulticastFanout::compact(void) {
+  this->subscriptions_.erase(std::remove_if(this->subscriptions_.begin(), this->subscriptions_.end(),
+      [](const std::unique_ptr<fanout_subscription_t>& iSubscription) { return !iSubscription->active; }),
+      this->subscriptions_.end());
+}
+
+/**
+ * @brief Binary form of a group address
+ * 
+ * @param iGroup
+ * @param oKey
+ * 
+ * @return
+ */
+[[nodiscard]] bool MulticastFanout::make_key(const addr::InternetAddress& iGroup, group_key_t& oKey) {
+  oKey = group_key_t();
+  oKey.family = iGroup.get_address_family();
+  return inet_pton(oKey.family, iGroup.get_ip().c_str(), oKey.bytes) == 1;
+}
+
+/**
+ * @brief Destination group of a datagram
+ * 
+ * @param iMessage
+ * @param oKey
+ * 
+ * @return
+ */
+[[nodiscard]] bool MulticastFanout::destination(const msghdr& iMessage, group_key_t& oKey) {
+  oKey = group_key_t();
+  msghdr& message = const_cast<msghdr&>(iMessage);
+  for (cmsghdr* control = CMSG_FIRSTHDR(&message); control != nullptr; control = CMSG_NXTHDR(&message, control)) {
+    if ((control->cmsg_level == IPPROTO_IP) && (control->cmsg_type == IP_PKTINFO)) {
+      in_pktinfo info;
+      std::memcpy(&info, CMSG_DATA(control), sizeof(info));
+      oKey.family = AF_INET;
+      std::memcpy(oKey.bytes, &info.ipi_addr, sizeof(info.ipi_addr));
+      return true;
+    }
+    if ((control->cmsg_level == IPPROTO_IPV6) && (control->cmsg_type == IPV6_PKTINFO)) {
+      in6_pktinfo info;
+      std::memcpy(&info, CMSG_DATA(control), sizeof(info));
+      oKey.family = AF_INET6;
+      std::memcpy(oKey.bytes, &info.ipi6_addr, sizeof(info.ipi6_addr));
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Source of a datagram, read from its name
+ * 
+ * @param iMessage
+ * @param oKey
+ * 
+ * @return
+ */
+[[nodiscard]] bool MulticastFanout::origin(const msghdr& iMessage, group_key_t& oKey) {
+  oKey = group_key_t();
+  if ((iMessage.msg_name == nullptr) || (iMessage.msg_namelen < sizeof(sa_family_t))) {
+    return false;
+  }
+  const sockaddr* name = static_cast<const sockaddr*>(iMessage.msg_name);
+  if ((name->sa_family == AF_INET) && (iMessage.msg_namelen >= sizeof(sockaddr_in))) {
+    oKey.family = AF_INET;
+    std::memcpy(oKey.bytes, &reinterpret_cast<const sockaddr_in*>(name)->sin_addr, sizeof(in_addr));
+    return true;
+  }
+  if ((name->sa_family == AF_INET6) && (iMessage.msg_namelen >= sizeof(sockaddr_in6))) {
+    const in6_addr& address = reinterpret_cast<const sockaddr_in6*>(name)->sin6_addr;
+    if (IN6_IS_ADDR_V4MAPPED(&address)) {
+      oKey.family = AF_INET;
+      std::memcpy(oKey.bytes, &address.s6_addr[12], sizeof(in_addr));
+    } else {
+      oKey.family = AF_INET6;
+      std::memcpy(oKey.bytes, &address, sizeof(address));
+    }
+    return true;
+  }
+  return false;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+} // namespace sock
+} // namespace ncs
@@ -0,0 +1,348 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file MulticastSocket.cpp
+ *
+ * @brief
+ */
+
+
+#include <MulticastSocket.h>
+
+#include <cerrno>
+
+#include <netinet/in.h>
+
+
+namespace ncs { // Network Communications System
+namespace sock { // Network Communications System Sockets
+
+
+/** PUBLIC METHODS **/
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+/**
+ * @brief Default constructor
+ */
+MulticastSocket::MulticastSocket(void) : family_(addr::NET_ADDR_FAM_UNSPEC) {}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Opens a datagram socket that reports the destination group of every received datagram
+ * 
+ * @param iFamily
+ * @param iType
+ * 
+ * @return
+ */
+[[nodiscard]] bool MulticastSocket::open(const addr::addr_family_e& iFamily, const int& iType) {
+  this->close();
+  if (!this->socket_.open(iFamily, SOCK_DGRAM | iType)) {
+    return false;
+  }
+  this->family_ = iFamily;
+  const bool v6 = (iFamily == addr::NET_ADDR_FAM_INET6);
+  if (!this->socket_.set_option(v6 ? IPPROTO_IPV6 : IPPROTO_IP, v6 ? IPV6_RECVPKTINFO : IP_PKTINFO, 1)) {
+    const int error = errno;
+    this->close();
+    errno = error;
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Binds the socket, opening it first if needed
+ * 
+ * @param iAddr
+ * 
+ * @return
+ */
+[[nodiscard]] bool MulticastSocket::bind(const addr::InternetAddress& iAddr) {
+  if (!this->is_open() && !this->open(iAddr.get_address_family())) {
+    return false;
+  }
+  return this->socket_.set_option(SOL_SOCKET, SO_REUSEADDR, 1) && this->socket_.bind(iAddr);
+}
+
+/**
+ * @brief Joins iGroup, receiving from any source
+ * 
+ * @param iGroup
+ * @param iIfindex
+ * 
+ * @return
+ */
+[[nodiscard]] bool MulticastSocket::join(const addr::InternetAddress& iGroup, const unsigned int& iIfindex) {
+  return this->membership(MCAST_JOIN_GROUP, iGroup, nullptr, iIfindex);
+}
+
+/**
+ * @brief Joins iGroup, receiving only from iSource
+ * 
+ * @param iGroup
+ * @param iSource
+ * @param iIfindex
+ * 
+ * @return
+ */
+[[nodiscard]] bool MulticastSocket::join(const addr::InternetAddress& iGroup, const addr::InternetAddress& iSource,
+                                         const unsigned int& iIfindex) {
+  return this->membership(MCAST_JOIN_SOURCE_GROUP, iGroup, &iSource, iIfindex);
+}
+
+/**
+ * @brief Leaves a group joined from any source
+ * 
+ * @param iGroup
+ * @param iIfindex
+ * 
+ * @return
+ */
+[[nodiscard]] bool MulticastSocket::leave(const addr::InternetAddress& iGroup, const unsigned int& iIfindex) {
+  return this->membership(MCAST_LEAVE_GROUP, iGroup, nullptr, iIfindex);
+}
+
+/**
+ * @brief Leaves a group joined for iSource only
+ * 
+ * @param iGroup
+ * @param iSource
+ * @param iIfindex
+ * 
+ * @return
+ */
+[[nodiscard]] bool MulticastSocket::leave(const addr::InternetAddress& iGroup, const addr::InternetAddress& iSource,
+                                          const unsigned int& iIfindex) {
+  return this->membership(MCAST_LEAVE_SOURCE_GROUP, iGroup, &iSource, iIfindex);
+}
+
+/**
+ * @brief Sends one datagram to iGroup
+ * 
+ * @param iData
+ * @param iSize
+ * @param iGroup
+ * 
+ * @return
+ */
+[[nodiscard]] ssize_t MulticastSocket::send_to(const void* iData, const std::size_t& iSize,
+                                               const addr::InternetAddress& iGroup) const {
+  sockaddr_storage storage;
+  socklen_t size = 0;
+  if (!iGroup.to_sockaddr(storage, size)) {
+    errno = EINVAL;
+    return -1;
+  }
+  return ::sendto(this->socket_.get_sd(), iData, iSize, MSG_NOSIGNAL, reinterpret_cast<const sockaddr*>(&storage),
+                  size);
+}
+
+/**
+ * @brief Receives one datagram
+ * 
+ * @param oData
+ * @param iSize
+ * @param oSource
+ * @param iFlags
+ * 
+ * @return
+ */
+[[nodiscard]] ssize_t MulticastSocket::recv_from(void* oData, const std::size_t& iSize, addr::InternetAddress& oSource,
+                                                 const int& iFlags) const {
+  sockaddr_storage storage;
+  socklen_t size = sizeof(storage);
+  const ssize_t received = ::recvfrom(this->socket_.get_sd(), oData, iSize, iFlags,
+                                      reinterpret_cast<sockaddr*>(&storage), &size);
+  if (received >= 0) {
+    (void)oSource.set_sockaddr(reinterpret_cast<const sockaddr*>(&storage), size);
+  }
+  return received;
+}
+
+/**
+ * @brief Closes the socket
+ * 
+ * @return
+ */
+bool MulticastSocket::close(void) {
+  this->family_ = addr::NET_ADDR_FAM_UNSPEC;
+  return this->socket_.close();
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+/**
+ * @brief Hops the sent datagrams may travel
+ * 
+ * @param iTtl
+ * 
+ * @return
+ */
+[[nodiscard]] bool MulticastSocket::set_ttl(const int& iTtl) {
+  return this->socket_.set_option<multicast_ttl_t>(iTtl);
+}
+
+/**
+ * @brief Whether the sent datagrams are also delivered to the members on this host
+ * 
+ * @param iEnabled
+ * 
+ * @return
+ */
+[[nodiscard]] bool MulticastSocket::set_loopback(const bool& iEnabled) {
+  return this->socket_.set_option<multicast_loop_t>(iEnabled);
+}
+
+/**
+ * @brief Interface the datagrams are sent from
+ * 
+ * @param iIfindex
+ * 
+ * @return
+ */
+[[nodiscard]] bool MulticastSocket::set_interface(const unsigned int& iIfindex) {
+  if (this->family_ == addr::NET_ADDR_FAM_INET6) {
+    return this->socket_.set_option(IPPROTO_IPV6, IPV6_MULTICAST_IF, static_cast<int>(iIfindex));
+  }
+  // IP_MULTICAST_IF only takes an interface index through ip_mreqn
+  ip_mreqn request{};
+  request.imr_ifindex = static_cast<int>(iIfindex);
+  return setsockopt(this->socket_.get_sd(), IPPROTO_IP, IP_MULTICAST_IF, &request, sizeof(request)) == 0;
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] const InternetSocket& MulticastSocket::get_socket(void) const {
+  return this->socket_;
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] addr::addr_family_e MulticastSocket::get_address_family(void) const {
+  return this->family_;
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] bool MulticastSocket::is_open(void) const {
+  return this->socket_.is_open();
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+/**
+ * @brief Destructor
+ */
+MulticastSocket::~MulticastSocket() {
+  this->close();
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PROTECTED METHODS **/
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PRIVATE METHODS **/
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Adds or drops a membership with the protocol independent MCAST_* options
+ * 
+ * @param iOption
+ * @param iGroup
+ * @param iSource
+ * @param iIfindex
+ * 
+ * @return
+ */
+[[nodiscard]] bool MulticastSocket::membership(const int& iOption, const addr::InternetAddress& iGroup,
+                                               const addr::InternetAddress* iSource, const unsigned int& iIfindex) {
+  socklen_t size = 0;
+  if (!iGroup.is_multicast()) {
+    errno = EINVAL;
+    return false;
+  }
+  if (iSource == nullptr) {
+    group_req request{};
+    request.gr_interface = iIfindex;
+    if (!iGroup.to_sockaddr(request.gr_group, size)) {
+      errno = EINVAL;
+      return false;
+    }
+    return setsockopt(this->socket_.get_sd(), this->level(), iOption, &request, sizeof(request)) == 0;
+  }
+  group_source_req request{};
+  request.gsr_interface = iIfindex;
+  if (!iGroup.to_sockaddr(request.gsr_group, size) || !iSource->to_sockaddr(request.gsr_source, size)) {
+    errno = EINVAL;
+    return false;
+  }
+  return setsockopt(this->socket_.get_sd(), this->level(), iOption, &request, sizeof(request)) == 0;
+}
+
+/**
+ * @brief Level of the multicast options for the family of the socket
+ * 
+ * @return
+ */
+[[nodiscard]] int MulticastSocket::level(void) const {
+  return (this->family_ == addr::NET_ADDR_FAM_INET6) ? IPPROTO_IPV6 : IPPROTO_IP;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+} // namespace sock
+} // namespace ncs
@@ -0,0 +1,447 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file PacketSocket.cpp
+ *
+ * @brief
+ */
+
+
+#include <PacketSocket.h>
+
+#include <NetworkAddress.h>
+
+#include <arpa/inet.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+
+namespace ncs { // Network Communications System
+namespace sock { // Network Communications System Sockets
+
+
+/**
+ * PacketSocket constants
+ */
+constexpr std::uint32_t PACKET_HEADER_SIZE = TPACKET_ALIGN(sizeof(tpacket3_hdr));   // Followed by the sockaddr_ll on RX and by the frame on TX
+
+
+/** PUBLIC METHODS **/
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+/**
+ * @brief Default constructor
+ */
+PacketSocket::PacketSocket(void)
+    : config_(), sd_(-1), map_(nullptr), mapSize_(0), txRing_(nullptr), txSlots_(0), txPerBlock_(0), txNext_(0),
+      rxNext_(0), holding_(false), blocks_(0), rxPackets_(0), txPackets_(0), kernelPackets_(0), kernelDrops_(0),
+      kernelFreezes_(0) {
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Creates the socket, attaches the filter, maps the rings and binds to the interface
+ * 
+ * @param iConfig
+ * 
+ * @return
+ */
+bool PacketSocket::open(const packet_config_t& iConfig) {
+  this->close();
+  if (iConfig.frame_size == 0 || iConfig.block_size < iConfig.frame_size || iConfig.block_count == 0 ||
+      (iConfig.tx_frame_count > 0 && (iConfig.tx_frame_size <= PACKET_HEADER_SIZE || iConfig.block_size < iConfig.tx_frame_size))) {
+    errno = EINVAL;
+    return false;
+  }
+  this->config_ = iConfig;
+
+  // Protocol 0 delivers nothing until bind(), so no frame lands before the ring and the filter are in place
+  this->sd_ = ::socket(addr::NET_ADDR_FAM_PACKET, SOCK_RAW | SOCK_CLOEXEC, 0);
+  if (this->sd_ < 0) {
+    return false;
+  }
+  const int version = TPACKET_V3;
+  if (::setsockopt(this->sd_, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) < 0 ||
+      (!iConfig.filter.empty() && !this->set_filter(iConfig.filter))) {
+    return this->fail();
+  }
+
+  tpacket_req3 rx{};
+  rx.tp_block_size = iConfig.block_size;
+  rx.tp_block_nr = iConfig.block_count;
+  rx.tp_frame_size = iConfig.frame_size;
+  rx.tp_frame_nr = (iConfig.block_size / iConfig.frame_size) * iConfig.block_count;
+  rx.tp_retire_blk_tov = iConfig.block_timeout_ms;
+  rx.tp_feature_req_word = TP_FT_REQ_FILL_RXHASH;
+  if (::setsockopt(this->sd_, SOL_PACKET, PACKET_RX_RING, &rx, sizeof(rx)) < 0) {
+    return this->fail();
+  }
+  const std::size_t rxSize = static_cast<std::size_t>(iConfig.block_size) * iConfig.block_count;
+
+  std::size_t txSize = 0;
+  if (iConfig.tx_frame_count > 0) {
+    // The TX ring takes no block timeout nor feature bits, its slots are plain frames
+    this->txPerBlock_ = iConfig.block_size / iConfig.tx_frame_size;
+    tpacket_req3 tx{};
+    tx.tp_block_size = iConfig.block_size;
+    tx.tp_block_nr = (iConfig.tx_frame_count + this->txPerBlock_ - 1) / this->txPerBlock_;
+    tx.tp_frame_size = iConfig.tx_frame_size;
+    tx.tp_frame_nr = tx.tp_block_nr * this->txPerBlock_;
+    if (::setsockopt(this->sd_, SOL_PACKET, PACKET_TX_RING, &tx, sizeof(tx)) < 0) {
+      return this->fail();
+    }
+    this->txSlots_ = tx.tp_frame_nr;
+    txSize = static_cast<std::size_t>(tx.tp_block_size) * tx.tp_block_nr;
+  }
+
+  // Both rings share one mapping, RX first
+  void* map = ::mmap(nullptr, rxSize + txSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, this->sd_, 0);
+  if (map == MAP_FAILED) {
+    return this->fail();
+  }
+  this->map_ = static_cast<std::uint8_t*>(map);
+  this->mapSize_ = rxSize + txSize;
+  this->txRing_ = (txSize > 0) ? this->map_ + rxSize : nullptr;
+
+  sockaddr_ll address{};
+  address.sll_family = addr::NET_ADDR_FAM_PACKET;
+  address.sll_protocol = htons(iConfig.protocol);
+  address.sll_ifindex = iConfig.ifindex;
+  if (::bind(this->sd_, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0) {
+    return this->fail();
+  }
+  return true;
+}
+
+/**
+ * @brief Unmaps the rings and closes the descriptor
+ */
+void PacketSocket::close(void) {
+  if (this->map_ != nullptr) {
+    ::munmap(this->map_, this->mapSize_);
+  }
+  if (this->sd_ >= 0) {
+    ::close(this->sd_);
+  }
+  this->sd_ = -1;
+  this->map_ = nullptr;
+  this->mapSize_ = 0;
+  this->txRing_ = nullptr;
+  this->txSlots_ = 0;
+  this->txPerBlock_ = 0;
+  this->txNext_ = 0;
+  this->rxNext_ = 0;
+  this->holding_ = false;
+}
+
+/**
+ * @brief Joins a fanout group, the kernel then spreads packets across its members
+ * 
+ * @param iGroup
+ * @param iMode
+ * @param iFlags
+ * 
+ * @return
+ */
+bool PacketSocket::join_fanout(const std::uint16_t& iGroup, const fanout_mode_e& iMode, const std::uint16_t& iFlags) {
+  const int value = static_cast<int>(iGroup) | ((static_cast<int>(iMode) | static_cast<int>(iFlags)) << 16);
+  return ::setsockopt(this->sd_, SOL_PACKET, PACKET_FANOUT, &value, sizeof(value)) == 0;
+}
+
+/**
+ * @brief Replaces the classic BPF filter, an empty program removes it
+ * 
+ * @param iFilter
+ * 
+ * @return
+ */
+bool PacketSocket::set_filter(const packet_filter_t& iFilter) {
+  if (iFilter.empty()) {
+    const int unused = 0;
+    return ::setsockopt(this->sd_, SOL_SOCKET, SO_DETACH_FILTER, &unused, sizeof(unused)) == 0 || errno == ENOENT;
+  }
+  sock_fprog program{};
+  program.len = static_cast<unsigned short>(iFilter.size());
+  program.filter = const_cast<sock_filter*>(iFilter.data());
+  return ::setsockopt(this->sd_, SOL_SOCKET, SO_ATTACH_FILTER, &program, sizeof(program)) == 0;
+}
+
+/**
+ * @brief Hands back the block taken by the previous call and takes the next retired one
+ * 
+ * @param oFrames
+ * 
+ * @return
+ */
+std::size_t PacketSocket::receive(std::vector<packet_frame_t>& oFrames) {
+  this->release();
+  oFrames.clear();
+  if (this->map_ == nullptr) {
+    return 0;
+  }
+  tpacket_block_desc* block = reinterpret_cast<tpacket_block_desc*>(
+      this->map_ + static_cast<std::size_t>(this->rxNext_) * this->config_.block_size);
+  if (!(__atomic_load_n(&block->hdr.bh1.block_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER)) {
+    return 0;
+  }
+  const std::uint32_t count = block->hdr.bh1.num_pkts;
+  oFrames.resize(count);
+  const std::uint8_t* cursor = reinterpret_cast<const std::uint8_t*>(block) + block->hdr.bh1.offset_to_first_pkt;
+  for (std::uint32_t i = 0; i < count; ++i) {
+    const tpacket3_hdr* header = reinterpret_cast<const tpacket3_hdr*>(cursor);
+    const sockaddr_ll* link = reinterpret_cast<const sockaddr_ll*>(cursor + PACKET_HEADER_SIZE);
+    packet_frame_t& frame = oFrames[i];
+    frame.data = cursor + header->tp_mac;
+    frame.size = header->tp_snaplen;
+    frame.length = header->tp_len;
+    frame.timestamp_ns = static_cast<std::uint64_t>(header->tp_sec) * 1000000000ull + header->tp_nsec;
+    frame.rxhash = header->hv1.tp_rxhash;
+    frame.ifindex = link->sll_ifindex;
+    frame.type = link->sll_pkttype;
+    cursor += header->tp_next_offset;
+  }
+  this->holding_ = true;
+  ++this->blocks_;
+  this->rxPackets_ += count;
+  return count;
+}
+
+/**
+ * @brief Hands the block taken by receive() back to the kernel
+ */
+void PacketSocket::release(void) {
+  if (!this->holding_) {
+    return;
+  }
+  tpacket_block_desc* block = reinterpret_cast<tpacket_block_desc*>(
+      this->map_ + static_cast<std::size_t>(this->rxNext_) * this->config_.block_size);
+  __atomic_store_n(&block->hdr.bh1.block_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+  this->rxNext_ = (this->rxNext_ + 1) % this->config_.block_count;
+  this->holding_ = false;
+}
+
+/**
+ * @brief Waits until a block is retired
+ * 
+ * @param iTimeoutMs
+ * 
+ * @return
+ */
+bool PacketSocket::wait(const int& iTimeoutMs) const {
+  pollfd entry{this->sd_, POLLIN, 0};
+  return ::poll(&entry, 1, iTimeoutMs) > 0 && (entry.revents & POLLIN);
+}
+
+/**
+ * @brief Copies the frames into free TX slots and flushes them with a single syscall
+ * 
+ * @param iFrames
+ * @param iCount
+ * 
+ * @return
+ */
+std::size_t PacketSocket::send(const iovec* iFrames, const std::size_t& iCount) {
+  if (this->txRing_ == nullptr) {
+    errno = ENOBUFS;
+    return 0;
+  }
+  std::size_t queued = 0;
+  for (; queued < iCount; ++queued) {
+    if (iFrames[queued].iov_len > this->config_.tx_frame_size - PACKET_HEADER_SIZE) {
+      errno = EMSGSIZE;
+      break;
+    }
+    std::uint8_t* slot = this->tx_slot(this->txNext_);
+    tpacket3_hdr* header = reinterpret_cast<tpacket3_hdr*>(slot);
+    if (__atomic_load_n(&header->tp_status, __ATOMIC_ACQUIRE) & (TP_STATUS_SEND_REQUEST | TP_STATUS_SENDING)) {
+      errno = ENOBUFS;
+      break;
+    }
+    std::memcpy(slot + PACKET_HEADER_SIZE, iFrames[queued].iov_base, iFrames[queued].iov_len);
+    header->tp_len = static_cast<std::uint32_t>(iFrames[queued].iov_len);
+    header->tp_next_offset = 0;
+    __atomic_store_n(&header->tp_status, TP_STATUS_SEND_REQUEST, __ATOMIC_RELEASE);
+    this->txNext_ = (this->txNext_ + 1) % this->txSlots_;
+  }
+  if (queued > 0) {
+    this->txPackets_ += queued;
+    this->flush();
+  }
+  return queued;
+}
+
+/**
+ * @brief Asks the kernel to transmit every queued slot
+ * 
+ * @return
+ */
+bool PacketSocket::flush(void) {
+  if (::sendto(this->sd_, nullptr, 0, MSG_DONTWAIT, nullptr, 0) >= 0) {
+    return true;
+  }
+  return errno == EAGAIN || errno == ENOBUFS;
+}
+
+/**
+ * @brief Accepts only frames of the given ethertype
+ * 
+ * Assumes an Ethernet link layer, the ethertype sits at offset 12
+ * 
+ * @param iEthertype
+ * 
+ * @return
+ */
+packet_filter_t PacketSocket::ethertype_filter(const std::uint16_t& iEthertype) {
+  return {
+    {BPF_LD | BPF_H | BPF_ABS, 0, 0, 12},
+    {BPF_JMP | BPF_JEQ | BPF_K, 0, 1, iEthertype},
+    {BPF_RET | BPF_K, 0, 0, 0xFFFFFFFF},
+    {BPF_RET | BPF_K, 0, 0, 0},
+  };
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+/**
+ * @brief
+ * 
+ * @return
+ */
+bool PacketSocket::is_open(void) const {
+  return this->sd_ >= 0;
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+const sd_t& PacketSocket::get_sd(void) const {
+  return this->sd_;
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+const packet_config_t& PacketSocket::get_config(void) const {
+  return this->config_;
+}
+
+/**
+ * @brief Local counters merged with PACKET_STATISTICS
+ * 
+ * @return
+ */
+packet_stats_t PacketSocket::get_stats(void) const {
+  tpacket_stats_v3 kernel{};
+  socklen_t length = sizeof(kernel);
+  if (this->is_open() && ::getsockopt(this->sd_, SOL_PACKET, PACKET_STATISTICS, &kernel, &length) == 0) {
+    this->kernelPackets_ += kernel.tp_packets;
+    this->kernelDrops_ += kernel.tp_drops;
+    this->kernelFreezes_ += kernel.tp_freeze_q_cnt;
+  }
+  packet_stats_t stats;
+  stats.blocks = this->blocks_;
+  stats.rx_packets = this->rxPackets_;
+  stats.tx_packets = this->txPackets_;
+  stats.kernel_packets = this->kernelPackets_;
+  stats.kernel_drops = this->kernelDrops_;
+  stats.kernel_freezes = this->kernelFreezes_;
+  return stats;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+/**
+ * @brief Destructor
+ */
+PacketSocket::~PacketSocket() {
+  this->close();
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PROTECTED METHODS **/
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PRIVATE METHODS **/
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Closes everything opened so far keeping the errno of the failed step
+ * 
+ * @return
+ */
+bool PacketSocket::fail(void) {
+  const int error = errno;
+  this->close();
+  errno = error;
+  return false;
+}
+
+/**
+ * @brief Address of a TX slot, slots never straddle two blocks
+ * 
+ * @param iSlot
+ * 
+ * @return
+ */
+std::uint8_t* PacketSocket::tx_slot(const std::uint32_t& iSlot) const {
+  return this->txRing_ + static_cast<std::size_t>(iSlot / this->txPerBlock_) * this->config_.block_size +
+         static_cast<std::size_t>(iSlot % this->txPerBlock_) * this->config_.tx_frame_size;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+} // namespace sock
+} // namespace ncs
@@ -0,0 +1,296 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file RateLimiter.cpp
+ *
+ * @brief
+ */
+
+
+#include <RateLimiter.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include <endian.h>
+#include <netinet/in.h>
+
+
+namespace ncs { // Network Communications System
+namespace sock { // Network Communications System Sockets
+
+
+/**
+ * @brief Mask keeping the first iPrefix bits of an address, applied to its 64 bits starting at iOffset
+ * 
+ * @param iPrefix
+ * @param iOffset
+ * 
+ * @return
+ */
+static std::uint64_t prefix_mask(const int& iPrefix, const int& iOffset) {
+  const int bits = std::min(std::max(iPrefix - iOffset, 0), 64);
+  return (bits == 0) ? 0 : (~0ull << (64 - bits));
+}
+
+
+/** PUBLIC METHODS **/
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+/**
+ * @brief Config constructor
+ * 
+ * @param iConfig
+ */
+RateLimiter::RateLimiter(const rate_limit_config_t& iConfig)
+    : config_(iConfig), intervalNs_(0), toleranceNs_(0), maskV4_(0), maskV6_{0, 0}, mask_(0) {
+  this->config_.burst = std::max<std::uint64_t>(this->config_.burst, 1);
+  this->config_.prefix_v4 = std::min<std::uint8_t>(this->config_.prefix_v4, 32);
+  this->config_.prefix_v6 = std::min<std::uint8_t>(this->config_.prefix_v6, 128);
+  this->maskV4_ = prefix_mask(this->config_.prefix_v4, 0);
+  this->maskV6_[0] = prefix_mask(this->config_.prefix_v6, 0);
+  this->maskV6_[1] = prefix_mask(this->config_.prefix_v6, 64);
+  if (this->config_.rate > 0) {
+    this->intervalNs_ = std::max<std::uint64_t>(1000000000ull / this->config_.rate, 1);
+    this->toleranceNs_ = this->intervalNs_ * this->config_.burst;
+  }
+  std::size_t buckets = 1;
+  while (buckets * RATE_LIMIT_BUCKET_SLOTS < this->config_.slots) {
+    buckets <<= 1;
+  }
+  this->mask_ = buckets - 1;
+  this->buckets_.reset(new rate_limit_bucket_t[buckets]);
+  this->clear();
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Accounts for one connection from iAddr
+ * 
+ * @param iAddr
+ * @param iSize
+ * @param iNowNs
+ * 
+ * @return
+ */
+[[nodiscard]] bool RateLimiter::admit(const sockaddr* iAddr, const socklen_t& iSize, const std::uint64_t& iNowNs) {
+  const std::uint64_t key = (this->intervalNs_ > 0) ? this->key_of(iAddr, iSize) : 0;
+  if (key == 0) {
+    return true;
+  }
+  rate_limit_bucket_t& bucket = this->buckets_[key & this->mask_];
+  for (std::size_t slot = 0; slot < RATE_LIMIT_BUCKET_SLOTS; ++slot) {
+    if (bucket.keys[slot].load(std::memory_order_relaxed) == key) {
+      return this->conform(bucket.tats[slot], iNowNs);
+    }
+  }
+  // The oldest arrival time belongs to the source that would lose the least by starting over
+  std::size_t victim = 0;
+  std::uint64_t oldest = std::numeric_limits<std::uint64_t>::max();
+  for (std::size_t slot = 0; slot < RATE_LIMIT_BUCKET_SLOTS; ++slot) {
+    if (bucket.keys[slot].load(std::memory_order_relaxed) == 0) {
+      victim = slot;
+      break;
+    }
+    const std::uint64_t tat = bucket.tats[slot].load(std::memory_order_relaxed);
+    if (tat < oldest) {
+      oldest = tat;
+      victim = slot;
+    }
+  }
+  // Losing the race to another thread only costs this source its first interval
+  std::uint64_t expected = bucket.keys[victim].load(std::memory_order_relaxed);
+  if (bucket.keys[victim].compare_exchange_strong(expected, key, std::memory_order_relaxed)) {
+    bucket.tats[victim].store(iNowNs + this->intervalNs_, std::memory_order_relaxed);
+  }
+  return true;
+}
+
+/**
+ * @brief Accounts for one connection from iAddr
+ * 
+ * @param iAddr
+ * @param iNowNs
+ * 
+ * @return
+ */
+[[nodiscard]] bool RateLimiter::admit(const addr::InternetAddress& iAddr, const std::uint64_t& iNowNs) {
+  sockaddr_storage storage;
+  socklen_t size = 0;
+  if (!iAddr.to_sockaddr(storage, size)) {
+    return true;
+  }
+  return this->admit(reinterpret_cast<const sockaddr*>(&storage), size, iNowNs);
+}
+
+/**
+ * @brief Forgets every source
+ */
+void RateLimiter::clear(void) {
+  for (std::size_t bucket = 0; bucket <= this->mask_; ++bucket) {
+    for (std::size_t slot = 0; slot < RATE_LIMIT_BUCKET_SLOTS; ++slot) {
+      this->buckets_[bucket].keys[slot].store(0, std::memory_order_relaxed);
+      this->buckets_[bucket].tats[slot].store(0, std::memory_order_relaxed);
+    }
+  }
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] const rate_limit_config_t& RateLimiter::get_config(void) const {
+  return this->config_;
+}
+
+/**
+ * @brief Sources the table holds at most
+ * 
+ * @return
+ */
+[[nodiscard]] std::size_t RateLimiter::get_slots(void) const {
+  return (this->mask_ + 1) * RATE_LIMIT_BUCKET_SLOTS;
+}
+
+/**
+ * @brief Sources in the table right now
+ * 
+ * @return
+ */
+[[nodiscard]] std::size_t RateLimiter::get_tracked(void) const {
+  std::size_t tracked = 0;
+  for (std::size_t bucket = 0; bucket <= this->mask_; ++bucket) {
+    for (std::size_t slot = 0; slot < RATE_LIMIT_BUCKET_SLOTS; ++slot) {
+      tracked += (this->buckets_[bucket].keys[slot].load(std::memory_order_relaxed) != 0) ? 1 : 0;
+    }
+  }
+  return tracked;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+/**
+ * @brief Destructor
+ */
+RateLimiter::~RateLimiter() {}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PROTECTED METHODS **/
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PRIVATE METHODS **/
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Hash of the source prefix of iAddr
+ * 
+ * @param iAddr
+ * @param iSize
+ * 
+ * @return
+ */
+[[nodiscard]] std::uint64_t RateLimiter::key_of(const sockaddr* iAddr, const socklen_t& iSize) const {
+  std::uint64_t halves[2] = {0, 0};
+  std::uint64_t key = 0;
+  if ((iAddr->sa_family == AF_INET) && (iSize >= sizeof(sockaddr_in))) {
+    const std::uint32_t ip = ntohl(reinterpret_cast<const sockaddr_in*>(iAddr)->sin_addr.s_addr);
+    halves[0] = (static_cast<std::uint64_t>(ip) << 32) & this->maskV4_;
+    key = AF_INET;
+  } else if ((iAddr->sa_family == AF_INET6) && (iSize >= sizeof(sockaddr_in6))) {
+    const in6_addr& ip = reinterpret_cast<const sockaddr_in6*>(iAddr)->sin6_addr;
+    if (IN6_IS_ADDR_V4MAPPED(&ip)) {
+      std::uint32_t ip4 = 0;
+      std::memcpy(&ip4, ip.s6_addr + 12, sizeof(ip4));
+      halves[0] = (static_cast<std::uint64_t>(ntohl(ip4)) << 32) & this->maskV4_;
+      key = AF_INET;
+    } else {
+      std::memcpy(halves, ip.s6_addr, sizeof(halves));
+      halves[0] = be64toh(halves[0]) & this->maskV6_[0];
+      halves[1] = be64toh(halves[1]) & this->maskV6_[1];
+      key = AF_INET6;
+    }
+  } else {
+    return 0;
+  }
+  // splitmix64 finalizer over each half of the prefix
+  for (const std::uint64_t half : halves) {
+    key ^= half;
+    key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ull;
+    key = (key ^ (key >> 27)) * 0x94d049bb133111ebull;
+    key ^= key >> 31;
+  }
+  return (key == 0) ? 1 : key;
+}
+
+/**
+ * @brief Pushes the theoretical arrival time of a source one interval further if it stays within the burst
+ * 
+ * @param ioTat
+ * @param iNowNs
+ * 
+ * @return
+ */
+[[nodiscard]] bool RateLimiter::conform(std::atomic<std::uint64_t>& ioTat, const std::uint64_t& iNowNs) const {
+  std::uint64_t tat = ioTat.load(std::memory_order_relaxed);
+  std::uint64_t next = 0;
+  do {
+    next = std::max(tat, iNowNs) + this->intervalNs_;
+    if (next - iNowNs > this->toleranceNs_) {
+      return false;
+    }
+  } while (!ioTat.compare_exchange_weak(tat, next, std::memory_order_relaxed));
+  return true;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+} // namespace sock
+} // namespace ncs
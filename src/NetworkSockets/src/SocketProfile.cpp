@@ -0,0 +1,248 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file SocketProfile.cpp
+ *
+ * @brief
+ */
+
+
+#include <SocketProfile.h>
+
+#include <cerrno>
+
+#include <netinet/ip.h>
+
+
+namespace ncs { // Network Communications System
+namespace sock { // Network Communications System Sockets
+
+
+/** PUBLIC METHODS **/
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+/**
+ * @brief Name constructor
+ * 
+ * @param iName
+ */
+SocketProfile::SocketProfile(const std::string& iName) : name_(iName) {}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Sets every option of the profile on iSocket
+ * 
+ * @param iSocket
+ * 
+ * @return
+ */
+[[nodiscard]] bool SocketProfile::apply(const InternetSocket& iSocket) const {
+  const addr::addr_family_e family = this->family_of(iSocket);
+  int error = 0;
+  for (const profile_entry_t& entry : this->entries_) {
+    int level = 0;
+    int name = 0;
+    resolve(entry, family, level, name);
+    if (!iSocket.set_option(level, name, entry.value) && !entry.optional && (error == 0)) {
+      error = errno;
+    }
+  }
+  errno = error;
+  return error == 0;
+}
+
+/**
+ * @brief Reads the effective value of every option of the profile from iSocket
+ * 
+ * @param iSocket
+ * 
+ * @return
+ */
+[[nodiscard]] std::vector<option_reading_t> SocketProfile::read_back(const InternetSocket& iSocket) const {
+  const addr::addr_family_e family = this->family_of(iSocket);
+  std::vector<option_reading_t> readings;
+  readings.reserve(this->entries_.size());
+  for (const profile_entry_t& entry : this->entries_) {
+    int level = 0;
+    int name = 0;
+    resolve(entry, family, level, name);
+    option_reading_t reading;
+    reading.label = entry.label;
+    reading.requested = entry.value;
+    reading.read = iSocket.get_option(level, name, reading.effective);
+    readings.push_back(reading);
+  }
+  return readings;
+}
+
+/**
+ * @brief Interactive traffic
+ * 
+ * @return
+ */
+[[nodiscard]] SocketProfile SocketProfile::low_latency(void) {
+  SocketProfile profile("low-latency");
+  profile.set<tcp_no_delay_t>(true)
+      .set<tcp_quick_ack_t>(true)
+      .set<tcp_not_sent_low_at_t>(LOW_LATENCY_NOT_SENT_LOW_AT)
+      .set<traffic_class_t>(IPTOS_LOWDELAY)
+      .set<busy_poll_t>(LOW_LATENCY_BUSY_POLL_US, true);
+  return profile;
+}
+
+/**
+ * @brief Transfers of large volumes
+ * 
+ * @return
+ */
+[[nodiscard]] SocketProfile SocketProfile::bulk_throughput(void) {
+  SocketProfile profile("bulk-throughput");
+  profile.set<tcp_no_delay_t>(false)
+      .set<send_buffer_t>(BULK_BUFFER_SIZE)
+      .set<recv_buffer_t>(BULK_BUFFER_SIZE)
+      .set<traffic_class_t>(IPTOS_THROUGHPUT);
+  return profile;
+}
+
+/**
+ * @brief Large numbers of mostly idle connections
+ * 
+ * @return
+ */
+[[nodiscard]] SocketProfile SocketProfile::many_idle_connections(void) {
+  SocketProfile profile("many-idle-connections");
+  profile.set<send_buffer_t>(IDLE_BUFFER_SIZE)
+      .set<recv_buffer_t>(IDLE_BUFFER_SIZE)
+      .set<tcp_not_sent_low_at_t>(IDLE_BUFFER_SIZE)
+      .set<keep_alive_t>(true);
+  return profile;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] const std::string& SocketProfile::get_name(void) const {
+  return this->name_;
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] const std::vector<profile_entry_t>& SocketProfile::get_entries(void) const {
+  return this->entries_;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+/**
+ * @brief Destructor
+ */
+SocketProfile::~SocketProfile() {}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PROTECTED METHODS **/
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PRIVATE METHODS **/
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Stores iEntry, replacing an entry for the same option
+ * 
+ * @param iEntry
+ */
+void SocketProfile::add(const profile_entry_t& iEntry) {
+  for (profile_entry_t& entry : this->entries_) {
+    if ((entry.level == iEntry.level) && (entry.name == iEntry.name)) {
+      entry = iEntry;
+      return;
+    }
+  }
+  this->entries_.push_back(iEntry);
+}
+
+/**
+ * @brief Level and name of iEntry on iSocket
+ * 
+ * @param iEntry
+ * @param iFamily
+ * @param oLevel
+ * @param oName
+ */
+void SocketProfile::resolve(const profile_entry_t& iEntry, const addr::addr_family_e& iFamily, int& oLevel,
+                            int& oName) {
+  const bool v6 = (iFamily == addr::NET_ADDR_FAM_INET6);
+  oLevel = v6 ? iEntry.level_v6 : iEntry.level;
+  oName = v6 ? iEntry.name_v6 : iEntry.name;
+}
+
+/**
+ * @brief Family of iSocket, looked up only if some option depends on it
+ * 
+ * @param iSocket
+ * 
+ * @return
+ */
+[[nodiscard]] addr::addr_family_e SocketProfile::family_of(const InternetSocket& iSocket) const {
+  for (const profile_entry_t& entry : this->entries_) {
+    if ((entry.level != entry.level_v6) || (entry.name != entry.name_v6)) {
+      return iSocket.get_address_family();
+    }
+  }
+  return addr::NET_ADDR_FAM_UNSPEC;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+} // namespace sock
+} // namespace ncs
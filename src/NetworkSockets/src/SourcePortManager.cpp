@@ -0,0 +1,341 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file SourcePortManager.cpp
+ *
+ * @brief
+ */
+
+
+#include <SourcePortManager.h>
+#include <SocketMetrics.h>
+#include <SocketOptions.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+
+#include <sys/socket.h>
+
+
+namespace ncs { // Network Communications System
+namespace sock { // Network Communications System Sockets
+
+
+/**
+ * @brief
+ * 
+ * @param iOther
+ * 
+ * @return
+ */
+[[nodiscard]] bool flow_key_t::operator==(const flow_key_t& iOther) const {
+  return (this->source == iOther.source) &&
+         (std::memcmp(this->destination.bytes, iOther.destination.bytes, addr::ADDRESS_KEY_SIZE) == 0);
+}
+
+/**
+ * @brief FNV-1a over the key
+ * 
+ * @param iKey
+ * 
+ * @return
+ */
+[[nodiscard]] std::size_t flow_key_hash_t::operator()(const flow_key_t& iKey) const {
+  std::uint64_t hash = 14695981039346656037ull ^ iKey.source;
+  for (const std::uint8_t byte : iKey.destination.bytes) {
+    hash = (hash ^ byte) * 1099511628211ull;
+  }
+  return static_cast<std::size_t>(hash);
+}
+
+
+/** PUBLIC METHODS **/
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+/**
+ * @brief Config constructor
+ * 
+ * @param iConfig
+ */
+SourcePortManager::SourcePortManager(const source_ports_config_t& iConfig)
+    : config_(iConfig), capacity_(0), connections_(0), cursor_(0), metrics_(nullptr) {
+  for (const addr::InternetAddress& source : this->config_.sources) {
+    addr::address_key_t key;
+    (void)addr::InternetAddress(source.get_ip(), addr::RANDOM_PORT).to_key(key);
+    this->sourceKeys_.push_back(key);
+  }
+  addr::port_t first = DEFAULT_FIRST_LOCAL_PORT;
+  addr::port_t last = DEFAULT_LAST_LOCAL_PORT;
+  std::ifstream range(LOCAL_PORT_RANGE_PATH);
+  addr::port_t systemFirst = 0;
+  addr::port_t systemLast = 0;
+  if ((range >> systemFirst >> systemLast) && (systemLast >= systemFirst)) {
+    first = systemFirst;
+    last = systemLast;
+  }
+  if ((this->config_.first_port > 0) && (this->config_.last_port >= this->config_.first_port)) {
+    first = std::max(first, this->config_.first_port);
+    last = std::min(last, this->config_.last_port);
+  }
+  this->capacity_ = (last >= first) ? static_cast<std::size_t>(last - first + 1) : 0;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Connects oSocket to iDestination from one of the sources of its family
+ * 
+ * @param iDestination
+ * @param oSocket
+ * 
+ * @return
+ */
+[[nodiscard]] bool SourcePortManager::connect(const addr::InternetAddress& iDestination, InternetSocket& oSocket) {
+  flow_key_t key;
+  if (!iDestination.to_key(key.destination) || (iDestination.get_port() == addr::RANDOM_PORT)) {
+    if (this->metrics_ != nullptr) {
+      this->metrics_->on_error();
+    }
+    errno = EINVAL;
+    return false;
+  }
+  const std::size_t sources = this->sourceKeys_.size();
+  const addr::addr_family_e family = iDestination.get_address_family();
+  std::vector<bool> tried(sources, false);
+  while (true) {
+    std::size_t best = sources;
+    std::size_t bestCount = this->capacity_;
+    for (std::size_t offset = 0; offset < sources; ++offset) {
+      const std::size_t source = (this->cursor_ + offset) % sources;
+      // Paired on the family of the sockaddr given to the kernel, an IPv4 mapped destination needs an IPv6 socket
+      if (tried[source] || (this->config_.sources[source].get_address_family() != family)) {
+        continue;
+      }
+      key.source = static_cast<std::uint32_t>(source);
+      const std::size_t count = this->count(key);
+      if (count < bestCount) {
+        best = source;
+        bestCount = count;
+      }
+    }
+    if (best == sources) {
+      if (this->metrics_ != nullptr) {
+        this->metrics_->on_exhausted();
+      }
+      errno = EADDRNOTAVAIL;
+      return false;
+    }
+    tried[best] = true;
+
+    const std::uint64_t start = (this->metrics_ != nullptr) ? metrics::clock_ns() : 0;
+    if (this->open_from(best, oSocket) && oSocket.connect(iDestination)) {
+      key.source = static_cast<std::uint32_t>(best);
+      ++this->flows_[key];
+      ++this->connections_;
+      this->cursor_ = (best + 1) % sources;
+      if (this->metrics_ != nullptr) {
+        this->metrics_->on_connect(metrics::clock_ns() - start);
+      }
+      return true;
+    }
+    const int error = errno;
+    oSocket.close();
+    errno = error;
+    // No port left toward the destination on this source, the next one may still have some
+    if (error != EADDRNOTAVAIL) {
+      if (this->metrics_ != nullptr) {
+        this->metrics_->on_error();
+      }
+      return false;
+    }
+    if (this->metrics_ != nullptr) {
+      this->metrics_->on_port_unavailable();
+    }
+  }
+}
+
+/**
+ * @brief Gives back the port held by a connection opened by connect()
+ * 
+ * @param iSocket
+ * 
+ * @return
+ */
+bool SourcePortManager::release(const InternetSocket& iSocket) {
+  sockaddr_storage storage;
+  socklen_t size = sizeof(storage);
+  addr::InternetAddress local;
+  flow_key_t key;
+  if ((::getsockname(iSocket.get_sd(), reinterpret_cast<sockaddr*>(&storage), &size) != 0) ||
+      !local.set_sockaddr(reinterpret_cast<sockaddr*>(&storage), size) || !iSocket.get_addr().to_key(key.destination)) {
+    return false;
+  }
+  addr::address_key_t source;
+  (void)addr::InternetAddress(local.get_ip(), addr::RANDOM_PORT).to_key(source);
+  for (std::size_t i = 0; i < this->sourceKeys_.size(); ++i) {
+    if (std::memcmp(this->sourceKeys_[i].bytes, source.bytes, addr::ADDRESS_KEY_SIZE) != 0) {
+      continue;
+    }
+    key.source = static_cast<std::uint32_t>(i);
+    auto flow = this->flows_.find(key);
+    if (flow == this->flows_.end()) {
+      continue;
+    }
+    if (--flow->second == 0) {
+      this->flows_.erase(flow);
+    }
+    --this->connections_;
+    return true;
+  }
+  return false;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+/**
+ * @brief Accounts every connect in iMetrics, nullptr to stop
+ * 
+ * @param iMetrics
+ */
+void SourcePortManager::set_metrics(metrics::ConnectMetrics* iMetrics) {
+  this->metrics_ = iMetrics;
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] const source_ports_config_t& SourcePortManager::get_config(void) const {
+  return this->config_;
+}
+
+/**
+ * @brief Ports each source has toward a destination
+ * 
+ * @return
+ */
+[[nodiscard]] const std::size_t& SourcePortManager::get_capacity(void) const {
+  return this->capacity_;
+}
+
+/**
+ * @brief Connections opened and not yet released
+ * 
+ * @return
+ */
+[[nodiscard]] const std::size_t& SourcePortManager::get_connections(void) const {
+  return this->connections_;
+}
+
+/**
+ * @brief Connections opened and not yet released from iSource to iDestination
+ * 
+ * @param iSource
+ * @param iDestination
+ * 
+ * @return
+ */
+[[nodiscard]] std::size_t SourcePortManager::get_connections(const std::size_t& iSource,
+                                                             const addr::InternetAddress& iDestination) const {
+  flow_key_t key;
+  key.source = static_cast<std::uint32_t>(iSource);
+  return iDestination.to_key(key.destination) ? this->count(key) : 0;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PROTECTED METHODS **/
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PRIVATE METHODS **/
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Opens oSocket and binds it to the address of iSource, leaving the port to connect(2)
+ * 
+ * @param iSource
+ * @param oSocket
+ * 
+ * @return
+ */
+[[nodiscard]] bool SourcePortManager::open_from(const std::size_t& iSource, InternetSocket& oSocket) const {
+  if (!oSocket.open(this->config_.sources[iSource].get_address_family()) ||
+      ((this->config_.profile != nullptr) && !this->config_.profile->apply(oSocket)) ||
+      !oSocket.set_option<bind_address_no_port_t>(true)) {
+    return false;
+  }
+  if ((this->config_.first_port > 0) && (this->config_.last_port >= this->config_.first_port)) {
+    const std::uint32_t range = (static_cast<std::uint32_t>(this->config_.last_port) << 16) |
+                                static_cast<std::uint32_t>(this->config_.first_port);
+    // Kernels before 6.3 lack the option and keep to the system wide range, the accounting still holds
+    if (!oSocket.set_option<local_port_range_t>(range) && (errno != ENOPROTOOPT)) {
+      return false;
+    }
+  }
+  return oSocket.bind({this->config_.sources[iSource].get_ip(), addr::RANDOM_PORT});
+}
+
+/**
+ * @brief Connections from iSource to the destination of iKey
+ * 
+ * @param iKey
+ * 
+ * @return
+ */
+[[nodiscard]] std::size_t SourcePortManager::count(const flow_key_t& iKey) const {
+  auto flow = this->flows_.find(iKey);
+  return (flow == this->flows_.end()) ? 0 : flow->second;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+} // namespace sock
+} // namespace ncs
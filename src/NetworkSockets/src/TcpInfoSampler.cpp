@@ -0,0 +1,200 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file TcpInfoSampler.cpp
+ *
+ * @brief
+ */
+
+
+#include <TcpInfoSampler.h>
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+#include <algorithm>
+
+
+namespace ncs { // Network Communications System
+namespace sock { // Network Communications System Sockets
+
+
+/** PUBLIC METHODS **/
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+/**
+ * @brief Loop constructor
+ * 
+ * @param iLoop
+ * @param iInterval
+ */
+TcpInfoSampler::TcpInfoSampler(EventLoop& iLoop, const std::chrono::milliseconds& iInterval)
+    : loop_(iLoop), interval_(iInterval), targets_(), task_(0) {
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Samples iSocket into ioMetrics on every period
+ * 
+ * @param iSocket
+ * @param ioMetrics
+ */
+void TcpInfoSampler::add(const InternetSocket& iSocket, metrics::SocketMetrics& ioMetrics) {
+  this->targets_.emplace_back(iSocket.get_sd(), &ioMetrics);
+}
+
+/**
+ * @brief
+ * 
+ * @param iSocket
+ * 
+ * @return
+ */
+bool TcpInfoSampler::remove(const InternetSocket& iSocket) {
+  auto target = std::find_if(this->targets_.begin(), this->targets_.end(),
+                             [&iSocket](const auto& iTarget) { return iTarget.first == iSocket.get_sd(); });
+  if (target == this->targets_.end()) {
+    return false;
+  }
+  *target = this->targets_.back();
+  this->targets_.pop_back();
+  return true;
+}
+
+/**
+ * @brief Samples every socket once per interval until stop()
+ */
+void TcpInfoSampler::start(void) {
+  this->stop();
+  this->task_ = this->loop_.schedule(loop_clock_t::now() + this->interval_, [this]() {
+    this->task_ = 0;
+    this->sample_all();
+    this->start();
+  });
+}
+
+/**
+ * @brief
+ */
+void TcpInfoSampler::stop(void) {
+  if (this->task_ != 0) {
+    this->loop_.cancel(this->task_);
+    this->task_ = 0;
+  }
+}
+
+/**
+ * @brief Samples every socket right away
+ * 
+ * @return
+ */
+std::size_t TcpInfoSampler::sample_all(void) {
+  std::size_t sampled = 0;
+  for (const auto& target : this->targets_) {
+    metrics::tcp_info_sample_t sample;
+    if (TcpInfoSampler::sample(target.first, sample)) {
+      target.second->on_tcp_info(sample);
+      ++sampled;
+    }
+  }
+  return sampled;
+}
+
+/**
+ * @brief Reads TCP_INFO from a descriptor
+ * 
+ * @param iSd
+ * @param oSample
+ * 
+ * @return
+ */
+[[nodiscard]] bool TcpInfoSampler::sample(const sd_t& iSd, metrics::tcp_info_sample_t& oSample) {
+  tcp_info info{};
+  socklen_t size = sizeof(info);
+  if (getsockopt(iSd, IPPROTO_TCP, TCP_INFO, &info, &size) != 0) {
+    return false;
+  }
+  oSample.rtt_us = info.tcpi_rtt;
+  oSample.rtt_var_us = info.tcpi_rttvar;
+  oSample.snd_cwnd = info.tcpi_snd_cwnd;
+  oSample.retransmits = info.tcpi_retransmits;
+  oSample.total_retrans = info.tcpi_total_retrans;
+  return true;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] std::size_t TcpInfoSampler::get_sampled_count(void) const {
+  return this->targets_.size();
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+/**
+ * @brief Destructor
+ */
+TcpInfoSampler::~TcpInfoSampler() {
+  this->stop();
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PROTECTED METHODS **/
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PRIVATE METHODS **/
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+} // namespace sock
+} // namespace ncs
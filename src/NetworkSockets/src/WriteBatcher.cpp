@@ -0,0 +1,363 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file WriteBatcher.cpp
+ *
+ * @brief
+ */
+
+
+#include <WriteBatcher.h>
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+#include <algorithm>
+#include <cerrno>
+
+
+namespace ncs { // Network Communications System
+namespace sock { // Network Communications System Sockets
+
+
+/** PUBLIC METHODS **/
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+/**
+ * @brief Socket constructor
+ * 
+ * @param iSocket
+ * @param iPolicy
+ * @param iLoop
+ */
+WriteBatcher::WriteBatcher(const InternetSocket& iSocket, const coalesce_policy_t& iPolicy, EventLoop* iLoop)
+    : socket_(iSocket), policy_(iPolicy), loop_(iLoop), queue_(), queuedSize_(0), flushTask_(0), retryDelay_(MIN_WRITE_RETRY),
+      stats_(),
+      flow_(nullptr) {
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Queues a copy of iData
+ * 
+ * @param iData
+ * @param iSize
+ * 
+ * @return
+ */
+[[nodiscard]] bool WriteBatcher::write(const void* iData, const std::size_t& iSize) {
+  if ((this->flow_ != nullptr) && !this->flow_->reserve(iSize)) {
+    errno = ENOBUFS;
+    return false;
+  }
+  const std::uint8_t* bytes = static_cast<const std::uint8_t*>(iData);
+  if (this->queue_.empty() || (this->queue_.back().data.capacity() - this->queue_.back().data.size() < iSize)) {
+    this->queue_.emplace_back();
+    this->queue_.back().data.reserve(std::max(iSize, WRITE_CHUNK_SIZE));
+  }
+  this->queue_.back().data.insert(this->queue_.back().data.end(), bytes, bytes + iSize);
+  return this->queued(iSize);
+}
+
+/**
+ * @brief Queues iBuffer without copying it
+ * 
+ * @param iBuffer
+ * 
+ * @return
+ */
+[[nodiscard]] bool WriteBatcher::write(std::vector<std::uint8_t>&& iBuffer) {
+  const std::size_t size = iBuffer.size();
+  if (size < this->policy_.copy_threshold) {
+    return this->write(iBuffer.data(), size);
+  }
+  if ((this->flow_ != nullptr) && !this->flow_->reserve(size)) {
+    errno = ENOBUFS;
+    return false;
+  }
+  this->queue_.push_back({std::move(iBuffer), 0});
+  return this->queued(size);
+}
+
+/**
+ * @brief Sends as much of the queue as the socket accepts
+ * 
+ * @return
+ */
+flush_status_e WriteBatcher::flush(void) {
+  this->disarm();
+  if (this->queue_.empty()) {
+    return FLUSH_DONE;
+  }
+  flush_status_e status = FLUSH_DONE;
+  this->cork(true);
+  while (!this->queue_.empty()) {
+    iovec iov[MAX_WRITE_IOV];
+    std::size_t count = 0;
+    for (auto buffer = this->queue_.begin(); (buffer != this->queue_.end()) && (count < MAX_WRITE_IOV); ++buffer) {
+      iov[count++] = {buffer->data.data() + buffer->offset, buffer->data.size() - buffer->offset};
+    }
+    const int flags = (this->policy_.use_msg_more && (count < this->queue_.size())) ? MSG_MORE : 0;
+    const ssize_t sent = this->socket_.send_v(iov, count, flags);
+    ++this->stats_.syscalls;
+    if (sent < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      status = ((errno == EAGAIN) || (errno == EWOULDBLOCK)) ? FLUSH_PENDING : FLUSH_ERROR;
+      break;
+    }
+    std::size_t remaining = static_cast<std::size_t>(sent);
+    this->queuedSize_ -= remaining;
+    this->stats_.bytes += remaining;
+    if (this->flow_ != nullptr) {
+      this->flow_->release(remaining);
+    }
+    while (remaining > 0) {
+      write_buffer_t& front = this->queue_.front();
+      const std::size_t consumed = std::min(remaining, front.data.size() - front.offset);
+      front.offset += consumed;
+      remaining -= consumed;
+      if (front.offset == front.data.size()) {
+        this->queue_.pop_front();
+      }
+    }
+  }
+  this->cork(false);
+  ++this->stats_.flushes;
+  return status;
+}
+
+/**
+ * @brief Drops every queued byte
+ */
+void WriteBatcher::clear(void) {
+  this->disarm();
+  if (this->flow_ != nullptr) {
+    this->flow_->release(this->queuedSize_);
+  }
+  this->queue_.clear();
+  this->queuedSize_ = 0;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+/**
+ * @brief
+ * 
+ * @param iPolicy
+ */
+void WriteBatcher::set_policy(const coalesce_policy_t& iPolicy) {
+  this->policy_ = iPolicy;
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] const coalesce_policy_t& WriteBatcher::get_policy(void) const {
+  return this->policy_;
+}
+
+/**
+ * @brief Reports queued and sent bytes to iFlow, nullptr to stop reporting
+ * 
+ * @param iFlow
+ */
+void WriteBatcher::set_flow_controller(FlowController* iFlow) {
+  if (this->flow_ != nullptr) {
+    this->flow_->release(this->queuedSize_);
+  }
+  this->flow_ = iFlow;
+  if ((this->flow_ != nullptr) && !this->flow_->reserve(this->queuedSize_)) {
+    this->flow_ = nullptr;
+  }
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] const coalesce_stats_t& WriteBatcher::get_stats(void) const {
+  return this->stats_;
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] const std::size_t& WriteBatcher::get_queued_size(void) const {
+  return this->queuedSize_;
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+[[nodiscard]] bool WriteBatcher::has_pending(void) const {
+  return this->queuedSize_ > 0;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+/**
+ * @brief Destructor
+ */
+WriteBatcher::~WriteBatcher() {
+  this->clear();
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PROTECTED METHODS **/
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PRIVATE METHODS **/
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Accounts for newly queued bytes, flushing or arming the automatic flush
+ * 
+ * @param iSize
+ * 
+ * @return
+ */
+[[nodiscard]] bool WriteBatcher::queued(const std::size_t& iSize) {
+  ++this->stats_.writes;
+  this->queuedSize_ += iSize;
+  if (this->queuedSize_ >= this->policy_.max_batch_bytes) {
+    const flush_status_e status = this->flush();
+    if (status == FLUSH_PENDING) {
+      this->retry();
+    }
+    return status != FLUSH_ERROR;
+  }
+  this->arm();
+  return true;
+}
+
+/**
+ * @brief Registers the automatic flush in the loop if not done yet
+ */
+void WriteBatcher::arm(void) {
+  if ((this->loop_ == nullptr) || (this->flushTask_ != 0)) {
+    return;
+  }
+  auto task = [this]() {
+    this->flushTask_ = 0;
+    this->auto_flush();
+  };
+  if (this->policy_.latency_budget.count() == 0) {
+    this->flushTask_ = this->loop_->defer(task);
+  }
+  else {
+    this->flushTask_ = this->loop_->schedule(loop_clock_t::now() + this->policy_.latency_budget, task);
+  }
+}
+
+/**
+ * @brief Cancels the automatic flush
+ */
+void WriteBatcher::disarm(void) {
+  if ((this->loop_ != nullptr) && (this->flushTask_ != 0)) {
+    this->loop_->cancel(this->flushTask_);
+  }
+  this->flushTask_ = 0;
+}
+
+/**
+ * @brief Flushes from the loop, retrying while the socket would block
+ */
+void WriteBatcher::auto_flush(void) {
+  const std::size_t before = this->queuedSize_;
+  if (this->flush() != FLUSH_PENDING) {
+    this->retryDelay_ = MIN_WRITE_RETRY;
+    return;
+  }
+  if (this->queuedSize_ < before) {
+    this->retryDelay_ = MIN_WRITE_RETRY;
+  }
+  this->retry();
+}
+
+/**
+ * @brief Schedules the next try of an automatic flush that would block
+ */
+void WriteBatcher::retry(void) {
+  // Retried by a timer rather than an EPOLLOUT watch, the socket may already be watched by its owner
+  if ((this->loop_ == nullptr) || (this->flushTask_ != 0)) {
+    return;
+  }
+  // Backing off past the latency budget would hold bytes longer than the policy allows once the peer drains
+  const std::chrono::microseconds ceiling = std::clamp(this->policy_.latency_budget, MIN_WRITE_RETRY, MAX_WRITE_RETRY);
+  this->retryDelay_ = std::min(this->retryDelay_, ceiling);
+  this->flushTask_ = this->loop_->schedule(loop_clock_t::now() + this->retryDelay_, [this]() {
+    this->flushTask_ = 0;
+    this->auto_flush();
+  });
+  this->retryDelay_ = std::min(this->retryDelay_ * 2, ceiling);
+}
+
+/**
+ * @brief Toggles TCP_CORK when the policy asks for it
+ * 
+ * @param iEnabled
+ */
+void WriteBatcher::cork(const bool& iEnabled) const {
+  if (this->policy_.use_cork) {
+    const int value = iEnabled ? 1 : 0;
+    setsockopt(this->socket_.get_sd(), IPPROTO_TCP, TCP_CORK, &value, sizeof(value));
+  }
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+} // namespace sock
+} // namespace ncs
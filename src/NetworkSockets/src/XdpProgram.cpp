@@ -0,0 +1,291 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file XdpProgram.cpp
+ *
+ * @brief
+ */
+
+
+#include <XdpProgram.h>
+
+#include <linux/bpf.h>
+#include <linux/if_link.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+
+
+namespace ncs { // Network Communications System
+namespace sock { // Network Communications System Sockets
+
+
+/**
+ * XdpProgram constants
+ */
+constexpr char XDP_MAP_NAME[] = "ncs_xsks";
+constexpr char XDP_PROGRAM_NAME[] = "ncs_xsk_redir";
+constexpr char XDP_PROGRAM_LICENSE[] = "Dual MIT/GPL";     // redirect_map is only offered to GPL compatible programs
+
+/**
+ * @brief Issues a bpf command
+ * 
+ * @param iCommand
+ * @param ioAttr
+ * 
+ * @return The syscall result, -1 with errno set on failure
+ */
+static long bpf(const int& iCommand, bpf_attr& ioAttr) {
+  return ::syscall(__NR_bpf, iCommand, &ioAttr, sizeof(ioAttr));
+}
+
+
+/** PUBLIC METHODS **/
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+/**
+ * @brief Default constructor
+ */
+XdpProgram::XdpProgram(void)
+    : ifindex_(0), mode_(XDP_ATTACH_AUTO), mapSd_(-1), programSd_(-1), linkSd_(-1) {
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Creates the socket map, loads the program and links it to the interface
+ * 
+ * @param iIfIndex
+ * @param iMode
+ * @param iQueues
+ * 
+ * @return
+ */
+bool XdpProgram::attach(const int& iIfIndex, const xdp_attach_e& iMode, const std::uint32_t& iQueues) {
+  this->detach();
+  this->ifindex_ = iIfIndex;
+
+  bpf_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.map_type = BPF_MAP_TYPE_XSKMAP;
+  attr.key_size = sizeof(std::uint32_t);
+  attr.value_size = sizeof(std::uint32_t);
+  attr.max_entries = iQueues;
+  std::strncpy(attr.map_name, XDP_MAP_NAME, sizeof(attr.map_name) - 1);
+  this->mapSd_ = static_cast<sd_t>(bpf(BPF_MAP_CREATE, attr));
+
+  bool linked = false;
+  if (this->mapSd_ >= 0 && this->load()) {
+    if (iMode == XDP_ATTACH_AUTO) {
+      linked = this->link(XDP_ATTACH_NATIVE) || this->link(XDP_ATTACH_GENERIC);
+    } else {
+      linked = this->link(iMode);
+    }
+  }
+  if (!linked) {
+    const int error = errno;
+    this->detach();
+    errno = error;
+  }
+  return linked;
+}
+
+/**
+ * @brief Redirects the queue iSocket is bound to into it
+ * 
+ * @param iSocket
+ * 
+ * @return
+ */
+bool XdpProgram::add(const XdpSocket& iSocket) {
+  if (!this->is_attached() || !iSocket.is_open()) {
+    errno = EBADF;
+    return false;
+  }
+  const std::uint32_t key = iSocket.get_config().queue;
+  const std::uint32_t value = static_cast<std::uint32_t>(iSocket.get_sd());
+  bpf_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.map_fd = static_cast<std::uint32_t>(this->mapSd_);
+  attr.key = reinterpret_cast<std::uint64_t>(&key);
+  attr.value = reinterpret_cast<std::uint64_t>(&value);
+  attr.flags = BPF_ANY;
+  return bpf(BPF_MAP_UPDATE_ELEM, attr) == 0;
+}
+
+/**
+ * @brief Stops redirecting iQueue
+ * 
+ * @param iQueue
+ * 
+ * @return
+ */
+bool XdpProgram::remove(const std::uint32_t& iQueue) {
+  if (!this->is_attached()) {
+    return false;
+  }
+  bpf_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.map_fd = static_cast<std::uint32_t>(this->mapSd_);
+  attr.key = reinterpret_cast<std::uint64_t>(&iQueue);
+  return bpf(BPF_MAP_DELETE_ELEM, attr) == 0;
+}
+
+/**
+ * @brief Unlinks the program and releases the map
+ */
+void XdpProgram::detach(void) {
+  // Closing the last reference to the link is what unhooks the program from the interface
+  for (sd_t* sd : {&this->linkSd_, &this->programSd_, &this->mapSd_}) {
+    if (*sd >= 0) {
+      ::close(*sd);
+      *sd = -1;
+    }
+  }
+  this->mode_ = XDP_ATTACH_AUTO;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+/**
+ * @brief
+ * 
+ * @return
+ */
+bool XdpProgram::is_attached(void) const {
+  return this->linkSd_ >= 0;
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+const xdp_attach_e& XdpProgram::get_mode(void) const {
+  return this->mode_;
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+const int& XdpProgram::get_ifindex(void) const {
+  return this->ifindex_;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+/**
+ * @brief Destructor
+ */
+XdpProgram::~XdpProgram() {
+  this->detach();
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PROTECTED METHODS **/
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PRIVATE METHODS **/
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Loads the redirect program against mapSd_
+ * 
+ * @return
+ */
+bool XdpProgram::load(void) {
+  // r2 = ctx->rx_queue_index; return bpf_redirect_map(&xsks, r2, XDP_PASS);
+  const bpf_insn program[] = {
+    {BPF_LDX | BPF_W | BPF_MEM, 2, 1, offsetof(xdp_md, rx_queue_index), 0},
+    {BPF_LD | BPF_DW | BPF_IMM, 1, BPF_PSEUDO_MAP_FD, 0, this->mapSd_},
+    {0, 0, 0, 0, 0},
+    {BPF_ALU64 | BPF_MOV | BPF_K, 3, 0, 0, XDP_PASS},
+    {BPF_JMP | BPF_CALL, 0, 0, 0, BPF_FUNC_redirect_map},
+    {BPF_JMP | BPF_EXIT, 0, 0, 0, 0},
+  };
+  bpf_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.prog_type = BPF_PROG_TYPE_XDP;
+  attr.expected_attach_type = BPF_XDP;
+  attr.insn_cnt = sizeof(program) / sizeof(program[0]);
+  attr.insns = reinterpret_cast<std::uint64_t>(program);
+  attr.license = reinterpret_cast<std::uint64_t>(XDP_PROGRAM_LICENSE);
+  std::strncpy(attr.prog_name, XDP_PROGRAM_NAME, sizeof(attr.prog_name) - 1);
+  this->programSd_ = static_cast<sd_t>(bpf(BPF_PROG_LOAD, attr));
+  return this->programSd_ >= 0;
+}
+
+/**
+ * @brief Links the loaded program with a single mode
+ * 
+ * @param iMode
+ * 
+ * @return
+ */
+bool XdpProgram::link(const xdp_attach_e& iMode) {
+  bpf_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.link_create.prog_fd = static_cast<std::uint32_t>(this->programSd_);
+  attr.link_create.target_ifindex = static_cast<std::uint32_t>(this->ifindex_);
+  attr.link_create.attach_type = BPF_XDP;
+  attr.link_create.flags = (iMode == XDP_ATTACH_NATIVE) ? XDP_FLAGS_DRV_MODE : XDP_FLAGS_SKB_MODE;
+  this->linkSd_ = static_cast<sd_t>(bpf(BPF_LINK_CREATE, attr));
+  if (this->linkSd_ < 0) {
+    return false;
+  }
+  this->mode_ = iMode;
+  return true;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+} // namespace sock
+} // namespace ncs
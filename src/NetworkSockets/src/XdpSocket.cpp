@@ -0,0 +1,558 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file XdpSocket.cpp
+ *
+ * @brief
+ */
+
+
+#include <XdpSocket.h>
+
+#include <NetworkAddress.h>
+
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+
+namespace ncs { // Network Communications System
+namespace sock { // Network Communications System Sockets
+
+
+/**
+ * @brief
+ * 
+ * @param iValue
+ * 
+ * @return
+ */
+static bool is_power_of_two(const std::uint32_t& iValue) {
+  return iValue != 0 && (iValue & (iValue - 1)) == 0;
+}
+
+
+/** PUBLIC METHODS **/
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+/**
+ * @brief Default constructor
+ */
+XdpSocket::XdpSocket(void)
+    : config_(), mode_(XDP_MODE_AUTO), sd_(-1), umem_(nullptr), umemSize_(0), fill_(), completion_(), rx_(), tx_(),
+      freeFrames_(), rxPackets_(0), txPackets_(0), wakeups_(0) {
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Creates the socket, registers the UMEM, maps the rings and binds to the configured queue
+ * 
+ * @param iConfig
+ * 
+ * @return
+ */
+bool XdpSocket::open(const xdp_config_t& iConfig) {
+  this->close();
+  if (!is_power_of_two(iConfig.ring_size) || !is_power_of_two(iConfig.frame_size) ||
+      iConfig.frame_size < XDP_MIN_FRAME_SIZE || iConfig.frame_count < 2) {
+    errno = EINVAL;
+    return false;
+  }
+  this->config_ = iConfig;
+
+  this->sd_ = ::socket(addr::NET_ADDR_FAM_XDP, SOCK_RAW | SOCK_CLOEXEC, 0);
+  if (this->sd_ < 0) {
+    return false;
+  }
+
+  this->umemSize_ = static_cast<std::size_t>(iConfig.frame_count) * iConfig.frame_size;
+  void* umem = ::mmap(nullptr, this->umemSize_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+  if (umem == MAP_FAILED) {
+    return this->fail();
+  }
+  this->umem_ = static_cast<std::uint8_t*>(umem);
+
+  xdp_umem_reg reg{};
+  reg.addr = reinterpret_cast<std::uint64_t>(this->umem_);
+  reg.len = this->umemSize_;
+  reg.chunk_size = iConfig.frame_size;
+  reg.headroom = 0;
+  if (::setsockopt(this->sd_, SOL_XDP, XDP_UMEM_REG, &reg, sizeof(reg)) < 0) {
+    return this->fail();
+  }
+
+  const int ringSize = static_cast<int>(iConfig.ring_size);
+  for (const int option : {XDP_UMEM_FILL_RING, XDP_UMEM_COMPLETION_RING, XDP_RX_RING, XDP_TX_RING}) {
+    if (::setsockopt(this->sd_, SOL_XDP, option, &ringSize, sizeof(ringSize)) < 0) {
+      return this->fail();
+    }
+  }
+
+  xdp_mmap_offsets offsets{};
+  socklen_t length = sizeof(offsets);
+  if (::getsockopt(this->sd_, SOL_XDP, XDP_MMAP_OFFSETS, &offsets, &length) < 0 ||
+      !this->map_ring(this->fill_, offsets.fr, sizeof(std::uint64_t), XDP_UMEM_PGOFF_FILL_RING) ||
+      !this->map_ring(this->completion_, offsets.cr, sizeof(std::uint64_t), XDP_UMEM_PGOFF_COMPLETION_RING) ||
+      !this->map_ring(this->rx_, offsets.rx, sizeof(xdp_desc), XDP_PGOFF_RX_RING) ||
+      !this->map_ring(this->tx_, offsets.tx, sizeof(xdp_desc), XDP_PGOFF_TX_RING)) {
+    return this->fail();
+  }
+  // Both producer rings start empty, the kernel owns every fill and completion slot
+  this->fill_.cached = *this->fill_.producer;
+  this->completion_.cached = *this->completion_.consumer;
+  this->rx_.cached = *this->rx_.consumer;
+  this->tx_.cached = *this->tx_.producer;
+
+  // Frames are handed out from the back, keep the lowest addresses for the fill ring
+  this->freeFrames_.clear();
+  this->freeFrames_.reserve(iConfig.frame_count);
+  for (std::uint32_t frame = iConfig.frame_count; frame > 0; --frame) {
+    this->freeFrames_.push_back(static_cast<std::uint64_t>(frame - 1) * iConfig.frame_size);
+  }
+  this->refill(std::min<std::size_t>(iConfig.ring_size, iConfig.frame_count / 2));
+
+  if (iConfig.busy_poll_us > 0) {
+    const int prefer = 1;
+    if (::setsockopt(this->sd_, SOL_SOCKET, SO_PREFER_BUSY_POLL, &prefer, sizeof(prefer)) < 0 ||
+        ::setsockopt(this->sd_, SOL_SOCKET, SO_BUSY_POLL, &iConfig.busy_poll_us, sizeof(iConfig.busy_poll_us)) < 0 ||
+        ::setsockopt(this->sd_, SOL_SOCKET, SO_BUSY_POLL_BUDGET, &iConfig.busy_poll_budget,
+                     sizeof(iConfig.busy_poll_budget)) < 0) {
+      return this->fail();
+    }
+  }
+
+  bool bound = false;
+  if (iConfig.mode == XDP_MODE_AUTO) {
+    bound = this->bind(XDP_MODE_ZEROCOPY) || this->bind(XDP_MODE_COPY);
+  } else {
+    bound = this->bind(iConfig.mode);
+  }
+  return bound ? true : this->fail();
+}
+
+/**
+ * @brief Unmaps the rings and the UMEM and closes the descriptor
+ */
+void XdpSocket::close(void) {
+  for (xdp_ring_t* ring : {&this->fill_, &this->completion_, &this->rx_, &this->tx_}) {
+    if (ring->map != nullptr) {
+      ::munmap(ring->map, ring->map_size);
+    }
+    *ring = xdp_ring_t();
+  }
+  if (this->sd_ >= 0) {
+    ::close(this->sd_);
+    this->sd_ = -1;
+  }
+  if (this->umem_ != nullptr) {
+    ::munmap(this->umem_, this->umemSize_);
+    this->umem_ = nullptr;
+    this->umemSize_ = 0;
+  }
+  this->freeFrames_.clear();
+  this->mode_ = XDP_MODE_AUTO;
+}
+
+/**
+ * @brief Takes up to iMax received packets from the RX ring
+ * 
+ * @param oPackets
+ * @param iMax
+ * 
+ * @return
+ */
+std::size_t XdpSocket::receive(xdp_packet_t* oPackets, const std::size_t& iMax) {
+  if (!this->is_open()) {
+    return 0;
+  }
+  const std::uint32_t available = __atomic_load_n(this->rx_.producer, __ATOMIC_ACQUIRE) - this->rx_.cached;
+  const std::uint32_t count = static_cast<std::uint32_t>(std::min<std::size_t>(available, iMax));
+  if (count == 0) {
+    // Busy polling and an exhausted fill ring both need a syscall to make progress
+    if (this->config_.busy_poll_us > 0 || (this->config_.need_wakeup &&
+        (__atomic_load_n(this->fill_.flags, __ATOMIC_RELAXED) & XDP_RING_NEED_WAKEUP))) {
+      ++this->wakeups_;
+      ::recvfrom(this->sd_, nullptr, 0, MSG_DONTWAIT, nullptr, nullptr);
+    }
+    return 0;
+  }
+  const xdp_desc* descs = static_cast<const xdp_desc*>(this->rx_.entries);
+  for (std::uint32_t i = 0; i < count; ++i) {
+    const xdp_desc& desc = descs[(this->rx_.cached + i) & this->rx_.mask];
+    oPackets[i].data = this->umem_ + desc.addr;
+    oPackets[i].size = desc.len;
+    oPackets[i].addr = desc.addr;
+  }
+  this->rx_.cached += count;
+  __atomic_store_n(this->rx_.consumer, this->rx_.cached, __ATOMIC_RELEASE);
+  this->rxPackets_ += count;
+  return count;
+}
+
+/**
+ * @brief Hands received frames back to the kernel through the fill ring
+ * 
+ * @param iPackets
+ * @param iCount
+ */
+void XdpSocket::release(const xdp_packet_t* iPackets, const std::size_t& iCount) {
+  const std::uint64_t frameMask = ~static_cast<std::uint64_t>(this->config_.frame_size - 1);
+  for (std::size_t i = 0; i < iCount; ++i) {
+    this->freeFrames_.push_back(iPackets[i].addr & frameMask);
+  }
+  this->refill(iCount);
+}
+
+/**
+ * @brief Takes up to iMax free frames to be filled in place and passed to submit()
+ * 
+ * @param oPackets
+ * @param iMax
+ * 
+ * @return
+ */
+std::size_t XdpSocket::acquire(xdp_packet_t* oPackets, const std::size_t& iMax) {
+  if (!this->is_open()) {
+    return 0;
+  }
+  if (this->freeFrames_.size() < iMax) {
+    this->complete();
+  }
+  const std::size_t count = std::min(iMax, this->freeFrames_.size());
+  for (std::size_t i = 0; i < count; ++i) {
+    oPackets[i].addr = this->freeFrames_.back();
+    oPackets[i].data = this->umem_ + oPackets[i].addr;
+    oPackets[i].size = this->config_.frame_size;
+    this->freeFrames_.pop_back();
+  }
+  return count;
+}
+
+/**
+ * @brief Posts acquired frames on the TX ring and kicks the kernel when it asks for it
+ * 
+ * @param iPackets
+ * @param iCount
+ * 
+ * @return
+ */
+std::size_t XdpSocket::submit(const xdp_packet_t* iPackets, const std::size_t& iCount) {
+  if (!this->is_open()) {
+    return 0;
+  }
+  const std::uint32_t used = this->tx_.cached - __atomic_load_n(this->tx_.consumer, __ATOMIC_ACQUIRE);
+  const std::size_t count = std::min<std::size_t>(iCount, this->tx_.size - used);
+  xdp_desc* descs = static_cast<xdp_desc*>(this->tx_.entries);
+  for (std::size_t i = 0; i < count; ++i) {
+    xdp_desc& desc = descs[(this->tx_.cached + i) & this->tx_.mask];
+    desc.addr = iPackets[i].addr;
+    desc.len = iPackets[i].size;
+    desc.options = 0;
+  }
+  for (std::size_t i = count; i < iCount; ++i) {
+    this->freeFrames_.push_back(iPackets[i].addr);
+  }
+  if (count == 0) {
+    return 0;
+  }
+  this->tx_.cached += static_cast<std::uint32_t>(count);
+  __atomic_store_n(this->tx_.producer, this->tx_.cached, __ATOMIC_RELEASE);
+  if (!this->config_.need_wakeup || (__atomic_load_n(this->tx_.flags, __ATOMIC_RELAXED) & XDP_RING_NEED_WAKEUP)) {
+    this->wakeup();
+  }
+  return count;
+}
+
+/**
+ * @brief Copies every buffer into its own frame and submits them
+ * 
+ * @param iPackets
+ * @param iCount
+ * 
+ * @return
+ */
+std::size_t XdpSocket::send(const iovec* iPackets, const std::size_t& iCount) {
+  std::size_t fitting = 0;
+  while (fitting < iCount && iPackets[fitting].iov_len <= this->config_.frame_size) {
+    ++fitting;
+  }
+  std::vector<xdp_packet_t> frames(fitting);
+  const std::size_t count = this->acquire(frames.data(), fitting);
+  for (std::size_t i = 0; i < count; ++i) {
+    std::memcpy(frames[i].data, iPackets[i].iov_base, iPackets[i].iov_len);
+    frames[i].size = static_cast<std::uint32_t>(iPackets[i].iov_len);
+  }
+  if (fitting < iCount && count == fitting) {
+    errno = EMSGSIZE;
+  } else if (count < fitting) {
+    errno = ENOBUFS;
+  }
+  return this->submit(frames.data(), count);
+}
+
+/**
+ * @brief Reaps the completion ring, returning sent frames to the free list
+ * 
+ * @return
+ */
+std::size_t XdpSocket::complete(void) {
+  if (!this->is_open()) {
+    return 0;
+  }
+  const std::uint32_t count = __atomic_load_n(this->completion_.producer, __ATOMIC_ACQUIRE) - this->completion_.cached;
+  const std::uint64_t* addrs = static_cast<const std::uint64_t*>(this->completion_.entries);
+  for (std::uint32_t i = 0; i < count; ++i) {
+    this->freeFrames_.push_back(addrs[(this->completion_.cached + i) & this->completion_.mask]);
+  }
+  this->completion_.cached += count;
+  __atomic_store_n(this->completion_.consumer, this->completion_.cached, __ATOMIC_RELEASE);
+  this->txPackets_ += count;
+  return count;
+}
+
+/**
+ * @brief Asks the kernel to process the TX ring and refill RX
+ * 
+ * @return
+ */
+bool XdpSocket::wakeup(void) {
+  ++this->wakeups_;
+  if (::sendto(this->sd_, nullptr, 0, MSG_DONTWAIT, nullptr, 0) >= 0) {
+    return true;
+  }
+  return errno == EAGAIN || errno == EBUSY || errno == ENOBUFS || errno == ENETDOWN;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+/**
+ * @brief
+ * 
+ * @return
+ */
+bool XdpSocket::is_open(void) const {
+  return this->sd_ >= 0;
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+const sd_t& XdpSocket::get_sd(void) const {
+  return this->sd_;
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+const xdp_config_t& XdpSocket::get_config(void) const {
+  return this->config_;
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+const xdp_mode_e& XdpSocket::get_mode(void) const {
+  return this->mode_;
+}
+
+/**
+ * @brief
+ * 
+ * @return
+ */
+std::size_t XdpSocket::get_free_frames(void) const {
+  return this->freeFrames_.size();
+}
+
+/**
+ * @brief Local counters merged with XDP_STATISTICS
+ * 
+ * @return
+ */
+xdp_stats_t XdpSocket::get_stats(void) const {
+  xdp_stats_t stats;
+  stats.rx_packets = this->rxPackets_;
+  stats.tx_packets = this->txPackets_;
+  stats.wakeups = this->wakeups_;
+  xdp_statistics kernel{};
+  socklen_t length = sizeof(kernel);
+  if (this->is_open() && ::getsockopt(this->sd_, SOL_XDP, XDP_STATISTICS, &kernel, &length) == 0) {
+    stats.rx_dropped = kernel.rx_dropped;
+    stats.rx_ring_full = kernel.rx_ring_full;
+    stats.fill_ring_empty = kernel.rx_fill_ring_empty_descs;
+    stats.rx_invalid = kernel.rx_invalid_descs;
+    stats.tx_invalid = kernel.tx_invalid_descs;
+    stats.tx_ring_empty = kernel.tx_ring_empty_descs;
+  }
+  return stats;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+/**
+ * @brief Destructor
+ */
+XdpSocket::~XdpSocket() {
+  this->close();
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PROTECTED METHODS **/
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PRIVATE METHODS **/
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Binds with a single mode
+ * 
+ * @param iMode
+ * 
+ * @return
+ */
+bool XdpSocket::bind(const xdp_mode_e& iMode) {
+  sockaddr_xdp address{};
+  address.sxdp_family = addr::NET_ADDR_FAM_XDP;
+  address.sxdp_ifindex = static_cast<std::uint32_t>(this->config_.ifindex);
+  address.sxdp_queue_id = this->config_.queue;
+  address.sxdp_flags = (iMode == XDP_MODE_ZEROCOPY) ? XDP_ZEROCOPY : XDP_COPY;
+  if (this->config_.need_wakeup) {
+    address.sxdp_flags |= XDP_USE_NEED_WAKEUP;
+  }
+  if (::bind(this->sd_, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0) {
+    return false;
+  }
+  // Read back what the driver granted, older kernels lack XDP_OPTIONS and only honour explicit requests
+  xdp_options options{};
+  socklen_t length = sizeof(options);
+  if (::getsockopt(this->sd_, SOL_XDP, XDP_OPTIONS, &options, &length) == 0) {
+    this->mode_ = (options.flags & XDP_OPTIONS_ZEROCOPY) ? XDP_MODE_ZEROCOPY : XDP_MODE_COPY;
+  } else {
+    this->mode_ = iMode;
+  }
+  return true;
+}
+
+/**
+ * @brief Closes everything opened so far keeping the errno of the failed step
+ * 
+ * @return Always false
+ */
+bool XdpSocket::fail(void) {
+  const int error = errno;
+  this->close();
+  errno = error;
+  return false;
+}
+
+/**
+ * @brief Maps one ring
+ * 
+ * @param oRing
+ * @param iOffsets
+ * @param iEntrySize
+ * @param iPageOffset
+ * 
+ * @return
+ */
+bool XdpSocket::map_ring(xdp_ring_t& oRing, const xdp_ring_offset& iOffsets, const std::size_t& iEntrySize,
+                         const std::uint64_t& iPageOffset) {
+  const std::size_t size = iOffsets.desc + this->config_.ring_size * iEntrySize;
+  void* map = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, this->sd_,
+                     static_cast<off_t>(iPageOffset));
+  if (map == MAP_FAILED) {
+    return false;
+  }
+  std::uint8_t* base = static_cast<std::uint8_t*>(map);
+  oRing.map = map;
+  oRing.map_size = size;
+  oRing.producer = reinterpret_cast<std::uint32_t*>(base + iOffsets.producer);
+  oRing.consumer = reinterpret_cast<std::uint32_t*>(base + iOffsets.consumer);
+  oRing.flags = reinterpret_cast<std::uint32_t*>(base + iOffsets.flags);
+  oRing.entries = base + iOffsets.desc;
+  oRing.size = this->config_.ring_size;
+  oRing.mask = this->config_.ring_size - 1;
+  return true;
+}
+
+/**
+ * @brief Pushes frames from the free list to the fill ring
+ * 
+ * @param iCount
+ * 
+ * @return
+ */
+std::size_t XdpSocket::refill(const std::size_t& iCount) {
+  const std::uint32_t used = this->fill_.cached - __atomic_load_n(this->fill_.consumer, __ATOMIC_ACQUIRE);
+  const std::size_t count = std::min({iCount, this->freeFrames_.size(), static_cast<std::size_t>(this->fill_.size - used)});
+  std::uint64_t* addrs = static_cast<std::uint64_t*>(this->fill_.entries);
+  for (std::size_t i = 0; i < count; ++i) {
+    addrs[(this->fill_.cached + i) & this->fill_.mask] = this->freeFrames_.back();
+    this->freeFrames_.pop_back();
+  }
+  if (count > 0) {
+    this->fill_.cached += static_cast<std::uint32_t>(count);
+    __atomic_store_n(this->fill_.producer, this->fill_.cached, __ATOMIC_RELEASE);
+  }
+  return count;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+} // namespace sock
+} // namespace ncs
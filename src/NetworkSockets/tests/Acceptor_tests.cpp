@@ -0,0 +1,223 @@
+/**
+ * @copyright Copyright (c) 2023
+ * 
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ * 
+ * @file Acceptor_tests.cpp
+ * 
+ * @brief
+ */
+
+
+#include <Acceptor.h>
+#include <SocketTest.h>
+
+#include <gtest/gtest.h>
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <vector>
+
+
+namespace ncs::sock {
+namespace tests {
+
+
+/**
+ * Acceptor test constants
+ */
+constexpr std::size_t TEST_CLIENTS = 10;
+
+/**
+ * @brief Connects iCount clients to iAddr, they wait in the accept queue until drained
+ * 
+ * @param iAddr
+ * @param iCount
+ * 
+ * @return
+ */
+static std::vector<InternetSocket> connect_clients(const addr::InternetAddress& iAddr, const std::size_t& iCount) {
+  std::vector<InternetSocket> clients(iCount);
+  for (InternetSocket& client : clients) {
+    EXPECT_TRUE(client.connect(iAddr));
+  }
+  return clients;
+}
+
+/**
+ * @brief
+ * 
+ * @param ioClients
+ */
+static void close_clients(std::vector<InternetSocket>& ioClients) {
+  for (InternetSocket& client : ioClients) {
+    client.close();
+  }
+}
+
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Acceptor_Drains_In_Batches) {
+  EventLoop loop;
+  metrics::AcceptMetrics metrics;
+  acceptor_config_t config;
+  config.budget = 4;
+  Acceptor acceptor(loop, config);
+  acceptor.set_metrics(&metrics);
+  std::vector<InternetSocket> accepted;
+  ASSERT_TRUE(acceptor.listen({"127.0.0.1", addr::RANDOM_PORT}, [&accepted](InternetSocket&& ioClient) {
+    accepted.push_back(std::move(ioClient));
+  }));
+  std::vector<InternetSocket> clients = connect_clients(acceptor.get_listener().get_addr(), TEST_CLIENTS);
+
+  EXPECT_EQ(loop.run_once(1000), 1u);
+  EXPECT_EQ(accepted.size(), 4u);
+  while (accepted.size() < TEST_CLIENTS) {
+    ASSERT_EQ(loop.run_once(1000), 1u);
+  }
+  EXPECT_NE(fcntl(accepted.front().get_sd(), F_GETFL) & O_NONBLOCK, 0);
+
+  const metrics::accept_snapshot_t snapshot = metrics.snapshot();
+  EXPECT_EQ(snapshot.accepted, TEST_CLIENTS);
+  EXPECT_EQ(snapshot.batches, 3u);
+  EXPECT_EQ(snapshot.budget_exhausted, 2u);
+  EXPECT_EQ(snapshot.queue_peak, TEST_CLIENTS);
+  EXPECT_EQ(snapshot.accept_latency.get_count(), TEST_CLIENTS);
+  EXPECT_EQ(snapshot.errors, 0u);
+
+  close_clients(accepted);
+  close_clients(clients);
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Acceptor_Sheds_When_Out_Of_Descriptors) {
+  EventLoop loop;
+  metrics::AcceptMetrics metrics;
+  Acceptor acceptor(loop);
+  acceptor.set_metrics(&metrics);
+  std::size_t accepted = 0;
+  ASSERT_TRUE(acceptor.listen({"127.0.0.1", addr::RANDOM_PORT}, [&accepted](InternetSocket&&) {
+    ++accepted;
+  }));
+  std::vector<InternetSocket> clients = connect_clients(acceptor.get_listener().get_addr(), 3);
+
+  // Use up every descriptor below a lowered limit
+  rlimit original{};
+  ASSERT_EQ(getrlimit(RLIMIT_NOFILE, &original), 0);
+  rlimit lowered = original;
+  lowered.rlim_cur = 256;
+  ASSERT_EQ(setrlimit(RLIMIT_NOFILE, &lowered), 0);
+  std::vector<int> filler;
+  const sd_t source = clients.front().get_sd();
+  for (int sd = dup(source); sd >= 0; sd = dup(source)) {
+    filler.push_back(sd);
+  }
+  EXPECT_EQ(errno, EMFILE);
+
+  EXPECT_EQ(acceptor.drain(), 0u);
+
+  for (int sd : filler) {
+    close(sd);
+  }
+  ASSERT_EQ(setrlimit(RLIMIT_NOFILE, &original), 0);
+
+  EXPECT_EQ(accepted, 0u);
+  const metrics::accept_snapshot_t snapshot = metrics.snapshot();
+  EXPECT_EQ(snapshot.shed, 3u);
+  EXPECT_GE(snapshot.descriptor_errors, 3u);
+  char byte = 0;
+  for (const InternetSocket& client : clients) {
+    EXPECT_EQ(client.recv(&byte, sizeof(byte)), 0);
+  }
+
+  // The spare descriptor is back, new connections are accepted again
+  std::vector<InternetSocket> late = connect_clients(acceptor.get_listener().get_addr(), 1);
+  EXPECT_EQ(loop.run_once(1000), 1u);
+  EXPECT_EQ(accepted, 1u);
+  close_clients(late);
+  close_clients(clients);
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Acceptor_Rate_Limits_Sources) {
+  EventLoop loop;
+  metrics::AcceptMetrics metrics;
+  rate_limit_config_t limits;
+  limits.rate = 1;
+  limits.burst = 3;
+  RateLimiter limiter(limits);
+  acceptor_config_t config;
+  config.limiter = &limiter;
+  Acceptor acceptor(loop, config);
+  acceptor.set_metrics(&metrics);
+  std::vector<InternetSocket> accepted;
+  ASSERT_TRUE(acceptor.listen({"127.0.0.1", addr::RANDOM_PORT}, [&accepted](InternetSocket&& ioClient) {
+    accepted.push_back(std::move(ioClient));
+  }));
+  std::vector<InternetSocket> clients = connect_clients(acceptor.get_listener().get_addr(), TEST_CLIENTS);
+  InternetSocket other;
+  ASSERT_TRUE(other.bind({"127.0.0.2", addr::RANDOM_PORT}));
+  ASSERT_TRUE(other.connect(acceptor.get_listener().get_addr()));
+
+  EXPECT_EQ(loop.run_once(1000), 1u);
+  ASSERT_EQ(accepted.size(), 4u);
+  EXPECT_EQ(accepted.back().get_addr().get_ip(), "127.0.0.2");
+  const metrics::accept_snapshot_t snapshot = metrics.snapshot();
+  EXPECT_EQ(snapshot.accepted, 4u);
+  EXPECT_EQ(snapshot.rate_limited, TEST_CLIENTS - 3);
+  EXPECT_EQ(snapshot.errors, 0u);
+
+  // Refused connections are reset
+  char byte = 0;
+  EXPECT_LT(clients.back().recv(&byte, sizeof(byte)), 0);
+  EXPECT_EQ(errno, ECONNRESET);
+
+  other.close();
+  close_clients(accepted);
+  close_clients(clients);
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Acceptor_Shares_A_Listener) {
+  ASSERT_TRUE(listener_.bind({"127.0.0.1", addr::RANDOM_PORT}));
+  ASSERT_TRUE(listener_.listen());
+  EventLoop first;
+  EventLoop second;
+  std::size_t accepted = 0;
+  const accept_handler_t handler = [&accepted](InternetSocket&&) {
+    ++accepted;
+  };
+  {
+    Acceptor a(first);
+    Acceptor b(second);
+    ASSERT_TRUE(a.attach(listener_, handler));
+    ASSERT_TRUE(b.attach(listener_, handler));
+    ASSERT_TRUE(client_.connect(listener_.get_addr()));
+    (void)first.run_once(100);
+    (void)second.run_once(0);
+    EXPECT_EQ(accepted, 1u);
+  }
+
+  // Detached acceptors leave the listener open
+  EXPECT_TRUE(listener_.is_open());
+  InternetSocket other;
+  ASSERT_TRUE(other.connect(listener_.get_addr()));
+  EXPECT_TRUE(listener_.accept(server_));
+  other.close();
+}
+
+
+} // namespace tests
+} // namespace ncs::sock
@@ -0,0 +1,131 @@
+/**
+ * @copyright Copyright (c) 2023
+ * 
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ * 
+ * @file ConnectionTable_tests.cpp
+ * 
+ * @brief
+ */
+
+
+#include <ConnectionTable.h>
+#include <FixedAddress.h>
+#include <SocketTest.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+
+namespace ncs::sock {
+namespace tests {
+
+
+/**
+ * @brief Registers a connection from iIp:iPort with descriptor iSd
+ * 
+ * @param ioTable
+ * @param iSd
+ * @param iIp
+ * @param iPort
+ * @param iNowNs
+ * 
+ * @return
+ */
+static connection_handle_t insert_peer(ConnectionTable& ioTable, const sd_t& iSd, const addr::ip_t& iIp,
+                                       const addr::port_t& iPort, const std::uint64_t& iNowNs = 0) {
+  addr::inet_address_t peer;
+  socklen_t size = 0;
+  EXPECT_TRUE(addr::to_inet_address({iIp, iPort}, peer));
+  return ioTable.insert(iSd, addr::get_sockaddr(peer, size), size, iNowNs);
+}
+
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Connection_Table_Handles) {
+  ConnectionTable table;
+  const connection_handle_t a = insert_peer(table, 10, "192.0.2.1", 40000);
+  const connection_handle_t b = insert_peer(table, 11, "2001:db8::1", 40001);
+  const connection_handle_t c = insert_peer(table, 12, "192.0.2.1", 40002);
+  ASSERT_NE(a, INVALID_CONNECTION_HANDLE);
+  ASSERT_NE(b, INVALID_CONNECTION_HANDLE);
+  ASSERT_NE(c, INVALID_CONNECTION_HANDLE);
+  EXPECT_EQ(table.get_size(), 3u);
+  EXPECT_EQ(table.get_pool().get_size(), 2u);
+
+  addr::InternetAddress peer;
+  ASSERT_TRUE(table.get_peer(b, peer));
+  EXPECT_EQ(peer, addr::InternetAddress("2001:db8::1", 40001));
+
+  // Erasing moves the last row into the hole, the other handles follow it
+  EXPECT_TRUE(table.erase(a));
+  EXPECT_FALSE(table.erase(a));
+  EXPECT_EQ(table.get_row(a), NO_ROW);
+  EXPECT_EQ(table.get_size(), 2u);
+  ASSERT_NE(table.get_row(c), NO_ROW);
+  EXPECT_EQ(table.get_sds()[table.get_row(c)], 12);
+  ASSERT_TRUE(table.get_peer(c, peer));
+  EXPECT_EQ(peer, addr::InternetAddress("192.0.2.1", 40002));
+
+  // The slot is reused under a new generation, the old handle stays stale
+  const connection_handle_t d = insert_peer(table, 13, "192.0.2.9", 40003);
+  EXPECT_EQ(d & 0xffffffffu, a & 0xffffffffu);
+  EXPECT_NE(d, a);
+  EXPECT_FALSE(table.touch(a, 1));
+  EXPECT_TRUE(table.touch(d, 1));
+  EXPECT_EQ(table.get_sds()[table.get_row(d)], 13);
+
+  EXPECT_TRUE(table.erase(b));
+  EXPECT_TRUE(table.erase(c));
+  EXPECT_TRUE(table.erase(d));
+  EXPECT_EQ(table.get_size(), 0u);
+  EXPECT_EQ(table.get_pool().get_size(), 0u);
+
+  sockaddr unix_addr{};
+  unix_addr.sa_family = AF_UNIX;
+  EXPECT_EQ(table.insert(14, &unix_addr, sizeof(unix_addr), 0), INVALID_CONNECTION_HANDLE);
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Connection_Table_Sweeps) {
+  ConnectionTable table;
+  std::vector<connection_handle_t> handles;
+  for (int i = 0; i < 100; ++i) {
+    handles.push_back(insert_peer(table, i, "10.0.0." + std::to_string(i % 8), 2000 + i, 1000));
+  }
+  for (int i = 0; i < 100; i += 10) {
+    EXPECT_TRUE(table.touch(handles[i], 5000, 100, 10));
+  }
+
+  std::vector<connection_handle_t> idle;
+  EXPECT_EQ(table.sweep_idle(5500, 1000, idle), 90u);
+  ASSERT_EQ(idle.size(), 90u);
+  for (int i = 0; i < 100; ++i) {
+    const bool found = std::find(idle.begin(), idle.end(), handles[i]) != idle.end();
+    EXPECT_EQ(found, (i % 10) != 0) << i;
+  }
+  EXPECT_EQ(table.sweep_idle(1500, 1000, idle), 0u);
+  EXPECT_TRUE(idle.empty());
+
+  EXPECT_TRUE(table.set_state(handles[1], CONNECTION_CLOSING));
+  EXPECT_EQ(table.mark_all(CONNECTION_DRAINING), 99u);
+  const connection_totals_t totals = table.aggregate();
+  EXPECT_EQ(totals.connections, 100u);
+  EXPECT_EQ(totals.states[CONNECTION_OPEN], 0u);
+  EXPECT_EQ(totals.states[CONNECTION_DRAINING], 99u);
+  EXPECT_EQ(totals.states[CONNECTION_CLOSING], 1u);
+  EXPECT_EQ(totals.bytes_in, 1000u);
+  EXPECT_EQ(totals.bytes_out, 100u);
+}
+
+
+} // namespace tests
+} // namespace ncs::sock
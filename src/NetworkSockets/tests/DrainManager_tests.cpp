@@ -0,0 +1,166 @@
+/**
+ * @copyright Copyright (c) 2023
+ * 
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ * 
+ * @file DrainManager_tests.cpp
+ * 
+ * @brief
+ */
+
+
+#include <DrainManager.h>
+#include <SocketTest.h>
+
+#include <gtest/gtest.h>
+
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+namespace ncs::sock {
+namespace tests {
+
+
+/**
+ * @brief Server loop on its own thread, every accepted connection is sent iPayload bytes and tracked by the drain
+ */
+struct drain_server_t {
+  drain_server_t(DrainManager& ioManager, const std::size_t& iPayload) : acceptor(loop), manager(ioManager) {
+    index = manager.add_loop(loop);
+    manager.add_acceptor(index, acceptor);
+    listening = acceptor.listen({"127.0.0.1", addr::RANDOM_PORT}, [this, iPayload](InternetSocket&& ioClient) {
+      sessions.emplace_back(std::make_unique<session_t>());
+      session_t& session = *sessions.back();
+      session.socket = std::move(ioClient);
+      session.writes = std::make_unique<WriteBatcher>(session.socket);
+      (void)session.writes->write(std::vector<std::uint8_t>(iPayload, 'x'));
+      (void)session.writes->flush();
+      (void)loop.add(session.socket.get_sd(), EPOLLIN, [](const std::uint32_t&) {});
+      manager.track(index, session.socket, session.writes.get());
+      ++accepted;
+    });
+    thread = std::thread([this]() {
+      loop.run();
+    });
+  }
+
+  ~drain_server_t() {
+    loop.stop();
+    thread.join();
+  }
+
+  struct session_t {
+    InternetSocket socket;
+    std::unique_ptr<WriteBatcher> writes;
+  };
+
+  EventLoop loop;
+  Acceptor acceptor;
+  DrainManager& manager;
+  std::size_t index = 0;
+  bool listening = false;
+  std::atomic<std::size_t> accepted{0};
+  std::vector<std::unique_ptr<session_t>> sessions;
+  std::thread thread;
+};
+
+/**
+ * @brief Waits up to a second for ioServer to accept iCount connections
+ * 
+ * @param iServer
+ * @param iCount
+ * 
+ * @return
+ */
+static bool wait_accepted(const drain_server_t& iServer, const std::size_t& iCount) {
+  for (int i = 0; (i < 1000) && (iServer.accepted.load() < iCount); ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return iServer.accepted.load() == iCount;
+}
+
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Drain_Flushes_And_Closes) {
+  constexpr std::size_t payload = 4 << 20;
+  DrainManager manager;
+  drain_server_t first(manager, payload);
+  drain_server_t second(manager, payload);
+  ASSERT_TRUE(first.listening && second.listening);
+  InternetSocket clients[2];
+  ASSERT_TRUE(clients[0].connect(first.acceptor.get_listener().get_addr()));
+  ASSERT_TRUE(clients[1].connect(second.acceptor.get_listener().get_addr()));
+  ASSERT_TRUE(wait_accepted(first, 1) && wait_accepted(second, 1));
+
+  ASSERT_TRUE(manager.drain());
+  EXPECT_FALSE(manager.drain());
+  EXPECT_FALSE(manager.wait(std::chrono::milliseconds(20)));
+  // Every queued byte arrives before the end of the stream, then closing our side lets the server close
+  for (InternetSocket& client : clients) {
+    EXPECT_EQ(receive_exactly(client, payload).size(), payload);
+    char byte = 0;
+    EXPECT_EQ(client.recv(&byte, 1), 0);
+    client.close();
+  }
+  ASSERT_TRUE(manager.wait(std::chrono::milliseconds(2000)));
+
+  const drain_progress_t progress = manager.get_progress();
+  EXPECT_TRUE(progress.done);
+  EXPECT_EQ(progress.loops_done, 2u);
+  EXPECT_EQ(progress.connections, 2u);
+  EXPECT_EQ(progress.flushed, 2u);
+  EXPECT_EQ(progress.half_closed, 2u);
+  EXPECT_EQ(progress.closed, 2u);
+  EXPECT_EQ(progress.expired, 0u);
+  EXPECT_EQ(first.sessions[0]->socket.get_sd(), -1);
+  EXPECT_FALSE(first.acceptor.is_listening());
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Drain_Resets_At_Deadline) {
+  drain_config_t config;
+  config.deadline = std::chrono::milliseconds(100);
+  DrainManager manager(config);
+  drain_server_t server(manager, 4 << 20);
+  ASSERT_TRUE(server.listening);
+  InternetSocket client;
+  ASSERT_TRUE(client.connect(server.acceptor.get_listener().get_addr()));
+  ASSERT_TRUE(wait_accepted(server, 1));
+
+  // The client never reads, the queued bytes can't leave before the deadline
+  ASSERT_TRUE(manager.drain());
+  ASSERT_TRUE(manager.wait(std::chrono::milliseconds(2000)));
+  const drain_progress_t progress = manager.get_progress();
+  EXPECT_EQ(progress.connections, 1u);
+  EXPECT_EQ(progress.half_closed, 0u);
+  EXPECT_EQ(progress.expired, 1u);
+  EXPECT_FALSE(server.sessions[0]->writes->has_pending());
+
+  const timeval timeout = {2, 0};
+  ASSERT_EQ(setsockopt(client.get_sd(), SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)), 0);
+  char buffer[65536];
+  ssize_t got = 0;
+  do {
+    got = client.recv(buffer, sizeof(buffer));
+  } while (got > 0);
+  EXPECT_EQ(got, -1);
+  EXPECT_EQ(errno, ECONNRESET);
+}
+
+
+} // namespace tests
+} // namespace ncs::sock
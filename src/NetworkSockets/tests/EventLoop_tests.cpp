@@ -0,0 +1,206 @@
+/**
+ * @copyright Copyright (c) 2023
+ * 
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ * 
+ * @file EventLoop_tests.cpp
+ * 
+ * @brief
+ */
+
+
+#include <SocketOptions.h>
+#include <SocketTest.h>
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <chrono>
+#include <thread>
+
+
+namespace ncs::sock {
+namespace tests {
+
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Dispatch_Readable_Event) {
+  connect_pair();
+  EventLoop loop;
+  std::uint32_t received = 0;
+  ASSERT_TRUE(loop.add(server_.get_sd(), EPOLLIN, [&](const std::uint32_t& iEvents) { received = iEvents; }));
+  EXPECT_EQ(loop.get_watched_count(), 1u);
+
+  EXPECT_EQ(loop.run_once(0), 0u);
+  ASSERT_EQ(client_.send("x", 1), 1);
+  EXPECT_EQ(loop.run_once(1000), 1u);
+  EXPECT_TRUE(received & EPOLLIN);
+  EXPECT_EQ(loop.get_iteration(), 2u);
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Handler_Removes_Itself) {
+  connect_pair();
+  EventLoop loop;
+  int calls = 0;
+  ASSERT_TRUE(loop.add(server_.get_sd(), EPOLLIN, [&](const std::uint32_t&) {
+    ++calls;
+    loop.remove(server_.get_sd());
+  }));
+  ASSERT_EQ(client_.send("x", 1), 1);
+  loop.run_once(1000);
+  loop.run_once(0);
+  EXPECT_EQ(calls, 1);
+  EXPECT_EQ(loop.get_watched_count(), 0u);
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Deferred_Tasks_Run_At_Iteration_End) {
+  EventLoop loop;
+  std::vector<int> order;
+  loop.defer([&]() {
+    order.push_back(1);
+    loop.defer([&]() { order.push_back(3); });  // Belongs to the next iteration
+  });
+  const task_id_t cancelled = loop.defer([&]() { order.push_back(-1); });
+  loop.defer([&]() { order.push_back(2); });
+  loop.cancel(cancelled);
+
+  loop.run_once(1000);  // Must not block, tasks are pending
+  EXPECT_EQ(order, (std::vector<int>{1, 2}));
+  loop.run_once(1000);
+  EXPECT_EQ(order, (std::vector<int>{1, 2, 3}));
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Timers_Fire_In_Deadline_Order) {
+  EventLoop loop;
+  std::vector<int> order;
+  const loop_clock_t::time_point now = loop_clock_t::now();
+  loop.schedule(now + std::chrono::milliseconds(20), [&]() { order.push_back(2); });
+  loop.schedule(now + std::chrono::milliseconds(5), [&]() { order.push_back(1); });
+  const task_id_t cancelled = loop.schedule(now + std::chrono::milliseconds(10), [&]() { order.push_back(-1); });
+  loop.cancel(cancelled);
+
+  while (order.size() < 2) {
+    loop.run_once();
+  }
+  EXPECT_EQ(order, (std::vector<int>{1, 2}));
+  EXPECT_GE(loop_clock_t::now() - now, std::chrono::milliseconds(20));
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Stop_From_Another_Thread) {
+  EventLoop loop;
+  std::thread stopper([&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    loop.stop();
+  });
+  loop.run();
+  stopper.join();
+  SUCCEED();
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Stop_Before_Run) {
+  EventLoop loop;
+  loop.stop();
+  loop.run();
+  // The stop is consumed, the next run() waits for another one
+  loop.post([&loop]() {
+    loop.stop();
+  });
+  loop.run();
+  SUCCEED();
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Post_From_Another_Thread) {
+  EventLoop loop;
+  std::thread::id ranOn;
+  std::thread poster([&]() {
+    for (int i = 0; i < 3; ++i) {
+      loop.post([&, i]() {
+        ranOn = std::this_thread::get_id();
+        if (i == 2) {
+          loop.stop();
+        }
+      });
+    }
+  });
+  loop.run();
+  poster.join();
+  EXPECT_EQ(ranOn, std::this_thread::get_id());
+}
+
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Busy_Poll_Falls_Back_When_Idle) {
+  connect_pair();
+  EventLoop loop;
+  int calls = 0;
+  ASSERT_TRUE(loop.add(server_.get_sd(), EPOLLIN, [&](const std::uint32_t&) {
+    char byte;
+    (void)server_.recv(&byte, sizeof(byte));
+    ++calls;
+  }));
+  EXPECT_FALSE(loop.is_spinning());
+
+  busy_poll_config_t config;
+  config.enabled = true;
+  config.idle_fallback = std::chrono::milliseconds(5);
+  ASSERT_TRUE(loop.set_busy_poll(config));
+  EXPECT_TRUE(loop.is_spinning());
+  if (geteuid() == 0) {
+    int busyPoll = 0;
+    EXPECT_TRUE(server_.get_option<busy_poll_t>(busyPoll));
+    EXPECT_EQ(busyPoll, DEFAULT_SOCKET_BUSY_POLL_US);
+  }
+
+  // Spinning answers right away
+  ASSERT_EQ(client_.send("x", 1), 1);
+  EXPECT_EQ(loop.run_once(1000), 1u);
+  EXPECT_TRUE(loop.is_spinning());
+
+  // A quiet period longer than the idle fallback parks the loop in a blocking wait
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_EQ(loop.run_once(50), 0u);
+  EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(50));
+  EXPECT_FALSE(loop.is_spinning());
+
+  // The next event resumes spinning
+  std::thread sender([this]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    (void)client_.send("y", 1);
+  });
+  EXPECT_EQ(loop.run_once(1000), 1u);
+  sender.join();
+  EXPECT_TRUE(loop.is_spinning());
+  EXPECT_EQ(calls, 2);
+
+  config.enabled = false;
+  ASSERT_TRUE(loop.set_busy_poll(config));
+  EXPECT_FALSE(loop.is_spinning());
+}
+
+
+} // namespace tests
+} // namespace ncs::sock
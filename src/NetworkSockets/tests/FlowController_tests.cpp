@@ -0,0 +1,130 @@
+/**
+ * @copyright Copyright (c) 2023
+ * 
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ * 
+ * @file FlowController_tests.cpp
+ * 
+ * @brief
+ */
+
+
+#include <FlowController.h>
+#include <SocketTest.h>
+#include <WriteBatcher.h>
+
+#include <gtest/gtest.h>
+
+#include <cerrno>
+
+
+namespace ncs::sock {
+namespace tests {
+
+
+/**
+ * @brief
+ */
+TEST(FlowControllerTest, Watermarks_Have_Hysteresis) {
+  FlowController flow({100, 40});
+  std::size_t highs = 0;
+  std::size_t lows = 0;
+  flow.set_high_watermark_handler([&highs](const std::size_t&) { ++highs; });
+  flow.set_low_watermark_handler([&lows](const std::size_t&) { ++lows; });
+
+  ASSERT_TRUE(flow.reserve(60));
+  EXPECT_FALSE(flow.is_saturated());
+  ASSERT_TRUE(flow.reserve(60));
+  EXPECT_TRUE(flow.is_saturated());
+  ASSERT_TRUE(flow.reserve(10));
+  EXPECT_EQ(highs, 1u);
+
+  flow.release(50);
+  EXPECT_TRUE(flow.is_saturated());
+  EXPECT_EQ(lows, 0u);
+  flow.release(50);
+  EXPECT_FALSE(flow.is_saturated());
+  EXPECT_EQ(lows, 1u);
+  EXPECT_EQ(flow.get_queued_size(), 30u);
+  EXPECT_EQ(flow.get_counters().peak, 130u);
+  EXPECT_EQ(flow.get_counters().high_crossings, 1u);
+  EXPECT_EQ(flow.get_counters().low_crossings, 1u);
+}
+
+/**
+ * @brief
+ */
+TEST(FlowControllerTest, Budget_Is_Shared_Across_Connections) {
+  FlowBudget budget(100);
+  {
+    FlowController first({1000, 0}, &budget);
+    FlowController second({1000, 0}, &budget);
+    ASSERT_TRUE(first.reserve(70));
+    EXPECT_FALSE(second.reserve(40));
+    EXPECT_EQ(second.get_counters().rejected, 1u);
+    ASSERT_TRUE(second.reserve(30));
+    EXPECT_EQ(budget.get_used(), 100u);
+    first.release(20);
+    EXPECT_EQ(budget.get_used(), 80u);
+  }
+  const flow_budget_counters_t counters = budget.get_counters();
+  EXPECT_EQ(counters.used, 0u);
+  EXPECT_EQ(counters.peak, 100u);
+  EXPECT_EQ(counters.rejected, 1u);
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Saturation_Pauses_Upstream_Reads) {
+  connect_pair();
+  EventLoop loop;
+  std::size_t reads = 0;
+  ASSERT_TRUE(loop.add(server_.get_sd(), EPOLLIN, [&reads](const std::uint32_t&) { ++reads; }));
+  ReadGate gate(loop, server_.get_sd(), EPOLLIN);
+  FlowController flow({10, 5});
+  flow.attach_upstream(gate);
+  ASSERT_EQ(client_.send("x", 1), 1);
+
+  ASSERT_TRUE(flow.reserve(10));
+  EXPECT_TRUE(gate.is_paused());
+  loop.run_once(50);
+  EXPECT_EQ(reads, 0u);
+
+  flow.release(5);
+  EXPECT_FALSE(gate.is_paused());
+  loop.run_once(1000);
+  EXPECT_EQ(reads, 1u);
+  EXPECT_EQ(gate.get_pause_count(), 1u);
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Batcher_Reports_To_Flow_Controller) {
+  connect_pair();
+  FlowBudget budget(64);
+  FlowController flow({32, 0}, &budget);
+  bool saturated = false;
+  flow.set_high_watermark_handler([&saturated](const std::size_t&) { saturated = true; });
+  flow.set_low_watermark_handler([&saturated](const std::size_t&) { saturated = false; });
+  WriteBatcher batcher(client_);
+  batcher.set_flow_controller(&flow);
+
+  ASSERT_TRUE(batcher.write(std::string(40, 'a').data(), 40));
+  EXPECT_TRUE(saturated);
+  EXPECT_FALSE(batcher.write(std::string(40, 'b').data(), 40));
+  EXPECT_EQ(errno, ENOBUFS);
+  EXPECT_EQ(batcher.get_queued_size(), 40u);
+
+  EXPECT_EQ(batcher.flush(), FLUSH_DONE);
+  EXPECT_FALSE(saturated);
+  EXPECT_EQ(flow.get_queued_size(), 0u);
+  EXPECT_EQ(budget.get_used(), 0u);
+  EXPECT_EQ(receive_exactly(server_, 40), std::string(40, 'a'));
+}
+
+
+} // namespace tests
+} // namespace ncs::sock
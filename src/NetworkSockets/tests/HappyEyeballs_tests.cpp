@@ -0,0 +1,141 @@
+/**
+ * @copyright Copyright (c) 2023
+ * 
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ * 
+ * @file HappyEyeballs_tests.cpp
+ * 
+ * @brief
+ */
+
+
+#include <HappyEyeballs.h>
+#include <SocketTest.h>
+
+#include <gtest/gtest.h>
+
+#include <cerrno>
+#include <chrono>
+
+
+namespace ncs::sock {
+namespace tests {
+
+
+/**
+ * @brief Loopback port whose SYNs are dropped: a listener that never accepts and whose queue is already full
+ * 
+ * @param oListener
+ * @param oFiller
+ * 
+ * @return
+ */
+static addr::InternetAddress blackhole(InternetSocket& oListener, InternetSocket& oFiller) {
+  EXPECT_TRUE(oListener.bind({"127.0.0.1", addr::RANDOM_PORT}));
+  EXPECT_TRUE(oListener.listen(0));
+  EXPECT_TRUE(oFiller.connect(oListener.get_addr()));
+  return oListener.get_addr();
+}
+
+/**
+ * @brief
+ * 
+ * @param iStart
+ * 
+ * @return
+ */
+static std::chrono::milliseconds elapsed(const std::chrono::steady_clock::time_point& iStart) {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - iStart);
+}
+
+
+/**
+ * @brief
+ */
+TEST(HappyEyeballsTest, Sort_Interleaves_Families) {
+  const addr::InternetAddress v4a("127.0.0.1", 1), v4b("127.0.0.2", 1), v6a("::1", 1), v6b("::2", 1);
+  const std::vector<addr::InternetAddress> candidates = {v4a, v4b, v6a, v6b};
+  EXPECT_EQ(HappyEyeballs::sort(candidates, addr::NET_ADDR_FAM_INET6),
+            (std::vector<addr::InternetAddress>{v6a, v4a, v6b, v4b}));
+  EXPECT_EQ(HappyEyeballs::sort(candidates, addr::NET_ADDR_FAM_INET6, 2),
+            (std::vector<addr::InternetAddress>{v6a, v6b, v4a, v4b}));
+  EXPECT_EQ(HappyEyeballs::sort(candidates, addr::NET_ADDR_FAM_INET),
+            (std::vector<addr::InternetAddress>{v4a, v6a, v4b, v6b}));
+  EXPECT_EQ(HappyEyeballs::sort({v4a, v4b}, addr::NET_ADDR_FAM_INET6),
+            (std::vector<addr::InternetAddress>{v4a, v4b}));
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Happy_Eyeballs_Races_Past_A_Blackhole) {
+  InternetSocket deadListener, filler, connected;
+  const addr::InternetAddress dead = blackhole(deadListener, filler);
+  ASSERT_TRUE(listener_.bind({"127.0.0.1", addr::RANDOM_PORT}));
+  ASSERT_TRUE(listener_.listen());
+
+  eyeballs_config_t config;
+  config.attempt_delay = std::chrono::milliseconds(50);
+  HappyEyeballs eyeballs(config);
+  const auto start = std::chrono::steady_clock::now();
+  ASSERT_TRUE(eyeballs.connect({dead, listener_.get_addr()}, connected));
+  EXPECT_GE(elapsed(start), config.attempt_delay);
+  EXPECT_LT(elapsed(start), std::chrono::milliseconds(1000));
+  EXPECT_EQ(eyeballs.get_attempts(), 2u);
+  EXPECT_EQ(connected.get_addr(), listener_.get_addr());
+
+  // The winner is a plain blocking connection
+  ASSERT_TRUE(listener_.accept(server_));
+  ASSERT_EQ(connected.send("eyeballs", 8), 8);
+  EXPECT_EQ(receive_exactly(server_, 8), "eyeballs");
+  connected.close();
+  filler.close();
+  deadListener.close();
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Happy_Eyeballs_Moves_On_When_Refused) {
+  InternetSocket refused, connected;
+  ASSERT_TRUE(refused.bind({"127.0.0.1", addr::RANDOM_PORT}));
+  const addr::InternetAddress closed = refused.get_addr();
+  refused.close();
+  ASSERT_TRUE(listener_.bind({"127.0.0.1", addr::RANDOM_PORT}));
+  ASSERT_TRUE(listener_.listen());
+
+  eyeballs_config_t config;
+  config.attempt_delay = std::chrono::milliseconds(2000);
+  HappyEyeballs eyeballs(config);
+  const auto start = std::chrono::steady_clock::now();
+  ASSERT_TRUE(eyeballs.connect({closed, listener_.get_addr()}, connected));
+  EXPECT_LT(elapsed(start), config.attempt_delay);
+  EXPECT_EQ(connected.get_addr(), listener_.get_addr());
+  connected.close();
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Happy_Eyeballs_Times_Out) {
+  InternetSocket deadListener, filler, connected;
+  const addr::InternetAddress dead = blackhole(deadListener, filler);
+
+  eyeballs_config_t config;
+  config.attempt_delay = std::chrono::milliseconds(20);
+  config.timeout = std::chrono::milliseconds(150);
+  HappyEyeballs eyeballs(config);
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(eyeballs.connect({dead, dead}, connected));
+  EXPECT_EQ(errno, ETIMEDOUT);
+  EXPECT_GE(elapsed(start), config.timeout);
+  EXPECT_EQ(eyeballs.get_attempts(), 2u);
+  EXPECT_FALSE(connected.is_open());
+  filler.close();
+  deadListener.close();
+}
+
+
+} // namespace tests
+} // namespace ncs::sock
@@ -0,0 +1,155 @@
+/**
+ * @copyright Copyright (c) 2023
+ * 
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ * 
+ * @file HotRestart_tests.cpp
+ * 
+ * @brief
+ */
+
+
+#include <HotRestart.h>
+#include <SocketTest.h>
+
+#include <gtest/gtest.h>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace ncs::sock {
+namespace tests {
+
+
+/**
+ * @brief Path of a Unix socket no other test uses
+ * 
+ * @param iName
+ * 
+ * @return
+ */
+static std::string handoff_path(const std::string& iName) {
+  return ::testing::TempDir() + "ncs_hot_restart_" + iName + "_" + std::to_string(getpid());
+}
+
+/**
+ * @brief Echoes one byte on iSocket
+ * 
+ * @param iSocket
+ * 
+ * @return
+ */
+static bool echo_byte(const InternetSocket& iSocket) {
+  char byte = 0;
+  return (iSocket.recv(&byte, 1) == 1) && (iSocket.send(&byte, 1) == 1);
+}
+
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Hot_Restart_Hands_Over_Sockets) {
+  connect_pair();
+  const std::string path = handoff_path("sockets");
+  const addr::InternetAddress listening = listener_.get_addr();
+  const addr::InternetAddress peer = server_.get_addr();
+  HotRestart previous;
+  ASSERT_TRUE(previous.listen(path));
+
+  const pid_t successor = fork();
+  ASSERT_GE(successor, 0);
+  if (successor == 0) {
+    // Only what comes through the handoff socket is used, not what fork(2) duplicated
+    listener_.close();
+    server_.close();
+    client_.close();
+    std::vector<InternetSocket> listeners;
+    std::vector<InternetSocket> connections;
+    HotRestart next;
+    InternetSocket accepted;
+    char byte = 0;
+    const bool taken = HotRestart::take_over(path, listeners, connections) && (listeners.size() == 1) &&
+                       (connections.size() == 1) && (listeners[0].get_addr() == listening) &&
+                       (connections[0].get_addr() == peer) && next.listen(path);
+    const bool served = taken && echo_byte(connections[0]) && listeners[0].accept(accepted) && echo_byte(accepted) &&
+                        (accepted.recv(&byte, 1) == 0);
+    _exit(served ? 0 : 1);
+  }
+
+  ASSERT_TRUE(previous.hand_over({&listener_}, {&server_}));
+  // Stops serving, the successor holds its own descriptors of both sockets
+  listener_.close();
+  server_.close();
+  char byte = 'a';
+  ASSERT_EQ(client_.send(&byte, 1), 1);
+  EXPECT_EQ(receive_exactly(client_, 1), "a");
+  InternetSocket client;
+  ASSERT_TRUE(client.connect(listening));
+  byte = 'b';
+  ASSERT_EQ(client.send(&byte, 1), 1);
+  EXPECT_EQ(receive_exactly(client, 1), "b");
+
+  // The socket file belongs to the successor by now
+  previous.close();
+  EXPECT_EQ(access(path.c_str(), F_OK), 0);
+  client.close();
+  int status = 0;
+  ASSERT_EQ(waitpid(successor, &status, 0), successor);
+  EXPECT_TRUE(WIFEXITED(status) && (WEXITSTATUS(status) == 0));
+  unlink(path.c_str());
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Hot_Restart_Fails_Cleanly) {
+  const std::string path = handoff_path("fails");
+  std::vector<InternetSocket> listeners;
+  std::vector<InternetSocket> connections;
+  EXPECT_FALSE(HotRestart::take_over(path, listeners, connections));
+  EXPECT_FALSE(HotRestart::take_over(std::string(200, 'x'), listeners, connections));
+  EXPECT_EQ(errno, ENAMETOOLONG);
+
+  HotRestart previous;
+  EXPECT_FALSE(previous.hand_over({}, {}, 10));
+  EXPECT_EQ(errno, EBADF);
+  ASSERT_TRUE(previous.listen(path));
+  EXPECT_FALSE(previous.hand_over({}, {}, 10));
+  EXPECT_EQ(errno, ETIMEDOUT);
+  previous.close();
+  EXPECT_NE(access(path.c_str(), F_OK), 0);
+
+  // A previous process speaking another version gives nothing away
+  const sd_t sd = ::socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+  sockaddr_un addr = {};
+  addr.sun_family = AF_UNIX;
+  std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+  ASSERT_EQ(::bind(sd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)), 0);
+  ASSERT_EQ(::listen(sd, 1), 0);
+  std::thread other([sd]() {
+    const sd_t peer = ::accept(sd, nullptr, nullptr);
+    const std::uint8_t header[HANDOFF_HEADER_SIZE] = {HANDOFF_MAGIC[0], HANDOFF_MAGIC[1], HANDOFF_VERSION + 1, 0};
+    (void)::send(peer, header, sizeof(header), MSG_NOSIGNAL);
+    ::close(peer);
+  });
+  EXPECT_FALSE(HotRestart::take_over(path, listeners, connections));
+  EXPECT_EQ(errno, EPROTO);
+  EXPECT_TRUE(listeners.empty() && connections.empty());
+  other.join();
+  ::close(sd);
+  unlink(path.c_str());
+}
+
+
+} // namespace tests
+} // namespace ncs::sock
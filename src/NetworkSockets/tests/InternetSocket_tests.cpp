@@ -0,0 +1,169 @@
+/**
+ * @copyright Copyright (c) 2023
+ * 
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ * 
+ * @file InternetSocket_tests.cpp
+ * 
+ * @brief
+ */
+
+
+#include <SocketTest.h>
+#include <Tracer.h>
+
+#include <gtest/gtest.h>
+
+#include <cerrno>
+#include <vector>
+
+
+namespace ncs::sock {
+namespace tests {
+
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Default_Constructor) {
+  InternetSocket socket;
+  EXPECT_FALSE(socket.is_open());
+  EXPECT_EQ   (socket.get_sd(), -1);
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Bind_Random_Port) {
+  ASSERT_TRUE(listener_.bind({"127.0.0.1", addr::RANDOM_PORT}));
+  EXPECT_TRUE(listener_.is_open());
+  EXPECT_EQ  (listener_.get_addr().get_ip(), "127.0.0.1");
+  EXPECT_GT  (listener_.get_addr().get_port(), addr::RANDOM_PORT);
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Bind_Invalid_Address) {
+  EXPECT_FALSE(listener_.bind({"not-an-ip", addr::RANDOM_PORT}));
+  EXPECT_EQ   (errno, EINVAL);
+  EXPECT_FALSE(listener_.is_open());
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Connect_Accept_Exchange) {
+  connect_pair();
+  EXPECT_EQ(server_.get_addr().get_ip(), "127.0.0.1");
+  EXPECT_EQ(client_.get_addr(), listener_.get_addr());
+
+  const std::string message = "ping";
+  ASSERT_EQ(client_.send(message.data(), message.size()), static_cast<ssize_t>(message.size()));
+  EXPECT_EQ(receive_exactly(server_, message.size()), message);
+
+  iovec iov[2] = {{const_cast<char*>("po"), 2}, {const_cast<char*>("ng"), 2}};
+  ASSERT_EQ(server_.send_v(iov, 2), 4);
+  EXPECT_EQ(receive_exactly(client_, 4), "pong");
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Ipv6_Loopback) {
+  InternetSocket probe;
+  if (!probe.bind({"::1", addr::RANDOM_PORT})) {
+    GTEST_SKIP() << "IPv6 loopback not available";
+  }
+  probe.close();
+  connect_pair("::1");
+  EXPECT_EQ(server_.get_addr().get_address_family(), addr::NET_ADDR_FAM_INET6);
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Non_Blocking_Receive) {
+  connect_pair();
+  ASSERT_TRUE(server_.set_non_blocking(true));
+  char byte;
+  EXPECT_EQ(server_.recv(&byte, 1), -1);
+  EXPECT_EQ(errno, EAGAIN);
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Close) {
+  connect_pair();
+  EXPECT_TRUE (client_.close());
+  EXPECT_FALSE(client_.is_open());
+  EXPECT_TRUE (client_.close());
+
+  char byte;
+  EXPECT_EQ(server_.recv(&byte, 1), 0);
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Move_Takes_The_Metrics) {
+  metrics::SocketMetrics metrics;
+  InternetSocket first;
+  first.set_metrics(&metrics);
+  InternetSocket second(std::move(first));
+  EXPECT_EQ(second.get_metrics(), &metrics);
+  EXPECT_EQ(first.get_metrics(), nullptr);
+
+  // A moved-from socket reopened for another connection must not report into the old counters
+  first = std::move(second);
+  EXPECT_EQ(first.get_metrics(), &metrics);
+  EXPECT_EQ(second.get_metrics(), nullptr);
+}
+
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Tracepoints) {
+#if !defined(NCS_ENABLE_TRACEPOINTS)
+  GTEST_SKIP() << "Tracepoints compiled out";
+#endif
+  static std::vector<trace::trace_event_t> events;
+  events.clear();
+  trace::Tracer::attach([](const trace::trace_event_t& iEvent) { events.push_back(iEvent); });
+  connect_pair();
+  ASSERT_EQ(client_.send("ping", 4), 4);
+  EXPECT_EQ(receive_exactly(server_, 4), "ping");
+  EXPECT_TRUE(client_.close());
+  trace::Tracer::detach();
+
+  std::vector<trace::trace_probe_e> probes;
+  for (const trace::trace_event_t& event : events) {
+    if (event.probe != trace::TRACE_ADDRESS_PARSE) {
+      probes.push_back(event.probe);
+    }
+  }
+  ASSERT_GE(probes.size(), 7u);
+  EXPECT_EQ(probes[0], trace::TRACE_SOCKET_OPEN);
+  EXPECT_EQ(probes.back(), trace::TRACE_SOCKET_CLOSE);
+  auto find = [](const trace::trace_probe_e& iProbe) {
+    for (const trace::trace_event_t& event : events) {
+      if (event.probe == iProbe) {
+        return event;
+      }
+    }
+    return trace::trace_event_t{};
+  };
+  EXPECT_EQ(find(trace::TRACE_SOCKET_SEND).size, 4);
+  EXPECT_EQ(find(trace::TRACE_SOCKET_SEND).address, &client_.get_addr());
+  EXPECT_EQ(find(trace::TRACE_SOCKET_RECV).result, 4);
+  EXPECT_EQ(find(trace::TRACE_SOCKET_CONNECT).sd, find(trace::TRACE_SOCKET_CLOSE).sd);
+  EXPECT_NE(find(trace::TRACE_SOCKET_ACCEPT).address, nullptr);
+  EXPECT_EQ(find(trace::TRACE_ADDRESS_PARSE).result, 1);
+}
+
+
+} // namespace tests
+} // namespace ncs::sock
@@ -0,0 +1,308 @@
+/**
+ * @copyright Copyright (c) 2023
+ * 
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ * 
+ * @file Multicast_tests.cpp
+ * 
+ * @brief
+ */
+
+
+#include <MulticastFanout.h>
+#include <MulticastSocket.h>
+#include <SocketTest.h>
+
+#include <gtest/gtest.h>
+
+#include <net/if.h>
+#include <poll.h>
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <vector>
+
+
+namespace ncs::sock {
+namespace tests {
+
+
+/**
+ * Multicast test constants
+ */
+constexpr const char* TEST_GROUP = "239.1.2.3";
+constexpr const char* OTHER_GROUP = "239.1.2.4";
+constexpr const char* SOURCE_SPECIFIC_GROUP = "232.1.2.3";
+constexpr int WAIT_MS = 1000;
+
+/**
+ * @brief Waits until iSocket has a datagram queued
+ * 
+ * @param iSocket
+ * @param iTimeoutMs
+ * 
+ * @return
+ */
+static bool wait_datagram(const MulticastSocket& iSocket, const int& iTimeoutMs = WAIT_MS) {
+  pollfd entry = {iSocket.get_socket().get_sd(), POLLIN, 0};
+  return ::poll(&entry, 1, iTimeoutMs) == 1;
+}
+
+/**
+ * @brief Opens a receiver bound to the wildcard address on a random port
+ * 
+ * @param oReceiver
+ */
+static void open_receiver(MulticastSocket& oReceiver) {
+  ASSERT_TRUE(oReceiver.bind({"0.0.0.0", addr::RANDOM_PORT}));
+}
+
+/**
+ * @brief Opens a sender multicasting on the loopback interface, bound to iIp
+ * 
+ * @param oSender
+ * @param iIp
+ */
+static void open_sender(MulticastSocket& oSender, const addr::ip_t& iIp = "127.0.0.1") {
+  ASSERT_TRUE(oSender.bind({iIp, addr::RANDOM_PORT}));
+  ASSERT_TRUE(oSender.set_interface(if_nametoindex("lo")));
+}
+
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Multicast_Options_Round_Trip) {
+  MulticastSocket v4;
+  MulticastSocket v6;
+  ASSERT_TRUE(v4.open(addr::NET_ADDR_FAM_INET));
+  ASSERT_TRUE(v6.open(addr::NET_ADDR_FAM_INET6));
+  for (MulticastSocket* socket : {&v4, &v6}) {
+    int ttl = 0;
+    bool loop = true;
+    EXPECT_TRUE(socket->set_ttl(4));
+    EXPECT_TRUE(socket->get_socket().get_option<multicast_ttl_t>(ttl));
+    EXPECT_EQ(ttl, 4);
+    EXPECT_TRUE(socket->set_loopback(false));
+    EXPECT_TRUE(socket->get_socket().get_option<multicast_loop_t>(loop));
+    EXPECT_FALSE(loop);
+    EXPECT_TRUE(socket->set_interface(if_nametoindex("lo")));
+  }
+  int hops = 0;
+  EXPECT_TRUE(v6.get_socket().get_option(IPPROTO_IPV6, IPV6_MULTICAST_HOPS, hops));
+  EXPECT_EQ(hops, 4);
+
+  // Loopback has no IPv6 multicast route, only the memberships are exercised
+  const unsigned int lo = if_nametoindex("lo");
+  EXPECT_TRUE(v6.join({"ff12::1234", 0}, lo));
+  EXPECT_TRUE(v6.join({"ff32::8000:1", 0}, {"::1", 0}, lo));
+  EXPECT_TRUE(v6.leave({"ff32::8000:1", 0}, {"::1", 0}, lo));
+  EXPECT_TRUE(v6.leave({"ff12::1234", 0}, lo));
+  errno = 0;
+  EXPECT_FALSE(v4.join({"10.0.0.1", 0}, lo));
+  EXPECT_EQ(errno, EINVAL);
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Multicast_Send_And_Receive) {
+  MulticastSocket receiver;
+  MulticastSocket sender;
+  open_receiver(receiver);
+  open_sender(sender);
+  const unsigned int lo = if_nametoindex("lo");
+  const addr::InternetAddress group(TEST_GROUP, receiver.get_socket().get_addr().get_port());
+  ASSERT_TRUE(receiver.join(group, lo));
+
+  const std::string message = "hello group";
+  ASSERT_EQ(sender.send_to(message.data(), message.size(), group), static_cast<ssize_t>(message.size()));
+  ASSERT_TRUE(wait_datagram(receiver));
+  char buffer[64] = {};
+  addr::InternetAddress source;
+  ASSERT_EQ(receiver.recv_from(buffer, sizeof(buffer), source), static_cast<ssize_t>(message.size()));
+  EXPECT_EQ(std::string(buffer, message.size()), message);
+  EXPECT_EQ(source, sender.get_socket().get_addr());
+
+  // Same datagram through an encoded group address
+  addr::Inet4Address encoded;
+  ASSERT_TRUE(encoded.assign(group));
+  ASSERT_EQ(sender.send_to(message.data(), message.size(), encoded), static_cast<ssize_t>(message.size()));
+  ASSERT_TRUE(wait_datagram(receiver));
+  EXPECT_EQ(receiver.recv_from(buffer, sizeof(buffer), source), static_cast<ssize_t>(message.size()));
+
+  // Once left, the group is no longer delivered
+  ASSERT_TRUE(receiver.leave(group, lo));
+  ASSERT_EQ(sender.send_to(message.data(), message.size(), group), static_cast<ssize_t>(message.size()));
+  EXPECT_FALSE(wait_datagram(receiver, 100));
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Fanout_Lends_One_Buffer_To_Every_Subscriber) {
+  MulticastSocket receiver;
+  MulticastSocket sender;
+  open_receiver(receiver);
+  open_sender(sender);
+  fanout_config_t config;
+  config.ifindex = if_nametoindex("lo");
+  MulticastFanout fanout(receiver, config);
+  const addr::port_t port = receiver.get_socket().get_addr().get_port();
+
+  std::vector<const std::uint8_t*> seen;
+  std::vector<std::string> other;
+  const datagram_handler_t record = [&seen](const datagram_t& iDatagram) {
+    seen.push_back(iDatagram.data);
+  };
+  const subscription_id_t first = fanout.subscribe({TEST_GROUP, 0}, record);
+  const subscription_id_t second = fanout.subscribe({TEST_GROUP, 0}, record);
+  const subscription_id_t third = fanout.subscribe({TEST_GROUP, 0}, record);
+  ASSERT_NE(first, 0u);
+  ASSERT_NE(second, 0u);
+  ASSERT_NE(third, 0u);
+  ASSERT_NE(fanout.subscribe({OTHER_GROUP, 0}, [&other](const datagram_t& iDatagram) {
+    other.emplace_back(reinterpret_cast<const char*>(iDatagram.data), iDatagram.size);
+  }), 0u);
+  EXPECT_EQ(fanout.get_subscribers(), 4u);
+
+  ASSERT_EQ(sender.send_to("to-test", 7, {TEST_GROUP, port}), 7);
+  ASSERT_EQ(sender.send_to("to-other", 8, {OTHER_GROUP, port}), 8);
+  ASSERT_TRUE(wait_datagram(receiver));
+  std::size_t received = 0;
+  for (int i = 0; (i < 10) && (received < 2); ++i) {
+    received += fanout.poll();
+  }
+  ASSERT_EQ(received, 2u);
+  ASSERT_EQ(seen.size(), 3u);
+  EXPECT_EQ(seen[0], seen[1]);
+  EXPECT_EQ(seen[1], seen[2]);
+  ASSERT_EQ(other.size(), 1u);
+  EXPECT_EQ(other.front(), "to-other");
+  EXPECT_EQ(fanout.get_stats().datagrams, 2u);
+  EXPECT_EQ(fanout.get_stats().deliveries, 4u);
+  EXPECT_EQ(fanout.get_stats().unmatched, 0u);
+
+  // The group stays joined until its last subscriber leaves
+  EXPECT_TRUE(fanout.unsubscribe(first));
+  EXPECT_TRUE(fanout.unsubscribe(second));
+  EXPECT_FALSE(fanout.unsubscribe(second));
+  ASSERT_EQ(sender.send_to("again", 5, {TEST_GROUP, port}), 5);
+  ASSERT_TRUE(wait_datagram(receiver));
+  EXPECT_EQ(fanout.poll(), 1u);
+  EXPECT_EQ(seen.size(), 4u);
+  EXPECT_TRUE(fanout.unsubscribe(third));
+  ASSERT_EQ(sender.send_to("gone", 4, {TEST_GROUP, port}), 4);
+  EXPECT_FALSE(wait_datagram(receiver, 100));
+  EXPECT_EQ(fanout.poll(), 0u);
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Fanout_Handler_Can_Unsubscribe_Itself) {
+  MulticastSocket receiver;
+  MulticastSocket sender;
+  open_receiver(receiver);
+  open_sender(sender);
+  fanout_config_t config;
+  config.ifindex = if_nametoindex("lo");
+  config.datagram_size = 4;
+  MulticastFanout fanout(receiver, config);
+  const addr::port_t port = receiver.get_socket().get_addr().get_port();
+
+  std::size_t calls = 0;
+  bool truncated = false;
+  subscription_id_t id = 0;
+  id = fanout.subscribe({TEST_GROUP, 0}, [&](const datagram_t& iDatagram) {
+    ++calls;
+    truncated = iDatagram.truncated;
+    EXPECT_TRUE(fanout.unsubscribe(id));
+  });
+  ASSERT_NE(id, 0u);
+  ASSERT_EQ(sender.send_to("first", 5, {TEST_GROUP, port}), 5);
+  ASSERT_EQ(sender.send_to("second", 6, {TEST_GROUP, port}), 6);
+  ASSERT_TRUE(wait_datagram(receiver));
+  std::size_t received = 0;
+  for (int i = 0; (i < 10) && (received < 2); ++i) {
+    received += fanout.poll();
+  }
+  EXPECT_EQ(calls, 1u);
+  EXPECT_TRUE(truncated);
+  EXPECT_EQ(fanout.get_subscribers(), 0u);
+  EXPECT_EQ(fanout.get_stats().truncated, received);
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Fanout_Source_Specific_Subscription) {
+  MulticastSocket receiver;
+  MulticastSocket wanted;
+  MulticastSocket unwanted;
+  open_receiver(receiver);
+  open_sender(wanted, "127.0.0.1");
+  open_sender(unwanted, "127.0.0.2");
+  fanout_config_t config;
+  config.ifindex = if_nametoindex("lo");
+  MulticastFanout fanout(receiver, config);
+  const addr::InternetAddress group(SOURCE_SPECIFIC_GROUP, receiver.get_socket().get_addr().get_port());
+
+  std::vector<addr::InternetAddress> sources;
+  ASSERT_NE(fanout.subscribe({SOURCE_SPECIFIC_GROUP, 0}, {"127.0.0.1", 0}, [&sources](const datagram_t& iDatagram) {
+    addr::InternetAddress source;
+    EXPECT_TRUE(source.set_sockaddr(iDatagram.source, iDatagram.source_size));
+    sources.push_back(source);
+  }), 0u);
+  ASSERT_EQ(unwanted.send_to("no", 2, group), 2);
+  ASSERT_EQ(wanted.send_to("yes", 3, group), 3);
+  ASSERT_TRUE(wait_datagram(receiver));
+  while (fanout.poll() > 0) {}
+
+  ASSERT_EQ(sources.size(), 1u);
+  EXPECT_EQ(sources.front(), wanted.get_socket().get_addr());
+  EXPECT_EQ(fanout.get_stats().datagrams, 1u);
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Fanout_Filters_Each_Subscription_By_Source) {
+  MulticastSocket receiver;
+  MulticastSocket first;
+  MulticastSocket second;
+  open_receiver(receiver);
+  open_sender(first, "127.0.0.1");
+  open_sender(second, "127.0.0.2");
+  fanout_config_t config;
+  config.ifindex = if_nametoindex("lo");
+  MulticastFanout fanout(receiver, config);
+  const addr::InternetAddress group(SOURCE_SPECIFIC_GROUP, receiver.get_socket().get_addr().get_port());
+
+  // Both sources are joined on the same group, each subscriber must only see its own
+  std::vector<std::string> fromFirst;
+  std::vector<std::string> fromSecond;
+  const auto collect = [](std::vector<std::string>& oReceived) {
+    return [&oReceived](const datagram_t& iDatagram) {
+      oReceived.emplace_back(reinterpret_cast<const char*>(iDatagram.data), iDatagram.size);
+    };
+  };
+  ASSERT_NE(fanout.subscribe({SOURCE_SPECIFIC_GROUP, 0}, {"127.0.0.1", 0}, collect(fromFirst)), 0u);
+  ASSERT_NE(fanout.subscribe({SOURCE_SPECIFIC_GROUP, 0}, {"127.0.0.2", 0}, collect(fromSecond)), 0u);
+  ASSERT_EQ(first.send_to("one", 3, group), 3);
+  ASSERT_EQ(second.send_to("two", 3, group), 3);
+  for (int i = 0; (i < 10) && (fanout.get_stats().datagrams < 2); ++i) {
+    ASSERT_TRUE(wait_datagram(receiver));
+    while (fanout.poll() > 0) {}
+  }
+
+  EXPECT_EQ(fromFirst, std::vector<std::string>{"one"});
+  EXPECT_EQ(fromSecond, std::vector<std::string>{"two"});
+  EXPECT_EQ(fanout.get_stats().deliveries, 2u);
+}
+
+
+} // namespace tests
+} // namespace ncs::sock
@@ -0,0 +1,170 @@
+/**
+ * @copyright Copyright (c) 2023
+ * 
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ * 
+ * @file PacketSocket_tests.cpp
+ * 
+ * @brief
+ */
+
+
+#include <PacketSocket.h>
+#include <SocketTest.h>
+
+#include <gtest/gtest.h>
+
+#include <net/if.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <string>
+#include <vector>
+
+
+namespace ncs::sock {
+namespace tests {
+
+
+/**
+ * PacketSocket test constants
+ */
+constexpr std::uint16_t TEST_ETHERTYPE = 0x88B6;   // IEEE local experimental ethertype 2
+
+/**
+ * @brief Small rings on loopback that only see the test ethertype
+ * 
+ * @return
+ */
+static packet_config_t loopback_config(void) {
+  packet_config_t config;
+  config.ifindex = static_cast<int>(::if_nametoindex("lo"));
+  config.block_size = 64 * 1024;
+  config.block_count = 4;
+  config.block_timeout_ms = 2;
+  config.tx_frame_count = 32;
+  config.filter = PacketSocket::ethertype_filter(TEST_ETHERTYPE);
+  return config;
+}
+
+/**
+ * @brief
+ * 
+ * @param iPayload
+ * 
+ * @return
+ */
+static std::string make_frame(const std::string& iPayload) {
+  std::string frame(12, '\xff');
+  frame.push_back(static_cast<char>(TEST_ETHERTYPE >> 8));
+  frame.push_back(static_cast<char>(TEST_ETHERTYPE & 0xFF));
+  frame.append(iPayload);
+  return frame;
+}
+
+/**
+ * @brief Drains iSocket until iCount looped back frames arrive or it stays idle
+ * 
+ * Loopback shows every injected frame twice, the outgoing copy is skipped
+ * 
+ * @param ioSocket
+ * @param iCount
+ * 
+ * @return
+ */
+static std::vector<std::string> capture(PacketSocket& ioSocket, const std::size_t& iCount) {
+  std::vector<std::string> captured;
+  std::vector<packet_frame_t> frames;
+  while (captured.size() < iCount && ioSocket.wait(200)) {
+    ioSocket.receive(frames);
+    for (const packet_frame_t& frame : frames) {
+      if (frame.type != PACKET_OUTGOING) {
+        captured.emplace_back(reinterpret_cast<const char*>(frame.data), frame.size);
+      }
+    }
+  }
+  ioSocket.release();
+  return captured;
+}
+
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Packet_Socket_Rejects_Bad_Geometry) {
+  PacketSocket socket;
+  packet_config_t config = loopback_config();
+  config.frame_size = config.block_size * 2;
+  EXPECT_FALSE(socket.open(config));
+  EXPECT_EQ(errno, EINVAL);
+  EXPECT_FALSE(socket.is_open());
+  const iovec frame{nullptr, 0};
+  EXPECT_EQ(socket.send(&frame, 1), 0u);
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Packet_Socket_Injects_And_Captures) {
+  PacketSocket capturer;
+  PacketSocket injector;
+  if (!capturer.open(loopback_config())) {
+    GTEST_SKIP() << "AF_PACKET is not permitted";
+  }
+  packet_config_t config = loopback_config();
+  config.protocol = TEST_ETHERTYPE;
+  ASSERT_TRUE(injector.open(config));
+
+  std::vector<std::string> sent;
+  std::vector<iovec> batch;
+  for (int i = 0; i < 16; ++i) {
+    sent.push_back(make_frame("ncs tpacket v3 frame " + std::to_string(i)));
+  }
+  for (std::string& frame : sent) {
+    batch.push_back({frame.data(), frame.size()});
+  }
+  ASSERT_EQ(injector.send(batch.data(), batch.size()), batch.size());
+
+  EXPECT_EQ(capture(capturer, sent.size()), sent);
+  const packet_stats_t stats = capturer.get_stats();
+  EXPECT_GE(stats.blocks, 1u);
+  EXPECT_EQ(stats.rx_packets, 2 * sent.size());
+  EXPECT_EQ(stats.kernel_drops, 0u);
+  EXPECT_EQ(injector.get_stats().tx_packets, sent.size());
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Packet_Fanout_Delivers_Each_Frame_Once) {
+  PacketSocket first;
+  PacketSocket second;
+  PacketSocket injector;
+  if (!first.open(loopback_config())) {
+    GTEST_SKIP() << "AF_PACKET is not permitted";
+  }
+  ASSERT_TRUE(second.open(loopback_config()));
+  ASSERT_TRUE(injector.open(loopback_config()));
+  const std::uint16_t group = static_cast<std::uint16_t>(::getpid());
+  ASSERT_TRUE(first.join_fanout(group, FANOUT_HASH));
+  ASSERT_TRUE(second.join_fanout(group, FANOUT_HASH));
+
+  std::vector<std::string> sent;
+  std::vector<iovec> batch;
+  for (int i = 0; i < 32; ++i) {
+    sent.push_back(make_frame("fanout " + std::to_string(i)));
+  }
+  for (std::string& frame : sent) {
+    batch.push_back({frame.data(), frame.size()});
+  }
+  ASSERT_EQ(injector.send(batch.data(), batch.size()), batch.size());
+
+  const std::size_t firstCount = capture(first, sent.size()).size();
+  const std::size_t secondCount = capture(second, sent.size() - firstCount).size();
+  EXPECT_EQ(firstCount + secondCount, sent.size());
+}
+
+
+} // namespace tests
+} // namespace ncs::sock
@@ -0,0 +1,132 @@
+/**
+ * @copyright Copyright (c) 2023
+ * 
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ * 
+ * @file RateLimiter_tests.cpp
+ * 
+ * @brief
+ */
+
+
+#include <RateLimiter.h>
+#include <SocketTest.h>
+
+#include <gtest/gtest.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/un.h>
+
+#include <string>
+
+
+namespace ncs::sock {
+namespace tests {
+
+
+/**
+ * RateLimiter test constants
+ */
+constexpr std::uint64_t MS = 1000000;
+
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Rate_Limiter_Gcra) {
+  rate_limit_config_t config;
+  config.rate = 10;
+  config.burst = 3;
+  RateLimiter limiter(config);
+  const addr::InternetAddress source("192.0.2.1", 40000);
+
+  // A quiet source gets its burst back to back, then one connection per interval
+  const std::uint64_t start = 1000 * MS;
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_TRUE(limiter.admit(source, start)) << i;
+  }
+  EXPECT_FALSE(limiter.admit(source, start));
+  EXPECT_FALSE(limiter.admit(source, start + 50 * MS));
+  EXPECT_TRUE(limiter.admit(source, start + 100 * MS));
+  EXPECT_FALSE(limiter.admit(source, start + 100 * MS));
+  EXPECT_TRUE(limiter.admit({"192.0.2.2", 40000}, start + 100 * MS));
+
+  // Refused connections cost nothing, the burst is back after burst intervals of silence
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_TRUE(limiter.admit(source, start + 400 * MS)) << i;
+  }
+  EXPECT_FALSE(limiter.admit(source, start + 400 * MS));
+
+  RateLimiter unlimited(rate_limit_config_t{0, 1, 32, 64, 4});
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(unlimited.admit(source, start));
+  }
+  EXPECT_EQ(unlimited.get_tracked(), 0u);
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Rate_Limiter_Prefixes) {
+  rate_limit_config_t config;
+  config.rate = 1;
+  config.burst = 1;
+  config.prefix_v4 = 24;
+  RateLimiter limiter(config);
+  const std::uint64_t now = 1000 * MS;
+
+  EXPECT_TRUE(limiter.admit({"10.0.0.1", 1000}, now));
+  EXPECT_FALSE(limiter.admit({"10.0.0.2", 1001}, now));
+  EXPECT_TRUE(limiter.admit({"10.0.1.1", 1000}, now));
+  EXPECT_TRUE(limiter.admit({"2001:db8::1", 1000}, now));
+  EXPECT_FALSE(limiter.admit({"2001:db8::2", 1000}, now));
+  EXPECT_TRUE(limiter.admit({"2001:db8:0:1::1", 1000}, now));
+
+  // Dual stack listeners see IPv4 clients as mapped addresses
+  sockaddr_in6 mapped{};
+  mapped.sin6_family = AF_INET6;
+  ASSERT_EQ(inet_pton(AF_INET6, "::ffff:10.0.0.3", &mapped.sin6_addr), 1);
+  EXPECT_FALSE(limiter.admit(reinterpret_cast<sockaddr*>(&mapped), sizeof(mapped), now));
+  ASSERT_EQ(inet_pton(AF_INET6, "::ffff:10.0.2.3", &mapped.sin6_addr), 1);
+  EXPECT_TRUE(limiter.admit(reinterpret_cast<sockaddr*>(&mapped), sizeof(mapped), now));
+
+  sockaddr_un local{};
+  local.sun_family = AF_UNIX;
+  EXPECT_TRUE(limiter.admit(reinterpret_cast<sockaddr*>(&local), sizeof(local), now));
+  EXPECT_TRUE(limiter.admit(reinterpret_cast<sockaddr*>(&local), sizeof(local), now));
+  EXPECT_EQ(limiter.get_tracked(), 5u);
+
+  limiter.clear();
+  EXPECT_EQ(limiter.get_tracked(), 0u);
+  EXPECT_TRUE(limiter.admit({"10.0.0.2", 1001}, now));
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Rate_Limiter_Eviction) {
+  rate_limit_config_t config;
+  config.rate = 1;
+  config.burst = 2;
+  config.slots = RATE_LIMIT_BUCKET_SLOTS;
+  RateLimiter limiter(config);
+  EXPECT_EQ(limiter.get_slots(), RATE_LIMIT_BUCKET_SLOTS);
+
+  // A single bucket, the flooding source stays ahead of every newcomer
+  const std::uint64_t now = 1000 * MS;
+  const addr::InternetAddress flooder("198.51.100.1", 1000);
+  EXPECT_TRUE(limiter.admit(flooder, now));
+  EXPECT_TRUE(limiter.admit(flooder, now));
+  EXPECT_FALSE(limiter.admit(flooder, now));
+  for (int i = 0; i < 50; ++i) {
+    EXPECT_TRUE(limiter.admit({"203.0.113." + std::to_string(i), 1000}, now + i * MS)) << i;
+    EXPECT_FALSE(limiter.admit(flooder, now + i * MS)) << i;
+  }
+  EXPECT_EQ(limiter.get_tracked(), RATE_LIMIT_BUCKET_SLOTS);
+}
+
+
+} // namespace tests
+} // namespace ncs::sock
@@ -0,0 +1,162 @@
+/**
+ * @copyright Copyright (c) 2023
+ * 
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ * 
+ * @file SocketProfile_tests.cpp
+ * 
+ * @brief
+ */
+
+
+#include <Acceptor.h>
+#include <SocketProfile.h>
+#include <SocketTest.h>
+
+#include <gtest/gtest.h>
+
+#include <netinet/ip.h>
+
+#include <cerrno>
+#include <string>
+#include <vector>
+
+
+namespace ncs::sock {
+namespace tests {
+
+
+/**
+ * @brief
+ * 
+ * @param iReadings
+ * @param iLabel
+ * 
+ * @return
+ */
+static option_reading_t find_reading(const std::vector<option_reading_t>& iReadings, const std::string& iLabel) {
+  for (const option_reading_t& reading : iReadings) {
+    if (iLabel == reading.label) {
+      return reading;
+    }
+  }
+  ADD_FAILURE() << "missing " << iLabel;
+  return option_reading_t();
+}
+
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Typed_Options_Round_Trip) {
+  connect_pair();
+  bool noDelay = false;
+  EXPECT_TRUE(client_.set_option<tcp_no_delay_t>(true));
+  EXPECT_TRUE(client_.get_option<tcp_no_delay_t>(noDelay));
+  EXPECT_TRUE(noDelay);
+
+  int lowAt = 0;
+  EXPECT_TRUE(client_.set_option<tcp_not_sent_low_at_t>(4096));
+  EXPECT_TRUE(client_.get_option<tcp_not_sent_low_at_t>(lowAt));
+  EXPECT_EQ(lowAt, 4096);
+
+  // The kernel doubles the buffer sizes to account for its bookkeeping
+  int buffer = 0;
+  EXPECT_TRUE(client_.set_option<recv_buffer_t>(64 * 1024));
+  EXPECT_TRUE(client_.get_option<recv_buffer_t>(buffer));
+  EXPECT_EQ(buffer, 128 * 1024);
+
+  EXPECT_EQ(client_.get_address_family(), addr::NET_ADDR_FAM_INET);
+  InternetSocket closed;
+  EXPECT_FALSE(closed.set_option<tcp_no_delay_t>(true));
+  EXPECT_EQ(closed.get_address_family(), addr::NET_ADDR_FAM_UNSPEC);
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Traffic_Class_Follows_The_Family) {
+  InternetSocket v4;
+  InternetSocket v6;
+  ASSERT_TRUE(v4.open(addr::NET_ADDR_FAM_INET));
+  ASSERT_TRUE(v6.open(addr::NET_ADDR_FAM_INET6));
+  int tos = 0;
+  EXPECT_TRUE(v4.set_option<traffic_class_t>(IPTOS_LOWDELAY));
+  EXPECT_TRUE(v6.set_option<traffic_class_t>(IPTOS_THROUGHPUT));
+  EXPECT_TRUE(v6.get_option(IPPROTO_IPV6, IPV6_TCLASS, tos));
+  EXPECT_EQ(tos, IPTOS_THROUGHPUT);
+  EXPECT_TRUE(v4.get_option<traffic_class_t>(tos));
+  EXPECT_EQ(tos, IPTOS_LOWDELAY);
+  v4.close();
+  v6.close();
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Profile_Applies_In_One_Pass) {
+  connect_pair("::1");
+  const SocketProfile profile = SocketProfile::low_latency();
+  ASSERT_TRUE(profile.apply(client_));
+
+  const std::vector<option_reading_t> readings = profile.read_back(client_);
+  ASSERT_EQ(readings.size(), profile.get_entries().size());
+  EXPECT_EQ(find_reading(readings, "TCP_NODELAY").effective, 1);
+  EXPECT_EQ(find_reading(readings, "TCP_NOTSENT_LOWAT").effective, LOW_LATENCY_NOT_SENT_LOW_AT);
+  EXPECT_EQ(find_reading(readings, "IP_TOS").effective, IPTOS_LOWDELAY);
+  for (const option_reading_t& reading : readings) {
+    EXPECT_TRUE(reading.read) << reading.label;
+  }
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Profile_Reports_Required_Failures) {
+  connect_pair();
+  SocketProfile profile("test");
+  profile.set<busy_poll_t>(-1, true).set<tcp_no_delay_t>(true);
+  EXPECT_TRUE(profile.apply(client_));
+
+  profile.set<busy_poll_t>(-1);
+  ASSERT_EQ(profile.get_entries().size(), 2u);
+  errno = 0;
+  EXPECT_FALSE(profile.apply(client_));
+  EXPECT_EQ(errno, EINVAL);
+
+  // Options after the failing one are still applied
+  profile.set<tcp_no_delay_t>(false);
+  (void)profile.apply(client_);
+  bool noDelay = true;
+  EXPECT_TRUE(client_.get_option<tcp_no_delay_t>(noDelay));
+  EXPECT_FALSE(noDelay);
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Acceptor_Applies_Profile) {
+  EventLoop loop;
+  const SocketProfile profile = SocketProfile::many_idle_connections();
+  acceptor_config_t config;
+  config.profile = &profile;
+  Acceptor acceptor(loop, config);
+  ASSERT_TRUE(acceptor.listen({"127.0.0.1", addr::RANDOM_PORT}, [this](InternetSocket&& ioClient) {
+    server_ = std::move(ioClient);
+  }));
+  ASSERT_TRUE(client_.connect(acceptor.get_listener().get_addr()));
+  EXPECT_EQ(loop.run_once(1000), 1u);
+  ASSERT_TRUE(server_.is_open());
+
+  bool keepAlive = false;
+  int buffer = 0;
+  EXPECT_TRUE(server_.get_option<keep_alive_t>(keepAlive));
+  EXPECT_TRUE(keepAlive);
+  EXPECT_TRUE(server_.get_option<send_buffer_t>(buffer));
+  EXPECT_EQ(buffer, 2 * IDLE_BUFFER_SIZE);
+}
+
+
+} // namespace tests
+} // namespace ncs::sock
@@ -0,0 +1,268 @@
+/**
+ * @copyright Copyright (c) 2023
+ * 
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ * 
+ * @file SourcePortManager_tests.cpp
+ * 
+ * @brief
+ */
+
+
+#include <SocketTest.h>
+#include <SocketOptions.h>
+#include <SourcePortManager.h>
+
+#include <gtest/gtest.h>
+
+#include <sys/socket.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+
+namespace ncs::sock {
+namespace tests {
+
+
+/**
+ * @brief Highest two free ports of the system wide ephemeral range, per socket ranges may only narrow it
+ * 
+ * A port some socket still holds, in TIME_WAIT after an earlier run for instance, fails the probing bind(2)
+ * 
+ * @param oFirst
+ * @param oLast
+ */
+static void test_range(addr::port_t& oFirst, addr::port_t& oLast) {
+  std::ifstream range(LOCAL_PORT_RANGE_PATH);
+  addr::port_t first = DEFAULT_FIRST_LOCAL_PORT;
+  oLast = DEFAULT_LAST_LOCAL_PORT;
+  range >> first >> oLast;
+  for (; oLast > first; --oLast) {
+    InternetSocket high;
+    InternetSocket low;
+    const bool free = high.bind({"0.0.0.0", oLast}) && low.bind({"0.0.0.0", oLast - 1});
+    high.close();
+    low.close();
+    if (free) {
+      break;
+    }
+  }
+  oFirst = oLast - 1;
+}
+
+/**
+ * @brief Local address the kernel bound iSocket to
+ * 
+ * @param iSocket
+ * 
+ * @return
+ */
+static addr::InternetAddress local_address(const InternetSocket& iSocket) {
+  sockaddr_storage storage;
+  socklen_t size = sizeof(storage);
+  addr::InternetAddress local;
+  EXPECT_EQ(::getsockname(iSocket.get_sd(), reinterpret_cast<sockaddr*>(&storage), &size), 0);
+  EXPECT_TRUE(local.set_sockaddr(reinterpret_cast<sockaddr*>(&storage), size));
+  return local;
+}
+
+/**
+ * @brief Opens a listener on a kernel picked loopback port
+ * 
+ * @param oListener
+ */
+static void listen_on_loopback(InternetSocket& oListener) {
+  ASSERT_TRUE(oListener.bind({"127.0.0.1", addr::RANDOM_PORT}));
+  ASSERT_TRUE(oListener.listen());
+}
+
+/**
+ * @brief
+ * 
+ * @param ioSockets
+ */
+static void close_all(std::vector<InternetSocket>& ioSockets) {
+  for (InternetSocket& socket : ioSockets) {
+    socket.close();
+  }
+}
+
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Source_Ports_Spread_Sources) {
+  InternetSocket listener;
+  listen_on_loopback(listener);
+  source_ports_config_t config;
+  config.sources = {{"127.0.0.2", addr::RANDOM_PORT}, {"127.0.0.3", addr::RANDOM_PORT}, {"::1", addr::RANDOM_PORT}};
+  SourcePortManager manager(config);
+  metrics::ConnectMetrics metrics;
+  manager.set_metrics(&metrics);
+  EXPECT_GT(manager.get_capacity(), 0u);
+
+  std::vector<InternetSocket> clients(4);
+  for (InternetSocket& client : clients) {
+    ASSERT_TRUE(manager.connect(listener.get_addr(), client));
+    EXPECT_EQ(client.get_addr(), listener.get_addr());
+  }
+  // IPv4 destinations never leave from the IPv6 source
+  EXPECT_EQ(local_address(clients[0]).get_ip(), "127.0.0.2");
+  EXPECT_EQ(local_address(clients[1]).get_ip(), "127.0.0.3");
+  EXPECT_EQ(manager.get_connections(0, listener.get_addr()), 2u);
+  EXPECT_EQ(manager.get_connections(1, listener.get_addr()), 2u);
+  EXPECT_EQ(manager.get_connections(2, listener.get_addr()), 0u);
+  EXPECT_EQ(manager.get_connections(), 4u);
+
+  // The next connection leaves from the least loaded source
+  EXPECT_TRUE(manager.release(clients[1]));
+  EXPECT_FALSE(manager.release(listener));
+  clients[1].close();
+  ASSERT_TRUE(manager.connect(listener.get_addr(), clients[1]));
+  EXPECT_EQ(local_address(clients[1]).get_ip(), "127.0.0.3");
+
+  const metrics::connect_snapshot_t snapshot = metrics.snapshot();
+  EXPECT_EQ(snapshot.connected, 5u);
+  EXPECT_EQ(snapshot.exhausted, 0u);
+  EXPECT_EQ(snapshot.connect_latency.get_count(), 5u);
+
+  InternetSocket invalid;
+  EXPECT_FALSE(manager.connect({"localhost", 8080}, invalid));
+  EXPECT_EQ(errno, EINVAL);
+  EXPECT_EQ(metrics.snapshot().errors, 1u);
+  close_all(clients);
+  listener.close();
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Source_Ports_Mapped_Addresses) {
+  InternetSocket listener;
+  listen_on_loopback(listener);
+  const addr::InternetAddress mapped("::ffff:127.0.0.1", listener.get_addr().get_port());
+  source_ports_config_t config;
+  config.sources = {{"127.0.0.2", addr::RANDOM_PORT}, {"::ffff:127.0.0.3", addr::RANDOM_PORT}};
+  SourcePortManager manager(config);
+
+  // A mapped destination is reached over IPv6, so it leaves from the mapped source and the other way round
+  std::vector<InternetSocket> clients(2);
+  ASSERT_TRUE(manager.connect(mapped, clients[0]));
+  ASSERT_TRUE(manager.connect(listener.get_addr(), clients[1]));
+  const addr::InternetAddress fromMapped = local_address(clients[0]);
+  EXPECT_EQ(fromMapped.get_address_family(), addr::NET_ADDR_FAM_INET6);
+  EXPECT_EQ(fromMapped.get_ip(), "::ffff:127.0.0.3");
+  EXPECT_EQ(local_address(clients[1]).get_ip(), "127.0.0.2");
+  EXPECT_EQ(manager.get_connections(1, mapped), 1u);
+  EXPECT_EQ(manager.get_connections(0, listener.get_addr()), 1u);
+  EXPECT_TRUE(manager.release(clients[0]));
+  EXPECT_EQ(manager.get_connections(), 1u);
+
+  source_ports_config_t mappedOnly;
+  mappedOnly.sources = {{"::ffff:127.0.0.3", addr::RANDOM_PORT}};
+  SourcePortManager other(mappedOnly);
+  InternetSocket client;
+  EXPECT_FALSE(other.connect(listener.get_addr(), client));
+  EXPECT_EQ(errno, EADDRNOTAVAIL);
+  close_all(clients);
+  listener.close();
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Source_Ports_Exhaustion) {
+  addr::port_t firstPort = 0;
+  addr::port_t lastPort = 0;
+  test_range(firstPort, lastPort);
+  std::vector<InternetSocket> listeners(2);
+  listen_on_loopback(listeners[0]);
+  listen_on_loopback(listeners[1]);
+  source_ports_config_t config;
+  config.sources = {{"127.0.0.2", addr::RANDOM_PORT}};
+  config.first_port = firstPort;
+  config.last_port = lastPort;
+  SourcePortManager manager(config);
+  metrics::ConnectMetrics metrics;
+  manager.set_metrics(&metrics);
+  ASSERT_EQ(manager.get_capacity(), 2u);
+
+  // Both ports are handed out again toward the second destination
+  std::vector<InternetSocket> clients(4);
+  for (std::size_t i = 0; i < clients.size(); ++i) {
+    ASSERT_TRUE(manager.connect(listeners[i / 2].get_addr(), clients[i]));
+    const addr::port_t port = local_address(clients[i]).get_port();
+    EXPECT_GE(port, firstPort);
+    EXPECT_LE(port, lastPort);
+  }
+  EXPECT_EQ(local_address(clients[0]).get_port() + local_address(clients[1]).get_port(),
+            local_address(clients[2]).get_port() + local_address(clients[3]).get_port());
+
+  InternetSocket extra;
+  EXPECT_FALSE(manager.connect(listeners[0].get_addr(), extra));
+  EXPECT_EQ(errno, EADDRNOTAVAIL);
+  EXPECT_FALSE(extra.is_open());
+  EXPECT_EQ(metrics.snapshot().exhausted, 1u);
+
+  // An abortive close skips TIME_WAIT, which would keep holding the port toward the listener
+  EXPECT_TRUE(manager.release(clients[0]));
+  const linger abort = {1, 0};
+  ASSERT_EQ(::setsockopt(clients[0].get_sd(), SOL_SOCKET, SO_LINGER, &abort, sizeof(abort)), 0);
+  clients[0].close();
+  EXPECT_TRUE(manager.connect(listeners[0].get_addr(), extra));
+  EXPECT_TRUE(manager.release(extra));
+  extra.close();
+  close_all(clients);
+  close_all(listeners);
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Source_Ports_Skip_Busy_Source) {
+  addr::port_t firstPort = 0;
+  addr::port_t lastPort = 0;
+  test_range(firstPort, lastPort);
+  InternetSocket listener;
+  listen_on_loopback(listener);
+  // A connection made behind the manager's back holds the first port of the range toward the listener
+  InternetSocket outsider;
+  ASSERT_TRUE(outsider.open(addr::NET_ADDR_FAM_INET));
+  ASSERT_TRUE(outsider.set_option<bind_address_no_port_t>(true));
+  ASSERT_TRUE(outsider.set_option<local_port_range_t>((static_cast<std::uint32_t>(firstPort) << 16) |
+                                                      static_cast<std::uint32_t>(firstPort)));
+  ASSERT_TRUE(outsider.bind({"127.0.0.2", addr::RANDOM_PORT}));
+  ASSERT_TRUE(outsider.connect(listener.get_addr()));
+  ASSERT_EQ(local_address(outsider).get_port(), firstPort);
+
+  source_ports_config_t config;
+  config.sources = {{"127.0.0.2", addr::RANDOM_PORT}, {"127.0.0.3", addr::RANDOM_PORT}};
+  config.first_port = firstPort;
+  config.last_port = lastPort;
+  SourcePortManager manager(config);
+  metrics::ConnectMetrics metrics;
+  manager.set_metrics(&metrics);
+
+  std::vector<InternetSocket> clients(3);
+  for (InternetSocket& client : clients) {
+    ASSERT_TRUE(manager.connect(listener.get_addr(), client));
+  }
+  EXPECT_EQ(local_address(clients[0]).get_ip(), "127.0.0.2");
+  EXPECT_EQ(local_address(clients[0]).get_port(), lastPort);
+  EXPECT_EQ(local_address(clients[1]).get_ip(), "127.0.0.3");
+  // The kernel has no port left on the first source, the connection moves on to the second
+  EXPECT_EQ(local_address(clients[2]).get_ip(), "127.0.0.3");
+  EXPECT_EQ(metrics.snapshot().port_unavailable, 1u);
+  EXPECT_EQ(metrics.snapshot().connected, 3u);
+  close_all(clients);
+  outsider.close();
+  listener.close();
+}
+
+
+} // namespace tests
+} // namespace ncs::sock
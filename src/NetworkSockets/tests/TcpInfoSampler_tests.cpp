@@ -0,0 +1,76 @@
+/**
+ * @copyright Copyright (c) 2023
+ * 
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ * 
+ * @file TcpInfoSampler_tests.cpp
+ * 
+ * @brief
+ */
+
+
+#include <SocketTest.h>
+#include <TcpInfoSampler.h>
+
+#include <gtest/gtest.h>
+
+
+namespace ncs::sock {
+namespace tests {
+
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Socket_Reports_To_Metrics) {
+  connect_pair();
+  metrics::SocketMetrics clientMetrics;
+  metrics::SocketMetrics serverMetrics;
+  client_.set_metrics(&clientMetrics);
+  server_.set_metrics(&serverMetrics);
+  ASSERT_EQ(client_.send("hello", 5), 5);
+  EXPECT_EQ(receive_exactly(server_, 5), "hello");
+  ASSERT_TRUE(server_.set_non_blocking(true));
+  char byte;
+  EXPECT_EQ(server_.recv(&byte, 1), -1);
+
+  const metrics::socket_snapshot_t client = clientMetrics.snapshot();
+  const metrics::socket_snapshot_t server = serverMetrics.snapshot();
+  EXPECT_EQ(client.bytes_out, 5u);
+  EXPECT_EQ(client.messages_out, 1u);
+  EXPECT_EQ(client.send_latency.get_count(), 1u);
+  EXPECT_EQ(server.bytes_in, 5u);
+  EXPECT_EQ(server.eagain, 1u);
+  EXPECT_EQ(server.syscalls, server.messages_in + 1);
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Periodic_Tcp_Info) {
+  connect_pair();
+  EventLoop loop;
+  metrics::LoopMetrics loopMetrics;
+  loop.set_metrics(&loopMetrics);
+  metrics::SocketMetrics socketMetrics;
+  TcpInfoSampler sampler(loop, std::chrono::milliseconds(1));
+  sampler.add(client_, socketMetrics);
+  sampler.start();
+  for (int i = 0; (i < 100) && (socketMetrics.snapshot().tcp.samples < 2); ++i) {
+    loop.run_once(10);
+  }
+  const metrics::socket_snapshot_t snapshot = socketMetrics.snapshot();
+  EXPECT_GE(snapshot.tcp.samples, 2u);
+  EXPECT_GT(snapshot.tcp.snd_cwnd, 0u);
+  EXPECT_GE(loopMetrics.snapshot().tasks, 2u);
+
+  metrics::tcp_info_sample_t sample;
+  EXPECT_FALSE(TcpInfoSampler::sample(-1, sample));
+  EXPECT_TRUE(sampler.remove(client_));
+  EXPECT_EQ(sampler.sample_all(), 0u);
+}
+
+
+} // namespace tests
+} // namespace ncs::sock
@@ -0,0 +1,219 @@
+/**
+ * @copyright Copyright (c) 2023
+ * 
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ * 
+ * @file WriteBatcher_tests.cpp
+ * 
+ * @brief
+ */
+
+
+#include <SocketTest.h>
+#include <WriteBatcher.h>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+
+namespace ncs::sock {
+namespace tests {
+
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Coalesce_Small_Writes) {
+  connect_pair();
+  WriteBatcher batcher(client_);
+  std::string expected;
+  for (int i = 0; i < 100; ++i) {
+    const std::string chunk = "message-" + std::to_string(i) + ";";
+    ASSERT_TRUE(batcher.write(chunk.data(), chunk.size()));
+    expected += chunk;
+  }
+  EXPECT_EQ(batcher.get_queued_size(), expected.size());
+  EXPECT_EQ(batcher.get_stats().syscalls, 0u);
+
+  EXPECT_EQ(batcher.flush(), FLUSH_DONE);
+  EXPECT_FALSE(batcher.has_pending());
+  EXPECT_EQ(batcher.get_stats().writes, 100u);
+  EXPECT_EQ(batcher.get_stats().syscalls, 1u);
+  EXPECT_EQ(batcher.get_stats().bytes, expected.size());
+  EXPECT_EQ(receive_exactly(server_, expected.size()), expected);
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Owned_Buffers_Are_Queued_Without_Copy) {
+  connect_pair();
+  coalesce_policy_t policy;
+  policy.copy_threshold = 8;
+  policy.use_cork = true;
+  WriteBatcher batcher(client_, policy);
+  ASSERT_TRUE(batcher.write("head", 4));
+  ASSERT_TRUE(batcher.write(std::vector<std::uint8_t>(4096, 'b')));
+  ASSERT_TRUE(batcher.write("tail", 4));
+  EXPECT_EQ(batcher.flush(), FLUSH_DONE);
+  EXPECT_EQ(batcher.get_stats().syscalls, 1u);
+  EXPECT_EQ(receive_exactly(server_, 4104), "head" + std::string(4096, 'b') + "tail");
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Flush_At_Iteration_End) {
+  connect_pair();
+  EventLoop loop;
+  WriteBatcher batcher(client_, {}, &loop);
+  ASSERT_TRUE(batcher.write("a", 1));
+  ASSERT_TRUE(batcher.write("b", 1));
+  EXPECT_TRUE(batcher.has_pending());
+
+  loop.run_once(1000);
+  EXPECT_FALSE(batcher.has_pending());
+  EXPECT_EQ(batcher.get_stats().syscalls, 1u);
+  EXPECT_EQ(receive_exactly(server_, 2), "ab");
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Byte_Threshold_Flushes_Immediately) {
+  connect_pair();
+  EventLoop loop;
+  coalesce_policy_t policy;
+  policy.max_batch_bytes = 10;
+  WriteBatcher batcher(client_, policy, &loop);
+  ASSERT_TRUE(batcher.write("01234", 5));
+  EXPECT_TRUE(batcher.has_pending());
+  ASSERT_TRUE(batcher.write("56789", 5));
+  EXPECT_FALSE(batcher.has_pending());
+  EXPECT_EQ(receive_exactly(server_, 10), "0123456789");
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Latency_Budget_Holds_Across_Iterations) {
+  connect_pair();
+  EventLoop loop;
+  coalesce_policy_t policy;
+  policy.latency_budget = std::chrono::milliseconds(30);
+  WriteBatcher batcher(client_, policy, &loop);
+  const loop_clock_t::time_point start = loop_clock_t::now();
+  ASSERT_TRUE(batcher.write("late", 4));
+
+  loop.run_once(0);
+  EXPECT_TRUE(batcher.has_pending());
+  while (batcher.has_pending()) {
+    loop.run_once();
+  }
+  EXPECT_GE(loop_clock_t::now() - start, policy.latency_budget);
+  EXPECT_EQ(receive_exactly(server_, 4), "late");
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Pending_Until_Socket_Is_Writable) {
+  connect_pair();
+  ASSERT_TRUE(client_.set_non_blocking(true));
+  WriteBatcher batcher(client_);
+  const std::size_t total = 16 * 1024 * 1024;
+  ASSERT_TRUE(batcher.write(std::vector<std::uint8_t>(total, 'z')));
+  EXPECT_EQ(batcher.flush(), FLUSH_PENDING);
+  EXPECT_TRUE(batcher.has_pending());
+
+  std::size_t received = 0;
+  std::vector<char> buffer(256 * 1024);
+  while (received < total) {
+    const ssize_t result = server_.recv(buffer.data(), buffer.size());
+    ASSERT_GT(result, 0);
+    received += static_cast<std::size_t>(result);
+    batcher.flush();
+  }
+  EXPECT_FALSE(batcher.has_pending());
+  EXPECT_EQ(batcher.get_stats().bytes, total);
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Destroyed_Batcher_Cancels_Flush) {
+  connect_pair();
+  EventLoop loop;
+  {
+    WriteBatcher batcher(client_, {}, &loop);
+    ASSERT_TRUE(batcher.write("x", 1));
+  }
+  loop.run_once(0);
+  SUCCEED();
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Automatic_Flush_Retries_When_Blocked) {
+  connect_pair();
+  ASSERT_TRUE(client_.set_non_blocking(true));
+  EventLoop loop;
+  WriteBatcher batcher(client_, {}, &loop);
+  constexpr std::size_t size = 8 << 20;
+  ASSERT_TRUE(batcher.write(std::vector<std::uint8_t>(size, 'x')));
+  ASSERT_TRUE(batcher.has_pending());
+
+  // Nothing is written after the socket buffer filled up, the loop alone must send the tail
+  std::size_t received = 0;
+  std::thread reader([this, &received, size]() {
+    received = receive_exactly(server_, size).size();
+  });
+  for (int i = 0; (i < 1000) && batcher.has_pending(); ++i) {
+    loop.run_once(10);
+  }
+  reader.join();
+  EXPECT_FALSE(batcher.has_pending());
+  EXPECT_EQ(received, size);
+}
+
+/**
+ * @brief
+ */
+TEST_F(SocketTest, Blocked_Flush_Resumes_Within_Latency_Budget) {
+  connect_pair();
+  ASSERT_TRUE(client_.set_non_blocking(true));
+  ASSERT_TRUE(server_.set_non_blocking(true));
+  EventLoop loop;
+  coalesce_policy_t policy;
+  policy.latency_budget = std::chrono::milliseconds(2);
+  WriteBatcher batcher(client_, policy, &loop);
+  ASSERT_TRUE(batcher.write(std::vector<std::uint8_t>(64 << 20, 'x')));
+
+  std::vector<char> buffer(256 * 1024);
+  for (int round = 0; round < 3; ++round) {
+    // Long enough blocked for the retries to back off as far as they may
+    const loop_clock_t::time_point blocked = loop_clock_t::now();
+    while (loop_clock_t::now() - blocked < std::chrono::milliseconds(150)) {
+      loop.run_once(10);
+    }
+    const std::size_t before = batcher.get_queued_size();
+    ASSERT_GT(before, 0u);
+    while (server_.recv(buffer.data(), buffer.size()) > 0) {
+    }
+
+    // The tail must move again within the budget, not after the longest backoff
+    const loop_clock_t::time_point drained = loop_clock_t::now();
+    while ((batcher.get_queued_size() == before) && (loop_clock_t::now() - drained < std::chrono::seconds(1))) {
+      loop.run_once(1);
+    }
+    EXPECT_LT(batcher.get_queued_size(), before);
+    EXPECT_LT(loop_clock_t::now() - drained, policy.latency_budget + std::chrono::milliseconds(20));
+  }
+}
+
+
+} // namespace tests
+} // namespace ncs::sock
@@ -0,0 +1,130 @@
+/**
+ * @copyright Copyright (c) 2023
+ * 
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ * 
+ * @file XdpSocket_tests.cpp
+ * 
+ * @brief
+ */
+
+
+#include <XdpTest.h>
+
+#include <gtest/gtest.h>
+
+#include <cerrno>
+#include <cstring>
+
+
+namespace ncs::sock {
+namespace tests {
+
+
+/**
+ * @brief
+ */
+TEST_F(XdpTest, Rejects_Invalid_Sizes) {
+  XdpSocket socket;
+  xdp_config_t config = make_config(veth0_);
+  config.ring_size = 48;
+  EXPECT_FALSE(socket.open(config));
+  EXPECT_EQ(errno, EINVAL);
+  config = make_config(veth0_);
+  config.frame_size = 1024;
+  EXPECT_FALSE(socket.open(config));
+  EXPECT_FALSE(socket.is_open());
+}
+
+/**
+ * @brief
+ */
+TEST_F(XdpTest, Auto_Mode_Falls_Back_To_Copy) {
+  XdpSocket socket;
+  ASSERT_TRUE(socket.open(make_config(veth1_, XDP_MODE_AUTO))) << std::strerror(errno);
+  EXPECT_TRUE(socket.is_open());
+  EXPECT_EQ(socket.get_mode(), XDP_MODE_COPY);
+  // Half of the UMEM is posted to the fill ring, capped by its size
+  EXPECT_EQ(socket.get_free_frames(), 32u);
+  socket.close();
+  EXPECT_FALSE(socket.is_open());
+  EXPECT_EQ(socket.get_free_frames(), 0u);
+}
+
+/**
+ * @brief
+ */
+TEST_F(XdpTest, Redirects_Frames_Between_Veth_Peers) {
+  XdpSocket receiver;
+  XdpSocket sender;
+  XdpProgram program;
+  ASSERT_TRUE(receiver.open(make_config(veth1_))) << std::strerror(errno);
+  ASSERT_TRUE(sender.open(make_config(veth0_))) << std::strerror(errno);
+  ASSERT_TRUE(program.attach(veth1_)) << std::strerror(errno);
+  EXPECT_NE(program.get_mode(), XDP_ATTACH_AUTO);
+  ASSERT_TRUE(program.add(receiver)) << std::strerror(errno);
+
+  std::vector<std::string> frames;
+  std::vector<iovec> batch;
+  for (int i = 0; i < 8; ++i) {
+    frames.push_back(make_frame("ncs xdp frame " + std::to_string(i)));
+  }
+  for (std::string& frame : frames) {
+    batch.push_back({frame.data(), frame.size()});
+  }
+  ASSERT_EQ(sender.send(batch.data(), batch.size()), batch.size());
+
+  EXPECT_EQ(receive_frames(receiver, frames.size()), frames);
+  const xdp_stats_t stats = receiver.get_stats();
+  EXPECT_EQ(stats.rx_packets, frames.size());
+  EXPECT_EQ(stats.rx_dropped, 0u);
+
+  // Every transmitted frame comes back through the completion ring
+  std::size_t completed = 0;
+  for (int attempt = 0; attempt < 100 && completed < frames.size(); ++attempt) {
+    completed += sender.complete();
+  }
+  EXPECT_EQ(completed, frames.size());
+  EXPECT_EQ(sender.get_stats().tx_packets, frames.size());
+  EXPECT_TRUE(program.remove(0));
+}
+
+/**
+ * @brief
+ */
+TEST_F(XdpTest, Acquired_Frames_Are_Sent_In_Place) {
+  XdpSocket receiver;
+  XdpSocket sender;
+  XdpProgram program;
+  ASSERT_TRUE(receiver.open(make_config(veth1_))) << std::strerror(errno);
+  ASSERT_TRUE(sender.open(make_config(veth0_))) << std::strerror(errno);
+  ASSERT_TRUE(program.attach(veth1_, XDP_ATTACH_GENERIC)) << std::strerror(errno);
+  EXPECT_EQ(program.get_mode(), XDP_ATTACH_GENERIC);
+  ASSERT_TRUE(program.add(receiver));
+
+  const std::string frame = make_frame("in place");
+  xdp_packet_t packet;
+  ASSERT_EQ(sender.acquire(&packet, 1), 1u);
+  EXPECT_EQ(packet.size, 2048u);
+  std::memcpy(packet.data, frame.data(), frame.size());
+  packet.size = static_cast<std::uint32_t>(frame.size());
+  const std::size_t freeFrames = sender.get_free_frames();
+  ASSERT_EQ(sender.submit(&packet, 1), 1u);
+
+  EXPECT_EQ(receive_frames(receiver, 1), std::vector<std::string>{frame});
+  for (int attempt = 0; attempt < 100 && sender.get_free_frames() == freeFrames; ++attempt) {
+    sender.complete();
+  }
+  EXPECT_EQ(sender.get_free_frames(), freeFrames + 1);
+
+  // Oversized buffers are refused instead of being truncated
+  std::string jumbo(4096, 'x');
+  iovec oversized{jumbo.data(), jumbo.size()};
+  EXPECT_EQ(sender.send(&oversized, 1), 0u);
+  EXPECT_EQ(errno, EMSGSIZE);
+}
+
+
+} // namespace tests
+} // namespace ncs::sock
@@ -0,0 +1,179 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file XdpTest.cpp
+ *
+ * @brief
+ */
+
+
+#include <XdpTest.h>
+
+#include <fcntl.h>
+#include <net/if.h>
+#include <poll.h>
+#include <sched.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdlib>
+
+
+namespace ncs { // Network Communications System
+namespace sock { // Network Communications System Sockets
+namespace tests { // Tests
+
+
+/** PUBLIC METHODS **/
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PROTECTED METHODS **/
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+/**
+ * @brief Moves the thread into a fresh namespace and creates veth0 <-> veth1, skipping when not permitted
+ */
+void XdpTest::SetUp() {
+  veth0_ = 0;
+  veth1_ = 0;
+  namespace_ = ::open("/proc/thread-self/ns/net", O_RDONLY | O_CLOEXEC);
+  if (namespace_ < 0 || ::unshare(CLONE_NEWNET) < 0) {
+    GTEST_SKIP() << "network namespaces are not available";
+  }
+  if (std::system("ip link add veth0 type veth peer name veth1 >/dev/null 2>&1 && "
+                  "ip link set veth0 up && ip link set veth1 up") != 0) {
+    GTEST_SKIP() << "veth pairs can not be created";
+  }
+  veth0_ = static_cast<int>(::if_nametoindex("veth0"));
+  veth1_ = static_cast<int>(::if_nametoindex("veth1"));
+  ASSERT_GT(veth0_, 0);
+  ASSERT_GT(veth1_, 0);
+}
+
+/**
+ * @brief Returns to the original namespace, the private one and its veth pair go away with it
+ */
+void XdpTest::TearDown() {
+  if (namespace_ >= 0) {
+    EXPECT_EQ(::setns(namespace_, CLONE_NEWNET), 0);
+    ::close(namespace_);
+  }
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief 
+ * 
+ * @param iIfIndex
+ * @param iMode
+ * 
+ * @return
+ */
+xdp_config_t XdpTest::make_config(const int& iIfIndex, const xdp_mode_e& iMode) {
+  xdp_config_t config;
+  config.ifindex = iIfIndex;
+  config.frame_count = 64;
+  config.frame_size = 2048;
+  config.ring_size = 32;
+  config.mode = iMode;
+  return config;
+}
+
+/**
+ * @brief 
+ * 
+ * @param iPayload
+ * 
+ * @return
+ */
+std::string XdpTest::make_frame(const std::string& iPayload) {
+  std::string frame(12, '\xff');
+  frame.append("\x88\xb5", 2);
+  frame.append(iPayload);
+  return frame;
+}
+
+/**
+ * @brief 
+ * 
+ * @param ioSocket
+ * @param iCount
+ * 
+ * @return
+ */
+std::vector<std::string> XdpTest::receive_frames(XdpSocket& ioSocket, const std::size_t& iCount) {
+  std::vector<std::string> frames;
+  std::vector<xdp_packet_t> packets(iCount);
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+  while (frames.size() < iCount && std::chrono::steady_clock::now() < deadline) {
+    pollfd entry{ioSocket.get_sd(), POLLIN, 0};
+    ::poll(&entry, 1, 10);
+    const std::size_t count = ioSocket.receive(packets.data(), iCount - frames.size());
+    for (std::size_t i = 0; i < count; ++i) {
+      frames.emplace_back(reinterpret_cast<const char*>(packets[i].data), packets[i].size);
+    }
+    ioSocket.release(packets.data(), count);
+  }
+  return frames;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PRIVATE METHODS **/
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+} // namespace tests
+} // namespace sock
+} // namespace ncs
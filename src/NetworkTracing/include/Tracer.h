@@ -0,0 +1,202 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file Tracer.h
+ *
+ * @brief Tracepoints placed on the NCS hot paths
+ */
+
+
+#ifndef NCS_TRACER_H
+#define NCS_TRACER_H
+
+
+#include <atomic>
+#include <cstdint>
+
+#if defined(NCS_ENABLE_TRACEPOINTS) && __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define NCS_HAVE_USDT 1
+#define NCS_TRACE_USDT(iProbe, iAddress, iSd, iSize, iResult) DTRACE_PROBE4(ncs, iProbe, iAddress, iSd, iSize, iResult)
+#else
+#define NCS_HAVE_USDT 0
+#define NCS_TRACE_USDT(iProbe, iAddress, iSd, iSize, iResult) do {} while (0)
+#endif
+
+/**
+ * @brief Fires the iProbe tracepoint, TRACE_ is prefixed to iProbe to name the trace_probe_e
+ * 
+ * Compiled out unless NCS_ENABLE_TRACEPOINTS is defined. When compiled in it is a USDT probe (where sys/sdt.h exists)
+ * plus a relaxed load and a never taken branch while no handler is attached.
+ */
+#if defined(NCS_ENABLE_TRACEPOINTS)
+#define NCS_TRACE(iProbe, iAddress, iSd, iSize, iResult)                                                           \
+  do {                                                                                                              \
+    NCS_TRACE_USDT(iProbe, iAddress, iSd, iSize, iResult);                                                          \
+    if (__builtin_expect(::ncs::trace::Tracer::is_attached(), 0)) {                                                 \
+      ::ncs::trace::Tracer::emit(::ncs::trace::TRACE_##iProbe, iAddress, iSd, iSize, iResult);                      \
+    }                                                                                                               \
+  } while (0)
+#else
+#define NCS_TRACE(iProbe, iAddress, iSd, iSize, iResult) do {} while (0)
+#endif
+
+
+namespace ncs { // Network Communications System
+namespace addr { // Network Communications System Addresses
+class InternetAddress;
+} // namespace addr
+namespace trace { // Network Communications System Tracing
+
+
+/**
+ * Tracer types
+ */
+enum trace_probe_e {
+  TRACE_SOCKET_OPEN,        // A descriptor has been created
+  TRACE_SOCKET_CONNECT,     // A connection has been started
+  TRACE_SOCKET_ACCEPT,      // A connection has been accepted
+  TRACE_SOCKET_SEND,        // Bytes have been handed to the kernel
+  TRACE_SOCKET_RECV,        // Bytes have been read from the kernel
+  TRACE_SOCKET_CLOSE,       // A descriptor has been closed
+  TRACE_ADDRESS_PARSE       // An address has been converted from or to its binary form
+};
+
+/**
+ * @brief Arguments carried by every tracepoint
+ */
+struct trace_event_t {
+  trace_probe_e probe;
+  const addr::InternetAddress* address = nullptr;   // Address involved, nullptr if none
+  std::int64_t sd = -1;                             // Descriptor involved, -1 if none
+  std::int64_t size = 0;                            // Bytes requested
+  std::int64_t result = 0;                          // Value returned by the traced call
+};
+
+using trace_handler_t = void (*)(const trace_event_t& iEvent);   // Receives the tracepoints, from any thread
+
+
+/**
+ * @brief Process wide dispatch of the tracepoints to a single attached handler
+ */
+class Tracer {
+public:
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+  /**
+   * @brief Default constructor
+   */
+  Tracer(void) = delete;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+  /**
+   * @brief Sends every tracepoint to iHandler
+   * 
+   * @param iHandler
+   */
+  static void attach(trace_handler_t iHandler);
+
+  /**
+   * @brief Stops sending tracepoints, the previous handler may still be running on other threads
+   */
+  static void detach(void);
+
+  /**
+   * @brief Checked by every tracepoint, kept inline so an unattached tracepoint costs a single load
+   * 
+   * @return
+   */
+  [[nodiscard]] static bool is_attached(void) {
+    return handler_.load(std::memory_order_relaxed) != nullptr;
+  }
+
+  /**
+   * @brief Hands a tracepoint to the attached handler
+   * 
+   * @param iProbe
+   * @param iAddress
+   * @param iSd
+   * @param iSize
+   * @param iResult
+   */
+  static void emit(const trace_probe_e& iProbe, const addr::InternetAddress* iAddress, const std::int64_t& iSd,
+                   const std::int64_t& iSize, const std::int64_t& iResult);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+  /**
+   * @brief
+   * 
+   * @param iProbe
+   * 
+   * @return Name of the probe, as exposed to USDT
+   */
+  [[nodiscard]] static const char* to_string(const trace_probe_e& iProbe);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+protected:
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+private:
+  static inline std::atomic<trace_handler_t> handler_{nullptr};
+};
+
+
+} // namespace trace
+} // namespace ncs
+
+
+#endif // NCS_TRACER_H
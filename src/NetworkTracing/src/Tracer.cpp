@@ -0,0 +1,152 @@
+/**
+ * @copyright Copyright (c) 2023
+ *
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ *
+ * @file Tracer.cpp
+ *
+ * @brief
+ */
+
+
+#include <Tracer.h>
+
+#include <cerrno>
+
+
+namespace ncs { // Network Communications System
+namespace trace { // Network Communications System Tracing
+
+
+/** PUBLIC METHODS **/
+/// PUBLIC //////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+/**
+ * @brief Sends every tracepoint to iHandler
+ * 
+ * @param iHandler
+ */
+void Tracer::attach(trace_handler_t iHandler) {
+  handler_.store(iHandler, std::memory_order_release);
+}
+
+/**
+ * @brief Stops sending tracepoints
+ */
+void Tracer::detach(void) {
+  handler_.store(nullptr, std::memory_order_release);
+}
+
+/**
+ * @brief Hands a tracepoint to the attached handler, errno is preserved for the traced code
+ * 
+ * @param iProbe
+ * @param iAddress
+ * @param iSd
+ * @param iSize
+ * @param iResult
+ */
+void Tracer::emit(const trace_probe_e& iProbe, const addr::InternetAddress* iAddress, const std::int64_t& iSd,
+                  const std::int64_t& iSize, const std::int64_t& iResult) {
+  const trace_handler_t handler = handler_.load(std::memory_order_acquire);
+  if (handler != nullptr) {
+    trace_event_t event;
+    event.probe = iProbe;
+    event.address = iAddress;
+    event.sd = iSd;
+    event.size = iSize;
+    event.result = iResult;
+    const int error = errno;
+    handler(event);
+    errno = error;
+  }
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+/**
+ * @brief
+ * 
+ * @param iProbe
+ * 
+ * @return
+ */
+[[nodiscard]] const char* Tracer::to_string(const trace_probe_e& iProbe) {
+  switch (iProbe) {
+    case TRACE_SOCKET_OPEN:
+      return "SOCKET_OPEN";
+    case TRACE_SOCKET_CONNECT:
+      return "SOCKET_CONNECT";
+    case TRACE_SOCKET_ACCEPT:
+      return "SOCKET_ACCEPT";
+    case TRACE_SOCKET_SEND:
+      return "SOCKET_SEND";
+    case TRACE_SOCKET_RECV:
+      return "SOCKET_RECV";
+    case TRACE_SOCKET_CLOSE:
+      return "SOCKET_CLOSE";
+    case TRACE_ADDRESS_PARSE:
+      return "ADDRESS_PARSE";
+  }
+  return "UNKNOWN";
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC ///////////////////////////////////////  FRIEND FUNCTIONS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PUBLIC //////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PROTECTED METHODS **/
+/// PROTECTED ///////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PROTECTED ///////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+/** PRIVATE METHODS **/
+/// PRIVATE /////////////////////////////////////     CONSTRUCTORS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////    CLASS METHODS    //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  SETTERS & GETTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////  OUTPUT FORMATTERS  //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////       OPERATORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// PRIVATE /////////////////////////////////////     DESTRUCTORS     //////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+} // namespace trace
+} // namespace ncs
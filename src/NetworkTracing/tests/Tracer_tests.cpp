@@ -0,0 +1,53 @@
+/**
+ * @copyright Copyright (c) 2023
+ * 
+ * @author Hugo Fernandez Solis (hugofernandezsolis@gmail.com)
+ * @date 19-10-2026
+ * 
+ * @file Tracer_tests.cpp
+ * 
+ * @brief
+ */
+
+
+#include <TracerTest.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+
+namespace ncs::trace {
+namespace tests {
+
+
+/**
+ * @brief
+ */
+TEST_F(TracerTest, Attached_Handler_Receives_Arguments) {
+#if !defined(NCS_ENABLE_TRACEPOINTS)
+  GTEST_SKIP() << "Tracepoints compiled out";
+#endif
+  NCS_TRACE(SOCKET_SEND, nullptr, 7, 100, 42);
+  ASSERT_EQ(events_.size(), 1u);
+  EXPECT_EQ(events_[0].probe, TRACE_SOCKET_SEND);
+  EXPECT_EQ(events_[0].address, nullptr);
+  EXPECT_EQ(events_[0].sd, 7);
+  EXPECT_EQ(events_[0].size, 100);
+  EXPECT_EQ(events_[0].result, 42);
+  EXPECT_EQ(std::string(Tracer::to_string(events_[0].probe)), "SOCKET_SEND");
+}
+
+/**
+ * @brief
+ */
+TEST_F(TracerTest, Detached_Tracepoints_Are_Silent) {
+  Tracer::detach();
+  EXPECT_FALSE(Tracer::is_attached());
+  NCS_TRACE(SOCKET_CLOSE, nullptr, 7, 0, 0);
+  EXPECT_TRUE(events_.empty());
+}
+
+
+} // namespace tests
+} // namespace ncs::trace